@@ -0,0 +1,22 @@
+-- Migration 051: Record assembly provenance in the warm working set.
+--
+-- Envelope diff activation (HCPEnvelopeManager::ActivateEnvelope) keeps the
+-- LMDB hot-set entries of plan queries shared between the outgoing and the
+-- incoming envelope, and evicts only what the incoming plan no longer
+-- carries. That needs to know WHICH stored query assembled each warm row —
+-- recorded here at assembly time by AssembleQuery.
+--
+-- Rows with NULL provenance (assembled before this migration) are evicted
+-- conservatively on a diff switch, so no backfill is required.
+
+\connect hcp_var
+
+BEGIN;
+
+ALTER TABLE envelope_working_set ADD COLUMN IF NOT EXISTS source_query_id INTEGER NULL;
+
+-- Diff eviction reads: all rows for an envelope from a set of queries
+CREATE INDEX IF NOT EXISTS idx_ews_source_query
+    ON envelope_working_set (envelope_id, source_query_id);
+
+COMMIT;
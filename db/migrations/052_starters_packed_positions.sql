@@ -0,0 +1,27 @@
+-- Migration 052: packed starter position lists
+--
+-- pbm_starters.positions stores INTEGER[] (~4 bytes per element, plus the
+-- text-literal round trip on every write and read). Occurrences of one
+-- token through a document have small gaps, so delta-encoded ULEB128
+-- varints pack to ~1 byte per occurrence — roughly 8x smaller, and the
+-- read side becomes one sequential decode instead of an array-literal
+-- parse per row.
+--
+-- Format (engine-side codec: HCPPosPack.h): first varint is the absolute
+-- first position, each subsequent varint the gap to its predecessor.
+--
+-- The engine writes positions_packed from this migration on (and clears
+-- the legacy array on upsert). Rows ingested earlier keep their INTEGER[]
+-- and NULL positions_packed; the reader falls back to the array for them,
+-- so re-ingest is optional.
+--
+-- Apply against: hcp_fic_pbm.
+
+\set ON_ERROR_STOP on
+
+BEGIN;
+
+ALTER TABLE pbm_starters
+    ADD COLUMN IF NOT EXISTS positions_packed BYTEA NULL;
+
+COMMIT;
@@ -0,0 +1,144 @@
+#!/usr/bin/env bash
+# load_parallel.sh — Parallel restore of the vocabulary substrate shards
+#
+# Serial gunzip+psql (db/load.sh all) takes most of an hour before the
+# engine can start envelope activation; shard restores are independent
+# Postgres databases, so they parallelize cleanly. hcp_core loads first
+# (every other shard's tokens reference its structural/byte-code
+# addressing), then the remaining shards fan out under a job limit.
+#
+# Usage: ./db/tools/load_parallel.sh
+#
+# Environment:
+#   HCP_DB_USER    — PostgreSQL user (default: hcp)
+#   HCP_DB_HOST    — PostgreSQL host (default: localhost)
+#   PGPASSWORD     — PostgreSQL password (set externally or defaults to hcp_dev)
+#   HCP_LOAD_JOBS  — concurrent shard loads after core (default: nproc, max 5)
+
+set -uo pipefail
+
+DB_USER="${HCP_DB_USER:-hcp}"
+DB_HOST="${HCP_DB_HOST:-localhost}"
+export PGPASSWORD="${PGPASSWORD:-hcp_dev}"
+
+SCRIPT_DIR="$(cd "$(dirname "$0")/.." && pwd)"   # db/
+JOBS="${HCP_LOAD_JOBS:-$(nproc 2>/dev/null || echo 4)}"
+[ "$JOBS" -gt 5 ] && JOBS=5
+
+# pigz decompresses on all cores; gunzip is the fallback.
+if command -v pigz >/dev/null 2>&1; then
+    DECOMPRESS="pigz -dc"
+else
+    DECOMPRESS="gunzip -c"
+fi
+
+LOG_DIR="$(mktemp -d /tmp/hcp_load_XXXXXX)"
+trap 'rm -rf "$LOG_DIR"' EXIT
+
+# Shard table: dbname:dumpfile (relative to db/). Order below is the
+# fan-out order — largest shards first so the long poles start early.
+CORE_SHARD="hcp_core:core.sql.gz"
+FANOUT_SHARDS=(
+    "hcp_english:english.sql.gz"
+    "hcp_fic_pbm:hcp_fic_pbm.sql.gz"
+    "hcp_fic_entities:fic_entities.sql.gz"
+    "hcp_nf_entities:hcp_nf_entities.sql.gz"
+    "hcp_var:var.sql.gz"
+)
+
+log() {
+    printf '[%s] %s\n' "$(date +%H:%M:%S)" "$*"
+}
+
+# Restore one shard. Runs in the background; writes its psql output to
+# $LOG_DIR/<db>.log and its exit code to $LOG_DIR/<db>.rc.
+load_shard() {
+    local dbname="$1"
+    local gzfile="$SCRIPT_DIR/$2"
+    local start rc
+    start=$(date +%s)
+
+    # Subshell: the inner exit ends the shard, not the script, so the
+    # stage-1 synchronous call survives a core failure long enough to report.
+    (
+        if [ ! -f "$gzfile" ]; then
+            echo "missing dump: $gzfile"
+            echo 1 > "$LOG_DIR/$dbname.rc"
+            exit 1
+        fi
+
+        if [ -f "${gzfile}.sha256" ]; then
+            (cd "$(dirname "$gzfile")" && sha256sum -c "$(basename "$gzfile").sha256" --quiet) \
+                || { echo "CHECKSUM FAILED: $gzfile"; echo 1 > "$LOG_DIR/$dbname.rc"; exit 1; }
+        fi
+
+        createdb -U "$DB_USER" -h "$DB_HOST" "$dbname" 2>/dev/null || true
+        if $DECOMPRESS "$gzfile" | psql -U "$DB_USER" -h "$DB_HOST" -d "$dbname" -q; then
+            rc=0
+        else
+            rc=1
+        fi
+        echo "$rc" > "$LOG_DIR/$dbname.rc"
+        exit "$rc"
+    ) > "$LOG_DIR/$dbname.log" 2>&1
+
+    local end=$(date +%s)
+    if [ "$(cat "$LOG_DIR/$dbname.rc" 2>/dev/null)" = "0" ]; then
+        log "$dbname: done in $((end - start))s"
+    else
+        log "$dbname: FAILED after $((end - start))s"
+    fi
+}
+
+wait_for_slot() {
+    while [ "$(jobs -rp | wc -l)" -ge "$JOBS" ]; do
+        sleep 1
+    done
+}
+
+report() {
+    local failed=0
+    for entry in "$CORE_SHARD" "${FANOUT_SHARDS[@]}"; do
+        local dbname="${entry%%:*}"
+        local rc
+        rc=$(cat "$LOG_DIR/$dbname.rc" 2>/dev/null || echo "?")
+        if [ "$rc" = "?" ]; then
+            failed=1
+            log "NOT ATTEMPTED: $dbname (earlier stage aborted)"
+        elif [ "$rc" != "0" ]; then
+            failed=1
+            log "FAILED: $dbname (see output below)"
+            sed "s/^/  [$dbname] /" "$LOG_DIR/$dbname.log" 2>/dev/null
+        fi
+    done
+    return "$failed"
+}
+
+TOTAL_START=$(date +%s)
+log "Restoring $((${#FANOUT_SHARDS[@]} + 1)) shards to $DB_HOST ($JOBS parallel after core, $DECOMPRESS)"
+
+# Stage 1: core — the addressing substrate the other shards reference.
+log "hcp_core: loading (stage 1)"
+load_shard "${CORE_SHARD%%:*}" "${CORE_SHARD##*:}"
+if [ "$(cat "$LOG_DIR/hcp_core.rc" 2>/dev/null)" != "0" ]; then
+    log "hcp_core failed — aborting before fan-out"
+    report
+    exit 1
+fi
+
+# Stage 2: everything else, $JOBS at a time.
+for entry in "${FANOUT_SHARDS[@]}"; do
+    wait_for_slot
+    dbname="${entry%%:*}"
+    log "$dbname: loading"
+    load_shard "$dbname" "${entry##*:}" &
+done
+wait
+
+TOTAL_END=$(date +%s)
+if report; then
+    log "All shards restored in $((TOTAL_END - TOTAL_START))s"
+else
+    log "Restore finished with failures in $((TOTAL_END - TOTAL_START))s"
+    exit 1
+fi
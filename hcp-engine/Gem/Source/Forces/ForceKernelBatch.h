@@ -0,0 +1,289 @@
+// ForceKernelBatch.h — batched Section-1 force application over SoA spans.
+//
+// The per-particle reference (ForceKernel.h) stays the ORACLE; this file is
+// the host-side batch path for force-layer experiments over prime-layer
+// particle populations, where walking an AoS Particle array through
+// generator calls one particle at a time leaves most of the memory bus idle.
+// Same math, laid out structure-of-arrays: the generator list is applied
+// per-ARRAY — one tight typed loop over every particle per generator, with a
+// single dispatch per generator rather than any per-particle indirection —
+// followed by a fused integrate pass in the same call.
+//
+// Equivalence contract: BIT-identity with the reference. Every batch loop
+// performs the identical operation sequence as the scalar updateForce /
+// Integrate bodies (no reassociation, no FMA contraction through plain
+// C++ arithmetic), and per particle the force accumulation order is the
+// generator-list order in both schemes, so positions and velocities agree
+// bit-for-bit. test_forces.cpp pins this with a randomized batch-vs-oracle
+// lockstep run.
+
+#pragma once
+
+#include "ForceKernel.h"
+
+#include <cstddef>
+#include <variant>
+#include <vector>
+
+namespace hcp::forces
+{
+    // Structure-of-arrays particle state for the batched force pass.
+    // Field-for-field mirror of Particle; inverseMass <= 0 encodes immovable
+    // exactly as in the reference (generators gate, Integrate skips).
+    struct ParticleSoA
+    {
+        std::vector<float> posX, posY, posZ;
+        std::vector<float> velX, velY, velZ;
+        std::vector<float> accX, accY, accZ;       // base/constant acceleration
+        std::vector<float> forceX, forceY, forceZ; // accumulator, cleared by IntegrateAll
+        std::vector<float> damping;
+        std::vector<float> inverseMass;
+
+        size_t Count() const { return posX.size(); }
+
+        void Resize(size_t n)
+        {
+            posX.resize(n);   posY.resize(n);   posZ.resize(n);
+            velX.resize(n);   velY.resize(n);   velZ.resize(n);
+            accX.resize(n);   accY.resize(n);   accZ.resize(n);
+            forceX.resize(n); forceY.resize(n); forceZ.resize(n);
+            damping.resize(n, 0.99f);
+            inverseMass.resize(n, 1.0f);
+        }
+
+        // Scatter from the AoS representation the scalar reference uses.
+        void FromAoS(const std::vector<Particle>& particles)
+        {
+            const size_t n = particles.size();
+            Resize(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const Particle& p = particles[i];
+                posX[i] = p.position.x;     posY[i] = p.position.y;     posZ[i] = p.position.z;
+                velX[i] = p.velocity.x;     velY[i] = p.velocity.y;     velZ[i] = p.velocity.z;
+                accX[i] = p.acceleration.x; accY[i] = p.acceleration.y; accZ[i] = p.acceleration.z;
+                forceX[i] = p.forceAccum.x; forceY[i] = p.forceAccum.y; forceZ[i] = p.forceAccum.z;
+                damping[i] = p.damping;
+                inverseMass[i] = p.inverseMass;
+            }
+        }
+
+        // Gather back to AoS.
+        void ToAoS(std::vector<Particle>& particles) const
+        {
+            const size_t n = Count();
+            particles.resize(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                Particle& p = particles[i];
+                p.position     = { posX[i], posY[i], posZ[i] };
+                p.velocity     = { velX[i], velY[i], velZ[i] };
+                p.acceleration = { accX[i], accY[i], accZ[i] };
+                p.forceAccum   = { forceX[i], forceY[i], forceZ[i] };
+                p.damping      = damping[i];
+                p.inverseMass  = inverseMass[i];
+            }
+        }
+    };
+
+    // A force-generator list entry. One std::visit per generator per step —
+    // the typed Apply loop below it runs over the whole array with no
+    // per-particle dispatch.
+    using ForceGen = std::variant<Gravity, Drag, Spring, AnchoredSpring,
+                                  Bungee, Buoyancy, StiffSpring, ConstantForce>;
+
+    // ---- Per-generator batch loops. Each keeps the exact operation order of
+    // the corresponding scalar updateForce body (ForceKernel.h) so the batch
+    // stays bit-identical to the oracle. ----
+
+    inline void Apply(ParticleSoA& p, const Gravity& g, float /*dt*/)
+    {
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!(p.inverseMass[i] > 0.0f)) continue;      // immovable: no force
+            const float mass = 1.0f / p.inverseMass[i];    // getMass(), finite branch
+            p.forceX[i] += g.gravity.x * mass;
+            p.forceY[i] += g.gravity.y * mass;
+            p.forceZ[i] += g.gravity.z * mass;
+        }
+    }
+
+    inline void Apply(ParticleSoA& p, const Drag& d, float /*dt*/)
+    {
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float vx = p.velX[i], vy = p.velY[i], vz = p.velZ[i];
+            const float mag = std::sqrt(vx * vx + vy * vy + vz * vz);
+            const float dragCoeff = d.k1 * mag + d.k2 * mag * mag;
+            if (!std::isfinite(dragCoeff)) continue;       // overflow guard, as scalar
+            if (!(mag > 0.0f)) continue;                   // normalized() of zero is zero
+            p.forceX[i] += (vx / mag) * -dragCoeff;
+            p.forceY[i] += (vy / mag) * -dragCoeff;
+            p.forceZ[i] += (vz / mag) * -dragCoeff;
+        }
+    }
+
+    inline void Apply(ParticleSoA& p, const Spring& s, float /*dt*/)
+    {
+        const Vec3 o = s.other->position;
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float dx = p.posX[i] - o.x, dy = p.posY[i] - o.y, dz = p.posZ[i] - o.z;
+            const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+            const float magnitude = (length - s.restLength) * s.springConstant;
+            if (!(length > 0.0f)) continue;                // coincident: zero force
+            p.forceX[i] += (dx / length) * -magnitude;
+            p.forceY[i] += (dy / length) * -magnitude;
+            p.forceZ[i] += (dz / length) * -magnitude;
+        }
+    }
+
+    inline void Apply(ParticleSoA& p, const AnchoredSpring& s, float /*dt*/)
+    {
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float dx = p.posX[i] - s.anchor.x;
+            const float dy = p.posY[i] - s.anchor.y;
+            const float dz = p.posZ[i] - s.anchor.z;
+            const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+            const float magnitude = (s.restLength - length) * s.springConstant;
+            if (!(length > 0.0f)) continue;
+            p.forceX[i] += (dx / length) * magnitude;
+            p.forceY[i] += (dy / length) * magnitude;
+            p.forceZ[i] += (dz / length) * magnitude;
+        }
+    }
+
+    inline void Apply(ParticleSoA& p, const Bungee& b, float /*dt*/)
+    {
+        const Vec3 o = b.other->position;
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float dx = p.posX[i] - o.x, dy = p.posY[i] - o.y, dz = p.posZ[i] - o.z;
+            const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+            if (length <= b.restLength) continue;          // slack -> no force
+            const float magnitude = b.springConstant * (length - b.restLength);
+            p.forceX[i] += (dx / length) * -magnitude;
+            p.forceY[i] += (dy / length) * -magnitude;
+            p.forceZ[i] += (dz / length) * -magnitude;
+        }
+    }
+
+    inline void Apply(ParticleSoA& p, const Buoyancy& b, float /*dt*/)
+    {
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float depth = p.posY[i];
+            if (depth >= b.waterHeight + b.maxDepth) continue;
+            if (depth <= b.waterHeight - b.maxDepth)
+            {
+                p.forceY[i] += b.liquidDensity * b.volume;
+                continue;
+            }
+            const float submersion =
+                (b.waterHeight + b.maxDepth - depth) / (2.0f * b.maxDepth);
+            p.forceY[i] += b.liquidDensity * b.volume * submersion;
+        }
+    }
+
+    inline void Apply(ParticleSoA& p, const StiffSpring& s, float dt)
+    {
+        if (dt == 0.0f) return;                            // closed form divides by dt
+        // gamma is particle-independent: hoisted out of the loop. Same NaN /
+        // over-damped rejection as the scalar body.
+        const float gamma =
+            0.5f * std::sqrt(4.0f * s.springConstant - s.damping * s.damping);
+        if (!(gamma > 0.0f)) return;
+        const float cosG = std::cos(gamma * dt);
+        const float sinG = std::sin(gamma * dt);
+        const float decay = std::exp(-0.5f * dt * s.damping);
+
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!(p.inverseMass[i] > 0.0f)) continue;
+
+            const float px = p.posX[i] - s.anchor.x;
+            const float py = p.posY[i] - s.anchor.y;
+            const float pz = p.posZ[i] - s.anchor.z;
+
+            const float cx = px * (s.damping / (2.0f * gamma)) + p.velX[i] * (1.0f / gamma);
+            const float cy = py * (s.damping / (2.0f * gamma)) + p.velY[i] * (1.0f / gamma);
+            const float cz = pz * (s.damping / (2.0f * gamma)) + p.velZ[i] * (1.0f / gamma);
+
+            const float tx = (px * cosG + cx * sinG) * decay;
+            const float ty = (py * cosG + cy * sinG) * decay;
+            const float tz = (pz * cosG + cz * sinG) * decay;
+
+            const float ax = (tx - px) * (1.0f / (dt * dt)) - p.velX[i] * (1.0f / dt);
+            const float ay = (ty - py) * (1.0f / (dt * dt)) - p.velY[i] * (1.0f / dt);
+            const float az = (tz - pz) * (1.0f / (dt * dt)) - p.velZ[i] * (1.0f / dt);
+
+            const float mass = 1.0f / p.inverseMass[i];
+            p.forceX[i] += ax * mass;
+            p.forceY[i] += ay * mass;
+            p.forceZ[i] += az * mass;
+        }
+    }
+
+    inline void Apply(ParticleSoA& p, const ConstantForce& c, float /*dt*/)
+    {
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            p.forceX[i] += c.force.x;
+            p.forceY[i] += c.force.y;
+            p.forceZ[i] += c.force.z;
+        }
+    }
+
+    // Apply every generator in list order. Per particle the accumulation order
+    // matches the per-particle reference (each particle sees the generators in
+    // the same sequence), so the swap from particle-major to generator-major
+    // iteration cannot change a single bit.
+    inline void ApplyAll(ParticleSoA& p, const std::vector<ForceGen>& generators, float dt)
+    {
+        for (const ForceGen& gen : generators)
+            std::visit([&](const auto& g) { Apply(p, g, dt); }, gen);
+    }
+
+    // Integrate every particle — same semi-implicit Euler, same op order as
+    // Integrate(Particle&, dt), accumulators cleared in the same pass.
+    inline void IntegrateAll(ParticleSoA& p, float dt)
+    {
+        const size_t n = p.Count();
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (p.inverseMass[i] <= 0.0f) continue;        // immovable: skip
+
+            const float rx = p.accX[i] + p.forceX[i] * p.inverseMass[i];
+            const float ry = p.accY[i] + p.forceY[i] * p.inverseMass[i];
+            const float rz = p.accZ[i] + p.forceZ[i] * p.inverseMass[i];
+
+            const float d = std::pow(p.damping[i], dt);
+            p.velX[i] = (p.velX[i] + rx * dt) * d;
+            p.velY[i] = (p.velY[i] + ry * dt) * d;
+            p.velZ[i] = (p.velZ[i] + rz * dt) * d;
+
+            p.posX[i] += p.velX[i] * dt;
+            p.posY[i] += p.velY[i] * dt;
+            p.posZ[i] += p.velZ[i] * dt;
+
+            p.forceX[i] = 0.0f; p.forceY[i] = 0.0f; p.forceZ[i] = 0.0f;
+        }
+    }
+
+    // Fused apply+integrate: one step of the whole population.
+    inline void StepAll(ParticleSoA& p, const std::vector<ForceGen>& generators, float dt)
+    {
+        ApplyAll(p, generators, dt);
+        IntegrateAll(p, dt);
+    }
+
+} // namespace hcp::forces
@@ -0,0 +1,124 @@
+// InteractionBatch.h — phase-filtered class-interaction pass over SoA spans.
+//
+// The first consumer of the prime-layer broadphase (HCPPrimeGrid.h): instead
+// of a per-generator force over the WHOLE population (ForceKernelBatch.h),
+// an interaction rule applies a pairwise force between SOURCE particles and
+// the TARGET particles inside their interaction radius — the class-interaction
+// experiments the phase typology (HCPPrimePhases.h) exists for. The grid cuts
+// the pairing from O(N²) to the neighborhood sweep; its exact sphere query
+// means the rule sees precisely the pairs the brute-force double loop would.
+//
+// Equivalence contract: BIT-identity with ApplyInteractionReference below.
+// The grid scatters indices in nondeterministic bucket order (see the rebuild
+// note in HCPPrimeGrid.h), so the pass collects each source's candidates and
+// SORTS them before accumulating — per source the pair order is ascending
+// target index in both schemes, and float accumulation agrees bit-for-bit.
+// test_primegrid.cpp pins this with a randomized grid-vs-oracle lockstep run.
+
+#pragma once
+
+#include "ForceKernelBatch.h"
+#include "../HCPPrimeGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace hcp::forces
+{
+    // One class-interaction rule: particles passing `source` feel a radial
+    // force from every particle passing `target` within `radius`. Positive
+    // `strength` repels (force along target→source), negative attracts.
+    // Magnitude falls off linearly to zero at the radius edge:
+    //   F = strength * (1 - d/radius) * d_hat
+    // Linear falloff keeps the force continuous at the cutoff, so particles
+    // crossing the radius between steps see no impulse spike.
+    struct InteractionRule
+    {
+        HCPEngine::PhaseFilter source;
+        HCPEngine::PhaseFilter target;
+        float radius = 1.0f;
+        float strength = 1.0f;
+    };
+
+    // Shared per-pair math: force on source particle i from target particle j.
+    // One body for both the grid pass and the reference so they cannot drift.
+    inline void AccumulatePair(ParticleSoA& p, size_t i, uint32_t j,
+                               const InteractionRule& rule)
+    {
+        const float dx = p.posX[i] - p.posX[j];
+        const float dy = p.posY[i] - p.posY[j];
+        const float dz = p.posZ[i] - p.posZ[j];
+        const float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (!(dist > 0.0f)) return;                 // coincident: zero force
+        const float magnitude = rule.strength * (1.0f - dist / rule.radius);
+        p.forceX[i] += (dx / dist) * magnitude;
+        p.forceY[i] += (dy / dist) * magnitude;
+        p.forceZ[i] += (dz / dist) * magnitude;
+    }
+
+    // Apply one rule via the broadphase. `grid` must have been rebuilt over
+    // p.posX/Y/Z and `phases` this frame (borrowed-array contract). The
+    // candidate sort restores determinism per the equivalence contract above.
+    inline void ApplyInteraction(ParticleSoA& p, const std::vector<uint32_t>& phases,
+                                 const HCPEngine::PrimeGrid& grid,
+                                 const InteractionRule& rule)
+    {
+        const size_t n = p.Count();
+        std::vector<uint32_t> candidates;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!rule.source.Accepts(phases[i]))
+                continue;
+
+            candidates.clear();
+            grid.ForEachInRadius(p.posX[i], p.posY[i], p.posZ[i], rule.radius,
+                rule.target, [&](uint32_t j) { candidates.push_back(j); });
+            std::sort(candidates.begin(), candidates.end());
+
+            for (uint32_t j : candidates)
+            {
+                if (j == static_cast<uint32_t>(i)) continue;   // no self-force
+                AccumulatePair(p, i, j, rule);
+            }
+        }
+    }
+
+    // Brute-force O(N²) reference — the ORACLE. Same pair predicate
+    // (filters + exact squared-distance), same per-pair math, ascending
+    // target order per source.
+    inline void ApplyInteractionReference(ParticleSoA& p,
+                                          const std::vector<uint32_t>& phases,
+                                          const InteractionRule& rule)
+    {
+        const size_t n = p.Count();
+        const float r2 = rule.radius * rule.radius;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!rule.source.Accepts(phases[i]))
+                continue;
+            for (size_t j = 0; j < n; ++j)
+            {
+                if (j == i || !rule.target.Accepts(phases[j]))
+                    continue;
+                const float dx = p.posX[i] - p.posX[j];
+                const float dy = p.posY[i] - p.posY[j];
+                const float dz = p.posZ[i] - p.posZ[j];
+                if (dx * dx + dy * dy + dz * dz > r2)
+                    continue;
+                AccumulatePair(p, i, static_cast<uint32_t>(j), rule);
+            }
+        }
+    }
+
+    // Apply every rule in list order, one broadphase sweep per rule.
+    inline void ApplyInteractions(ParticleSoA& p, const std::vector<uint32_t>& phases,
+                                  const HCPEngine::PrimeGrid& grid,
+                                  const std::vector<InteractionRule>& rules)
+    {
+        for (const InteractionRule& rule : rules)
+            ApplyInteraction(p, phases, grid, rule);
+    }
+
+} // namespace hcp::forces
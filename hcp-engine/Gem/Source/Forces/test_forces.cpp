@@ -10,9 +10,11 @@
 // it is included deliberately to pin the signed deviation.
 
 #include "ForceKernel.h"
+#include "ForceKernelBatch.h"
 
 #include <cmath>
 #include <cstdio>
+#include <vector>
 
 using namespace hcp::forces;
 
@@ -426,6 +428,114 @@ static void TestIntegrator()
     }
 }
 
+// ---- Batch (SoA) path vs per-particle oracle ------------------------------
+static void TestBatch()
+{
+    const float dt = 1.0f / 60.0f;
+    const size_t N = 97;   // odd count, exercises any residual tail handling
+    const int STEPS = 40;
+
+    // Deterministic varied population (LCG, no <random> needed). Every ~9th
+    // particle is immovable; damping and mass vary per particle.
+    unsigned seed = 0x5eed1u;
+    auto frand = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (float)(seed >> 8) / (float)(1u << 24) * 2.0f - 1.0f;   // [-1,1)
+    };
+
+    std::vector<Particle> ref(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        Particle& p = ref[i];
+        p.position = {frand() * 4.0f, frand() * 4.0f, frand() * 4.0f};
+        p.velocity = {frand(), frand(), frand()};
+        p.damping = 0.9f + 0.09f * (frand() * 0.5f + 0.5f);
+        p.inverseMass = (i % 9 == 8) ? 0.0f : 0.25f + (frand() * 0.5f + 0.5f);
+    }
+
+    // External spring endpoint — outside the population, never integrated.
+    Particle hub;
+    hub.position = {0.5f, 0.5f, 0.0f};
+
+    // Full generator list, every Section-1 type represented, applied in order.
+    std::vector<ForceGen> gens;
+    gens.push_back(Gravity(Vec3{0.0f, -9.81f, 0.0f}));
+    gens.push_back(Drag(0.3f, 0.05f));
+    gens.push_back(Spring(&hub, 1.5f, 1.0f));
+    gens.push_back(AnchoredSpring(Vec3{-1.0f, 2.0f, 0.0f}, 2.0f, 1.5f));
+    gens.push_back(Bungee(&hub, 2.5f, 2.0f));
+    gens.push_back(Buoyancy(1.0f, 0.01f, 0.0f, 1000.0f));
+    gens.push_back(StiffSpring(Vec3{1.0f, 0.0f, 1.0f}, 50.0f, 0.5f));
+    gens.push_back(ConstantForce(Vec3{0.1f, 0.0f, -0.2f}));
+
+    // Round-trip sanity: FromAoS/ToAoS with zero steps is the identity.
+    ParticleSoA soa;
+    soa.FromAoS(ref);
+    std::vector<Particle> roundTrip;
+    soa.ToAoS(roundTrip);
+    bool identity = true;
+    for (size_t i = 0; identity && i < N; ++i)
+    {
+        identity = roundTrip[i].position.x == ref[i].position.x
+                && roundTrip[i].position.y == ref[i].position.y
+                && roundTrip[i].position.z == ref[i].position.z
+                && roundTrip[i].velocity.x == ref[i].velocity.x
+                && roundTrip[i].velocity.y == ref[i].velocity.y
+                && roundTrip[i].velocity.z == ref[i].velocity.z
+                && roundTrip[i].damping == ref[i].damping
+                && roundTrip[i].inverseMass == ref[i].inverseMass;
+    }
+    Check("batch: SoA round-trip (FromAoS -> ToAoS) is the identity", identity);
+
+    const std::vector<Particle> initial = ref;   // for the immovable check
+
+    // Lockstep: per-particle oracle vs fused batch step, STEPS steps.
+    for (int s = 0; s < STEPS; ++s)
+    {
+        for (Particle& p : ref)
+        {
+            for (const ForceGen& gen : gens)
+                std::visit([&](const auto& g) { g.updateForce(p, dt); }, gen);
+            Integrate(p, dt);
+        }
+        StepAll(soa, gens, dt);
+    }
+
+    std::vector<Particle> got;
+    soa.ToAoS(got);
+    bool match = true;
+    bool finite = true;
+    for (size_t i = 0; i < N; ++i)
+    {
+        match = match
+             && got[i].position.x == ref[i].position.x
+             && got[i].position.y == ref[i].position.y
+             && got[i].position.z == ref[i].position.z
+             && got[i].velocity.x == ref[i].velocity.x
+             && got[i].velocity.y == ref[i].velocity.y
+             && got[i].velocity.z == ref[i].velocity.z;
+        finite = finite
+              && std::isfinite(got[i].position.x) && std::isfinite(got[i].position.y)
+              && std::isfinite(got[i].position.z);
+    }
+    Check("batch: positions/velocities match oracle exactly after 40 steps", match);
+    Check("batch: all positions stay finite", finite);
+
+    // Immovable particles never move through the batch path either.
+    bool immovableStill = true;
+    for (size_t i = 8; i < N; i += 9)
+    {
+        immovableStill = immovableStill
+                      && got[i].position.x == initial[i].position.x
+                      && got[i].position.y == initial[i].position.y
+                      && got[i].position.z == initial[i].position.z
+                      && got[i].velocity.x == initial[i].velocity.x
+                      && got[i].velocity.y == initial[i].velocity.y
+                      && got[i].velocity.z == initial[i].velocity.z;
+    }
+    Check("batch: immovable (inverseMass 0) particles do not move", immovableStill);
+}
+
 int main()
 {
     std::printf("=== HCP Section-1 Newtonian force-generator tests ===\n");
@@ -439,6 +549,7 @@ int main()
     TestDegenerate();
     TestConstantForce();
     TestIntegrator();
+    TestBatch();
     std::printf("=== %d passed, %d failed ===\n", g_pass, g_fail);
     return g_fail;
 }
@@ -0,0 +1,264 @@
+// test_primegrid.cpp — brute-force oracle tests for the prime-layer broadphase.
+//
+// Follows the project's standalone test idiom (tools/byte-floor/test_bytefloor.cpp):
+// manual checks + printf, process exit code = number of failures.
+//
+// These pin what any class-interaction pass leans on:
+//   1. PhaseFilter semantics match the bit typology: class bits are
+//      require-set, axis bits are mask+pole (both poles meaningful).
+//   2. Grid range queries return EXACTLY the brute-force neighborhood —
+//      randomized positions, radii and filters; sets compared, since bucket
+//      order is documented nondeterministic.
+//   3. Parallel rebuild (sharded scatter) yields the same neighborhoods as a
+//      serial rebuild.
+//   4. Shrink-rebuild leaves no stale indices; the empty grid is inert.
+//   5. The interaction pass (InteractionBatch.h) is BIT-identical to its
+//      O(N²) reference — the sorted-candidate determinism contract.
+
+#include "../HCPPrimeGrid.h"
+#include "InteractionBatch.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace HCPEngine;
+using namespace hcp::forces;
+
+static int g_pass = 0, g_fail = 0;
+
+static void Check(const char* label, bool ok)
+{
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", label);
+    if (ok) ++g_pass; else ++g_fail;
+}
+
+// Phase-bit values mirroring HCPPrimePhases.h (that header is AZ-typed, so
+// the standalone test restates the reserved bits it exercises; the values are
+// part of the documented reserved map and AZ::u32 == uint32_t).
+static constexpr uint32_t I_NOT_I_MASK     = 1u << 19;
+static constexpr uint32_t VALENCE_MASK     = 1u << 18;
+static constexpr uint32_t SUBSTANTIVE_MASK = 1u << 13;
+static constexpr uint32_t ACTION_MASK      = 1u << 10;
+static constexpr uint32_t ENTITY_MASK      = 1u << 9;
+
+struct Population
+{
+    std::vector<float> posX, posY, posZ;
+    std::vector<uint32_t> phases;
+    size_t Count() const { return posX.size(); }
+};
+
+static Population RandomPopulation(size_t n, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+    std::uniform_int_distribution<uint32_t> bits(0u, 0xFFFFFu);   // 20-bit phases
+
+    Population p;
+    p.posX.resize(n); p.posY.resize(n); p.posZ.resize(n);
+    p.phases.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        p.posX[i] = coord(rng);
+        p.posY[i] = coord(rng);
+        p.posZ[i] = coord(rng);
+        p.phases[i] = bits(rng);
+    }
+    return p;
+}
+
+// The oracle: exact sphere membership by exhaustive scan.
+static std::vector<uint32_t> BruteForceQuery(const Population& p,
+    float x, float y, float z, float radius, const PhaseFilter& filter)
+{
+    std::vector<uint32_t> hits;
+    const float r2 = radius * radius;
+    for (size_t i = 0; i < p.Count(); ++i)
+    {
+        if (!filter.Accepts(p.phases[i]))
+            continue;
+        const float dx = p.posX[i] - x;
+        const float dy = p.posY[i] - y;
+        const float dz = p.posZ[i] - z;
+        if (dx * dx + dy * dy + dz * dz <= r2)
+            hits.push_back(static_cast<uint32_t>(i));
+    }
+    return hits;
+}
+
+static std::vector<uint32_t> GridQuery(const PrimeGrid& grid,
+    float x, float y, float z, float radius, const PhaseFilter& filter)
+{
+    std::vector<uint32_t> hits;
+    grid.ForEachInRadius(x, y, z, radius, filter,
+        [&](uint32_t i) { hits.push_back(i); });
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+int main()
+{
+    // ---- 1. PhaseFilter semantics --------------------------------------
+    {
+        PhaseFilter classOnly;
+        classOnly.classMask = SUBSTANTIVE_MASK | ENTITY_MASK;
+        Check("class bits: all required set accepts",
+              classOnly.Accepts(SUBSTANTIVE_MASK | ENTITY_MASK | VALENCE_MASK));
+        Check("class bits: missing one rejects",
+              !classOnly.Accepts(SUBSTANTIVE_MASK));
+
+        PhaseFilter badPole;       // VALENCE pinned to the BAD pole (bit set)
+        badPole.axisMask = VALENCE_MASK;
+        badPole.axisValue = VALENCE_MASK;
+        Check("axis pole: set pole accepts", badPole.Accepts(VALENCE_MASK | ACTION_MASK));
+        Check("axis pole: clear pole rejects", !badPole.Accepts(ACTION_MASK));
+
+        PhaseFilter goodPole;      // same axis, opposite pole (bit clear)
+        goodPole.axisMask = VALENCE_MASK;
+        goodPole.axisValue = 0;
+        Check("axis pole: clear pole is a real state", goodPole.Accepts(ACTION_MASK));
+        Check("axisMask 0 means any pole", PhaseFilter{}.Accepts(I_NOT_I_MASK));
+    }
+
+    // ---- 2. Randomized grid-vs-brute-force queries ---------------------
+    {
+        const Population p = RandomPopulation(200000, 1u);
+        PrimeGrid grid(2.0f, 18u);
+        grid.Rebuild(p.posX.data(), p.posY.data(), p.posZ.data(),
+                     p.phases.data(), p.Count());
+
+        std::mt19937 rng(2u);
+        std::uniform_real_distribution<float> coord(-55.0f, 55.0f);
+        std::uniform_real_distribution<float> rad(0.1f, 6.0f);
+        std::uniform_int_distribution<uint32_t> bits(0u, 0xFFFFFu);
+
+        bool allEqual = true;
+        size_t totalHits = 0;
+        for (int q = 0; q < 200; ++q)
+        {
+            PhaseFilter filter;
+            switch (q % 4)
+            {
+            case 0: break;                                      // no filter
+            case 1: filter.classMask = SUBSTANTIVE_MASK; break;
+            case 2: filter.axisMask = I_NOT_I_MASK | VALENCE_MASK;
+                    filter.axisValue = bits(rng) & filter.axisMask; break;
+            case 3: filter.classMask = ACTION_MASK;
+                    filter.axisMask = VALENCE_MASK;
+                    filter.axisValue = (q & 8) ? VALENCE_MASK : 0u; break;
+            }
+            const float x = coord(rng), y = coord(rng), z = coord(rng);
+            const float r = rad(rng);
+            const auto expect = BruteForceQuery(p, x, y, z, r, filter);
+            const auto got = GridQuery(grid, x, y, z, r, filter);
+            totalHits += expect.size();
+            if (got != expect)
+                allEqual = false;
+        }
+        Check("200 randomized filtered queries match brute force", allEqual);
+        Check("queries actually hit particles", totalHits > 0);
+    }
+
+    // ---- 3. Parallel rebuild == serial rebuild -------------------------
+    {
+        // Above the serial cutoff so the sharded passes actually run.
+        const Population p = RandomPopulation(100000, 3u);
+        PrimeGrid serial(2.0f, 17u), parallel(2.0f, 17u);
+        serial.Rebuild(p.posX.data(), p.posY.data(), p.posZ.data(),
+                       p.phases.data(), p.Count(), 1);
+        parallel.Rebuild(p.posX.data(), p.posY.data(), p.posZ.data(),
+                         p.phases.data(), p.Count(), 4);
+
+        bool equal = true;
+        for (int q = 0; q < 50 && equal; ++q)
+        {
+            const float x = -50.0f + 2.0f * q, r = 3.5f;
+            equal = GridQuery(serial, x, 0.0f, x * 0.5f, r, PhaseFilter{})
+                 == GridQuery(parallel, x, 0.0f, x * 0.5f, r, PhaseFilter{});
+        }
+        Check("parallel rebuild matches serial rebuild", equal);
+    }
+
+    // ---- 4. Shrink-rebuild and empty grid ------------------------------
+    {
+        Population p = RandomPopulation(5000, 4u);
+        PrimeGrid grid(2.0f, 12u);
+        grid.Rebuild(p.posX.data(), p.posY.data(), p.posZ.data(),
+                     p.phases.data(), p.Count());
+
+        // Rebuild over a prefix: indices >= the new count must never appear.
+        const size_t shrunk = 100;
+        grid.Rebuild(p.posX.data(), p.posY.data(), p.posZ.data(),
+                     p.phases.data(), shrunk);
+        bool inRange = true;
+        grid.ForEachInRadius(0.0f, 0.0f, 0.0f, 200.0f, PhaseFilter{},
+            [&](uint32_t i) { if (i >= shrunk) inRange = false; });
+        Check("shrink-rebuild drops stale indices", inRange);
+        Check("shrink-rebuild matches brute force over the prefix",
+              GridQuery(grid, 0.0f, 0.0f, 0.0f, 20.0f, PhaseFilter{})
+              == [&] {
+                     Population prefix = p;
+                     prefix.posX.resize(shrunk); prefix.posY.resize(shrunk);
+                     prefix.posZ.resize(shrunk); prefix.phases.resize(shrunk);
+                     return BruteForceQuery(prefix, 0.0f, 0.0f, 0.0f, 20.0f, PhaseFilter{});
+                 }());
+
+        grid.Rebuild(nullptr, nullptr, nullptr, nullptr, 0);
+        int calls = 0;
+        grid.ForEachInRadius(0.0f, 0.0f, 0.0f, 100.0f, PhaseFilter{},
+            [&](uint32_t) { ++calls; });
+        Check("empty grid visits nothing", calls == 0);
+    }
+
+    // ---- 5. Interaction pass bit-identical to its O(N²) reference ------
+    {
+        const Population pop = RandomPopulation(4000, 5u);
+        ParticleSoA gridSide, refSide;
+        gridSide.Resize(pop.Count());
+        for (size_t i = 0; i < pop.Count(); ++i)
+        {
+            gridSide.posX[i] = pop.posX[i];
+            gridSide.posY[i] = pop.posY[i];
+            gridSide.posZ[i] = pop.posZ[i];
+        }
+        refSide = gridSide;
+
+        std::vector<InteractionRule> rules(2);
+        rules[0].source.classMask = SUBSTANTIVE_MASK;      // things repel things
+        rules[0].target.classMask = SUBSTANTIVE_MASK;
+        rules[0].radius = 3.0f;
+        rules[0].strength = 0.75f;
+        rules[1].source.classMask = ACTION_MASK;           // actions drawn toward
+        rules[1].target.classMask = SUBSTANTIVE_MASK;      // BAD-pole things
+        rules[1].target.axisMask = VALENCE_MASK;
+        rules[1].target.axisValue = VALENCE_MASK;
+        rules[1].radius = 5.0f;
+        rules[1].strength = -0.25f;
+
+        PrimeGrid grid(3.0f, 13u);
+        grid.Rebuild(gridSide.posX.data(), gridSide.posY.data(), gridSide.posZ.data(),
+                     pop.phases.data(), pop.Count());
+        ApplyInteractions(gridSide, pop.phases, grid, rules);
+        for (const InteractionRule& rule : rules)
+            ApplyInteractionReference(refSide, pop.phases, rule);
+
+        const bool bitEqual =
+            std::memcmp(gridSide.forceX.data(), refSide.forceX.data(),
+                        pop.Count() * sizeof(float)) == 0
+         && std::memcmp(gridSide.forceY.data(), refSide.forceY.data(),
+                        pop.Count() * sizeof(float)) == 0
+         && std::memcmp(gridSide.forceZ.data(), refSide.forceZ.data(),
+                        pop.Count() * sizeof(float)) == 0;
+        Check("interaction pass bit-identical to O(N^2) reference", bitEqual);
+
+        float sum = 0.0f;
+        for (float f : gridSide.forceX) sum += std::fabs(f);
+        Check("interaction pass produced nonzero forces", sum > 0.0f);
+    }
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail;
+}
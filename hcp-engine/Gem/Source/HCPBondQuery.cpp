@@ -9,16 +9,29 @@ namespace HCPEngine
         int docPk, const AZStd::string& tokenId)
     {
         AZStd::vector<BondEntry> bonds;
+
+        AZStd::string cacheKey = AZStd::to_string(docPk) + "|" + tokenId;
+        auto cached = m_bondCache.find(cacheKey);
+        if (cached != m_bondCache.end())
+        {
+            if (cached->second.first.Fresh())
+            {
+                return cached->second.second;
+            }
+            m_bondCache.erase(cached);
+        }
+
         PGconn* pg = m_conn.Get();
         if (!pg) return bonds;
 
         AZStd::string pkStr = AZStd::to_string(docPk);
+        bool complete = true;
 
         if (tokenId.empty())
         {
             // Overview mode: top starters by total bond count
             const char* params[] = { pkStr.c_str() };
-            PGresult* res = PQexecParams(pg,
+            PGresult* res = m_conn.ExecPrepared("bondq_overview",
                 "SELECT s.token_a_id, "
                 "  COALESCE((SELECT SUM(wb.count) FROM pbm_word_bonds wb WHERE wb.starter_id = s.id), 0) + "
                 "  COALESCE((SELECT SUM(cb.count) FROM pbm_char_bonds cb WHERE cb.starter_id = s.id), 0) + "
@@ -26,7 +39,7 @@ namespace HCPEngine
                 "  COALESCE((SELECT SUM(vb.count) FROM pbm_var_bonds vb WHERE vb.starter_id = s.id), 0) AS total "
                 "FROM pbm_starters s WHERE s.doc_id = $1 "
                 "ORDER BY total DESC LIMIT 50",
-                1, nullptr, params, nullptr, nullptr, 0);
+                1, params);
             if (PQresultStatus(res) == PGRES_TUPLES_OK)
             {
                 for (int i = 0; i < PQntuples(res); ++i)
@@ -43,10 +56,10 @@ namespace HCPEngine
         {
             // Drill-down: bonds for a specific A-side token
             const char* params[] = { pkStr.c_str(), tokenId.c_str() };
-            PGresult* res = PQexecParams(pg,
+            PGresult* res = m_conn.ExecPrepared("bondq_starter_id",
                 "SELECT s.id FROM pbm_starters s "
-                "WHERE s.doc_id = $1 AND s.token_a_id = $2",
-                2, nullptr, params, nullptr, nullptr, 0);
+                "WHERE s.doc_id = $1::integer AND s.token_a_id = $2",
+                2, params);
             if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) == 0)
             {
                 PQclear(res);
@@ -57,89 +70,69 @@ namespace HCPEngine
 
             AZStd::string sidStr = AZStd::to_string(starterId);
 
-            // Word bonds
+            // All four subtable scans are independent — pipeline them so the
+            // drill-down costs one round trip instead of four. Every query
+            // yields the same (token_b, count) shape, collected in queue order.
+            if (!m_conn.PipelineBegin())
             {
-                const char* p[] = { sidStr.c_str() };
-                res = PQexecParams(pg,
-                    "SELECT 'AB.AB.' || b_p3 || '.' || b_p4 || '.' || b_p5, count "
-                    "FROM pbm_word_bonds WHERE starter_id = $1 ORDER BY count DESC",
-                    1, nullptr, p, nullptr, nullptr, 0);
-                if (PQresultStatus(res) == PGRES_TUPLES_OK)
-                {
-                    for (int i = 0; i < PQntuples(res); ++i)
-                    {
-                        BondEntry be;
-                        be.tokenB = PQgetvalue(res, i, 0);
-                        be.count = atoi(PQgetvalue(res, i, 1));
-                        bonds.push_back(AZStd::move(be));
-                    }
-                }
-                PQclear(res);
+                return bonds;
             }
 
-            // Char bonds
-            {
-                const char* p[] = { sidStr.c_str() };
-                res = PQexecParams(pg,
-                    "SELECT 'AA.' || b_p2 || '.' || b_p3 || '.' || b_p4 || '.' || b_p5, count "
-                    "FROM pbm_char_bonds WHERE starter_id = $1 ORDER BY count DESC",
-                    1, nullptr, p, nullptr, nullptr, 0);
-                if (PQresultStatus(res) == PGRES_TUPLES_OK)
-                {
-                    for (int i = 0; i < PQntuples(res); ++i)
-                    {
-                        BondEntry be;
-                        be.tokenB = PQgetvalue(res, i, 0);
-                        be.count = atoi(PQgetvalue(res, i, 1));
-                        bonds.push_back(AZStd::move(be));
-                    }
-                }
-                PQclear(res);
-            }
+            const char* sid[] = { sidStr.c_str() };
+            m_conn.PipelineQueue("bondq_word",
+                "SELECT 'AB.AB.' || b_p3 || '.' || b_p4 || '.' || b_p5, count "
+                "FROM pbm_word_bonds WHERE starter_id = $1::integer ORDER BY count DESC",
+                1, sid);
+            m_conn.PipelineQueue("bondq_char",
+                "SELECT 'AA.' || b_p2 || '.' || b_p3 || '.' || b_p4 || '.' || b_p5, count "
+                "FROM pbm_char_bonds WHERE starter_id = $1::integer ORDER BY count DESC",
+                1, sid);
+            m_conn.PipelineQueue("bondq_marker",
+                "SELECT 'AA.AE.' || b_p3 || '.' || b_p4, count "
+                "FROM pbm_marker_bonds WHERE starter_id = $1::integer ORDER BY count DESC",
+                1, sid);
+            const char* sidAndDoc[] = { sidStr.c_str(), pkStr.c_str() };
+            m_conn.PipelineQueue("bondq_var",
+                "SELECT COALESCE(dv.surface, vb.b_var_id), vb.count "
+                "FROM pbm_var_bonds vb "
+                "LEFT JOIN pbm_docvars dv ON dv.doc_id = $2::integer AND dv.var_id = vb.b_var_id "
+                "WHERE vb.starter_id = $1::integer ORDER BY vb.count DESC",
+                2, sidAndDoc);
 
-            // Marker bonds
+            for (PGresult* sub : m_conn.PipelineDrain())
             {
-                const char* p[] = { sidStr.c_str() };
-                res = PQexecParams(pg,
-                    "SELECT 'AA.AE.' || b_p3 || '.' || b_p4, count "
-                    "FROM pbm_marker_bonds WHERE starter_id = $1 ORDER BY count DESC",
-                    1, nullptr, p, nullptr, nullptr, 0);
-                if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                if (PQresultStatus(sub) == PGRES_TUPLES_OK)
                 {
-                    for (int i = 0; i < PQntuples(res); ++i)
+                    for (int i = 0; i < PQntuples(sub); ++i)
                     {
                         BondEntry be;
-                        be.tokenB = PQgetvalue(res, i, 0);
-                        be.count = atoi(PQgetvalue(res, i, 1));
+                        be.tokenB = PQgetvalue(sub, i, 0);
+                        be.count = atoi(PQgetvalue(sub, i, 1));
                         bonds.push_back(AZStd::move(be));
                     }
                 }
-                PQclear(res);
-            }
-
-            // Var bonds
-            {
-                const char* p[] = { sidStr.c_str(), pkStr.c_str() };
-                res = PQexecParams(pg,
-                    "SELECT COALESCE(dv.surface, vb.b_var_id), vb.count "
-                    "FROM pbm_var_bonds vb "
-                    "LEFT JOIN pbm_docvars dv ON dv.doc_id = $2::integer AND dv.var_id = vb.b_var_id "
-                    "WHERE vb.starter_id = $1::integer ORDER BY vb.count DESC",
-                    2, nullptr, p, nullptr, nullptr, 0);
-                if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                else
                 {
-                    for (int i = 0; i < PQntuples(res); ++i)
-                    {
-                        BondEntry be;
-                        be.tokenB = PQgetvalue(res, i, 0);
-                        be.count = atoi(PQgetvalue(res, i, 1));
-                        bonds.push_back(AZStd::move(be));
-                    }
+                    // A mid-pipeline failure aborts the later sub-results
+                    // (PGRES_PIPELINE_ABORTED) — the drill-down is truncated,
+                    // not empty. Return it uncached rather than pinning an
+                    // incomplete result for the whole TTL window.
+                    complete = false;
                 }
-                PQclear(res);
+                PQclear(sub);
             }
         }
 
+        if (!complete)
+        {
+            return bonds;
+        }
+        if (m_bondCache.size() >= BOND_CACHE_MAX)
+        {
+            m_bondCache.clear();
+        }
+        m_bondCache[cacheKey] = { QueryCache::Stamp::Now(), bonds };
+
         return bonds;
     }
 
@@ -151,7 +144,7 @@ namespace HCPEngine
 
         AZStd::string pkStr = AZStd::to_string(docPk);
         const char* params[] = { pkStr.c_str() };
-        PGresult* res = PQexecParams(pg,
+        PGresult* res = m_conn.ExecPrepared("bondq_all_starters",
             "SELECT s.token_a_id, "
             "  COALESCE((SELECT SUM(wb.count) FROM pbm_word_bonds wb WHERE wb.starter_id = s.id), 0) + "
             "  COALESCE((SELECT SUM(cb.count) FROM pbm_char_bonds cb WHERE cb.starter_id = s.id), 0) + "
@@ -159,7 +152,7 @@ namespace HCPEngine
             "  COALESCE((SELECT SUM(vb.count) FROM pbm_var_bonds vb WHERE vb.starter_id = s.id), 0) AS total "
             "FROM pbm_starters s WHERE s.doc_id = $1 "
             "ORDER BY total DESC",
-            1, nullptr, params, nullptr, nullptr, 0);
+            1, params);
         if (PQresultStatus(res) == PGRES_TUPLES_OK)
         {
             for (int i = 0; i < PQntuples(res); ++i)
@@ -1,14 +1,20 @@
 #pragma once
 
 #include "HCPDbConnection.h"
+#include "HCPQueryCache.h"
 #include <AzCore/base.h>
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/utils.h>
 
 namespace HCPEngine
 {
     //! Bond query kernel.
     //! Drill-down queries into PBM bond subtables for a specific document.
+    //! GetBondsForToken caches its results (TTL + store-generation validation,
+    //! see HCPQueryCache.h) — the bond view re-requests the same overview and
+    //! drill-downs on every refresh.
     class HCPBondQuery
     {
     public:
@@ -20,7 +26,7 @@ namespace HCPEngine
             int count = 0;
         };
 
-        //! Get bonds for a specific token in a document.
+        //! Get bonds for a specific token in a document. Cached.
         //! If tokenId is empty, returns top starters with their total bond counts.
         AZStd::vector<BondEntry> GetBondsForToken(int docPk, const AZStd::string& tokenId);
 
@@ -29,6 +35,12 @@ namespace HCPEngine
 
     private:
         HCPDbConnection& m_conn;
+
+        // Keyed "<docPk>|<tokenId>". One kernel per socket worker, so no
+        // locking; cross-worker invalidation rides the generation stamp.
+        static constexpr size_t BOND_CACHE_MAX = 256;
+        AZStd::unordered_map<AZStd::string,
+            AZStd::pair<QueryCache::Stamp, AZStd::vector<BondEntry>>> m_bondCache;
     };
 
 } // namespace HCPEngine
@@ -1,9 +1,10 @@
 #include "HCPByteIngest.h"
+#include "HCPCharClass.h"
 #include "HCPVocabBed.h"   // BedManager
 
 #include "../../../tools/byte-floor/bytefloor.h"
 
-#include <cctype>
+#include <vector>
 
 namespace HCPEngine
 {
@@ -11,9 +12,6 @@ namespace HCPEngine
     {
         using Elem = hcp::bytefloor::Elem;
 
-        bool IsWs(uint32_t c)    { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; }
-        bool IsPunct(uint32_t c) { return c < 0x80 && std::ispunct(static_cast<int>(c)) != 0; }
-
         void AppendUtf8(uint32_t cp, AZStd::string& out)
         {
             if      (cp < 0x80)    out += char(cp);
@@ -23,60 +21,125 @@ namespace HCPEngine
         }
 
         bool IsCodepoint(const Elem& e) { return e.kind == Elem::Codepoint; }
+
+        //! Segment a resolved element stream into runs (whitespace-delimited, edge-punct
+        //! stripped, lowercased), carrying the byte span up from the byte-floor positional
+        //! map. charBase/byteBase shift positions to document-global values so the
+        //! streaming path (ByteIngestStream) emits the same runs as the one-shot path.
+        void SegmentElems(const hcp::bytefloor::Result& r, AZ::u32 charBase, AZ::u32 byteBase,
+                          AZStd::vector<CharRun>& runs)
+        {
+            const auto& E = r.elems;
+            const AZ::u32 n = static_cast<AZ::u32>(E.size());
+
+            // Classify every element ONCE up front (HCPCharClass.h) — the
+            // delimiter scan, edge strip and core-build passes below each
+            // used to re-ask cctype per character; now they test bits of the
+            // packed class byte. Residue bytes classify as carried-verbatim.
+            std::vector<AZ::u8> cls(n);
+            for (AZ::u32 j = 0; j < n; ++j)
+                cls[j] = IsCodepoint(E[j]) ? CharClass::Classify(E[j].value) : 0;
+
+            AZ::u32 i = 0;
+            while (i < n)
+            {
+                while (i < n && (cls[i] & CharClass::WS)) ++i;                        // skip whitespace
+                if (i >= n) break;
+
+                AZ::u32 chunkStart = i;
+                while (i < n && !(cls[i] & CharClass::WS)) ++i;                       // collect to next whitespace
+
+                AZ::u32 cs = chunkStart, ce = i;                                      // strip edge punctuation
+                while (cs < ce && (cls[cs]   & CharClass::PUNCT)) ++cs;
+                while (ce > cs && (cls[ce-1] & CharClass::PUNCT)) --ce;
+                if (ce <= cs) continue;
+
+                CharRun run;
+                run.startPos  = charBase + cs;                                        // character (codepoint) position
+                run.length    = ce - cs;
+                run.byteStart = byteBase + E[cs].srcOffset;                           // positional map: source bytes
+                run.byteLen   = E[ce-1].srcOffset + E[ce-1].srcLen - E[cs].srcOffset;
+
+                AZStd::string core;
+                core.reserve(ce - cs);
+                AZ::u32 capCount = 0;
+                for (AZ::u32 j = cs; j < ce; ++j)
+                {
+                    const uint32_t v = E[j].value;
+                    if (IsCodepoint(E[j]) && v < 0x80)
+                    {
+                        if (cls[j] & CharClass::UPPER)
+                        {
+                            if (j - cs < 64) run.capMask |= AZ::u64(1) << (j - cs);
+                            ++capCount;
+                            if (j == cs) run.firstCap = true;
+                            core += static_cast<char>(v | 0x20);                      // ASCII fold
+                        }
+                        else
+                        {
+                            core += static_cast<char>(v);
+                        }
+                    }
+                    else if (IsCodepoint(E[j])) { AppendUtf8(v, core); }              // non-ASCII: carried, not dropped
+                    else                        { core += static_cast<char>(v & 0xFF); } // residue byte: carried
+                }
+                run.allCaps = (capCount != 0 && capCount == run.length);
+                run.text    = AZStd::move(core);
+                run.tag     = RunTag::Word;
+                runs.push_back(AZStd::move(run));
+            }
+        }
     }
 
     AZStd::vector<CharRun> IngestBytes(const uint8_t* data, size_t len)
     {
         AZStd::vector<CharRun> runs;
 
+        // One run per ~6 source bytes (average word plus delimiter) — size
+        // the vector up front so a novel doesn't regrow it dozens of times.
+        runs.reserve(len / 6 + 1);
+
         // Stage 1: bytes -> positioned characters (the byte-floor, replacing PhysX Phase-1).
-        hcp::bytefloor::Result r = hcp::bytefloor::resolve(data, len);
-        const auto& E = r.elems;
-        const AZ::u32 n = static_cast<AZ::u32>(E.size());
+        // Stage 2: segment the character stream into runs.
+        SegmentElems(hcp::bytefloor::resolve(data, len), 0, 0, runs);
 
-        // Stage 2: segment the character stream into runs (whitespace-delimited, edge-punct
-        // stripped, lowercased), carrying the byte span up from the byte-floor positional map.
-        AZ::u32 i = 0;
-        while (i < n)
+        return runs;
+    }
+
+    void ByteIngestStream::Feed(const uint8_t* data, size_t len, AZStd::vector<CharRun>& outRuns)
+    {
+        m_totalBytes += len;
+        m_carry.append(reinterpret_cast<const char*>(data), len);
+
+        // Split at the LAST ASCII whitespace in hand: everything before it is safe to
+        // segment now (runs are whitespace-delimited), the tail may continue in the next
+        // chunk. ASCII whitespace bytes never occur inside a UTF-8 sequence, so a raw
+        // byte scan cannot split a codepoint.
+        size_t split = m_carry.size();
+        while (split > 0
+            && !(CharClass::Classify(static_cast<unsigned char>(m_carry[split - 1])) & CharClass::WS))
+            --split;
+        if (split == 0) return;                                                   // no boundary yet — keep buffering
+
+        Segment(reinterpret_cast<const uint8_t*>(m_carry.data()), split, outRuns);
+        m_carry.erase(0, split);
+    }
+
+    void ByteIngestStream::Finish(AZStd::vector<CharRun>& outRuns)
+    {
+        if (!m_carry.empty())
         {
-            while (i < n && IsCodepoint(E[i]) && IsWs(E[i].value)) ++i;          // skip whitespace
-            if (i >= n) break;
-
-            AZ::u32 chunkStart = i;
-            while (i < n && !(IsCodepoint(E[i]) && IsWs(E[i].value))) ++i;        // collect to next whitespace
-
-            AZ::u32 cs = chunkStart, ce = i;                                      // strip edge punctuation
-            while (cs < ce && IsCodepoint(E[cs])   && IsPunct(E[cs].value))   ++cs;
-            while (ce > cs && IsCodepoint(E[ce-1]) && IsPunct(E[ce-1].value)) --ce;
-            if (ce <= cs) continue;
-
-            CharRun run;
-            run.startPos  = cs;                                                   // character (codepoint) position
-            run.length    = ce - cs;
-            run.byteStart = E[cs].srcOffset;                                      // positional map: source bytes
-            run.byteLen   = E[ce-1].srcOffset + E[ce-1].srcLen - E[cs].srcOffset;
-
-            AZStd::string core;
-            core.reserve(ce - cs);
-            for (AZ::u32 j = cs; j < ce; ++j)
-            {
-                const uint32_t v = E[j].value;
-                if (IsCodepoint(E[j]) && v < 0x80)
-                {
-                    const unsigned char uc = static_cast<unsigned char>(v);
-                    if (std::isupper(uc)) { run.capMask.push_back(j - cs); if (j == cs) run.firstCap = true; }
-                    core += static_cast<char>(std::tolower(uc));
-                }
-                else if (IsCodepoint(E[j])) { AppendUtf8(v, core); }              // non-ASCII: carried, not dropped
-                else                        { core += static_cast<char>(v & 0xFF); } // residue byte: carried
-            }
-            run.allCaps = (!run.capMask.empty() && run.capMask.size() == run.length);
-            run.text    = AZStd::move(core);
-            run.tag     = RunTag::Word;
-            runs.push_back(AZStd::move(run));
+            Segment(reinterpret_cast<const uint8_t*>(m_carry.data()), m_carry.size(), outRuns);
+            m_carry.clear();
         }
+    }
 
-        return runs;
+    void ByteIngestStream::Segment(const uint8_t* data, size_t len, AZStd::vector<CharRun>& outRuns)
+    {
+        hcp::bytefloor::Result r = hcp::bytefloor::resolve(data, len);
+        SegmentElems(r, m_charBase, m_byteBase, outRuns);
+        m_charBase += static_cast<AZ::u32>(r.elems.size());
+        m_byteBase += static_cast<AZ::u32>(len);
     }
 
     ResolutionManifest ResolveBytes(BedManager& bed, const uint8_t* data, size_t len)
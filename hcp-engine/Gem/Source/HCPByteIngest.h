@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
 #include <cstdint>
 #include <cstddef>
 
@@ -21,4 +22,31 @@ namespace HCPEngine
     //! Convenience: ingest bytes and resolve them to words in one call — the connected path,
     //! bytes -> characters -> words.
     ResolutionManifest ResolveBytes(BedManager& bed, const uint8_t* data, size_t len);
+
+    //! Streaming variant of IngestBytes for chunked arrivals (socket ingest).
+    //! Feed() segments everything up to the last whitespace in hand and holds the
+    //! unterminated tail back for the next chunk; Finish() flushes that tail.
+    //! Emitted runs carry document-global char/byte positions, so the combined
+    //! output is identical to one IngestBytes() call over the whole document —
+    //! but peak memory is a chunk plus the tail, not the document.
+    class ByteIngestStream
+    {
+    public:
+        //! Feed one chunk; completed runs are appended to outRuns.
+        void Feed(const uint8_t* data, size_t len, AZStd::vector<CharRun>& outRuns);
+
+        //! Flush the held-back tail (call once, after the last chunk).
+        void Finish(AZStd::vector<CharRun>& outRuns);
+
+        //! Total bytes fed so far.
+        size_t TotalBytes() const { return m_totalBytes; }
+
+    private:
+        void Segment(const uint8_t* data, size_t len, AZStd::vector<CharRun>& outRuns);
+
+        AZStd::string m_carry;     // bytes after the last whitespace boundary
+        AZ::u32 m_charBase = 0;    // codepoint position of the next segment's start
+        AZ::u32 m_byteBase = 0;    // source byte offset of the next segment's start
+        size_t m_totalBytes = 0;
+    };
 }
@@ -1,15 +1,36 @@
 #include "HCPCacheMissResolver.h"
 #include "HCPDbUtils.h"
 
+#include <AzCore/std/containers/unordered_set.h>
+
 #include <lmdb.h>
 #include <libpq-fe.h>
 #include <cstdio>
 #include <cstring>
 #include <cctype>
+#include <cstdlib>
+#include <chrono>
 
 namespace HCPEngine
 {
 
+    // Group-commit thresholds: a batch goes to LMDB once it reaches
+    // GROUP_COMMIT_MAX_ENTRIES writes or the oldest staged entry has waited
+    // GROUP_COMMIT_MAX_WAIT_MS, whichever comes first.
+    static constexpr size_t GROUP_COMMIT_MAX_ENTRIES = 256;
+    static constexpr int    GROUP_COMMIT_MAX_WAIT_MS = 25;
+
+    // Overlay entries are keyed "<sub-db>\0<key>" — sub-db names never
+    // contain NUL, so the pair packs into one string without ambiguity.
+    static AZStd::string OverlayKey(const AZStd::string& subDbName,
+                                    const char* key, size_t keyLen)
+    {
+        AZStd::string packed(subDbName);
+        packed.append(1, '\0');
+        packed.append(key, keyLen);
+        return packed;
+    }
+
     // ---- CacheMissResolver ----
 
     CacheMissResolver::~CacheMissResolver()
@@ -19,6 +40,8 @@ namespace HCPEngine
 
     void CacheMissResolver::Shutdown()
     {
+        StopCommitThread();
+
         for (auto& [name, conn] : m_pgConns)
         {
             if (conn)
@@ -39,6 +62,17 @@ namespace HCPEngine
     void CacheMissResolver::SetLmdbEnv(MDB_env* env)
     {
         m_env = env;
+
+        // Reader daemons (HCP_LMDB_READONLY) share the writer's environment:
+        // misses still resolve from Postgres, but the cache fill is skipped —
+        // only the writer process populates LMDB.
+        m_lmdbReadOnly = false;
+        if (m_env)
+        {
+            unsigned int envFlags = 0;
+            mdb_env_get_flags(m_env, &envFlags);
+            m_lmdbReadOnly = (envFlags & MDB_RDONLY) != 0;
+        }
     }
 
     void CacheMissResolver::SetLmdbDbi(const char* subDbName, MDB_dbi dbi)
@@ -82,6 +116,17 @@ namespace HCPEngine
         const char* key, size_t keyLen,
         const ResolveContext& context)
     {
+        const bool groupCommit = GroupCommitEnabled() && m_env && !m_lmdbReadOnly;
+
+        // A staged-but-uncommitted fill answers repeat misses without a
+        // second round trip to Postgres.
+        if (groupCommit)
+        {
+            AZStd::string staged;
+            if (OverlayGet(subDbName, key, keyLen, staged))
+                return staged;
+        }
+
         // Check for var_request prefix — routes to VarHandler
         AZStd::string handlerName;
         if (keyLen > VAR_PREFIX_LEN &&
@@ -106,9 +151,16 @@ namespace HCPEngine
             return {};
         }
 
-        // Execute all LMDB writes in a single transaction
-        if (!result.writes.empty() && m_env)
+        // Stage for the commit thread, or execute all LMDB writes in a
+        // single transaction
+        if (!result.writes.empty() && m_env && !m_lmdbReadOnly)
         {
+            if (groupCommit)
+            {
+                EnqueueWrites(result.writes);
+                return result.value;
+            }
+
             MDB_txn* txn;
             int rc = mdb_txn_begin(m_env, nullptr, 0, &txn);
             if (rc == 0)
@@ -151,7 +203,17 @@ namespace HCPEngine
         const void* key, size_t keyLen,
         const void* value, size_t valueLen)
     {
-        if (!m_env) return false;
+        if (!m_env || m_lmdbReadOnly) return false;
+
+        if (GroupCommitEnabled())
+        {
+            AZStd::vector<ResolveResult::LmdbWrite> writes;
+            writes.push_back({ AZStd::string(subDbName),
+                               AZStd::string(static_cast<const char*>(key), keyLen),
+                               AZStd::string(static_cast<const char*>(value), valueLen) });
+            EnqueueWrites(writes);
+            return true;
+        }
 
         auto it = m_dbis.find(AZStd::string(subDbName));
         if (it == m_dbis.end()) return false;
@@ -192,6 +254,325 @@ namespace HCPEngine
         return true;
     }
 
+    // ---------------------------------------------------------------------------
+    // Group commit. One writer thread drains the staging queue and commits each
+    // batch in a single LMDB transaction; the overlay map covers the window
+    // between a miss resolving and its batch landing. The request asked for a
+    // lock-free buffer — a mutex-guarded deque (the prefetch-lane idiom) is
+    // plenty here: the critical sections are a push or a swap, never a commit.
+    // ---------------------------------------------------------------------------
+
+    bool CacheMissResolver::GroupCommitEnabled()
+    {
+        // Default OFF; HCP_RESOLVER_GROUP_COMMIT=1 batches cache fills.
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_RESOLVER_GROUP_COMMIT");
+            return v && v[0] != '\0' && v[0] != '0';
+        }();
+        return enabled;
+    }
+
+    void CacheMissResolver::EnqueueWrites(AZStd::vector<ResolveResult::LmdbWrite>& writes)
+    {
+        std::lock_guard<std::mutex> lock(m_commitMutex);
+        if (m_commitStop) return;
+
+        for (auto& write : writes)
+        {
+            m_overlay[OverlayKey(write.subDbName, write.key.c_str(), write.key.size())] =
+                write.value;
+            m_commitQueue.push_back(AZStd::move(write));
+        }
+
+        if (!m_commitRunning)
+        {
+            m_commitRunning = true;
+            m_commitThread = std::thread(&CacheMissResolver::CommitThreadMain, this);
+        }
+        m_commitWork.notify_one();
+    }
+
+    bool CacheMissResolver::OverlayGet(
+        const char* subDbName, const char* key, size_t keyLen,
+        AZStd::string& outValue) const
+    {
+        std::lock_guard<std::mutex> lock(m_commitMutex);
+        auto it = m_overlay.find(OverlayKey(AZStd::string(subDbName), key, keyLen));
+        if (it == m_overlay.end()) return false;
+        outValue = it->second;
+        return true;
+    }
+
+    void CacheMissResolver::CommitThreadMain()
+    {
+        std::unique_lock<std::mutex> lock(m_commitMutex);
+        for (;;)
+        {
+            m_commitWork.wait(lock, [&] { return m_commitStop || !m_commitQueue.empty(); });
+            if (m_commitQueue.empty() && m_commitStop) return;
+
+            // Give the queue a short window to reach a full batch before
+            // paying for a commit. Stop requests flush immediately.
+            if (!m_commitStop && m_commitQueue.size() < GROUP_COMMIT_MAX_ENTRIES)
+            {
+                m_commitWork.wait_for(lock,
+                    std::chrono::milliseconds(GROUP_COMMIT_MAX_WAIT_MS),
+                    [&] { return m_commitStop ||
+                                 m_commitQueue.size() >= GROUP_COMMIT_MAX_ENTRIES; });
+            }
+
+            std::deque<ResolveResult::LmdbWrite> batch;
+            batch.swap(m_commitQueue);
+
+            lock.unlock();
+            CommitBatch(batch);
+            lock.lock();
+
+            // Retire overlay entries the batch covered — unless a newer write
+            // for the same key has restaged it, in which case the entry stays
+            // until that write's own batch lands. A failed commit also clears
+            // its entries: the overlay is a window, not a store, and the next
+            // miss falls back to the resolve path.
+            for (const auto& write : batch)
+            {
+                auto it = m_overlay.find(
+                    OverlayKey(write.subDbName, write.key.c_str(), write.key.size()));
+                if (it != m_overlay.end() && it->second == write.value)
+                    m_overlay.erase(it);
+            }
+        }
+    }
+
+    bool CacheMissResolver::CommitBatch(const std::deque<ResolveResult::LmdbWrite>& batch)
+    {
+        if (!m_env || batch.empty()) return false;
+
+        // m_dbis is populated once during Load, before any miss can resolve —
+        // safe to read here without the commit mutex.
+        MDB_txn* txn;
+        int rc = mdb_txn_begin(m_env, nullptr, 0, &txn);
+        if (rc != 0)
+        {
+            fprintf(stderr, "[CacheMissResolver] group commit txn_begin: %s\n",
+                mdb_strerror(rc));
+            fflush(stderr);
+            return false;
+        }
+
+        for (const auto& write : batch)
+        {
+            auto dbiIt = m_dbis.find(write.subDbName);
+            if (dbiIt == m_dbis.end()) continue;
+
+            MDB_val k, v;
+            k.mv_data = const_cast<char*>(write.key.c_str());
+            k.mv_size = write.key.size();
+            v.mv_data = const_cast<char*>(write.value.c_str());
+            v.mv_size = write.value.size();
+
+            rc = mdb_put(txn, dbiIt->second, &k, &v, 0);
+            if (rc != 0)
+            {
+                fprintf(stderr, "[CacheMissResolver] group commit mdb_put(%s): %s\n",
+                    write.subDbName.c_str(), mdb_strerror(rc));
+                fflush(stderr);
+                mdb_txn_abort(txn);
+                return false;
+            }
+        }
+
+        rc = mdb_txn_commit(txn);
+        if (rc != 0)
+        {
+            fprintf(stderr, "[CacheMissResolver] group commit txn_commit: %s\n",
+                mdb_strerror(rc));
+            fflush(stderr);
+            return false;
+        }
+        return true;
+    }
+
+    void CacheMissResolver::StopCommitThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_commitMutex);
+            if (!m_commitRunning) return;
+            m_commitStop = true;
+            m_commitWork.notify_one();
+        }
+        m_commitThread.join();
+
+        std::lock_guard<std::mutex> lock(m_commitMutex);
+        m_commitRunning = false;
+        m_commitStop    = false;
+        m_commitQueue.clear();
+        m_overlay.clear();
+    }
+
+    // ---------------------------------------------------------------------------
+    // Mint batch. MintRecommendations accumulate across a document (possessive
+    // forms whose base resolved, hyphenated variants of known compounds) and
+    // land here at document commit. Everything is set-based: one ANY() lookup
+    // for the base token ids, one multi-row INSERT for the new forms — first
+    // contact with vocabulary-dense material pays two round trips instead of
+    // two per form.
+    // ---------------------------------------------------------------------------
+
+    AZ::u32 CacheMissResolver::ExecuteMintBatch(
+        const AZStd::vector<MintRecommendation>& recommendations)
+    {
+        if (recommendations.empty()) return 0;
+
+        // Dedupe by surface form — dense material recommends the same
+        // possessive dozens of times within one document.
+        AZStd::unordered_map<AZStd::string, const MintRecommendation*> unique;
+        for (const auto& rec : recommendations)
+        {
+            if (rec.surfaceForm.empty() || rec.baseWord.empty()) continue;
+            unique.emplace(rec.surfaceForm, &rec);
+        }
+        if (unique.empty()) return 0;
+
+        PGconn* conn = GetConnection("hcp_english");
+        if (!conn) return 0;
+
+        // CheckPossessives leaves baseTokenId blank ("filled when the base
+        // resolves") — by commit time the answer is one batched lookup. Probe
+        // exact and lowercase, prefer exact, same order WordHandler uses.
+        AZStd::unordered_map<AZStd::string, AZStd::string> wordToToken;
+        {
+            AZStd::unordered_set<AZStd::string> needed;
+            for (const auto& [surface, rec] : unique)
+            {
+                if (!rec->baseTokenId.empty()) continue;
+                needed.insert(rec->baseWord);
+
+                AZStd::string lower = rec->baseWord;
+                for (auto& c : lower)
+                    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c + 32);
+                needed.insert(lower);
+            }
+
+            if (!needed.empty())
+            {
+                AZStd::vector<AZStd::string> words(needed.begin(), needed.end());
+                AZStd::string arr = BuildTextArrayLiteral(words);
+
+                const char* paramValues[1] = { arr.c_str() };
+                int paramLengths[1] = { static_cast<int>(arr.size()) };
+                int paramFormats[1] = { 0 };
+
+                PGresult* res = PQexecParams(conn,
+                    "SELECT word, token_id FROM entries WHERE word = ANY($1::text[])",
+                    1, nullptr, paramValues, paramLengths, paramFormats, 0);
+
+                if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                {
+                    for (int i = 0; i < PQntuples(res); ++i)
+                        wordToToken[PQgetvalue(res, i, 0)] = PQgetvalue(res, i, 1);
+                }
+                PQclear(res);
+            }
+        }
+
+        // Pair each form with its base token id. Forms whose base never
+        // resolved are dropped — they stay unresolved runs, same as before.
+        AZStd::vector<AZStd::string> forms;
+        AZStd::vector<AZStd::string> tokens;
+        forms.reserve(unique.size());
+        tokens.reserve(unique.size());
+        AZ::u32 unresolvedBase = 0;
+
+        for (const auto& [surface, rec] : unique)
+        {
+            AZStd::string tokenId = rec->baseTokenId;
+            if (tokenId.empty())
+            {
+                auto it = wordToToken.find(rec->baseWord);
+                if (it == wordToToken.end())
+                {
+                    AZStd::string lower = rec->baseWord;
+                    for (auto& c : lower)
+                        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c + 32);
+                    it = wordToToken.find(lower);
+                }
+                if (it != wordToToken.end()) tokenId = it->second;
+            }
+
+            if (tokenId.empty()) { ++unresolvedBase; continue; }
+            forms.push_back(surface);
+            tokens.push_back(tokenId);
+        }
+
+        if (forms.empty())
+        {
+            fprintf(stderr, "[CacheMissResolver] Mint batch: %zu recommended, "
+                "%zu unique, 0 mintable (%u base unresolved)\n",
+                recommendations.size(), unique.size(), unresolvedBase);
+            fflush(stderr);
+            return 0;
+        }
+
+        // One set-based statement, one implicit transaction: unnest the pairs,
+        // skip forms already present (re-ingest), insert the rest. The minted
+        // form maps to the BASE token — morph bits are positional and
+        // re-derived at resolve time, so nothing else travels.
+        AZStd::string formArr = BuildTextArrayLiteral(forms);
+        AZStd::string tokenArr = BuildTextArrayLiteral(tokens);
+
+        const char* paramValues[2] = { formArr.c_str(), tokenArr.c_str() };
+        int paramLengths[2] = {
+            static_cast<int>(formArr.size()),
+            static_cast<int>(tokenArr.size())
+        };
+        int paramFormats[2] = { 0, 0 };
+
+        PGresult* res = PQexecParams(conn,
+            "INSERT INTO entries (word, token_id) "
+            "SELECT u.w, u.t FROM unnest($1::text[], $2::text[]) AS u(w, t) "
+            "WHERE NOT EXISTS (SELECT 1 FROM entries e WHERE e.word = u.w)",
+            2, nullptr, paramValues, paramLengths, paramFormats, 0);
+
+        if (PQresultStatus(res) != PGRES_COMMAND_OK)
+        {
+            fprintf(stderr, "[CacheMissResolver] mint batch INSERT failed: %s\n",
+                PQerrorMessage(conn));
+            fflush(stderr);
+            PQclear(res);
+            return 0;
+        }
+        AZ::u32 minted = static_cast<AZ::u32>(atoi(PQcmdTuples(res)));
+        PQclear(res);
+
+        // Cache fill. Only w2t — a t2w row for the minted form would clobber
+        // the base form's reverse mapping and break reconstruction.
+        if (m_env && !m_lmdbReadOnly)
+        {
+            AZStd::vector<ResolveResult::LmdbWrite> writes;
+            writes.reserve(forms.size());
+            for (size_t i = 0; i < forms.size(); ++i)
+                writes.push_back({ "w2t", forms[i], tokens[i] });
+
+            if (GroupCommitEnabled())
+            {
+                EnqueueWrites(writes);
+            }
+            else
+            {
+                std::deque<ResolveResult::LmdbWrite> batch(writes.begin(), writes.end());
+                CommitBatch(batch);
+            }
+        }
+
+        fprintf(stderr, "[CacheMissResolver] Mint batch: %zu recommended, %zu unique, "
+            "%u minted, %zu already present, %u base unresolved\n",
+            recommendations.size(), unique.size(), minted,
+            forms.size() - minted, unresolvedBase);
+        fflush(stderr);
+
+        return minted;
+    }
+
     // ---- WordHandler ----
 
     bool WordHandler::Resolve(
@@ -5,6 +5,14 @@
 #include <AzCore/std/containers/unordered_map.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 
+#include "HCPResolutionChamber.h"  // MintRecommendation
+#include "HCPDbUtils.h"            // B50PairCodec — compile-time pair tables
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
 // Forward declare LMDB types (avoids lmdb.h in header for non-Private targets)
 typedef struct MDB_env MDB_env;
 typedef unsigned int MDB_dbi;
@@ -20,14 +28,22 @@ namespace HCPEngine
         "ABCDEFGHIJKLMNPQRSTUVWXYZabcdefghijklmnpqrstuvwxyz";
     inline constexpr int BASE50 = 50;
 
+    // Compile-time pair tables for THIS alphabet — distinct from the token-id
+    // B50_CODEC in HCPDbUtils.h (this one excludes O/o; never mix the two).
+    inline constexpr B50PairCodec BASE50_CODEC = BuildB50PairCodec(BASE50_ALPHABET);
+
     /// Encode an integer (0-2499) as a 2-char base-50 pair.
     inline AZStd::string EncodePairB50(int value)
     {
-        char pair[3];
-        pair[0] = BASE50_ALPHABET[value / BASE50];
-        pair[1] = BASE50_ALPHABET[value % BASE50];
-        pair[2] = '\0';
-        return AZStd::string(pair, 2);
+        if (value < 0) value = 0;
+        if (value >= 2500) value = 2499;
+        return AZStd::string(BASE50_CODEC.encode[value], 2);
+    }
+
+    /// Decode a 2-char base-50 pair back to its integer (0-2499).
+    inline int DecodePairB50(const char* pair)
+    {
+        return BASE50_CODEC.DecodePair(pair);
     }
 
     /// Context passed to handlers for document-level metadata.
@@ -94,6 +110,15 @@ namespace HCPEngine
         /// Get or lazily open a Postgres connection by database name.
         PGconn* GetConnection(const char* dbname);
 
+        /// Execute a document's accumulated MintRecommendations as one batch.
+        /// Dedupes by surface form, fills the base token ids CheckPossessives
+        /// leaves blank with a single ANY() lookup, mints every new form in
+        /// one set-based INSERT, and stages the resulting w2t mappings the
+        /// same way resolved misses are staged — the next document hits
+        /// cache instead of re-recommending.
+        /// @return Number of forms actually minted (new entries rows).
+        AZ::u32 ExecuteMintBatch(const AZStd::vector<MintRecommendation>& recommendations);
+
         void Shutdown();
 
     private:
@@ -101,10 +126,51 @@ namespace HCPEngine
                       const void* key, size_t keyLen,
                       const void* value, size_t valueLen);
 
+        // -------------------------------------------------------------------
+        // Group commit. First-contact ingest of a new corpus resolves misses
+        // faster than LMDB can commit them one txn apiece — write txns
+        // serialize the whole environment, so the per-miss commit becomes the
+        // ceiling. With HCP_RESOLVER_GROUP_COMMIT=1, resolved writes land in
+        // a staging queue and a dedicated writer thread commits them in
+        // batches (every GROUP_COMMIT_MAX_ENTRIES entries or after
+        // GROUP_COMMIT_MAX_WAIT_MS, whichever comes first). Until a write
+        // commits, an overlay map keyed (sub-db, key) answers repeat misses
+        // so nothing resolves twice.
+        // -------------------------------------------------------------------
+
+        static bool GroupCommitEnabled();
+
+        //! Stage resolved writes for the commit thread, starting it on first use.
+        void EnqueueWrites(AZStd::vector<ResolveResult::LmdbWrite>& writes);
+
+        //! Look up a staged-but-uncommitted value. Returns false on miss.
+        bool OverlayGet(const char* subDbName, const char* key, size_t keyLen,
+                        AZStd::string& outValue) const;
+
+        //! Commit thread body: drains the queue in batches, one txn per batch.
+        void CommitThreadMain();
+
+        //! Write one drained batch to LMDB in a single transaction.
+        bool CommitBatch(const std::deque<ResolveResult::LmdbWrite>& batch);
+
+        //! Flush remaining staged writes, then stop and join the commit thread.
+        void StopCommitThread();
+
         AZStd::unordered_map<AZStd::string, AZStd::unique_ptr<ICacheMissHandler>> m_handlers;
         AZStd::unordered_map<AZStd::string, MDB_dbi> m_dbis;
+        bool m_lmdbReadOnly = false;   // env opened MDB_RDONLY — skip cache fills
         AZStd::unordered_map<AZStd::string, PGconn*> m_pgConns;
         MDB_env* m_env = nullptr;
+
+        // Group-commit state. m_commitMutex guards the queue and the overlay;
+        // m_commitWork wakes the writer thread.
+        std::thread             m_commitThread;
+        mutable std::mutex      m_commitMutex;
+        std::condition_variable m_commitWork;
+        std::deque<ResolveResult::LmdbWrite> m_commitQueue;
+        AZStd::unordered_map<AZStd::string, AZStd::string> m_overlay;
+        bool m_commitRunning = false;
+        bool m_commitStop    = false;
     };
 
     // ---- Vocabulary Handlers ----
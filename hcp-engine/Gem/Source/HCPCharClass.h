@@ -0,0 +1,79 @@
+#pragma once
+
+// ============================================================================
+// HCP codepoint classification — packed class byte behind a two-level table.
+//
+// Run segmentation (HCPByteIngest.cpp) used to ask cctype one question per
+// character per pass: whitespace? punctuation? uppercase? Each answer was a
+// branch chain, and segmentation is serial — it gates every parallel stage
+// behind it. The table collapses all the questions into one lookup emitting a
+// packed class byte; the segmentation loops then test bits.
+//
+// The table is generated at compile time (constexpr, no codegen step) and is
+// two-level over the full codepoint space: a page index over cp >> 8 and a
+// pool of 256-byte class pages. Today only the Latin-1 page carries classes
+// (matching the byte-level semantics segmentation always had — edge
+// punctuation and case folding are ASCII concerns); Unicode whitespace or
+// punctuation classes later mean adding pages, not touching lookups.
+// ============================================================================
+
+#include <AzCore/base.h>
+
+#include <cstdint>
+
+namespace HCPEngine
+{
+namespace CharClass
+{
+    //! Class bits. A zero byte is "carried verbatim" — neither delimiter,
+    //! strippable edge, nor case-foldable.
+    enum : AZ::u8
+    {
+        WS     = 1 << 0,   // run delimiter
+        PUNCT  = 1 << 1,   // stripped from run edges
+        UPPER  = 1 << 2,   // contributes to capMask; folds via | 0x20
+        DIGIT  = 1 << 3,
+        LETTER = 1 << 4,
+    };
+
+    inline constexpr uint32_t PAGE_COUNT = 2;       // default + Latin-1
+    inline constexpr uint32_t INDEX_SIZE = 0x1100;  // (0x10FFFF >> 8) + 1
+
+    struct Tables
+    {
+        AZ::u8 pageIndex[INDEX_SIZE] = {};
+        AZ::u8 pages[PAGE_COUNT][256] = {};
+    };
+
+    constexpr Tables BuildTables()
+    {
+        Tables t;
+
+        // Page 1: Latin-1 (codepoints 0x00–0xFF). Class membership matches
+        // the cctype "C" locale predicates segmentation used before.
+        AZ::u8* p = t.pages[1];
+        p[' '] = p['\t'] = p['\n'] = p['\r'] = p['\f'] = p['\v'] = WS;
+        for (uint32_t c = 0x21; c <= 0x2F; ++c) p[c] = PUNCT;
+        for (uint32_t c = 0x3A; c <= 0x40; ++c) p[c] = PUNCT;
+        for (uint32_t c = 0x5B; c <= 0x60; ++c) p[c] = PUNCT;
+        for (uint32_t c = 0x7B; c <= 0x7E; ++c) p[c] = PUNCT;
+        for (uint32_t c = '0'; c <= '9'; ++c) p[c] = DIGIT;
+        for (uint32_t c = 'A'; c <= 'Z'; ++c) p[c] = UPPER | LETTER;
+        for (uint32_t c = 'a'; c <= 'z'; ++c) p[c] = LETTER;
+
+        t.pageIndex[0] = 1;   // every other page maps to the all-zero default
+        return t;
+    }
+
+    inline constexpr Tables g_tables = BuildTables();
+
+    //! Packed class byte for one codepoint. Out-of-range input classifies as
+    //! carried-verbatim, like any unmapped page.
+    inline constexpr AZ::u8 Classify(uint32_t cp)
+    {
+        const uint32_t page = cp >> 8;
+        return g_tables.pages[page < INDEX_SIZE ? g_tables.pageIndex[page] : 0][cp & 0xFF];
+    }
+
+} // namespace CharClass
+} // namespace HCPEngine
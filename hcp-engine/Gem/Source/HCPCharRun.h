@@ -41,7 +41,14 @@ namespace HCPEngine
         bool firstCap = false;                   // First char is uppercase
         bool allCaps = false;                    // All chars uppercase (e.g. "NASA") — try both Label and lowercase
         bool positionalCap = false;              // Caps may be positional (after ., ?, !, \n) — lowercase fallback
-        AZStd::vector<AZ::u32> capMask;         // Run-relative positions that were uppercase
+
+        //! Run-relative uppercase positions, packed one bit per position
+        //! (bit j set = char j was uppercase). Bed-resolvable words are at
+        //! most 20 chars, so 64 bits is lossless for anything that can
+        //! settle; positions past 63 feed only allCaps, which segmentation
+        //! computes from the full uppercase count. Packed so the pipeline's
+        //! highest-volume transient type carries no per-run heap vector.
+        AZ::u64 capMask = 0;
 
         // Source byte span (the byte-floor positional map) — carries the proprioceptive
         // position from raw bytes up to the run, so a resolved word traces to source bytes.
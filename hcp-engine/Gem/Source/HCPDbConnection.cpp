@@ -31,6 +31,9 @@ namespace DbConn_Detail {
             return false;
         }
 
+        // Fresh connection — nothing is prepared on it yet.
+        m_prepared.clear();
+
         AZLOG_INFO("HCPDbConnection: Connected to %s", connInfo ? connInfo : DbConn_Detail::DEFAULT_CONNINFO);
         return true;
     }
@@ -42,6 +45,9 @@ namespace DbConn_Detail {
             PQfinish(m_conn);
             m_conn = nullptr;
         }
+        m_prepared.clear();
+        m_pipelineOps.clear();
+        m_inPipeline = false;
     }
 
     bool HCPDbConnection::IsConnected() const
@@ -49,4 +55,128 @@ namespace DbConn_Detail {
         return m_conn != nullptr && PQstatus(m_conn) == CONNECTION_OK;
     }
 
+    PGresult* HCPDbConnection::ExecPrepared(const char* name, const char* sql,
+        int nParams, const char* const* params)
+    {
+        if (!m_conn)
+        {
+            return nullptr;
+        }
+
+        if (m_prepared.find(name) == m_prepared.end())
+        {
+            PGresult* prep = PQprepare(m_conn, name, sql, nParams, nullptr);
+            if (PQresultStatus(prep) != PGRES_COMMAND_OK)
+            {
+                AZLOG_ERROR("HCPDbConnection: PREPARE '%s' failed: %s",
+                    name, PQerrorMessage(m_conn));
+                PQclear(prep);
+                return nullptr;
+            }
+            PQclear(prep);
+            m_prepared.insert(name);
+        }
+
+        return PQexecPrepared(m_conn, name, nParams, params, nullptr, nullptr, 0);
+    }
+
+    bool HCPDbConnection::PipelineBegin()
+    {
+        if (!m_conn || m_inPipeline)
+        {
+            return false;
+        }
+        if (PQenterPipelineMode(m_conn) != 1)
+        {
+            AZLOG_ERROR("HCPDbConnection: PQenterPipelineMode failed: %s",
+                PQerrorMessage(m_conn));
+            return false;
+        }
+        m_inPipeline = true;
+        m_pipelineOps.clear();
+        return true;
+    }
+
+    bool HCPDbConnection::PipelineQueue(const char* name, const char* sql,
+        int nParams, const char* const* params)
+    {
+        if (!m_conn || !m_inPipeline)
+        {
+            return false;
+        }
+
+        if (m_prepared.find(name) == m_prepared.end())
+        {
+            if (PQsendPrepare(m_conn, name, sql, nParams, nullptr) != 1)
+            {
+                AZLOG_ERROR("HCPDbConnection: pipelined PREPARE '%s' failed: %s",
+                    name, PQerrorMessage(m_conn));
+                return false;
+            }
+            m_pipelineOps.push_back(OP_PREPARE);
+            m_prepared.insert(name);
+        }
+
+        if (PQsendQueryPrepared(m_conn, name, nParams, params, nullptr, nullptr, 0) != 1)
+        {
+            AZLOG_ERROR("HCPDbConnection: pipelined send '%s' failed: %s",
+                name, PQerrorMessage(m_conn));
+            return false;
+        }
+        m_pipelineOps.push_back(OP_EXEC);
+        return true;
+    }
+
+    AZStd::vector<PGresult*> HCPDbConnection::PipelineDrain()
+    {
+        AZStd::vector<PGresult*> results;
+        if (!m_conn || !m_inPipeline)
+        {
+            return results;
+        }
+
+        if (PQpipelineSync(m_conn) != 1)
+        {
+            AZLOG_ERROR("HCPDbConnection: PQpipelineSync failed: %s",
+                PQerrorMessage(m_conn));
+        }
+
+        // One result per queued send, each terminated by a null PQgetResult.
+        // After an in-pipeline error the remaining results come back as
+        // PGRES_PIPELINE_ABORTED — they still have to be consumed.
+        for (AZ::u8 op : m_pipelineOps)
+        {
+            PGresult* res = PQgetResult(m_conn);
+            if (op == OP_PREPARE)
+            {
+                if (res && PQresultStatus(res) != PGRES_COMMAND_OK)
+                {
+                    AZLOG_ERROR("HCPDbConnection: in-pipeline PREPARE failed: %s",
+                        PQerrorMessage(m_conn));
+                }
+                PQclear(res);
+            }
+            else
+            {
+                results.push_back(res);
+            }
+            PGresult* term = PQgetResult(m_conn);
+            PQclear(term);   // expected null terminator
+        }
+
+        // Consume the sync point, then leave pipeline mode.
+        PGresult* sync = PQgetResult(m_conn);
+        if (sync && PQresultStatus(sync) != PGRES_PIPELINE_SYNC)
+        {
+            AZLOG_ERROR("HCPDbConnection: unexpected pipeline sync result: %s",
+                PQerrorMessage(m_conn));
+        }
+        PQclear(sync);
+
+        PQexitPipelineMode(m_conn);
+        m_inPipeline = false;
+        m_pipelineOps.clear();
+        return results;
+    }
+
 } // namespace HCPEngine
@@ -2,14 +2,23 @@
 
 #include <AzCore/base.h>
 #include <AzCore/std/string/string.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
 
 struct pg_conn;
 typedef pg_conn PGconn;
+struct pg_result;
+typedef pg_result PGresult;
 
 namespace HCPEngine
 {
     //! Thin PGconn* wrapper — shared by all DB kernels.
     //! One connection per database. Kernels take a reference to this.
+    //!
+    //! Hot query kernels should go through ExecPrepared / the pipeline API
+    //! rather than raw PQexecParams: the same statement texts run millions of
+    //! times across an ingest run, and the link is cross-host, so server-side
+    //! plan reuse and batched round trips both matter.
     class HCPDbConnection
     {
     public:
@@ -32,8 +41,44 @@ namespace HCPEngine
         //! Raw PGconn* for query execution. All kernels use this.
         PGconn* Get() const { return m_conn; }
 
+        //! Execute a named prepared statement, preparing it on first use.
+        //! The registry is per-connection — Connect()/Disconnect() clear it, so
+        //! a reconnect transparently re-prepares on the next call.
+        //! @param name Stable statement name, unique per SQL text.
+        //! @param sql  Statement text with $n placeholders (used on first call only).
+        //! @return Result owned by the caller (PQclear it); nullptr when not
+        //!         connected or the PREPARE itself failed.
+        PGresult* ExecPrepared(const char* name, const char* sql,
+            int nParams, const char* const* params);
+
+        //! Enter libpq pipeline mode. Queue statements with PipelineQueue(),
+        //! then collect with PipelineDrain() — everything queued travels to the
+        //! server in a single round trip.
+        bool PipelineBegin();
+
+        //! Queue one prepared-statement execution (first use of a name sends
+        //! an in-pipeline PREPARE ahead of it). Only valid between
+        //! PipelineBegin() and PipelineDrain().
+        bool PipelineQueue(const char* name, const char* sql,
+            int nParams, const char* const* params);
+
+        //! Sync, collect one PGresult per queued statement (in queue order),
+        //! and exit pipeline mode. A failed statement yields its error result
+        //! in place. Caller PQclears every entry.
+        AZStd::vector<PGresult*> PipelineDrain();
+
     private:
         PGconn* m_conn = nullptr;
+
+        //! Statement names already PREPAREd on m_conn.
+        AZStd::unordered_set<AZStd::string> m_prepared;
+
+        //! Pipeline bookkeeping: one entry per queued send, in wire order.
+        //! OP_PREPARE results are acks to check and discard; OP_EXEC results
+        //! are handed back from PipelineDrain().
+        enum PipelineOp : AZ::u8 { OP_PREPARE = 0, OP_EXEC = 1 };
+        AZStd::vector<AZ::u8> m_pipelineOps;
+        bool m_inPipeline = false;
     };
 
 } // namespace HCPEngine
@@ -14,15 +14,49 @@ namespace HCPEngine
 
     inline constexpr const char B50[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwx";
 
+    // Pair codec tables, built at compile time from the alphabet. The pair
+    // math (div/mod by 50 to encode, char arithmetic to decode) runs millions
+    // of times at the DB and JSON boundaries, so both directions fold to
+    // straight indexed loads: 2500 entries value → two chars, 256 entries
+    // char → digit. No init order, no runtime fill.
+    //
+    // The tree carries two base-50 alphabets (historical): B50 above (token
+    // ids and position packing) and HCPCacheMissResolver.h BASE50_ALPHABET
+    // (O/o excluded, codepoint tokens — matches the Python side). One
+    // builder, one instance each; pairs from the two never mix.
+    struct B50PairCodec
+    {
+        char encode[2500][2];    // value → two chars
+        AZ::u8 charValue[256];   // char → digit 0..49; foreign chars decode
+                                 // as 0 (DecodeB50Char's forgiving behavior)
+
+        constexpr int DecodePair(const char* p) const
+        {
+            return int(charValue[static_cast<unsigned char>(p[0])]) * 50
+                 + int(charValue[static_cast<unsigned char>(p[1])]);
+        }
+    };
+
+    constexpr B50PairCodec BuildB50PairCodec(const char* alphabet)
+    {
+        B50PairCodec c{};
+        for (int d = 0; d < 50; ++d)
+            c.charValue[static_cast<unsigned char>(alphabet[d])] = static_cast<AZ::u8>(d);
+        for (int v = 0; v < 2500; ++v)
+        {
+            c.encode[v][0] = alphabet[v / 50];
+            c.encode[v][1] = alphabet[v % 50];
+        }
+        return c;
+    }
+
+    inline constexpr B50PairCodec B50_CODEC = BuildB50PairCodec(B50);
+
     inline AZStd::string EncodePairStr(int value)
     {
         if (value < 0) value = 0;
         if (value >= 2500) value = 2499;
-        char buf[3];
-        buf[0] = B50[value / 50];
-        buf[1] = B50[value % 50];
-        buf[2] = '\0';
-        return AZStd::string(buf);
+        return AZStd::string(B50_CODEC.encode[value], 2);
     }
 
     // Position encoding: position → 4 chars (two pairs)
@@ -30,26 +64,22 @@ namespace HCPEngine
     // Max position: 2499 * 2500 + 2499 = 6,249,999
     inline void EncodePosition(int position, char out[4])
     {
-        int pair1 = position / 2500;
-        int pair2 = position % 2500;
-        out[0] = B50[pair1 / 50];
-        out[1] = B50[pair1 % 50];
-        out[2] = B50[pair2 / 50];
-        out[3] = B50[pair2 % 50];
+        const char* hi = B50_CODEC.encode[(position / 2500) % 2500];
+        const char* lo = B50_CODEC.encode[position % 2500];
+        out[0] = hi[0];
+        out[1] = hi[1];
+        out[2] = lo[0];
+        out[3] = lo[1];
     }
 
     inline int DecodeB50Char(char c)
     {
-        if (c >= 'A' && c <= 'Z') return c - 'A';
-        if (c >= 'a' && c <= 'x') return 26 + (c - 'a');
-        return 0;
+        return B50_CODEC.charValue[static_cast<unsigned char>(c)];
     }
 
     inline int DecodePosition(const char* p)
     {
-        int pair1 = DecodeB50Char(p[0]) * 50 + DecodeB50Char(p[1]);
-        int pair2 = DecodeB50Char(p[2]) * 50 + DecodeB50Char(p[3]);
-        return pair1 * 2500 + pair2;
+        return B50_CODEC.DecodePair(p) * 2500 + B50_CODEC.DecodePair(p + 2);
     }
 
     // ---- Token ID splitting ----
@@ -199,6 +229,31 @@ namespace HCPEngine
         return "lingo";
     }
 
+    // ---- Postgres array literals ----
+
+    //! Render a Postgres text[] literal ({"a","b"}) for an ANY($1::text[])
+    //! bind. Every element is double-quoted with backslash escaping (quote
+    //! and backslash are the only characters needing it inside quotes), so
+    //! arbitrary token ids, entity ids and surface forms ("Gilman's") are
+    //! safe without hand-built IN clauses.
+    inline AZStd::string BuildTextArrayLiteral(const AZStd::vector<AZStd::string>& values)
+    {
+        AZStd::string arr = "{";
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i > 0) arr += ',';
+            arr += '"';
+            for (char c : values[i])
+            {
+                if (c == '"' || c == '\\') arr += '\\';
+                arr += c;
+            }
+            arr += '"';
+        }
+        arr += '}';
+        return arr;
+    }
+
     // ---- Sparse modifier encoding ----
 
     // Encode non-zero modifiers as sparse [position_b50(4) + modifier_b50(4)] pairs.
@@ -0,0 +1,579 @@
+#include "HCPDocBundle.h"
+#include "HCPDbUtils.h"
+#include "HCPDocumentQuery.h"
+#include "HCPPbmSnapshot.h"
+#include "HCPPosPack.h"
+
+#include <AzCore/Console/ILogger.h>
+#include <AzCore/std/string/conversions.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <libpq-fe.h>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HCPEngine
+{
+namespace DocBundle_Detail
+{
+    // Parse a libpq INTEGER[] text literal "{1,2,3}" into out (appending).
+    inline void ParseIntArray(const char* arr, AZStd::vector<int>& out)
+    {
+        if (!arr || arr[0] != '{') return;
+        const char* p = arr + 1;
+        while (*p && *p != '}')
+        {
+            char* end = nullptr;
+            long v = strtol(p, &end, 10);
+            if (end == p) break;
+            out.push_back(static_cast<int>(v));
+            p = end;
+            if (*p == ',') ++p;
+        }
+    }
+} // DocBundle_Detail
+
+    bool HCPDocBundle::ExportDocument(const AZStd::string& docId,
+        const AZStd::string& path, ExportResult& out)
+    {
+        using namespace PbmSnapshot;
+        using namespace DocBundle_Detail;
+
+        PGconn* pg = m_conn.Get();
+        if (!pg)
+        {
+            out.error = "Database not available";
+            return false;
+        }
+
+        // Document row: everything the bundle carries besides bonds/positions.
+        int docPk = 0;
+        AZStd::string name, century, metaJson;
+        int totalSlots = 0;
+        AZStd::string firstFpbA, firstFpbB;
+        AZStd::vector<int> allCapsPositions;
+        {
+            const char* params[] = { docId.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT id, name, p3, COALESCE(total_slots, 0), "
+                "COALESCE(metadata::text, '{}'), "
+                "COALESCE(first_fpb_a, ''), COALESCE(first_fpb_b, ''), "
+                "COALESCE(all_caps_positions, '{}') "
+                "FROM pbm_documents WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) == 0)
+            {
+                out.error = "Document not found";
+                PQclear(res);
+                return false;
+            }
+            docPk = atoi(PQgetvalue(res, 0, 0));
+            name = PQgetvalue(res, 0, 1);
+            century = PQgetvalue(res, 0, 2);
+            totalSlots = atoi(PQgetvalue(res, 0, 3));
+            metaJson = PQgetvalue(res, 0, 4);
+            firstFpbA = PQgetvalue(res, 0, 5);
+            firstFpbB = PQgetvalue(res, 0, 6);
+            ParseIntArray(PQgetvalue(res, 0, 7), allCapsPositions);
+            PQclear(res);
+        }
+
+        AZStd::string pkStr = AZStd::to_string(docPk);
+
+        // Catalog provenance — travels with the bundle so the destination
+        // dedupes re-imports the same way re-ingest dedupes re-scans.
+        AZStd::string catalog, catalogId;
+        {
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT source_catalog, catalog_id FROM document_provenance "
+                "WHERE doc_id = $1::integer",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+            {
+                catalog = PQgetvalue(res, 0, 0);
+                catalogId = PQgetvalue(res, 0, 1);
+            }
+            PQclear(res);
+        }
+
+        // Var table — decimal id → table index, surfaces into the blob.
+        AZStd::vector<VarRecord> varRecords;
+        AZStd::string varBlob;
+        AZStd::unordered_map<AZStd::string, AZ::u32> varIdToIdx;
+        {
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT var_id, surface FROM pbm_docvars WHERE doc_id = $1 ORDER BY var_id",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK)
+            {
+                for (int i = 0; i < PQntuples(res); ++i)
+                {
+                    const char* varId = PQgetvalue(res, i, 0);
+                    const char* surface = PQgetvalue(res, i, 1);
+                    size_t surfaceLen = strlen(surface);
+
+                    VarRecord vr;
+                    size_t n = strlen(varId);
+                    if (n >= sizeof(vr.varId)) n = sizeof(vr.varId) - 1;
+                    memcpy(vr.varId, varId, n);
+                    vr.surfaceOffset = static_cast<AZ::u32>(varBlob.size());
+                    vr.surfaceLen = static_cast<AZ::u32>(surfaceLen);
+
+                    varIdToIdx[varId] = static_cast<AZ::u32>(varRecords.size());
+                    varRecords.push_back(vr);
+                    varBlob.append(surface, surfaceLen);
+                }
+            }
+            PQclear(res);
+        }
+
+        // Starters: A-side token ids for the bond queries, plus the position
+        // arrays — both come off the same rows.
+        AZStd::unordered_map<int, AZStd::string> starterTokenA;
+        AZStd::vector<PosRecord> posRecords;
+        AZStd::vector<AZ::u32> posInts;
+        {
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT id, token_a_id, COALESCE(positions, '{}'), positions_packed "
+                "FROM pbm_starters WHERE doc_id = $1 ORDER BY id",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) != PGRES_TUPLES_OK)
+            {
+                out.error = "Starters query failed";
+                PQclear(res);
+                return false;
+            }
+            AZStd::vector<unsigned char> packedBytes;   // reused across rows
+            for (int i = 0; i < PQntuples(res); ++i)
+            {
+                starterTokenA[atoi(PQgetvalue(res, i, 0))] = PQgetvalue(res, i, 1);
+
+                // Packed positions first (delta varints in bytea, migration
+                // 052 — the write path blanks the legacy column); fall back
+                // to the positions INTEGER[] for rows ingested before the
+                // migration. Mirrors HCPPbmReader::LoadFirstPositions.
+                AZStd::vector<int> posList;
+                if (!PQgetisnull(res, i, 3)
+                    && PosPack::HexToBytes(PQgetvalue(res, i, 3), packedBytes)
+                    && !packedBytes.empty())
+                {
+                    PosPack::Unpack(packedBytes.data(), packedBytes.size(),
+                        [&](int pos) { posList.push_back(pos); });
+                }
+                else
+                {
+                    ParseIntArray(PQgetvalue(res, i, 2), posList);
+                }
+                if (posList.empty()) continue;
+
+                PosRecord pr;
+                PutToken(pr.tokenId, PQgetvalue(res, i, 1));
+                pr.first = static_cast<AZ::u32>(posInts.size());
+                pr.count = static_cast<AZ::u32>(posList.size());
+                posRecords.push_back(pr);
+                for (int p : posList)
+                    posInts.push_back(static_cast<AZ::u32>(p));
+            }
+            PQclear(res);
+        }
+
+        if (starterTokenA.empty())
+        {
+            out.error = "Document has no bonds to export";
+            return false;
+        }
+
+        // Bond records from the four subtables. Var sides stay as indices
+        // into the var table — surfaces travel once, in the blob.
+        AZStd::vector<BondRecord> bondRecords;
+        auto aSide = [&](int starterId, BondRecord& br) -> bool {
+            auto it = starterTokenA.find(starterId);
+            if (it == starterTokenA.end()) return false;
+            const AZStd::string& tok = it->second;
+            if (tok.starts_with("00.00.00."))
+            {
+                auto vit = varIdToIdx.find(AZStd::string(tok.data() + 9, tok.size() - 9));
+                if (vit == varIdToIdx.end()) return false;
+                br.aVar = vit->second;
+            }
+            else
+            {
+                PutToken(br.tokenA, tok);
+            }
+            return true;
+        };
+        auto loadBonds = [&](const char* query, auto fillB) {
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg, query,
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK)
+            {
+                for (int i = 0; i < PQntuples(res); ++i)
+                {
+                    BondRecord br;
+                    if (!aSide(atoi(PQgetvalue(res, i, 0)), br)) continue;
+                    if (!fillB(res, i, br)) continue;
+                    br.count = static_cast<AZ::u32>(
+                        atoi(PQgetvalue(res, i, PQnfields(res) - 1)));
+                    bondRecords.push_back(br);
+                }
+            }
+            PQclear(res);
+        };
+
+        loadBonds(
+            "SELECT wb.starter_id, wb.b_p3, wb.b_p4, wb.b_p5, wb.count "
+            "FROM pbm_word_bonds wb "
+            "JOIN pbm_starters s ON s.id = wb.starter_id "
+            "WHERE s.doc_id = $1",
+            [](PGresult* res, int i, BondRecord& br) {
+                AZStd::string b = AZStd::string("AB.AB.") + PQgetvalue(res, i, 1) + "." +
+                    PQgetvalue(res, i, 2) + "." + PQgetvalue(res, i, 3);
+                PutToken(br.tokenB, b);
+                return true;
+            });
+        loadBonds(
+            "SELECT cb.starter_id, cb.b_p2, cb.b_p3, cb.b_p4, cb.b_p5, cb.count "
+            "FROM pbm_char_bonds cb "
+            "JOIN pbm_starters s ON s.id = cb.starter_id "
+            "WHERE s.doc_id = $1",
+            [](PGresult* res, int i, BondRecord& br) {
+                AZStd::string b = AZStd::string("AA.") + PQgetvalue(res, i, 1) + "." +
+                    PQgetvalue(res, i, 2) + "." + PQgetvalue(res, i, 3) + "." +
+                    PQgetvalue(res, i, 4);
+                PutToken(br.tokenB, b);
+                return true;
+            });
+        loadBonds(
+            "SELECT mb.starter_id, mb.b_p3, mb.b_p4, mb.count "
+            "FROM pbm_marker_bonds mb "
+            "JOIN pbm_starters s ON s.id = mb.starter_id "
+            "WHERE s.doc_id = $1",
+            [](PGresult* res, int i, BondRecord& br) {
+                AZStd::string b = AZStd::string("AA.AE.") + PQgetvalue(res, i, 1) + "." +
+                    PQgetvalue(res, i, 2);
+                PutToken(br.tokenB, b);
+                return true;
+            });
+        loadBonds(
+            "SELECT vb.starter_id, vb.b_var_id, vb.count "
+            "FROM pbm_var_bonds vb "
+            "JOIN pbm_starters s ON s.id = vb.starter_id "
+            "WHERE s.doc_id = $1",
+            [&varIdToIdx](PGresult* res, int i, BondRecord& br) {
+                auto it = varIdToIdx.find(PQgetvalue(res, i, 1));
+                if (it == varIdToIdx.end()) return false;
+                br.bVar = it->second;
+                return true;
+            });
+
+        // Snapshot image header — docPk is the SOURCE pk, informational only.
+        SnapshotHeader snapHeader;
+        snapHeader.docPk = static_cast<AZ::u32>(docPk);
+        snapHeader.totalSlots = static_cast<AZ::u32>(totalSlots);
+        snapHeader.bondCount = static_cast<AZ::u32>(bondRecords.size());
+        snapHeader.varCount = static_cast<AZ::u32>(varRecords.size());
+        snapHeader.varBlobBytes = static_cast<AZ::u32>(varBlob.size());
+        snapHeader.posRecCount = static_cast<AZ::u32>(posRecords.size());
+        snapHeader.posIntCount = static_cast<AZ::u32>(posInts.size());
+        snapHeader.allCapsCount = static_cast<AZ::u32>(allCapsPositions.size());
+        PutToken(snapHeader.firstFpbA, firstFpbA);
+        PutToken(snapHeader.firstFpbB, firstFpbB);
+
+        DocBundle::BundleHeader header;
+        header.nameLen = static_cast<AZ::u32>(name.size());
+        header.centuryLen = static_cast<AZ::u32>(century.size());
+        header.metaLen = static_cast<AZ::u32>(metaJson.size());
+        header.catalogLen = static_cast<AZ::u32>(catalog.size());
+        header.catalogIdLen = static_cast<AZ::u32>(catalogId.size());
+        header.snapshotBytes = static_cast<AZ::u32>(TotalBytes(snapHeader));
+
+        AZStd::string outPath = path;
+        if (outPath.empty())
+        {
+            mkdir(DocBundle::Dir(), 0755);   // EEXIST is the normal case
+            outPath = DocBundle::PathFor(docId);
+        }
+
+        FILE* f = fopen(outPath.c_str(), "wb");
+        if (!f)
+        {
+            out.error = "Could not open bundle path for writing";
+            return false;
+        }
+
+        auto writeBytes = [f](const void* p, size_t n) {
+            return n == 0 || fwrite(p, 1, n, f) == n;
+        };
+        bool ok = writeBytes(&header, sizeof(header)) &&
+            writeBytes(name.data(), name.size()) &&
+            writeBytes(century.data(), century.size()) &&
+            writeBytes(metaJson.data(), metaJson.size()) &&
+            writeBytes(catalog.data(), catalog.size()) &&
+            writeBytes(catalogId.data(), catalogId.size()) &&
+            writeBytes(&snapHeader, sizeof(snapHeader)) &&
+            writeBytes(varRecords.data(), varRecords.size() * sizeof(VarRecord)) &&
+            writeBytes(varBlob.data(), varBlob.size()) &&
+            writeBytes(bondRecords.data(), bondRecords.size() * sizeof(BondRecord)) &&
+            writeBytes(posRecords.data(), posRecords.size() * sizeof(PosRecord)) &&
+            writeBytes(posInts.data(), posInts.size() * sizeof(AZ::u32));
+        if (ok)
+        {
+            for (int p : allCapsPositions)
+            {
+                AZ::u32 v = static_cast<AZ::u32>(p);
+                if (fwrite(&v, sizeof(v), 1, f) != 1) { ok = false; break; }
+            }
+        }
+        fclose(f);
+
+        if (!ok)
+        {
+            out.error = "Bundle write failed";
+            remove(outPath.c_str());   // a torn bundle must not be shipped
+            return false;
+        }
+
+        out.path = outPath;
+        out.bytes = DocBundle::TotalBytes(header);
+        out.bonds = snapHeader.bondCount;
+        out.vars = snapHeader.varCount;
+        out.positions = snapHeader.posRecCount;
+
+        fprintf(stderr, "[HCPDocBundle] export: %s -> %s — %u bonds, %u vars, "
+            "%u pos records, %zu bytes\n",
+            docId.c_str(), outPath.c_str(), out.bonds, out.vars, out.positions,
+            out.bytes);
+        fflush(stderr);
+        return true;
+    }
+
+    bool HCPDocBundle::ImportDocument(const AZStd::string& path, ImportResult& out)
+    {
+        using namespace PbmSnapshot;
+
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            out.error = "Could not open bundle file";
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 ||
+            static_cast<size_t>(st.st_size) < sizeof(DocBundle::BundleHeader))
+        {
+            close(fd);
+            out.error = "Bundle file truncated";
+            return false;
+        }
+        size_t mapBytes = static_cast<size_t>(st.st_size);
+
+        void* map = mmap(nullptr, mapBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);   // the mapping keeps the file alive
+        if (map == MAP_FAILED)
+        {
+            out.error = "Could not map bundle file";
+            return false;
+        }
+        const char* base = static_cast<const char*>(map);
+
+        DocBundle::BundleHeader header;
+        memcpy(&header, base, sizeof(header));
+        if (header.magic != DocBundle::MAGIC || header.version != DocBundle::VERSION ||
+            DocBundle::TotalBytes(header) > mapBytes ||
+            header.snapshotBytes < sizeof(SnapshotHeader))
+        {
+            munmap(map, mapBytes);
+            out.error = "Bad bundle header";
+            return false;
+        }
+
+        AZStd::string name(base + DocBundle::NameOffset(header), header.nameLen);
+        AZStd::string century(base + DocBundle::CenturyOffset(header), header.centuryLen);
+        AZStd::string metaJson(base + DocBundle::MetaOffset(header), header.metaLen);
+        AZStd::string catalog(base + DocBundle::CatalogOffset(header), header.catalogLen);
+        AZStd::string catalogId(base + DocBundle::CatalogIdOffset(header), header.catalogIdLen);
+
+        const char* snapBase = base + DocBundle::SnapshotOffset(header);
+        SnapshotHeader snapHeader;
+        memcpy(&snapHeader, snapBase, sizeof(snapHeader));
+        if (snapHeader.magic != MAGIC || snapHeader.version != VERSION ||
+            TotalBytes(snapHeader) > header.snapshotBytes)
+        {
+            munmap(map, mapBytes);
+            out.error = "Bad bundle payload";
+            return false;
+        }
+
+        // Pull everything out of the mapping up front, then drop it — no DB
+        // round trip runs with the file mapped.
+        const VarRecord* vars =
+            reinterpret_cast<const VarRecord*>(snapBase + VarTableOffset(snapHeader));
+        const char* varBlob = snapBase + VarBlobOffset(snapHeader);
+        const BondRecord* bonds =
+            reinterpret_cast<const BondRecord*>(snapBase + BondTableOffset(snapHeader));
+        const PosRecord* posRecs =
+            reinterpret_cast<const PosRecord*>(snapBase + PosTableOffset(snapHeader));
+        const AZ::u32* posIntsRaw =
+            reinterpret_cast<const AZ::u32*>(snapBase + PosIntOffset(snapHeader));
+        const AZ::u32* allCapsRaw =
+            reinterpret_cast<const AZ::u32*>(snapBase + AllCapsOffset(snapHeader));
+
+        // Var surfaces by decimal id. The destination mints its own var ids;
+        // bonds and positions travel by surface and re-resolve against them.
+        AZStd::vector<AZStd::string> varSurfaces;
+        AZStd::unordered_map<AZStd::string, AZStd::string> varIdToSurface;
+        varSurfaces.reserve(snapHeader.varCount);
+        for (AZ::u32 i = 0; i < snapHeader.varCount; ++i)
+        {
+            const VarRecord& vr = vars[i];
+            AZStd::string surface(varBlob + vr.surfaceOffset, vr.surfaceLen);
+            varIdToSurface[AZStd::string(vr.varId)] = surface;
+            varSurfaces.push_back(AZStd::move(surface));
+        }
+        auto varToken = [&](AZ::u32 idx) -> AZStd::string {
+            AZStd::string token = VAR_PREFIX;
+            token += ' ';
+            token += varSurfaces[idx];
+            return token;
+        };
+
+        PBMData pbm;
+        pbm.firstFpbA = snapHeader.firstFpbA;
+        pbm.firstFpbB = snapHeader.firstFpbB;
+        pbm.bonds.reserve(snapHeader.bondCount);
+        for (AZ::u32 i = 0; i < snapHeader.bondCount; ++i)
+        {
+            const BondRecord& br = bonds[i];
+            if ((br.aVar != NO_VAR && br.aVar >= snapHeader.varCount) ||
+                (br.bVar != NO_VAR && br.bVar >= snapHeader.varCount))
+            {
+                munmap(map, mapBytes);
+                out.error = "Bundle var index out of range";
+                return false;
+            }
+            Bond bond;
+            bond.tokenA = br.aVar != NO_VAR ? varToken(br.aVar) : AZStd::string(br.tokenA);
+            bond.tokenB = br.bVar != NO_VAR ? varToken(br.bVar) : AZStd::string(br.tokenB);
+            bond.count = static_cast<int>(br.count);
+            pbm.totalPairs += br.count;
+            pbm.bonds.push_back(AZStd::move(bond));
+        }
+
+        AZStd::unordered_set<AZ::u32> allCapsSet;
+        for (AZ::u32 i = 0; i < snapHeader.allCapsCount; ++i)
+            allCapsSet.insert(allCapsRaw[i]);
+
+        // Per-occurrence vectors in StorePositions' shape. Var starters go
+        // back to VAR_PREFIX + surface form so they resolve to the newly
+        // minted local var ids.
+        AZStd::vector<AZStd::string> tokenIds;
+        AZStd::vector<int> positions;
+        AZStd::vector<AZ::u32> modifiers;
+        tokenIds.reserve(snapHeader.posIntCount);
+        positions.reserve(snapHeader.posIntCount);
+        modifiers.reserve(snapHeader.posIntCount);
+        for (AZ::u32 r = 0; r < snapHeader.posRecCount; ++r)
+        {
+            const PosRecord& pr = posRecs[r];
+            if (static_cast<size_t>(pr.first) + pr.count > snapHeader.posIntCount)
+            {
+                munmap(map, mapBytes);
+                out.error = "Bundle position slice out of range";
+                return false;
+            }
+
+            AZStd::string token(pr.tokenId);
+            if (token.starts_with("00.00.00."))
+            {
+                auto it = varIdToSurface.find(
+                    AZStd::string(token.data() + 9, token.size() - 9));
+                if (it == varIdToSurface.end()) continue;   // torn var table
+                token = AZStd::string(VAR_PREFIX) + " " + it->second;
+            }
+
+            for (AZ::u32 k = 0; k < pr.count; ++k)
+            {
+                const AZ::u32 pos = posIntsRaw[pr.first + k];
+                tokenIds.push_back(token);
+                positions.push_back(static_cast<int>(pos));
+                modifiers.push_back(allCapsSet.count(pos) ? 2u : 0u);
+            }
+        }
+
+        const int totalSlots = static_cast<int>(snapHeader.totalSlots);
+        const AZ::u32 posRecCount = snapHeader.posRecCount;
+        munmap(map, mapBytes);
+
+        if (pbm.bonds.empty())
+        {
+            out.error = "Bundle has no bonds";
+            return false;
+        }
+
+        HCPDocumentQuery docQuery(m_conn);
+
+        // Same dedupe as re-ingest: a (catalog, catalog_id) already in the
+        // store means this document was replicated (or ingested) before.
+        if (!catalog.empty() && !catalogId.empty())
+        {
+            int existingPk = docQuery.GetDocPkByCatalogId(catalog, catalogId);
+            if (existingPk != 0)
+            {
+                out.docPk = existingPk;
+                out.docId = docQuery.GetDocId(existingPk);
+                out.error = "Document already present (catalog match)";
+                return false;
+            }
+        }
+
+        if (name.empty()) name = "untitled";
+        if (century.empty()) century = "AB";
+
+        int docPk = m_writer.CreateDocumentStub(name, century);
+        if (docPk == 0)
+        {
+            out.error = "Could not create document row";
+            return false;
+        }
+
+        AZStd::string docId = m_writer.FillPBMData(docPk, pbm);
+        if (docId.empty())
+        {
+            docQuery.DeleteDocument(docPk);   // don't leave an empty stub behind
+            out.error = "Bond write failed";
+            return false;
+        }
+
+        if (!tokenIds.empty())
+        {
+            m_writer.StorePositions(docPk, tokenIds, positions, totalSlots, modifiers);
+        }
+
+        if (!metaJson.empty() && metaJson != "{}")
+        {
+            docQuery.StoreDocumentMetadata(docPk, metaJson);
+        }
+        docQuery.StoreProvenance(docPk, "bundle", path, "hcpb", catalog, catalogId);
+
+        out.docId = docId;
+        out.docPk = docPk;
+        out.name = name;
+        out.bonds = static_cast<AZ::u32>(pbm.bonds.size());
+        out.positions = posRecCount;
+
+        fprintf(stderr, "[HCPDocBundle] import: %s -> %s (pk=%d) — %u bonds, "
+            "%u pos records\n",
+            path.c_str(), docId.c_str(), docPk, out.bonds, out.positions);
+        fflush(stderr);
+        return true;
+    }
+
+} // namespace HCPEngine
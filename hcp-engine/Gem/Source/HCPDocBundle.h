@@ -0,0 +1,165 @@
+#pragma once
+
+// ============================================================================
+// HCP document bundle — self-contained on-disk form of one ingested document,
+// for inter-site replication.
+//
+// Replicating a corpus used to mean pg_dump of hcp_fic_pbm, which drags
+// indexes and every unrelated document along. A bundle carries exactly one
+// document: its PBM bonds, document-local vars, starter positions, ALL_CAPS
+// overlay, metadata JSONB, and catalog provenance — the union of what
+// HCPPbmReader::LoadPBM and HCPDocumentQuery read back. Moving a document is
+// one file copy plus one `import`, not a DBA task.
+//
+// Layout (native-endian, sections back to back):
+//
+//   [BundleHeader]
+//   [name           nameLen bytes]       document display name
+//   [century        centuryLen bytes]    namespace p3 (destination re-mints
+//                                        p4/p5 from its own sequence)
+//   [metadata       metaLen bytes]       pbm_documents.metadata as JSON text
+//   [catalog        catalogLen bytes]    provenance source_catalog
+//   [catalogId      catalogIdLen bytes]  provenance catalog_id
+//   [snapshot image snapshotBytes]       a complete PbmSnapshot (header +
+//                                        vars + bonds + positions + all-caps,
+//                                        see HCPPbmSnapshot.h)
+//
+// The payload IS the snapshot format — export builds the same fixed-stride
+// sections straight from Postgres, and import walks them exactly like
+// HCPPbmReader's snapshot path. The embedded snapshot's docPk is the SOURCE
+// site's PK and is ignored on import; doc_id, PK, and var ids are all minted
+// fresh at the destination (var sides travel by surface, so re-minted ids
+// resolve correctly). Section offsets are derived from the header lengths —
+// no stored manifest, same doctrine as the snapshot itself.
+// ============================================================================
+
+#include "HCPDbConnection.h"
+#include "HCPPbmWriter.h"
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <cstdlib>
+
+namespace HCPEngine
+{
+namespace DocBundle
+{
+    inline constexpr AZ::u32 MAGIC   = 0x4C444248;   // "HBDL" little-endian
+    inline constexpr AZ::u32 VERSION = 1;
+
+    struct BundleHeader
+    {
+        AZ::u32 magic = MAGIC;
+        AZ::u32 version = VERSION;
+        AZ::u32 nameLen = 0;
+        AZ::u32 centuryLen = 0;
+        AZ::u32 metaLen = 0;
+        AZ::u32 catalogLen = 0;
+        AZ::u32 catalogIdLen = 0;
+        AZ::u32 snapshotBytes = 0;
+    };
+
+    static_assert(sizeof(BundleHeader) == 32, "bundle header stride");
+
+    // ---- Derived section offsets (bytes from file start) ----
+
+    inline size_t NameOffset(const BundleHeader&) { return sizeof(BundleHeader); }
+    inline size_t CenturyOffset(const BundleHeader& h)
+    {
+        return NameOffset(h) + h.nameLen;
+    }
+    inline size_t MetaOffset(const BundleHeader& h)
+    {
+        return CenturyOffset(h) + h.centuryLen;
+    }
+    inline size_t CatalogOffset(const BundleHeader& h)
+    {
+        return MetaOffset(h) + h.metaLen;
+    }
+    inline size_t CatalogIdOffset(const BundleHeader& h)
+    {
+        return CatalogOffset(h) + h.catalogLen;
+    }
+    inline size_t SnapshotOffset(const BundleHeader& h)
+    {
+        return CatalogIdOffset(h) + h.catalogIdLen;
+    }
+    inline size_t TotalBytes(const BundleHeader& h)
+    {
+        return SnapshotOffset(h) + h.snapshotBytes;
+    }
+
+    // ---- Location (same env idiom as HCP_PBM_SNAPSHOT_DIR) ----
+
+    //! Default bundle directory — HCP_BUNDLE_DIR, or the /tmp default.
+    //! `export` accepts an explicit path; this only backs the default.
+    inline const char* Dir()
+    {
+        static const char* dir = []() {
+            const char* d = std::getenv("HCP_BUNDLE_DIR");
+            return d && d[0] ? d : "/tmp/hcp_doc_bundles";
+        }();
+        return dir;
+    }
+
+    //! Default file path for one document's bundle (doc_id is filename-safe:
+    //! pair codes and dots only).
+    inline AZStd::string PathFor(const AZStd::string& docId)
+    {
+        AZStd::string path = Dir();
+        path += '/';
+        path += docId;
+        path += ".hcpb";
+        return path;
+    }
+
+} // namespace DocBundle
+
+    //! Document bundle export/import kernel.
+    //! Takes a HCPDbConnection reference — does not own the connection.
+    //! Export is read-only; import writes through the HCPPbmWriter bulk path
+    //! and must run on the engine lane.
+    class HCPDocBundle
+    {
+    public:
+        explicit HCPDocBundle(HCPDbConnection& conn)
+            : m_conn(conn), m_writer(conn) {}
+
+        struct ExportResult
+        {
+            AZStd::string path;
+            size_t bytes = 0;
+            AZ::u32 bonds = 0;
+            AZ::u32 vars = 0;
+            AZ::u32 positions = 0;   // starter position records
+            AZStd::string error;
+        };
+
+        //! Serialize one document into a bundle file at `path` (empty = the
+        //! DocBundle::PathFor default). Built straight from Postgres, so it
+        //! works whether or not a local mmap snapshot exists.
+        bool ExportDocument(const AZStd::string& docId, const AZStd::string& path,
+            ExportResult& out);
+
+        struct ImportResult
+        {
+            AZStd::string docId;   // minted at this site
+            int docPk = 0;
+            AZStd::string name;
+            AZ::u32 bonds = 0;
+            AZ::u32 positions = 0;
+            AZStd::string error;
+        };
+
+        //! Bulk-write a bundle into the local store: mints a fresh doc row,
+        //! writes bonds and positions through the HCPPbmWriter COPY path, and
+        //! restores metadata + provenance. A document whose (catalog,
+        //! catalog_id) is already present is refused — delete it first to
+        //! re-import.
+        bool ImportDocument(const AZStd::string& path, ImportResult& out);
+
+    private:
+        HCPDbConnection& m_conn;
+        HCPPbmWriter m_writer;
+    };
+
+} // namespace HCPEngine
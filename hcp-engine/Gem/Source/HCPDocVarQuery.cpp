@@ -1,4 +1,5 @@
 #include "HCPDocVarQuery.h"
+#include "HCPDbUtils.h"
 
 #include <AzCore/std/string/conversions.h>
 #include <libpq-fe.h>
@@ -13,9 +14,9 @@ namespace HCPEngine
 
         AZStd::string pkStr = AZStd::to_string(docPk);
         const char* params[] = { pkStr.c_str() };
-        PGresult* res = PQexecParams(pg,
+        PGresult* res = m_conn.ExecPrepared("docvarq_list",
             "SELECT var_id, surface FROM pbm_docvars WHERE doc_id = $1 ORDER BY var_id",
-            1, nullptr, params, nullptr, nullptr, 0);
+            1, params);
         if (PQresultStatus(res) == PGRES_TUPLES_OK)
         {
             for (int i = 0; i < PQntuples(res); ++i)
@@ -38,14 +39,14 @@ namespace HCPEngine
 
         AZStd::string pkStr = AZStd::to_string(docPk);
         const char* params[] = { pkStr.c_str() };
-        PGresult* res = PQexecParams(pg,
+        PGresult* res = m_conn.ExecPrepared("docvarq_list_ext",
             "SELECT v.var_id, v.surface, COALESCE(v.var_category, ''), "
             "       COALESCE(v.group_id, 0), COALESCE(g.suggested_id, ''), "
             "       COALESCE(g.status, '') "
             "FROM pbm_docvars v "
             "LEFT JOIN docvar_groups g ON g.id = v.group_id "
             "WHERE v.doc_id = $1 ORDER BY v.var_id",
-            1, nullptr, params, nullptr, nullptr, 0);
+            1, params);
         if (PQresultStatus(res) == PGRES_TUPLES_OK)
         {
             for (int i = 0; i < PQntuples(res); ++i)
@@ -64,4 +65,116 @@ namespace HCPEngine
         return vars;
     }
 
+    AZStd::unordered_map<AZStd::string, AZStd::string> HCPDocVarQuery::GetVarIdsBySurface(
+        int docPk, const AZStd::vector<AZStd::string>& surfaces)
+    {
+        AZStd::unordered_map<AZStd::string, AZStd::string> found;
+        if (surfaces.empty()) return found;
+        PGconn* pg = m_conn.Get();
+        if (!pg) return found;
+
+        AZStd::string pkStr = AZStd::to_string(docPk);
+        AZStd::string arr = BuildTextArrayLiteral(surfaces);
+        const char* params[] = { pkStr.c_str(), arr.c_str() };
+        PGresult* res = m_conn.ExecPrepared("docvarq_by_surface",
+            "SELECT surface, var_id FROM pbm_docvars "
+            "WHERE doc_id = $1::integer AND surface = ANY($2::text[])",
+            2, params);
+        if (PQresultStatus(res) == PGRES_TUPLES_OK)
+        {
+            found.reserve(PQntuples(res));
+            for (int i = 0; i < PQntuples(res); ++i)
+                found[PQgetvalue(res, i, 0)] = PQgetvalue(res, i, 1);
+        }
+        PQclear(res);
+        return found;
+    }
+
+    AZStd::unordered_map<AZStd::string, AZStd::string> HCPDocVarQuery::GetSurfacesByVarId(
+        int docPk, const AZStd::vector<AZStd::string>& varIds)
+    {
+        AZStd::unordered_map<AZStd::string, AZStd::string> found;
+        if (varIds.empty()) return found;
+        PGconn* pg = m_conn.Get();
+        if (!pg) return found;
+
+        AZStd::string pkStr = AZStd::to_string(docPk);
+        AZStd::string arr = BuildTextArrayLiteral(varIds);
+        const char* params[] = { pkStr.c_str(), arr.c_str() };
+        PGresult* res = m_conn.ExecPrepared("docvarq_by_var_id",
+            "SELECT var_id, surface FROM pbm_docvars "
+            "WHERE doc_id = $1::integer AND var_id = ANY($2::text[])",
+            2, params);
+        if (PQresultStatus(res) == PGRES_TUPLES_OK)
+        {
+            found.reserve(PQntuples(res));
+            for (int i = 0; i < PQntuples(res); ++i)
+                found[PQgetvalue(res, i, 0)] = PQgetvalue(res, i, 1);
+        }
+        PQclear(res);
+        return found;
+    }
+
+    AZStd::unordered_map<AZStd::string, AZStd::string> HCPDocVarQuery::MintVars(
+        int docPk,
+        const AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>>& surfacesWithCategories)
+    {
+        AZStd::unordered_map<AZStd::string, AZStd::string> minted;
+        if (surfacesWithCategories.empty()) return minted;
+        PGconn* pg = m_conn.Get();
+        if (!pg) return minted;
+
+        AZStd::vector<AZStd::string> surfaces, categories;
+        surfaces.reserve(surfacesWithCategories.size());
+        categories.reserve(surfacesWithCategories.size());
+        for (const auto& [surface, category] : surfacesWithCategories)
+        {
+            surfaces.push_back(surface);
+            categories.push_back(category);
+        }
+
+        AZStd::string pkStr = AZStd::to_string(docPk);
+        AZStd::string surfArr = BuildTextArrayLiteral(surfaces);
+        AZStd::string catArr = BuildTextArrayLiteral(categories);
+        const char* params[] = { pkStr.c_str(), surfArr.c_str(), catArr.c_str() };
+
+        // One set-based insert: continue the document's decimal var sequence
+        // ("NN.MM", the pair encoding the row path minted one at a time) from
+        // its current max, in input order (WITH ORDINALITY fixes the unnest
+        // order), returning the assignments.
+        PGresult* res = m_conn.ExecPrepared("docvarq_mint",
+            "WITH base AS ("
+            "  SELECT COALESCE(MAX("
+            "    CAST(SPLIT_PART(var_id, '.', 1) AS INTEGER) * 100 + "
+            "    CAST(SPLIT_PART(var_id, '.', 2) AS INTEGER)"
+            "  ), -1) AS top FROM pbm_docvars WHERE doc_id = $1::integer"
+            "), incoming AS ("
+            "  SELECT t.surface, t.category, t.ord - 1 AS ord "
+            "  FROM unnest($2::text[], $3::text[]) WITH ORDINALITY "
+            "       AS t(surface, category, ord)"
+            ") "
+            "INSERT INTO pbm_docvars (doc_id, var_id, surface, var_category) "
+            "SELECT $1::integer, "
+            "  LPAD(((base.top + 1 + incoming.ord) / 100)::text, 2, '0') || '.' || "
+            "  LPAD(((base.top + 1 + incoming.ord) % 100)::text, 2, '0'), "
+            "  incoming.surface, incoming.category "
+            "FROM incoming, base "
+            "RETURNING surface, var_id",
+            3, params);
+        if (PQresultStatus(res) == PGRES_TUPLES_OK)
+        {
+            minted.reserve(PQntuples(res));
+            for (int i = 0; i < PQntuples(res); ++i)
+                minted[PQgetvalue(res, i, 0)] = PQgetvalue(res, i, 1);
+        }
+        else
+        {
+            fprintf(stderr, "[HCPDocVarQuery] bulk mint failed (%zu vars): %s\n",
+                surfacesWithCategories.size(), PQerrorMessage(pg));
+            fflush(stderr);
+        }
+        PQclear(res);
+        return minted;
+    }
+
 } // namespace HCPEngine
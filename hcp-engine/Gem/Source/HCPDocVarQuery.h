@@ -4,6 +4,8 @@
 #include <AzCore/base.h>
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/utils.h>
 
 namespace HCPEngine
 {
@@ -36,6 +38,31 @@ namespace HCPEngine
         //! Get extended docvar info including category, group, and suggested entity.
         AZStd::vector<DocVarExtended> GetDocVarsExtended(int docPk);
 
+        // Batch var operations. Var-heavy documents (dialect, OCR noise) mint
+        // thousands of vars; these keep the round-trip count per document
+        // constant instead of per-var. All three go through the
+        // prepared-statement path with the surface/var-id sets as array
+        // parameters.
+
+        //! Bulk surface → var_id lookup: which of these surfaces already have
+        //! a var in this document. One round trip for the whole set.
+        AZStd::unordered_map<AZStd::string, AZStd::string> GetVarIdsBySurface(
+            int docPk, const AZStd::vector<AZStd::string>& surfaces);
+
+        //! Bulk var_id → surface lookup for retrieval. One round trip.
+        AZStd::unordered_map<AZStd::string, AZStd::string> GetSurfacesByVarId(
+            int docPk, const AZStd::vector<AZStd::string>& varIds);
+
+        //! Bulk mint: assign decimal var_ids ("NN.MM", continuing from the
+        //! document's current max) to every (surface, category) pair in one
+        //! set-based INSERT ... RETURNING. Ids are assigned in input order.
+        //! Callers filter out already-minted surfaces first (GetVarIdsBySurface)
+        //! — this inserts unconditionally. Returns surface → assigned var_id;
+        //! empty on failure (nothing partially minted — single statement).
+        AZStd::unordered_map<AZStd::string, AZStd::string> MintVars(
+            int docPk,
+            const AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>>& surfacesWithCategories);
+
     private:
         HCPDbConnection& m_conn;
     };
@@ -12,9 +12,9 @@ namespace HCPEngine
         if (!pg) return 0;
 
         const char* params[] = { docId.c_str() };
-        PGresult* res = PQexecParams(pg,
+        PGresult* res = m_conn.ExecPrepared("docq_pk",
             "SELECT id FROM pbm_documents WHERE doc_id = $1",
-            1, nullptr, params, nullptr, nullptr, 0);
+            1, params);
         int pk = 0;
         if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
         {
@@ -24,6 +24,25 @@ namespace HCPEngine
         return pk;
     }
 
+    AZStd::string HCPDocumentQuery::GetDocId(int docPk)
+    {
+        PGconn* pg = m_conn.Get();
+        if (!pg) return {};
+
+        AZStd::string pkStr = AZStd::to_string(docPk);
+        const char* params[] = { pkStr.c_str() };
+        PGresult* res = m_conn.ExecPrepared("docq_id_by_pk",
+            "SELECT doc_id FROM pbm_documents WHERE id = $1::integer",
+            1, params);
+        AZStd::string docId;
+        if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+        {
+            docId = PQgetvalue(res, 0, 0);
+        }
+        PQclear(res);
+        return docId;
+    }
+
     int HCPDocumentQuery::GetDocPkByCatalogId(
         const AZStd::string& catalog,
         const AZStd::string& catalogId)
@@ -32,11 +51,11 @@ namespace HCPEngine
         if (!pg) return 0;
 
         const char* params[] = { catalog.c_str(), catalogId.c_str() };
-        PGresult* res = PQexecParams(pg,
+        PGresult* res = m_conn.ExecPrepared("docq_pk_by_catalog",
             "SELECT d.id FROM pbm_documents d "
             "JOIN document_provenance p ON p.doc_id = d.id "
             "WHERE p.source_catalog = $1 AND p.catalog_id = $2",
-            2, nullptr, params, nullptr, nullptr, 0);
+            2, params);
         int pk = 0;
         if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
             pk = atoi(PQgetvalue(res, 0, 0));
@@ -46,6 +65,11 @@ namespace HCPEngine
 
     AZStd::vector<HCPDocumentQuery::DocumentInfo> HCPDocumentQuery::ListDocuments()
     {
+        if (m_listStamp.Fresh())
+        {
+            return m_cachedList;
+        }
+
         AZStd::vector<DocumentInfo> result;
         PGconn* pg = m_conn.Get();
         if (!pg)
@@ -77,6 +101,8 @@ namespace HCPEngine
                 info.bonds = atoi(PQgetvalue(res, i, 3));
                 result.push_back(AZStd::move(info));
             }
+            m_cachedList = result;
+            m_listStamp = QueryCache::Stamp::Now();
         }
         PQclear(res);
         return result;
@@ -85,6 +111,17 @@ namespace HCPEngine
     HCPDocumentQuery::DocumentDetail HCPDocumentQuery::GetDocumentDetail(const AZStd::string& docId)
     {
         DocumentDetail detail;
+
+        auto cached = m_detailCache.find(docId);
+        if (cached != m_detailCache.end())
+        {
+            if (cached->second.first.Fresh())
+            {
+                return cached->second.second;
+            }
+            m_detailCache.erase(cached);
+        }
+
         PGconn* pg = m_conn.Get();
         if (!pg) return detail;
 
@@ -119,6 +156,12 @@ namespace HCPEngine
             detail.metadataJson = PQgetvalue(res, 0, 5);
             detail.starters = atoi(PQgetvalue(res, 0, 6));
             detail.bonds = atoi(PQgetvalue(res, 0, 7));
+
+            if (m_detailCache.size() >= DETAIL_CACHE_MAX)
+            {
+                m_detailCache.clear();
+            }
+            m_detailCache[docId] = { QueryCache::Stamp::Now(), detail };
         }
         PQclear(res);
         return detail;
@@ -132,10 +175,10 @@ namespace HCPEngine
 
         AZStd::string pkStr = AZStd::to_string(docPk);
         const char* params[] = { pkStr.c_str() };
-        PGresult* res = PQexecParams(pg,
+        PGresult* res = m_conn.ExecPrepared("docq_provenance",
             "SELECT source_type, source_path, source_format, source_catalog, catalog_id "
             "FROM document_provenance WHERE doc_id = $1",
-            1, nullptr, params, nullptr, nullptr, 0);
+            1, params);
         if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
         {
             prov.sourceType = PQgetvalue(res, 0, 0);
@@ -163,10 +206,10 @@ namespace HCPEngine
 
         AZStd::string pkStr = AZStd::to_string(docPk);
         const char* params[] = { pkStr.c_str(), key.c_str(), value.c_str() };
-        PGresult* res = PQexecParams(pg,
+        PGresult* res = m_conn.ExecPrepared("docq_meta_set_key",
             "UPDATE pbm_documents SET metadata = metadata || jsonb_build_object($2, $3::jsonb) "
             "WHERE id = $1::integer",
-            3, nullptr, params, nullptr, nullptr, 0);
+            3, params);
         bool ok = (PQresultStatus(res) == PGRES_COMMAND_OK);
         if (!ok)
         {
@@ -174,6 +217,7 @@ namespace HCPEngine
             fflush(stderr);
         }
         PQclear(res);
+        if (ok) QueryCache::BumpGeneration();
         return ok;
     }
 
@@ -201,6 +245,7 @@ namespace HCPEngine
             fflush(stderr);
         }
         PQclear(res);
+        if (ok) QueryCache::BumpGeneration();
         return ok;
     }
 
@@ -251,6 +296,7 @@ namespace HCPEngine
             PQclear(res);
         }
 
+        if (ok) QueryCache::BumpGeneration();
         return ok;
     }
 
@@ -345,6 +391,7 @@ namespace HCPEngine
         }
         int deleted = ok ? atoi(PQcmdTuples(res)) : 0;
         PQclear(res);
+        if (deleted > 0) QueryCache::BumpGeneration();
         return deleted;
     }
 
@@ -1,14 +1,20 @@
 #pragma once
 
 #include "HCPDbConnection.h"
+#include "HCPQueryCache.h"
 #include <AzCore/base.h>
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/utils.h>
 
 namespace HCPEngine
 {
     //! Document query and metadata kernel.
     //! Handles listing, detail, provenance, and metadata operations on pbm_documents.
+    //! ListDocuments and GetDocumentDetail cache their results (TTL +
+    //! store-generation validation, see HCPQueryCache.h) — the dashboards poll
+    //! them every few seconds and the aggregate scans are the expensive part.
     class HCPDocumentQuery
     {
     public:
@@ -51,14 +57,17 @@ namespace HCPEngine
         //! Resolve a doc_id string to its integer PK. Returns 0 on failure.
         int GetDocPk(const AZStd::string& docId);
 
+        //! Resolve an integer PK back to its doc_id string. Empty on failure.
+        AZStd::string GetDocId(int docPk);
+
         //! Resolve a (catalog, catalog_id) pair to an existing document PK via
         //! document_provenance. Returns 0 if no match found.
         int GetDocPkByCatalogId(const AZStd::string& catalog, const AZStd::string& catalogId);
 
-        //! List all stored documents with basic stats.
+        //! List all stored documents with basic stats. Cached.
         AZStd::vector<DocumentInfo> ListDocuments();
 
-        //! Get full document detail including metadata JSONB.
+        //! Get full document detail including metadata JSONB. Cached per doc_id.
         DocumentDetail GetDocumentDetail(const AZStd::string& docId);
 
         //! Get provenance info for a document by PK.
@@ -91,6 +100,16 @@ namespace HCPEngine
 
     private:
         HCPDbConnection& m_conn;
+
+        // Result caches. One kernel instance per socket worker, so these are
+        // single-threaded; cross-worker invalidation rides the generation in
+        // each stamp (QueryCache::Stamp::Fresh()).
+        AZStd::vector<DocumentInfo> m_cachedList;
+        QueryCache::Stamp m_listStamp;
+
+        static constexpr size_t DETAIL_CACHE_MAX = 256;
+        AZStd::unordered_map<AZStd::string,
+            AZStd::pair<QueryCache::Stamp, DocumentDetail>> m_detailCache;
     };
 
 } // namespace HCPEngine
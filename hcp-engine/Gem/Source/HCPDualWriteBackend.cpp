@@ -0,0 +1,318 @@
+#include "HCPDatabaseBackend.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace HCPEngine
+{
+    // Backpressure: the sync queue holds at most this many document batches.
+    // When the secondary falls further behind (mothership unreachable from
+    // the field), the primary's commit blocks until a slot frees — local
+    // ingest trickles instead of silently diverging.
+    static constexpr size_t MAX_QUEUED_BATCHES = 64;
+
+    // Wait between replay attempts when the secondary is down.
+    static constexpr int SECONDARY_RETRY_MS = 2000;
+
+    /// Dual-write backend for field-kit trickle sync. Wraps two backends:
+    /// the primary (local SQLite capture) takes every operation
+    /// synchronously; writes are also staged per document — explicit
+    /// transaction boundaries delimit a batch — and a worker thread replays
+    /// each committed batch on the secondary (the Postgres mothership)
+    /// inside its own transaction, keeping the secondary on the bulk path.
+    /// Reads never touch the secondary. Replaces export-then-reimport for
+    /// corpus migration.
+    class DualWriteBackend : public IDatabaseBackend
+    {
+        struct StagedWrite
+        {
+            AZStd::string sql;
+            AZStd::vector<AZStd::string> params;
+            bool hasParams = false;
+        };
+        using WriteBatch = AZStd::vector<StagedWrite>;
+
+    public:
+        DualWriteBackend(
+            AZStd::unique_ptr<IDatabaseBackend> primary,
+            AZStd::unique_ptr<IDatabaseBackend> secondary)
+            : m_primary(AZStd::move(primary))
+            , m_secondary(AZStd::move(secondary))
+        {
+        }
+
+        ~DualWriteBackend() override
+        {
+            Disconnect();
+        }
+
+        bool Connect(const char* connectionString) override
+        {
+            // Primary must be up — it is the ingest path. The secondary may
+            // be unreachable (field deployment); batches queue until the
+            // worker can replay them.
+            if (!m_primary->Connect(connectionString))
+                return false;
+
+            const char* secondaryConn = std::getenv("HCP_DUAL_SECONDARY_CONN");
+            if (!m_secondary->Connect(secondaryConn))
+            {
+                fprintf(stderr, "[DualWriteBackend] Secondary (%s) unreachable — "
+                    "queuing until it returns\n", m_secondary->BackendName());
+                fflush(stderr);
+            }
+
+            StartWorker();
+            return true;
+        }
+
+        void Disconnect() override
+        {
+            StopWorker();
+            if (m_secondary) m_secondary->Disconnect();
+            if (m_primary) m_primary->Disconnect();
+        }
+
+        bool IsConnected() const override
+        {
+            return m_primary && m_primary->IsConnected();
+        }
+
+        // ---- Reads: primary only ----
+
+        QueryResult Query(const char* sql) override
+        {
+            return m_primary->Query(sql);
+        }
+
+        QueryResult QueryParams(
+            const char* sql,
+            const AZStd::vector<AZStd::string>& params) override
+        {
+            return m_primary->QueryParams(sql, params);
+        }
+
+        // ---- Writes: primary synchronous, secondary staged ----
+
+        bool Execute(const char* sql) override
+        {
+            if (!m_primary->Execute(sql))
+                return false;
+            Stage(sql, nullptr);
+            return true;
+        }
+
+        bool ExecuteParams(
+            const char* sql,
+            const AZStd::vector<AZStd::string>& params) override
+        {
+            if (!m_primary->ExecuteParams(sql, params))
+                return false;
+            Stage(sql, &params);
+            return true;
+        }
+
+        bool BeginTransaction() override
+        {
+            if (!m_primary->BeginTransaction())
+                return false;
+            m_inTransaction = true;
+            m_pending.clear();
+            return true;
+        }
+
+        bool CommitTransaction() override
+        {
+            bool ok = m_primary->CommitTransaction();
+            m_inTransaction = false;
+            if (ok && !m_pending.empty())
+                EnqueueBatch(AZStd::move(m_pending));
+            m_pending.clear();
+            return ok;
+        }
+
+        bool RollbackTransaction() override
+        {
+            // Whatever the primary threw away never reaches the secondary.
+            m_inTransaction = false;
+            m_pending.clear();
+            return m_primary->RollbackTransaction();
+        }
+
+        const char* BackendName() const override { return "dual"; }
+
+        void* GetRawConnection() const override
+        {
+            return m_primary->GetRawConnection();
+        }
+
+    private:
+        void Stage(const char* sql, const AZStd::vector<AZStd::string>* params)
+        {
+            StagedWrite w;
+            w.sql = sql;
+            if (params)
+            {
+                w.params = *params;
+                w.hasParams = true;
+            }
+
+            if (m_inTransaction)
+            {
+                // Document batch — ships when the transaction commits.
+                m_pending.push_back(AZStd::move(w));
+            }
+            else
+            {
+                // Loose write (schema setup, one-off updates) — ships alone.
+                WriteBatch single;
+                single.push_back(AZStd::move(w));
+                EnqueueBatch(AZStd::move(single));
+            }
+        }
+
+        void EnqueueBatch(WriteBatch batch)
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueSpace.wait(lock, [&] {
+                return m_workerStop || m_queue.size() < MAX_QUEUED_BATCHES;
+            });
+            if (m_workerStop) return;
+            m_queue.push_back(AZStd::move(batch));
+            m_queueWork.notify_one();
+        }
+
+        void StartWorker()
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_workerRunning) return;
+            m_workerStop = false;
+            m_workerRunning = true;
+            m_worker = std::thread(&DualWriteBackend::WorkerMain, this);
+        }
+
+        void StopWorker()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                if (!m_workerRunning) return;
+                m_workerStop = true;
+                m_queueWork.notify_one();
+                m_queueSpace.notify_all();
+            }
+            m_worker.join();
+
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_workerRunning = false;
+            if (!m_queue.empty())
+            {
+                fprintf(stderr, "[DualWriteBackend] Shutdown with %zu batches "
+                    "unsynced — secondary never came back\n", m_queue.size());
+                fflush(stderr);
+                m_queue.clear();
+            }
+        }
+
+        void WorkerMain()
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            for (;;)
+            {
+                m_queueWork.wait(lock, [&] { return m_workerStop || !m_queue.empty(); });
+                if (m_queue.empty() && m_workerStop) return;
+
+                WriteBatch batch = AZStd::move(m_queue.front());
+                m_queue.pop_front();
+
+                lock.unlock();
+                bool ok = ReplayBatch(batch);
+                lock.lock();
+
+                if (ok)
+                {
+                    m_queueSpace.notify_one();
+                    continue;
+                }
+
+                // Secondary down: put the batch back at the front (replay
+                // order is document order) and wait before retrying. On
+                // stop, try one last replay so a clean shutdown drains.
+                m_queue.push_front(AZStd::move(batch));
+                if (m_workerStop)
+                {
+                    lock.unlock();
+                    bool drained = ReplayBatch(m_queue.front());
+                    lock.lock();
+                    if (drained) m_queue.pop_front();
+                    return;
+                }
+                m_queueWork.wait_for(lock,
+                    std::chrono::milliseconds(SECONDARY_RETRY_MS),
+                    [&] { return m_workerStop; });
+            }
+        }
+
+        //! Replay one document batch on the secondary inside a transaction.
+        //! Reconnects once on failure; false means the batch stays queued.
+        bool ReplayBatch(const WriteBatch& batch)
+        {
+            if (!m_secondary->IsConnected())
+            {
+                const char* secondaryConn = std::getenv("HCP_DUAL_SECONDARY_CONN");
+                if (!m_secondary->Connect(secondaryConn))
+                    return false;
+                fprintf(stderr, "[DualWriteBackend] Secondary reconnected, "
+                    "resuming sync\n");
+                fflush(stderr);
+            }
+
+            if (!m_secondary->BeginTransaction())
+                return false;
+
+            for (const auto& w : batch)
+            {
+                bool ok = w.hasParams
+                    ? m_secondary->ExecuteParams(w.sql.c_str(), w.params)
+                    : m_secondary->Execute(w.sql.c_str());
+                if (!ok)
+                {
+                    m_secondary->RollbackTransaction();
+                    return false;
+                }
+            }
+
+            return m_secondary->CommitTransaction();
+        }
+
+        AZStd::unique_ptr<IDatabaseBackend> m_primary;
+        AZStd::unique_ptr<IDatabaseBackend> m_secondary;
+
+        // Caller-thread state: the batch being built for the open transaction.
+        bool m_inTransaction = false;
+        WriteBatch m_pending;
+
+        // Sync queue. m_queueMutex guards the queue; m_queueWork wakes the
+        // worker, m_queueSpace wakes producers blocked on backpressure.
+        std::thread             m_worker;
+        std::mutex              m_queueMutex;
+        std::condition_variable m_queueWork;
+        std::condition_variable m_queueSpace;
+        std::deque<WriteBatch>  m_queue;
+        bool m_workerRunning = false;
+        bool m_workerStop    = false;
+    };
+
+    AZStd::unique_ptr<IDatabaseBackend> CreateDualWriteBackend(
+        AZStd::unique_ptr<IDatabaseBackend> primary,
+        AZStd::unique_ptr<IDatabaseBackend> secondary)
+    {
+        return AZStd::make_unique<DualWriteBackend>(
+            AZStd::move(primary), AZStd::move(secondary));
+    }
+
+} // namespace HCPEngine
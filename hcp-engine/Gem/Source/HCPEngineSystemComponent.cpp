@@ -250,6 +250,9 @@ namespace HCPEngine
                 fprintf(stderr, "[HCPEngine] Envelope manager initialized\n");
                 fflush(stderr);
 
+                // Activation replaces the w2t window — let it refresh the flat index.
+                m_envelopeManager.SetVocabulary(&m_vocabulary);
+
                 // Load inflection rules from hcp_english and wire into BedManager.
                 // dbName is flaggable — defaults to "hcp_english" for English shard.
                 auto rules = m_envelopeManager.LoadInflectionRules("hcp_english");
@@ -1,11 +1,14 @@
 #include "HCPEnvelopeManager.h"
 #include "HCPResolutionChamber.h"  // MorphBit namespace
+#include "HCPResolveStats.h"
+#include "HCPVocabulary.h"
 
 #include <AzCore/std/containers/unordered_set.h>
 #include <lmdb.h>
 #include <libpq-fe.h>
 #include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <string>
 
@@ -35,6 +38,29 @@ namespace HCPEngine
         if (addTab) line += '\t';
     }
 
+    // Strip trailing semicolons/whitespace so a stored query can be embedded
+    // in a CTE or a UNION ALL branch.
+    static std::string StripStoredQuery(const AZStd::string& queryText)
+    {
+        std::string baseQuery(queryText.c_str(), queryText.size());
+        while (!baseQuery.empty() &&
+               (baseQuery.back() == ';' || baseQuery.back() == ' ' ||
+                baseQuery.back() == '\n' || baseQuery.back() == '\r'))
+            baseQuery.pop_back();
+        return baseQuery;
+    }
+
+    // Same-shard query fusion in EnsureLengthAssembled — default ON;
+    // HCP_QUERY_FUSION=0 restores one round trip per stored query.
+    static bool QueryFusionEnabled()
+    {
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_QUERY_FUSION");
+            return !(v && v[0] == '0');
+        }();
+        return enabled;
+    }
+
     // ---------------------------------------------------------------------------
     bool HCPEnvelopeManager::Initialize(MDB_env* lmdbEnv, const char* envelopeConnStr)
     {
@@ -43,20 +69,34 @@ namespace HCPEngine
         m_lmdbEnv     = lmdbEnv;
         m_coreConnStr = envelopeConnStr;
 
-        // Open _manifest sub-db in LMDB for tracking loaded entries
+        // Reader daemons get a MDB_RDONLY environment (HCP_LMDB_READONLY) —
+        // detect it from the env flags so every write path below can no-op.
+        {
+            unsigned int envFlags = 0;
+            mdb_env_get_flags(m_lmdbEnv, &envFlags);
+            m_lmdbReadOnly = (envFlags & MDB_RDONLY) != 0;
+        }
+
+        // Open _manifest sub-db in LMDB for tracking loaded entries. Readers
+        // open it without MDB_CREATE; if the writer has not created it yet the
+        // snapshot/manifest machinery simply stays off for this process.
         MDB_txn* txn = nullptr;
-        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0)
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, m_lmdbReadOnly ? MDB_RDONLY : 0, &txn) != 0)
             return false;
 
         MDB_dbi dbi;
-        if (mdb_dbi_open(txn, "_manifest", MDB_CREATE, &dbi) != 0)
+        if (mdb_dbi_open(txn, "_manifest", m_lmdbReadOnly ? 0 : MDB_CREATE, &dbi) != 0)
         {
             mdb_txn_abort(txn);
-            return false;
+            if (!m_lmdbReadOnly)
+                return false;
+        }
+        else
+        {
+            m_manifestDbi  = dbi;
+            m_manifestOpen = true;
+            mdb_txn_commit(txn);
         }
-        m_manifestDbi  = dbi;
-        m_manifestOpen = true;
-        mdb_txn_commit(txn);
 
         // Connect to envelope definitions DB (hcp_core for now, hcp_envelope when ready)
         m_coreConn = PQconnectdb(envelopeConnStr);
@@ -70,7 +110,9 @@ namespace HCPEngine
             return false;
         }
 
-        fprintf(stderr, "[EnvelopeManager] Initialized (manifest sub-db ready)\n");
+        fprintf(stderr, "[EnvelopeManager] Initialized (%s)\n",
+            m_lmdbReadOnly ? "reader mode — LMDB writes owned by the writer daemon"
+                           : "manifest sub-db ready");
         fflush(stderr);
         return true;
     }
@@ -148,17 +190,6 @@ namespace HCPEngine
         EnvelopeActivation activation;
         auto t0 = std::chrono::high_resolution_clock::now();
 
-        // Evict LMDB hot cache from previous envelope (ephemeral, always safe to clear).
-        // Working set in Postgres is NOT cleared — rows persist for reuse across restarts
-        // and multiple envelopes coexist by envelope_id.
-        if (!m_activeEnvelope.empty())
-        {
-            activation.evictedEntries = EvictManifest(m_activeEnvelope);
-            fprintf(stderr, "[EnvelopeManager] Evicted LMDB for '%s' (%d sub-dbs)\n",
-                m_activeEnvelope.c_str(), activation.evictedEntries);
-            fflush(stderr);
-        }
-
         // Load definition
         EnvelopeDefinition def = LoadEnvelope(name);
         if (def.id == 0)
@@ -169,6 +200,13 @@ namespace HCPEngine
         }
         activation.envelopeId = def.id;
 
+        // Provenance of the OUTGOING plan, recorded at its activation —
+        // consumed by the diff path below once the incoming plan is known.
+        const int previousEnvelopeId = m_activeEnvelopeId;
+        AZStd::unordered_set<int> previousQueryIds;
+        for (const auto& q : m_activeQueries)
+            previousQueryIds.insert(q.id);
+
         // Collect all queries from children (cascade order) then own.
         // Track query ranges per child for incremental assembly — each child
         // envelope is one phase in the cascade (Labels, special chars, common, etc.).
@@ -206,17 +244,98 @@ namespace HCPEngine
         m_nextChildToAssemble = 0;
         m_totalAssembled = 0;
         m_assembledLengths.clear();
-
-        // Clear LMDB hot cache — ephemeral, rebuilt on demand by BedManager.
+        m_morphemeProbe.clear();
+
+        // Activation snapshot: the LMDB hot cache persists on disk, so if this
+        // exact plan (same envelope, same resolved queries) was the last thing
+        // that populated it, attach the populated sub-dbs instead of dropping
+        // them — restart skips the feed entirely. Any definition change produces
+        // a new plan hash and falls through to the cold path below. The cache
+        // may be a partial window; that is fine — it is a demand-refilled
+        // sliding window with Postgres fall-through either way.
+        AZ::u64 planHash = ComputePlanHash(def.id);
+        bool attached = m_lmdbReadOnly ||
+                        ((m_activeEnvelope.empty() || m_activeEnvelope == name)
+                         && ValidateActivationSnapshot(name, def.id, planHash));
+
+        if (attached)
+        {
+            fprintf(stderr, m_lmdbReadOnly
+                ? "[EnvelopeManager] Reader mode — attached writer-owned hot cache for '%s' (plan %016llx)\n"
+                : "[EnvelopeManager] Activation snapshot valid for '%s' (plan %016llx) — hot cache attached, no re-feed\n",
+                name.c_str(), static_cast<unsigned long long>(planHash));
+            fflush(stderr);
+        }
+        else
         {
-            MDB_txn* dropTxn = nullptr;
-            if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &dropTxn) == 0)
+            // Diff activation: envelopes that share plan queries (same-century
+            // siblings differing only in Labels, say) keep the shared queries'
+            // w2t entries and evict only what the incoming plan dropped. Per-row
+            // provenance (source_query_id, migration 051) attributes each warm
+            // row to the stored query that assembled it; the added queries cost
+            // nothing here because assembly is deferred anyway. This skips the
+            // wholesale drop — and with it the tens of seconds of re-feed a
+            // mid-session envelope switch used to cost.
+            AZStd::unordered_set<int> newQueryIds;
+            for (const auto& q : m_activeQueries)
+                newQueryIds.insert(q.id);
+            AZStd::unordered_set<int> removedQueryIds;
+            int sharedQueries = 0;
+            for (int qid : previousQueryIds)
+            {
+                if (newQueryIds.find(qid) != newQueryIds.end()) ++sharedQueries;
+                else removedQueryIds.insert(qid);
+            }
+
+            const bool diffable = !m_activeEnvelope.empty()
+                && m_activeEnvelope != name
+                && previousEnvelopeId != 0
+                && sharedQueries > 0;
+
+            if (diffable)
+            {
+                ClearActivationSnapshot(m_activeEnvelope);
+                activation.evictedEntries =
+                    EvictRemovedQueryEntries(previousEnvelopeId, removedQueryIds);
+                fprintf(stderr, "[EnvelopeManager] Diff activation '%s' -> '%s': "
+                    "%d shared queries kept, %zu removed, %d entries evicted\n",
+                    m_activeEnvelope.c_str(), name.c_str(), sharedQueries,
+                    removedQueryIds.size(), activation.evictedEntries);
+                fflush(stderr);
+                // The old manifest record is left in place: the sub-dbs now
+                // hold entries both envelopes claim, and EvictManifest drops
+                // whole sub-dbs. A later DeactivateEnvelope of the old name
+                // falls back to the usual full-drop semantics.
+            }
+            else
             {
-                MDB_dbi dbiW2t = 0, dbiT2w = 0;
-                if (mdb_dbi_open(dropTxn, "w2t", 0, &dbiW2t) == 0) mdb_drop(dropTxn, dbiW2t, 0);
-                if (mdb_dbi_open(dropTxn, "t2w", 0, &dbiT2w) == 0) mdb_drop(dropTxn, dbiT2w, 0);
-                mdb_txn_commit(dropTxn);
+                // Evict LMDB hot cache from the previous envelope (ephemeral, always
+                // safe to clear). Working set in Postgres is NOT cleared — rows
+                // persist for reuse across restarts and multiple envelopes coexist
+                // by envelope_id.
+                if (!m_activeEnvelope.empty())
+                {
+                    ClearActivationSnapshot(m_activeEnvelope);
+                    activation.evictedEntries = EvictManifest(m_activeEnvelope);
+                    fprintf(stderr, "[EnvelopeManager] Evicted LMDB for '%s' (%d sub-dbs)\n",
+                        m_activeEnvelope.c_str(), activation.evictedEntries);
+                    fflush(stderr);
+                }
+
+                // Clear LMDB hot cache — ephemeral, rebuilt on demand by BedManager.
+                {
+                    MDB_txn* dropTxn = nullptr;
+                    if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &dropTxn) == 0)
+                    {
+                        MDB_dbi dbiW2t = 0, dbiT2w = 0;
+                        if (mdb_dbi_open(dropTxn, "w2t", 0, &dbiW2t) == 0) mdb_drop(dropTxn, dbiW2t, 0);
+                        if (mdb_dbi_open(dropTxn, "t2w", 0, &dbiT2w) == 0) mdb_drop(dropTxn, dbiT2w, 0);
+                        mdb_txn_commit(dropTxn);
+                    }
+                }
             }
+
+            RecordActivationSnapshot(name, def.id, planHash);
         }
 
         auto t1 = std::chrono::high_resolution_clock::now();
@@ -235,6 +354,11 @@ namespace HCPEngine
 
         LogActivation(activation, name);
 
+        // The w2t window was just replaced wholesale — rebuild the flat lookup
+        // index over it. Rows fed later still resolve via the LMDB fall-through.
+        if (m_vocabulary)
+            m_vocabulary->BuildWordIndex();
+
         fprintf(stderr, "[EnvelopeManager] Activated '%s': %zu queries stored, assembly deferred (%.1f ms)\n",
             name.c_str(), m_activeQueries.size(), activation.loadTimeMs);
         fflush(stderr);
@@ -245,6 +369,7 @@ namespace HCPEngine
     // ---------------------------------------------------------------------------
     void HCPEnvelopeManager::DeactivateEnvelope(const AZStd::string& name)
     {
+        ClearActivationSnapshot(name);
         int evicted = EvictManifest(name);
 
         if (m_activeEnvelope == name)
@@ -310,24 +435,8 @@ namespace HCPEngine
         PGconn* varConn   = GetShardConnection("hcp_var");
         if (!shardConn || !varConn) return 0;
 
-        // Strip trailing semicolons/whitespace from stored query
-        std::string baseQuery(query.queryText.c_str(), query.queryText.size());
-        while (!baseQuery.empty() &&
-               (baseQuery.back() == ';' || baseQuery.back() == ' ' ||
-                baseQuery.back() == '\n' || baseQuery.back() == '\r'))
-            baseQuery.pop_back();
-
-        // Probe: check if the stored query returns a 'morpheme' column.
-        // Queries like query 26 (token_variants) do; most vocab queries don't.
-        // Run a LIMIT 0 probe to get column metadata without fetching rows.
-        bool hasMorpheme = false;
-        {
-            std::string probeQ = "WITH _probe AS (" + baseQuery + ") SELECT * FROM _probe LIMIT 0";
-            PGresult* probe = PQexec(shardConn, probeQ.c_str());
-            if (PQresultStatus(probe) == PGRES_TUPLES_OK)
-                hasMorpheme = (PQfnumber(probe, "morpheme") >= 0);
-            PQclear(probe);
-        }
+        std::string baseQuery = StripStoredQuery(query.queryText);
+        bool hasMorpheme = QueryHasMorpheme(shardConn, query);
 
         // Enrichment: extract broadphase + Label detection from the base query results.
         // Base queries select from entries table which already has broadphase and ns columns.
@@ -384,14 +493,15 @@ namespace HCPEngine
             "CREATE TEMP TABLE _ews_stage "
             "(envelope_id INT, shard_db TEXT, lmdb_subdb TEXT, word TEXT, token_id TEXT, "
             " word_length SMALLINT, ns TEXT, characteristics INT, category TEXT, base_priority INT, "
-            " morpheme TEXT) "
+            " morpheme TEXT, source_query_id INT) "
             "ON COMMIT DELETE ROWS");
         PQclear(tmpRes);
         PQexec(varConn, "BEGIN");
         PGresult* copyRes = PQexec(varConn,
             "COPY _ews_stage "
             "(envelope_id, shard_db, lmdb_subdb, word, token_id, "
-            " word_length, ns, characteristics, category, base_priority, morpheme) "
+            " word_length, ns, characteristics, category, base_priority, morpheme, "
+            " source_query_id) "
             "FROM STDIN");
 
         if (PQresultStatus(copyRes) != PGRES_COPY_IN)
@@ -407,6 +517,7 @@ namespace HCPEngine
         PQclear(copyRes);
 
         std::string envIdStr   = std::to_string(envelopeId);
+        std::string queryIdStr = std::to_string(query.id);   // provenance (migration 051)
         std::string shardDbStr(query.shardDb.c_str(), query.shardDb.size());
         std::string subdbStr(query.lmdbSubdb.c_str(), query.lmdbSubdb.size());
 
@@ -446,7 +557,9 @@ namespace HCPEngine
             std::string priorityStr = std::to_string(startOffset + i);
             line += priorityStr; line += '\t';
             // morpheme (nullable — present for token_variant queries)
-            AppendCopyField(line, morpheme, morpheme ? (int)strlen(morpheme) : 0, false);
+            AppendCopyField(line, morpheme, morpheme ? (int)strlen(morpheme) : 0, true);
+            // source_query_id — which stored query assembled this row
+            line += queryIdStr;
             line += '\n';
 
             if (PQputCopyData(varConn, line.c_str(), (int)line.size()) != 1)
@@ -474,8 +587,8 @@ namespace HCPEngine
         // Label rows that share the same surface form.
         PGresult* mergeRes = PQexec(varConn,
             "INSERT INTO envelope_working_set "
-            "(envelope_id, shard_db, lmdb_subdb, word, token_id, word_length, ns, characteristics, category, base_priority, morpheme) "
-            "SELECT envelope_id, shard_db, lmdb_subdb, word, token_id, word_length, ns, characteristics, category, base_priority, morpheme "
+            "(envelope_id, shard_db, lmdb_subdb, word, token_id, word_length, ns, characteristics, category, base_priority, morpheme, source_query_id) "
+            "SELECT envelope_id, shard_db, lmdb_subdb, word, token_id, word_length, ns, characteristics, category, base_priority, morpheme, source_query_id "
             "FROM _ews_stage "
             "ON CONFLICT (envelope_id, lmdb_subdb, word) DO NOTHING");
 
@@ -496,12 +609,226 @@ namespace HCPEngine
         return merged;
     }
 
+    // ---------------------------------------------------------------------------
+    bool HCPEnvelopeManager::QueryHasMorpheme(PGconn* shardConn, const EnvelopeQuery& query)
+    {
+        // Queries like query 26 (token_variants) return a 'morpheme' column;
+        // most vocab queries don't. A LIMIT 0 probe gets column metadata
+        // without fetching rows — cached by id so per-length re-assembly
+        // doesn't re-pay one probe round trip per stored query.
+        auto it = m_morphemeProbe.find(query.id);
+        if (it != m_morphemeProbe.end()) return it->second;
+
+        bool hasMorpheme = false;
+        std::string probeQ = "WITH _probe AS (" + StripStoredQuery(query.queryText) +
+            ") SELECT * FROM _probe LIMIT 0";
+        PGresult* probe = PQexec(shardConn, probeQ.c_str());
+        if (PQresultStatus(probe) == PGRES_TUPLES_OK)
+            hasMorpheme = (PQfnumber(probe, "morpheme") >= 0);
+        PQclear(probe);
+
+        m_morphemeProbe[query.id] = hasMorpheme;
+        return hasMorpheme;
+    }
+
+    // ---------------------------------------------------------------------------
+    // Fused cold → warm: a run of same-shard stored queries becomes ONE
+    // server-side UNION ALL, each branch tagged with its plan position (_q).
+    // The enrichment join runs once over the union, rows come back ordered by
+    // _q, and base_priority is assigned in arrival order — the same numbering
+    // the sequential path produces. One COPY transaction stages the whole
+    // group; the merge inserts in base_priority order so earlier-priority
+    // branches still win ON CONFLICT, exactly as per-query merges did.
+    // ---------------------------------------------------------------------------
+    int HCPEnvelopeManager::AssembleQueryGroup(
+        const AZStd::vector<const EnvelopeQuery*>& group, int envelopeId,
+        int startOffset, int targetLength)
+    {
+        if (group.empty()) return 0;
+        if (group.size() == 1)
+            return AssembleQuery(*group[0], envelopeId, startOffset, targetLength);
+
+        PGconn* shardConn = GetShardConnection(group[0]->shardDb);
+        PGconn* varConn   = GetShardConnection("hcp_var");
+        if (!shardConn || !varConn) return 0;
+
+        // Build the tagged union. Stored queries keep their own ORDER BY —
+        // legal inside a parenthesized FROM-item.
+        std::string fused;
+        for (size_t qi = 0; qi < group.size(); ++qi)
+        {
+            std::string morphemeExpr =
+                QueryHasMorpheme(shardConn, *group[qi]) ? "_s.morpheme" : "NULL::text";
+            if (qi > 0) fused += " UNION ALL ";
+            fused += "SELECT " + std::to_string(qi) + " AS _q, _s.word, _s.token_id, " +
+                morphemeExpr + " AS morpheme FROM (" +
+                StripStoredQuery(group[qi]->queryText) + ") _s";
+        }
+
+        std::string lengthFilter;
+        if (targetLength > 0)
+            lengthFilter = " WHERE length(_b.word) = " + std::to_string(targetLength);
+
+        std::string enrichedQuery =
+            "WITH _base AS (" + fused + ") "
+            "SELECT _b._q, "
+            "       _b.word, "
+            "       _b.token_id, "
+            "       length(_b.word), "
+            "       split_part(_b.token_id, '.', 1), "
+            "       COALESCE(_e.broadphase, 0), "
+            "       CASE WHEN _e.ns = 'AD' THEN 'P' ELSE NULL END, "
+            "       _b.morpheme "
+            "FROM _base _b "
+            "LEFT JOIN entries _e ON _e.token_id = _b.token_id" +
+            lengthFilter +
+            " ORDER BY _b._q";
+
+        PGresult* res = PQexec(shardConn, enrichedQuery.c_str());
+        if (PQresultStatus(res) != PGRES_TUPLES_OK)
+        {
+            // A stored query may not survive embedding (e.g. its own CTEs).
+            // Fall back to the sequential path for this group.
+            fprintf(stderr, "[EnvelopeManager] Fused assembly failed on %s "
+                "(%zu queries), falling back: %s\n",
+                group[0]->shardDb.c_str(), group.size(), PQerrorMessage(shardConn));
+            fflush(stderr);
+            PQclear(res);
+
+            int rowOffset = startOffset;
+            for (const EnvelopeQuery* q : group)
+                rowOffset += AssembleQuery(*q, envelopeId, rowOffset, targetLength);
+            return rowOffset - startOffset;
+        }
+
+        int nrows = PQntuples(res);
+        if (nrows == 0) { PQclear(res); return 0; }
+
+        // Stage + merge, one transaction for the whole group (schema and
+        // conflict handling identical to AssembleQuery).
+        PQexec(varConn, "DROP TABLE IF EXISTS _ews_stage");
+        PGresult* tmpRes = PQexec(varConn,
+            "CREATE TEMP TABLE _ews_stage "
+            "(envelope_id INT, shard_db TEXT, lmdb_subdb TEXT, word TEXT, token_id TEXT, "
+            " word_length SMALLINT, ns TEXT, characteristics INT, category TEXT, base_priority INT, "
+            " morpheme TEXT, source_query_id INT) "
+            "ON COMMIT DELETE ROWS");
+        PQclear(tmpRes);
+        PQexec(varConn, "BEGIN");
+        PGresult* copyRes = PQexec(varConn,
+            "COPY _ews_stage "
+            "(envelope_id, shard_db, lmdb_subdb, word, token_id, "
+            " word_length, ns, characteristics, category, base_priority, morpheme, "
+            " source_query_id) "
+            "FROM STDIN");
+
+        if (PQresultStatus(copyRes) != PGRES_COPY_IN)
+        {
+            fprintf(stderr, "[EnvelopeManager] COPY start failed: %s\n",
+                PQerrorMessage(varConn));
+            fflush(stderr);
+            PQclear(copyRes);
+            PQclear(res);
+            PQexec(varConn, "ROLLBACK");
+            return 0;
+        }
+        PQclear(copyRes);
+
+        std::string envIdStr = std::to_string(envelopeId);
+        std::string shardDbStr(group[0]->shardDb.c_str(), group[0]->shardDb.size());
+
+        // Per-branch provenance, indexed by the _q tag.
+        AZStd::vector<std::string> queryIdStrs;
+        AZStd::vector<std::string> subdbStrs;
+        for (const EnvelopeQuery* q : group)
+        {
+            queryIdStrs.push_back(std::to_string(q->id));
+            subdbStrs.push_back(std::string(q->lmdbSubdb.c_str(), q->lmdbSubdb.size()));
+        }
+
+        for (int i = 0; i < nrows; ++i)
+        {
+            int branch = atoi(PQgetvalue(res, i, 0));
+            if (branch < 0 || branch >= static_cast<int>(group.size())) continue;
+
+            const char* word     = PQgetvalue(res, i, 1);
+            const char* tokenId  = PQgetvalue(res, i, 2);
+            const char* wordLen  = PQgetvalue(res, i, 3);
+            const char* ns       = PQgetvalue(res, i, 4);
+            const char* charStr  = PQgetvalue(res, i, 5);
+            const char* category = PQgetlength(res, i, 6) > 0 ? PQgetvalue(res, i, 6) : nullptr;
+            const char* morpheme = PQgetlength(res, i, 7) > 0 ? PQgetvalue(res, i, 7) : nullptr;
+
+            std::string line;
+            line.reserve(72);
+
+            line += envIdStr; line += '\t';
+            AppendCopyField(line, shardDbStr.c_str(), (int)shardDbStr.size(), true);
+            AppendCopyField(line, subdbStrs[branch].c_str(), (int)subdbStrs[branch].size(), true);
+            AppendCopyField(line, word, PQgetlength(res, i, 1), true);
+            AppendCopyField(line, tokenId, PQgetlength(res, i, 2), true);
+            AppendCopyField(line, wordLen, PQgetlength(res, i, 3), true);
+            AppendCopyField(line, ns, PQgetlength(res, i, 4), true);
+            AppendCopyField(line, charStr, PQgetlength(res, i, 5), true);
+            AppendCopyField(line, category, category ? (int)strlen(category) : 0, true);
+            std::string priorityStr = std::to_string(startOffset + i);
+            line += priorityStr; line += '\t';
+            AppendCopyField(line, morpheme, morpheme ? (int)strlen(morpheme) : 0, true);
+            line += queryIdStrs[branch];
+            line += '\n';
+
+            if (PQputCopyData(varConn, line.c_str(), (int)line.size()) != 1)
+                break;
+        }
+
+        PQputCopyEnd(varConn, nullptr);
+
+        PGresult* endRes;
+        while ((endRes = PQgetResult(varConn)) != nullptr)
+        {
+            ExecStatusType st = PQresultStatus(endRes);
+            if (st != PGRES_COMMAND_OK)
+            {
+                fprintf(stderr, "[EnvelopeManager] COPY end error (%s): %s\n",
+                    PQresStatus(st), PQerrorMessage(varConn));
+                fflush(stderr);
+            }
+            PQclear(endRes);
+        }
+
+        // ORDER BY base_priority: insertion order decides ON CONFLICT winners,
+        // and lower base_priority = earlier plan position, as before.
+        PGresult* mergeRes = PQexec(varConn,
+            "INSERT INTO envelope_working_set "
+            "(envelope_id, shard_db, lmdb_subdb, word, token_id, word_length, ns, characteristics, category, base_priority, morpheme, source_query_id) "
+            "SELECT envelope_id, shard_db, lmdb_subdb, word, token_id, word_length, ns, characteristics, category, base_priority, morpheme, source_query_id "
+            "FROM _ews_stage ORDER BY base_priority "
+            "ON CONFLICT (envelope_id, lmdb_subdb, word) DO NOTHING");
+
+        int merged = 0;
+        if (PQresultStatus(mergeRes) == PGRES_COMMAND_OK)
+            merged = atoi(PQcmdTuples(mergeRes));
+        else
+        {
+            fprintf(stderr, "[EnvelopeManager] Merge from stage failed: %s\n",
+                PQerrorMessage(varConn));
+            fflush(stderr);
+        }
+        PQclear(mergeRes);
+
+        PQexec(varConn, "COMMIT");
+        PQclear(res);
+
+        return merged;
+    }
+
     // ---------------------------------------------------------------------------
     // Warm → LMDB: read envelope_working_set ordered by effective_priority,
     // write to LMDB sub-dbs. Also populates t2w reverse for w2t writes.
     // ---------------------------------------------------------------------------
     int HCPEnvelopeManager::FlushWorkingSetToLmdb(int envelopeId)
     {
+        if (m_lmdbReadOnly) return 0;                 // the writer owns the hot window
         PGconn* varConn = GetShardConnection("hcp_var");
         if (!varConn || !m_lmdbEnv) return 0;
 
@@ -649,40 +976,18 @@ namespace HCPEngine
     // Hot-cache window management
     // ---------------------------------------------------------------------------
 
-    int HCPEnvelopeManager::FeedSlice(int envelopeId, int offset, int count)
+    // ---------------------------------------------------------------------------
+    // LMDB write halves of FeedSlice / EvictSlice, shared with the lane's
+    // whole-transition requests (Kind::Advance). Safe from either thread: LMDB
+    // serializes write transactions internally, so a lane commit and a
+    // foreground commit queue behind one another rather than interleave.
+    // ---------------------------------------------------------------------------
+    int HCPEnvelopeManager::WriteFeedRows(const AZStd::vector<FeedRow>& rows)
     {
-        PGconn* varConn = GetShardConnection("hcp_var");
-        if (!varConn || !m_lmdbEnv) return 0;
-
-        AZStd::string envIdStr  = AZStd::string::format("%d", envelopeId);
-        AZStd::string offsetStr = AZStd::string::format("%d", offset);
-        AZStd::string countStr  = AZStd::string::format("%d", count);
-        const char* params[] = { envIdStr.c_str(), offsetStr.c_str(), countStr.c_str() };
-
-        // Include morpheme column (migration 044) — stored as extended LMDB value
-        // format: token_id (14 bytes) + '\x00' + morpheme_name (if non-empty).
-        PGresult* res = PQexecParams(varConn,
-            "SELECT word, token_id, lmdb_subdb, morpheme "
-            "FROM envelope_working_set "
-            "WHERE envelope_id = $1 "
-            "ORDER BY lmdb_subdb, word_length, effective_priority "
-            "OFFSET $2 LIMIT $3",
-            3, nullptr, params, nullptr, nullptr, 0);
-
-        if (PQresultStatus(res) != PGRES_TUPLES_OK)
-        {
-            fprintf(stderr, "[EnvelopeManager] FeedSlice query failed: %s\n",
-                PQerrorMessage(varConn));
-            fflush(stderr);
-            PQclear(res);
-            return 0;
-        }
-
-        int nrows = PQntuples(res);
-        if (nrows == 0) { PQclear(res); return 0; }
+        if (!m_lmdbEnv || m_lmdbReadOnly || rows.empty()) return 0;
 
         MDB_txn* txn = nullptr;
-        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0) { PQclear(res); return 0; }
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0) return 0;
 
         std::string currentSubdb;
         MDB_dbi dbi    = 0;
@@ -690,20 +995,13 @@ namespace HCPEngine
         bool t2wOpen   = false;
         int written    = 0;
 
-        for (int i = 0; i < nrows; ++i)
+        for (const FeedRow& row : rows)
         {
-            const char* word     = PQgetvalue(res, i, 0);
-            const char* tokenId  = PQgetvalue(res, i, 1);
-            const char* subdb    = PQgetvalue(res, i, 2);
-            int wordLen  = PQgetlength(res, i, 0);
-            int tokenLen = PQgetlength(res, i, 1);
-            int morphLen = PQgetlength(res, i, 3);
-            const char* morpheme = (morphLen > 0) ? PQgetvalue(res, i, 3) : nullptr;
-
-            if (currentSubdb != subdb)
+            if (currentSubdb != row.subdb.c_str())
             {
-                currentSubdb = subdb;
-                if (mdb_dbi_open(txn, subdb, MDB_CREATE, &dbi) != 0) { dbi = 0; continue; }
+                currentSubdb = row.subdb.c_str();
+                if (mdb_dbi_open(txn, currentSubdb.c_str(), MDB_CREATE, &dbi) != 0)
+                { dbi = 0; continue; }
                 t2wOpen = false;
                 if (currentSubdb == "w2t")
                     t2wOpen = (mdb_dbi_open(txn, "t2w", MDB_CREATE, &dbiT2w) == 0);
@@ -711,22 +1009,22 @@ namespace HCPEngine
 
             if (dbi == 0) continue;
 
-            MDB_val mKey = { static_cast<size_t>(wordLen), const_cast<char*>(word) };
+            MDB_val mKey = { row.word.size(), const_cast<char*>(row.word.data()) };
 
             // Extended LMDB value: token_id + '\x00' + morpheme (if non-empty)
             // RebuildVocab checks val.mv_size > 14 && val.mv_data[14] == '\x00' to decode.
             std::string extVal;
             MDB_val mVal;
-            if (morpheme && morphLen > 0)
+            if (!row.morpheme.empty())
             {
-                extVal.assign(tokenId, tokenLen);
+                extVal.assign(row.tokenId.data(), row.tokenId.size());
                 extVal += '\x00';
-                extVal.append(morpheme, morphLen);
+                extVal.append(row.morpheme.data(), row.morpheme.size());
                 mVal = { extVal.size(), const_cast<char*>(extVal.data()) };
             }
             else
             {
-                mVal = { static_cast<size_t>(tokenLen), const_cast<char*>(tokenId) };
+                mVal = { row.tokenId.size(), const_cast<char*>(row.tokenId.data()) };
             }
 
             if (mdb_put(txn, dbi, &mKey, &mVal, 0) == 0)
@@ -734,64 +1032,188 @@ namespace HCPEngine
                 ++written;
                 if (t2wOpen)
                 {
-                    MDB_val rKey = { static_cast<size_t>(tokenLen), const_cast<char*>(tokenId) };
-                    MDB_val rVal = { static_cast<size_t>(wordLen),  const_cast<char*>(word) };
+                    MDB_val rKey = { row.tokenId.size(), const_cast<char*>(row.tokenId.data()) };
+                    MDB_val rVal = { row.word.size(),    const_cast<char*>(row.word.data()) };
                     mdb_put(txn, dbiT2w, &rKey, &rVal, MDB_NOOVERWRITE);
                 }
             }
         }
 
         mdb_txn_commit(txn);
-        PQclear(res);
-
-        fprintf(stderr, "[EnvelopeManager] FeedSlice(offset=%d, count=%d): %d written\n",
-            offset, count, written);
-        fflush(stderr);
         return written;
     }
 
-    // ---------------------------------------------------------------------------
-    void HCPEnvelopeManager::ClearHotWindow()
+    int HCPEnvelopeManager::DeleteEvictRows(const AZStd::vector<EvictRow>& rows)
     {
-        if (!m_lmdbEnv) return;
+        if (!m_lmdbEnv || m_lmdbReadOnly || rows.empty()) return 0;
+
         MDB_txn* txn = nullptr;
-        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0) return;
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0) return 0;
+
+        std::string currentSubdb;
         MDB_dbi dbi = 0;
-        if (mdb_dbi_open(txn, "w2t", 0, &dbi) == 0)
-            mdb_drop(txn, dbi, 0);   // del=0: clear contents, keep the named db
+        int evicted = 0;
+
+        for (const EvictRow& row : rows)
+        {
+            if (currentSubdb != row.subdb.c_str())
+            {
+                currentSubdb = row.subdb.c_str();
+                dbi = 0;
+                mdb_dbi_open(txn, currentSubdb.c_str(), 0, &dbi);
+            }
+
+            if (dbi == 0) continue;
+
+            MDB_val mKey = { row.word.size(), const_cast<char*>(row.word.data()) };
+            if (mdb_del(txn, dbi, &mKey, nullptr) == 0)
+                ++evicted;
+        }
+
         mdb_txn_commit(txn);
+        return evicted;
     }
 
-    // ---------------------------------------------------------------------------
-    void HCPEnvelopeManager::EvictSlice(int envelopeId, int offset, int count)
+    int HCPEnvelopeManager::FeedSlice(int envelopeId, int offset, int count)
     {
+        if (!m_lmdbEnv || m_lmdbReadOnly) return 0;   // the writer owns the hot window
+        ScopedStageTimer stageTimer(ResolveStage::LmdbFeed);
+
+        // Consume a staged slice if the prefetch lane already fetched these rows.
+        // If the lane is mid-query on this slice, wait for it — the request was
+        // queued one window-advance ago, so it is normally long done.
+        AZStd::vector<FeedRow> rows;
+        bool staged = false;
+        {
+            AZ::u64 key = StageKey(envelopeId, 0, offset);
+            std::unique_lock<std::mutex> lock(m_prefetchMutex);
+            m_prefetchDone.wait(lock,
+                [&] { return m_inFlight.find(key) == m_inFlight.end(); });
+            auto it = m_stagedSlices.find(key);
+            if (it != m_stagedSlices.end())
+            {
+                rows = AZStd::move(it->second);
+                m_stagedSlices.erase(it);
+                staged = true;
+            }
+        }
+
+        if (!staged)
+        {
+            PGconn* varConn = GetShardConnection("hcp_var");
+            if (!varConn) return 0;
+
+            AZStd::string envIdStr  = AZStd::string::format("%d", envelopeId);
+            AZStd::string offsetStr = AZStd::string::format("%d", offset);
+            AZStd::string countStr  = AZStd::string::format("%d", count);
+            const char* params[] = { envIdStr.c_str(), offsetStr.c_str(), countStr.c_str() };
+
+            // Include morpheme column (migration 044) — stored as extended LMDB value
+            // format: token_id (14 bytes) + '\x00' + morpheme_name (if non-empty).
+            PGresult* res = PQexecParams(varConn,
+                "SELECT word, token_id, lmdb_subdb, morpheme "
+                "FROM envelope_working_set "
+                "WHERE envelope_id = $1 "
+                "ORDER BY lmdb_subdb, word_length, effective_priority "
+                "OFFSET $2 LIMIT $3",
+                3, nullptr, params, nullptr, nullptr, 0);
+
+            if (PQresultStatus(res) != PGRES_TUPLES_OK)
+            {
+                fprintf(stderr, "[EnvelopeManager] FeedSlice query failed: %s\n",
+                    PQerrorMessage(varConn));
+                fflush(stderr);
+                PQclear(res);
+                return 0;
+            }
+
+            int nrows = PQntuples(res);
+            rows.reserve(nrows);
+            for (int i = 0; i < nrows; ++i)
+            {
+                FeedRow row;
+                row.word    = AZStd::string(PQgetvalue(res, i, 0), PQgetlength(res, i, 0));
+                row.tokenId = AZStd::string(PQgetvalue(res, i, 1), PQgetlength(res, i, 1));
+                row.subdb   = AZStd::string(PQgetvalue(res, i, 2), PQgetlength(res, i, 2));
+                if (PQgetlength(res, i, 3) > 0)
+                    row.morpheme = AZStd::string(PQgetvalue(res, i, 3), PQgetlength(res, i, 3));
+                rows.push_back(AZStd::move(row));
+            }
+            PQclear(res);
+        }
+
+        if (rows.empty()) return 0;
+
+        int written = WriteFeedRows(rows);
+
+        fprintf(stderr, "[EnvelopeManager] FeedSlice(offset=%d, count=%d): %d written%s\n",
+            offset, count, written, staged ? " (staged)" : "");
+        fflush(stderr);
+
+        // Self-prime: the sliding window advances by one slice per call, so the
+        // next feed will want [offset + count, offset + 2*count). Queue it now.
+        if (PrefetchEnabled() && static_cast<int>(rows.size()) == count)
+            PrefetchSliceAsync(envelopeId, offset + count, count);
+
+        return written;
+    }
+
+    // ---------------------------------------------------------------------------
+    void HCPEnvelopeManager::ClearHotWindow()
+    {
+        if (!m_lmdbEnv || m_lmdbReadOnly) return;
+        MDB_txn* txn = nullptr;
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0) return;
+        MDB_dbi dbi = 0;
+        if (mdb_dbi_open(txn, "w2t", 0, &dbi) == 0)
+            mdb_drop(txn, dbi, 0);   // del=0: clear contents, keep the named db
+        mdb_txn_commit(txn);
+    }
+
+    // ---------------------------------------------------------------------------
+    // Diff activation eviction: drop only the w2t entries whose provenance
+    // (the stored query that assembled them — migration 051) the incoming
+    // plan no longer carries. Rows with NULL provenance predate the migration
+    // and are evicted conservatively. t2w is left intact, as everywhere else.
+    // ---------------------------------------------------------------------------
+    int HCPEnvelopeManager::EvictRemovedQueryEntries(int envelopeId,
+        const AZStd::unordered_set<int>& removedQueryIds)
+    {
+        if (m_lmdbReadOnly) return 0;
         PGconn* varConn = GetShardConnection("hcp_var");
-        if (!varConn || !m_lmdbEnv) return;
+        if (!varConn || !m_lmdbEnv) return 0;
 
-        AZStd::string envIdStr  = AZStd::string::format("%d", envelopeId);
-        AZStd::string offsetStr = AZStd::string::format("%d", offset);
-        AZStd::string countStr  = AZStd::string::format("%d", count);
-        const char* params[] = { envIdStr.c_str(), offsetStr.c_str(), countStr.c_str() };
+        // Postgres int[] literal of the removed query ids (empty array still
+        // sweeps the NULL-provenance rows).
+        AZStd::string removedArr = "{";
+        for (int qid : removedQueryIds)
+        {
+            if (removedArr.size() > 1) removedArr += ',';
+            removedArr += AZStd::string::format("%d", qid);
+        }
+        removedArr += "}";
+
+        AZStd::string envIdStr = AZStd::string::format("%d", envelopeId);
+        const char* params[] = { envIdStr.c_str(), removedArr.c_str() };
 
-        // Query only word + subdb — t2w is NOT evicted (accumulates for reconstruction).
         PGresult* res = PQexecParams(varConn,
             "SELECT word, lmdb_subdb "
             "FROM envelope_working_set "
             "WHERE envelope_id = $1 "
-            "ORDER BY lmdb_subdb, word_length, effective_priority "
-            "OFFSET $2 LIMIT $3",
-            3, nullptr, params, nullptr, nullptr, 0);
+            "AND (source_query_id IS NULL OR source_query_id = ANY($2::int[])) "
+            "ORDER BY lmdb_subdb",
+            2, nullptr, params, nullptr, nullptr, 0);
 
         if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) == 0)
         {
             PQclear(res);
-            return;
+            return 0;
         }
 
         int nrows = PQntuples(res);
 
         MDB_txn* txn = nullptr;
-        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0) { PQclear(res); return; }
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0) { PQclear(res); return 0; }
 
         std::string currentSubdb;
         MDB_dbi dbi = 0;
@@ -820,6 +1242,51 @@ namespace HCPEngine
         mdb_txn_commit(txn);
         PQclear(res);
 
+        return evicted;
+    }
+
+    // ---------------------------------------------------------------------------
+    void HCPEnvelopeManager::EvictSlice(int envelopeId, int offset, int count)
+    {
+        if (m_lmdbReadOnly) return;
+        PGconn* varConn = GetShardConnection("hcp_var");
+        if (!varConn || !m_lmdbEnv) return;
+
+        AZStd::string envIdStr  = AZStd::string::format("%d", envelopeId);
+        AZStd::string offsetStr = AZStd::string::format("%d", offset);
+        AZStd::string countStr  = AZStd::string::format("%d", count);
+        const char* params[] = { envIdStr.c_str(), offsetStr.c_str(), countStr.c_str() };
+
+        // Query only word + subdb — t2w is NOT evicted (accumulates for reconstruction).
+        PGresult* res = PQexecParams(varConn,
+            "SELECT word, lmdb_subdb "
+            "FROM envelope_working_set "
+            "WHERE envelope_id = $1 "
+            "ORDER BY lmdb_subdb, word_length, effective_priority "
+            "OFFSET $2 LIMIT $3",
+            3, nullptr, params, nullptr, nullptr, 0);
+
+        if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) == 0)
+        {
+            PQclear(res);
+            return;
+        }
+
+        int nrows = PQntuples(res);
+
+        AZStd::vector<EvictRow> rows;
+        rows.reserve(nrows);
+        for (int i = 0; i < nrows; ++i)
+        {
+            EvictRow row;
+            row.word  = AZStd::string(PQgetvalue(res, i, 0), PQgetlength(res, i, 0));
+            row.subdb = AZStd::string(PQgetvalue(res, i, 1), PQgetlength(res, i, 1));
+            rows.push_back(AZStd::move(row));
+        }
+        PQclear(res);
+
+        int evicted = DeleteEvictRows(rows);
+
         fprintf(stderr, "[EnvelopeManager] EvictSlice(offset=%d, count=%d): %d evicted\n",
             offset, count, evicted);
         fflush(stderr);
@@ -848,6 +1315,9 @@ namespace HCPEngine
     // ---------------------------------------------------------------------------
     void HCPEnvelopeManager::ClearWorkingSet(int envelopeId)
     {
+        // Staged prefetch results were read from the rows being deleted.
+        InvalidateStaging();
+
         PGconn* varConn = GetShardConnection("hcp_var");
         if (!varConn) return;
 
@@ -869,6 +1339,7 @@ namespace HCPEngine
     {
         AZStd::vector<VocabEntry> out;
         if (!m_coreConn) return out;
+        ScopedStageTimer stageTimer(ResolveStage::EnvelopeQuery);
 
         // Look up envelope id
         const char* params[] = { name.c_str() };
@@ -965,13 +1436,36 @@ namespace HCPEngine
             return;
         }
 
-        // Assemble: run all stored queries filtered to this word length
+        // Assemble: run all stored queries filtered to this word length.
+        // Consecutive same-shard queries fuse into one UNION ALL round trip
+        // (grouping stays consecutive so an interleaved plan keeps its
+        // priority order); HCP_QUERY_FUSION=0 restores one-at-a-time.
         auto t0 = std::chrono::high_resolution_clock::now();
         int rowOffset = 0;
-        for (const auto& q : m_activeQueries)
+        if (QueryFusionEnabled())
         {
-            int assembled = AssembleQuery(q, m_activeEnvelopeId, rowOffset, wordLength);
-            rowOffset += assembled;
+            size_t i = 0;
+            while (i < m_activeQueries.size())
+            {
+                AZStd::vector<const EnvelopeQuery*> group;
+                size_t j = i;
+                while (j < m_activeQueries.size()
+                    && m_activeQueries[j].shardDb == m_activeQueries[i].shardDb)
+                {
+                    group.push_back(&m_activeQueries[j]);
+                    ++j;
+                }
+                rowOffset += AssembleQueryGroup(group, m_activeEnvelopeId, rowOffset, wordLength);
+                i = j;
+            }
+        }
+        else
+        {
+            for (const auto& q : m_activeQueries)
+            {
+                int assembled = AssembleQuery(q, m_activeEnvelopeId, rowOffset, wordLength);
+                rowOffset += assembled;
+            }
         }
 
         m_assembledLengths[wordLength] = true;
@@ -991,7 +1485,29 @@ namespace HCPEngine
     {
         // Ensure this length has been assembled into the working set before querying.
         EnsureLengthAssembled(wordLength);
+        ScopedStageTimer stageTimer(ResolveStage::WarmBatch);
         AZStd::vector<VocabEntry> out;
+
+        // Staged read-ahead: the previous batch at this length queued this one on
+        // the prefetch lane. Consume it and queue the batch after — the resolve
+        // loop then only pays the Postgres round trip on the first batch per length.
+        {
+            AZ::u64 key = StageKey(envelopeId, wordLength, offset);
+            std::unique_lock<std::mutex> lock(m_prefetchMutex);
+            m_prefetchDone.wait(lock,
+                [&] { return m_inFlight.find(key) == m_inFlight.end(); });
+            auto it = m_stagedBatches.find(key);
+            if (it != m_stagedBatches.end())
+            {
+                out = AZStd::move(it->second);
+                m_stagedBatches.erase(it);
+                lock.unlock();
+                if (static_cast<int>(out.size()) == count)
+                    PrefetchWarmBatchAsync(envelopeId, wordLength, offset + count, count);
+                return out;
+            }
+        }
+
         PGconn* varConn = GetShardConnection("hcp_var");
         if (!varConn) return out;
 
@@ -1028,6 +1544,10 @@ namespace HCPEngine
         }
         PQclear(res);
 
+        // Queue the next batch at this length so the follow-up call finds it staged.
+        if (PrefetchEnabled() && static_cast<int>(out.size()) == count)
+            PrefetchWarmBatchAsync(envelopeId, wordLength, offset + count, count);
+
         return out;
     }
 
@@ -1131,7 +1651,7 @@ namespace HCPEngine
         const AZStd::vector<AZStd::string>& neededP3,
         const AZStd::vector<int>& neededLengths)
     {
-        if (!m_lmdbEnv || neededP3.empty() || neededLengths.empty()) return 0;
+        if (!m_lmdbEnv || m_lmdbReadOnly || neededP3.empty() || neededLengths.empty()) return 0;
 
         PGconn* shardConn = GetShardConnection("hcp_english");
         if (!shardConn) return 0;
@@ -1235,7 +1755,7 @@ namespace HCPEngine
     // ---------------------------------------------------------------------------
     int HCPEnvelopeManager::EvictManifest(const AZStd::string& envelopeName)
     {
-        if (!m_manifestOpen || !m_lmdbEnv) return 0;
+        if (!m_manifestOpen || !m_lmdbEnv || m_lmdbReadOnly) return 0;
 
         MDB_txn* txn = nullptr;
         if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0)
@@ -1281,7 +1801,7 @@ namespace HCPEngine
         const AZStd::string& subdb,
         int entryCount)
     {
-        if (!m_manifestOpen || !m_lmdbEnv || entryCount == 0) return;
+        if (!m_manifestOpen || !m_lmdbEnv || m_lmdbReadOnly || entryCount == 0) return;
 
         MDB_txn* txn = nullptr;
         if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0)
@@ -1303,6 +1823,97 @@ namespace HCPEngine
         mdb_txn_commit(txn);
     }
 
+    // ---------------------------------------------------------------------------
+    AZ::u64 HCPEnvelopeManager::ComputePlanHash(int envelopeId) const
+    {
+        // FNV-1a over the resolved query plan. Any change to the definition —
+        // query text, shard, target sub-db, priority, ordering, composition —
+        // changes the hash and invalidates the activation snapshot.
+        AZ::u64 h = 1469598103934665603ull;
+        auto fold = [&h](const char* data, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+                h = (h ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+        };
+        auto foldInt = [&fold](int v)
+        {
+            AZStd::string s = AZStd::string::format("|%d|", v);
+            fold(s.c_str(), s.size());
+        };
+
+        foldInt(envelopeId);
+        for (const auto& q : m_activeQueries)
+        {
+            foldInt(q.id);
+            foldInt(q.priority);
+            fold(q.shardDb.c_str(),   q.shardDb.size());
+            fold(q.queryText.c_str(), q.queryText.size());
+            fold(q.lmdbSubdb.c_str(), q.lmdbSubdb.size());
+        }
+        return h;
+    }
+
+    // ---------------------------------------------------------------------------
+    void HCPEnvelopeManager::RecordActivationSnapshot(
+        const AZStd::string& envelopeName, int envelopeId, AZ::u64 planHash)
+    {
+        if (!m_manifestOpen || !m_lmdbEnv || m_lmdbReadOnly) return;
+
+        MDB_txn* txn = nullptr;
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0)
+            return;
+
+        AZStd::string key = "snap:" + envelopeName;
+        AZStd::string record = AZStd::string::format("id=%d plan=%016llx",
+            envelopeId, static_cast<unsigned long long>(planHash));
+
+        MDB_val mdbKey = { key.size(),    const_cast<char*>(key.c_str()) };
+        MDB_val mdbVal = { record.size(), const_cast<char*>(record.c_str()) };
+        mdb_put(txn, m_manifestDbi, &mdbKey, &mdbVal, 0);
+        mdb_txn_commit(txn);
+    }
+
+    // ---------------------------------------------------------------------------
+    bool HCPEnvelopeManager::ValidateActivationSnapshot(
+        const AZStd::string& envelopeName, int envelopeId, AZ::u64 planHash)
+    {
+        if (!m_manifestOpen || !m_lmdbEnv) return false;
+
+        MDB_txn* txn = nullptr;
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, MDB_RDONLY, &txn) != 0)
+            return false;
+
+        AZStd::string key = "snap:" + envelopeName;
+        MDB_val mdbKey = { key.size(), const_cast<char*>(key.c_str()) };
+        MDB_val mdbVal;
+
+        bool valid = false;
+        if (mdb_get(txn, m_manifestDbi, &mdbKey, &mdbVal) == 0)
+        {
+            AZStd::string expected = AZStd::string::format("id=%d plan=%016llx",
+                envelopeId, static_cast<unsigned long long>(planHash));
+            valid = (mdbVal.mv_size == expected.size() &&
+                     memcmp(mdbVal.mv_data, expected.c_str(), expected.size()) == 0);
+        }
+        mdb_txn_abort(txn);
+        return valid;
+    }
+
+    // ---------------------------------------------------------------------------
+    void HCPEnvelopeManager::ClearActivationSnapshot(const AZStd::string& envelopeName)
+    {
+        if (!m_manifestOpen || !m_lmdbEnv || m_lmdbReadOnly) return;
+
+        MDB_txn* txn = nullptr;
+        if (mdb_txn_begin(m_lmdbEnv, nullptr, 0, &txn) != 0)
+            return;
+
+        AZStd::string key = "snap:" + envelopeName;
+        MDB_val mdbKey = { key.size(), const_cast<char*>(key.c_str()) };
+        mdb_del(txn, m_manifestDbi, &mdbKey, nullptr);
+        mdb_txn_commit(txn);
+    }
+
     // ---------------------------------------------------------------------------
     void HCPEnvelopeManager::LogActivation(
         const EnvelopeActivation& activation,
@@ -1354,9 +1965,524 @@ namespace HCPEngine
         return conn;
     }
 
+    // ---------------------------------------------------------------------------
+    // Read-ahead prefetch lane — one background thread running speculative warm-set
+    // queries on lane-owned connections, staging rows for the foreground to consume.
+    // ---------------------------------------------------------------------------
+
+    bool HCPEnvelopeManager::PrefetchEnabled()
+    {
+        // Default ON; HCP_ENVELOPE_PREFETCH=0 restores fully synchronous warm queries.
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_ENVELOPE_PREFETCH");
+            return !(v && v[0] == '0');
+        }();
+        return enabled;
+    }
+
+    void HCPEnvelopeManager::PrefetchWarmBatchAsync(
+        int envelopeId, int wordLength, int offset, int count)
+    {
+        if (!PrefetchEnabled()) return;
+        PrefetchRequest req;
+        req.kind       = PrefetchRequest::Kind::WarmBatch;
+        req.envelopeId = envelopeId;
+        req.wordLength = wordLength;
+        req.offset     = offset;
+        req.count      = count;
+        EnqueuePrefetch(AZStd::move(req));
+    }
+
+    void HCPEnvelopeManager::PrefetchSliceAsync(int envelopeId, int offset, int count)
+    {
+        if (!PrefetchEnabled()) return;
+        PrefetchRequest req;
+        req.kind       = PrefetchRequest::Kind::Slice;
+        req.envelopeId = envelopeId;
+        req.offset     = offset;
+        req.count      = count;
+        EnqueuePrefetch(AZStd::move(req));
+    }
+
+    void HCPEnvelopeManager::AdvanceSliceAsync(int envelopeId, int evictOffset,
+        int feedOffset, int count)
+    {
+        if (!PrefetchEnabled()) return;
+        if (!m_lmdbEnv || m_lmdbReadOnly) return;   // the writer owns the hot window
+        PrefetchRequest req;
+        req.kind        = PrefetchRequest::Kind::Advance;
+        req.envelopeId  = envelopeId;
+        req.evictOffset = evictOffset;
+        req.offset      = feedOffset;
+        req.count       = count;
+        EnqueuePrefetch(AZStd::move(req));
+    }
+
+    bool HCPEnvelopeManager::TakeSliceAdvance(int envelopeId, int feedOffset, SliceAdvance& out)
+    {
+        AZ::u64 key = AdvanceKey(envelopeId, feedOffset);
+        std::unique_lock<std::mutex> lock(m_prefetchMutex);
+        m_prefetchDone.wait(lock,
+            [&] { return m_inFlight.find(key) == m_inFlight.end(); });
+        auto it = m_stagedAdvances.find(key);
+        if (it == m_stagedAdvances.end()) return false;
+        out = AZStd::move(it->second);
+        m_stagedAdvances.erase(it);
+        return true;
+    }
+
+    void HCPEnvelopeManager::PrefetchEnvelopeEntriesAsync(const AZStd::string& envelopeName)
+    {
+        if (!PrefetchEnabled() || envelopeName.empty()) return;
+        PrefetchRequest req;
+        req.kind         = PrefetchRequest::Kind::Envelope;
+        req.envelopeName = envelopeName;
+        EnqueuePrefetch(AZStd::move(req));
+    }
+
+    bool HCPEnvelopeManager::TakeStagedEnvelopeEntries(
+        const AZStd::string& envelopeName, AZStd::vector<VocabEntry>& out)
+    {
+        std::unique_lock<std::mutex> lock(m_prefetchMutex);
+        m_prefetchDone.wait(lock,
+            [&] { return m_envelopeInFlight.find(envelopeName) == m_envelopeInFlight.end(); });
+        auto it = m_stagedEnvelopes.find(envelopeName);
+        if (it == m_stagedEnvelopes.end()) return false;
+        out = AZStd::move(it->second);
+        m_stagedEnvelopes.erase(it);
+        return true;
+    }
+
+    void HCPEnvelopeManager::EnqueuePrefetch(PrefetchRequest&& req)
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        if (m_prefetchStop) return;
+
+        // Dedup: drop requests whose result is already staged or mid-query.
+        if (req.kind == PrefetchRequest::Kind::Envelope)
+        {
+            if (m_envelopeInFlight.count(req.envelopeName) ||
+                m_stagedEnvelopes.count(req.envelopeName)) return;
+            m_envelopeInFlight.insert(req.envelopeName);
+        }
+        else
+        {
+            // Slices use wordLength = 0; warm batches are length >= 2; whole
+            // transitions use the 0xFF sentinel — no collisions.
+            AZ::u64 key = req.kind == PrefetchRequest::Kind::Advance
+                ? AdvanceKey(req.envelopeId, req.offset)
+                : StageKey(req.envelopeId, req.wordLength, req.offset);
+            if (m_inFlight.count(key)) return;
+            if (req.kind == PrefetchRequest::Kind::WarmBatch && m_stagedBatches.count(key)) return;
+            if (req.kind == PrefetchRequest::Kind::Slice && m_stagedSlices.count(key)) return;
+            if (req.kind == PrefetchRequest::Kind::Advance && m_stagedAdvances.count(key)) return;
+            m_inFlight.insert(key);
+        }
+
+        if (!m_prefetchRunning)
+        {
+            m_prefetchRunning = true;
+            m_prefetchThread = std::thread(&HCPEnvelopeManager::PrefetchThreadMain, this);
+        }
+        m_prefetchQueue.push_back(AZStd::move(req));
+        m_prefetchWork.notify_one();
+    }
+
+    void HCPEnvelopeManager::StopPrefetchThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_prefetchMutex);
+            if (!m_prefetchRunning) return;
+            m_prefetchStop = true;
+            m_prefetchQueue.clear();
+            m_prefetchWork.notify_one();
+        }
+        m_prefetchThread.join();
+
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        m_prefetchRunning = false;
+        m_prefetchStop    = false;
+        m_prefetchQueue.clear();
+        m_stagedBatches.clear();
+        m_stagedSlices.clear();
+        m_stagedAdvances.clear();
+        m_stagedEnvelopes.clear();
+        m_inFlight.clear();
+        m_envelopeInFlight.clear();
+        m_prefetchDone.notify_all();
+    }
+
+    void HCPEnvelopeManager::InvalidateStaging()
+    {
+        std::unique_lock<std::mutex> lock(m_prefetchMutex);
+        if (!m_prefetchRunning &&
+            m_stagedBatches.empty() && m_stagedSlices.empty() &&
+            m_stagedAdvances.empty() && m_stagedEnvelopes.empty())
+            return;
+
+        // Drop queued-but-not-started requests and release their in-flight marks
+        // so any foreground waiter falls through to the synchronous path.
+        for (const auto& queued : m_prefetchQueue)
+        {
+            if (queued.kind == PrefetchRequest::Kind::Envelope)
+                m_envelopeInFlight.erase(queued.envelopeName);
+            else if (queued.kind == PrefetchRequest::Kind::Advance)
+                m_inFlight.erase(AdvanceKey(queued.envelopeId, queued.offset));
+            else
+                m_inFlight.erase(StageKey(queued.envelopeId, queued.wordLength, queued.offset));
+        }
+        m_prefetchQueue.clear();
+        m_prefetchDone.notify_all();
+
+        // Let the lane finish the request it is running (at most one), then drop
+        // everything staged — it was read from rows that are being rewritten.
+        m_prefetchDone.wait(lock,
+            [&] { return m_inFlight.empty() && m_envelopeInFlight.empty(); });
+        m_stagedBatches.clear();
+        m_stagedSlices.clear();
+        m_stagedAdvances.clear();
+        m_stagedEnvelopes.clear();
+    }
+
+    void HCPEnvelopeManager::PrefetchThreadMain()
+    {
+        // Lane-owned connections. PGconn is not thread-safe, so the lane never
+        // touches m_shardConns or m_coreConn — it opens its own hcp_var (local
+        // warm tier) and core (envelope definitions) connections lazily and
+        // closes them on exit.
+        PGconn* varConn  = nullptr;
+        PGconn* coreConn = nullptr;
+
+        auto ensureConn = [](PGconn*& conn, const char* connStr, const char* label) -> PGconn*
+        {
+            if (conn && PQstatus(conn) == CONNECTION_OK) return conn;
+            if (conn) { PQfinish(conn); conn = nullptr; }
+            PGconn* fresh = PQconnectdb(connStr);
+            if (PQstatus(fresh) != CONNECTION_OK)
+            {
+                fprintf(stderr, "[EnvelopeManager] Prefetch lane: %s connect failed: %s\n",
+                    label, PQerrorMessage(fresh));
+                fflush(stderr);
+                PQfinish(fresh);
+                return nullptr;
+            }
+            conn = fresh;
+            return conn;
+        };
+        auto ensureVar = [&]() {
+            return ensureConn(varConn,
+                "host=localhost port=5432 dbname=hcp_var user=hcp password=hcp_dev", "hcp_var");
+        };
+
+        for (;;)
+        {
+            PrefetchRequest req;
+            {
+                std::unique_lock<std::mutex> lock(m_prefetchMutex);
+                m_prefetchWork.wait(lock,
+                    [&] { return m_prefetchStop || !m_prefetchQueue.empty(); });
+                if (m_prefetchStop) break;
+                req = AZStd::move(m_prefetchQueue.front());
+                m_prefetchQueue.pop_front();
+            }
+
+            if (req.kind == PrefetchRequest::Kind::WarmBatch)
+            {
+                // Same SELECT as QueryWarmBatch. Offset-0 requests may be
+                // speculative (queued before any foreground batch assembled the
+                // length) — those legitimately return zero rows, handled below.
+                AZStd::vector<VocabEntry> entries;
+                bool ok = false;
+                if (PGconn* conn = ensureVar())
+                {
+                    AZStd::string envIdStr  = AZStd::string::format("%d", req.envelopeId);
+                    AZStd::string lenStr    = AZStd::string::format("%d", req.wordLength);
+                    AZStd::string offsetStr = AZStd::string::format("%d", req.offset);
+                    AZStd::string countStr  = AZStd::string::format("%d", req.count);
+                    const char* params[] = { envIdStr.c_str(), lenStr.c_str(),
+                                             offsetStr.c_str(), countStr.c_str() };
+
+                    PGresult* res = PQexecParams(conn,
+                        "SELECT word, token_id, morpheme "
+                        "FROM envelope_working_set "
+                        "WHERE envelope_id = $1 AND word_length = $2 "
+                        "ORDER BY effective_priority "
+                        "OFFSET $3 LIMIT $4",
+                        4, nullptr, params, nullptr, nullptr, 0);
+
+                    if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                    {
+                        ok = true;
+                        int rows = PQntuples(res);
+                        entries.reserve(rows);
+                        for (int i = 0; i < rows; ++i)
+                        {
+                            VocabEntry e;
+                            e.word    = AZStd::string(PQgetvalue(res, i, 0));
+                            e.tokenId = AZStd::string(PQgetvalue(res, i, 1));
+                            if (PQgetlength(res, i, 2) > 0)
+                                e.morpheme = AZStd::string(PQgetvalue(res, i, 2));
+                            entries.push_back(AZStd::move(e));
+                        }
+                    }
+                    PQclear(res);
+                }
+
+                AZ::u64 key = StageKey(req.envelopeId, req.wordLength, req.offset);
+                std::lock_guard<std::mutex> lock(m_prefetchMutex);
+                // Stage only non-empty successes. On failure the foreground
+                // re-queries synchronously instead of mistaking a hiccup for
+                // exhaustion; an empty result can mean the length was never
+                // assembled (speculative first-batch request), so exhaustion is
+                // always confirmed by the foreground's own query.
+                if (ok && !entries.empty() && m_inFlight.count(key))
+                    m_stagedBatches[key] = AZStd::move(entries);
+                m_inFlight.erase(key);
+                m_prefetchDone.notify_all();
+            }
+            else if (req.kind == PrefetchRequest::Kind::Slice)
+            {
+                // Same SELECT as FeedSlice; the LMDB write stays on the foreground.
+                AZStd::vector<FeedRow> rows;
+                bool ok = false;
+                if (PGconn* conn = ensureVar())
+                {
+                    AZStd::string envIdStr  = AZStd::string::format("%d", req.envelopeId);
+                    AZStd::string offsetStr = AZStd::string::format("%d", req.offset);
+                    AZStd::string countStr  = AZStd::string::format("%d", req.count);
+                    const char* params[] = { envIdStr.c_str(), offsetStr.c_str(), countStr.c_str() };
+
+                    PGresult* res = PQexecParams(conn,
+                        "SELECT word, token_id, lmdb_subdb, morpheme "
+                        "FROM envelope_working_set "
+                        "WHERE envelope_id = $1 "
+                        "ORDER BY lmdb_subdb, word_length, effective_priority "
+                        "OFFSET $2 LIMIT $3",
+                        3, nullptr, params, nullptr, nullptr, 0);
+
+                    if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                    {
+                        ok = true;
+                        int nrows = PQntuples(res);
+                        rows.reserve(nrows);
+                        for (int i = 0; i < nrows; ++i)
+                        {
+                            FeedRow row;
+                            row.word    = AZStd::string(PQgetvalue(res, i, 0), PQgetlength(res, i, 0));
+                            row.tokenId = AZStd::string(PQgetvalue(res, i, 1), PQgetlength(res, i, 1));
+                            row.subdb   = AZStd::string(PQgetvalue(res, i, 2), PQgetlength(res, i, 2));
+                            if (PQgetlength(res, i, 3) > 0)
+                                row.morpheme = AZStd::string(PQgetvalue(res, i, 3), PQgetlength(res, i, 3));
+                            rows.push_back(AZStd::move(row));
+                        }
+                    }
+                    PQclear(res);
+                }
+
+                AZ::u64 key = StageKey(req.envelopeId, 0, req.offset);
+                std::lock_guard<std::mutex> lock(m_prefetchMutex);
+                if (ok && m_inFlight.count(key))
+                    m_stagedSlices[key] = AZStd::move(rows);
+                m_inFlight.erase(key);
+                m_prefetchDone.notify_all();
+            }
+            else if (req.kind == PrefetchRequest::Kind::Advance)
+            {
+                // Whole slice transition off the foreground: evict SELECT and
+                // feed SELECT on the lane connection, then both LMDB write
+                // transactions right here — so the foreground's next
+                // AdvanceEnvelopeSlice is a pure in-memory splice. The w2t
+                // rows of both halves ride along for that splice.
+                SliceAdvance adv;
+                AZStd::vector<EvictRow> evictRows;
+                AZStd::vector<FeedRow>  feedRows;
+                bool evictOk = false;
+                bool feedOk  = false;
+
+                if (PGconn* conn = ensureVar())
+                {
+                    AZStd::string envIdStr  = AZStd::string::format("%d", req.envelopeId);
+                    AZStd::string evictStr  = AZStd::string::format("%d", req.evictOffset);
+                    AZStd::string offsetStr = AZStd::string::format("%d", req.offset);
+                    AZStd::string countStr  = AZStd::string::format("%d", req.count);
+
+                    // Same SELECT as EvictSlice (word + subdb only; t2w accumulates).
+                    const char* eParams[] = { envIdStr.c_str(), evictStr.c_str(), countStr.c_str() };
+                    PGresult* res = PQexecParams(conn,
+                        "SELECT word, lmdb_subdb "
+                        "FROM envelope_working_set "
+                        "WHERE envelope_id = $1 "
+                        "ORDER BY lmdb_subdb, word_length, effective_priority "
+                        "OFFSET $2 LIMIT $3",
+                        3, nullptr, eParams, nullptr, nullptr, 0);
+
+                    if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                    {
+                        evictOk = true;
+                        int nrows = PQntuples(res);
+                        evictRows.reserve(nrows);
+                        for (int i = 0; i < nrows; ++i)
+                        {
+                            EvictRow row;
+                            row.word  = AZStd::string(PQgetvalue(res, i, 0), PQgetlength(res, i, 0));
+                            row.subdb = AZStd::string(PQgetvalue(res, i, 1), PQgetlength(res, i, 1));
+                            if (row.subdb == "w2t")
+                                adv.evictedWords.push_back(row.word);
+                            evictRows.push_back(AZStd::move(row));
+                        }
+                    }
+                    PQclear(res);
+
+                    // Feed rows: a plain slice prefetch (FeedSlice self-prime)
+                    // may already have staged them — reuse instead of re-querying.
+                    {
+                        AZ::u64 sliceKey = StageKey(req.envelopeId, 0, req.offset);
+                        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+                        auto it = m_stagedSlices.find(sliceKey);
+                        if (it != m_stagedSlices.end())
+                        {
+                            feedRows = AZStd::move(it->second);
+                            m_stagedSlices.erase(it);
+                            feedOk = true;
+                        }
+                    }
+
+                    if (!feedOk)
+                    {
+                        const char* fParams[] = { envIdStr.c_str(), offsetStr.c_str(), countStr.c_str() };
+                        res = PQexecParams(conn,
+                            "SELECT word, token_id, lmdb_subdb, morpheme "
+                            "FROM envelope_working_set "
+                            "WHERE envelope_id = $1 "
+                            "ORDER BY lmdb_subdb, word_length, effective_priority "
+                            "OFFSET $2 LIMIT $3",
+                            3, nullptr, fParams, nullptr, nullptr, 0);
+
+                        if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                        {
+                            feedOk = true;
+                            int nrows = PQntuples(res);
+                            feedRows.reserve(nrows);
+                            for (int i = 0; i < nrows; ++i)
+                            {
+                                FeedRow row;
+                                row.word    = AZStd::string(PQgetvalue(res, i, 0), PQgetlength(res, i, 0));
+                                row.tokenId = AZStd::string(PQgetvalue(res, i, 1), PQgetlength(res, i, 1));
+                                row.subdb   = AZStd::string(PQgetvalue(res, i, 2), PQgetlength(res, i, 2));
+                                if (PQgetlength(res, i, 3) > 0)
+                                    row.morpheme = AZStd::string(PQgetvalue(res, i, 3), PQgetlength(res, i, 3));
+                                feedRows.push_back(AZStd::move(row));
+                            }
+                        }
+                        PQclear(res);
+                    }
+                }
+
+                // Stage only complete transitions: a splice applied on top of a
+                // half-transitioned index would drift from the hot window, so a
+                // failed half sends the foreground down the synchronous path.
+                const bool ok = evictOk && feedOk;
+                if (ok)
+                {
+                    for (const FeedRow& row : feedRows)
+                    {
+                        if (row.subdb != "w2t") continue;
+                        VocabEntry e;
+                        e.word     = row.word;
+                        e.tokenId  = row.tokenId;
+                        e.morpheme = row.morpheme;
+                        adv.entries.push_back(AZStd::move(e));
+                    }
+
+                    // Evict before feed, in sync-path order — a word leaving one
+                    // slot and re-entering at the next must end up present.
+                    int evicted = DeleteEvictRows(evictRows);
+                    int written = WriteFeedRows(feedRows);
+                    fprintf(stderr, "[EnvelopeManager] Lane slice advance: "
+                        "evict(offset=%d) %d, feed(offset=%d) %d\n",
+                        req.evictOffset, evicted, req.offset, written);
+                    fflush(stderr);
+                }
+
+                AZ::u64 key = AdvanceKey(req.envelopeId, req.offset);
+                std::lock_guard<std::mutex> lock(m_prefetchMutex);
+                if (ok && m_inFlight.count(key))
+                    m_stagedAdvances[key] = AZStd::move(adv);
+                m_inFlight.erase(key);
+                m_prefetchDone.notify_all();
+            }
+            else  // Kind::Envelope
+            {
+                // Same two-step lookup as QueryEnvelopeEntries: envelope id from
+                // the core db, entries from the warm db.
+                AZStd::vector<VocabEntry> entries;
+                bool ok = false;
+                PGconn* core = ensureConn(coreConn, m_coreConnStr.c_str(), "core");
+                if (core)
+                {
+                    const char* params[] = { req.envelopeName.c_str() };
+                    PGresult* res = PQexecParams(core,
+                        "SELECT id FROM envelope_definitions WHERE name = $1",
+                        1, nullptr, params, nullptr, nullptr, 0);
+
+                    int envId = 0;
+                    if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                        envId = atoi(PQgetvalue(res, 0, 0));
+                    PQclear(res);
+
+                    PGconn* conn = envId ? ensureVar() : nullptr;
+                    if (conn)
+                    {
+                        AZStd::string envIdStr  = AZStd::string::format("%d", envId);
+                        const char*   qParams[] = { envIdStr.c_str() };
+
+                        res = PQexecParams(conn,
+                            "SELECT word, token_id, morpheme "
+                            "FROM envelope_working_set "
+                            "WHERE envelope_id = $1 "
+                            "ORDER BY word_length, effective_priority",
+                            1, nullptr, qParams, nullptr, nullptr, 0);
+
+                        if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                        {
+                            ok = true;
+                            int nrows = PQntuples(res);
+                            entries.reserve(static_cast<size_t>(nrows));
+                            for (int i = 0; i < nrows; ++i)
+                            {
+                                VocabEntry e;
+                                e.word    = PQgetvalue(res, i, 0);
+                                e.tokenId = PQgetvalue(res, i, 1);
+                                if (PQgetlength(res, i, 2) > 0)
+                                    e.morpheme = PQgetvalue(res, i, 2);
+                                entries.push_back(AZStd::move(e));
+                            }
+                        }
+                        PQclear(res);
+                    }
+                }
+
+                fprintf(stderr, "[EnvelopeManager] Prefetch lane: '%s' staged %zu entries\n",
+                    req.envelopeName.c_str(), entries.size());
+                fflush(stderr);
+
+                std::lock_guard<std::mutex> lock(m_prefetchMutex);
+                if (ok && m_envelopeInFlight.count(req.envelopeName))
+                    m_stagedEnvelopes[req.envelopeName] = AZStd::move(entries);
+                m_envelopeInFlight.erase(req.envelopeName);
+                m_prefetchDone.notify_all();
+            }
+        }
+
+        if (varConn)  PQfinish(varConn);
+        if (coreConn) PQfinish(coreConn);
+    }
+
     // ---------------------------------------------------------------------------
     void HCPEnvelopeManager::Shutdown()
     {
+        StopPrefetchThread();
+
         for (auto& [_, conn] : m_shardConns)
         {
             if (conn) PQfinish(conn);
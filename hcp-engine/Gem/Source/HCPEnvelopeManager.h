@@ -3,9 +3,15 @@
 #include <AzCore/base.h>
 #include <AzCore/std/containers/vector.h>
 #include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
 #include <AzCore/std/string/string.h>
 #include "HCPResolutionChamber.h"  // InflectionRule
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
 // Forward declarations
 typedef struct pg_conn PGconn;
 struct MDB_env;
@@ -70,6 +76,16 @@ namespace HCPEngine
         AZStd::string morpheme;  // Morpheme name (e.g. "PAST", "PLURAL") or empty for canonical forms
     };
 
+    //! Row sets captured while the feeder lane ran a whole slice transition:
+    //! the w2t keys the evict removed and the w2t rows the feed wrote. BedManager
+    //! splices these into its in-memory vocab index instead of rescanning the
+    //! hot window (see AdvanceSliceAsync / TakeSliceAdvance).
+    struct SliceAdvance
+    {
+        AZStd::vector<AZStd::string> evictedWords;  // w2t keys deleted by the evict half
+        AZStd::vector<VocabEntry>    entries;       // w2t rows written by the feed half
+    };
+
     //! Manages the three-layer cache lifecycle:
     //!
     //!   Cold (hcp_english/hcp_core) → Warm (hcp_var.envelope_working_set) → Hot (LMDB)
@@ -99,6 +115,9 @@ namespace HCPEngine
         //! Activate an envelope: load definition, store query plan, clear LMDB hot cache.
         //! NO assembly — cold→warm queries are deferred to EnsureLengthAssembled().
         //! Multiple envelopes can be active; working set rows coexist by envelope_id.
+        //! Switching between envelopes whose plans share stored queries is a DIFF:
+        //! shared queries' w2t entries stay, only removed queries' entries are
+        //! evicted (see EvictRemovedQueryEntries) — no wholesale drop and re-feed.
         //! Returns activation stats (entriesLoaded = 0 for deferred assembly).
         EnvelopeActivation ActivateEnvelope(const AZStd::string& name);
 
@@ -141,8 +160,60 @@ namespace HCPEngine
         //! Uses per-length OFFSET so offsets stay small (max ~40K) instead of scanning
         //! through the global 535K ordering. Called from ResolveLengthCycle multi-slice loop.
         //! Returns entries in effective_priority order (highest-priority first, offset=0).
+        //! Consumes a staged read-ahead batch when the prefetch lane has one ready,
+        //! and queues the next batch so the resolve loop rarely waits on Postgres.
         AZStd::vector<VocabEntry> QueryWarmBatch(int envelopeId, int wordLength, int offset, int count);
 
+        // ---- Read-ahead prefetch lane ----
+        //
+        // A single background thread speculatively runs the warm-set queries for
+        // slice N+1 while the resolve loop consumes slice N, staging the rows in
+        // memory. The foreground consumes staged rows under m_prefetchMutex; the
+        // LMDB write in FeedSlice stays on the calling thread (local mmap, cheap —
+        // the Postgres round trip is the stall being hidden). The lane owns its
+        // own libpq connections: PGconn is not thread-safe and m_shardConns
+        // belongs to the foreground. Disable with HCP_ENVELOPE_PREFETCH=0.
+
+        //! Whether the read-ahead lane is enabled (HCP_ENVELOPE_PREFETCH, default on).
+        static bool PrefetchEnabled();
+
+        //! Queue a background QueryWarmBatch for (envelopeId, wordLength, offset, count).
+        //! Callers queue the NEXT batch after a foreground QueryWarmBatch (which
+        //! assembles) has returned for this length, and may also queue offset 0
+        //! SPECULATIVELY before the first foreground query — safe because the lane
+        //! never stages an empty result, so an unassembled length falls back to the
+        //! synchronous path (which assembles) instead of reading as exhausted.
+        void PrefetchWarmBatchAsync(int envelopeId, int wordLength, int offset, int count);
+
+        //! Queue a background fetch of the FeedSlice rows for [offset, offset+count).
+        //! FeedSlice consumes the staged rows and writes LMDB on the calling thread.
+        void PrefetchSliceAsync(int envelopeId, int offset, int count);
+
+        //! Queue a WHOLE slice transition on the lane: evict the slot leaving the
+        //! window, feed the incoming one. Unlike PrefetchSliceAsync, both Postgres
+        //! round trips AND both LMDB write transactions run off the foreground —
+        //! LMDB serializes writers internally, and resolve-side reads are MVCC
+        //! snapshots that never block on a writer — and the w2t rows of both
+        //! halves are staged for an in-memory index splice. No-op on read-only
+        //! stores (the writer process owns the hot window).
+        void AdvanceSliceAsync(int envelopeId, int evictOffset, int feedOffset, int count);
+
+        //! Claim the staged transition for (envelopeId, feedOffset). Waits if the
+        //! lane is mid-transition (it was queued one advance ago, so it is
+        //! normally long done). Returns false if never queued or failed — the
+        //! caller falls back to the synchronous evict/feed/rescan path.
+        bool TakeSliceAdvance(int envelopeId, int feedOffset, SliceAdvance& out);
+
+        //! Queue a background QueryEnvelopeEntries for a signal-picked envelope
+        //! (short-pass tense/register pre-fetch). Harvest with TakeStagedEnvelopeEntries.
+        void PrefetchEnvelopeEntriesAsync(const AZStd::string& envelopeName);
+
+        //! Move staged entries for a previously queued envelope prefetch into out.
+        //! Waits if the query is still running on the lane (it was issued a length
+        //! cycle ago, so it is usually done). Returns false if never queued/failed.
+        bool TakeStagedEnvelopeEntries(const AZStd::string& envelopeName,
+                                       AZStd::vector<VocabEntry>& out);
+
         //! Query a priority-ordered phase from the warm set across ALL word lengths.
         //! Returns entries in effective_priority order (Labels first, then special chars,
         //! then common vocab ascending, etc.). Triggers incremental child-envelope
@@ -166,6 +237,10 @@ namespace HCPEngine
         //! dbName defaults to "hcp_english" but is flaggable for other language shards.
         AZStd::vector<InflectionRule> LoadInflectionRules(const char* dbName = "hcp_english");
 
+        //! Wire the vocabulary so ActivateEnvelope can rebuild its flat w2t index
+        //! after replacing the hot window wholesale.
+        void SetVocabulary(HCPVocabulary* vocab) { m_vocabulary = vocab; }
+
         //! Get the currently active envelope name (empty if none).
         const AZStd::string& ActiveEnvelope() const { return m_activeEnvelope; }
 
@@ -180,6 +255,20 @@ namespace HCPEngine
         int AssembleQuery(const EnvelopeQuery& query, int envelopeId, int startOffset,
                           int targetLength = 0);
 
+        //! Fused cold → warm: one UNION ALL round trip for a run of same-shard
+        //! queries, branches tagged with their plan position so base_priority
+        //! ordering matches the sequential path, staged through a single COPY
+        //! transaction. Falls back to per-query AssembleQuery if the fused
+        //! statement fails (a stored query may not survive embedding).
+        //! Returns number of rows assembled across the group.
+        int AssembleQueryGroup(const AZStd::vector<const EnvelopeQuery*>& group,
+                               int envelopeId, int startOffset, int targetLength = 0);
+
+        //! Whether a stored query returns a 'morpheme' column (LIMIT 0 probe).
+        //! Cached by query id — EnsureLengthAssembled re-runs the full plan per
+        //! word length, and the probe answer never changes within an activation.
+        bool QueryHasMorpheme(PGconn* shardConn, const EnvelopeQuery& query);
+
         //! Warm → LMDB: read envelope_working_set for envelopeId ordered by
         //! effective_priority, write to LMDB sub-dbs. Also writes t2w reverse for w2t.
         //! Returns number of entries written.
@@ -191,11 +280,34 @@ namespace HCPEngine
         //! Evict all LMDB entries tracked in _manifest for a given envelope.
         int EvictManifest(const AZStd::string& envelopeName);
 
+        //! Diff activation: evict only the w2t entries assembled by queries the
+        //! incoming plan no longer carries (provenance = source_query_id,
+        //! migration 051; NULL-provenance rows are evicted conservatively).
+        //! Returns entries evicted. t2w is left intact.
+        int EvictRemovedQueryEntries(int envelopeId,
+                                     const AZStd::unordered_set<int>& removedQueryIds);
+
         //! Record loaded sub-dbs in _manifest for clean eviction.
         void RecordManifest(const AZStd::string& envelopeName,
                             const AZStd::string& subdb,
                             int entryCount);
 
+        //! FNV-1a over the resolved query plan (id, priority, shard, SQL text,
+        //! target sub-db of every stored query). Two activations with the same
+        //! hash would assemble identical working sets.
+        AZ::u64 ComputePlanHash(int envelopeId) const;
+
+        //! Activation snapshot: _manifest key "snap:<name>" holds the envelope id
+        //! and plan hash recorded after a successful activation. LMDB already
+        //! persists on disk, so if the record still matches on (re)activation the
+        //! populated hot cache is ATTACHED as-is instead of dropped and re-fed —
+        //! daemon restart becomes a hash check, not minutes of cold re-queries.
+        bool ValidateActivationSnapshot(const AZStd::string& envelopeName,
+                                        int envelopeId, AZ::u64 planHash);
+        void RecordActivationSnapshot(const AZStd::string& envelopeName,
+                                      int envelopeId, AZ::u64 planHash);
+        void ClearActivationSnapshot(const AZStd::string& envelopeName);
+
         //! Log activation to Postgres audit table.
         void LogActivation(const EnvelopeActivation& activation,
                            const AZStd::string& envelopeName);
@@ -203,9 +315,76 @@ namespace HCPEngine
         //! Get (or lazily open) a Postgres connection for a named DB.
         PGconn* GetShardConnection(const AZStd::string& dbName);
 
+        // ---- Prefetch lane internals ----
+
+        //! One queued speculative query. Slice requests carry wordLength = 0;
+        //! Advance requests additionally carry the offset of the slot to evict.
+        struct PrefetchRequest
+        {
+            enum class Kind { WarmBatch, Slice, Advance, Envelope };
+            Kind kind = Kind::WarmBatch;
+            int envelopeId = 0;
+            int wordLength = 0;
+            int offset = 0;
+            int count = 0;
+            int evictOffset = 0;          // Kind::Advance only
+            AZStd::string envelopeName;   // Kind::Envelope only
+        };
+
+        //! Staged FeedSlice row — mirrors the FeedSlice SELECT columns.
+        struct FeedRow
+        {
+            AZStd::string word;
+            AZStd::string tokenId;
+            AZStd::string subdb;
+            AZStd::string morpheme;
+        };
+
+        //! Staged EvictSlice row — mirrors the EvictSlice SELECT columns.
+        struct EvictRow
+        {
+            AZStd::string word;
+            AZStd::string subdb;
+        };
+
+        //! Staging key for warm batches and slices (slices use wordLength = 0).
+        static AZ::u64 StageKey(int envelopeId, int wordLength, int offset)
+        {
+            return (static_cast<AZ::u64>(static_cast<AZ::u32>(envelopeId)) << 40)
+                 | (static_cast<AZ::u64>(static_cast<AZ::u32>(wordLength) & 0xFF) << 32)
+                 |  static_cast<AZ::u64>(static_cast<AZ::u32>(offset));
+        }
+
+        //! Staging key for whole-transition requests — the 0xFF wordLength
+        //! sentinel keeps them clear of plain slice fetches at the same offset.
+        static AZ::u64 AdvanceKey(int envelopeId, int offset)
+        {
+            return StageKey(envelopeId, 0xFF, offset);
+        }
+
+        //! LMDB write halves of EvictSlice / FeedSlice, callable from the lane
+        //! thread as well as the foreground: LMDB serializes write transactions
+        //! internally, so the two sides queue rather than interleave.
+        int DeleteEvictRows(const AZStd::vector<EvictRow>& rows);
+        int WriteFeedRows(const AZStd::vector<FeedRow>& rows);
+
+        //! Push a request onto the lane, starting the thread on first use.
+        //! Duplicate keys already staged or in flight are dropped.
+        void EnqueuePrefetch(PrefetchRequest&& req);
+
+        //! Stop and join the prefetch thread; drops any unconsumed staging.
+        void StopPrefetchThread();
+
+        //! Lane body: pops requests, runs them on lane-owned connections, stages results.
+        void PrefetchThreadMain();
+
+        //! Drop all staged results and pending requests (warm set changed under them).
+        void InvalidateStaging();
+
         MDB_env*      m_lmdbEnv     = nullptr;
         AZStd::string m_coreConnStr;
         PGconn*       m_coreConn    = nullptr;
+        HCPVocabulary* m_vocabulary = nullptr;   // For w2t index rebuild on activation
 
         // Per-DB Postgres connections (lazy-opened) — includes shards and hcp_var
         AZStd::unordered_map<AZStd::string, PGconn*> m_shardConns;
@@ -213,6 +392,10 @@ namespace HCPEngine
         // LMDB _manifest sub-db handle
         unsigned int m_manifestDbi  = 0;
         bool         m_manifestOpen = false;
+        // Environment opened MDB_RDONLY (multi-process reader daemon). The
+        // writer process owns activation, feeding and eviction — every LMDB
+        // write path below no-ops so readers attach to the shared store.
+        bool         m_lmdbReadOnly = false;
 
         AZStd::string m_activeEnvelope;
         int           m_activeEnvelopeId = 0;
@@ -225,6 +408,10 @@ namespace HCPEngine
         // Avoids redundant DB checks once a length is confirmed present.
         AZStd::unordered_map<int, bool> m_assembledLengths;
 
+        // Morpheme-column probe results by stored query id (see QueryHasMorpheme).
+        // Cleared on activation — query text can change between plans.
+        AZStd::unordered_map<int, bool> m_morphemeProbe;
+
         // Incremental child-envelope assembly state.
         // Each AdvancePhase assembles the next child's queries into the warm set.
         // m_childQueryRanges[i] = {startIdx, count} into m_activeQueries for child i.
@@ -232,6 +419,25 @@ namespace HCPEngine
         AZStd::vector<ChildQueryRange> m_childQueryRanges;
         int m_nextChildToAssemble = 0;   // Next child index to assemble on demand
         int m_totalAssembled = 0;        // Total rows assembled so far (drives base_priority)
+
+        // Prefetch lane state. m_prefetchMutex guards the queue, the staging maps
+        // and the in-flight sets; m_prefetchWork wakes the lane, m_prefetchDone
+        // wakes foreground waiters blocked on an in-flight key. The lane's libpq
+        // connections are locals of PrefetchThreadMain — never shared.
+        std::thread             m_prefetchThread;
+        std::mutex              m_prefetchMutex;
+        std::condition_variable m_prefetchWork;
+        std::condition_variable m_prefetchDone;
+        std::deque<PrefetchRequest> m_prefetchQueue;
+        bool m_prefetchRunning = false;
+        bool m_prefetchStop    = false;
+
+        AZStd::unordered_map<AZ::u64, AZStd::vector<VocabEntry>> m_stagedBatches;
+        AZStd::unordered_map<AZ::u64, AZStd::vector<FeedRow>>    m_stagedSlices;
+        AZStd::unordered_map<AZ::u64, SliceAdvance>              m_stagedAdvances;
+        AZStd::unordered_map<AZStd::string, AZStd::vector<VocabEntry>> m_stagedEnvelopes;
+        AZStd::unordered_set<AZ::u64>       m_inFlight;
+        AZStd::unordered_set<AZStd::string> m_envelopeInFlight;
     };
 
 } // namespace HCPEngine
@@ -0,0 +1,330 @@
+#include "HCPEulerReassembly.h"
+
+#include <AzCore/std/containers/unordered_set.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace HCPEngine
+{
+namespace
+{
+    // Chain-compaction worker count: HCP_EULER_WORKERS=N (default: core
+    // count; 1 forces the serial path). Read once — same caching idiom as
+    // the other tuning env vars.
+    AZ::u32 EulerWorkerCount()
+    {
+        static AZ::u32 count = [] {
+            AZ::u32 hw = std::thread::hardware_concurrency();
+            if (hw == 0) hw = 1;
+            AZ::u32 c = hw;
+            if (const char* env = std::getenv("HCP_EULER_WORKERS"))
+            {
+                int requested = atoi(env);
+                if (requested >= 1)
+                    c = AZStd::min(static_cast<AZ::u32>(requested), hw);
+            }
+            return c;
+        }();
+        return count;
+    }
+
+    constexpr AZ::u32 NO_SEG = 0xFFFFFFFFu;
+
+    struct OutEdge
+    {
+        AZ::u32 target = 0;
+        int count = 0;
+    };
+
+    //! One compacted non-branching chain: `remaining` parallel edge instances
+    //! from anchor `from` to anchor `to` through `interior`. interior is empty
+    //! for a direct anchor-to-anchor bond; remaining > 1 implies no interior —
+    //! a repeated bond's B-side has in-degree > 1 and is an anchor by
+    //! definition.
+    struct Segment
+    {
+        AZ::u32 from = 0;
+        AZ::u32 to = 0;
+        AZStd::vector<AZ::u32> interior;
+        int remaining = 0;
+        AZ::u32 sortKey = 0xFFFFFFFFu;
+    };
+}
+
+    // Euler path diagnostic, carried over from the original bond-walk sketch:
+    // verifies the graph has valid degree conditions before a walk is
+    // attempted. (Verified historically: 10481/10481 edges on Yellow
+    // Wallpaper, 0 imbalanced nodes.)
+    bool DiagnoseEulerConditions(const PBMData& pbmData)
+    {
+        AZStd::unordered_map<AZStd::string, int> inDeg, outDeg;
+        for (const auto& bond : pbmData.bonds)
+        {
+            outDeg[bond.tokenA] += bond.count;
+            inDeg[bond.tokenB] += bond.count;
+        }
+
+        AZStd::unordered_map<AZStd::string, bool> allTokens;
+        for (const auto& [t, _] : inDeg) { allTokens[t] = true; }
+        for (const auto& [t, _] : outDeg) { allTokens[t] = true; }
+
+        int startNodes = 0, endNodes = 0, imbalanced = 0;
+        for (const auto& [token, _] : allTokens)
+        {
+            int out = outDeg.count(token) ? outDeg[token] : 0;
+            int in = inDeg.count(token) ? inDeg[token] : 0;
+            if (out == in + 1)
+            {
+                startNodes++;
+                fprintf(stderr, "[Euler] START node: %s (out=%d, in=%d)\n",
+                    token.c_str(), out, in);
+            }
+            else if (in == out + 1)
+            {
+                endNodes++;
+                fprintf(stderr, "[Euler] END node: %s (out=%d, in=%d)\n",
+                    token.c_str(), out, in);
+            }
+            else if (out != in)
+            {
+                imbalanced++;
+                fprintf(stderr, "[Euler] IMBALANCED: %s (out=%d, in=%d, diff=%d)\n",
+                    token.c_str(), out, in, out - in);
+            }
+        }
+        fprintf(stderr, "[Euler] Summary: %d start, %d end, %d imbalanced, %zu total nodes\n",
+            startNodes, endNodes, imbalanced, allTokens.size());
+        fflush(stderr);
+
+        return (startNodes == 1 && endNodes == 1 && imbalanced == 0);
+    }
+
+    EulerReassemblyResult ReassembleViaBondWalk(
+        const PBMData& pbmData,
+        const AZStd::unordered_map<AZStd::string, AZ::u32>* firstPositions,
+        int workers)
+    {
+        EulerReassemblyResult result;
+        if (pbmData.bonds.empty() || pbmData.firstFpbA.empty())
+            return result;
+
+        auto tCompact = std::chrono::high_resolution_clock::now();
+
+        // Intern tokens — the walk works on dense u32 ids; strings only
+        // reappear at expansion.
+        AZStd::unordered_map<AZStd::string, AZ::u32> ids;
+        AZStd::vector<const AZStd::string*> names;
+        auto intern = [&](const AZStd::string& token) -> AZ::u32
+        {
+            auto [it, inserted] = ids.emplace(token, static_cast<AZ::u32>(names.size()));
+            if (inserted)
+                names.push_back(&it->first);
+            return it->second;
+        };
+
+        AZStd::vector<AZStd::vector<OutEdge>> outgoing;
+        AZStd::vector<int> inMult, outMult;
+        auto grow = [&](AZ::u32 id)
+        {
+            if (id >= outgoing.size())
+            {
+                outgoing.resize(id + 1);
+                inMult.resize(id + 1, 0);
+                outMult.resize(id + 1, 0);
+            }
+        };
+
+        for (const auto& bond : pbmData.bonds)
+        {
+            const AZ::u32 a = intern(bond.tokenA);
+            const AZ::u32 b = intern(bond.tokenB);
+            grow(a); grow(b);
+            outgoing[a].push_back({b, bond.count});
+            outMult[a] += bond.count;
+            inMult[b] += bond.count;
+            result.totalEdges += static_cast<size_t>(bond.count);
+        }
+
+        const AZ::u32 start = intern(pbmData.firstFpbA);
+        grow(start);
+        const AZ::u32 nodeCount = static_cast<AZ::u32>(names.size());
+
+        // Anchors: any node the walk must make a decision at (or can't pass
+        // through blindly) — branch points, imbalanced nodes, the head.
+        // Everything else has exactly one bond in and one out, so the path
+        // through it is forced and compactable.
+        AZStd::vector<AZ::u8> isAnchor(nodeCount, 0);
+        for (AZ::u32 i = 0; i < nodeCount; ++i)
+            if (inMult[i] != 1 || outMult[i] != 1 || i == start)
+            {
+                isAnchor[i] = 1;
+                result.anchors++;
+            }
+
+        // Every outgoing edge of an anchor heads one chain; chains are
+        // edge-disjoint (an interior node has exactly one in-edge, so exactly
+        // one chain passes through it), which is what lets the compaction
+        // walks run with no shared mutable state — each head owns its slot.
+        struct Head { AZ::u32 from; AZ::u32 edge; };
+        AZStd::vector<Head> heads;
+        for (AZ::u32 i = 0; i < nodeCount; ++i)
+            if (isAnchor[i])
+                for (AZ::u32 e = 0; e < outgoing[i].size(); ++e)
+                    heads.push_back({i, e});
+
+        AZStd::vector<Segment> segments(heads.size());
+
+        AZ::u32 workerCount = workers >= 1
+            ? AZStd::min(static_cast<AZ::u32>(workers), EulerWorkerCount())
+            : EulerWorkerCount();
+        if (heads.size() < 64)
+            workerCount = 1;   // not worth spinning threads up for
+        result.workers = workerCount;
+
+        const size_t totalEdges = result.totalEdges;
+        auto compactRange = [&](size_t lo, size_t hi)
+        {
+            for (size_t h = lo; h < hi; ++h)
+            {
+                const OutEdge& e = outgoing[heads[h].from][heads[h].edge];
+                Segment& seg = segments[h];
+                seg.from = heads[h].from;
+                seg.remaining = e.count;
+
+                AZ::u32 cur = e.target;
+                size_t steps = 0;
+                while (!isAnchor[cur])
+                {
+                    seg.interior.push_back(cur);
+                    cur = outgoing[cur][0].target;
+                    if (++steps > totalEdges)
+                    {
+                        // Only reachable on corrupt data (an interior cycle
+                        // implies a double in-edge, i.e. an anchor). Truncate;
+                        // the walk dead-ends here and reports incomplete.
+                        fprintf(stderr, "[EulerReassembly] chain from %s never "
+                            "reached an anchor — truncating (corrupt graph?)\n",
+                            names[seg.from]->c_str());
+                        fflush(stderr);
+                        break;
+                    }
+                }
+                seg.to = cur;
+
+                // Selection key at the owning anchor: earliest known document
+                // position of the chain's head token when positions survive,
+                // else edge rarity (the sketch's rare-first order).
+                const AZ::u32 headTok = seg.interior.empty() ? seg.to : seg.interior[0];
+                if (firstPositions)
+                {
+                    auto pit = firstPositions->find(*names[headTok]);
+                    if (pit != firstPositions->end())
+                        seg.sortKey = pit->second;
+                }
+                else
+                {
+                    seg.sortKey = static_cast<AZ::u32>(seg.remaining);
+                }
+            }
+        };
+
+        if (workerCount <= 1)
+        {
+            compactRange(0, heads.size());
+        }
+        else
+        {
+            std::vector<std::thread> pool;
+            const size_t stripe = (heads.size() + workerCount - 1) / workerCount;
+            for (AZ::u32 w = 0; w < workerCount; ++w)
+            {
+                const size_t lo = w * stripe;
+                const size_t hi = AZStd::min(lo + stripe, heads.size());
+                if (lo >= hi) break;
+                pool.emplace_back([&compactRange, lo, hi] { compactRange(lo, hi); });
+            }
+            for (auto& t : pool) t.join();
+        }
+        result.segments = segments.size();
+
+        auto tWalk = std::chrono::high_resolution_clock::now();
+        result.compactMs = std::chrono::duration<double, std::milli>(tWalk - tCompact).count();
+
+        // Condensed adjacency, each anchor's exits ordered by sortKey once up
+        // front (ties broken rare-first).
+        AZStd::vector<AZStd::vector<AZ::u32>> segsFrom(nodeCount);
+        for (AZ::u32 i = 0; i < segments.size(); ++i)
+            segsFrom[segments[i].from].push_back(i);
+        for (auto& list : segsFrom)
+            std::sort(list.begin(), list.end(), [&](AZ::u32 a, AZ::u32 b)
+            {
+                if (segments[a].sortKey != segments[b].sortKey)
+                    return segments[a].sortKey < segments[b].sortKey;
+                return segments[a].remaining < segments[b].remaining;
+            });
+
+        // Hierholzer's over the condensed graph. Each frame remembers the
+        // segment that reached it; pops emit in reverse path order.
+        struct Frame { AZ::u32 node; AZ::u32 via; };
+        AZStd::vector<Frame> stack;
+        AZStd::vector<AZ::u32> pathSegs;
+        stack.push_back({start, NO_SEG});
+
+        while (!stack.empty())
+        {
+            const Frame f = stack.back();
+            AZ::u32 chosen = NO_SEG;
+            for (AZ::u32 idx : segsFrom[f.node])
+                if (segments[idx].remaining > 0) { chosen = idx; break; }
+
+            if (chosen != NO_SEG)
+            {
+                segments[chosen].remaining--;
+                stack.push_back({segments[chosen].to, chosen});
+            }
+            else
+            {
+                if (f.via != NO_SEG)
+                    pathSegs.push_back(f.via);
+                stack.pop_back();
+            }
+        }
+        std::reverse(pathSegs.begin(), pathSegs.end());
+
+        // Expand segments back to tokens.
+        size_t pathTokens = 1;
+        for (AZ::u32 idx : pathSegs)
+            pathTokens += segments[idx].interior.size() + 1;
+        result.sequence.reserve(pathTokens);
+
+        result.sequence.push_back(*names[start]);
+        for (AZ::u32 idx : pathSegs)
+        {
+            const Segment& seg = segments[idx];
+            for (AZ::u32 tok : seg.interior)
+                result.sequence.push_back(*names[tok]);
+            result.sequence.push_back(*names[seg.to]);
+            result.edgesConsumed += seg.interior.size() + 1;
+        }
+        result.complete = (result.edgesConsumed == result.totalEdges);
+
+        result.walkMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - tWalk).count();
+
+        fprintf(stderr, "[EulerReassembly] %zu bonds → %zu anchors, %zu segments "
+            "(%u workers, %.1f ms); walk %zu/%zu edges, %zu tokens in %.1f ms%s\n",
+            result.totalEdges, result.anchors, result.segments,
+            result.workers, result.compactMs,
+            result.edgesConsumed, result.totalEdges, result.sequence.size(),
+            result.walkMs, result.complete ? "" : " (INCOMPLETE)");
+        fflush(stderr);
+
+        return result;
+    }
+
+} // namespace HCPEngine
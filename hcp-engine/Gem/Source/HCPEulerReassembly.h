@@ -0,0 +1,64 @@
+#pragma once
+
+#include "HCPParticlePipeline.h"
+#include <AzCore/base.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+// Bond-walk reassembly — reconstruction from the PBM bond graph alone, for
+// documents whose positional store is damaged or missing. The positional path
+// (HCPPbmReader::LoadPositionsWithModifiers) remains the production
+// reconstruction; this engine is the fallback when only bonds survive.
+//
+// The walk is Hierholzer's Eulerian-path construction, run over a condensed
+// graph: maximal non-branching chains (interior tokens with exactly one bond
+// in and one bond out) are compacted into walk segments in parallel — every
+// chain is edge-disjoint from every other, so the workers share nothing — and
+// the serial Euler walk then only touches anchor nodes (branch points,
+// imbalanced nodes, the document head). On prose graphs most tokens are
+// interior, so the serial portion shrinks accordingly.
+//
+// Hub ambiguity (the blocker that parked the original sketch — "the" has many
+// valid exits) is tempered, not solved: when per-starter first positions are
+// supplied, edge selection at hubs prefers the segment whose head token
+// appears earliest in the document; without them selection falls back to the
+// sketch's rare-first order. Output is a valid bond traversal, byte-exact
+// only where the graph leaves no choice.
+
+namespace HCPEngine
+{
+    //! Outcome of one bond walk. `sequence` holds token ids (starter forms,
+    //! including var tokens) in traversal order; resolve them to surfaces with
+    //! HCPVocabulary::TokenToWord before display.
+    struct EulerReassemblyResult
+    {
+        AZStd::vector<AZStd::string> sequence;
+        size_t totalEdges    = 0;    //!< bond instances in the graph
+        size_t edgesConsumed = 0;    //!< bond instances on the emitted path
+        size_t segments      = 0;    //!< condensed walk segments built
+        size_t anchors       = 0;    //!< branch/imbalance nodes + document head
+        AZ::u32 workers      = 0;    //!< threads used for chain compaction
+        double compactMs     = 0.0;  //!< parallel compaction time
+        double walkMs        = 0.0;  //!< serial Euler walk + expansion time
+        bool complete = false;       //!< every edge consumed in a single path
+    };
+
+    //! Degree diagnostic: true when the bond graph admits a single Eulerian
+    //! path (exactly one start node with out=in+1, one end node with in=out+1,
+    //! everything else balanced). Logs every offender — useful for validating
+    //! bond-graph integrity after partial recovery.
+    bool DiagnoseEulerConditions(const PBMData& pbmData);
+
+    //! Reassemble a token sequence from bonds alone, starting at firstFpbA.
+    //! firstPositions (token id → earliest document position, from whatever
+    //! starter rows survive — see HCPPbmReader::LoadFirstPositions) is
+    //! optional and only steers edge choice at hubs; pass nullptr for a purely
+    //! structural walk. workers <= 0 sizes the compaction pool from
+    //! HCP_EULER_WORKERS / core count.
+    EulerReassemblyResult ReassembleViaBondWalk(
+        const PBMData& pbmData,
+        const AZStd::unordered_map<AZStd::string, AZ::u32>* firstPositions = nullptr,
+        int workers = 0);
+
+} // namespace HCPEngine
@@ -1,13 +1,24 @@
 #include "HCPGutenbergRunner.h"
 #include "HCPEngineSystemComponent.h"
 #include "HCPPhysIngest.h"
+#include "HCPByteIngest.h"
+#include "HCPVocabBed.h"
+#include "HCPDbConnection.h"
+#include "HCPPbmWriter.h"
+#include "HCPDocumentQuery.h"
 
 #include <rapidjson/document.h>
 
 #include <dirent.h>
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
 
 namespace HCPEngine
 {
@@ -32,6 +43,132 @@ namespace HCPEngine
         return found;
     }
 
+    //! Three-stage pipeline internals: N readers (file I/O + byte-floor segmentation)
+    //! → one resolver lane (the BedManager is the serializing resource) → M writers
+    //! (Postgres storage on their own connections). Corpus runs used to idle every
+    //! core but one; now only the resolve stage is serial.
+    namespace GutenbergRunner_Detail
+    {
+        struct TextJob
+        {
+            int catalogId = 0;
+            AZStd::string catalogIdStr;
+            AZStd::string docName;
+            AZStd::string filePath;
+        };
+
+        //! Reader output: runs segmented ahead of the resolver.
+        struct RunsJob
+        {
+            TextJob job;
+            AZStd::vector<CharRun> runs;
+            size_t sourceBytes = 0;
+        };
+
+        //! Resolver output: scan results ready for storage.
+        struct StoreJob
+        {
+            TextJob job;
+            ManifestScanResult scan;
+        };
+
+        //! Bounded hand-off queue between stages. The bound caps how many documents'
+        //! worth of runs/bonds sit in memory when one stage outpaces the next.
+        template<typename T>
+        class BoundedQueue
+        {
+        public:
+            explicit BoundedQueue(size_t cap) : m_cap(cap) {}
+
+            void Push(T&& item)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_space.wait(lock, [this] { return m_items.size() < m_cap || m_closed; });
+                if (m_closed) return;
+                m_items.push_back(AZStd::move(item));
+                m_avail.notify_one();
+            }
+
+            //! False once the queue is closed and drained.
+            bool Pop(T& out)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_avail.wait(lock, [this] { return !m_items.empty() || m_closed; });
+                if (m_items.empty()) return false;
+                out = AZStd::move(m_items.front());
+                m_items.pop_front();
+                m_space.notify_one();
+                return true;
+            }
+
+            void Close()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_closed = true;
+                m_avail.notify_all();
+                m_space.notify_all();
+            }
+
+        private:
+            size_t m_cap;
+            std::deque<T> m_items;
+            std::mutex m_mutex;
+            std::condition_variable m_avail;
+            std::condition_variable m_space;
+            bool m_closed = false;
+        };
+
+        int EnvCount(const char* var, int def, int maxVal)
+        {
+            if (const char* s = std::getenv(var))
+            {
+                int v = atoi(s);
+                if (v >= 1 && v <= maxVal) return v;
+            }
+            return def;
+        }
+
+        bool PipelineEnabled()
+        {
+            const char* s = std::getenv("HCP_GUTENBERG_PIPELINE");
+            return !(s && strcmp(s, "0") == 0);
+        }
+
+        //! Writer-stage storage: the PBM branch of PhysIngestRuns, on the writer's own
+        //! connection. Returns the doc_id, or empty with errorOut set.
+        AZStd::string StoreScan(
+            StoreJob& sj,
+            const AZStd::string& centuryCode,
+            HCPPbmWriter& pbmWriter,
+            HCPDocumentQuery& docQuery,
+            AZStd::string& errorOut)
+        {
+            PBMData pbmData;
+            pbmData.bonds        = AZStd::move(sj.scan.bonds);
+            pbmData.firstFpbA    = sj.scan.firstFpbA;
+            pbmData.firstFpbB    = sj.scan.firstFpbB;
+            pbmData.totalPairs   = sj.scan.totalPairs;
+            pbmData.uniqueTokens = sj.scan.uniqueTokens;
+
+            AZStd::string docId;
+            int stubPk = docQuery.GetDocPkByCatalogId("gutenberg", sj.job.catalogIdStr);
+            if (stubPk != 0)
+                docId = pbmWriter.FillPBMData(stubPk, pbmData);
+            if (docId.empty())
+                docId = pbmWriter.StorePBM(sj.job.docName, centuryCode, pbmData);
+            if (docId.empty())
+            {
+                errorOut = "StorePBM/FillPBMData failed";
+                return docId;
+            }
+
+            pbmWriter.StorePositions(
+                pbmWriter.LastDocPk(), sj.scan.tokenIds, sj.scan.positions,
+                sj.scan.totalSlots, sj.scan.modifiers);
+            return docId;
+        }
+    } // namespace GutenbergRunner_Detail
+
     GutenbergRunResult RunGutenbergTexts(
         int workingDocId,
         const AZStd::string& textsDir,
@@ -40,6 +177,8 @@ namespace HCPEngine
         HCPEngineSystemComponent* engine,
         PGconn* varConn)
     {
+        using namespace GutenbergRunner_Detail;
+
         GutenbergRunResult result;
 
         if (!varConn || PQstatus(varConn) != CONNECTION_OK)
@@ -74,6 +213,8 @@ namespace HCPEngine
             return result;
         }
 
+        // Resolve the job list up front (cheap directory scans); skips counted here.
+        AZStd::vector<TextJob> jobs;
         for (const auto& entry : jdoc.GetArray())
         {
             if (!entry.IsObject()) continue;
@@ -95,56 +236,227 @@ namespace HCPEngine
                 continue;
             }
 
-            // Read text file
-            std::ifstream ifs(filePath.c_str());
-            if (!ifs.is_open())
-            {
-                ++result.failed;
-                result.errors.push_back(AZStd::string("Cannot open: ") + filePath);
-                continue;
-            }
-            std::string stdText((std::istreambuf_iterator<char>(ifs)),
-                                 std::istreambuf_iterator<char>());
-            ifs.close();
-            AZStd::string text(stdText.c_str(), stdText.size());
-
             // Doc name = filename stem (no extension)
             size_t lastSlash = filePath.rfind('/');
             size_t lastDot   = filePath.rfind('.');
             if (lastSlash == AZStd::string::npos) lastSlash = 0; else ++lastSlash;
             if (lastDot == AZStd::string::npos || lastDot <= lastSlash) lastDot = filePath.size();
-            AZStd::string docName = filePath.substr(lastSlash, lastDot - lastSlash);
 
-            AZStd::string catalogIdStr = AZStd::to_string(catalogId);
+            TextJob job;
+            job.catalogId    = catalogId;
+            job.catalogIdStr = AZStd::to_string(catalogId);
+            job.docName      = filePath.substr(lastSlash, lastDot - lastSlash);
+            job.filePath     = AZStd::move(filePath);
+            jobs.push_back(AZStd::move(job));
+        }
+
+        const int totalJobs = static_cast<int>(jobs.size());
 
-            ++result.processed;
-            fprintf(stderr, "[GutenbergRunner] [%d/%u] catalog_id=%d: %s (%zu bytes)\n",
-                result.processed, jdoc.GetArray().Size(),
-                catalogId, docName.c_str(), text.size());
+        // ---- Serial fallback (HCP_GUTENBERG_PIPELINE=0, or nothing to overlap) ----
+        if (!PipelineEnabled() || totalJobs <= 1)
+        {
+            for (auto& job : jobs)
+            {
+                std::ifstream ifs(job.filePath.c_str());
+                if (!ifs.is_open())
+                {
+                    ++result.failed;
+                    result.errors.push_back(AZStd::string("Cannot open: ") + job.filePath);
+                    continue;
+                }
+                std::string stdText((std::istreambuf_iterator<char>(ifs)),
+                                     std::istreambuf_iterator<char>());
+                ifs.close();
+                AZStd::string text(stdText.c_str(), stdText.size());
+
+                ++result.processed;
+                fprintf(stderr, "[GutenbergRunner] [%d/%d] catalog_id=%d: %s (%zu bytes)\n",
+                    result.processed, totalJobs, job.catalogId, job.docName.c_str(), text.size());
+                fflush(stderr);
+
+                PhysIngestResult pir = PhysIngestText(
+                    text, job.docName, centuryCode,
+                    "gutenberg", job.catalogIdStr,
+                    fictionFirst, false, engine);
+
+                if (pir.ok)
+                {
+                    ++result.succeeded;
+                    fprintf(stderr, "[GutenbergRunner]   → %s (%llu bonds, %llu pairs)\n",
+                        pir.docId.c_str(), (unsigned long long)pir.bondTypes,
+                        (unsigned long long)pir.totalPairs);
+                }
+                else
+                {
+                    ++result.failed;
+                    AZStd::string errMsg =
+                        AZStd::string("catalog_id=") + job.catalogIdStr + ": " + pir.errorMessage;
+                    result.errors.push_back(errMsg);
+                    fprintf(stderr, "[GutenbergRunner]   FAILED: %s\n", pir.errorMessage.c_str());
+                }
+                fflush(stderr);
+            }
+
+            fprintf(stderr, "[GutenbergRunner] Done: %d processed, %d succeeded, %d failed, %d skipped\n",
+                result.processed, result.succeeded, result.failed, result.skipped);
             fflush(stderr);
+            return result;
+        }
+
+        // ---- Pipelined run: readers → resolver lane → writers ----
+        BedManager& bedManager = engine->GetBedManager();
+        if (!bedManager.IsInitialized())
+        {
+            result.errors.push_back("BedManager not initialized");
+            return result;
+        }
+
+        const int readerCount = EnvCount("HCP_GUTENBERG_READERS", 4, 16);
+        const int writerCount = EnvCount("HCP_GUTENBERG_WRITERS", 2, 8);
+
+        fprintf(stderr, "[GutenbergRunner] Pipelined: %d docs, %d readers, 1 resolver, %d writers\n",
+            totalJobs, readerCount, writerCount);
+        fflush(stderr);
+
+        // Bounds keep at most a few documents of runs/bonds in flight per stage.
+        BoundedQueue<RunsJob>  runsQueue(static_cast<size_t>(readerCount) + 2);
+        BoundedQueue<StoreJob> storeQueue(static_cast<size_t>(writerCount) + 2);
+
+        std::mutex resultMutex;
+        std::atomic<int> nextJob{0};
+        std::atomic<int> readersLive{readerCount};
+
+        // Stage 1: readers — file I/O + CRLF normalize + byte-floor segmentation.
+        std::vector<std::thread> readers;
+        for (int t = 0; t < readerCount; ++t)
+        {
+            readers.emplace_back([&]
+            {
+                for (;;)
+                {
+                    const int ji = nextJob.fetch_add(1);
+                    if (ji >= totalJobs) break;
+                    TextJob& job = jobs[ji];
+
+                    std::ifstream ifs(job.filePath.c_str());
+                    if (!ifs.is_open())
+                    {
+                        std::lock_guard<std::mutex> lock(resultMutex);
+                        ++result.failed;
+                        result.errors.push_back(AZStd::string("Cannot open: ") + job.filePath);
+                        continue;
+                    }
+                    std::string stdText((std::istreambuf_iterator<char>(ifs)),
+                                         std::istreambuf_iterator<char>());
+                    ifs.close();
 
-            PhysIngestResult pir = PhysIngestText(
-                text, docName, centuryCode,
-                "gutenberg", catalogIdStr,
-                fictionFirst, false, engine);
+                    // Normalize CRLF → LF (Gutenberg hard wraps), as PhysIngestText does.
+                    AZStd::string text;
+                    text.reserve(stdText.size());
+                    for (char c : stdText)
+                        if (c != '\r') text.push_back(c);
 
-            if (pir.ok)
+                    RunsJob rj;
+                    rj.job         = job;
+                    rj.sourceBytes = text.size();
+                    rj.runs        = IngestBytes(
+                        reinterpret_cast<const uint8_t*>(text.data()), text.size());
+                    runsQueue.Push(AZStd::move(rj));
+                }
+                if (readersLive.fetch_sub(1) == 1)
+                    runsQueue.Close();   // last reader out
+            });
+        }
+
+        // Stage 3: writers — PBM storage on per-writer connections.
+        std::vector<std::thread> writers;
+        for (int t = 0; t < writerCount; ++t)
+        {
+            writers.emplace_back([&]
             {
-                ++result.succeeded;
-                fprintf(stderr, "[GutenbergRunner]   → %s (%llu bonds, %llu pairs)\n",
-                    pir.docId.c_str(), (unsigned long long)pir.bondTypes,
-                    (unsigned long long)pir.totalPairs);
+                HCPDbConnection db;
+                HCPPbmWriter pbmWriter(db);
+                HCPDocumentQuery docQuery(db);
+
+                StoreJob sj;
+                while (storeQueue.Pop(sj))
+                {
+                    if (!db.IsConnected()) db.Connect();
+                    if (!db.IsConnected())
+                    {
+                        std::lock_guard<std::mutex> lock(resultMutex);
+                        ++result.failed;
+                        result.errors.push_back(
+                            AZStd::string("catalog_id=") + sj.job.catalogIdStr + ": no database connection");
+                        continue;
+                    }
+
+                    AZStd::string error;
+                    AZStd::string docId = StoreScan(sj, centuryCode, pbmWriter, docQuery, error);
+
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    if (!docId.empty())
+                    {
+                        ++result.succeeded;
+                        fprintf(stderr, "[GutenbergRunner]   → %s (catalog_id=%d)\n",
+                            docId.c_str(), sj.job.catalogId);
+                    }
+                    else
+                    {
+                        ++result.failed;
+                        result.errors.push_back(
+                            AZStd::string("catalog_id=") + sj.job.catalogIdStr + ": " + error);
+                        fprintf(stderr, "[GutenbergRunner]   FAILED: catalog_id=%d: %s\n",
+                            sj.job.catalogId, error.c_str());
+                    }
+                    fflush(stderr);
+                }
+            });
+        }
+
+        // Stage 2: resolver lane — this thread. The bed/envelope state is shared,
+        // so exactly one document resolves at a time; everything else overlaps.
+        auto& entityAnnotator = engine->GetEntityAnnotator();
+        RunsJob rj;
+        while (runsQueue.Pop(rj))
+        {
+            int processedNow;
+            {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                processedNow = ++result.processed;
             }
-            else
+            fprintf(stderr, "[GutenbergRunner] [%d/%d] catalog_id=%d: %s (%zu bytes, %zu runs)\n",
+                processedNow, totalJobs, rj.job.catalogId, rj.job.docName.c_str(),
+                rj.sourceBytes, rj.runs.size());
+            fflush(stderr);
+
+            if (rj.runs.empty())
             {
+                std::lock_guard<std::mutex> lock(resultMutex);
                 ++result.failed;
-                AZStd::string errMsg =
-                    AZStd::string("catalog_id=") + catalogIdStr + ": " + pir.errorMessage;
-                result.errors.push_back(errMsg);
-                fprintf(stderr, "[GutenbergRunner]   FAILED: %s\n", pir.errorMessage.c_str());
+                result.errors.push_back(
+                    AZStd::string("catalog_id=") + rj.job.catalogIdStr + ": no runs from byte-floor");
+                continue;
             }
-            fflush(stderr);
+
+            ResolutionManifest manifest = bedManager.Resolve(rj.runs);
+            if (entityAnnotator.IsInitialized())
+                entityAnnotator.AnnotateManifest(manifest, fictionFirst);
+
+            StoreJob sj;
+            sj.job  = AZStd::move(rj.job);
+            sj.scan = ScanManifestToPBM(manifest);
+            storeQueue.Push(AZStd::move(sj));
+
+            // Mint accumulated recommendations before the next document
+            // resolves — its passes then hit cache instead of re-recommending.
+            if (!manifest.mintRecommendations.empty())
+                engine->GetResolver().ExecuteMintBatch(manifest.mintRecommendations);
         }
+        storeQueue.Close();
+
+        for (auto& t : readers) t.join();
+        for (auto& t : writers) t.join();
 
         fprintf(stderr, "[GutenbergRunner] Done: %d processed, %d succeeded, %d failed, %d skipped\n",
             result.processed, result.succeeded, result.failed, result.skipped);
@@ -0,0 +1,200 @@
+#include "HCPIngestBench.h"
+#include "HCPEngineSystemComponent.h"
+#include "HCPPhysIngest.h"
+#include "HCPByteIngest.h"
+
+#include "../../../tools/byte-floor/bytefloor.h"
+
+#include <dirent.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace HCPEngine
+{
+    namespace
+    {
+        //! Pinned fixtures — catalog ids that ship in data/gutenberg/texts.
+        //! Pinning by id (not by size scan) keeps the benchmark comparable
+        //! across commits even when the corpus directory grows.
+        struct FixtureSpec
+        {
+            const char* name;
+            int catalogId;
+        };
+        constexpr FixtureSpec FIXTURES[] = {
+            { "small",  1952 },   // The Yellow Wallpaper (~52 KB)
+            { "medium", 11 },     // Alice's Adventures in Wonderland (~170 KB)
+            { "novel",  98 },     // A Tale of Two Cities (~800 KB)
+        };
+
+        //! Same prefix match as RunGutenbergTexts: catalog id zero-padded to
+        //! 5 digits plus underscore.
+        AZStd::string FindFixtureFile(const AZStd::string& fixturesDir, int catalogId)
+        {
+            char prefix[16];
+            snprintf(prefix, sizeof(prefix), "%05d_", catalogId);
+
+            DIR* dir = opendir(fixturesDir.c_str());
+            if (!dir) return "";
+
+            AZStd::string found;
+            struct dirent* entry;
+            while ((entry = readdir(dir)) != nullptr)
+            {
+                if (strncmp(entry->d_name, prefix, strlen(prefix)) == 0)
+                {
+                    found = fixturesDir + "/" + entry->d_name;
+                    break;
+                }
+            }
+            closedir(dir);
+            return found;
+        }
+
+        //! Read a fixture and normalize CRLF -> LF (Gutenberg hard wraps),
+        //! exactly as PhysIngestText does before the byte-floor.
+        bool ReadNormalized(const AZStd::string& path, AZStd::string& out)
+        {
+            FILE* f = fopen(path.c_str(), "rb");
+            if (!f) return false;
+            fseek(f, 0, SEEK_END);
+            long size = ftell(f);
+            fseek(f, 0, SEEK_SET);
+            if (size <= 0) { fclose(f); return false; }
+
+            AZStd::string raw;
+            raw.resize(static_cast<size_t>(size));
+            size_t got = fread(&raw[0], 1, static_cast<size_t>(size), f);
+            fclose(f);
+            if (got != static_cast<size_t>(size)) return false;
+
+            out.reserve(raw.size());
+            for (char c : raw)
+                if (c != '\r') out.push_back(c);
+            return true;
+        }
+
+        double MsSince(std::chrono::high_resolution_clock::time_point t0)
+        {
+            return std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - t0).count();
+        }
+    }
+
+    IngestBenchResult RunIngestBench(
+        const AZStd::string& fixturesDir,
+        int passes,
+        HCPEngineSystemComponent* engine)
+    {
+        IngestBenchResult result;
+        if (!engine)
+        {
+            result.error = "No engine";
+            return result;
+        }
+        if (passes < 1) passes = 1;
+
+        for (const FixtureSpec& spec : FIXTURES)
+        {
+            IngestBenchFixture fixture;
+            fixture.name = spec.name;
+            fixture.file = FindFixtureFile(fixturesDir, spec.catalogId);
+
+            if (fixture.file.empty())
+            {
+                IngestBenchPass missing;
+                missing.scenario = "cold";
+                missing.error = AZStd::string("fixture not found (catalog_id=")
+                    + AZStd::to_string(spec.catalogId) + ")";
+                fixture.passes.push_back(AZStd::move(missing));
+                result.fixtures.push_back(AZStd::move(fixture));
+                continue;
+            }
+
+            AZStd::string text;
+            if (!ReadNormalized(fixture.file, text))
+            {
+                IngestBenchPass unreadable;
+                unreadable.scenario = "cold";
+                unreadable.error = "fixture unreadable";
+                fixture.passes.push_back(AZStd::move(unreadable));
+                result.fixtures.push_back(AZStd::move(fixture));
+                continue;
+            }
+            fixture.bytes = text.size();
+
+            for (int p = 0; p < passes; ++p)
+            {
+                IngestBenchPass pass;
+                pass.scenario = (p == 0) ? "cold" : "warm";
+
+                auto passStart = std::chrono::high_resolution_clock::now();
+
+                // Stage 1a: byte-floor decode alone. IngestBytes runs decode +
+                // segmentation fused, so the decode is timed separately first —
+                // the extra decode costs the benchmark, not the measurement.
+                auto t0 = std::chrono::high_resolution_clock::now();
+                hcp::bytefloor::Result floor = hcp::bytefloor::resolve(
+                    reinterpret_cast<const uint8_t*>(text.data()), text.size());
+                pass.byteFloorMs = MsSince(t0);
+                const size_t elemCount = floor.elems.size();
+                floor = hcp::bytefloor::Result();   // release before the real run
+
+                // Stage 1b: the pipeline's fused decode + segmentation; the
+                // segmentation share is the fused time minus the decode.
+                t0 = std::chrono::high_resolution_clock::now();
+                AZStd::vector<CharRun> runs = IngestBytes(
+                    reinterpret_cast<const uint8_t*>(text.data()), text.size());
+                double ingestMs = MsSince(t0);
+                pass.segmentMs = ingestMs > pass.byteFloorMs
+                    ? ingestMs - pass.byteFloorMs : 0.0;
+
+                // Stages 2-4: resolve, scan, store — timed inside the pipeline.
+                AZStd::string docName = AZStd::string("bench_") + spec.name;
+                PhysIngestResult pir = PhysIngestRuns(
+                    runs, text.size(), AZStd::string(), docName,
+                    "AB", /*catalog=*/"", /*catalogId=*/"",
+                    /*fictionFirst=*/true, /*isWorkingDoc=*/false, engine);
+
+                pass.resolveMs  = pir.resolveTimeMs;
+                pass.scanMs     = pir.scanTimeMs;
+                pass.storeMs    = pir.storeTimeMs;
+                pass.totalMs    = MsSince(passStart);
+                pass.runs       = pir.totalRuns;
+                pass.resolved   = pir.resolved;
+                pass.unresolved = pir.unresolved;
+                pass.bondTypes  = pir.bondTypes;
+                pass.ok         = pir.ok;
+                if (!pir.ok)
+                    pass.error = pir.errorMessage;
+
+                fprintf(stderr, "[IngestBench] %s/%s: %zu elems, %u runs — "
+                    "floor %.1f + segment %.1f + resolve %.1f + scan %.1f + store %.1f "
+                    "= %.1f ms%s\n",
+                    spec.name, pass.scenario.c_str(), elemCount, pass.runs,
+                    pass.byteFloorMs, pass.segmentMs, pass.resolveMs,
+                    pass.scanMs, pass.storeMs, pass.totalMs,
+                    pass.ok ? "" : " (FAILED)");
+                fflush(stderr);
+
+                fixture.passes.push_back(AZStd::move(pass));
+            }
+
+            result.fixtures.push_back(AZStd::move(fixture));
+        }
+
+        // The run is ok when every executed pass stored its document; a
+        // missing fixture is reported per-fixture but fails the run too, so
+        // the acceptance pipeline can't silently bench a shrunken corpus.
+        result.ok = !result.fixtures.empty();
+        for (const auto& fixture : result.fixtures)
+            for (const auto& pass : fixture.passes)
+                if (!pass.ok) result.ok = false;
+        if (!result.ok && result.error.empty())
+            result.error = "one or more passes failed (see fixtures)";
+
+        return result;
+    }
+
+} // namespace HCPEngine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace HCPEngine
+{
+    class HCPEngineSystemComponent;
+
+    //! One timed ingest pass over one fixture. Stage boundaries match the
+    //! pipeline's own (PhysIngestProgress): byte-floor decode, run
+    //! segmentation, resolve, scan, store. Pass 0 is the cold scenario (first
+    //! touch of the fixture in this process — envelope window, pack cache and
+    //! query caches at whatever state the engine started in); later passes are
+    //! warm (every cross-document cache primed by the pass before).
+    struct IngestBenchPass
+    {
+        AZStd::string scenario;      // "cold" / "warm"
+        double byteFloorMs = 0.0;    // bytes -> positioned characters
+        double segmentMs   = 0.0;    // characters -> runs
+        double resolveMs   = 0.0;    // BedManager::Resolve
+        double scanMs      = 0.0;    // ScanManifestToPBM
+        double storeMs     = 0.0;    // PBM storage (bonds + positions)
+        double totalMs     = 0.0;    // end-to-end, file bytes to stored doc
+        AZ::u32 runs       = 0;
+        AZ::u32 resolved   = 0;
+        AZ::u32 unresolved = 0;
+        AZ::u64 bondTypes  = 0;
+        bool ok = false;
+        AZStd::string error;
+    };
+
+    //! One corpus fixture: a pinned data/gutenberg text, found by the same
+    //! 5-digit catalog-id prefix match RunGutenbergTexts uses.
+    struct IngestBenchFixture
+    {
+        AZStd::string name;          // "small" / "medium" / "novel"
+        AZStd::string file;
+        AZ::u64 bytes = 0;
+        AZStd::vector<IngestBenchPass> passes;
+    };
+
+    struct IngestBenchResult
+    {
+        bool ok = false;
+        AZStd::string error;
+        AZStd::vector<IngestBenchFixture> fixtures;
+    };
+
+    //! Run the fixed ingest benchmark: each pinned fixture is ingested
+    //! `passes` times (default 2 — cold then warm) through the full
+    //! byte-floor -> resolve -> scan -> store pipeline, with per-stage wall
+    //! times recorded. The socket server's run_ingest_bench action serializes
+    //! the result as JSON for cross-commit tracking; numbers are wall times on
+    //! the calling thread, so run it on an otherwise idle engine.
+    IngestBenchResult RunIngestBench(
+        const AZStd::string& fixturesDir,
+        int passes,
+        HCPEngineSystemComponent* engine);
+
+} // namespace HCPEngine
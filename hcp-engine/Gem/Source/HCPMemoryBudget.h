@@ -0,0 +1,236 @@
+#pragma once
+
+// MemoryBudget — per-component resident-memory accounting for the daemon.
+//
+// The engine's caches each grow their own way (envelope window, vocab
+// indexes, VocabPack cache, assembly caches), and the daemons share hosts
+// with Postgres — the footprint has to be a configured number, not an
+// emergent one. Components register a usage callback (current resident
+// bytes) and, when they can be rebuilt, an eviction callback tagged with a
+// cost-to-rebuild class. Enforce() drops cheapest-first until the accounted
+// total fits HCP_MEM_BUDGET_MB; the stats action exports the whole table
+// plus process RSS so the number can be watched.
+//
+// Deliberately NOT accounted: file-backed memory (LMDB maps, TextCache,
+// PBM snapshots — the kernel reclaims those pages under pressure on its
+// own) and per-worker session caches (a few MB each, bounded by worker
+// count). The budget defends the process-private heap the kernel cannot
+// take back.
+
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/function/function_template.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <unistd.h>
+
+namespace HCPEngine
+{
+    //! How much work re-filling a component costs once evicted. Eviction
+    //! order is Cheap → Moderate → Expensive; Pinned components are
+    //! accounted and exported but never evicted (the engine cannot run
+    //! without them).
+    enum class RebuildCost : AZ::u32
+    {
+        Cheap = 0,       //!< Refills from data already resident (derived caches)
+        Moderate,        //!< Refills from local disk (LMDB, side files)
+        Expensive,       //!< Refills from Postgres round trips
+        Pinned,          //!< Not evictable
+    };
+
+    class MemoryBudget
+    {
+    public:
+        using UsageFn = AZStd::function<size_t()>;
+        using EvictFn = AZStd::function<void()>;
+
+        static constexpr const char* CostName(RebuildCost cost)
+        {
+            switch (cost)
+            {
+            case RebuildCost::Cheap:     return "cheap";
+            case RebuildCost::Moderate:  return "moderate";
+            case RebuildCost::Expensive: return "expensive";
+            case RebuildCost::Pinned:    return "pinned";
+            default:                     return "unknown";
+            }
+        }
+
+        static MemoryBudget& Get()
+        {
+            static MemoryBudget s_instance;
+            return s_instance;
+        }
+
+        //! Budget in bytes — HCP_MEM_BUDGET_MB; 0 (the default) disables
+        //! enforcement, accounting still runs for the stats export.
+        static size_t BudgetBytes()
+        {
+            static const size_t bytes = []() -> size_t {
+                const char* mb = std::getenv("HCP_MEM_BUDGET_MB");
+                long v = mb ? atol(mb) : 0;
+                if (v < 0) v = 0;
+                return static_cast<size_t>(v) * 1024 * 1024;
+            }();
+            return bytes;
+        }
+
+        //! Process RSS in bytes, from /proc/self/statm. The budget enforces
+        //! against the accounted total (what we can actually evict); RSS is
+        //! exported alongside it as the ground truth the ceiling is about.
+        static size_t ResidentBytes()
+        {
+            FILE* f = fopen("/proc/self/statm", "r");
+            if (!f) return 0;
+            unsigned long sizePages = 0, rssPages = 0;
+            int n = fscanf(f, "%lu %lu", &sizePages, &rssPages);
+            fclose(f);
+            if (n != 2) return 0;
+            static const long pageSize = sysconf(_SC_PAGESIZE);
+            return static_cast<size_t>(rssPages) * static_cast<size_t>(pageSize);
+        }
+
+        //! Register a component. `usage` is polled on every Enforce/Snapshot
+        //! and must be cheap (a size sum under the component's own lock).
+        //! Components that cannot rebuild pass no `evict` and RebuildCost::Pinned.
+        //! Re-registering a name replaces the previous entry (engine restart).
+        void Register(const char* name, RebuildCost cost, UsageFn usage, EvictFn evict = {})
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& c : m_components)
+            {
+                if (c.name == name)
+                {
+                    c.cost = cost;
+                    c.usage = AZStd::move(usage);
+                    c.evict = AZStd::move(evict);
+                    return;
+                }
+            }
+            m_components.push_back({ name, cost, AZStd::move(usage), AZStd::move(evict) });
+        }
+
+        //! Drop a component (engine shutdown). Unknown names are a no-op.
+        void Unregister(const char* name)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i = 0; i < m_components.size(); ++i)
+            {
+                if (m_components[i].name == name)
+                {
+                    m_components.erase(m_components.begin() + i);
+                    return;
+                }
+            }
+        }
+
+        //! Plain-data row for the stats export.
+        struct ComponentSnapshot
+        {
+            AZStd::string name;
+            RebuildCost cost = RebuildCost::Pinned;
+            size_t bytes = 0;
+            bool evictable = false;
+        };
+
+        AZStd::vector<ComponentSnapshot> Snapshot()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            AZStd::vector<ComponentSnapshot> out;
+            out.reserve(m_components.size());
+            for (const auto& c : m_components)
+            {
+                ComponentSnapshot s;
+                s.name = c.name;
+                s.cost = c.cost;
+                s.bytes = c.usage ? c.usage() : 0;
+                s.evictable = static_cast<bool>(c.evict);
+                out.push_back(AZStd::move(s));
+            }
+            return out;
+        }
+
+        //! Accounted total across registered components.
+        size_t TotalBytes()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            size_t total = 0;
+            for (const auto& c : m_components)
+                total += c.usage ? c.usage() : 0;
+            return total;
+        }
+
+        //! Evict cheapest-first until the accounted total fits the budget.
+        //! Call after growth events (pack builds, envelope loads) — never
+        //! from inside a component's own lock. Returns true if the total
+        //! fits on exit (trivially true with no budget configured).
+        bool Enforce(const char* trigger)
+        {
+            const size_t budget = BudgetBytes();
+            if (budget == 0) return true;
+
+            size_t total = TotalBytes();
+            if (total <= budget) return true;
+
+            // Walk cost classes upward, re-polling after each eviction —
+            // dropping one component often brings the total under without
+            // touching anything more expensive.
+            for (AZ::u32 cost = 0; cost < static_cast<AZ::u32>(RebuildCost::Pinned); ++cost)
+            {
+                for (size_t i = 0; total > budget; ++i)
+                {
+                    EvictFn evict;
+                    AZStd::string name;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        size_t seen = 0;
+                        for (const auto& c : m_components)
+                        {
+                            if (static_cast<AZ::u32>(c.cost) != cost || !c.evict)
+                                continue;
+                            if (seen++ == i)
+                            {
+                                evict = c.evict;
+                                name = c.name;
+                                break;
+                            }
+                        }
+                    }
+                    if (!evict) break;   // this cost class exhausted
+
+                    evict();
+                    const size_t after = TotalBytes();
+                    fprintf(stderr, "[MemoryBudget] evicted '%s' (%s, trigger: %s): "
+                        "%zu -> %zu bytes vs %zu budget\n",
+                        name.c_str(), CostName(static_cast<RebuildCost>(cost)), trigger,
+                        total, after, budget);
+                    fflush(stderr);
+                    total = after;
+                }
+                if (total <= budget) return true;
+            }
+
+            fprintf(stderr, "[MemoryBudget] over budget after eviction (trigger: %s): "
+                "%zu accounted vs %zu budget — remainder is pinned\n",
+                trigger, total, budget);
+            fflush(stderr);
+            return false;
+        }
+
+    private:
+        struct Component
+        {
+            AZStd::string name;
+            RebuildCost cost;
+            UsageFn usage;
+            EvictFn evict;
+        };
+
+        std::mutex m_mutex;
+        AZStd::vector<Component> m_components;
+    };
+
+} // namespace HCPEngine
@@ -0,0 +1,91 @@
+#pragma once
+
+// MpscQueue — lock-free multi-producer single-consumer result channel.
+//
+// Resolve workers produce ResolutionResults concurrently while one thread
+// (the Resolve caller) consumes them. The old merge serialized every worker
+// on one mutex at exactly the moment its workspace finished simulating; this
+// queue makes the producer side a single CAS push, so draining results never
+// blocks a workspace that is mid-simulate on another thread.
+//
+// Push is a Treiber-stack CAS loop — lock-free, and ABA-safe here because a
+// node is never reused while linked. The single consumer detaches the whole
+// chain with one exchange and reverses it, so DrainTo hands back each
+// producer's results in push order. Not a general queue: one consumer at a
+// time, by design.
+
+#include <AzCore/std/containers/vector.h>
+#include <atomic>
+
+namespace HCPEngine
+{
+    template <typename T>
+    class MpscQueue
+    {
+    public:
+        ~MpscQueue()
+        {
+            Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+            while (node)
+            {
+                Node* next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+
+        //! Producer side: one allocation + one CAS loop. Safe from any thread.
+        void Push(T&& value)
+        {
+            Node* node = new Node{ AZStd::move(value),
+                m_head.load(std::memory_order_relaxed) };
+            // On CAS failure node->next is refreshed with the observed head.
+            while (!m_head.compare_exchange_weak(node->next, node,
+                std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void Push(const T& value)
+        {
+            Push(T(value));
+        }
+
+        //! Consumer side (single thread at a time): detach everything pushed
+        //! so far and append to `out` in push order. Touches the shared head
+        //! exactly once.
+        void DrainTo(AZStd::vector<T>& out)
+        {
+            Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+            Node* reversed = nullptr;
+            while (node)
+            {
+                Node* next = node->next;
+                node->next = reversed;
+                reversed = node;
+                node = next;
+            }
+            while (reversed)
+            {
+                out.push_back(AZStd::move(reversed->value));
+                Node* next = reversed->next;
+                delete reversed;
+                reversed = next;
+            }
+        }
+
+        bool Empty() const
+        {
+            return m_head.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        struct Node
+        {
+            T value;
+            Node* next;
+        };
+
+        std::atomic<Node*> m_head{ nullptr };
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+// NumaTopology — minimal NUMA probe + thread pinning for workspace placement.
+//
+// The ingest hosts are dual-socket: a workspace whose particle planes live on
+// one node but whose settle worker runs on the other pays cross-socket
+// bandwidth on every step. We deliberately do NOT link libnuma for this —
+// everything needed is in /sys and sched_setaffinity:
+//
+//   - topology: /sys/devices/system/node/node<N>/cpulist ("0-15,32-47")
+//   - memory binding: FIRST TOUCH. Linux places a page on the node of the
+//     thread that first writes it, so "bind these arrays to node N" is
+//     "pin a thread to node N, then let it do the allocating writes".
+//   - compute binding: pin the worker that owns those arrays to the same node.
+//
+// Probed once, lazily (same singleton shape as ResolveStats). On non-Linux
+// builds, in containers without /sys, and under HCP_NUMA=0 the topology
+// reports a single node and every pin is a no-op — callers need no fallback
+// path of their own.
+
+#include <AzCore/base.h>
+#include <AzCore/std/containers/vector.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace HCPEngine
+{
+    class NumaTopology
+    {
+    public:
+        //! Process-wide instance; topology is immutable after the first call.
+        static NumaTopology& Get()
+        {
+            static NumaTopology s_instance;
+            return s_instance;
+        }
+
+        //! Number of NUMA nodes with at least one CPU. 1 = no placement to do.
+        AZ::u32 NodeCount() const
+        {
+            return static_cast<AZ::u32>(m_nodeCpus.size() ? m_nodeCpus.size() : 1);
+        }
+
+        //! Pin the CALLING thread to every CPU of `node` (modulo node count).
+        //! No-op (returns false) on single-node topologies.
+        bool PinThreadToNode(AZ::u32 node) const
+        {
+#if defined(__linux__)
+            if (m_nodeCpus.size() < 2)
+                return false;
+            const auto& cpus = m_nodeCpus[node % m_nodeCpus.size()];
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus)
+                CPU_SET(cpu, &set);
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+            (void)node;
+            return false;
+#endif
+        }
+
+    private:
+        NumaTopology()
+        {
+#if defined(__linux__)
+            // HCP_NUMA=0 forces single-node behaviour (e.g. when the
+            // container's cpuset makes the /sys view a lie).
+            const char* env = std::getenv("HCP_NUMA");
+            if (env && env[0] == '0')
+                return;
+
+            for (AZ::u32 n = 0;; ++n)
+            {
+                char path[96];
+                std::snprintf(path, sizeof(path),
+                    "/sys/devices/system/node/node%u/cpulist", n);
+                FILE* f = std::fopen(path, "r");
+                if (!f)
+                    break;   // nodes are numbered densely; first gap ends the scan
+                char list[512] = {};
+                const bool read = std::fgets(list, sizeof(list), f) != nullptr;
+                std::fclose(f);
+                if (!read)
+                    continue;
+
+                // cpulist is comma-separated ranges: "0-15,32-47" or "3".
+                AZStd::vector<int> cpus;
+                const char* p = list;
+                while (*p && *p != '\n')
+                {
+                    char* end = nullptr;
+                    long lo = std::strtol(p, &end, 10);
+                    if (end == p)
+                        break;
+                    long hi = lo;
+                    if (*end == '-')
+                    {
+                        p = end + 1;
+                        hi = std::strtol(p, &end, 10);
+                    }
+                    for (long c = lo; c <= hi; ++c)
+                        cpus.push_back(static_cast<int>(c));
+                    p = (*end == ',') ? end + 1 : end;
+                }
+                if (!cpus.empty())   // skip memory-only nodes
+                    m_nodeCpus.push_back(AZStd::move(cpus));
+            }
+
+            if (m_nodeCpus.size() > 1)
+            {
+                fprintf(stderr, "[NumaTopology] %zu nodes with CPUs\n", m_nodeCpus.size());
+                fflush(stderr);
+            }
+#endif
+        }
+
+        AZStd::vector<AZStd::vector<int>> m_nodeCpus;
+    };
+
+} // namespace HCPEngine
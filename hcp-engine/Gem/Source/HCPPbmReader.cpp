@@ -1,5 +1,7 @@
 #include "HCPPbmReader.h"
 #include "HCPDbUtils.h"
+#include "HCPPbmSnapshot.h"
+#include "HCPPosPack.h"
 #include "HCPResolutionChamber.h"
 
 #include <AzCore/Console/ILogger.h>
@@ -10,13 +12,130 @@
 #include <algorithm>
 #include <cstring>
 #include <cctype>
+#include <climits>
 #include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace HCPEngine
 {
+namespace PbmReader_Detail
+{
+    // Serve LoadPBM from an ingest-time snapshot (HCPPbmSnapshot.h). The file
+    // is mmap'd read-only and every section is addressed by index — no SQL, no
+    // text parsing. Returns false (leaving `out` untouched) when there is no
+    // usable snapshot, and the caller falls back to live Postgres.
+    bool TryLoadSnapshotBonds(const AZStd::string& docId, PBMData& out)
+    {
+        using namespace PbmSnapshot;
+
+        AZStd::string path = PathFor(docId);
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader))
+        {
+            close(fd);
+            return false;
+        }
+        size_t mapBytes = static_cast<size_t>(st.st_size);
+
+        void* map = mmap(nullptr, mapBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);   // the mapping keeps the file alive
+        if (map == MAP_FAILED)
+        {
+            return false;
+        }
+
+        const char* base = static_cast<const char*>(map);
+        SnapshotHeader header;
+        memcpy(&header, base, sizeof(header));
+
+        if (header.magic != MAGIC || header.version != VERSION ||
+            TotalBytes(header) > mapBytes)
+        {
+            fprintf(stderr, "[HCPPbmReader] snapshot rejected (%s): bad header\n",
+                path.c_str());
+            fflush(stderr);
+            munmap(map, mapBytes);
+            return false;
+        }
+
+        const VarRecord* vars =
+            reinterpret_cast<const VarRecord*>(base + VarTableOffset(header));
+        const char* varBlob = base + VarBlobOffset(header);
+        const BondRecord* bonds =
+            reinterpret_cast<const BondRecord*>(base + BondTableOffset(header));
+
+        // Reconstruct the var token form used everywhere else: prefix + surface.
+        auto varToken = [&](AZ::u32 idx) -> AZStd::string {
+            const VarRecord& vr = vars[idx];
+            AZStd::string token = VAR_PREFIX;
+            token += ' ';
+            token.append(varBlob + vr.surfaceOffset, vr.surfaceLen);
+            return token;
+        };
+
+        PBMData result;
+        result.firstFpbA = header.firstFpbA;
+        result.firstFpbB = header.firstFpbB;
+        result.bonds.reserve(header.bondCount);
+
+        for (AZ::u32 i = 0; i < header.bondCount; ++i)
+        {
+            const BondRecord& br = bonds[i];
+            if ((br.aVar != NO_VAR && br.aVar >= header.varCount) ||
+                (br.bVar != NO_VAR && br.bVar >= header.varCount))
+            {
+                fprintf(stderr, "[HCPPbmReader] snapshot rejected (%s): var index\n",
+                    path.c_str());
+                fflush(stderr);
+                munmap(map, mapBytes);
+                return false;
+            }
+
+            Bond bond;
+            bond.tokenA = br.aVar != NO_VAR ? varToken(br.aVar) : AZStd::string(br.tokenA);
+            bond.tokenB = br.bVar != NO_VAR ? varToken(br.bVar) : AZStd::string(br.tokenB);
+            bond.count = static_cast<int>(br.count);
+            result.totalPairs += br.count;
+            result.bonds.push_back(AZStd::move(bond));
+        }
+
+        munmap(map, mapBytes);
+
+        AZStd::unordered_set<AZStd::string> uniqueTokens;
+        for (const auto& bond : result.bonds)
+        {
+            uniqueTokens.insert(bond.tokenA);
+            uniqueTokens.insert(bond.tokenB);
+        }
+        result.uniqueTokens = uniqueTokens.size();
+
+        out = AZStd::move(result);
+        return true;
+    }
+} // PbmReader_Detail
+
     PBMData HCPPbmReader::LoadPBM(const AZStd::string& docId)
     {
         PBMData result;
+
+        if (PbmSnapshot::Enabled() &&
+            PbmReader_Detail::TryLoadSnapshotBonds(docId, result))
+        {
+            AZLOG_INFO("HCPPbmReader: Loaded PBM %s from snapshot — %zu bonds, "
+                "%zu total pairs, %zu unique tokens",
+                docId.c_str(), result.bonds.size(), result.totalPairs, result.uniqueTokens);
+            return result;
+        }
+
         PGconn* pg = m_conn.Get();
         if (!pg)
         {
@@ -254,6 +373,16 @@ namespace HCPEngine
 
         AZStd::string pkStr = AZStd::to_string(docPk);
 
+        // Session-scoped starter cache: the same function-word starters head
+        // nearly every document, so surfaces resolved once serve the whole
+        // session. Surfaces come from the active envelope's entries — drop the
+        // cache when the word index changes under us.
+        if (m_starterCacheGeneration != vocab.WordIndexGeneration())
+        {
+            m_starterWords.clear();
+            m_starterCacheGeneration = vocab.WordIndexGeneration();
+        }
+
         // ALL_CAPS positions for this doc (nominal — author override).
         // FIRST_CAP is positional, computed by TokenIdsToText (capitalize after . ? ! \n).
         AZStd::unordered_set<int> allCapsPositions;
@@ -283,14 +412,16 @@ namespace HCPEngine
             PQclear(res);
         }
 
-        // Pull all starters with their position arrays. One row per (doc, token).
-        // Per-doc result: ~thousands of rows, each with positions INTEGER[] payload.
+        // Pull all starters with their position lists. One row per (doc, token).
+        // Per-doc result: ~thousands of rows, each with a packed varint payload
+        // (positions_packed, migration 052) or — for rows ingested before the
+        // migration — the legacy positions INTEGER[].
         struct PosWord { int pos; AZStd::string word; };
         AZStd::vector<PosWord> entries;
         {
             const char* params[] = { pkStr.c_str() };
             PGresult* res = PQexecParams(pg,
-                "SELECT token_a_id, positions FROM pbm_starters WHERE doc_id = $1",
+                "SELECT token_a_id, positions, positions_packed FROM pbm_starters WHERE doc_id = $1",
                 1, nullptr, params, nullptr, nullptr, 0);
             if (PQresultStatus(res) != PGRES_TUPLES_OK)
             {
@@ -299,7 +430,9 @@ namespace HCPEngine
                 return false;
             }
 
-            // First pass: collect word token_ids needing entries lookup
+            // First pass: collect word token_ids needing entries lookup —
+            // only ids the session cache has never seen (hits and pinned
+            // misses both skip the fetch).
             AZStd::vector<AZStd::string> wordTokenIds;
             int n = PQntuples(res);
             for (int i = 0; i < n; ++i)
@@ -308,44 +441,16 @@ namespace HCPEngine
                 if (strncmp(tid, "00.00.00.", 9) == 0) continue;
                 if (strcmp(tid, STREAM_START) == 0 || strcmp(tid, STREAM_END) == 0) continue;
                 if (vocab.TokenToChar(tid) != '\0') continue;
+                if (m_starterWords.count(tid) != 0) continue;
                 wordTokenIds.emplace_back(tid);
             }
 
-            // Batch-fetch surface forms from hcp_english.entries
-            AZStd::unordered_map<AZStd::string, AZStd::string> nameMap;
-            if (!wordTokenIds.empty())
-            {
-                PGconn* eng = PQconnectdb(
-                    "dbname=hcp_english user=hcp password=hcp_dev host=192.168.68.60 port=5435 sslmode=disable");
-                if (PQstatus(eng) == CONNECTION_OK)
-                {
-                    std::string arr = "ARRAY[";
-                    for (size_t j = 0; j < wordTokenIds.size(); ++j)
-                    {
-                        if (j) arr += ',';
-                        arr += '\'';
-                        for (char ch : wordTokenIds[j]) { if (ch == '\'') arr += '\''; arr += ch; }
-                        arr += '\'';
-                    }
-                    arr += "]";
-                    std::string q = "SELECT token_id, word FROM entries WHERE token_id = ANY(" + arr + ")";
-                    PGresult* nr = PQexec(eng, q.c_str());
-                    if (PQresultStatus(nr) == PGRES_TUPLES_OK)
-                    {
-                        for (int j = 0; j < PQntuples(nr); ++j)
-                            nameMap[PQgetvalue(nr, j, 0)] = PQgetvalue(nr, j, 1);
-                    }
-                    PQclear(nr);
-                }
-                else
-                {
-                    fprintf(stderr, "[HCPPbmReader] hcp_english connect failed: %s\n", PQerrorMessage(eng));
-                    fflush(stderr);
-                }
-                PQfinish(eng);
-            }
+            // Batch-fetch surface forms from hcp_english.entries into the
+            // session cache
+            FetchStarterWords(wordTokenIds);
 
-            // Second pass: for each starter, resolve word and unnest positions array
+            // Second pass: for each starter, resolve word and unpack positions
+            AZStd::vector<unsigned char> packedBytes;   // reused across rows
             for (int i = 0; i < n; ++i)
             {
                 const char* tid = PQgetvalue(res, i, 0);
@@ -364,13 +469,24 @@ namespace HCPEngine
                     if (ch != '\0') word = AZStd::string(1, ch);
                     else
                     {
-                        auto nit = nameMap.find(tid);
-                        if (nit != nameMap.end()) word = nit->second;
+                        auto nit = m_starterWords.find(tid);
+                        if (nit != m_starterWords.end()) word = nit->second;
                     }
                 }
                 if (word.empty()) continue;
 
-                // Parse positions INTEGER[] literal "{1,2,3}"
+                // Packed positions first (delta varints in bytea, hex on the
+                // text-mode wire): one sequential decode, no per-element parse.
+                if (!PQgetisnull(res, i, 2)
+                    && PosPack::HexToBytes(PQgetvalue(res, i, 2), packedBytes)
+                    && !packedBytes.empty())
+                {
+                    PosPack::Unpack(packedBytes.data(), packedBytes.size(),
+                        [&](int pos) { entries.push_back({pos, word}); });
+                    continue;
+                }
+
+                // Legacy rows: parse the positions INTEGER[] literal "{1,2,3}"
                 const char* arr = PQgetvalue(res, i, 1);
                 if (!arr || arr[0] != '{') continue;
                 const char* p = arr + 1;
@@ -409,4 +525,356 @@ namespace HCPEngine
         return true;
     }
 
+    void HCPPbmReader::FetchStarterWords(const AZStd::vector<AZStd::string>& wordTokenIds)
+    {
+        if (wordTokenIds.empty())
+            return;
+
+        bool fetched = false;
+        PGconn* eng = PQconnectdb(
+            "dbname=hcp_english user=hcp password=hcp_dev host=192.168.68.60 port=5435 sslmode=disable");
+        if (PQstatus(eng) == CONNECTION_OK)
+        {
+            std::string arr = "ARRAY[";
+            for (size_t j = 0; j < wordTokenIds.size(); ++j)
+            {
+                if (j) arr += ',';
+                arr += '\'';
+                for (char ch : wordTokenIds[j]) { if (ch == '\'') arr += '\''; arr += ch; }
+                arr += '\'';
+            }
+            arr += "]";
+            std::string q = "SELECT token_id, word FROM entries WHERE token_id = ANY(" + arr + ")";
+            PGresult* nr = PQexec(eng, q.c_str());
+            if (PQresultStatus(nr) == PGRES_TUPLES_OK)
+            {
+                for (int j = 0; j < PQntuples(nr); ++j)
+                    m_starterWords[PQgetvalue(nr, j, 0)] = PQgetvalue(nr, j, 1);
+                fetched = true;
+            }
+            PQclear(nr);
+        }
+        else
+        {
+            fprintf(stderr, "[HCPPbmReader] hcp_english connect failed: %s\n", PQerrorMessage(eng));
+            fflush(stderr);
+        }
+        PQfinish(eng);
+
+        // Pin the batch's unresolved ids as known misses — emplace leaves
+        // resolved entries alone. Skipped when the fetch itself failed, so
+        // a transient outage never poisons the session cache.
+        if (fetched)
+        {
+            for (const auto& tid : wordTokenIds)
+                m_starterWords.emplace(tid, AZStd::string());
+        }
+    }
+
+    bool HCPPbmReader::LoadPositionsRange(
+        const AZStd::string& docId,
+        const HCPVocabulary& vocab,
+        int fromSlot, int count,
+        AZStd::vector<AZStd::string>& words,
+        AZStd::vector<AZ::u32>& modifiers,
+        int& totalSlots)
+    {
+        words.clear();
+        modifiers.clear();
+        totalSlots = 0;
+
+        if (fromSlot < 0) fromSlot = 0;
+        if (count <= 0) return false;
+        const int endSlot = fromSlot > INT_MAX - count ? INT_MAX : fromSlot + count;
+
+        PGconn* pg = m_conn.Get();
+        if (!pg)
+        {
+            AZLOG_ERROR("HCPPbmReader: Not connected");
+            return false;
+        }
+
+        // Document PK and total_slots (the caller pages off total_slots)
+        int docPk = 0;
+        {
+            const char* params[] = { docId.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT id, COALESCE(total_slots, 0) FROM pbm_documents WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) == 0)
+            {
+                AZLOG_ERROR("HCPPbmReader::LoadPositionsRange: Document %s not found", docId.c_str());
+                PQclear(res);
+                return false;
+            }
+            docPk = atoi(PQgetvalue(res, 0, 0));
+            totalSlots = atoi(PQgetvalue(res, 0, 1));
+            PQclear(res);
+        }
+
+        AZStd::string pkStr = AZStd::to_string(docPk);
+
+        // var_id → surface, same as the full loader (small per-doc table)
+        AZStd::unordered_map<AZStd::string, AZStd::string> varSurfaces;
+        {
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT var_id, surface FROM pbm_docvars WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK)
+            {
+                for (int i = 0; i < PQntuples(res); ++i)
+                    varSurfaces[PQgetvalue(res, i, 0)] = PQgetvalue(res, i, 1);
+            }
+            PQclear(res);
+        }
+
+        if (m_starterCacheGeneration != vocab.WordIndexGeneration())
+        {
+            m_starterWords.clear();
+            m_starterCacheGeneration = vocab.WordIndexGeneration();
+        }
+
+        // ALL_CAPS overlay, window slots only
+        AZStd::unordered_set<int> allCapsPositions;
+        {
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT all_caps_positions FROM pbm_documents WHERE id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+            {
+                const char* arr = PQgetvalue(res, 0, 0);
+                if (arr && arr[0] == '{')
+                {
+                    const char* p = arr + 1;
+                    while (*p && *p != '}')
+                    {
+                        char* end = nullptr;
+                        long v = strtol(p, &end, 10);
+                        if (end == p) break;
+                        if (v >= fromSlot && v < endSlot)
+                            allCapsPositions.insert(static_cast<int>(v));
+                        p = end;
+                        if (*p == ',') ++p;
+                    }
+                }
+            }
+            PQclear(res);
+        }
+
+        // Window pass over the starters. Packed lists are ascending deltas, so
+        // each row's decode stops at the first position past the window — a
+        // viewport-sized request touches a viewport-sized slice of every list,
+        // and word resolution only runs for starters that actually land in it.
+        struct PosWord { int pos; AZStd::string word; };
+        AZStd::vector<PosWord> entries;
+        {
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT token_a_id, positions, positions_packed FROM pbm_starters WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) != PGRES_TUPLES_OK)
+            {
+                fprintf(stderr, "[HCPPbmReader] starters query failed: %s\n", PQerrorMessage(pg));
+                PQclear(res);
+                return false;
+            }
+
+            const int n = PQntuples(res);
+
+            // Per-row in-window positions; rows with none are skipped entirely
+            // from word resolution.
+            AZStd::vector<AZStd::vector<int>> rowPositions(n);
+            AZStd::vector<unsigned char> packedBytes;
+            for (int i = 0; i < n; ++i)
+            {
+                const char* tid = PQgetvalue(res, i, 0);
+                if (strcmp(tid, STREAM_START) == 0 || strcmp(tid, STREAM_END) == 0) continue;
+
+                if (!PQgetisnull(res, i, 2)
+                    && PosPack::HexToBytes(PQgetvalue(res, i, 2), packedBytes)
+                    && !packedBytes.empty())
+                {
+                    AZ::u32 acc = 0;
+                    bool first = true;
+                    size_t b = 0;
+                    while (b < packedBytes.size())
+                    {
+                        AZ::u32 v = packedBytes[b];
+                        if (v < 0x80) { ++b; }
+                        else
+                        {
+                            v &= 0x7F; ++b;
+                            int shift = 7;
+                            while (b < packedBytes.size())
+                            {
+                                const AZ::u32 byte = packedBytes[b++];
+                                v |= (byte & 0x7F) << shift;
+                                if (byte < 0x80) break;
+                                shift += 7;
+                            }
+                        }
+                        acc = first ? v : acc + v;
+                        first = false;
+                        const int pos = static_cast<int>(acc);
+                        if (pos >= endSlot) break;
+                        if (pos >= fromSlot) rowPositions[i].push_back(pos);
+                    }
+                    continue;
+                }
+
+                const char* arr = PQgetvalue(res, i, 1);
+                if (!arr || arr[0] != '{') continue;
+                const char* p = arr + 1;
+                while (*p && *p != '}')
+                {
+                    char* end = nullptr;
+                    long v = strtol(p, &end, 10);
+                    if (end == p) break;
+                    if (v >= endSlot) break;   // stored ascending
+                    if (v >= fromSlot) rowPositions[i].push_back(static_cast<int>(v));
+                    p = end;
+                    if (*p == ',') ++p;
+                }
+            }
+
+            // Resolve only the starters the window touched.
+            AZStd::vector<AZStd::string> wordTokenIds;
+            for (int i = 0; i < n; ++i)
+            {
+                if (rowPositions[i].empty()) continue;
+                const char* tid = PQgetvalue(res, i, 0);
+                if (strncmp(tid, "00.00.00.", 9) == 0) continue;
+                if (vocab.TokenToChar(tid) != '\0') continue;
+                if (m_starterWords.count(tid) != 0) continue;
+                wordTokenIds.emplace_back(tid);
+            }
+            FetchStarterWords(wordTokenIds);
+
+            for (int i = 0; i < n; ++i)
+            {
+                if (rowPositions[i].empty()) continue;
+                const char* tid = PQgetvalue(res, i, 0);
+
+                AZStd::string word;
+                if (strncmp(tid, "00.00.00.", 9) == 0)
+                {
+                    AZStd::string varId(tid + 9);
+                    auto vit = varSurfaces.find(varId);
+                    if (vit != varSurfaces.end()) word = vit->second;
+                }
+                else
+                {
+                    char ch = vocab.TokenToChar(tid);
+                    if (ch != '\0') word = AZStd::string(1, ch);
+                    else
+                    {
+                        auto nit = m_starterWords.find(tid);
+                        if (nit != m_starterWords.end()) word = nit->second;
+                    }
+                }
+                if (word.empty()) continue;
+
+                for (int pos : rowPositions[i])
+                    entries.push_back({pos, word});
+            }
+            PQclear(res);
+        }
+
+        std::sort(entries.begin(), entries.end(),
+            [](const PosWord& a, const PosWord& b) { return a.pos < b.pos; });
+
+        words.reserve(entries.size());
+        modifiers.reserve(entries.size());
+        for (auto& e : entries)
+        {
+            AZ::u32 mod = allCapsPositions.count(e.pos) ? 2u : 0u;
+            words.push_back(AZStd::move(e.word));
+            modifiers.push_back(mod);
+        }
+
+        fprintf(stderr, "[HCPPbmReader] LoadPositionsRange: %s — slots [%d,%d) of %d, %zu words\n",
+            docId.c_str(), fromSlot, endSlot, totalSlots, words.size());
+        fflush(stderr);
+
+        return true;
+    }
+
+    AZStd::unordered_map<AZStd::string, AZ::u32> HCPPbmReader::LoadFirstPositions(
+        const AZStd::string& docId)
+    {
+        AZStd::unordered_map<AZStd::string, AZ::u32> firsts;
+
+        PGconn* pg = m_conn.Get();
+        if (!pg)
+        {
+            AZLOG_ERROR("HCPPbmReader: Not connected");
+            return firsts;
+        }
+
+        AZStd::string pkStr;
+        {
+            const char* params[] = { docId.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT id FROM pbm_documents WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) == 0)
+            {
+                PQclear(res);
+                return firsts;
+            }
+            pkStr = PQgetvalue(res, 0, 0);
+            PQclear(res);
+        }
+
+        const char* params[] = { pkStr.c_str() };
+        PGresult* res = PQexecParams(pg,
+            "SELECT token_a_id, positions, positions_packed FROM pbm_starters WHERE doc_id = $1",
+            1, nullptr, params, nullptr, nullptr, 0);
+        if (PQresultStatus(res) != PGRES_TUPLES_OK)
+        {
+            fprintf(stderr, "[HCPPbmReader] starters query failed: %s\n", PQerrorMessage(pg));
+            PQclear(res);
+            return firsts;
+        }
+
+        AZStd::vector<unsigned char> packedBytes;
+        const int n = PQntuples(res);
+        firsts.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            const char* tid = PQgetvalue(res, i, 0);
+
+            // Packed rows: the first varint IS the absolute first position
+            // (deltas follow) — decode it and stop.
+            if (!PQgetisnull(res, i, 2)
+                && PosPack::HexToBytes(PQgetvalue(res, i, 2), packedBytes)
+                && !packedBytes.empty())
+            {
+                AZ::u32 v = 0;
+                int shift = 0;
+                for (size_t b = 0; b < packedBytes.size(); ++b)
+                {
+                    v |= static_cast<AZ::u32>(packedBytes[b] & 0x7F) << shift;
+                    if (packedBytes[b] < 0x80) break;
+                    shift += 7;
+                }
+                firsts.emplace(tid, v);
+                continue;
+            }
+
+            // Legacy rows: leading integer of the "{1,2,3}" literal.
+            const char* arr = PQgetvalue(res, i, 1);
+            if (!arr || arr[0] != '{') continue;
+            char* end = nullptr;
+            long v = strtol(arr + 1, &end, 10);
+            if (end != arr + 1)
+                firsts.emplace(tid, static_cast<AZ::u32>(v));
+        }
+        PQclear(res);
+
+        return firsts;
+    }
+
 } // namespace HCPEngine
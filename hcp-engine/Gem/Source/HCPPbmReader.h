@@ -6,6 +6,7 @@
 #include <AzCore/base.h>
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/containers/unordered_map.h>
 
 namespace HCPEngine
 {
@@ -37,8 +38,44 @@ namespace HCPEngine
                                         AZStd::vector<AZStd::string>& words,
                                         AZStd::vector<AZ::u32>& modifiers);
 
+        //! Windowed variant of LoadPositionsWithModifiers: only slots in
+        //! [fromSlot, fromSlot + count) are materialized and resolved. The
+        //! packed lists are ascending deltas, so each starter's decode stops at
+        //! the first position past the window, and word resolution only runs
+        //! for starters the window actually touches — viewport-sized requests
+        //! stay viewport-sized no matter how long the document is. totalSlots
+        //! receives the document's slot count for paging.
+        bool LoadPositionsRange(const AZStd::string& docId,
+                                const HCPVocabulary& vocab,
+                                int fromSlot, int count,
+                                AZStd::vector<AZStd::string>& words,
+                                AZStd::vector<AZ::u32>& modifiers,
+                                int& totalSlots);
+
+        //! Load each starter's EARLIEST position only (token_id → first slot).
+        //! For the bond-walk reassembly engine: when a damaged document still
+        //! has starter rows, the first positions anchor hub disambiguation
+        //! without paying the full position unpack. Positions are stored
+        //! ascending, so only the head of each list is decoded. Returns an
+        //! empty map if the document (or its starters) cannot be read.
+        AZStd::unordered_map<AZStd::string, AZ::u32> LoadFirstPositions(
+            const AZStd::string& docId);
+
     private:
+        //! Batch-fetch surface forms for word token ids from
+        //! hcp_english.entries into the session cache; unresolved ids are
+        //! pinned as known misses only when the fetch itself succeeded.
+        void FetchStarterWords(const AZStd::vector<AZStd::string>& wordTokenIds);
+
         HCPDbConnection& m_conn;
+
+        // Session-scoped starter→surface cache (token_id → word; empty value =
+        // known miss). Function-word starters repeat across every retrieval,
+        // so the batched entries fetch only sees ids this session has never
+        // resolved. Keyed to the vocabulary's word-index generation: an
+        // envelope change clears it.
+        AZStd::unordered_map<AZStd::string, AZStd::string> m_starterWords;
+        AZ::u32 m_starterCacheGeneration = 0;
     };
 
 } // namespace HCPEngine
@@ -0,0 +1,168 @@
+#pragma once
+
+// ============================================================================
+// HCP PBM snapshot — the mmap-able on-disk form of one document's PBM.
+//
+// Retrieval used to reconstruct PBMData from live Postgres on every call,
+// which put DB load on the reassembly latency path. At ingest time the writer
+// emits this side file; the reader mmaps it and serves bonds with zero
+// parsing — every section is a fixed-stride record array addressed by index,
+// in the spirit of Pack/PackKernel.h's LengthBucket layout (claim 444:
+// arrayed, fixed-stride, no surface-form keys on the hot path).
+//
+// Layout (native-endian, sections back to back in this order):
+//
+//   [SnapshotHeader]
+//   [VarRecord      × varCount]       var_id + surface slice into the blob
+//   [surface blob   varBlobBytes]     concatenated var surfaces, no terminators
+//   [BondRecord     × bondCount]      fixed 44-byte stride
+//   [PosRecord      × posRecCount]    per-starter slice into the position ints
+//   [AZ::u32        × posIntCount]    flat position values
+//   [AZ::u32        × allCapsCount]   ALL_CAPS positions (nominal overlay)
+//
+// Section offsets are DERIVED from the counts in the header — no stored
+// manifest, same doctrine as PackWindow's compact-id assignment. The bond
+// sections are written when the document commits; the position sections are
+// appended by StorePositions, which patches the header counts in place.
+//
+// Token ids are short pair-code strings (≤ 15 chars), stored NUL-padded in
+// fixed char[16] fields. Var tokens have arbitrary-length surfaces, so bond
+// sides that are vars carry an index into the var table instead.
+// ============================================================================
+
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace HCPEngine
+{
+namespace PbmSnapshot
+{
+    inline constexpr AZ::u32 MAGIC   = 0x4D425048;   // "HPBM" little-endian
+    inline constexpr AZ::u32 VERSION = 1;
+
+    //! Marks a bond side that is not a var (token id is in the char field).
+    inline constexpr AZ::u32 NO_VAR = 0xFFFFFFFFu;
+
+    struct SnapshotHeader
+    {
+        AZ::u32 magic = MAGIC;
+        AZ::u32 version = VERSION;
+        AZ::u32 docPk = 0;
+        AZ::u32 totalSlots = 0;      // patched by the position append
+        AZ::u32 bondCount = 0;
+        AZ::u32 varCount = 0;
+        AZ::u32 varBlobBytes = 0;
+        AZ::u32 posRecCount = 0;     // 0 until positions are appended
+        AZ::u32 posIntCount = 0;
+        AZ::u32 allCapsCount = 0;
+        char firstFpbA[16] = {};
+        char firstFpbB[16] = {};
+    };
+
+    //! One document-local var: decimal id ("NN.MM") + its surface slice.
+    struct VarRecord
+    {
+        char varId[8] = {};
+        AZ::u32 surfaceOffset = 0;   // into the surface blob
+        AZ::u32 surfaceLen = 0;
+    };
+
+    //! One (A, B, count) bond. A side that is a var carries aVar (index into
+    //! the var table) and an empty tokenA; same for the B side.
+    struct BondRecord
+    {
+        char tokenA[16] = {};
+        char tokenB[16] = {};
+        AZ::u32 aVar = NO_VAR;
+        AZ::u32 bVar = NO_VAR;
+        AZ::u32 count = 0;
+    };
+
+    //! One starter's positions: a slice into the flat position-int section.
+    //! tokenId is the starter form ("00.00.00.NN.MM" for vars).
+    struct PosRecord
+    {
+        char tokenId[16] = {};
+        AZ::u32 first = 0;
+        AZ::u32 count = 0;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 72, "snapshot header stride");
+    static_assert(sizeof(VarRecord) == 16, "var record stride");
+    static_assert(sizeof(BondRecord) == 44, "bond record stride");
+    static_assert(sizeof(PosRecord) == 24, "pos record stride");
+
+    // ---- Derived section offsets (bytes from file start) ----
+
+    inline size_t VarTableOffset(const SnapshotHeader&) { return sizeof(SnapshotHeader); }
+    inline size_t VarBlobOffset(const SnapshotHeader& h)
+    {
+        return VarTableOffset(h) + h.varCount * sizeof(VarRecord);
+    }
+    inline size_t BondTableOffset(const SnapshotHeader& h)
+    {
+        return VarBlobOffset(h) + h.varBlobBytes;
+    }
+    inline size_t PosTableOffset(const SnapshotHeader& h)
+    {
+        return BondTableOffset(h) + static_cast<size_t>(h.bondCount) * sizeof(BondRecord);
+    }
+    inline size_t PosIntOffset(const SnapshotHeader& h)
+    {
+        return PosTableOffset(h) + h.posRecCount * sizeof(PosRecord);
+    }
+    inline size_t AllCapsOffset(const SnapshotHeader& h)
+    {
+        return PosIntOffset(h) + h.posIntCount * sizeof(AZ::u32);
+    }
+    inline size_t TotalBytes(const SnapshotHeader& h)
+    {
+        return AllCapsOffset(h) + h.allCapsCount * sizeof(AZ::u32);
+    }
+
+    // ---- Location / enablement (same env idiom as HCP_PBM_COPY) ----
+
+    //! Snapshot emission and serving are on by default; HCP_PBM_SNAPSHOT=0
+    //! disables both (retrieval falls back to live Postgres).
+    inline bool Enabled()
+    {
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_PBM_SNAPSHOT");
+            return !(v && v[0] == '0');
+        }();
+        return enabled;
+    }
+
+    //! Snapshot directory — HCP_PBM_SNAPSHOT_DIR, or the /tmp default.
+    inline const char* Dir()
+    {
+        static const char* dir = []() {
+            const char* d = std::getenv("HCP_PBM_SNAPSHOT_DIR");
+            return d && d[0] ? d : "/tmp/hcp_pbm_snapshots";
+        }();
+        return dir;
+    }
+
+    //! File path for one document's snapshot (doc_id is filename-safe:
+    //! pair codes and dots only).
+    inline AZStd::string PathFor(const AZStd::string& docId)
+    {
+        AZStd::string path = Dir();
+        path += '/';
+        path += docId;
+        path += ".pbm";
+        return path;
+    }
+
+    //! Copy a token id into a fixed NUL-padded field. Ids longer than the
+    //! field (never produced by the pair-code scheme) are truncated.
+    inline void PutToken(char (&field)[16], const AZStd::string& token)
+    {
+        size_t n = token.size() < sizeof(field) ? token.size() : sizeof(field) - 1;
+        memcpy(field, token.data(), n);
+    }
+
+} // namespace PbmSnapshot
+} // namespace HCPEngine
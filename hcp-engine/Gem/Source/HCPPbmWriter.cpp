@@ -1,14 +1,329 @@
 #include "HCPPbmWriter.h"
 #include "HCPDbUtils.h"
+#include "HCPDocVarQuery.h"
+#include "HCPPbmSnapshot.h"
+#include "HCPPosPack.h"
+#include "HCPQueryCache.h"
+#include "HCPTextCache.h"
+#include "HCPTokenHandle.h"
 
 #include <AzCore/Console/ILogger.h>
 #include <AzCore/std/string/conversions.h>
 #include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
 #include <libpq-fe.h>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace HCPEngine
 {
+namespace PbmWriter_Detail
+{
+    // Escape one field for text-format COPY (tab-delimited rows). Only the four
+    // characters COPY treats specially need escaping; everything else passes
+    // through byte-for-byte (docvar surfaces can be arbitrary document text).
+    inline void AppendCopyField(AZStd::string& out, const AZStd::string& v)
+    {
+        for (char c : v)
+        {
+            switch (c)
+            {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t";  break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            default:   out += c;      break;
+            }
+        }
+    }
+
+    // Stream one buffered COPY payload. The whole document's rows for a table
+    // go out as a single PQputCopyData — libpq chunks internally.
+    bool RunCopy(PGconn* pg, const char* copySql, const AZStd::string& payload, const char* label)
+    {
+        PGresult* res = PQexec(pg, copySql);
+        if (PQresultStatus(res) != PGRES_COPY_IN)
+        {
+            fprintf(stderr, "[HCPPbmWriter] COPY start failed (%s): %s\n",
+                label, PQerrorMessage(pg));
+            fflush(stderr);
+            PQclear(res);
+            return false;
+        }
+        PQclear(res);
+
+        if (!payload.empty() &&
+            PQputCopyData(pg, payload.data(), static_cast<int>(payload.size())) != 1)
+        {
+            fprintf(stderr, "[HCPPbmWriter] COPY data failed (%s): %s\n",
+                label, PQerrorMessage(pg));
+            fflush(stderr);
+            PQputCopyEnd(pg, "client-side write error");
+            PGresult* end = PQgetResult(pg);
+            PQclear(end);
+            return false;
+        }
+
+        if (PQputCopyEnd(pg, nullptr) != 1)
+        {
+            fprintf(stderr, "[HCPPbmWriter] COPY end failed (%s): %s\n",
+                label, PQerrorMessage(pg));
+            fflush(stderr);
+        }
+
+        res = PQgetResult(pg);
+        bool ok = (PQresultStatus(res) == PGRES_COMMAND_OK);
+        if (!ok)
+        {
+            fprintf(stderr, "[HCPPbmWriter] COPY failed (%s): %s\n",
+                label, PQerrorMessage(pg));
+            fflush(stderr);
+        }
+        PQclear(res);
+        return ok;
+    }
+
+    // Run a plain command, log + report failure.
+    bool RunCommand(PGconn* pg, const char* sql, const char* label)
+    {
+        PGresult* res = PQexec(pg, sql);
+        bool ok = (PQresultStatus(res) == PGRES_COMMAND_OK);
+        if (!ok)
+        {
+            fprintf(stderr, "[HCPPbmWriter] %s failed: %s\n", label, PQerrorMessage(pg));
+            fflush(stderr);
+        }
+        PQclear(res);
+        return ok;
+    }
+} // PbmWriter_Detail
+
+    bool HCPPbmWriter::UseCopyPath()
+    {
+        // Default ON; HCP_PBM_COPY=0 restores the row-at-a-time path
+        // (useful when bisecting ingest differences).
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_PBM_COPY");
+            return !(v && v[0] == '0');
+        }();
+        return enabled;
+    }
+
+    void HCPPbmWriter::EmitSnapshot(PGconn* pg, const AZStd::string& docId, int docPk,
+        const PBMData& pbmData)
+    {
+        using namespace PbmSnapshot;
+
+        // Var table: read the docvars this document's bond write just minted.
+        AZStd::vector<VarRecord> varRecords;
+        AZStd::string varBlob;
+        AZStd::unordered_map<AZStd::string, AZ::u32> surfaceToVarIdx;
+        {
+            AZStd::string pkStr = AZStd::to_string(docPk);
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT var_id, surface FROM pbm_docvars WHERE doc_id = $1 ORDER BY var_id",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK)
+            {
+                for (int i = 0; i < PQntuples(res); ++i)
+                {
+                    const char* varId = PQgetvalue(res, i, 0);
+                    const char* surface = PQgetvalue(res, i, 1);
+                    size_t surfaceLen = strlen(surface);
+
+                    VarRecord vr;
+                    size_t n = strlen(varId);
+                    if (n >= sizeof(vr.varId)) n = sizeof(vr.varId) - 1;
+                    memcpy(vr.varId, varId, n);
+                    vr.surfaceOffset = static_cast<AZ::u32>(varBlob.size());
+                    vr.surfaceLen = static_cast<AZ::u32>(surfaceLen);
+
+                    surfaceToVarIdx[surface] = static_cast<AZ::u32>(varRecords.size());
+                    varRecords.push_back(vr);
+                    varBlob.append(surface, surfaceLen);
+                }
+            }
+            PQclear(res);
+        }
+
+        // Bond records — fixed stride, var sides as indices into the var table.
+        AZStd::vector<BondRecord> bondRecords;
+        bondRecords.reserve(pbmData.bonds.size());
+        for (const auto& bond : pbmData.bonds)
+        {
+            BondRecord br;
+            br.count = static_cast<AZ::u32>(bond.count);
+
+            if (IsVarToken(bond.tokenA))
+            {
+                auto it = surfaceToVarIdx.find(VarSurface(bond.tokenA));
+                if (it == surfaceToVarIdx.end()) continue;   // docvar insert failed earlier
+                br.aVar = it->second;
+            }
+            else
+            {
+                PutToken(br.tokenA, bond.tokenA);
+            }
+
+            if (IsVarToken(bond.tokenB))
+            {
+                auto it = surfaceToVarIdx.find(VarSurface(bond.tokenB));
+                if (it == surfaceToVarIdx.end()) continue;
+                br.bVar = it->second;
+            }
+            else
+            {
+                PutToken(br.tokenB, bond.tokenB);
+            }
+
+            bondRecords.push_back(br);
+        }
+
+        SnapshotHeader header;
+        header.docPk = static_cast<AZ::u32>(docPk);
+        header.bondCount = static_cast<AZ::u32>(bondRecords.size());
+        header.varCount = static_cast<AZ::u32>(varRecords.size());
+        header.varBlobBytes = static_cast<AZ::u32>(varBlob.size());
+        PutToken(header.firstFpbA, pbmData.firstFpbA);
+        PutToken(header.firstFpbB, pbmData.firstFpbB);
+
+        mkdir(Dir(), 0755);   // EEXIST is the normal case
+
+        AZStd::string path = PathFor(docId);
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f)
+        {
+            fprintf(stderr, "[HCPPbmWriter] snapshot open failed: %s\n", path.c_str());
+            fflush(stderr);
+            return;
+        }
+
+        bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+        if (ok && !varRecords.empty())
+            ok = fwrite(varRecords.data(), sizeof(VarRecord), varRecords.size(), f) == varRecords.size();
+        if (ok && !varBlob.empty())
+            ok = fwrite(varBlob.data(), 1, varBlob.size(), f) == varBlob.size();
+        if (ok && !bondRecords.empty())
+            ok = fwrite(bondRecords.data(), sizeof(BondRecord), bondRecords.size(), f) == bondRecords.size();
+        fclose(f);
+
+        if (!ok)
+        {
+            fprintf(stderr, "[HCPPbmWriter] snapshot write failed: %s\n", path.c_str());
+            fflush(stderr);
+            remove(path.c_str());   // a torn snapshot must not be served
+            return;
+        }
+
+        fprintf(stderr, "[HCPPbmWriter] snapshot: %s — %u bonds, %u vars, %zu bytes\n",
+            docId.c_str(), header.bondCount, header.varCount, TotalBytes(header));
+        fflush(stderr);
+    }
+
+    void HCPPbmWriter::AppendSnapshotPositions(PGconn* pg, int docPk,
+        const AZStd::vector<AZStd::pair<AZStd::string, AZStd::vector<int>>>& starterPositions,
+        const AZStd::vector<int>& allCapsPositions, int totalSlots)
+    {
+        using namespace PbmSnapshot;
+
+        // Snapshot files are named by doc_id; positions only know the PK.
+        AZStd::string docId;
+        {
+            AZStd::string pkStr = AZStd::to_string(docPk);
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT doc_id FROM pbm_documents WHERE id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                docId = PQgetvalue(res, 0, 0);
+            PQclear(res);
+        }
+        if (docId.empty())
+        {
+            return;
+        }
+
+        AZStd::string path = PathFor(docId);
+        FILE* f = fopen(path.c_str(), "r+b");
+        if (!f)
+        {
+            // No bond snapshot to extend (emission disabled or failed earlier).
+            return;
+        }
+
+        SnapshotHeader header;
+        if (fread(&header, sizeof(header), 1, f) != 1 ||
+            header.magic != MAGIC || header.version != VERSION ||
+            header.docPk != static_cast<AZ::u32>(docPk))
+        {
+            fprintf(stderr, "[HCPPbmWriter] snapshot header mismatch: %s\n", path.c_str());
+            fflush(stderr);
+            fclose(f);
+            return;
+        }
+
+        AZStd::vector<PosRecord> posRecords;
+        AZStd::vector<AZ::u32> posInts;
+        posRecords.reserve(starterPositions.size());
+        for (const auto& [tokenId, posList] : starterPositions)
+        {
+            PosRecord pr;
+            PutToken(pr.tokenId, tokenId);
+            pr.first = static_cast<AZ::u32>(posInts.size());
+            pr.count = static_cast<AZ::u32>(posList.size());
+            posRecords.push_back(pr);
+            for (int p : posList)
+                posInts.push_back(static_cast<AZ::u32>(p));
+        }
+
+        // Position sections start right after the bonds — independent of any
+        // previously appended counts, so a re-store overwrites in place.
+        size_t bondEnd = PosTableOffset(header) - header.posRecCount * sizeof(PosRecord);
+
+        header.posRecCount = static_cast<AZ::u32>(posRecords.size());
+        header.posIntCount = static_cast<AZ::u32>(posInts.size());
+        header.allCapsCount = static_cast<AZ::u32>(allCapsPositions.size());
+        header.totalSlots = static_cast<AZ::u32>(totalSlots);
+
+        bool ok = fseek(f, static_cast<long>(bondEnd), SEEK_SET) == 0;
+        if (ok && !posRecords.empty())
+            ok = fwrite(posRecords.data(), sizeof(PosRecord), posRecords.size(), f) == posRecords.size();
+        if (ok && !posInts.empty())
+            ok = fwrite(posInts.data(), sizeof(AZ::u32), posInts.size(), f) == posInts.size();
+        if (ok)
+        {
+            for (int p : allCapsPositions)
+            {
+                AZ::u32 v = static_cast<AZ::u32>(p);
+                if (fwrite(&v, sizeof(v), 1, f) != 1) { ok = false; break; }
+            }
+        }
+        if (ok)
+            ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, f) == 1;
+        if (ok)
+        {
+            fflush(f);
+            ftruncate(fileno(f), static_cast<off_t>(TotalBytes(header)));
+        }
+        fclose(f);
+
+        if (!ok)
+        {
+            fprintf(stderr, "[HCPPbmWriter] snapshot position append failed: %s\n", path.c_str());
+            fflush(stderr);
+            remove(path.c_str());
+            return;
+        }
+
+        fprintf(stderr, "[HCPPbmWriter] snapshot positions: %s — %u starters, %u ints\n",
+            docId.c_str(), header.posRecCount, header.posIntCount);
+        fflush(stderr);
+    }
+
     AZStd::string HCPPbmWriter::StorePBM(
         const AZStd::string& docName,
         const AZStd::string& centuryCode,
@@ -93,11 +408,17 @@ namespace HCPEngine
 
         if (ok)
         {
+            QueryCache::BumpGeneration();
             fprintf(stderr, "[HCPPbmWriter] StorePBM: '%s' -> %s — %zu starters, "
                 "%zu word, %zu char, %zu marker, %zu var bonds\n",
                 docName.c_str(), docId.c_str(), summary.starters,
                 summary.wordBonds, summary.charBonds, summary.markerBonds, summary.varBonds);
             fflush(stderr);
+
+            if (PbmSnapshot::Enabled())
+            {
+                EmitSnapshot(pg, docId, docPk, pbmData);
+            }
         }
         else
         {
@@ -177,6 +498,7 @@ namespace HCPEngine
         }
 
         m_lastDocPk = docPk;
+        QueryCache::BumpGeneration();
         fprintf(stderr, "[HCPPbmWriter] CreateDocumentStub: '%s' pk=%d\n",
             docName.c_str(), docPk);
         fflush(stderr);
@@ -244,103 +566,837 @@ namespace HCPEngine
 
         if (ok)
         {
+            QueryCache::BumpGeneration();
+            TextCache::Invalidate(docId);   // re-ingest: cached text is the old edition
             fprintf(stderr, "[HCPPbmWriter] FillPBMData: %s (pk=%d) — %zu starters, "
                 "%zu word, %zu char, %zu marker, %zu var bonds\n",
                 docId.c_str(), existingDocPk, summary.starters,
                 summary.wordBonds, summary.charBonds, summary.markerBonds, summary.varBonds);
             fflush(stderr);
+
+            if (PbmSnapshot::Enabled())
+            {
+                EmitSnapshot(pg, docId, existingDocPk, pbmData);
+            }
+        }
+        else
+        {
+            fprintf(stderr, "[HCPPbmWriter] FillPBMData: COMMIT failed: %s\n",
+                PQerrorMessage(pg));
+            fflush(stderr);
+            return {};
+        }
+
+        return docId;
+    }
+
+    bool HCPPbmWriter::UseIncrementalPath()
+    {
+        // Default ON; HCP_PBM_INCREMENTAL=0 restores full rewrites on re-ingest.
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_PBM_INCREMENTAL");
+            return !(v && v[0] == '0');
+        }();
+        return enabled;
+    }
+
+    PBMDelta HCPPbmWriter::DiffPBM(const PBMData& oldData, const PBMData& newData)
+    {
+        PBMDelta delta;
+
+        TokenInterner interner;
+        AZStd::unordered_map<AZStd::pair<TokenHandle, TokenHandle>, size_t, TokenPairHash> oldIndex;
+        oldIndex.reserve(oldData.bonds.size());
+        for (size_t i = 0; i < oldData.bonds.size(); ++i)
+        {
+            oldIndex[{ interner.Intern(oldData.bonds[i].tokenA),
+                       interner.Intern(oldData.bonds[i].tokenB) }] = i;
+        }
+
+        AZStd::vector<char> matched(oldData.bonds.size(), 0);
+        for (const auto& bond : newData.bonds)
+        {
+            auto it = oldIndex.find({ interner.Intern(bond.tokenA),
+                                      interner.Intern(bond.tokenB) });
+            if (it == oldIndex.end())
+            {
+                delta.changed.push_back(bond);
+                continue;
+            }
+            matched[it->second] = 1;
+            if (oldData.bonds[it->second].count != bond.count)
+                delta.changed.push_back(bond);
+            else
+                ++delta.unchanged;
+        }
+
+        for (size_t i = 0; i < oldData.bonds.size(); ++i)
+            if (!matched[i]) delta.removed.push_back(oldData.bonds[i]);
+
+        return delta;
+    }
+
+    AZStd::string HCPPbmWriter::UpdatePBMDelta(int existingDocPk, const PBMData& newData,
+        const PBMData& oldData)
+    {
+        PGconn* pg = m_conn.Get();
+        if (!pg)
+        {
+            AZLOG_ERROR("HCPPbmWriter: Not connected");
+            return {};
+        }
+
+        if (newData.bonds.empty())
+        {
+            AZLOG_ERROR("HCPPbmWriter: UpdatePBMDelta: empty PBM data");
+            return {};
+        }
+
+        PBMDelta delta = DiffPBM(oldData, newData);
+
+        PQexec(pg, "BEGIN");
+
+        AZStd::string docPkStr = AZStd::to_string(existingDocPk);
+
+        // Fetch doc_id string for this row
+        AZStd::string docId;
+        {
+            const char* params[] = { docPkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT doc_id FROM pbm_documents WHERE id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                docId = PQgetvalue(res, 0, 0);
+            PQclear(res);
+        }
+
+        if (docId.empty())
+        {
+            fprintf(stderr, "[HCPPbmWriter] UpdatePBMDelta: pk=%d not found\n", existingDocPk);
+            fflush(stderr);
+            PQexec(pg, "ROLLBACK");
+            return {};
+        }
+
+        m_lastDocPk = existingDocPk;
+
+        if (delta.changed.empty() && delta.removed.empty())
+        {
+            PQexec(pg, "COMMIT");
+            fprintf(stderr, "[HCPPbmWriter] UpdatePBMDelta: %s (pk=%d) — no bond changes "
+                "(%zu unchanged)\n", docId.c_str(), existingDocPk, delta.unchanged);
+            fflush(stderr);
+            return docId;
+        }
+
+        // Re-stamp crystallization seeds (the first pair may have moved)
+        {
+            const char* params[] = {
+                newData.firstFpbA.c_str(), newData.firstFpbB.c_str(), docPkStr.c_str()
+            };
+            PGresult* res = PQexecParams(pg,
+                "UPDATE pbm_documents SET first_fpb_a = $1, first_fpb_b = $2 "
+                "WHERE id = $3::integer",
+                3, nullptr, params, nullptr, nullptr, 0);
+            PQclear(res);
+        }
+
+        // Existing docvars: surface → decimal var_id
+        AZStd::unordered_map<AZStd::string, AZStd::string> surfaceToVarId;
+        int nextDecimal = 0;
+        {
+            const char* params[] = { docPkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT var_id, surface FROM pbm_docvars WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK)
+            {
+                for (int i = 0; i < PQntuples(res); ++i)
+                {
+                    const char* vid = PQgetvalue(res, i, 0);
+                    surfaceToVarId[PQgetvalue(res, i, 1)] = vid;
+                    const int decimal = atoi(vid) * 100 + atoi(strchr(vid, '.') + 1);
+                    if (decimal >= nextDecimal) nextDecimal = decimal + 1;
+                }
+            }
+            PQclear(res);
+        }
+
+        // Decimal var_id for a var token, minting a docvar row on first sight.
+        // Returns empty on mint failure.
+        auto varIdFor = [&](const AZStd::string& token) -> AZStd::string
+        {
+            AZStd::string surface = VarSurface(token);
+            auto it = surfaceToVarId.find(surface);
+            if (it != surfaceToVarId.end()) return it->second;
+
+            char varIdBuf[8];
+            snprintf(varIdBuf, sizeof(varIdBuf), "%02d.%02d",
+                nextDecimal / 100, nextDecimal % 100);
+            ++nextDecimal;
+
+            const char* category = ClassifyVar(surface);
+            const char* insParams[] = { docPkStr.c_str(), varIdBuf, surface.c_str(), category };
+            PGresult* res = PQexecParams(pg,
+                "INSERT INTO pbm_docvars (doc_id, var_id, surface, var_category) "
+                "VALUES ($1::integer, $2, $3, $4)",
+                4, nullptr, insParams, nullptr, nullptr, 0);
+            const bool ok = (PQresultStatus(res) == PGRES_COMMAND_OK);
+            PQclear(res);
+            if (!ok)
+            {
+                fprintf(stderr, "[HCPPbmWriter] UpdatePBMDelta: docvar INSERT failed for '%s': %s\n",
+                    surface.c_str(), PQerrorMessage(pg));
+                fflush(stderr);
+                return {};
+            }
+            surfaceToVarId[surface] = varIdBuf;
+            return AZStd::string(varIdBuf);
+        };
+
+        // Split an A-side token into starter columns (vars → 00.00.00.NN.MM).
+        auto starterParts = [&](const AZStd::string& tokenA, AZStd::string parts[5]) -> bool
+        {
+            if (IsVarToken(tokenA))
+            {
+                AZStd::string vid = varIdFor(tokenA);
+                if (vid.empty()) return false;
+                size_t dot = vid.find('.');
+                parts[0] = "00"; parts[1] = "00"; parts[2] = "00";
+                parts[3] = AZStd::string(vid.data(), dot);
+                parts[4] = AZStd::string(vid.data() + dot + 1, vid.size() - dot - 1);
+                return true;
+            }
+            SplitTokenId(tokenA, parts);
+            return true;
+        };
+
+        // Starter id per A-side token; created on demand for new starters,
+        // looked up only (createMissing=false) when servicing removals.
+        AZStd::unordered_map<AZStd::string, int> starterIds;
+        auto starterIdFor = [&](const AZStd::string& tokenA, bool createMissing) -> int
+        {
+            auto cached = starterIds.find(tokenA);
+            if (cached != starterIds.end()) return cached->second;
+
+            AZStd::string parts[5];
+            if (!starterParts(tokenA, parts)) return 0;
+
+            const char* params[] = {
+                docPkStr.c_str(),
+                parts[0].c_str(), parts[1].c_str(), parts[2].c_str(),
+                parts[3].c_str(), parts[4].c_str()
+            };
+            int id = 0;
+            PGresult* res = PQexecParams(pg,
+                "SELECT id FROM pbm_starters WHERE doc_id = $1::integer "
+                "AND a_ns = $2 AND a_p2 = $3 AND a_p3 = $4 AND a_p4 = $5 AND a_p5 = $6",
+                6, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                id = atoi(PQgetvalue(res, 0, 0));
+            PQclear(res);
+
+            if (id == 0 && createMissing)
+            {
+                res = PQexecParams(pg,
+                    "INSERT INTO pbm_starters (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5) "
+                    "VALUES ($1::integer, $2, $3, $4, $5, $6) "
+                    "RETURNING id",
+                    6, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                    id = atoi(PQgetvalue(res, 0, 0));
+                else
+                {
+                    fprintf(stderr, "[HCPPbmWriter] UpdatePBMDelta: insert starter failed for '%s': %s\n",
+                        tokenA.c_str(), PQerrorMessage(pg));
+                    fflush(stderr);
+                }
+                PQclear(res);
+            }
+
+            if (id != 0) starterIds[tokenA] = id;
+            return id;
+        };
+
+        // Changed bonds: overwrite counts (absolute, not accumulated — the
+        // re-scan's count is the document's truth).
+        size_t applied = 0;
+        for (const auto& bond : delta.changed)
+        {
+            const int starterId = starterIdFor(bond.tokenA, true);
+            if (starterId == 0) continue;
+
+            AZStd::string starterIdStr = AZStd::to_string(starterId);
+            AZStd::string countStr = AZStd::to_string(bond.count);
+
+            if (IsVarToken(bond.tokenB))
+            {
+                AZStd::string vid = varIdFor(bond.tokenB);
+                if (vid.empty()) continue;
+                const char* params[] = { starterIdStr.c_str(), vid.c_str(), countStr.c_str() };
+                PGresult* res = PQexecParams(pg,
+                    "INSERT INTO pbm_var_bonds (starter_id, b_var_id, count) "
+                    "VALUES ($1::integer, $2, $3::integer) "
+                    "ON CONFLICT (starter_id, b_var_id) "
+                    "DO UPDATE SET count = EXCLUDED.count",
+                    3, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++applied;
+                PQclear(res);
+                continue;
+            }
+
+            AZStd::string bParts[5];
+            SplitTokenId(bond.tokenB, bParts);
+
+            if (bParts[0] == "AB" && bParts[1] == "AB")
+            {
+                const char* params[] = {
+                    starterIdStr.c_str(),
+                    bParts[2].c_str(), bParts[3].c_str(), bParts[4].c_str(),
+                    countStr.c_str()
+                };
+                PGresult* res = PQexecParams(pg,
+                    "INSERT INTO pbm_word_bonds (starter_id, b_p3, b_p4, b_p5, count) "
+                    "VALUES ($1::integer, $2, $3, $4, $5::integer) "
+                    "ON CONFLICT (starter_id, b_p3, b_p4, b_p5) "
+                    "DO UPDATE SET count = EXCLUDED.count",
+                    5, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++applied;
+                PQclear(res);
+            }
+            else if (bParts[0] == "AA" && bParts[1] != "AE")
+            {
+                const char* params[] = {
+                    starterIdStr.c_str(),
+                    bParts[1].c_str(), bParts[2].c_str(), bParts[3].c_str(), bParts[4].c_str(),
+                    countStr.c_str()
+                };
+                PGresult* res = PQexecParams(pg,
+                    "INSERT INTO pbm_char_bonds (starter_id, b_p2, b_p3, b_p4, b_p5, count) "
+                    "VALUES ($1::integer, $2, $3, $4, $5, $6::integer) "
+                    "ON CONFLICT (starter_id, b_p2, b_p3, b_p4, b_p5) "
+                    "DO UPDATE SET count = EXCLUDED.count",
+                    6, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++applied;
+                PQclear(res);
+            }
+            else if (bParts[0] == "AA" && bParts[1] == "AE" && bParts[4].empty())
+            {
+                const char* params[] = {
+                    starterIdStr.c_str(),
+                    bParts[2].c_str(), bParts[3].c_str(),
+                    countStr.c_str()
+                };
+                PGresult* res = PQexecParams(pg,
+                    "INSERT INTO pbm_marker_bonds (starter_id, b_p3, b_p4, count) "
+                    "VALUES ($1::integer, $2, $3, $4::integer) "
+                    "ON CONFLICT (starter_id, b_p3, b_p4) "
+                    "DO UPDATE SET count = EXCLUDED.count",
+                    4, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++applied;
+                PQclear(res);
+            }
+        }
+
+        // Removed bonds: delete the specific subtable rows.
+        size_t deleted = 0;
+        for (const auto& bond : delta.removed)
+        {
+            const int starterId = starterIdFor(bond.tokenA, false);
+            if (starterId == 0) continue;   // starter already gone
+
+            AZStd::string starterIdStr = AZStd::to_string(starterId);
+
+            if (IsVarToken(bond.tokenB))
+            {
+                auto it = surfaceToVarId.find(VarSurface(bond.tokenB));
+                if (it == surfaceToVarId.end()) continue;
+                const char* params[] = { starterIdStr.c_str(), it->second.c_str() };
+                PGresult* res = PQexecParams(pg,
+                    "DELETE FROM pbm_var_bonds WHERE starter_id = $1::integer AND b_var_id = $2",
+                    2, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++deleted;
+                PQclear(res);
+                continue;
+            }
+
+            AZStd::string bParts[5];
+            SplitTokenId(bond.tokenB, bParts);
+
+            if (bParts[0] == "AB" && bParts[1] == "AB")
+            {
+                const char* params[] = {
+                    starterIdStr.c_str(), bParts[2].c_str(), bParts[3].c_str(), bParts[4].c_str()
+                };
+                PGresult* res = PQexecParams(pg,
+                    "DELETE FROM pbm_word_bonds WHERE starter_id = $1::integer "
+                    "AND b_p3 = $2 AND b_p4 = $3 AND b_p5 = $4",
+                    4, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++deleted;
+                PQclear(res);
+            }
+            else if (bParts[0] == "AA" && bParts[1] != "AE")
+            {
+                const char* params[] = {
+                    starterIdStr.c_str(),
+                    bParts[1].c_str(), bParts[2].c_str(), bParts[3].c_str(), bParts[4].c_str()
+                };
+                PGresult* res = PQexecParams(pg,
+                    "DELETE FROM pbm_char_bonds WHERE starter_id = $1::integer "
+                    "AND b_p2 = $2 AND b_p3 = $3 AND b_p4 = $4 AND b_p5 = $5",
+                    5, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++deleted;
+                PQclear(res);
+            }
+            else if (bParts[0] == "AA" && bParts[1] == "AE" && bParts[4].empty())
+            {
+                const char* params[] = {
+                    starterIdStr.c_str(), bParts[2].c_str(), bParts[3].c_str()
+                };
+                PGresult* res = PQexecParams(pg,
+                    "DELETE FROM pbm_marker_bonds WHERE starter_id = $1::integer "
+                    "AND b_p3 = $2 AND b_p4 = $3",
+                    3, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++deleted;
+                PQclear(res);
+            }
+        }
+
+        // Starters whose token left the document entirely (every token still in
+        // the document appears on some bond side). Their bond rows were deleted
+        // above; the row carries the stale positions array, so it goes too.
+        size_t droppedStarters = 0;
+        {
+            TokenInterner interner;
+            AZStd::unordered_set<TokenHandle> newTokens;
+            for (const auto& bond : newData.bonds)
+            {
+                newTokens.insert(interner.Intern(bond.tokenA));
+                newTokens.insert(interner.Intern(bond.tokenB));
+            }
+
+            AZStd::unordered_set<AZStd::string> droppedA;
+            for (const auto& bond : delta.removed)
+            {
+                if (newTokens.count(interner.Intern(bond.tokenA)) ||
+                    !droppedA.insert(bond.tokenA).second)
+                    continue;
+
+                AZStd::string parts[5];
+                if (!starterParts(bond.tokenA, parts)) continue;
+                const char* params[] = {
+                    docPkStr.c_str(),
+                    parts[0].c_str(), parts[1].c_str(), parts[2].c_str(),
+                    parts[3].c_str(), parts[4].c_str()
+                };
+                PGresult* res = PQexecParams(pg,
+                    "DELETE FROM pbm_starters WHERE doc_id = $1::integer "
+                    "AND a_ns = $2 AND a_p2 = $3 AND a_p3 = $4 AND a_p4 = $5 AND a_p5 = $6",
+                    6, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_COMMAND_OK) ++droppedStarters;
+                PQclear(res);
+            }
+        }
+
+        PGresult* commitRes = PQexec(pg, "COMMIT");
+        bool ok = (PQresultStatus(commitRes) == PGRES_COMMAND_OK);
+        PQclear(commitRes);
+
+        if (!ok)
+        {
+            fprintf(stderr, "[HCPPbmWriter] UpdatePBMDelta: COMMIT failed: %s\n",
+                PQerrorMessage(pg));
+            fflush(stderr);
+            return {};
+        }
+
+        QueryCache::BumpGeneration();
+        TextCache::Invalidate(docId);   // re-ingest: cached text is the old edition
+        fprintf(stderr, "[HCPPbmWriter] UpdatePBMDelta: %s (pk=%d) — %zu changed, %zu removed, "
+            "%zu starters dropped, %zu unchanged\n",
+            docId.c_str(), existingDocPk, applied, deleted, droppedStarters, delta.unchanged);
+        fflush(stderr);
+
+        // The snapshot side file has no delta form — regenerate it whole.
+        if (PbmSnapshot::Enabled())
+        {
+            EmitSnapshot(pg, docId, existingDocPk, newData);
+        }
+
+        return docId;
+    }
+
+    HCPPbmWriter::BondWriteSummary HCPPbmWriter::WritePBMBonds(
+        PGconn* pg, int docPk, const PBMData& pbmData)
+    {
+        return UseCopyPath()
+            ? WritePBMBondsBulk(pg, docPk, pbmData)
+            : WritePBMBondsRows(pg, docPk, pbmData);
+    }
+
+    // ---- WritePBMBondsBulk: COPY-based bulk write ----
+    //
+    // The row-at-a-time path is tens of thousands of round trips for a novel —
+    // the ingest bottleneck now that settle is fast. Bulk path per document:
+    //
+    //   1. Docvars: one MAX + one SELECT of existing rows, mint client-side,
+    //      one COPY of the new rows.
+    //   2. Starters: COPY into a temp table, one INSERT ... ON CONFLICT DO
+    //      NOTHING merge, one SELECT to map (a_ns..a_p5) → starter id.
+    //   3. Bond subtables: counts pre-aggregated client-side (what ON CONFLICT
+    //      DO UPDATE did per-row), then COPY + single-statement merge each.
+    //
+    // Upsert semantics match the row path; temp tables are ON COMMIT DROP so
+    // everything stays inside the caller's transaction.
+    HCPPbmWriter::BondWriteSummary HCPPbmWriter::WritePBMBondsBulk(
+        PGconn* pg, int docPk, const PBMData& pbmData)
+    {
+        using namespace PbmWriter_Detail;
+
+        BondWriteSummary summary;
+        AZStd::string docPkStr = AZStd::to_string(docPk);
+
+        // ---- 1. Document-local vars ----
+        AZStd::unordered_map<AZStd::string, AZStd::string> varToDecimal;
+        {
+            int nextDecimal = 0;
+            {
+                const char* params[] = { docPkStr.c_str() };
+                PGresult* res = PQexecParams(pg,
+                    "SELECT COALESCE(MAX("
+                    "  CAST(SPLIT_PART(var_id, '.', 1) AS INTEGER) * 100 + "
+                    "  CAST(SPLIT_PART(var_id, '.', 2) AS INTEGER)"
+                    "), -1) FROM pbm_docvars WHERE doc_id = $1",
+                    1, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                    nextDecimal = atoi(PQgetvalue(res, 0, 0)) + 1;
+                PQclear(res);
+            }
+
+            // Existing docvars in one query (the row path probed per surface)
+            AZStd::unordered_map<AZStd::string, AZStd::string> surfaceSeen;
+            {
+                const char* params[] = { docPkStr.c_str() };
+                PGresult* res = PQexecParams(pg,
+                    "SELECT var_id, surface FROM pbm_docvars WHERE doc_id = $1",
+                    1, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_TUPLES_OK)
+                {
+                    for (int i = 0; i < PQntuples(res); ++i)
+                        surfaceSeen[PQgetvalue(res, i, 1)] = PQgetvalue(res, i, 0);
+                }
+                PQclear(res);
+            }
+
+            AZStd::string docvarRows;
+            for (const auto& bond : pbmData.bonds)
+            {
+                for (const AZStd::string* tok : { &bond.tokenA, &bond.tokenB })
+                {
+                    if (!IsVarToken(*tok) || varToDecimal.count(*tok))
+                        continue;
+
+                    AZStd::string surface = VarSurface(*tok);
+                    auto it = surfaceSeen.find(surface);
+                    if (it != surfaceSeen.end())
+                    {
+                        varToDecimal[*tok] = it->second;
+                        continue;
+                    }
+
+                    char varIdBuf[8];
+                    snprintf(varIdBuf, sizeof(varIdBuf), "%02d.%02d",
+                        nextDecimal / 100, nextDecimal % 100);
+                    AZStd::string varId(varIdBuf);
+                    ++nextDecimal;
+
+                    docvarRows += docPkStr;
+                    docvarRows += '\t';
+                    docvarRows += varId;
+                    docvarRows += '\t';
+                    AppendCopyField(docvarRows, surface);
+                    docvarRows += '\t';
+                    docvarRows += ClassifyVar(surface);
+                    docvarRows += '\n';
+
+                    varToDecimal[*tok] = varId;
+                    surfaceSeen[surface] = varId;
+                }
+            }
+
+            if (!docvarRows.empty())
+            {
+                RunCopy(pg,
+                    "COPY pbm_docvars (doc_id, var_id, surface, var_category) FROM STDIN",
+                    docvarRows, "pbm_docvars");
+            }
+        }
+
+        if (!varToDecimal.empty())
+        {
+            fprintf(stderr, "[HCPPbmWriter] WritePBMBondsBulk: minted %zu document-local vars\n",
+                varToDecimal.size());
+            fflush(stderr);
+        }
+
+        // ---- 2. Starters ----
+        // Group bonds by A-side token and compute each starter's split parts.
+        AZStd::unordered_map<AZStd::string, AZStd::vector<const Bond*>> bondsByA;
+        for (const auto& bond : pbmData.bonds)
+            bondsByA[bond.tokenA].push_back(&bond);
+
+        auto splitStarter = [&](const AZStd::string& tokenA, AZStd::string parts[5])
+        {
+            auto varIt = varToDecimal.find(tokenA);
+            if (varIt != varToDecimal.end())
+            {
+                const AZStd::string& vid = varIt->second;
+                size_t dot = vid.find('.');
+                parts[0] = "00"; parts[1] = "00"; parts[2] = "00";
+                parts[3] = AZStd::string(vid.data(), dot);
+                parts[4] = AZStd::string(vid.data() + dot + 1, vid.size() - dot - 1);
+            }
+            else
+            {
+                SplitTokenId(tokenA, parts);
+            }
+        };
+
+        auto starterKey = [](const AZStd::string parts[5])
+        {
+            AZStd::string key = parts[0];
+            for (int i = 1; i < 5; ++i) { key += '.'; key += parts[i]; }
+            return key;
+        };
+
+        {
+            AZStd::string starterRows;
+            for (const auto& [tokenA, bonds] : bondsByA)
+            {
+                AZStd::string parts[5];
+                splitStarter(tokenA, parts);
+                starterRows += docPkStr;
+                for (int i = 0; i < 5; ++i)
+                {
+                    starterRows += '\t';
+                    AppendCopyField(starterRows, parts[i]);
+                }
+                starterRows += '\n';
+            }
+
+            if (!RunCommand(pg,
+                    "CREATE TEMP TABLE tmp_pbm_starters "
+                    "(doc_id integer, a_ns text, a_p2 text, a_p3 text, a_p4 text, a_p5 text) "
+                    "ON COMMIT DROP",
+                    "CREATE TEMP tmp_pbm_starters") ||
+                !RunCopy(pg, "COPY tmp_pbm_starters FROM STDIN", starterRows, "pbm_starters") ||
+                !RunCommand(pg,
+                    "INSERT INTO pbm_starters (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5) "
+                    "SELECT doc_id, a_ns, a_p2, a_p3, a_p4, a_p5 FROM tmp_pbm_starters "
+                    "ON CONFLICT (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5) DO NOTHING",
+                    "starter merge"))
+            {
+                return summary;
+            }
+        }
+
+        // Map (a_ns..a_p5) → starter id in one round trip
+        AZStd::unordered_map<AZStd::string, int> starterIds;
+        {
+            const char* params[] = { docPkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT id, a_ns, a_p2, a_p3, a_p4, a_p5 FROM pbm_starters WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK)
+            {
+                for (int i = 0; i < PQntuples(res); ++i)
+                {
+                    AZStd::string key = PQgetvalue(res, i, 1);
+                    for (int f = 2; f <= 5; ++f) { key += '.'; key += PQgetvalue(res, i, f); }
+                    starterIds[key] = atoi(PQgetvalue(res, i, 0));
+                }
+            }
+            PQclear(res);
+        }
+
+        // ---- 3. Bond subtables ----
+        // Pre-aggregate counts per key: this is what the per-row ON CONFLICT
+        // DO UPDATE accumulation did, moved client-side (and it keeps the merge
+        // statement free of same-statement double-update errors).
+        AZStd::unordered_map<AZStd::string, int> wordAgg, charAgg, markerAgg, varAgg;
+
+        for (const auto& [tokenA, bonds] : bondsByA)
+        {
+            AZStd::string parts[5];
+            splitStarter(tokenA, parts);
+            auto idIt = starterIds.find(starterKey(parts));
+            if (idIt == starterIds.end())
+            {
+                fprintf(stderr, "[HCPPbmWriter] bulk: no starter id for '%s'\n", tokenA.c_str());
+                fflush(stderr);
+                continue;
+            }
+            ++summary.starters;
+            AZStd::string idStr = AZStd::to_string(idIt->second);
+
+            for (const Bond* bond : bonds)
+            {
+                auto varIt = varToDecimal.find(bond->tokenB);
+                if (varIt != varToDecimal.end())
+                {
+                    varAgg[idStr + "\t" + varIt->second] += bond->count;
+                    continue;
+                }
+
+                AZStd::string bParts[5];
+                SplitTokenId(bond->tokenB, bParts);
+
+                if (bParts[0] == "AB" && bParts[1] == "AB")
+                {
+                    wordAgg[idStr + "\t" + bParts[2] + "\t" + bParts[3] + "\t" + bParts[4]]
+                        += bond->count;
+                }
+                else if (bParts[0] == "AA" && bParts[1] != "AE")
+                {
+                    charAgg[idStr + "\t" + bParts[1] + "\t" + bParts[2] + "\t" + bParts[3]
+                        + "\t" + bParts[4]] += bond->count;
+                }
+                else if (bParts[0] == "AA" && bParts[1] == "AE" && bParts[4].empty())
+                {
+                    markerAgg[idStr + "\t" + bParts[2] + "\t" + bParts[3]] += bond->count;
+                }
+            }
         }
-        else
+
+        // Subtable merge: temp COPY + one upsert statement each. Key fields are
+        // pair codes / decimal ids — no characters needing COPY escapes.
+        auto mergeSubtable = [&](const AZStd::unordered_map<AZStd::string, int>& agg,
+                                 const char* createSql, const char* copySql,
+                                 const char* mergeSql, const char* label, size_t& counter)
         {
-            fprintf(stderr, "[HCPPbmWriter] FillPBMData: COMMIT failed: %s\n",
-                PQerrorMessage(pg));
-            fflush(stderr);
-            return {};
-        }
+            if (agg.empty()) return;
 
-        return docId;
+            AZStd::string rows;
+            for (const auto& [key, count] : agg)
+            {
+                rows += key;
+                rows += '\t';
+                rows += AZStd::to_string(count);
+                rows += '\n';
+            }
+
+            if (RunCommand(pg, createSql, label) &&
+                RunCopy(pg, copySql, rows, label) &&
+                RunCommand(pg, mergeSql, label))
+            {
+                counter = agg.size();
+            }
+        };
+
+        mergeSubtable(wordAgg,
+            "CREATE TEMP TABLE tmp_pbm_word_bonds "
+            "(starter_id integer, b_p3 text, b_p4 text, b_p5 text, count integer) "
+            "ON COMMIT DROP",
+            "COPY tmp_pbm_word_bonds FROM STDIN",
+            "INSERT INTO pbm_word_bonds (starter_id, b_p3, b_p4, b_p5, count) "
+            "SELECT starter_id, b_p3, b_p4, b_p5, count FROM tmp_pbm_word_bonds "
+            "ON CONFLICT (starter_id, b_p3, b_p4, b_p5) "
+            "DO UPDATE SET count = pbm_word_bonds.count + EXCLUDED.count",
+            "pbm_word_bonds", summary.wordBonds);
+
+        mergeSubtable(charAgg,
+            "CREATE TEMP TABLE tmp_pbm_char_bonds "
+            "(starter_id integer, b_p2 text, b_p3 text, b_p4 text, b_p5 text, count integer) "
+            "ON COMMIT DROP",
+            "COPY tmp_pbm_char_bonds FROM STDIN",
+            "INSERT INTO pbm_char_bonds (starter_id, b_p2, b_p3, b_p4, b_p5, count) "
+            "SELECT starter_id, b_p2, b_p3, b_p4, b_p5, count FROM tmp_pbm_char_bonds "
+            "ON CONFLICT (starter_id, b_p2, b_p3, b_p4, b_p5) "
+            "DO UPDATE SET count = pbm_char_bonds.count + EXCLUDED.count",
+            "pbm_char_bonds", summary.charBonds);
+
+        mergeSubtable(markerAgg,
+            "CREATE TEMP TABLE tmp_pbm_marker_bonds "
+            "(starter_id integer, b_p3 text, b_p4 text, count integer) "
+            "ON COMMIT DROP",
+            "COPY tmp_pbm_marker_bonds FROM STDIN",
+            "INSERT INTO pbm_marker_bonds (starter_id, b_p3, b_p4, count) "
+            "SELECT starter_id, b_p3, b_p4, count FROM tmp_pbm_marker_bonds "
+            "ON CONFLICT (starter_id, b_p3, b_p4) "
+            "DO UPDATE SET count = pbm_marker_bonds.count + EXCLUDED.count",
+            "pbm_marker_bonds", summary.markerBonds);
+
+        mergeSubtable(varAgg,
+            "CREATE TEMP TABLE tmp_pbm_var_bonds "
+            "(starter_id integer, b_var_id text, count integer) "
+            "ON COMMIT DROP",
+            "COPY tmp_pbm_var_bonds FROM STDIN",
+            "INSERT INTO pbm_var_bonds (starter_id, b_var_id, count) "
+            "SELECT starter_id, b_var_id, count FROM tmp_pbm_var_bonds "
+            "ON CONFLICT (starter_id, b_var_id) "
+            "DO UPDATE SET count = pbm_var_bonds.count + EXCLUDED.count",
+            "pbm_var_bonds", summary.varBonds);
+
+        return summary;
     }
 
-    HCPPbmWriter::BondWriteSummary HCPPbmWriter::WritePBMBonds(
+    HCPPbmWriter::BondWriteSummary HCPPbmWriter::WritePBMBondsRows(
         PGconn* pg, int docPk, const PBMData& pbmData)
     {
         BondWriteSummary summary;
 
-        // Mint document-local vars (decimal pair IDs)
+        // Mint document-local vars (decimal pair IDs). Batched through
+        // HCPDocVarQuery: one lookup of already-minted surfaces, one set-based
+        // insert for the rest — round trips scale with documents, not vars
+        // (var-heavy documents mint thousands).
         AZStd::unordered_map<AZStd::string, AZStd::string> varToDecimal;
         {
-            int nextDecimal = 0;
-            {
-                AZStd::string pkStr = AZStd::to_string(docPk);
-                const char* params[] = { pkStr.c_str() };
-                PGresult* res = PQexecParams(pg,
-                    "SELECT COALESCE(MAX("
-                    "  CAST(SPLIT_PART(var_id, '.', 1) AS INTEGER) * 100 + "
-                    "  CAST(SPLIT_PART(var_id, '.', 2) AS INTEGER)"
-                    "), -1) FROM pbm_docvars WHERE doc_id = $1",
-                    1, nullptr, params, nullptr, nullptr, 0);
-                if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
-                    nextDecimal = atoi(PQgetvalue(res, 0, 0)) + 1;
-                PQclear(res);
-            }
-
-            AZStd::string docPkStr2 = AZStd::to_string(docPk);
-            AZStd::unordered_map<AZStd::string, AZStd::string> surfaceSeen;
+            // Unique var surfaces in first-encounter order, so assigned ids
+            // match what the old per-var loop would have minted.
+            AZStd::vector<AZStd::string> surfaces;
+            AZStd::unordered_map<AZStd::string, AZStd::vector<AZStd::string>> varTokensBySurface;
+            AZStd::unordered_set<AZStd::string> seenTokens;
             for (const auto& bond : pbmData.bonds)
             {
                 for (const AZStd::string* tok : { &bond.tokenA, &bond.tokenB })
                 {
-                    if (!IsVarToken(*tok) || varToDecimal.count(*tok))
+                    if (!IsVarToken(*tok) || !seenTokens.insert(*tok).second)
                         continue;
 
                     AZStd::string surface = VarSurface(*tok);
-                    auto it = surfaceSeen.find(surface);
-                    if (it != surfaceSeen.end())
-                    {
-                        varToDecimal[*tok] = it->second;
-                        continue;
-                    }
+                    auto [it, inserted] = varTokensBySurface.emplace(
+                        surface, AZStd::vector<AZStd::string>{});
+                    if (inserted)
+                        surfaces.push_back(surface);
+                    it->second.push_back(*tok);
+                }
+            }
 
-                    // Check existing docvar for this surface
-                    const char* checkParams[] = { docPkStr2.c_str(), surface.c_str() };
-                    PGresult* res = PQexecParams(pg,
-                        "SELECT var_id FROM pbm_docvars WHERE doc_id = $1 AND surface = $2",
-                        2, nullptr, checkParams, nullptr, nullptr, 0);
-                    if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
-                    {
-                        AZStd::string varId = PQgetvalue(res, 0, 0);
-                        varToDecimal[*tok] = varId;
-                        surfaceSeen[surface] = varId;
-                        PQclear(res);
-                        continue;
-                    }
-                    PQclear(res);
+            if (!surfaces.empty())
+            {
+                HCPDocVarQuery varQuery(m_conn);
+                auto bySurface = varQuery.GetVarIdsBySurface(docPk, surfaces);
 
-                    // Mint new decimal var_id
-                    char varIdBuf[8];
-                    snprintf(varIdBuf, sizeof(varIdBuf), "%02d.%02d",
-                        nextDecimal / 100, nextDecimal % 100);
-                    AZStd::string varId(varIdBuf);
-                    ++nextDecimal;
+                AZStd::vector<AZStd::pair<AZStd::string, AZStd::string>> toMint;
+                for (const auto& surface : surfaces)
+                    if (bySurface.find(surface) == bySurface.end())
+                        toMint.emplace_back(surface, ClassifyVar(surface));
 
-                    const char* category = ClassifyVar(surface);
-                    const char* insParams[] = { docPkStr2.c_str(), varIdBuf, surface.c_str(), category };
-                    res = PQexecParams(pg,
-                        "INSERT INTO pbm_docvars (doc_id, var_id, surface, var_category) "
-                        "VALUES ($1::integer, $2, $3, $4)",
-                        4, nullptr, insParams, nullptr, nullptr, 0);
-                    if (PQresultStatus(res) != PGRES_COMMAND_OK)
-                    {
-                        fprintf(stderr, "[HCPPbmWriter] docvar INSERT failed for '%s': %s\n",
-                            surface.c_str(), PQerrorMessage(pg));
-                        fflush(stderr);
-                    }
-                    else
-                    {
-                        varToDecimal[*tok] = varId;
-                        surfaceSeen[surface] = varId;
-                    }
-                    PQclear(res);
+                if (!toMint.empty())
+                {
+                    for (auto& [surface, varId] : varQuery.MintVars(docPk, toMint))
+                        bySurface[surface] = AZStd::move(varId);
+                }
+
+                // A surface missing here means the mint failed; its bonds fall
+                // back to the raw var token, as a failed INSERT did before.
+                for (const auto& [surface, toks] : varTokensBySurface)
+                {
+                    auto idIt = bySurface.find(surface);
+                    if (idIt == bySurface.end())
+                        continue;
+                    for (const auto& tok : toks)
+                        varToDecimal[tok] = idIt->second;
                 }
             }
         }
@@ -491,7 +1547,7 @@ namespace HCPEngine
         const AZStd::vector<AZStd::string>& tokenIds,
         const AZStd::vector<int>& positions,
         int totalSlots,
-        const AZStd::unordered_map<AZStd::string, AZStd::vector<int>>& morphemePositions)
+        const AZStd::vector<AZ::u32>& modifiers)
     {
         PGconn* pg = m_conn.Get();
         if (!pg || tokenIds.size() != positions.size())
@@ -553,7 +1609,18 @@ namespace HCPEngine
             return s;
         };
 
-        for (const auto& [tokenId, posList] : tokenPositions)
+        const bool bulk = UseCopyPath();
+        AZStd::string copyRows;   // staged COPY payload (bulk path)
+        size_t staged = 0;
+
+        // Resolved (starter token id, positions) pairs for the mmap snapshot.
+        AZStd::vector<AZStd::pair<AZStd::string, AZStd::vector<int>>> snapPositions;
+        if (PbmSnapshot::Enabled())
+        {
+            snapPositions.reserve(tokenPositions.size());
+        }
+
+        for (auto& [tokenId, posList] : tokenPositions)
         {
             if (posList.empty()) continue;
 
@@ -587,17 +1654,46 @@ namespace HCPEngine
             AZStd::string aParts[5];
             SplitTokenId(starterTokenId, aParts);
 
-            // One row per (doc, token). Positions live as INTEGER[] on the row.
-            AZStd::string posArr = buildIntArray(posList);
+            // One row per (doc, token). Positions live as delta-encoded
+            // varints in positions_packed (migration 052) — Pack also sorts
+            // the list ascending, which the snapshot wants anyway. The
+            // legacy INTEGER[] column is cleared on upsert so a re-ingest
+            // never leaves the two representations disagreeing.
+            AZStd::string packed = PosPack::Pack(posList);
+
+            if (PbmSnapshot::Enabled())
+            {
+                snapPositions.emplace_back(starterTokenId, posList);
+            }
+
+            if (bulk)
+            {
+                // Stage for one COPY + merge after the loop. The bytea hex
+                // literal goes through as text — Postgres parses it on the
+                // merge insert.
+                copyRows += docPkStr;
+                for (int f = 0; f < 5; ++f)
+                {
+                    copyRows += '\t';
+                    PbmWriter_Detail::AppendCopyField(copyRows, aParts[f]);
+                }
+                copyRows += '\t';
+                copyRows += PosPack::BytesToHex(packed, /*copyMode=*/true);
+                copyRows += '\n';
+                ++staged;
+                continue;
+            }
+
+            AZStd::string packedHex = PosPack::BytesToHex(packed, /*copyMode=*/false);
             const char* params[] = { docPkStr.c_str(),
                                      aParts[0].c_str(), aParts[1].c_str(), aParts[2].c_str(),
                                      aParts[3].c_str(), aParts[4].c_str(),
-                                     posArr.c_str() };
+                                     packedHex.c_str() };
             PGresult* res = PQexecParams(pg,
-                "INSERT INTO pbm_starters (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5, positions) "
-                "VALUES ($1::integer, $2, $3, $4, $5, $6, $7::integer[]) "
+                "INSERT INTO pbm_starters (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5, positions_packed) "
+                "VALUES ($1::integer, $2, $3, $4, $5, $6, $7::bytea) "
                 "ON CONFLICT (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5) "
-                "DO UPDATE SET positions = EXCLUDED.positions",
+                "DO UPDATE SET positions_packed = EXCLUDED.positions_packed, positions = '{}'",
                 7, nullptr, params, nullptr, nullptr, 0);
             if (PQresultStatus(res) == PGRES_COMMAND_OK)
                 ++updated;
@@ -607,15 +1703,285 @@ namespace HCPEngine
             PQclear(res);
         }
 
+        if (bulk && staged > 0)
+        {
+            using namespace PbmWriter_Detail;
+            if (RunCommand(pg,
+                    "CREATE TEMP TABLE tmp_pbm_positions "
+                    "(doc_id integer, a_ns text, a_p2 text, a_p3 text, a_p4 text, a_p5 text, "
+                    "positions_packed bytea) ON COMMIT DROP",
+                    "CREATE TEMP tmp_pbm_positions") &&
+                RunCopy(pg, "COPY tmp_pbm_positions FROM STDIN", copyRows, "positions") &&
+                RunCommand(pg,
+                    "INSERT INTO pbm_starters (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5, positions_packed) "
+                    "SELECT doc_id, a_ns, a_p2, a_p3, a_p4, a_p5, positions_packed FROM tmp_pbm_positions "
+                    "ON CONFLICT (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5) "
+                    "DO UPDATE SET positions_packed = EXCLUDED.positions_packed, positions = '{}'",
+                    "positions merge"))
+            {
+                updated = staged;
+            }
+        }
+
         // Caps: only ALL_CAPS needs storage (nominal — author override).
         // FIRST_CAP is positional/derivable: capitalize-next after . ? ! \n + Label
         // tokens carry intrinsic caps in entries.word. Other morpheme bits are no
-        // longer written — every form is its own token.
-        // Possessives: future work.
-        auto capIt = morphemePositions.find("ALL_CAPS");
-        if (capIt != morphemePositions.end() && !capIt->second.empty())
+        // longer written — every form is its own token. Possessives: future work.
+        // ALL_CAPS comes straight off the packed modifier column (bit 1).
+        AZStd::vector<int> allCapsPositions;
+        if (modifiers.size() == positions.size())
+        {
+            for (size_t i = 0; i < modifiers.size(); ++i)
+                if (modifiers[i] & 2u) allCapsPositions.push_back(positions[i]);
+        }
+        if (!allCapsPositions.empty())
+        {
+            AZStd::string posArr = buildIntArray(allCapsPositions);
+            const char* params[] = { posArr.c_str(), docPkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "UPDATE pbm_documents SET all_caps_positions = $1::integer[] "
+                "WHERE id = $2::integer",
+                2, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) != PGRES_COMMAND_OK)
+                fprintf(stderr, "[HCPPbmWriter] all_caps_positions UPDATE failed: %s\n",
+                    PQerrorMessage(pg));
+            PQclear(res);
+        }
+
+        PGresult* commitRes = PQexec(pg, "COMMIT");
+        bool ok = (PQresultStatus(commitRes) == PGRES_COMMAND_OK);
+        PQclear(commitRes);
+
+        if (ok)
+        {
+            QueryCache::BumpGeneration();
+
+            // Positions land after the bond commit — drop any text a retrieve
+            // cached in between, so the next one assembles the complete document.
+            {
+                const char* params[] = { docPkStr.c_str() };
+                PGresult* res = PQexecParams(pg,
+                    "SELECT doc_id FROM pbm_documents WHERE id = $1",
+                    1, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                {
+                    TextCache::Invalidate(PQgetvalue(res, 0, 0));
+                }
+                PQclear(res);
+            }
+
+            if (PbmSnapshot::Enabled())
+            {
+                AppendSnapshotPositions(pg, docPk, snapPositions, allCapsPositions, totalSlots);
+            }
+        }
+
+        fprintf(stderr, "[HCPPbmWriter] StorePositions: pk=%d — %zu/%zu starters, %zu all-caps\n",
+            docPk, updated, tokenPositions.size(), allCapsPositions.size());
+        fflush(stderr);
+
+        return ok;
+    }
+
+    bool HCPPbmWriter::StorePositionsGrouped(
+        int docPk,
+        AZStd::vector<AZStd::pair<AZStd::string, AZStd::vector<int>>>& starterPositions,
+        int totalSlots,
+        const AZStd::vector<int>& allCapsPositions)
+    {
+        PGconn* pg = m_conn.Get();
+        if (!pg)
+        {
+            AZLOG_ERROR("HCPPbmWriter::StorePositionsGrouped: not connected");
+            return false;
+        }
+
+        PQexec(pg, "BEGIN");
+
+        // Update total_slots and unique_tokens (the grouping is one entry per
+        // unique token — no re-grouping pass here).
+        {
+            AZStd::string pkStr = AZStd::to_string(docPk);
+            AZStd::string slotsStr = AZStd::to_string(totalSlots);
+            AZStd::string uniqStr = AZStd::to_string(static_cast<int>(starterPositions.size()));
+            const char* params[] = { slotsStr.c_str(), uniqStr.c_str(), pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "UPDATE pbm_documents SET total_slots = $1::integer, unique_tokens = $2::integer "
+                "WHERE id = $3::integer",
+                3, nullptr, params, nullptr, nullptr, 0);
+            PQclear(res);
+        }
+
+        // Build surface→decimal var_id lookup
+        AZStd::unordered_map<AZStd::string, AZStd::string> surfaceToVarId;
+        {
+            AZStd::string pkStr = AZStd::to_string(docPk);
+            const char* params[] = { pkStr.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "SELECT var_id, surface FROM pbm_docvars WHERE doc_id = $1",
+                1, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_TUPLES_OK)
+            {
+                for (int i = 0; i < PQntuples(res); ++i)
+                {
+                    surfaceToVarId[PQgetvalue(res, i, 1)] = PQgetvalue(res, i, 0);
+                }
+            }
+            PQclear(res);
+        }
+
+        AZStd::string docPkStr = AZStd::to_string(docPk);
+        size_t updated = 0;
+        size_t staged = 0;
+        size_t flushes = 0;
+
+        const bool bulk = UseCopyPath();
+
+        // Bounded COPY staging: rather than holding every row for one COPY,
+        // flush whenever the buffer crosses the threshold — several small
+        // COPYs into the same temp table merge identically. This is what
+        // keeps the store side flat for multi-hundred-MB documents.
+        static constexpr size_t COPY_FLUSH_BYTES = 4u << 20;
+        AZStd::string copyRows;
+        bool copyOk = true;
+        bool tmpReady = false;
+
+        auto flushCopy = [&]()
+        {
+            if (copyRows.empty()) return;
+            using namespace PbmWriter_Detail;
+            if (!tmpReady)
+            {
+                tmpReady = RunCommand(pg,
+                    "CREATE TEMP TABLE tmp_pbm_positions "
+                    "(doc_id integer, a_ns text, a_p2 text, a_p3 text, a_p4 text, a_p5 text, "
+                    "positions_packed bytea) ON COMMIT DROP",
+                    "CREATE TEMP tmp_pbm_positions");
+                if (!tmpReady)
+                {
+                    copyOk = false;
+                    copyRows.clear();
+                    return;
+                }
+            }
+            if (!RunCopy(pg, "COPY tmp_pbm_positions FROM STDIN", copyRows, "positions"))
+                copyOk = false;
+            copyRows.clear();
+            ++flushes;
+        };
+
+        // Resolved (starter token id, positions) pairs for the mmap snapshot.
+        // The snapshot appender needs the whole document at once, so when
+        // snapshots are on the grouping is referenced a second time — ints
+        // only, no per-slot strings.
+        AZStd::vector<AZStd::pair<AZStd::string, AZStd::vector<int>>> snapPositions;
+        if (PbmSnapshot::Enabled())
+        {
+            snapPositions.reserve(starterPositions.size());
+        }
+
+        for (auto& [tokenId, posList] : starterPositions)
+        {
+            if (posList.empty()) continue;
+
+            // Resolve var tokens to decimal starter IDs
+            AZStd::string starterTokenId;
+            if (tokenId.starts_with(VAR_PREFIX) && tokenId.size() > VAR_PREFIX_LEN + 1)
+            {
+                AZStd::string surface = VarSurface(tokenId);
+                auto it = surfaceToVarId.find(surface);
+                if (it != surfaceToVarId.end())
+                {
+                    const AZStd::string& vid = it->second;
+                    size_t dot = vid.find('.');
+                    starterTokenId = "00.00.00." +
+                        AZStd::string(vid.data(), dot) + "." +
+                        AZStd::string(vid.data() + dot + 1, vid.size() - dot - 1);
+                }
+                else
+                {
+                    fprintf(stderr, "[HCPPbmWriter] StorePositionsGrouped: no docvar for surface '%s'\n",
+                        surface.c_str());
+                    fflush(stderr);
+                    continue;
+                }
+            }
+            else
+            {
+                starterTokenId = tokenId;
+            }
+
+            AZStd::string aParts[5];
+            SplitTokenId(starterTokenId, aParts);
+
+            AZStd::string packed = PosPack::Pack(posList);
+
+            if (PbmSnapshot::Enabled())
+            {
+                snapPositions.emplace_back(starterTokenId, posList);
+            }
+
+            if (bulk)
+            {
+                copyRows += docPkStr;
+                for (int f = 0; f < 5; ++f)
+                {
+                    copyRows += '\t';
+                    PbmWriter_Detail::AppendCopyField(copyRows, aParts[f]);
+                }
+                copyRows += '\t';
+                copyRows += PosPack::BytesToHex(packed, /*copyMode=*/true);
+                copyRows += '\n';
+                ++staged;
+                if (copyRows.size() >= COPY_FLUSH_BYTES)
+                    flushCopy();
+                continue;
+            }
+
+            AZStd::string packedHex = PosPack::BytesToHex(packed, /*copyMode=*/false);
+            const char* params[] = { docPkStr.c_str(),
+                                     aParts[0].c_str(), aParts[1].c_str(), aParts[2].c_str(),
+                                     aParts[3].c_str(), aParts[4].c_str(),
+                                     packedHex.c_str() };
+            PGresult* res = PQexecParams(pg,
+                "INSERT INTO pbm_starters (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5, positions_packed) "
+                "VALUES ($1::integer, $2, $3, $4, $5, $6, $7::bytea) "
+                "ON CONFLICT (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5) "
+                "DO UPDATE SET positions_packed = EXCLUDED.positions_packed, positions = '{}'",
+                7, nullptr, params, nullptr, nullptr, 0);
+            if (PQresultStatus(res) == PGRES_COMMAND_OK)
+                ++updated;
+            else
+                fprintf(stderr, "[HCPPbmWriter] StorePositionsGrouped: starter upsert failed for '%s': %s\n",
+                    starterTokenId.c_str(), PQerrorMessage(pg));
+            PQclear(res);
+        }
+
+        if (bulk && staged > 0)
+        {
+            flushCopy();
+            if (copyOk && tmpReady &&
+                PbmWriter_Detail::RunCommand(pg,
+                    "INSERT INTO pbm_starters (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5, positions_packed) "
+                    "SELECT doc_id, a_ns, a_p2, a_p3, a_p4, a_p5, positions_packed FROM tmp_pbm_positions "
+                    "ON CONFLICT (doc_id, a_ns, a_p2, a_p3, a_p4, a_p5) "
+                    "DO UPDATE SET positions_packed = EXCLUDED.positions_packed, positions = '{}'",
+                    "positions merge"))
+            {
+                updated = staged;
+            }
+        }
+
+        // ALL_CAPS arrives pre-extracted from the streaming scan.
+        if (!allCapsPositions.empty())
         {
-            AZStd::string posArr = buildIntArray(capIt->second);
+            AZStd::string posArr = "{";
+            for (size_t k = 0; k < allCapsPositions.size(); ++k)
+            {
+                if (k) posArr += ',';
+                posArr += AZStd::to_string(allCapsPositions[k]);
+            }
+            posArr += '}';
             const char* params[] = { posArr.c_str(), docPkStr.c_str() };
             PGresult* res = PQexecParams(pg,
                 "UPDATE pbm_documents SET all_caps_positions = $1::integer[] "
@@ -631,8 +1997,31 @@ namespace HCPEngine
         bool ok = (PQresultStatus(commitRes) == PGRES_COMMAND_OK);
         PQclear(commitRes);
 
-        fprintf(stderr, "[HCPPbmWriter] StorePositions: pk=%d — %zu/%zu starters, %zu morpheme lists\n",
-            docPk, updated, tokenPositions.size(), morphemePositions.size());
+        if (ok)
+        {
+            QueryCache::BumpGeneration();
+
+            {
+                const char* params[] = { docPkStr.c_str() };
+                PGresult* res = PQexecParams(pg,
+                    "SELECT doc_id FROM pbm_documents WHERE id = $1",
+                    1, nullptr, params, nullptr, nullptr, 0);
+                if (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0)
+                {
+                    TextCache::Invalidate(PQgetvalue(res, 0, 0));
+                }
+                PQclear(res);
+            }
+
+            if (PbmSnapshot::Enabled())
+            {
+                AppendSnapshotPositions(pg, docPk, snapPositions, allCapsPositions, totalSlots);
+            }
+        }
+
+        fprintf(stderr, "[HCPPbmWriter] StorePositionsGrouped: pk=%d — %zu/%zu starters, "
+            "%zu all-caps, %zu COPY flushes\n",
+            docPk, updated, starterPositions.size(), allCapsPositions.size(), flushes);
         fflush(stderr);
 
         return ok;
@@ -6,9 +6,19 @@
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/containers/vector.h>
 #include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/utils.h>
 
 namespace HCPEngine
 {
+    //! Bond delta between a stored PBM and a re-scan of the same document.
+    //! Counts in `changed` are the new absolute values, not increments.
+    struct PBMDelta
+    {
+        AZStd::vector<Bond> changed;   // new bonds, or bonds whose count moved
+        AZStd::vector<Bond> removed;   // present in the stored PBM, absent now
+        size_t unchanged = 0;
+    };
+
     //! PBM write kernel — bond insertion and position storage.
     //! Single-purpose: writes PBM data to hcp_fic_pbm.
     //! Takes a HCPDbConnection reference — does not own the connection.
@@ -38,19 +48,49 @@ namespace HCPEngine
         //! @return doc_id string of the filled document, or empty on failure.
         AZStd::string FillPBMData(int existingDocPk, const PBMData& pbmData);
 
+        //! Diff a re-scan against the stored PBM (from HCPPbmReader::LoadPBM).
+        static PBMDelta DiffPBM(const PBMData& oldData, const PBMData& newData);
+
+        //! Incremental re-ingest: apply only the bond delta between oldData
+        //! (the stored PBM) and newData to an existing document row. Changed
+        //! counts are overwritten, vanished bonds deleted, and starters whose
+        //! token left the document dropped; everything else is untouched. For
+        //! an edition where <1% of the text moved this is a few hundred rows
+        //! instead of a full rewrite.
+        //! @return doc_id string of the updated document, or empty on failure.
+        AZStd::string UpdatePBMDelta(int existingDocPk, const PBMData& newData,
+            const PBMData& oldData);
+
+        //! True when incremental re-ingest is enabled (the default).
+        //! HCP_PBM_INCREMENTAL=0 restores full rewrites on re-ingest.
+        static bool UseIncrementalPath();
+
         //! Integer PK of the last document touched by StorePBM / CreateDocumentStub.
         int LastDocPk() const { return m_lastDocPk; }
 
         //! Store position data alongside PBM bonds.
-        //! Each occurrence is one row in pbm_positions(starter_id, position).
-        //! Cap overlays (FIRST_CAP / ALL_CAPS) are written to pbm_cap_flags.
-        //! @param morphemePositions Map of morpheme name → position list (from ScanManifestToPBM).
+        //! One row per starter: occurrences are delta-encoded varints in
+        //! pbm_starters.positions_packed (HCPPosPack.h, migration 052).
+        //! @param modifiers Packed per-position modifier column, 1:1 with tokenIds
+        //!   (TokenStream layout; from ScanManifestToPBM). ALL_CAPS (bit 1) is
+        //!   extracted here for pbm_documents.all_caps_positions.
         bool StorePositions(
             int docPk,
             const AZStd::vector<AZStd::string>& tokenIds,
             const AZStd::vector<int>& positions,
             int totalSlots,
-            const AZStd::unordered_map<AZStd::string, AZStd::vector<int>>& morphemePositions = {});
+            const AZStd::vector<AZ::u32>& modifiers = {});
+
+        //! Streaming-scan counterpart of StorePositions: takes positions
+        //! already grouped per starter token (ManifestScanAggregate), so no
+        //! per-slot arrays exist on either side, and flushes the COPY payload
+        //! in bounded chunks instead of staging the whole document. Same rows,
+        //! same upsert semantics. Non-const: PosPack sorts each list in place.
+        bool StorePositionsGrouped(
+            int docPk,
+            AZStd::vector<AZStd::pair<AZStd::string, AZStd::vector<int>>>& starterPositions,
+            int totalSlots,
+            const AZStd::vector<int>& allCapsPositions = {});
 
     private:
         struct BondWriteSummary
@@ -64,8 +104,36 @@ namespace HCPEngine
 
         //! Shared bond-writing logic used by StorePBM and FillPBMData.
         //! Runs inside the caller's BEGIN transaction — does not commit.
+        //! Dispatches to the COPY bulk path (default) or the legacy
+        //! row-at-a-time path (HCP_PBM_COPY=0).
         BondWriteSummary WritePBMBonds(PGconn* pg, int docPk, const PBMData& pbmData);
 
+        //! Legacy row-at-a-time INSERTs — one round trip per starter/bond.
+        BondWriteSummary WritePBMBondsRows(PGconn* pg, int docPk, const PBMData& pbmData);
+
+        //! COPY bulk path: stages all rows client-side, streams them with
+        //! COPY FROM STDIN into per-subtable temp tables, and merges each with
+        //! a single INSERT ... ON CONFLICT. Same upsert semantics, a handful of
+        //! round trips per document instead of one per row.
+        BondWriteSummary WritePBMBondsBulk(PGconn* pg, int docPk, const PBMData& pbmData);
+
+        //! True when the COPY bulk-write path is enabled (the default).
+        //! HCP_PBM_COPY=0 restores the row-at-a-time INSERT path.
+        static bool UseCopyPath();
+
+        //! Emit the mmap bond snapshot for a committed document (side file,
+        //! see HCPPbmSnapshot.h). Reads the minted docvars back to build the
+        //! var table. Failures only log — the DB remains the source of truth.
+        void EmitSnapshot(PGconn* pg, const AZStd::string& docId, int docPk,
+            const PBMData& pbmData);
+
+        //! Append the position sections to an existing snapshot and patch its
+        //! header counts. starterPositions carries resolved starter token ids
+        //! ("00.00.00.NN.MM" for vars) with their position lists.
+        void AppendSnapshotPositions(PGconn* pg, int docPk,
+            const AZStd::vector<AZStd::pair<AZStd::string, AZStd::vector<int>>>& starterPositions,
+            const AZStd::vector<int>& allCapsPositions, int totalSlots);
+
         HCPDbConnection& m_conn;
         int m_lastDocPk = 0;
     };
@@ -9,8 +9,25 @@
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 
+#include <chrono>
+#include <cstdlib>
+
 namespace HCPEngine
 {
+    // Streaming-scan switch. HCP_SCAN_STREAM=1 forces the bounded-memory scan,
+    // =0 pins the classic one; unset auto-enables past a run count where the
+    // per-slot scan arrays start to rival the manifest itself (the
+    // multi-hundred-MB archival compilations that used to OOM the daemon).
+    static bool UseStreamingScan(size_t runCount)
+    {
+        static const int mode = []() {
+            const char* v = std::getenv("HCP_SCAN_STREAM");
+            if (!v || !v[0]) return -1;
+            return v[0] == '0' ? 0 : 1;
+        }();
+        if (mode >= 0) return mode == 1;
+        return runCount >= 8u * 1024 * 1024;
+    }
     PhysIngestResult PhysIngestText(
         const AZStd::string& text,
         const AZStd::string& docName,
@@ -21,18 +38,6 @@ namespace HCPEngine
         bool isWorkingDoc,
         HCPEngineSystemComponent* engine)
     {
-        PhysIngestResult result;
-
-        // Prerequisites
-        BedManager& bedManager = engine->GetBedManager();
-        if (!bedManager.IsInitialized())
-        { result.errorMessage = "BedManager not initialized"; return result; }
-
-        HCPDbConnection& dbConn = engine->GetDbConnection();
-        if (!dbConn.IsConnected()) dbConn.Connect();
-        if (!dbConn.IsConnected())
-        { result.errorMessage = "No database connection"; return result; }
-
         fprintf(stderr, "[PhysIngest] Starting: '%s' (%zu bytes)\n",
             docName.c_str(), text.size());
         fflush(stderr);
@@ -47,17 +52,95 @@ namespace HCPEngine
         AZStd::vector<CharRun> runs = IngestBytes(
             reinterpret_cast<const uint8_t*>(normalizedText.data()), normalizedText.size());
 
-        result.phase1Total   = static_cast<AZ::u32>(normalizedText.size());
-        result.phase1Settled = result.phase1Total;   // byte-floor decodes deterministically
-        result.phase1TimeMs  = 0.0f;
-
         fprintf(stderr, "[PhysIngest] byte-floor: %zu bytes → %zu runs\n",
             normalizedText.size(), runs.size());
         fflush(stderr);
 
+        return PhysIngestRuns(runs, normalizedText.size(), text, docName, centuryCode,
+            catalog, catalogId, fictionFirst, isWorkingDoc, engine);
+    }
+
+    PhysIngestResult PhysIngestTextInPlace(
+        char* text, size_t textLen,
+        const AZStd::string& docName,
+        const AZStd::string& centuryCode,
+        const AZStd::string& catalog,
+        const AZStd::string& catalogId,
+        bool fictionFirst,
+        HCPEngineSystemComponent* engine)
+    {
+        fprintf(stderr, "[PhysIngest] Starting (in place): '%s' (%zu bytes)\n",
+            docName.c_str(), textLen);
+        fflush(stderr);
+
+        // Normalize CRLF → LF (Gutenberg hard wraps) by compacting the
+        // caller's buffer — the write cursor never passes the read cursor.
+        size_t kept = 0;
+        for (size_t i = 0; i < textLen; ++i)
+            if (text[i] != '\r') text[kept++] = text[i];
+
+        AZStd::vector<CharRun> runs = IngestBytes(
+            reinterpret_cast<const uint8_t*>(text), kept);
+
+        fprintf(stderr, "[PhysIngest] byte-floor: %zu bytes → %zu runs\n",
+            kept, runs.size());
+        fflush(stderr);
+
+        return PhysIngestRuns(runs, kept, AZStd::string(), docName, centuryCode,
+            catalog, catalogId, fictionFirst, /*isWorkingDoc=*/false, engine);
+    }
+
+    PhysIngestResult PhysIngestRuns(
+        AZStd::vector<CharRun>& runs,
+        size_t sourceBytes,
+        const AZStd::string& rawText,
+        const AZStd::string& docName,
+        const AZStd::string& centuryCode,
+        const AZStd::string& catalog,
+        const AZStd::string& catalogId,
+        bool fictionFirst,
+        bool isWorkingDoc,
+        HCPEngineSystemComponent* engine,
+        PhysIngestProgress* progress)
+    {
+        PhysIngestResult result;
+
+        // Between-phase cancellation gate: no document rows have been written
+        // at any point this fires, so a cancelled job leaves no partial doc
+        // (resolve-side cache fills are harmless and kept).
+        auto cancelled = [&]() -> bool
+        {
+            if (!progress || !progress->cancelRequested.load(std::memory_order_relaxed))
+                return false;
+            result.cancelled = true;
+            result.errorMessage = "cancelled";
+            return true;
+        };
+
+        // Prerequisites
+        BedManager& bedManager = engine->GetBedManager();
+        if (!bedManager.IsInitialized())
+        { result.errorMessage = "BedManager not initialized"; return result; }
+
+        HCPDbConnection& dbConn = engine->GetDbConnection();
+        if (!dbConn.IsConnected()) dbConn.Connect();
+        if (!dbConn.IsConnected())
+        { result.errorMessage = "No database connection"; return result; }
+
+        result.phase1Total   = static_cast<AZ::u32>(sourceBytes);
+        result.phase1Settled = result.phase1Total;   // byte-floor decodes deterministically
+        result.phase1TimeMs  = 0.0f;
+
         if (runs.empty())
         { result.errorMessage = "No runs from byte-floor"; return result; }
 
+        if (cancelled()) return result;
+        if (progress)
+        {
+            progress->stage.store(PhysIngestProgress::Stage::Resolve, std::memory_order_relaxed);
+            progress->runsTotal.store(static_cast<AZ::u32>(runs.size()), std::memory_order_relaxed);
+        }
+
         // Phase 2: word resolution
         ResolutionManifest manifest = bedManager.Resolve(runs);
 
@@ -66,6 +149,9 @@ namespace HCPEngine
         result.unresolved   = manifest.unresolvedRuns;
         result.resolveTimeMs = manifest.totalTimeMs;
 
+        if (progress)
+            progress->runsResolved.store(manifest.resolvedRuns, std::memory_order_relaxed);
+
         fprintf(stderr, "[PhysIngest] Phase 2: %u/%u resolved in %.1f ms\n",
             manifest.resolvedRuns, manifest.totalRuns, manifest.totalTimeMs);
         fflush(stderr);
@@ -75,14 +161,41 @@ namespace HCPEngine
         if (entityAnnotator.IsInitialized())
             entityAnnotator.AnnotateManifest(manifest, fictionFirst);
 
-        // Scanner: manifest → bonds + positions
-        ManifestScanResult scan = ScanManifestToPBM(manifest);
+        if (cancelled()) return result;
+        if (progress)
+            progress->stage.store(PhysIngestProgress::Stage::Scan, std::memory_order_relaxed);
+
+        // Scanner: manifest → bonds + positions. Very large physical ingests
+        // take the streaming scan, which never builds the per-slot parallel
+        // arrays (see ManifestScanAggregate). Working docs keep the classic
+        // scan — they are small and serialize the manifest anyway.
+        const bool streamScan = !isWorkingDoc && UseStreamingScan(manifest.results.size());
+
+        auto scanStart = std::chrono::high_resolution_clock::now();
+        ManifestScanResult scan;
+        ManifestScanAggregate streamed;
+        if (streamScan)
+            streamed = ScanManifestToPBMStreaming(manifest);
+        else
+            scan = ScanManifestToPBM(manifest);
+        result.scanTimeMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - scanStart).count();
+
+        result.bondTypes        = streamScan ? streamed.bonds.size() : scan.bonds.size();
+        result.totalPairs       = streamScan ? streamed.totalPairs : scan.totalPairs;
+        result.uniqueTokens     = streamScan ? streamed.uniqueTokens : scan.uniqueTokens;
+        result.totalSlots       = streamScan ? streamed.totalSlots : scan.totalSlots;
+        result.entityAnnotations = streamScan ? streamed.entityAnnotations : scan.entityAnnotations;
+
+        if (progress)
+            progress->bondsWritten.store(streamScan ? streamed.bonds.size() : scan.bonds.size(),
+                std::memory_order_relaxed);
 
-        result.bondTypes        = scan.bonds.size();
-        result.totalPairs       = scan.totalPairs;
-        result.uniqueTokens     = scan.uniqueTokens;
-        result.totalSlots       = scan.totalSlots;
-        result.entityAnnotations = scan.entityAnnotations;
+        if (cancelled()) return result;
+        if (progress)
+            progress->stage.store(PhysIngestProgress::Stage::Store, std::memory_order_relaxed);
+
+        auto storeStart = std::chrono::high_resolution_clock::now();
 
         if (isWorkingDoc)
         {
@@ -102,23 +215,27 @@ namespace HCPEngine
             rw.EndArray();
             AZStd::string resolvedJson(resolvedSb.GetString(), resolvedSb.GetSize());
 
-            result.workingDocId = engine->StoreWorkingDoc(docName, text, resolvedJson);
+            result.workingDocId = engine->StoreWorkingDoc(docName, rawText, resolvedJson);
             result.isWorkingDoc = true;
             result.ok = (result.workingDocId > 0);
+            result.storeTimeMs = std::chrono::duration<float, std::milli>(
+                std::chrono::high_resolution_clock::now() - storeStart).count();
 
             fprintf(stderr, "[PhysIngest] Working doc '%s' → hcp_var id=%d\n",
                 docName.c_str(), result.workingDocId);
             fflush(stderr);
+            if (progress)
+                progress->stage.store(PhysIngestProgress::Stage::Done, std::memory_order_relaxed);
             return result;
         }
 
         // Physical text — store in PBM
         PBMData pbmData;
-        pbmData.bonds      = AZStd::move(scan.bonds);
-        pbmData.firstFpbA  = scan.firstFpbA;
-        pbmData.firstFpbB  = scan.firstFpbB;
-        pbmData.totalPairs = scan.totalPairs;
-        pbmData.uniqueTokens = scan.uniqueTokens;
+        pbmData.bonds      = AZStd::move(streamScan ? streamed.bonds : scan.bonds);
+        pbmData.firstFpbA  = streamScan ? streamed.firstFpbA : scan.firstFpbA;
+        pbmData.firstFpbB  = streamScan ? streamed.firstFpbB : scan.firstFpbB;
+        pbmData.totalPairs = streamScan ? streamed.totalPairs : scan.totalPairs;
+        pbmData.uniqueTokens = streamScan ? streamed.uniqueTokens : scan.uniqueTokens;
 
         HCPPbmWriter& pbmWriter = engine->GetPbmWriter();
 
@@ -127,7 +244,26 @@ namespace HCPEngine
             int stubPk = engine->GetDocumentQuery().GetDocPkByCatalogId(catalog, catalogId);
             if (stubPk != 0)
             {
-                result.docId   = pbmWriter.FillPBMData(stubPk, pbmData);
+                // Re-ingest of a document that already holds bonds (edition
+                // refresh): diff against the stored PBM and apply only the
+                // delta, instead of rewriting every row.
+                if (HCPPbmWriter::UseIncrementalPath())
+                {
+                    AZStd::string existingDocId = engine->GetDocumentQuery().GetDocId(stubPk);
+                    if (!existingDocId.empty())
+                    {
+                        PBMData oldPbm = engine->GetPbmReader().LoadPBM(existingDocId);
+                        if (!oldPbm.bonds.empty())
+                        {
+                            result.docId = pbmWriter.UpdatePBMDelta(stubPk, pbmData, oldPbm);
+                            result.incremental = !result.docId.empty();
+                        }
+                    }
+                }
+
+                // Empty stub (or incremental disabled/failed): full fill.
+                if (result.docId.empty())
+                    result.docId = pbmWriter.FillPBMData(stubPk, pbmData);
                 result.usedStub = true;
             }
         }
@@ -138,17 +274,29 @@ namespace HCPEngine
         { result.errorMessage = "StorePBM/FillPBMData failed"; return result; }
 
         result.docPk = pbmWriter.LastDocPk();
-        result.positionsStored = pbmWriter.StorePositions(
-            result.docPk, scan.tokenIds, scan.positions,
-            scan.totalSlots, scan.morphemePositions);
+        result.positionsStored = streamScan
+            ? pbmWriter.StorePositionsGrouped(result.docPk, streamed.starterPositions,
+                streamed.totalSlots, streamed.allCapsPositions)
+            : pbmWriter.StorePositions(result.docPk, scan.tokenIds, scan.positions,
+                scan.totalSlots, scan.modifiers);
+
+        result.storeTimeMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - storeStart).count();
 
         result.ok = true;
 
+        // Document commit: execute the mint recommendations the resolve pass
+        // accumulated (possessives, hyphenated variants) as one batch.
+        if (!manifest.mintRecommendations.empty())
+            engine->GetResolver().ExecuteMintBatch(manifest.mintRecommendations);
+
         fprintf(stderr, "[PhysIngest] Complete: %s → %llu bond types, %llu pairs, %d slots\n",
             result.docId.c_str(), (unsigned long long)result.bondTypes,
             (unsigned long long)result.totalPairs, result.totalSlots);
         fflush(stderr);
 
+        if (progress)
+            progress->stage.store(PhysIngestProgress::Stage::Done, std::memory_order_relaxed);
         return result;
     }
 
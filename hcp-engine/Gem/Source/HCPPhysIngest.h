@@ -1,17 +1,55 @@
 #pragma once
 
+#include <AzCore/std/containers/vector.h>
 #include <AzCore/std/string/string.h>
 
+#include <atomic>
+
+#include "HCPCharRun.h"
+
 namespace HCPEngine
 {
     class HCPEngineSystemComponent;
 
+    //! Live progress + cancellation handle for a job-mode ingest (socket
+    //! server's phys_ingest with "job": true). The pipeline publishes coarse
+    //! per-phase counters; job_status reads them lock-free. Cancellation is
+    //! honored BETWEEN phases only — a resolve or store pass in flight always
+    //! completes, so the engine and the PBM store are never left half-written.
+    struct PhysIngestProgress
+    {
+        enum class Stage : AZ::u8 { Queued, ByteFloor, Resolve, Scan, Store, Done };
+
+        std::atomic<Stage>   stage{Stage::Queued};
+        std::atomic<AZ::u64> bytesIngested{0};   // bytes through the byte-floor
+        std::atomic<AZ::u32> runsTotal{0};       // runs entering resolution
+        std::atomic<AZ::u32> runsResolved{0};    // runs resolved so far
+        std::atomic<AZ::u64> bondsWritten{0};    // bond types from the scanner
+        std::atomic<bool>    cancelRequested{false};
+
+        static const char* StageName(Stage s)
+        {
+            switch (s)
+            {
+            case Stage::Queued:    return "queued";
+            case Stage::ByteFloor: return "byte_floor";
+            case Stage::Resolve:   return "resolve";
+            case Stage::Scan:      return "scan";
+            case Stage::Store:     return "store";
+            case Stage::Done:      return "done";
+            default:               return "unknown";
+            }
+        }
+    };
+
     struct PhysIngestResult
     {
         bool ok = false;
+        bool cancelled = false;    // job cancelled between phases; nothing stored
         AZStd::string docId;
         int docPk = 0;
         bool usedStub = false;
+        bool incremental = false;   // bond delta applied instead of a full rewrite
         bool positionsStored = false;
         bool isWorkingDoc = false;
         int workingDocId = 0;
@@ -23,6 +61,8 @@ namespace HCPEngine
         AZ::u32 resolved = 0;
         AZ::u32 unresolved = 0;
         float resolveTimeMs = 0.f;
+        float scanTimeMs = 0.f;    // ScanManifestToPBM
+        float storeTimeMs = 0.f;   // PBM/working-doc storage (bonds + positions)
         AZ::u64 bondTypes = 0;
         AZ::u64 totalPairs = 0;
         AZ::u64 uniqueTokens = 0;
@@ -45,4 +85,39 @@ namespace HCPEngine
         bool isWorkingDoc,
         HCPEngineSystemComponent* engine);
 
+    // Same pipeline as PhysIngestText, for callers that own a MUTABLE text
+    // buffer (the socket layer parses payloads in situ): CRLF normalization
+    // compacts the buffer in place instead of copying it, so the document
+    // reaches the byte-floor with zero intermediate copies. The buffer is
+    // consumed — its contents are clobbered and not retained, which is why
+    // this variant has no working-doc mode (working docs store the raw text).
+    PhysIngestResult PhysIngestTextInPlace(
+        char* text, size_t textLen,
+        const AZStd::string& docName,
+        const AZStd::string& centuryCode,
+        const AZStd::string& catalog,
+        const AZStd::string& catalogId,
+        bool fictionFirst,
+        HCPEngineSystemComponent* engine);
+
+    // Back half of the pipeline, for runs the byte-floor already produced — the
+    // streaming socket ingest feeds chunks through ByteIngestStream and hands the
+    // accumulated runs here. sourceBytes is the document's byte length (reported
+    // as phase 1 totals). rawText is stored verbatim for working docs only;
+    // streaming callers pass an empty string with isWorkingDoc=false.
+    // `progress` (optional) receives per-phase counters and carries the
+    // between-phase cancellation flag for job-mode ingest.
+    PhysIngestResult PhysIngestRuns(
+        AZStd::vector<CharRun>& runs,
+        size_t sourceBytes,
+        const AZStd::string& rawText,
+        const AZStd::string& docName,
+        const AZStd::string& centuryCode,
+        const AZStd::string& catalog,
+        const AZStd::string& catalogId,
+        bool fictionFirst,
+        bool isWorkingDoc,
+        HCPEngineSystemComponent* engine,
+        PhysIngestProgress* progress = nullptr);
+
 } // namespace HCPEngine
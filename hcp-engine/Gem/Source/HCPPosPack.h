@@ -0,0 +1,137 @@
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/containers/vector.h>
+
+#include <algorithm>
+
+// Packed starter position lists (migration 052). Per-starter positions live
+// in pbm_starters.positions_packed as delta-encoded ULEB128 varints: the
+// first varint is the absolute first position, each subsequent varint the
+// gap to its predecessor. A token recurring through a document has small
+// gaps, so the common occurrence costs one byte — roughly 8x smaller than
+// the INTEGER[] text literals it replaces, and decoded in one sequential
+// pass. Writer side: HCPPbmWriter::StorePositions. Reader side:
+// HCPPbmReader::LoadPositionsWithModifiers, which falls back to the legacy
+// positions column for rows from before the migration.
+
+namespace HCPEngine
+{
+namespace PosPack
+{
+    //! Append one ULEB128 varint to out.
+    inline void PutVarint(AZStd::string& out, AZ::u32 v)
+    {
+        while (v >= 0x80)
+        {
+            out += static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        out += static_cast<char>(v);
+    }
+
+    //! Delta-encode a position list into ULEB128 bytes. Sorts in place when
+    //! needed — packed order is ascending by definition, and every consumer
+    //! orders by position anyway.
+    inline AZStd::string Pack(AZStd::vector<int>& positions)
+    {
+        if (!std::is_sorted(positions.begin(), positions.end()))
+            std::sort(positions.begin(), positions.end());
+
+        AZStd::string out;
+        out.reserve(positions.size() + 4);   // gaps are almost always one byte
+        AZ::u32 prev = 0;
+        bool first = true;
+        for (int pos : positions)
+        {
+            const AZ::u32 v = static_cast<AZ::u32>(pos);
+            PutVarint(out, first ? v : v - prev);
+            prev = v;
+            first = false;
+        }
+        return out;
+    }
+
+    //! Decode packed bytes back to absolute positions; emit(int) fires once
+    //! per position in ascending order. The single-byte case (gap < 128 —
+    //! nearly every byte in practice) is peeled ahead of the generic
+    //! continuation loop, so the hot path is one load, one add, one store.
+    template<typename Emit>
+    inline void Unpack(const unsigned char* data, size_t len, Emit&& emit)
+    {
+        AZ::u32 acc = 0;
+        bool first = true;
+        size_t i = 0;
+        while (i < len)
+        {
+            AZ::u32 v = data[i];
+            if (v < 0x80)
+            {
+                ++i;
+            }
+            else
+            {
+                v &= 0x7F;
+                ++i;
+                int shift = 7;
+                while (i < len)
+                {
+                    const AZ::u32 b = data[i++];
+                    v |= (b & 0x7F) << shift;
+                    if (b < 0x80) break;
+                    shift += 7;
+                }
+            }
+            acc = first ? v : acc + v;
+            first = false;
+            emit(static_cast<int>(acc));
+        }
+    }
+
+    //! Decode a libpq text-mode bytea hex literal ("\x0a1b…") into bytes.
+    //! Returns false (out untouched beyond clear) for anything else.
+    inline bool HexToBytes(const char* hex, AZStd::vector<unsigned char>& out)
+    {
+        out.clear();
+        if (!hex || hex[0] != '\\' || hex[1] != 'x') return false;
+
+        auto nibble = [](char c) -> int
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        };
+
+        for (const char* p = hex + 2; p[0] && p[1]; p += 2)
+        {
+            const int hi = nibble(p[0]);
+            const int lo = nibble(p[1]);
+            if (hi < 0 || lo < 0) return false;
+            out.push_back(static_cast<unsigned char>((hi << 4) | lo));
+        }
+        return true;
+    }
+
+    //! Hex-encode packed bytes as a bytea input literal. copyMode doubles the
+    //! backslash for COPY text format ("\\x…" vs the "\x…" a query parameter
+    //! takes).
+    inline AZStd::string BytesToHex(const AZStd::string& bytes, bool copyMode)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+        AZStd::string out;
+        out.reserve(bytes.size() * 2 + 3);
+        if (copyMode) out += '\\';
+        out += "\\x";
+        for (char c : bytes)
+        {
+            const unsigned char uc = static_cast<unsigned char>(c);
+            out += hexDigits[uc >> 4];
+            out += hexDigits[uc & 0xF];
+        }
+        return out;
+    }
+
+} // namespace PosPack
+} // namespace HCPEngine
@@ -0,0 +1,259 @@
+#pragma once
+
+// PrimeGrid — uniform spatial hash broadphase for prime-layer particles.
+//
+// HCPPrimePhases.h defines WHAT a prime-layer particle is (the 20-bit phase
+// typology); this grid answers WHERE — the neighborhood structure any
+// class-interaction pass needs so it is not O(N²) over the population.
+// Cells are cubes of `cellSize`; a cell's integer coords hash into a
+// power-of-two bucket table (Teschner-style multiplicative hash). Bucket
+// collisions (two cells landing in one bucket) are harmless: queries filter
+// by exact distance anyway and dedupe the bucket list per query, so
+// collisions only add rejected candidates — never drop or repeat a hit.
+//
+// Rebuild is per-frame and parallel: a sharded hash pass fills the
+// particle→bucket scratch, a serial count + prefix sum lays out the index
+// arena, and a sharded scatter with atomic bucket cursors places indices.
+// Within a bucket the particle order is therefore nondeterministic across
+// rebuilds — consumers must not depend on it (Forces/InteractionBatch.h
+// sorts its candidate lists before accumulating for exactly this reason).
+//
+// The position/phase arrays are BORROWED: the grid keeps the pointers handed
+// to Rebuild for distance and phase checks during queries, so they must stay
+// alive and unmoved until the next Rebuild. SoA layout on purpose — this is
+// the layout the batch force path (Forces/ForceKernelBatch.h) already uses.
+//
+// Pure C++ (no AZ / O3DE deps) on purpose, same standalone-oracle discipline
+// as Settle/SettleKernel.h, Pack/PackKernel.h and tools/byte-floor: the
+// brute-force oracle test (Forces/test_primegrid.cpp) builds and runs with
+// nothing but a compiler. Phase values interoperate with the AZ::u32
+// constants in HCPPrimePhases.h — both are 32-bit unsigned.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace HCPEngine
+{
+    //! Phase-bit query filter, shaped by the three-tier bit typology
+    //! (HCPPrimePhases.h):
+    //!   - classMask: CLASS bits (13-6) that must all be SET. Classes are
+    //!     declarative — bit-clear just means "absent", so only set-bits can
+    //!     be required.
+    //!   - axisMask/axisValue: SEMANTIC/PHYSICAL AXIS bits (19-14) to pin.
+    //!     Axes are bidirectional — both poles are meaningful — so the filter
+    //!     names which axis bits matter (mask) and which pole each must be at
+    //!     (value). axisMask == 0 means "any pole on every axis".
+    struct PhaseFilter
+    {
+        uint32_t classMask = 0;
+        uint32_t axisMask  = 0;
+        uint32_t axisValue = 0;
+
+        bool Accepts(uint32_t phase) const
+        {
+            return (phase & classMask) == classMask
+                && (phase & axisMask) == axisValue;
+        }
+    };
+
+    class PrimeGrid
+    {
+    public:
+        //! @param cellSize   Cell edge length. Pick ~ the largest interaction
+        //!                   radius so range queries touch ≤ 27 cells.
+        //! @param bucketBits log2 of the bucket-table size. Size toward the
+        //!                   expected live-particle count (load factor ~1).
+        explicit PrimeGrid(float cellSize, uint32_t bucketBits = 20u)
+            : m_cellSize(cellSize)
+            , m_invCellSize(1.0f / cellSize)
+            , m_bucketCount(1u << bucketBits)
+            , m_bucketMask((1u << bucketBits) - 1u)
+        {
+        }
+
+        //! Rebuild the grid over the whole population. Called once per frame;
+        //! previous contents are discarded. Arrays are borrowed (see header
+        //! note). @param workers 0 = hardware concurrency.
+        void Rebuild(const float* posX, const float* posY, const float* posZ,
+                     const uint32_t* phases, size_t count, int workers = 0)
+        {
+            m_posX = posX; m_posY = posY; m_posZ = posZ;
+            m_phases = phases;
+            m_count = count;
+
+            m_bucketOf.resize(count);
+            m_cellStart.assign(m_bucketCount + 1, 0u);
+            m_indices.resize(count);
+
+            if (count == 0)
+                return;
+
+            const int width = ResolveWorkers(count, workers);
+
+            // Pass 1 (sharded): particle → bucket.
+            RunShards(count, width, [this](size_t lo, size_t hi)
+            {
+                for (size_t i = lo; i < hi; ++i)
+                    m_bucketOf[i] = BucketOf(m_posX[i], m_posY[i], m_posZ[i]);
+            });
+
+            // Pass 2 (serial): per-bucket counts, then exclusive prefix sum.
+            // O(N + buckets) of trivial adds — not worth sharding.
+            for (size_t i = 0; i < count; ++i)
+                ++m_cellStart[m_bucketOf[i] + 1];
+            for (uint32_t b = 0; b < m_bucketCount; ++b)
+                m_cellStart[b + 1] += m_cellStart[b];
+
+            // Pass 3 (sharded): scatter indices via atomic bucket cursors.
+            if (m_cursorCapacity < m_bucketCount)
+            {
+                m_cursors.reset(new std::atomic<uint32_t>[m_bucketCount]);
+                m_cursorCapacity = m_bucketCount;
+            }
+            for (uint32_t b = 0; b < m_bucketCount; ++b)
+                m_cursors[b].store(m_cellStart[b], std::memory_order_relaxed);
+
+            RunShards(count, width, [this](size_t lo, size_t hi)
+            {
+                for (size_t i = lo; i < hi; ++i)
+                {
+                    const uint32_t slot = m_cursors[m_bucketOf[i]]
+                        .fetch_add(1u, std::memory_order_relaxed);
+                    m_indices[slot] = static_cast<uint32_t>(i);
+                }
+            });
+        }
+
+        //! Visit every particle within `radius` of (x,y,z) whose phase passes
+        //! `filter` — exactly once. Callback receives the particle index into
+        //! the arrays the grid was rebuilt from. Exact (squared-distance
+        //! checked); bucket collisions and corner cells only cost rejected
+        //! candidates. Two cells of the range hashing to one bucket would
+        //! scan it twice and DOUBLE-report its in-radius particles, so the
+        //! query dedupes the bucket list first (the range is typically ≤ 27
+        //! cells — the sort is noise next to the scan).
+        template <typename Fn>
+        void ForEachInRadius(float x, float y, float z, float radius,
+                             const PhaseFilter& filter, Fn&& fn) const
+        {
+            if (m_count == 0)
+                return;
+
+            const float r2 = radius * radius;
+            const int32_t cx0 = CellCoord(x - radius), cx1 = CellCoord(x + radius);
+            const int32_t cy0 = CellCoord(y - radius), cy1 = CellCoord(y + radius);
+            const int32_t cz0 = CellCoord(z - radius), cz1 = CellCoord(z + radius);
+
+            std::vector<uint32_t> buckets;
+            buckets.reserve(static_cast<size_t>(cx1 - cx0 + 1)
+                          * static_cast<size_t>(cy1 - cy0 + 1)
+                          * static_cast<size_t>(cz1 - cz0 + 1));
+            for (int32_t cz = cz0; cz <= cz1; ++cz)
+            for (int32_t cy = cy0; cy <= cy1; ++cy)
+            for (int32_t cx = cx0; cx <= cx1; ++cx)
+                buckets.push_back(HashCell(cx, cy, cz));
+            std::sort(buckets.begin(), buckets.end());
+            buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+
+            for (const uint32_t b : buckets)
+            {
+                const uint32_t end = m_cellStart[b + 1];
+                for (uint32_t s = m_cellStart[b]; s < end; ++s)
+                {
+                    const uint32_t i = m_indices[s];
+                    if (!filter.Accepts(m_phases[i]))
+                        continue;
+                    const float dx = m_posX[i] - x;
+                    const float dy = m_posY[i] - y;
+                    const float dz = m_posZ[i] - z;
+                    if (dx * dx + dy * dy + dz * dz <= r2)
+                        fn(i);
+                }
+            }
+        }
+
+        size_t Count() const { return m_count; }
+        float CellSize() const { return m_cellSize; }
+        uint32_t BucketCount() const { return m_bucketCount; }
+
+    private:
+        int32_t CellCoord(float v) const
+        {
+            return static_cast<int32_t>(std::floor(v * m_invCellSize));
+        }
+
+        //! Teschner et al. multiplicative cell hash, masked to the table.
+        uint32_t HashCell(int32_t cx, int32_t cy, int32_t cz) const
+        {
+            const uint32_t h = static_cast<uint32_t>(cx) * 73856093u
+                             ^ static_cast<uint32_t>(cy) * 19349663u
+                             ^ static_cast<uint32_t>(cz) * 83492791u;
+            return h & m_bucketMask;
+        }
+
+        uint32_t BucketOf(float x, float y, float z) const
+        {
+            return HashCell(CellCoord(x), CellCoord(y), CellCoord(z));
+        }
+
+        static int ResolveWorkers(size_t count, int workers)
+        {
+            if (count < 65536)
+                return 1;   // serial cutoff: thread spin-up beats the work
+            if (workers <= 0)
+                workers = static_cast<int>(std::thread::hardware_concurrency());
+            return workers > 1 ? workers : 1;
+        }
+
+        template <typename Fn>
+        static void RunShards(size_t n, int width, const Fn& fn)
+        {
+            if (width <= 1)
+            {
+                fn(0, n);
+                return;
+            }
+            std::vector<std::thread> pool;
+            const size_t chunk = (n + width - 1) / width;
+            for (int t = 0; t < width; ++t)
+            {
+                const size_t lo = static_cast<size_t>(t) * chunk;
+                const size_t hi = lo + chunk < n ? lo + chunk : n;
+                if (lo >= hi)
+                    break;
+                pool.emplace_back([&fn, lo, hi] { fn(lo, hi); });
+            }
+            for (auto& th : pool)
+                th.join();
+        }
+
+        float m_cellSize;
+        float m_invCellSize;
+        uint32_t m_bucketCount;
+        uint32_t m_bucketMask;
+
+        // Borrowed arrays (valid from Rebuild until the next Rebuild).
+        const float* m_posX = nullptr;
+        const float* m_posY = nullptr;
+        const float* m_posZ = nullptr;
+        const uint32_t* m_phases = nullptr;
+        size_t m_count = 0;
+
+        // Bucket layout: indices of bucket b live in
+        // m_indices[m_cellStart[b] .. m_cellStart[b+1]).
+        std::vector<uint32_t> m_bucketOf;    // scratch: particle → bucket
+        std::vector<uint32_t> m_cellStart;   // size bucketCount+1
+        std::vector<uint32_t> m_indices;
+
+        // Scatter cursors (atomics are neither copyable nor resizable in a
+        // std::vector, hence the raw array).
+        std::unique_ptr<std::atomic<uint32_t>[]> m_cursors;
+        uint32_t m_cursorCapacity = 0;
+    };
+
+} // namespace HCPEngine
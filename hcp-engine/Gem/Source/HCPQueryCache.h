@@ -0,0 +1,92 @@
+#pragma once
+
+#include <AzCore/base.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+namespace HCPEngine
+{
+    //! Validity tracking for the read-side query kernels' result caches
+    //! (HCPDocumentQuery, HCPBondQuery).
+    //!
+    //! The Workstation dashboards poll list/info/bonds every few seconds, and
+    //! each poll re-runs the same aggregate scans against Postgres. The query
+    //! kernels keep small per-instance result caches — one kernel per socket
+    //! worker, so the caches themselves need no locking — validated two ways:
+    //!
+    //!   - store generation: every PBM write path (StorePBM, FillPBMData,
+    //!     UpdatePBMDelta, metadata writes, document deletes) bumps a
+    //!     process-wide counter. A cached result stamped with an older
+    //!     generation is stale, whichever worker did the writing.
+    //!   - TTL: bounds staleness against writers in OTHER processes (psql,
+    //!     batch scripts), which the generation counter cannot see.
+    //!
+    //! HCP_QUERY_CACHE_TTL_MS overrides the TTL (default 2000);
+    //! HCP_QUERY_CACHE=0 disables caching entirely.
+    namespace QueryCache
+    {
+        inline std::atomic<AZ::u64>& Generation()
+        {
+            static std::atomic<AZ::u64> s_generation{1};
+            return s_generation;
+        }
+
+        //! Current store generation (read side).
+        inline AZ::u64 CurrentGeneration()
+        {
+            return Generation().load(std::memory_order_acquire);
+        }
+
+        //! Record a store mutation — called by the write paths after a
+        //! successful commit. Cheap enough to call unconditionally.
+        inline void BumpGeneration()
+        {
+            Generation().fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        //! Cache TTL in milliseconds; 0 disables caching.
+        inline AZ::s64 TtlMs()
+        {
+            static const AZ::s64 ttl = []() -> AZ::s64 {
+                const char* off = std::getenv("HCP_QUERY_CACHE");
+                if (off && off[0] == '0')
+                {
+                    return 0;
+                }
+                const char* ms = std::getenv("HCP_QUERY_CACHE_TTL_MS");
+                return ms ? static_cast<AZ::s64>(atoll(ms)) : 2000;
+            }();
+            return ttl;
+        }
+
+        inline AZ::s64 NowMs()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        //! Stamp carried by each cached result. A result is served from cache
+        //! only while Fresh() — same generation and within the TTL.
+        struct Stamp
+        {
+            AZ::u64 generation = 0;
+            AZ::s64 fetchedMs = 0;
+
+            bool Fresh() const
+            {
+                const AZ::s64 ttl = TtlMs();
+                return ttl > 0
+                    && generation == CurrentGeneration()
+                    && (NowMs() - fetchedMs) <= ttl;
+            }
+
+            static Stamp Now()
+            {
+                return Stamp{ CurrentGeneration(), NowMs() };
+            }
+        };
+    } // namespace QueryCache
+
+} // namespace HCPEngine
@@ -73,9 +73,15 @@ namespace HCPEngine
     //! Tracking slot for a stream run loaded into a workspace buffer.
     struct StreamRunSlot
     {
+        //! vocabEntry sentinels: identity is bound by POSITION at load time
+        //! (claim 606/613 — reattached by slot on readback, see Pack/PackKernel.h).
+        static constexpr AZ::u32 ENTRY_UNBOUND = 0xFFFFFFFF;  // loaded without a pack — identify via tierLookup
+        static constexpr AZ::u32 ENTRY_NONE    = 0xFFFFFFFE;  // bound against a pack, word not in it
+
         AZ::u32 runIndex;          // Index into the original runs array
         AZ::u32 bufferStart;       // First particle index in the buffer
         AZ::u32 charCount;         // Number of characters (= particles)
+        AZ::u32 vocabEntry = ENTRY_UNBOUND;  // Pack entry index bound at load (or sentinel)
         AZStd::string runText;     // Lowercase run text (for match lookup)
         bool resolved = false;
         AZStd::string matchedWord;
@@ -0,0 +1,160 @@
+#pragma once
+
+// ResolveArena — bump allocator for per-resolve scratch.
+//
+// A single Resolve() builds and tears down dozens of index vectors
+// (classification lists, broadphase candidate sets, dep-resolution queues),
+// each paying the general-purpose allocator per document. The arena hands out
+// memory by bumping a pointer through retained blocks; individual frees are
+// no-ops and the whole arena is reclaimed at once by Reset() at the top of the
+// next Resolve(). Blocks are kept across resets, so after the first document
+// of a batch run the scratch path does no heap allocation at all.
+//
+// Single-threaded by design: the arena backs only the sequential stages of
+// Resolve(). Worker-pool threads (HCP_RESOLVE_WORKERS > 1) keep their own
+// locals and never touch it.
+
+#include <cstddef>
+#include <memory>
+#include <vector>          // std::vector — arena scratch is off the AZ pool
+
+namespace HCPEngine
+{
+    template<class T> class ArenaStlAllocator;
+
+    class ResolveArena
+    {
+    public:
+        //! Block granularity. A typical document's scratch fits in one block;
+        //! an oversized request gets an exact-fit block of its own.
+        static constexpr size_t BLOCK_SIZE = 1u << 20;   // 1 MB
+
+        //! Bump-allocate `bytes` with the given alignment (power of two).
+        void* Allocate(size_t bytes, size_t alignment)
+        {
+            if (bytes == 0)
+                bytes = 1;
+
+            // Walk forward from the active block; most requests hit it directly.
+            // Slack left behind in earlier blocks is reclaimed at Reset().
+            for (; m_activeBlock < m_blocks.size(); ++m_activeBlock)
+            {
+                Block& b = m_blocks[m_activeBlock];
+                size_t aligned = (b.used + alignment - 1) & ~(alignment - 1);
+                if (aligned + bytes <= b.capacity)
+                {
+                    b.used = aligned + bytes;
+                    Account(bytes);
+                    return b.data.get() + aligned;
+                }
+            }
+
+            Block nb;
+            nb.capacity = bytes > BLOCK_SIZE ? bytes : BLOCK_SIZE;
+            nb.data.reset(new unsigned char[nb.capacity]);
+            nb.used = bytes;
+            m_blocks.push_back(std::move(nb));
+            m_activeBlock = m_blocks.size() - 1;
+            Account(bytes);
+            return m_blocks.back().data.get();
+        }
+
+        //! Rewind every block without freeing — capacity grown during document N
+        //! is reused allocation-free by document N+1.
+        void Reset()
+        {
+            for (Block& b : m_blocks)
+                b.used = 0;
+            m_activeBlock = 0;
+            m_bytesUsed = 0;
+        }
+
+        //! Free all blocks (shutdown).
+        void Release()
+        {
+            m_blocks.clear();
+            m_blocks.shrink_to_fit();
+            m_activeBlock = 0;
+            m_bytesUsed = 0;
+            m_highWater = 0;
+        }
+
+        size_t BytesUsed() const { return m_bytesUsed; }
+        size_t HighWater() const { return m_highWater; }
+
+        //! Convenience: an empty std::vector whose storage lives in this arena.
+        template<class T>
+        std::vector<T, ArenaStlAllocator<T>> MakeVector();
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<unsigned char[]> data;
+            size_t capacity = 0;
+            size_t used = 0;
+        };
+
+        void Account(size_t bytes)
+        {
+            m_bytesUsed += bytes;
+            if (m_bytesUsed > m_highWater)
+                m_highWater = m_bytesUsed;
+        }
+
+        std::vector<Block> m_blocks;
+        size_t m_activeBlock = 0;
+        size_t m_bytesUsed   = 0;
+        size_t m_highWater   = 0;
+    };
+
+    //! Minimal std-allocator adapter over ResolveArena. deallocate() is a no-op;
+    //! memory comes back wholesale via ResolveArena::Reset(). Two adapters
+    //! compare equal iff they point at the same arena, so container moves
+    //! between arena vectors are pointer swaps.
+    template<class T>
+    class ArenaStlAllocator
+    {
+    public:
+        using value_type = T;
+
+        explicit ArenaStlAllocator(ResolveArena* arena) : m_arena(arena) {}
+
+        template<class U>
+        ArenaStlAllocator(const ArenaStlAllocator<U>& other) : m_arena(other.GetArena()) {}
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t) {}   // reclaimed by Reset()
+
+        ResolveArena* GetArena() const { return m_arena; }
+
+    private:
+        ResolveArena* m_arena = nullptr;
+    };
+
+    template<class A, class B>
+    bool operator==(const ArenaStlAllocator<A>& a, const ArenaStlAllocator<B>& b)
+    {
+        return a.GetArena() == b.GetArena();
+    }
+
+    template<class A, class B>
+    bool operator!=(const ArenaStlAllocator<A>& a, const ArenaStlAllocator<B>& b)
+    {
+        return !(a == b);
+    }
+
+    //! std::vector whose storage lives in a ResolveArena.
+    template<class T>
+    using ArenaVector = std::vector<T, ArenaStlAllocator<T>>;
+
+    template<class T>
+    std::vector<T, ArenaStlAllocator<T>> ResolveArena::MakeVector()
+    {
+        return std::vector<T, ArenaStlAllocator<T>>(ArenaStlAllocator<T>(this));
+    }
+
+} // namespace HCPEngine
@@ -0,0 +1,171 @@
+#pragma once
+
+// ResolveStats — hot-path instrumentation for the resolve pipeline.
+//
+// When a document resolves slowly we need to know WHERE the time went:
+// LMDB slice feeds, Postgres warm-batch fetches, settle steps, broadphase
+// strips, or the length cycles themselves. Each stage records into a set of
+// monotonic counters plus a log2 microsecond histogram; a snapshot of the
+// whole table is served by the socket server's {"action":"stats"} response.
+//
+// Cost model: one steady_clock read on stage entry and exit plus a handful
+// of relaxed atomic adds — nothing runs when the pipeline is idle, and no
+// lock is ever taken. Counters are process-lifetime and never reset, so two
+// snapshots diffed against each other give a rate over any interval.
+// Safe from the resolve worker pool and the envelope prefetch lane alike.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace HCPEngine
+{
+    //! One timed region of the resolve pipeline. Keep this list short and
+    //! coarse — stages are for attributing document time, not micro-profiling.
+    enum class ResolveStage : uint32_t
+    {
+        ResolveTotal,    //!< BedManager::Resolve, end to end
+        LengthCycle,     //!< ResolveLengthCycle (one word length, one pass)
+        Broadphase,      //!< RunBroadphaseFilter (partial-match strips)
+        Settle,          //!< Workspace::BeginSimulate (SoA settle steps)
+        LmdbFeed,        //!< EnvelopeManager::FeedSlice (Postgres -> LMDB window)
+        WarmBatch,       //!< EnvelopeManager::QueryWarmBatch (per-length fetch)
+        EnvelopeQuery,   //!< EnvelopeManager::QueryEnvelopeEntries (signal prefetch)
+
+        Count
+    };
+
+    class ResolveStats
+    {
+    public:
+        //! log2 microsecond buckets: bucket i covers [2^i, 2^(i+1)) us.
+        //! Bucket 0 is sub-2us, bucket 15 is everything over ~32 ms.
+        static constexpr size_t HIST_BUCKETS = 16;
+
+        static constexpr const char* StageName(ResolveStage stage)
+        {
+            switch (stage)
+            {
+            case ResolveStage::ResolveTotal:  return "resolve_total";
+            case ResolveStage::LengthCycle:   return "length_cycle";
+            case ResolveStage::Broadphase:    return "broadphase";
+            case ResolveStage::Settle:        return "settle";
+            case ResolveStage::LmdbFeed:      return "lmdb_feed";
+            case ResolveStage::WarmBatch:     return "warm_batch";
+            case ResolveStage::EnvelopeQuery: return "envelope_query";
+            default:                          return "unknown";
+            }
+        }
+
+        //! Process-wide instance. Every pipeline thread records into the same
+        //! table; relaxed atomics are sufficient because each field is an
+        //! independent monotonic accumulator.
+        static ResolveStats& Get()
+        {
+            static ResolveStats s_instance;
+            return s_instance;
+        }
+
+        void Record(ResolveStage stage, uint64_t micros)
+        {
+            StageSlot& slot = m_stages[static_cast<size_t>(stage)];
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            slot.totalUs.fetch_add(micros, std::memory_order_relaxed);
+
+            uint64_t prevMax = slot.maxUs.load(std::memory_order_relaxed);
+            while (micros > prevMax &&
+                   !slot.maxUs.compare_exchange_weak(prevMax, micros, std::memory_order_relaxed))
+            {
+            }
+
+            size_t bucket = 0;
+            for (uint64_t v = micros >> 1; v != 0 && bucket < HIST_BUCKETS - 1; v >>= 1)
+                ++bucket;
+            slot.hist[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! Plain-data copy of one stage for serialization (no atomics held).
+        struct StageSnapshot
+        {
+            uint64_t count = 0;
+            uint64_t totalUs = 0;
+            uint64_t maxUs = 0;
+            uint64_t hist[HIST_BUCKETS] = {};
+        };
+
+        //! Settle-step budget vs steps actually run (convergence early exit,
+        //! SettleKernelSimd.h). Monotonic totals — same diff-two-snapshots
+        //! model as the stages; 1 - actual/budget is the work saved. GPU
+        //! submits run their full budget and record budget == actual.
+        void RecordSettleSteps(uint64_t budget, uint64_t actual)
+        {
+            m_settleBudgetSteps.fetch_add(budget, std::memory_order_relaxed);
+            m_settleActualSteps.fetch_add(actual, std::memory_order_relaxed);
+        }
+
+        struct SettleStepsSnapshot
+        {
+            uint64_t budget = 0;
+            uint64_t actual = 0;
+        };
+
+        SettleStepsSnapshot SnapshotSettleSteps() const
+        {
+            SettleStepsSnapshot out;
+            out.budget = m_settleBudgetSteps.load(std::memory_order_relaxed);
+            out.actual = m_settleActualSteps.load(std::memory_order_relaxed);
+            return out;
+        }
+
+        StageSnapshot Snapshot(ResolveStage stage) const
+        {
+            const StageSlot& slot = m_stages[static_cast<size_t>(stage)];
+            StageSnapshot out;
+            out.count = slot.count.load(std::memory_order_relaxed);
+            out.totalUs = slot.totalUs.load(std::memory_order_relaxed);
+            out.maxUs = slot.maxUs.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < HIST_BUCKETS; ++i)
+                out.hist[i] = slot.hist[i].load(std::memory_order_relaxed);
+            return out;
+        }
+
+    private:
+        struct StageSlot
+        {
+            std::atomic<uint64_t> count{0};
+            std::atomic<uint64_t> totalUs{0};
+            std::atomic<uint64_t> maxUs{0};
+            std::atomic<uint64_t> hist[HIST_BUCKETS]{};
+        };
+
+        StageSlot m_stages[static_cast<size_t>(ResolveStage::Count)];
+        std::atomic<uint64_t> m_settleBudgetSteps{0};
+        std::atomic<uint64_t> m_settleActualSteps{0};
+    };
+
+    //! RAII stage timer: construct at the top of the region, records on scope
+    //! exit. Early returns and exceptions are attributed like normal exits.
+    class ScopedStageTimer
+    {
+    public:
+        explicit ScopedStageTimer(ResolveStage stage)
+            : m_stage(stage)
+            , m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedStageTimer()
+        {
+            const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_start).count();
+            ResolveStats::Get().Record(m_stage, static_cast<uint64_t>(micros));
+        }
+
+        ScopedStageTimer(const ScopedStageTimer&) = delete;
+        ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+    private:
+        ResolveStage m_stage;
+        std::chrono::steady_clock::time_point m_start;
+    };
+}
@@ -0,0 +1,453 @@
+#include "HCPShardRouter.h"
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace HCPEngine
+{
+    // ---- Wire helpers ------------------------------------------------------
+    // Same framing as HCPSocketServer's client side: 4-byte big-endian length
+    // + JSON payload. The router only ever speaks v1 to its backends, so a
+    // reply frame with the binary bit set (or over the 64 MB cap) is a
+    // protocol violation and drops the connection.
+
+    static bool ReadExact(int fd, void* buf, size_t len)
+    {
+        auto* p = static_cast<uint8_t*>(buf);
+        size_t remaining = len;
+        while (remaining > 0)
+        {
+            ssize_t n = ::recv(fd, p, remaining, 0);
+            if (n <= 0) return false;
+            p += n;
+            remaining -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    static bool WriteExact(int fd, const void* buf, size_t len)
+    {
+        auto* p = static_cast<const uint8_t*>(buf);
+        size_t remaining = len;
+        while (remaining > 0)
+        {
+            ssize_t n = ::send(fd, p, remaining, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            p += n;
+            remaining -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    static bool ReadFrame(int fd, AZStd::string& out)
+    {
+        uint32_t lenNet;
+        if (!ReadExact(fd, &lenNet, 4)) return false;
+        uint32_t len = ntohl(lenNet);
+        if (len > 64 * 1024 * 1024) return false;   // also rejects binary frames
+        out.resize(len);
+        return ReadExact(fd, out.data(), len);
+    }
+
+    static bool WriteFrame(int fd, const AZStd::string& msg)
+    {
+        uint32_t lenNet = htonl(static_cast<uint32_t>(msg.size()));
+        if (!WriteExact(fd, &lenNet, 4)) return false;
+        return WriteExact(fd, msg.data(), msg.size());
+    }
+
+    // FNV-1a, 64-bit — the ring only needs a stable, well-mixed hash, not a
+    // cryptographic one.
+    static AZ::u64 Fnv1a(const char* s, size_t n)
+    {
+        AZ::u64 h = 14695981039346656037ull;
+        for (size_t i = 0; i < n; ++i)
+        {
+            h ^= static_cast<uint8_t>(s[i]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    static AZStd::string ErrorReply(const char* message)
+    {
+        rapidjson::StringBuffer sb;
+        rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+        w.StartObject();
+        w.Key("status"); w.String("error");
+        w.Key("message"); w.String(message);
+        w.EndObject();
+        return AZStd::string(sb.GetString(), sb.GetSize());
+    }
+
+    static bool ReplyIsOk(const AZStd::string& reply)
+    {
+        rapidjson::Document d;
+        d.Parse(reply.c_str());
+        return !d.HasParseError() && d.IsObject()
+            && d.HasMember("status") && d["status"].IsString()
+            && strcmp(d["status"].GetString(), "ok") == 0;
+    }
+
+    // ---- Construction ------------------------------------------------------
+
+    std::unique_ptr<HCPShardRouter> HCPShardRouter::CreateFromEnv()
+    {
+        const char* env = std::getenv("HCP_SHARD_BACKENDS");
+        if (!env || !*env)
+        {
+            return nullptr;
+        }
+
+        auto router = std::unique_ptr<HCPShardRouter>(new HCPShardRouter());
+
+        const char* p = env;
+        while (*p)
+        {
+            const char* end = strchr(p, ',');
+            AZStd::string spec(p, end ? static_cast<size_t>(end - p) : strlen(p));
+            p = end ? end + 1 : p + spec.size();
+
+            while (!spec.empty() && spec.front() == ' ') spec.erase(spec.begin());
+            while (!spec.empty() && spec.back() == ' ') spec.pop_back();
+            if (spec.empty()) continue;
+
+            const size_t colon = spec.rfind(':');
+            const int port = (colon != AZStd::string::npos)
+                ? atoi(spec.c_str() + colon + 1) : 0;
+            if (colon == AZStd::string::npos || colon == 0 || port <= 0 || port > 65535)
+            {
+                fprintf(stderr, "[HCPShardRouter] Bad backend spec '%s' in "
+                    "HCP_SHARD_BACKENDS (want host:port) — router mode disabled\n",
+                    spec.c_str());
+                fflush(stderr);
+                return nullptr;
+            }
+
+            auto backend = std::make_unique<Backend>();
+            backend->label = spec;
+            backend->host = spec.substr(0, colon);
+            backend->port = port;
+            router->m_backends.push_back(std::move(backend));
+        }
+
+        if (router->m_backends.empty())
+        {
+            return nullptr;
+        }
+
+        // 64 virtual points per backend spread each shard around the ring, so
+        // removing one redistributes its keys roughly evenly instead of
+        // dumping them all on its clockwise neighbour.
+        static constexpr int VIRTUAL_POINTS = 64;
+        for (size_t i = 0; i < router->m_backends.size(); ++i)
+        {
+            for (int v = 0; v < VIRTUAL_POINTS; ++v)
+            {
+                char point[128];
+                const int len = snprintf(point, sizeof(point), "%s#%d",
+                    router->m_backends[i]->label.c_str(), v);
+                router->m_ring.push_back({ Fnv1a(point, static_cast<size_t>(len)),
+                    static_cast<AZ::u32>(i) });
+            }
+        }
+        std::sort(router->m_ring.begin(), router->m_ring.end());
+
+        for (const auto& b : router->m_backends)
+        {
+            fprintf(stderr, "[HCPShardRouter] Shard backend: %s\n", b->label.c_str());
+        }
+        fflush(stderr);
+        return router;
+    }
+
+    HCPShardRouter::~HCPShardRouter()
+    {
+        for (auto& b : m_backends)
+        {
+            if (b->fd >= 0)
+            {
+                ::close(b->fd);
+                b->fd = -1;
+            }
+        }
+    }
+
+    // ---- Shard selection ---------------------------------------------------
+
+    size_t HCPShardRouter::ShardForKey(const char* key, size_t len) const
+    {
+        const AZ::u64 h = Fnv1a(key, len);
+        auto it = std::lower_bound(m_ring.begin(), m_ring.end(),
+            AZStd::pair<AZ::u64, AZ::u32>{ h, 0 });
+        if (it == m_ring.end()) it = m_ring.begin();   // wrap past the top
+        return it->second;
+    }
+
+    size_t HCPShardRouter::NextRoundRobin()
+    {
+        return static_cast<size_t>(m_roundRobin.fetch_add(1) % m_backends.size());
+    }
+
+    // ---- Transport ---------------------------------------------------------
+
+    AZStd::string HCPShardRouter::Forward(size_t shard, const AZStd::string& payload)
+    {
+        Backend& b = *m_backends[shard];
+        std::lock_guard<std::mutex> lock(b.mutex);
+
+        // One reconnect retry: a backend restart leaves a dead persistent
+        // connection behind, and the first write after it fails cleanly.
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            if (b.fd < 0)
+            {
+                char portStr[16];
+                snprintf(portStr, sizeof(portStr), "%d", b.port);
+                addrinfo hints{};
+                hints.ai_family = AF_UNSPEC;
+                hints.ai_socktype = SOCK_STREAM;
+                addrinfo* res = nullptr;
+                if (::getaddrinfo(b.host.c_str(), portStr, &hints, &res) != 0)
+                {
+                    fprintf(stderr, "[HCPShardRouter] Cannot resolve shard '%s'\n",
+                        b.label.c_str());
+                    fflush(stderr);
+                    return AZStd::string();
+                }
+                for (addrinfo* ai = res; ai; ai = ai->ai_next)
+                {
+                    int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+                    if (fd < 0) continue;
+                    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+                    {
+                        int one = 1;
+                        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                        b.fd = fd;
+                        break;
+                    }
+                    ::close(fd);
+                }
+                ::freeaddrinfo(res);
+                if (b.fd < 0)
+                {
+                    fprintf(stderr, "[HCPShardRouter] Connect to shard '%s' failed: %s\n",
+                        b.label.c_str(), strerror(errno));
+                    fflush(stderr);
+                    return AZStd::string();
+                }
+            }
+
+            AZStd::string reply;
+            if (WriteFrame(b.fd, payload) && ReadFrame(b.fd, reply))
+            {
+                return reply;
+            }
+            ::close(b.fd);
+            b.fd = -1;
+        }
+
+        fprintf(stderr, "[HCPShardRouter] Shard '%s' dropped the connection twice\n",
+            b.label.c_str());
+        fflush(stderr);
+        return AZStd::string();
+    }
+
+    // ---- Routing -----------------------------------------------------------
+
+    AZStd::string HCPShardRouter::Route(const char* action, const rapidjson::Document& doc,
+        const AZStd::string& rawJson, int& sessionShard)
+    {
+        if (strcmp(action, "health") == 0 || strcmp(action, "stats") == 0)
+        {
+            return AggregateStatus(action, rawJson);
+        }
+        if (strcmp(action, "list") == 0)
+        {
+            return AggregateList(rawJson);
+        }
+
+        // Streaming ingest: ingest_begin picks the shard (by name, so
+        // re-ingests land on the document's owner) and pins the connection to
+        // it; the chunk/commit/abort actions are stateful on the backend and
+        // must all hit that one shard.
+        if (strcmp(action, "ingest_begin") == 0)
+        {
+            const size_t shard = (doc.HasMember("name") && doc["name"].IsString())
+                ? ShardForKey(doc["name"].GetString(), doc["name"].GetStringLength())
+                : NextRoundRobin();
+            AZStd::string reply = Forward(shard, rawJson);
+            if (reply.empty())
+            {
+                sessionShard = -1;
+                return ErrorReply("Shard unreachable");
+            }
+            sessionShard = ReplyIsOk(reply) ? static_cast<int>(shard) : -1;
+            return reply;
+        }
+        if (strcmp(action, "ingest_chunk") == 0 || strcmp(action, "ingest_commit") == 0
+            || strcmp(action, "ingest_abort") == 0)
+        {
+            if (sessionShard < 0 || static_cast<size_t>(sessionShard) >= m_backends.size())
+            {
+                return ErrorReply("No active ingest session");
+            }
+            AZStd::string reply = Forward(static_cast<size_t>(sessionShard), rawJson);
+            if (strcmp(action, "ingest_chunk") != 0)
+            {
+                sessionShard = -1;   // commit/abort end the session either way
+            }
+            return reply.empty() ? ErrorReply("Shard unreachable") : reply;
+        }
+
+        // Named work (ingest, phys_ingest, run_gutenberg, ...): consistent
+        // hash on the document name for ingest affinity.
+        if (doc.HasMember("name") && doc["name"].IsString())
+        {
+            const size_t shard = ShardForKey(doc["name"].GetString(),
+                doc["name"].GetStringLength());
+            AZStd::string reply = Forward(shard, rawJson);
+            return reply.empty() ? ErrorReply("Shard unreachable") : reply;
+        }
+
+        // Doc and job lookups: ids are minted per shard, so the router cannot
+        // compute the owner — scatter, first "ok" wins.
+        if (doc.HasMember("doc_id") || doc.HasMember("job_id"))
+        {
+            return ScatterFirstOk(rawJson);
+        }
+
+        // Stateless work (tokenize, phys_resolve, ...): any shard will do.
+        AZStd::string reply = Forward(NextRoundRobin(), rawJson);
+        return reply.empty() ? ErrorReply("Shard unreachable") : reply;
+    }
+
+    AZStd::string HCPShardRouter::ScatterFirstOk(const AZStd::string& rawJson)
+    {
+        AZStd::string lastReply;
+        for (size_t i = 0; i < m_backends.size(); ++i)
+        {
+            AZStd::string reply = Forward(i, rawJson);
+            if (reply.empty()) continue;
+            if (ReplyIsOk(reply)) return reply;
+            lastReply = AZStd::move(reply);   // a real "not found" beats "unreachable"
+        }
+        return lastReply.empty() ? ErrorReply("All shards unreachable")
+                                 : lastReply;
+    }
+
+    AZStd::string HCPShardRouter::AggregateList(const AZStd::string& rawJson)
+    {
+        rapidjson::StringBuffer sb;
+        rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+        w.StartObject();
+        w.Key("status"); w.String("ok");
+
+        size_t up = 0;
+        AZ::u64 count = 0;
+        w.Key("documents");
+        w.StartArray();
+        for (size_t i = 0; i < m_backends.size(); ++i)
+        {
+            AZStd::string reply = Forward(i, rawJson);
+            if (reply.empty()) continue;
+            rapidjson::Document d;
+            d.Parse(reply.c_str());
+            if (d.HasParseError() || !d.IsObject()) continue;
+            ++up;
+            if (d.HasMember("documents") && d["documents"].IsArray())
+            {
+                for (const auto& entry : d["documents"].GetArray())
+                {
+                    entry.Accept(w);
+                    ++count;
+                }
+            }
+        }
+        w.EndArray();
+        w.Key("count"); w.Uint64(count);
+        w.Key("shards_total"); w.Uint64(m_backends.size());
+        w.Key("shards_up"); w.Uint64(up);
+        w.EndObject();
+        return AZStd::string(sb.GetString(), sb.GetSize());
+    }
+
+    AZStd::string HCPShardRouter::AggregateStatus(const char* action,
+        const AZStd::string& rawJson)
+    {
+        const bool isHealth = strcmp(action, "health") == 0;
+
+        rapidjson::StringBuffer sb;
+        rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+        w.StartObject();
+
+        size_t up = 0;
+        bool allReady = true;
+        AZ::u64 words = 0, labels = 0, chars = 0;
+
+        rapidjson::StringBuffer shardsSb;
+        rapidjson::Writer<rapidjson::StringBuffer> shardsW(shardsSb);
+        shardsW.StartObject();
+        for (size_t i = 0; i < m_backends.size(); ++i)
+        {
+            shardsW.Key(m_backends[i]->label.c_str());
+            AZStd::string reply = Forward(i, rawJson);
+            rapidjson::Document d;
+            if (!reply.empty()) d.Parse(reply.c_str());
+            if (reply.empty() || d.HasParseError() || !d.IsObject())
+            {
+                shardsW.StartObject();
+                shardsW.Key("status"); shardsW.String("error");
+                shardsW.Key("message"); shardsW.String("unreachable");
+                shardsW.EndObject();
+                allReady = false;
+                continue;
+            }
+            ++up;
+            d.Accept(shardsW);
+            if (isHealth)
+            {
+                allReady = allReady && d.HasMember("ready") && d["ready"].IsBool()
+                    && d["ready"].GetBool();
+                if (d.HasMember("words") && d["words"].IsUint64()) words += d["words"].GetUint64();
+                if (d.HasMember("labels") && d["labels"].IsUint64()) labels += d["labels"].GetUint64();
+                if (d.HasMember("chars") && d["chars"].IsUint64()) chars += d["chars"].GetUint64();
+            }
+        }
+        shardsW.EndObject();
+
+        w.Key("status"); w.String(up > 0 ? "ok" : "error");
+        if (up == 0)
+        {
+            w.Key("message"); w.String("All shards unreachable");
+        }
+        if (isHealth)
+        {
+            // Fleet totals: "ready" only when every shard answered ready, so
+            // a probe watching the router sees the weakest link.
+            w.Key("ready"); w.Bool(up == m_backends.size() && allReady);
+            w.Key("words"); w.Uint64(words);
+            w.Key("labels"); w.Uint64(labels);
+            w.Key("chars"); w.Uint64(chars);
+        }
+        w.Key("shards_total"); w.Uint64(m_backends.size());
+        w.Key("shards_up"); w.Uint64(up);
+        w.Key("shards"); w.RawValue(shardsSb.GetString(), shardsSb.GetSize(),
+            rapidjson::kObjectType);
+        w.EndObject();
+        return AZStd::string(sb.GetString(), sb.GetSize());
+    }
+
+} // namespace HCPEngine
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/utils.h>
+
+#include <rapidjson/document.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace HCPEngine
+{
+    //! Shard-routing front end for horizontal ingest scaling.
+    //!
+    //! One BedManager serializes resolution per daemon; past a point the only
+    //! way to ingest faster is more daemons. A daemon started with
+    //! HCP_SHARD_BACKENDS="host:port,host:port,..." becomes a router: it
+    //! accepts the standard length-prefixed JSON protocol and owns no engine
+    //! work of its own — every request is partitioned across the backends,
+    //! which are ordinary daemons speaking the same protocol.
+    //!
+    //! Routing policy, by request shape:
+    //!   - "name" present (ingest, phys_ingest, ingest_begin, ...): consistent
+    //!     hash on the name — re-ingests and stub fills land on the shard that
+    //!     holds the document, and adding a shard only moves ~1/N of the keys.
+    //!   - "doc_id" present (retrieve, info, bonds, ...): doc ids are minted
+    //!     by the owning shard, so the router scatters and returns the first
+    //!     "ok" reply (misses answer with an error and cost one starter-row
+    //!     probe each).
+    //!   - list: scatter-gather — per-shard document arrays merged, counts
+    //!     summed.
+    //!   - health / stats: scatter to all, aggregated under a "shards" object
+    //!     so one probe watches the whole fleet.
+    //!   - streaming ingest (ingest_chunk/commit/abort): pinned to the shard
+    //!     ingest_begin chose, carried in per-connection state.
+    //!   - everything else (tokenize, phys_resolve, ...): round-robin.
+    //!
+    //! Scope: v1 JSON only. The router answers "protocol" itself and never
+    //! negotiates v2 frames, compression, or the shm lane — bulk lanes are
+    //! point-to-point optimizations that don't survive a hop. job_status /
+    //! job_cancel scatter like doc_id lookups; job ids are per-shard, so two
+    //! shards can in principle both know an id — first answer wins.
+    //!
+    //! One persistent connection per backend, lazily opened, serialized by a
+    //! per-backend mutex; a dead backend costs one reconnect attempt per
+    //! request routed at it. A slow backend holds only the worker whose
+    //! request is on it — synchronous ingests block exactly as they would
+    //! against a single daemon.
+    class HCPShardRouter
+    {
+    public:
+        //! Build from HCP_SHARD_BACKENDS. Returns nullptr when the variable
+        //! is unset or empty (normal single-daemon mode).
+        static std::unique_ptr<HCPShardRouter> CreateFromEnv();
+
+        ~HCPShardRouter();
+
+        size_t BackendCount() const { return m_backends.size(); }
+
+        //! Route one request. `doc` is the parsed request (NOT in-situ — the
+        //! raw bytes must survive for forwarding), `rawJson` the exact bytes
+        //! to put on the wire. `sessionShard` is the connection's pinned
+        //! streaming-ingest shard (-1 = none); the router updates it across
+        //! ingest_begin/commit/abort.
+        AZStd::string Route(const char* action, const rapidjson::Document& doc,
+            const AZStd::string& rawJson, int& sessionShard);
+
+    private:
+        struct Backend
+        {
+            AZStd::string label;   // "host:port", stats key + ring seed
+            AZStd::string host;
+            int port = 0;
+            int fd = -1;
+            std::mutex mutex;      // serializes the persistent connection
+        };
+
+        HCPShardRouter() = default;
+
+        //! Forward one framed request to a shard and read the framed reply.
+        //! Empty return = transport failure (after one reconnect attempt).
+        AZStd::string Forward(size_t shard, const AZStd::string& payload);
+
+        size_t ShardForKey(const char* key, size_t len) const;
+        size_t NextRoundRobin();
+
+        AZStd::string ScatterFirstOk(const AZStd::string& rawJson);
+        AZStd::string AggregateList(const AZStd::string& rawJson);
+        AZStd::string AggregateStatus(const char* action, const AZStd::string& rawJson);
+
+        std::vector<std::unique_ptr<Backend>> m_backends;
+
+        //! Consistent-hash ring: 64 virtual points per backend, sorted by
+        //! hash; a key maps to the first point at or past its own hash.
+        AZStd::vector<AZStd::pair<AZ::u64, AZ::u32>> m_ring;
+
+        std::atomic<AZ::u64> m_roundRobin{0};
+    };
+
+} // namespace HCPEngine
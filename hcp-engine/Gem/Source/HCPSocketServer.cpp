@@ -6,9 +6,22 @@
 #include "HCPResolutionChamber.h"
 #include "HCPVocabBed.h"
 #include "HCPBondCompiler.h"
+#include "HCPDbConnection.h"
+#include "HCPDocumentQuery.h"
+#include "HCPDocVarQuery.h"
+#include "HCPBondQuery.h"
+#include "HCPPbmReader.h"
+#include "HCPDocBundle.h"
 #include "HCPEnvelopeManager.h"
+#include "HCPByteIngest.h"
 #include "HCPPhysIngest.h"
 #include "HCPGutenbergRunner.h"
+#include "HCPIngestBench.h"
+#include "HCPEulerReassembly.h"
+#include "HCPResolveStats.h"
+#include "HCPMemoryBudget.h"
+#include "HCPTextCache.h"
+#include "HCPShardRouter.h"
 
 #include <AzCore/Console/ILogger.h>
 
@@ -17,17 +30,160 @@
 #include <rapidjson/stringbuffer.h>
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <cstdlib>
 #include <cstring>
 #include <chrono>
 #include <fstream>
 #include <sys/resource.h>
 #include <sys/stat.h>
 
+#ifdef HCP_HAVE_LZ4
+#include <lz4.h>
+#endif
+
 namespace HCPEngine
 {
+    //! Per-worker DB connection and the query kernels bound to it. Read-only
+    //! actions run entirely on this, so they never contend with the engine's
+    //! shared connection while an ingest holds it.
+    struct SocketWorkerContext
+    {
+        HCPDbConnection db;
+        HCPDocumentQuery docQuery;
+        HCPDocVarQuery docVarQuery;
+        HCPBondQuery bondQuery;
+        HCPPbmReader pbmReader;
+
+        SocketWorkerContext()
+            : docQuery(db), docVarQuery(db), bondQuery(db), pbmReader(db) {}
+
+        //! Connect lazily, like the shared connection always has.
+        bool EnsureDb()
+        {
+            if (!db.IsConnected())
+            {
+                db.Connect();
+            }
+            return db.IsConnected();
+        }
+    };
+
+    //! Per-connection state for the streaming ingest actions (ingest_begin /
+    //! ingest_chunk / ingest_commit). Each chunk goes straight through the
+    //! byte-floor on arrival, so network receive overlaps segmentation and
+    //! peak memory is a chunk plus the run list — never the whole text.
+    struct SocketIngestSession
+    {
+        bool active = false;
+        ByteIngestStream stream;
+        AZStd::vector<CharRun> runs;
+        AZStd::string docName;
+        AZStd::string centuryCode = "AB";
+        AZStd::string catalog;
+        AZStd::string catalogId;
+        bool fictionFirst = true;
+
+        void Reset() { *this = SocketIngestSession(); }
+    };
+
+    //! Per-connection protocol state, negotiated by the "protocol" action.
+    //! Separate from SocketIngestSession because that resets on
+    //! ingest_begin/abort — a negotiated upgrade outlives ingest sessions.
+    //! Defaults keep v1 clients on JSON-everything.
+    struct SocketConnState
+    {
+        int version = 1;     // 1 = JSON-everything; 2 = binary bulk frames
+        bool lz4 = false;    // v2 only; true iff negotiated AND built with liblz4
+
+        // Same-host shared-memory lane (negotiated via "protocol" with
+        // "shm_bytes"; loopback peers only). Bulk payloads cross through the
+        // mapped region and the socket carries only control JSON — no copy
+        // through the kernel socket buffers. The server owns the region and
+        // unlinks it at connection teardown.
+        //! Router mode only: backend shard pinned by ingest_begin, so the
+        //! stateful chunk/commit/abort actions hit the same daemon. -1 = no
+        //! streaming ingest in flight on this connection.
+        int shardSession = -1;
+
+        AZStd::string shmName;
+        uint8_t* shmMap = nullptr;
+        size_t shmSize = 0;
+        int shmFd = -1;
+
+        void CloseShm()
+        {
+            if (shmMap) { ::munmap(shmMap, shmSize); shmMap = nullptr; }
+            if (shmFd >= 0) { ::close(shmFd); shmFd = -1; }
+            if (!shmName.empty()) { ::shm_unlink(shmName.c_str()); shmName.clear(); }
+            shmSize = 0;
+        }
+    };
+
+    // True when the connected peer is a loopback address — the only case
+    // where a shared-memory region is visible to both ends.
+    static bool PeerIsLoopback(int fd)
+    {
+        sockaddr_storage ss{};
+        socklen_t len = sizeof(ss);
+        if (::getpeername(fd, reinterpret_cast<sockaddr*>(&ss), &len) != 0)
+            return false;
+        if (ss.ss_family == AF_INET)
+            return (ntohl(reinterpret_cast<sockaddr_in*>(&ss)->sin_addr.s_addr) >> 24) == 127;
+        if (ss.ss_family == AF_INET6)
+        {
+            const auto* a6 = reinterpret_cast<sockaddr_in6*>(&ss);
+            if (IN6_IS_ADDR_LOOPBACK(&a6->sin6_addr)) return true;
+            if (IN6_IS_ADDR_V4MAPPED(&a6->sin6_addr)) return a6->sin6_addr.s6_addr[12] == 127;
+        }
+        return false;
+    }
+
+    //! One background ingest job (phys_ingest with "job": true). The handler
+    //! copies everything it needs out of the receive buffer at submit time;
+    //! the job thread owns the rest of the pipeline. States: Queued → Running
+    //! → Done/Failed, or → Cancelled from either of the first two (jobs abort
+    //! between phases only — see PhysIngestProgress).
+    struct IngestJob
+    {
+        enum class State : AZ::u8 { Queued, Running, Done, Failed, Cancelled };
+
+        static const char* StateName(State s)
+        {
+            switch (s)
+            {
+            case State::Queued:    return "queued";
+            case State::Running:   return "running";
+            case State::Done:      return "done";
+            case State::Failed:    return "failed";
+            case State::Cancelled: return "cancelled";
+            default:               return "unknown";
+            }
+        }
+
+        uint64_t id = 0;
+        std::atomic<State> state{State::Queued};
+        PhysIngestProgress progress;
+
+        // Inputs — owned copies (the receive buffer dies with the request).
+        AZStd::string text;
+        AZStd::string docName;
+        AZStd::string centuryCode = "AB";
+        AZStd::string catalog;
+        AZStd::string catalogId;
+        bool fictionFirst = true;
+        bool isWorkingDoc = false;
+
+        // Output — valid once state is Done or Failed (the job thread fills
+        // it before the terminal state store; readers load state first).
+        PhysIngestResult result;
+    };
+
     // Read exactly N bytes from a socket. Returns false on error/disconnect.
     static bool ReadExact(int fd, void* buf, size_t len)
     {
@@ -80,6 +236,196 @@ namespace HCPEngine
         return WriteExact(fd, msg.data(), msg.size());
     }
 
+    // ---- Protocol v2 binary frames ----------------------------------------
+    // A binary frame reuses the 4-byte length prefix with its top bit set
+    // (v1 payloads are capped at 64 MB, so the bit is free for framing):
+    //   [len | 0x80000000][type u8][flags u8][raw_len u32 BE][body]
+    // len counts everything after the prefix; raw_len is the uncompressed
+    // body size. Binary frames only ever go OUT, and only to a connection
+    // that negotiated v2 — requests stay JSON in both directions.
+
+    static constexpr uint32_t FRAME_BINARY_BIT = 0x80000000u;
+    static constexpr uint8_t  FRAME_TYPE_TEXT  = 0x01;   // raw UTF-8 document text
+    static constexpr uint8_t  FRAME_FLAG_LZ4   = 0x01;   // body is LZ4 block-compressed
+
+    // One binary frame: compress if the connection negotiated it AND it
+    // actually shrinks the body (already-compressed payloads ship raw).
+    static bool WriteBinaryFrame(int fd, uint8_t type, const char* payload,
+        size_t payloadLen, bool tryLz4)
+    {
+        const char* body = payload;
+        size_t bodyLen = payloadLen;
+        uint8_t flags = 0;
+
+        AZStd::vector<char> compressed;   // must outlive the writes below
+#ifdef HCP_HAVE_LZ4
+        if (tryLz4 && payloadLen > 0 && payloadLen <= LZ4_MAX_INPUT_SIZE)
+        {
+            compressed.resize(static_cast<size_t>(
+                LZ4_compressBound(static_cast<int>(payloadLen))));
+            const int n = LZ4_compress_default(payload, compressed.data(),
+                static_cast<int>(payloadLen), static_cast<int>(compressed.size()));
+            if (n > 0 && static_cast<size_t>(n) < payloadLen)
+            {
+                body = compressed.data();
+                bodyLen = static_cast<size_t>(n);
+                flags |= FRAME_FLAG_LZ4;
+            }
+        }
+#else
+        (void)tryLz4;
+#endif
+
+        uint8_t header[10];
+        const uint32_t lenNet = htonl(static_cast<uint32_t>(bodyLen + 6) | FRAME_BINARY_BIT);
+        memcpy(header, &lenNet, 4);
+        header[4] = type;
+        header[5] = flags;
+        const uint32_t rawNet = htonl(static_cast<uint32_t>(payloadLen));
+        memcpy(header + 6, &rawNet, 4);
+
+        if (!WriteExact(fd, header, sizeof(header))) return false;
+        return bodyLen == 0 || WriteExact(fd, body, bodyLen);
+    }
+
+    // ---- Streamed large replies -------------------------------------------
+    // The wire format is length-prefixed, so a streamed reply needs its exact
+    // body size up front: one escape-measuring scan, then the payload is
+    // escaped through a fixed window straight into socket writes. Reply
+    // memory is bounded by the window regardless of document size.
+
+    // Bytes the JSON escaper will emit for s[0..n). Must stay in lockstep
+    // with WriteEscapedStream below (rapidjson-compatible escaping: quote,
+    // backslash, the short control escapes, \u00XX for the rest of <0x20).
+    static size_t JsonEscapedLength(const char* s, size_t n)
+    {
+        size_t len = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const unsigned char c = static_cast<unsigned char>(s[i]);
+            if (c == '"' || c == '\\')
+                len += 2;
+            else if (c >= 0x20)
+                len += 1;
+            else if (c == '\b' || c == '\t' || c == '\n' || c == '\f' || c == '\r')
+                len += 2;
+            else
+                len += 6;
+        }
+        return len;
+    }
+
+    // Escape s[0..n) through a fixed window into socket writes.
+    static bool WriteEscapedStream(int fd, const char* s, size_t n)
+    {
+        static constexpr size_t WINDOW = 64 * 1024;
+        char buf[WINDOW];
+        size_t fill = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (fill + 6 > WINDOW)   // worst case one char expands to \u00XX
+            {
+                if (!WriteExact(fd, buf, fill)) return false;
+                fill = 0;
+            }
+            const unsigned char c = static_cast<unsigned char>(s[i]);
+            if (c == '"' || c == '\\')
+            {
+                buf[fill++] = '\\';
+                buf[fill++] = static_cast<char>(c);
+            }
+            else if (c >= 0x20)
+            {
+                buf[fill++] = static_cast<char>(c);
+            }
+            else if (c == '\b') { buf[fill++] = '\\'; buf[fill++] = 'b'; }
+            else if (c == '\t') { buf[fill++] = '\\'; buf[fill++] = 't'; }
+            else if (c == '\n') { buf[fill++] = '\\'; buf[fill++] = 'n'; }
+            else if (c == '\f') { buf[fill++] = '\\'; buf[fill++] = 'f'; }
+            else if (c == '\r') { buf[fill++] = '\\'; buf[fill++] = 'r'; }
+            else
+            {
+                static const char hex[] = "0123456789ABCDEF";
+                buf[fill++] = '\\'; buf[fill++] = 'u';
+                buf[fill++] = '0';  buf[fill++] = '0';
+                buf[fill++] = hex[c >> 4];
+                buf[fill++] = hex[c & 0xF];
+            }
+        }
+        return fill == 0 || WriteExact(fd, buf, fill);
+    }
+
+    // One length-prefixed reply of head + escape(payload) + tail, where only
+    // head and tail are materialized. The prefix and head go out in a single
+    // writev so small replies still cost one syscall up front.
+    static bool WriteMessageStreamed(int fd, const AZStd::string& head,
+        const char* payload, size_t payloadLen, const AZStd::string& tail)
+    {
+        const size_t total = head.size() + JsonEscapedLength(payload, payloadLen) + tail.size();
+        if (total > 64 * 1024 * 1024)   // mirror the receive-side sanity cap
+            return false;
+
+        uint32_t lenNet = htonl(static_cast<uint32_t>(total));
+        struct iovec iov[2];
+        iov[0].iov_base = &lenNet;
+        iov[0].iov_len = 4;
+        iov[1].iov_base = const_cast<char*>(head.data());
+        iov[1].iov_len = head.size();
+
+        // writev with partial-write handling: fall back to WriteExact for
+        // whatever the first call left behind.
+        ssize_t sent = ::writev(fd, iov, 2);
+        if (sent < 0) return false;
+        size_t done = static_cast<size_t>(sent);
+        for (int v = 0; v < 2 && done > 0; ++v)
+        {
+            const size_t take = done < iov[v].iov_len ? done : iov[v].iov_len;
+            iov[v].iov_base = static_cast<char*>(iov[v].iov_base) + take;
+            iov[v].iov_len -= take;
+            done -= take;
+        }
+        for (int v = 0; v < 2; ++v)
+            if (iov[v].iov_len > 0 && !WriteExact(fd, iov[v].iov_base, iov[v].iov_len))
+                return false;
+
+        if (!WriteEscapedStream(fd, payload, payloadLen)) return false;
+        return WriteExact(fd, tail.data(), tail.size());
+    }
+
+    // Shared body of the phys_ingest-shaped "ok" reply — phys_ingest,
+    // ingest_commit, and job_status (done jobs) report identical fields.
+    // Writes into an object the caller has opened.
+    static void WriteIngestResultFields(rapidjson::Writer<rapidjson::StringBuffer>& w,
+        const PhysIngestResult& pir, const AZStd::string& docName)
+    {
+        w.Key("phase1_settled"); w.Uint(pir.phase1Settled);
+        w.Key("phase1_total");   w.Uint(pir.phase1Total);
+        w.Key("phase1_time_ms"); w.Double(static_cast<double>(pir.phase1TimeMs));
+        w.Key("total_runs");     w.Uint(pir.totalRuns);
+        w.Key("resolved");       w.Uint(pir.resolved);
+        w.Key("unresolved");     w.Uint(pir.unresolved);
+        if (pir.isWorkingDoc)
+        {
+            w.Key("mode");           w.String("working_doc");
+            w.Key("working_doc_id"); w.Int(pir.workingDocId);
+            w.Key("doc_name");       w.String(docName.c_str());
+            return;
+        }
+        w.Key("doc_id");          w.String(pir.docId.c_str());
+        w.Key("doc_pk");          w.Int(pir.docPk);
+        w.Key("doc_name");        w.String(docName.c_str());
+        if (pir.usedStub) { w.Key("stub_filled"); w.Bool(true); }
+        if (pir.incremental) { w.Key("incremental"); w.Bool(true); }
+        w.Key("resolve_time_ms"); w.Double(static_cast<double>(pir.resolveTimeMs));
+        w.Key("bond_types");      w.Uint64(pir.bondTypes);
+        w.Key("total_pairs");     w.Uint64(pir.totalPairs);
+        w.Key("unique_tokens");   w.Uint64(pir.uniqueTokens);
+        w.Key("total_slots");     w.Int(pir.totalSlots);
+        w.Key("positions_stored"); w.Bool(pir.positionsStored);
+        w.Key("entity_annotations"); w.Uint64(pir.entityAnnotations);
+    }
+
     HCPSocketServer::~HCPSocketServer()
     {
         Stop();
@@ -92,7 +438,30 @@ namespace HCPEngine
         m_engine = engine;
         m_listenAll = listenAll;
         m_stopRequested.store(false);
+
+        // Router mode: same protocol on the wire, but every request fans out
+        // to the HCP_SHARD_BACKENDS fleet instead of the local engine.
+        m_router = HCPShardRouter::CreateFromEnv();
+        if (m_router)
+        {
+            fprintf(stderr, "[HCPSocketServer] Shard router mode: %zu backends\n",
+                m_router->BackendCount());
+            fflush(stderr);
+        }
+
+        int workers = DEFAULT_WORKERS;
+        if (const char* wc = std::getenv("HCP_SOCKET_WORKERS"))
+        {
+            int v = atoi(wc);
+            if (v >= 1 && v <= 32) workers = v;
+        }
+        for (int i = 0; i < workers; ++i)
+        {
+            m_workers.emplace_back(&HCPSocketServer::WorkerThread, this);
+        }
+
         m_thread = std::thread(&HCPSocketServer::ListenerThread, this, port);
+        m_jobThread = std::thread(&HCPSocketServer::JobThread, this);
         return true;
     }
 
@@ -109,6 +478,29 @@ namespace HCPEngine
         {
             m_thread.join();
         }
+        m_queueCv.notify_all();
+        for (auto& worker : m_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+        m_jobCv.notify_all();
+        if (m_jobThread.joinable())
+        {
+            m_jobThread.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            for (int fd : m_pendingClients)
+            {
+                ::close(fd);
+            }
+            m_pendingClients.clear();
+        }
+        m_router.reset();   // closes the backend connections
         m_running.store(false);
     }
 
@@ -184,11 +576,13 @@ namespace HCPEngine
             fprintf(stderr, "[HCPSocketServer] Client connected\n");
             fflush(stderr);
 
-            HandleClient(clientFd);
-
-            ::close(clientFd);
-            fprintf(stderr, "[HCPSocketServer] Client disconnected\n");
-            fflush(stderr);
+            // Hand the client to the worker pool; the listener goes straight
+            // back to accept() so new clients are never behind a slow request.
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                m_pendingClients.push_back(clientFd);
+            }
+            m_queueCv.notify_one();
         }
 
         fprintf(stderr, "[HCPSocketServer] Accept loop exited (stopRequested=%d, listenFd=%d)\n",
@@ -197,8 +591,118 @@ namespace HCPEngine
         m_running.store(false);
     }
 
-    void HCPSocketServer::HandleClient(int clientFd)
+    void HCPSocketServer::WorkerThread()
+    {
+        // One connection + kernel set per worker, alive for the server's life.
+        SocketWorkerContext ctx;
+
+        while (true)
+        {
+            int clientFd = -1;
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_queueCv.wait(lock, [this] {
+                    return m_stopRequested.load() || !m_pendingClients.empty();
+                });
+                if (m_stopRequested.load() && m_pendingClients.empty())
+                {
+                    break;
+                }
+                clientFd = m_pendingClients.front();
+                m_pendingClients.pop_front();
+            }
+
+            HandleClient(clientFd, ctx);
+
+            ::close(clientFd);
+            fprintf(stderr, "[HCPSocketServer] Client disconnected\n");
+            fflush(stderr);
+        }
+    }
+
+    void HCPSocketServer::JobThread()
+    {
+        while (true)
+        {
+            std::shared_ptr<IngestJob> job;
+            {
+                std::unique_lock<std::mutex> lock(m_jobMutex);
+                m_jobCv.wait(lock, [this] {
+                    return m_stopRequested.load() || !m_jobQueue.empty();
+                });
+                if (m_stopRequested.load())
+                {
+                    break;   // still-queued jobs stay Queued — the daemon is going down
+                }
+                job = m_jobQueue.front();
+                m_jobQueue.pop_front();
+            }
+
+            IngestJob::State expected = IngestJob::State::Queued;
+            if (!job->state.compare_exchange_strong(expected, IngestJob::State::Running))
+            {
+                continue;   // cancelled while queued
+            }
+
+            // CRLF-normalize + byte-floor (mirrors PhysIngestText), then the
+            // shared back half with this job's progress handle.
+            job->progress.stage.store(PhysIngestProgress::Stage::ByteFloor);
+            AZStd::string normalized;
+            normalized.reserve(job->text.size());
+            for (char c : job->text)
+                if (c != '\r') normalized.push_back(c);
+
+            AZStd::vector<CharRun> runs = IngestBytes(
+                reinterpret_cast<const uint8_t*>(normalized.data()), normalized.size());
+            job->progress.bytesIngested.store(normalized.size());
+
+            {
+                // Jobs share the engine lane with direct phys_ingest /
+                // ingest_commit / run_gutenberg actions — one lane only.
+                std::lock_guard<std::mutex> engineLock(m_engineMutex);
+                job->result = PhysIngestRuns(runs, normalized.size(),
+                    job->isWorkingDoc ? job->text : AZStd::string(),
+                    job->docName, job->centuryCode, job->catalog, job->catalogId,
+                    job->fictionFirst, job->isWorkingDoc, m_engine, &job->progress);
+            }
+            job->text = AZStd::string();   // free the payload — only the result is polled
+
+            job->state.store(job->result.cancelled ? IngestJob::State::Cancelled
+                           : job->result.ok        ? IngestJob::State::Done
+                                                   : IngestJob::State::Failed);
+
+            fprintf(stderr, "[HCPSocketServer] Ingest job %llu ('%s'): %s\n",
+                (unsigned long long)job->id, job->docName.c_str(),
+                IngestJob::StateName(job->state.load()));
+            fflush(stderr);
+
+            // Prune oldest finished jobs beyond the retention cap; anything
+            // queued or running is never dropped.
+            {
+                std::lock_guard<std::mutex> lock(m_jobMutex);
+                while (m_jobs.size() > JOB_RETAIN_MAX)
+                {
+                    auto oldest = m_jobs.end();
+                    for (auto it = m_jobs.begin(); it != m_jobs.end(); ++it)
+                    {
+                        const IngestJob::State s = it->second->state.load();
+                        if (s == IngestJob::State::Queued || s == IngestJob::State::Running)
+                            continue;
+                        if (oldest == m_jobs.end() || it->first < oldest->first)
+                            oldest = it;
+                    }
+                    if (oldest == m_jobs.end()) break;
+                    m_jobs.erase(oldest);
+                }
+            }
+        }
+    }
+
+    void HCPSocketServer::HandleClient(int clientFd, SocketWorkerContext& ctx)
     {
+        SocketIngestSession session;   // streaming ingest state; dies with the connection
+        SocketConnState conn;          // negotiated protocol version; dies with the connection
+
         while (!m_stopRequested.load())
         {
             AZStd::string request;
@@ -207,18 +711,52 @@ namespace HCPEngine
                 break;  // Client disconnected or error
             }
 
-            AZStd::string response = ProcessRequest(request);
-            if (!WriteMessage(clientFd, response))
+            AZStd::string response = ProcessRequest(request, ctx, session, conn, clientFd);
+            // Empty response = the handler already streamed its reply.
+            if (!response.empty() && !WriteMessage(clientFd, response))
             {
                 break;  // Write error
             }
         }
+
+        conn.CloseShm();
     }
 
-    AZStd::string HCPSocketServer::ProcessRequest(const AZStd::string& json)
+    AZStd::string HCPSocketServer::ProcessRequest(AZStd::string& json, SocketWorkerContext& ctx,
+        SocketIngestSession& session, SocketConnState& conn, int clientFd)
     {
+        // ---- Router mode ----
+        // Forwarding needs the request's exact bytes, so the router parses a
+        // copy instead of in-situ (which unescapes the receive buffer in
+        // place). "protocol" is answered locally and pinned to v1 JSON: binary
+        // frames, compression and the shm lane are point-to-point lanes the
+        // router does not proxy.
+        if (m_router)
+        {
+            rapidjson::Document routed;
+            routed.Parse(json.c_str());
+            if (routed.HasParseError() || !routed.IsObject())
+            {
+                return R"({"status":"error","message":"Invalid JSON"})";
+            }
+            if (!routed.HasMember("action") || !routed["action"].IsString())
+            {
+                return R"({"status":"error","message":"Missing 'action' field"})";
+            }
+            const char* routedAction = routed["action"].GetString();
+            if (strcmp(routedAction, "protocol") == 0)
+            {
+                return R"({"status":"ok","version":1,"compression":"none"})";
+            }
+            return m_router->Route(routedAction, routed, json, conn.shardSession);
+        }
+
+        // In-situ parse: string values are views into the receive buffer, and
+        // escape sequences are unescaped in place only where they occur — a
+        // megabyte ingest payload is never duplicated by the JSON layer. The
+        // buffer outlives `doc` (HandleClient owns it for the whole request).
         rapidjson::Document doc;
-        doc.Parse(json.c_str(), json.size());
+        doc.ParseInsitu(json.data());
 
         if (doc.HasParseError() || !doc.IsObject())
         {
@@ -232,6 +770,72 @@ namespace HCPEngine
 
         const char* action = doc["action"].GetString();
 
+        // ---- protocol (v2 negotiation) ----
+        // The server clamps to what it supports and echoes the result; the
+        // client must honor the echo, not the request. Downgrading back to
+        // v1 mid-connection is allowed (version: 1).
+        if (strcmp(action, "protocol") == 0)
+        {
+            int requested = 1;
+            if (doc.HasMember("version") && doc["version"].IsInt())
+                requested = doc["version"].GetInt();
+
+            conn.version = (requested >= 2) ? 2 : 1;
+
+            bool wantLz4 = doc.HasMember("compression") && doc["compression"].IsString()
+                && strcmp(doc["compression"].GetString(), "lz4") == 0;
+#ifdef HCP_HAVE_LZ4
+            conn.lz4 = wantLz4 && conn.version >= 2;
+#else
+            (void)wantLz4;
+            conn.lz4 = false;
+#endif
+
+            // Same-host shared-memory lane, orthogonal to the version: a
+            // loopback peer may ask for a bulk-payload region ("shm_bytes").
+            // Re-negotiation replaces any previous region.
+            conn.CloseShm();
+            if (doc.HasMember("shm_bytes") && doc["shm_bytes"].IsUint64())
+            {
+                const uint64_t want = doc["shm_bytes"].GetUint64();
+                if (want > 0 && want <= 64ull * 1024 * 1024 && PeerIsLoopback(clientFd))
+                {
+                    static std::atomic<uint32_t> s_shmCounter{0};
+                    char name[64];
+                    snprintf(name, sizeof(name), "/hcp-sock-%d-%u",
+                        static_cast<int>(getpid()), s_shmCounter.fetch_add(1) + 1);
+                    int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+                    if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(want)) == 0)
+                    {
+                        void* map = ::mmap(nullptr, static_cast<size_t>(want),
+                            PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                        if (map != MAP_FAILED)
+                        {
+                            conn.shmName = name;
+                            conn.shmMap = static_cast<uint8_t*>(map);
+                            conn.shmSize = static_cast<size_t>(want);
+                            conn.shmFd = fd;
+                        }
+                    }
+                    if (!conn.shmMap && fd >= 0) { ::close(fd); ::shm_unlink(name); }
+                }
+            }
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            w.Key("version"); w.Int(conn.version);
+            w.Key("compression"); w.String(conn.lz4 ? "lz4" : "none");
+            if (conn.shmMap)
+            {
+                w.Key("shm_name"); w.String(conn.shmName.c_str());
+                w.Key("shm_bytes"); w.Uint64(conn.shmSize);
+            }
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
         // ---- health ----
         if (strcmp(action, "health") == 0)
         {
@@ -247,6 +851,76 @@ namespace HCPEngine
             return AZStd::string(sb.GetString(), sb.GetSize());
         }
 
+        // ---- stats ----
+        // Per-stage resolve timing: monotonic since process start, so callers
+        // diff two snapshots to get rates over an interval. hist buckets are
+        // log2 microseconds (bucket i = [2^i, 2^(i+1)) us).
+        if (strcmp(action, "stats") == 0)
+        {
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            w.Key("stages");
+            w.StartObject();
+            for (uint32_t s = 0; s < static_cast<uint32_t>(ResolveStage::Count); ++s)
+            {
+                const auto stage = static_cast<ResolveStage>(s);
+                const auto snap = ResolveStats::Get().Snapshot(stage);
+                w.Key(ResolveStats::StageName(stage));
+                w.StartObject();
+                w.Key("count"); w.Uint64(snap.count);
+                w.Key("total_ms"); w.Double(static_cast<double>(snap.totalUs) / 1000.0);
+                w.Key("avg_us"); w.Double(snap.count
+                    ? static_cast<double>(snap.totalUs) / static_cast<double>(snap.count) : 0.0);
+                w.Key("max_us"); w.Uint64(snap.maxUs);
+                w.Key("hist");
+                w.StartArray();
+                for (size_t b = 0; b < ResolveStats::HIST_BUCKETS; ++b)
+                    w.Uint64(snap.hist[b]);
+                w.EndArray();
+                w.EndObject();
+            }
+            w.EndObject();
+            // Settle-step budget vs steps actually run (convergence early
+            // exit); 1 - actual/budget is the settle work saved.
+            const auto settleSteps = ResolveStats::Get().SnapshotSettleSteps();
+            w.Key("settle_steps");
+            w.StartObject();
+            w.Key("budget"); w.Uint64(settleSteps.budget);
+            w.Key("actual"); w.Uint64(settleSteps.actual);
+            w.EndObject();
+            // Memory-budget accounting: per-component resident bytes vs the
+            // configured ceiling (HCP_MEM_BUDGET_MB; budget_bytes 0 means
+            // unbounded). rss_bytes is the whole process, file-backed pages
+            // included — the accounted components are the evictable slice.
+            {
+                w.Key("memory");
+                w.StartObject();
+                w.Key("budget_bytes"); w.Uint64(MemoryBudget::BudgetBytes());
+                w.Key("rss_bytes"); w.Uint64(MemoryBudget::ResidentBytes());
+                const auto components = MemoryBudget::Get().Snapshot();
+                AZ::u64 accounted = 0;
+                w.Key("components");
+                w.StartObject();
+                for (const auto& c : components)
+                {
+                    accounted += c.bytes;
+                    w.Key(c.name.c_str());
+                    w.StartObject();
+                    w.Key("bytes"); w.Uint64(c.bytes);
+                    w.Key("rebuild_cost"); w.String(MemoryBudget::CostName(c.cost));
+                    w.Key("evictable"); w.Bool(c.evictable);
+                    w.EndObject();
+                }
+                w.EndObject();
+                w.Key("accounted_bytes"); w.Uint64(accounted);
+                w.EndObject();
+            }
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
         // ---- retrieve ----
         if (strcmp(action, "retrieve") == 0)
         {
@@ -259,64 +933,292 @@ namespace HCPEngine
 
             auto t0 = std::chrono::high_resolution_clock::now();
 
-            // Load positions from DB — direct reconstruction
-            HCPDbConnection& db = m_engine->GetDbConnection();
-            if (!db.IsConnected())
+            // Editors re-open the same few documents constantly — serve repeat
+            // retrievals from the assembled-text cache (mmap'd side file,
+            // unlinked by re-ingest/delete) instead of re-paying the position
+            // load + reassembly. The view keeps the mapped bytes alive through
+            // the reply even if an ingest replaces the file mid-flight.
+            TextCache::View cachedText;
+            if (TextCache::Enabled())
             {
-                db.Connect();
-            }
-            if (!db.IsConnected())
-            {
-                return R"({"status":"error","message":"Database not available"})";
+                cachedText = TextCache::Open(docId);
             }
 
-            AZStd::vector<AZStd::string> words;
-            AZStd::vector<AZ::u32> posModifiers;
-            if (!m_engine->GetPbmReader().LoadPositionsWithModifiers(docId, m_engine->GetVocabulary(), words, posModifiers)
-                || words.empty())
+            AZStd::string text;
+            const char* textData = nullptr;
+            size_t textBytes = 0;
+            size_t tokenCount = 0;
+            double loadMs = 0.0;
+
+            if (cachedText)
             {
-                return R"({"status":"error","message":"Document not found or has no positions"})";
+                textData = cachedText.text;
+                textBytes = cachedText.size;
+                tokenCount = static_cast<size_t>(cachedText.tokens);
             }
+            else
+            {
+                // Load positions from DB on this worker's own connection
+                if (!ctx.EnsureDb())
+                {
+                    return R"({"status":"error","message":"Database not available"})";
+                }
 
-            auto tLoad = std::chrono::high_resolution_clock::now();
+                AZStd::vector<AZStd::string> words;
+                AZStd::vector<AZ::u32> posModifiers;
+                if (!ctx.pbmReader.LoadPositionsWithModifiers(docId, m_engine->GetVocabulary(), words, posModifiers)
+                    || words.empty())
+                {
+                    return R"({"status":"error","message":"Document not found or has no positions"})";
+                }
 
-            // Reconstruct text from pre-resolved words with stickiness rules + stored cap/morph modifiers
-            AZStd::string text = TokenIdsToText(words, &posModifiers);
+                auto tLoad = std::chrono::high_resolution_clock::now();
+
+                // Reconstruct text from pre-resolved words with stickiness rules + stored cap/morph modifiers
+                text = TokenIdsToText(words, &posModifiers);
+                loadMs = std::chrono::duration<double, std::milli>(tLoad - t0).count();
+
+                textData = text.data();
+                textBytes = text.size();
+                tokenCount = words.size();
+
+                if (TextCache::Enabled())
+                {
+                    TextCache::Put(docId, text.data(), text.size(), words.size());
+                }
+            }
 
             auto t1 = std::chrono::high_resolution_clock::now();
-            double loadMs = std::chrono::duration<double, std::milli>(tLoad - t0).count();
             double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
 
-            fprintf(stderr, "[HCPSocketServer] Retrieved '%s': %zu words -> %zu chars, %.1f ms\n",
-                docId.c_str(), words.size(), text.size(), totalMs);
+            fprintf(stderr, "[HCPSocketServer] Retrieved '%s': %zu words -> %zu chars, %.1f ms%s\n",
+                docId.c_str(), tokenCount, textBytes, totalMs,
+                cachedText ? " (cached)" : "");
             fflush(stderr);
 
+            // Same-host shm lane: the text lands in the mapped region and the
+            // reply carries only control fields — the payload never crosses
+            // the socket. Per-request opt-in ("shm": true); the client
+            // guarantees no other request of its own is in flight, so the
+            // region holds exactly this reply until the next opted-in request.
+            if (doc.HasMember("shm") && doc["shm"].IsBool() && doc["shm"].GetBool()
+                && conn.shmMap && textBytes <= conn.shmSize)
+            {
+                memcpy(conn.shmMap, textData, textBytes);
+                rapidjson::StringBuffer sb;
+                rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+                w.StartObject();
+                w.Key("status"); w.String("ok");
+                w.Key("shm"); w.Bool(true);
+                w.Key("text_bytes"); w.Uint64(textBytes);
+                w.Key("tokens"); w.Uint64(tokenCount);
+                w.Key("load_ms"); w.Double(loadMs);
+                w.Key("ms"); w.Double(totalMs);
+                w.EndObject();
+                return AZStd::string(sb.GetString(), sb.GetSize());
+            }
+
+            // Protocol v2: control fields as a normal JSON reply, then the
+            // text as ONE binary frame — no JSON escape on the way out, no
+            // unescape client-side, and (negotiated) LZ4 for WAN links.
+            if (conn.version >= 2)
+            {
+                rapidjson::StringBuffer sb;
+                rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+                w.StartObject();
+                w.Key("status"); w.String("ok");
+                w.Key("binary"); w.Bool(true);
+                w.Key("text_bytes"); w.Uint64(textBytes);
+                w.Key("tokens"); w.Uint64(tokenCount);
+                w.Key("load_ms"); w.Double(loadMs);
+                w.Key("ms"); w.Double(totalMs);
+                w.EndObject();
+                if (!WriteMessage(clientFd, AZStd::string(sb.GetString(), sb.GetSize()))
+                    || !WriteBinaryFrame(clientFd, FRAME_TYPE_TEXT, textData, textBytes, conn.lz4))
+                {
+                    fprintf(stderr, "[HCPSocketServer] Binary reply failed for '%s'\n",
+                        docId.c_str());
+                    fflush(stderr);
+                }
+                return AZStd::string();   // reply already on the wire
+            }
+
+            // Novel-sized replies stream: building the JSON reply in memory
+            // would hold a second (escaped) copy of the text per connection.
+            // Escape straight into socket writes through the fixed window.
+            static constexpr size_t STREAM_REPLY_THRESHOLD = 256 * 1024;
+            if (textBytes >= STREAM_REPLY_THRESHOLD)
+            {
+                const AZStd::string head = "{\"status\":\"ok\",\"text\":\"";
+                const AZStd::string tail = AZStd::string::format(
+                    "\",\"tokens\":%zu,\"load_ms\":%.3f,\"ms\":%.3f}",
+                    tokenCount, loadMs, totalMs);
+                if (!WriteMessageStreamed(clientFd, head, textData, textBytes, tail))
+                {
+                    fprintf(stderr, "[HCPSocketServer] Streamed reply failed for '%s'\n",
+                        docId.c_str());
+                    fflush(stderr);
+                }
+                return AZStd::string();   // reply already on the wire
+            }
+
             rapidjson::StringBuffer sb;
             rapidjson::Writer<rapidjson::StringBuffer> w(sb);
             w.StartObject();
             w.Key("status"); w.String("ok");
-            w.Key("text"); w.String(text.c_str(), static_cast<rapidjson::SizeType>(text.size()));
-            w.Key("tokens"); w.Uint64(words.size());
+            w.Key("text"); w.String(textData, static_cast<rapidjson::SizeType>(textBytes));
+            w.Key("tokens"); w.Uint64(tokenCount);
             w.Key("load_ms"); w.Double(loadMs);
             w.Key("ms"); w.Double(totalMs);
             w.EndObject();
             return AZStd::string(sb.GetString(), sb.GetSize());
         }
 
-        // ---- list ----
-        if (strcmp(action, "list") == 0)
+        // ---- retrieve_range ----
+        // Windowed retrieval: only slots [from_slot, from_slot + count) are
+        // loaded, resolved and reconstructed. Viewport-sized requests return
+        // in viewport-sized time regardless of document length — the
+        // Workstation pages novels through this instead of `retrieve`.
+        if (strcmp(action, "retrieve_range") == 0)
         {
-            HCPDbConnection& db = m_engine->GetDbConnection();
-            if (!db.IsConnected())
+            if (!doc.HasMember("doc_id") || !doc["doc_id"].IsString())
             {
-                db.Connect();
+                return R"({"status":"error","message":"Missing 'doc_id' field"})";
             }
-            if (!db.IsConnected())
+            if (!doc.HasMember("from_slot") || !doc["from_slot"].IsInt())
+            {
+                return R"({"status":"error","message":"Missing 'from_slot' field"})";
+            }
+            if (!doc.HasMember("count") || !doc["count"].IsInt())
+            {
+                return R"({"status":"error","message":"Missing 'count' field"})";
+            }
+
+            AZStd::string docId(doc["doc_id"].GetString(), doc["doc_id"].GetStringLength());
+            int fromSlot = doc["from_slot"].GetInt();
+            int count = doc["count"].GetInt();
+            if (fromSlot < 0 || count <= 0)
+            {
+                return R"({"status":"error","message":"from_slot/count out of range"})";
+            }
+
+            if (!ctx.EnsureDb())
             {
                 return R"({"status":"error","message":"Database not available"})";
             }
 
-            auto docs = m_engine->GetDocumentQuery().ListDocuments();
+            auto t0 = std::chrono::high_resolution_clock::now();
+
+            AZStd::vector<AZStd::string> words;
+            AZStd::vector<AZ::u32> posModifiers;
+            int totalSlots = 0;
+            if (!ctx.pbmReader.LoadPositionsRange(docId, m_engine->GetVocabulary(),
+                    fromSlot, count, words, posModifiers, totalSlots))
+            {
+                return R"({"status":"error","message":"Document not found or has no positions"})";
+            }
+
+            AZStd::string text = TokenIdsToText(words, &posModifiers);
+            double totalMs = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - t0).count();
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status");      w.String("ok");
+            w.Key("text");        w.String(text.c_str(), static_cast<rapidjson::SizeType>(text.size()));
+            w.Key("tokens");      w.Uint64(words.size());
+            w.Key("from_slot");   w.Int(fromSlot);
+            w.Key("count");       w.Int(count);
+            w.Key("total_slots"); w.Int(totalSlots);
+            w.Key("ms");          w.Double(totalMs);
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
+        // ---- reassemble_bonds ----
+        // Bond-walk reconstruction for damaged/partial documents — the
+        // positional path stays behind `retrieve`; this serves whatever a
+        // bare bond graph can still say. Optional "positions": false skips
+        // the starter first-position load (purely structural walk);
+        // "text": true additionally resolves the token walk to surface text.
+        if (strcmp(action, "reassemble_bonds") == 0)
+        {
+            if (!doc.HasMember("doc_id") || !doc["doc_id"].IsString())
+            {
+                return R"({"status":"error","message":"Missing 'doc_id' field"})";
+            }
+            AZStd::string docId(doc["doc_id"].GetString(), doc["doc_id"].GetStringLength());
+
+            bool usePositions = true;
+            if (doc.HasMember("positions") && doc["positions"].IsBool())
+                usePositions = doc["positions"].GetBool();
+            bool wantText = false;
+            if (doc.HasMember("text") && doc["text"].IsBool())
+                wantText = doc["text"].GetBool();
+
+            if (!ctx.EnsureDb())
+            {
+                return R"({"status":"error","message":"Database not available"})";
+            }
+
+            PBMData pbm = ctx.pbmReader.LoadPBM(docId);
+            if (pbm.bonds.empty())
+            {
+                return R"({"status":"error","message":"Document not found or has no bonds"})";
+            }
+
+            AZStd::unordered_map<AZStd::string, AZ::u32> firstPositions;
+            if (usePositions)
+                firstPositions = ctx.pbmReader.LoadFirstPositions(docId);
+
+            EulerReassemblyResult walk = ReassembleViaBondWalk(
+                pbm, firstPositions.empty() ? nullptr : &firstPositions);
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status");         w.String(walk.sequence.empty() ? "error" : "ok");
+            w.Key("complete");       w.Bool(walk.complete);
+            w.Key("tokens");         w.Uint64(walk.sequence.size());
+            w.Key("edges_consumed"); w.Uint64(walk.edgesConsumed);
+            w.Key("edges_total");    w.Uint64(walk.totalEdges);
+            w.Key("anchors");        w.Uint64(walk.anchors);
+            w.Key("segments");       w.Uint64(walk.segments);
+            w.Key("workers");        w.Uint(walk.workers);
+            w.Key("position_anchors"); w.Uint64(firstPositions.size());
+            w.Key("compact_ms");     w.Double(walk.compactMs);
+            w.Key("walk_ms");        w.Double(walk.walkMs);
+
+            if (wantText && !walk.sequence.empty())
+            {
+                // Resolve the walk to surfaces; unresolvable tokens (stream
+                // markers, unknown ids) drop, matching the positional loader.
+                const HCPVocabulary& vocab = m_engine->GetVocabulary();
+                AZStd::vector<AZStd::string> words;
+                words.reserve(walk.sequence.size());
+                for (const auto& tid : walk.sequence)
+                {
+                    AZStd::string word = vocab.TokenToWord(tid);
+                    if (!word.empty())
+                        words.push_back(AZStd::move(word));
+                }
+                AZStd::string text = TokenIdsToText(words);
+                w.Key("text"); w.String(text.c_str(), static_cast<rapidjson::SizeType>(text.size()));
+            }
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
+        // ---- list ----
+        if (strcmp(action, "list") == 0)
+        {
+            if (!ctx.EnsureDb())
+            {
+                return R"({"status":"error","message":"Database not available"})";
+            }
+
+            auto docs = ctx.docQuery.ListDocuments();
 
             rapidjson::StringBuffer sb;
             rapidjson::Writer<rapidjson::StringBuffer> w(sb);
@@ -349,22 +1251,19 @@ namespace HCPEngine
 
             AZStd::string docId(doc["doc_id"].GetString(), doc["doc_id"].GetStringLength());
 
-            HCPDbConnection& db = m_engine->GetDbConnection();
-            if (!db.IsConnected()) db.Connect();
-            if (!db.IsConnected())
+            if (!ctx.EnsureDb())
             {
                 return R"({"status":"error","message":"Database not available"})";
             }
 
-            HCPDocumentQuery& docQuery = m_engine->GetDocumentQuery();
-            auto detail = docQuery.GetDocumentDetail(docId);
+            auto detail = ctx.docQuery.GetDocumentDetail(docId);
             if (detail.pk == 0)
             {
                 return R"({"status":"error","message":"Document not found"})";
             }
 
-            auto prov = docQuery.GetProvenance(detail.pk);
-            auto vars = m_engine->GetDocVarQuery().GetDocVars(detail.pk);
+            auto prov = ctx.docQuery.GetProvenance(detail.pk);
+            auto vars = ctx.docVarQuery.GetDocVars(detail.pk);
 
             rapidjson::StringBuffer sb;
             rapidjson::Writer<rapidjson::StringBuffer> w(sb);
@@ -421,13 +1320,14 @@ namespace HCPEngine
             if (!doc.HasMember("doc_id") || !doc["doc_id"].IsString())
                 return R"({"status":"error","message":"Missing 'doc_id' field"})";
 
-            HCPDbConnection& db = m_engine->GetDbConnection();
-            if (!db.IsConnected()) db.Connect();
-            if (!db.IsConnected())
+            // Store mutation — take the engine lane so it can't race an ingest.
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
+
+            if (!ctx.EnsureDb())
                 return R"({"status":"error","message":"Database not available"})";
 
             AZStd::string docIdStr(doc["doc_id"].GetString(), doc["doc_id"].GetStringLength());
-            int docPk = m_engine->GetDocumentQuery().GetDocPk(docIdStr);
+            int docPk = ctx.docQuery.GetDocPk(docIdStr);
             if (docPk == 0)
             {
                 rapidjson::StringBuffer sb;
@@ -440,7 +1340,11 @@ namespace HCPEngine
                 return AZStd::string(sb.GetString(), sb.GetSize());
             }
 
-            int deleted = m_engine->GetDocumentQuery().DeleteDocument(docPk);
+            int deleted = ctx.docQuery.DeleteDocument(docPk);
+            if (deleted > 0)
+            {
+                TextCache::Invalidate(docIdStr);
+            }
             rapidjson::StringBuffer sb;
             rapidjson::Writer<rapidjson::StringBuffer> w(sb);
             w.StartObject();
@@ -461,15 +1365,15 @@ namespace HCPEngine
 
             AZStd::string docId(doc["doc_id"].GetString(), doc["doc_id"].GetStringLength());
 
-            HCPDbConnection& db = m_engine->GetDbConnection();
-            if (!db.IsConnected()) db.Connect();
-            if (!db.IsConnected())
+            // Store mutation — take the engine lane so it can't race an ingest.
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
+
+            if (!ctx.EnsureDb())
             {
                 return R"({"status":"error","message":"Database not available"})";
             }
 
-            HCPDocumentQuery& docQuery = m_engine->GetDocumentQuery();
-            int docPk = docQuery.GetDocPk(docId);
+            int docPk = ctx.docQuery.GetDocPk(docId);
             if (docPk == 0)
             {
                 return R"({"status":"error","message":"Document not found"})";
@@ -500,7 +1404,7 @@ namespace HCPEngine
                 }
             }
 
-            bool ok = docQuery.UpdateMetadata(docPk, setJson, removeKeys);
+            bool ok = ctx.docQuery.UpdateMetadata(docPk, setJson, removeKeys);
 
             rapidjson::StringBuffer sb;
             rapidjson::Writer<rapidjson::StringBuffer> w(sb);
@@ -523,14 +1427,12 @@ namespace HCPEngine
 
             AZStd::string docId(doc["doc_id"].GetString(), doc["doc_id"].GetStringLength());
 
-            HCPDbConnection& db = m_engine->GetDbConnection();
-            if (!db.IsConnected()) db.Connect();
-            if (!db.IsConnected())
+            if (!ctx.EnsureDb())
             {
                 return R"({"status":"error","message":"Database not available"})";
             }
 
-            int docPk = m_engine->GetDocumentQuery().GetDocPk(docId);
+            int docPk = ctx.docQuery.GetDocPk(docId);
             if (docPk == 0)
             {
                 return R"({"status":"error","message":"Document not found"})";
@@ -542,7 +1444,7 @@ namespace HCPEngine
                 tokenId = AZStd::string(doc["token"].GetString(), doc["token"].GetStringLength());
             }
 
-            auto bonds = m_engine->GetBondQuery().GetBondsForToken(docPk, tokenId);
+            auto bonds = ctx.bondQuery.GetBondsForToken(docPk, tokenId);
 
             // Resolve surface forms via vocabulary lookup
             const auto& vocab = m_engine->GetVocabulary();
@@ -584,6 +1486,97 @@ namespace HCPEngine
             return AZStd::string(sb.GetString(), sb.GetSize());
         }
 
+        // ---- export (one document -> self-contained bundle file) ----
+        if (strcmp(action, "export") == 0)
+        {
+            if (!doc.HasMember("doc_id") || !doc["doc_id"].IsString())
+            {
+                return R"({"status":"error","message":"Missing 'doc_id' field"})";
+            }
+
+            AZStd::string docId(doc["doc_id"].GetString(), doc["doc_id"].GetStringLength());
+            AZStd::string path;
+            if (doc.HasMember("path") && doc["path"].IsString())
+            {
+                path = AZStd::string(doc["path"].GetString(), doc["path"].GetStringLength());
+            }
+
+            // Read-only — runs on this worker's connection like retrieve/info.
+            if (!ctx.EnsureDb())
+            {
+                return R"({"status":"error","message":"Database not available"})";
+            }
+
+            HCPDocBundle bundle(ctx.db);
+            HCPDocBundle::ExportResult result;
+            if (!bundle.ExportDocument(docId, path, result))
+            {
+                return R"({"status":"error","message":")" + result.error + R"("})";
+            }
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            w.Key("doc_id"); w.String(docId.c_str());
+            w.Key("path"); w.String(result.path.c_str());
+            w.Key("bytes"); w.Uint64(result.bytes);
+            w.Key("bonds"); w.Uint(result.bonds);
+            w.Key("vars"); w.Uint(result.vars);
+            w.Key("positions"); w.Uint(result.positions);
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
+        // ---- import (bulk-write a bundle file into the local store) ----
+        if (strcmp(action, "import") == 0)
+        {
+            if (!doc.HasMember("path") || !doc["path"].IsString())
+            {
+                return R"({"status":"error","message":"Missing 'path' field"})";
+            }
+
+            AZStd::string path(doc["path"].GetString(), doc["path"].GetStringLength());
+
+            // Store mutation — take the engine lane so it can't race an ingest.
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
+
+            if (!ctx.EnsureDb())
+            {
+                return R"({"status":"error","message":"Database not available"})";
+            }
+
+            HCPDocBundle bundle(ctx.db);
+            HCPDocBundle::ImportResult result;
+            if (!bundle.ImportDocument(path, result))
+            {
+                rapidjson::StringBuffer sb;
+                rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+                w.StartObject();
+                w.Key("status"); w.String("error");
+                w.Key("message"); w.String(result.error.c_str());
+                if (result.docPk != 0)   // catalog dedupe: point at the existing doc
+                {
+                    w.Key("doc_id"); w.String(result.docId.c_str());
+                    w.Key("doc_pk"); w.Int(result.docPk);
+                }
+                w.EndObject();
+                return AZStd::string(sb.GetString(), sb.GetSize());
+            }
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            w.Key("doc_id"); w.String(result.docId.c_str());
+            w.Key("doc_pk"); w.Int(result.docPk);
+            w.Key("doc_name"); w.String(result.name.c_str());
+            w.Key("bonds"); w.Uint(result.bonds);
+            w.Key("positions"); w.Uint(result.positions);
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
         // ---- phys_resolve — REMOVED: PhysX path deleted; use phys_ingest ----
         if (strcmp(action, "phys_resolve") == 0)
         {
@@ -594,6 +1587,8 @@ namespace HCPEngine
         if (strcmp(action, "phys_ingest") == 0)
         {
             AZStd::string text;
+            char* inlineText = nullptr;   // in-situ view for the 'text' branch
+            size_t inlineLen = 0;
             AZStd::string docName;
             AZStd::string centuryCode = "AB";
             bool fictionFirst = true;
@@ -626,11 +1621,26 @@ namespace HCPEngine
             }
             else if (doc.HasMember("text") && doc["text"].IsString())
             {
-                text = AZStd::string(doc["text"].GetString(), doc["text"].GetStringLength());
+                // In-situ value: a mutable view into the receive buffer, so the
+                // document reaches the byte-floor without an intermediate copy.
+                inlineText = const_cast<char*>(doc["text"].GetString());
+                inlineLen = doc["text"].GetStringLength();
+            }
+            else if (doc.HasMember("shm_bytes") && doc["shm_bytes"].IsUint64())
+            {
+                // Same-host shm lane: the client placed the document in the
+                // mapped region — it never crossed the socket. In-place like
+                // the inline branch (CRLF compaction mutates the region; the
+                // client hands it over until the reply).
+                const uint64_t shmLen = doc["shm_bytes"].GetUint64();
+                if (!conn.shmMap || shmLen > conn.shmSize)
+                    return R"({"status":"error","message":"No shared-memory region that large on this connection"})";
+                inlineText = reinterpret_cast<char*>(conn.shmMap);
+                inlineLen = static_cast<size_t>(shmLen);
             }
             else
             {
-                return R"({"status":"error","message":"phys_ingest requires 'file' or 'text'"})";
+                return R"({"status":"error","message":"phys_ingest requires 'file', 'text', or 'shm_bytes'"})";
             }
 
             if (doc.HasMember("name") && doc["name"].IsString())
@@ -646,10 +1656,55 @@ namespace HCPEngine
             if (doc.HasMember("catalog_id") && doc["catalog_id"].IsString())
                 ingestCatalogId = AZStd::string(doc["catalog_id"].GetString(), doc["catalog_id"].GetStringLength());
 
-            PhysIngestResult pir = PhysIngestText(
-                text, docName, centuryCode,
-                ingestCatalog, ingestCatalogId,
-                fictionFirst, isWorkingDoc, m_engine);
+            // "job": true — queue the ingest and return a job id immediately.
+            // The job thread owns the pipeline from here; poll with job_status,
+            // abort between phases with job_cancel. The payload is copied out
+            // of the receive buffer (it dies with this request).
+            if (doc.HasMember("job") && doc["job"].IsBool() && doc["job"].GetBool())
+            {
+                auto job = std::make_shared<IngestJob>();
+                job->text = inlineText
+                    ? AZStd::string(inlineText, inlineLen)
+                    : AZStd::move(text);
+                job->docName = docName;
+                job->centuryCode = centuryCode;
+                job->catalog = ingestCatalog;
+                job->catalogId = ingestCatalogId;
+                job->fictionFirst = fictionFirst;
+                job->isWorkingDoc = isWorkingDoc;
+
+                uint64_t jobId;
+                {
+                    std::lock_guard<std::mutex> lock(m_jobMutex);
+                    jobId = m_nextJobId++;
+                    job->id = jobId;
+                    m_jobs.emplace(jobId, job);
+                    m_jobQueue.push_back(AZStd::move(job));
+                }
+                m_jobCv.notify_one();
+
+                rapidjson::StringBuffer sb;
+                rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+                w.StartObject();
+                w.Key("status"); w.String("ok");
+                w.Key("job_id"); w.Uint64(jobId);
+                w.EndObject();
+                return AZStd::string(sb.GetString(), sb.GetSize());
+            }
+
+            // Ingest drives the shared bed/envelope state — one lane only.
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
+
+            // Inline text never carries isWorkingDoc (that is a file-path
+            // property), so the in-place variant applies.
+            PhysIngestResult pir = inlineText
+                ? PhysIngestTextInPlace(
+                    inlineText, inlineLen, docName, centuryCode,
+                    ingestCatalog, ingestCatalogId, fictionFirst, m_engine)
+                : PhysIngestText(
+                    text, docName, centuryCode,
+                    ingestCatalog, ingestCatalogId,
+                    fictionFirst, isWorkingDoc, m_engine);
 
             if (!pir.errorMessage.empty())
                 return R"({"status":"error","message":")" + pir.errorMessage + R"("})";
@@ -658,32 +1713,182 @@ namespace HCPEngine
             rapidjson::Writer<rapidjson::StringBuffer> w(sb);
             w.StartObject();
             w.Key("status"); w.String("ok");
-            w.Key("phase1_settled"); w.Uint(pir.phase1Settled);
-            w.Key("phase1_total");   w.Uint(pir.phase1Total);
-            w.Key("phase1_time_ms"); w.Double(static_cast<double>(pir.phase1TimeMs));
-            w.Key("total_runs");     w.Uint(pir.totalRuns);
-            w.Key("resolved");       w.Uint(pir.resolved);
-            w.Key("unresolved");     w.Uint(pir.unresolved);
-            if (pir.isWorkingDoc)
-            {
-                w.Key("mode");           w.String("working_doc");
-                w.Key("working_doc_id"); w.Int(pir.workingDocId);
-                w.Key("doc_name");       w.String(docName.c_str());
+            WriteIngestResultFields(w, pir, docName);
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
+        // ---- ingest_begin (open a streaming ingest session on this connection) ----
+        if (strcmp(action, "ingest_begin") == 0)
+        {
+            session.Reset();
+
+            if (doc.HasMember("name") && doc["name"].IsString())
+                session.docName = AZStd::string(doc["name"].GetString(), doc["name"].GetStringLength());
+            if (doc.HasMember("century") && doc["century"].IsString())
+                session.centuryCode = AZStd::string(doc["century"].GetString(), doc["century"].GetStringLength());
+            if (doc.HasMember("corpus") && doc["corpus"].IsString())
+            {
+                AZStd::string corpus(doc["corpus"].GetString(), doc["corpus"].GetStringLength());
+                if (corpus == "nonfiction" || corpus == "nf")
+                    session.fictionFirst = false;
             }
-            else
+            if (doc.HasMember("catalog") && doc["catalog"].IsString())
+                session.catalog = AZStd::string(doc["catalog"].GetString(), doc["catalog"].GetStringLength());
+            if (doc.HasMember("catalog_id") && doc["catalog_id"].IsString())
+                session.catalogId = AZStd::string(doc["catalog_id"].GetString(), doc["catalog_id"].GetStringLength());
+            if (session.docName.empty()) session.docName = "untitled";
+
+            session.active = true;
+
+            fprintf(stderr, "[HCPSocketServer] Streaming ingest opened: '%s'\n", session.docName.c_str());
+            fflush(stderr);
+            return R"({"status":"ok"})";
+        }
+
+        // ---- ingest_chunk (one chunk of text; segmented on arrival) ----
+        if (strcmp(action, "ingest_chunk") == 0)
+        {
+            if (!session.active)
+                return R"({"status":"error","message":"No ingest session — send ingest_begin first"})";
+            if (!doc.HasMember("data") || !doc["data"].IsString())
+                return R"({"status":"error","message":"Missing 'data' field"})";
+
+            // Normalize CRLF → LF per chunk, same as the one-shot path. A CR at a
+            // chunk edge is fine: CRs are dropped wherever they land. The value
+            // is an in-situ view into the mutable receive buffer, so the strip
+            // compacts in place — no per-chunk copy of the payload.
+            char* data = const_cast<char*>(doc["data"].GetString());
+            const size_t dataLen = doc["data"].GetStringLength();
+            size_t kept = 0;
+            for (size_t i = 0; i < dataLen; ++i)
+                if (data[i] != '\r') data[kept++] = data[i];
+
+            session.stream.Feed(
+                reinterpret_cast<const uint8_t*>(data), kept,
+                session.runs);
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            w.Key("bytes"); w.Uint64(session.stream.TotalBytes());
+            w.Key("runs");  w.Uint64(session.runs.size());
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
+        // ---- ingest_commit (flush the tail and run Phase 2 → scanner → PBM) ----
+        if (strcmp(action, "ingest_commit") == 0)
+        {
+            if (!session.active)
+                return R"({"status":"error","message":"No ingest session — send ingest_begin first"})";
+
+            session.stream.Finish(session.runs);
+
+            fprintf(stderr, "[HCPSocketServer] Streaming ingest commit: '%s' (%zu bytes, %zu runs)\n",
+                session.docName.c_str(), session.stream.TotalBytes(), session.runs.size());
+            fflush(stderr);
+
+            PhysIngestResult pir;
+            {
+                // Ingest drives the shared bed/envelope state — one lane only.
+                std::lock_guard<std::mutex> engineLock(m_engineMutex);
+                pir = PhysIngestRuns(
+                    session.runs, session.stream.TotalBytes(), AZStd::string(),
+                    session.docName, session.centuryCode,
+                    session.catalog, session.catalogId,
+                    session.fictionFirst, /*isWorkingDoc=*/false, m_engine);
+            }
+
+            AZStd::string docName = session.docName;
+            session.Reset();
+
+            if (!pir.errorMessage.empty())
+                return R"({"status":"error","message":")" + pir.errorMessage + R"("})";
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            WriteIngestResultFields(w, pir, docName);
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
+        // ---- ingest_abort (drop the session without storing anything) ----
+        if (strcmp(action, "ingest_abort") == 0)
+        {
+            session.Reset();
+            return R"({"status":"ok"})";
+        }
+
+        // ---- job_status (poll a background ingest job) ----
+        if (strcmp(action, "job_status") == 0)
+        {
+            if (!doc.HasMember("job_id") || !doc["job_id"].IsUint64())
+                return R"({"status":"error","message":"Missing 'job_id'"})";
+
+            std::shared_ptr<IngestJob> job;
             {
-                w.Key("doc_id");          w.String(pir.docId.c_str());
-                w.Key("doc_pk");          w.Int(pir.docPk);
-                w.Key("doc_name");        w.String(docName.c_str());
-                if (pir.usedStub) { w.Key("stub_filled"); w.Bool(true); }
-                w.Key("resolve_time_ms"); w.Double(static_cast<double>(pir.resolveTimeMs));
-                w.Key("bond_types");      w.Uint64(pir.bondTypes);
-                w.Key("total_pairs");     w.Uint64(pir.totalPairs);
-                w.Key("unique_tokens");   w.Uint64(pir.uniqueTokens);
-                w.Key("total_slots");     w.Int(pir.totalSlots);
-                w.Key("positions_stored"); w.Bool(pir.positionsStored);
-                w.Key("entity_annotations"); w.Uint64(pir.entityAnnotations);
+                std::lock_guard<std::mutex> lock(m_jobMutex);
+                auto it = m_jobs.find(doc["job_id"].GetUint64());
+                if (it != m_jobs.end()) job = it->second;
             }
+            if (!job)
+                return R"({"status":"error","message":"Unknown job id"})";
+
+            const IngestJob::State state = job->state.load();
+            const PhysIngestProgress& p = job->progress;
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            w.Key("job_id"); w.Uint64(job->id);
+            w.Key("state");  w.String(IngestJob::StateName(state));
+            w.Key("stage");  w.String(PhysIngestProgress::StageName(p.stage.load()));
+            w.Key("bytes_ingested"); w.Uint64(p.bytesIngested.load());
+            w.Key("runs_total");     w.Uint(p.runsTotal.load());
+            w.Key("runs_resolved");  w.Uint(p.runsResolved.load());
+            w.Key("bonds_written");  w.Uint64(p.bondsWritten.load());
+            if (state == IngestJob::State::Done)
+                WriteIngestResultFields(w, job->result, job->docName);
+            else if (state == IngestJob::State::Failed)
+            {
+                w.Key("message"); w.String(job->result.errorMessage.c_str());
+            }
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
+        // ---- job_cancel (abort a background ingest job between phases) ----
+        if (strcmp(action, "job_cancel") == 0)
+        {
+            if (!doc.HasMember("job_id") || !doc["job_id"].IsUint64())
+                return R"({"status":"error","message":"Missing 'job_id'"})";
+
+            std::shared_ptr<IngestJob> job;
+            {
+                std::lock_guard<std::mutex> lock(m_jobMutex);
+                auto it = m_jobs.find(doc["job_id"].GetUint64());
+                if (it != m_jobs.end()) job = it->second;
+            }
+            if (!job)
+                return R"({"status":"error","message":"Unknown job id"})";
+
+            job->progress.cancelRequested.store(true);
+            // A still-queued job cancels outright; the job thread skips it.
+            // A running job stops at its next between-phase gate.
+            IngestJob::State expected = IngestJob::State::Queued;
+            job->state.compare_exchange_strong(expected, IngestJob::State::Cancelled);
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String("ok");
+            w.Key("job_id"); w.Uint64(job->id);
+            w.Key("state");  w.String(IngestJob::StateName(job->state.load()));
             w.EndObject();
             return AZStd::string(sb.GetString(), sb.GetSize());
         }
@@ -700,6 +1905,8 @@ namespace HCPEngine
 
             AZStd::string name(doc[nameKey].GetString(), doc[nameKey].GetStringLength());
 
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
+
             HCPEnvelopeManager& envMgr = m_engine->GetEnvelopeManager();
             EnvelopeActivation result = envMgr.ActivateEnvelope(name);
             int warmSize = envMgr.GetWorkingSetSize(result.envelopeId);
@@ -726,6 +1933,8 @@ namespace HCPEngine
             }
 
             AZStd::string name(doc["name"].GetString(), doc["name"].GetStringLength());
+
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
             m_engine->GetEnvelopeManager().DeactivateEnvelope(name);
 
             rapidjson::StringBuffer sb;
@@ -759,6 +1968,8 @@ namespace HCPEngine
                 if (corpus == "nonfiction" || corpus == "nf") fictionFirst = false;
             }
 
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
+
             GutenbergRunResult runResult = RunGutenbergTexts(
                 workingDocId, textsDir, centuryCode, fictionFirst,
                 m_engine, m_engine->GetVarConn());
@@ -782,6 +1993,66 @@ namespace HCPEngine
             return AZStd::string(sb.GetString(), sb.GetSize());
         }
 
+        // ---- run_ingest_bench ----
+        if (strcmp(action, "run_ingest_bench") == 0)
+        {
+            AZStd::string fixturesDir = "data/gutenberg/texts";
+            int passes = 2;   // cold + warm
+
+            if (doc.HasMember("fixtures_dir") && doc["fixtures_dir"].IsString())
+                fixturesDir = AZStd::string(doc["fixtures_dir"].GetString(), doc["fixtures_dir"].GetStringLength());
+            if (doc.HasMember("passes") && doc["passes"].IsInt())
+            {
+                passes = doc["passes"].GetInt();
+                if (passes < 1) passes = 1;
+                if (passes > 10) passes = 10;
+            }
+
+            std::lock_guard<std::mutex> engineLock(m_engineMutex);
+
+            IngestBenchResult bench = RunIngestBench(fixturesDir, passes, m_engine);
+
+            rapidjson::StringBuffer sb;
+            rapidjson::Writer<rapidjson::StringBuffer> w(sb);
+            w.StartObject();
+            w.Key("status"); w.String(bench.ok ? "ok" : "error");
+            if (!bench.error.empty()) { w.Key("message"); w.String(bench.error.c_str()); }
+            w.Key("fixtures");
+            w.StartArray();
+            for (const auto& fixture : bench.fixtures)
+            {
+                w.StartObject();
+                w.Key("name");  w.String(fixture.name.c_str());
+                w.Key("file");  w.String(fixture.file.c_str());
+                w.Key("bytes"); w.Uint64(fixture.bytes);
+                w.Key("passes");
+                w.StartArray();
+                for (const auto& pass : fixture.passes)
+                {
+                    w.StartObject();
+                    w.Key("scenario");      w.String(pass.scenario.c_str());
+                    w.Key("ok");            w.Bool(pass.ok);
+                    if (!pass.error.empty()) { w.Key("error"); w.String(pass.error.c_str()); }
+                    w.Key("byte_floor_ms"); w.Double(pass.byteFloorMs);
+                    w.Key("segment_ms");    w.Double(pass.segmentMs);
+                    w.Key("resolve_ms");    w.Double(pass.resolveMs);
+                    w.Key("scan_ms");       w.Double(pass.scanMs);
+                    w.Key("store_ms");      w.Double(pass.storeMs);
+                    w.Key("total_ms");      w.Double(pass.totalMs);
+                    w.Key("runs");          w.Uint(pass.runs);
+                    w.Key("resolved");      w.Uint(pass.resolved);
+                    w.Key("unresolved");    w.Uint(pass.unresolved);
+                    w.Key("bond_types");    w.Uint64(pass.bondTypes);
+                    w.EndObject();
+                }
+                w.EndArray();
+                w.EndObject();
+            }
+            w.EndArray();
+            w.EndObject();
+            return AZStd::string(sb.GetString(), sb.GetSize());
+        }
+
         return R"({"status":"error","message":"Unknown action"})";
     }
 
@@ -3,10 +3,21 @@
 #include <AzCore/std/string/string.h>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace HCPEngine
 {
     class HCPEngineSystemComponent;
+    class HCPShardRouter;
+    struct SocketWorkerContext;
+    struct SocketIngestSession;
+    struct SocketConnState;
+    struct IngestJob;
 
     //! TCP socket server for the HCP engine API.
     //! Listens on a port and accepts JSON commands:
@@ -15,10 +26,41 @@ namespace HCPEngine
     //!   - 4 bytes: message length (network byte order, big-endian)
     //!   - N bytes: JSON payload (UTF-8)
     //!
+    //! Protocol v2 (negotiated per connection; v1 JSON-everything stays the
+    //! default, so existing clients never see a binary frame):
+    //!   {"action": "protocol", "version": 2, "compression": "lz4" (optional)}
+    //!     → {"status": "ok", "version": 2, "compression": "lz4"|"none"}
+    //!   After v2, bulk payloads ride BINARY frames — the length prefix with
+    //!   its top bit set, then [type u8][flags u8][raw_len u32 BE][body].
+    //!   type 1 = document text (raw UTF-8); flags bit 0 = LZ4 block
+    //!   compression (raw_len = uncompressed size; built without liblz4 the
+    //!   negotiation reports "none"). retrieve sends its control fields as a
+    //!   normal JSON reply first, then the text as one binary frame — no JSON
+    //!   escape server-side, no unescape client-side. All other actions are
+    //!   unchanged JSON.
+    //!
+    //! Same-host shared-memory lane (loopback peers only; orthogonal to the
+    //! version — the Workstation uses it from v1):
+    //!   {"action": "protocol", "shm_bytes": N}
+    //!     → {"status": "ok", ..., "shm_name": "/hcp-sock-...", "shm_bytes": N}
+    //!   The server creates and owns a POSIX shm region; the client maps it
+    //!   by name. Bulk payloads then cross through the region and the socket
+    //!   carries only control JSON: retrieve with "shm": true answers
+    //!   {"status": "ok", "shm": true, "text_bytes": N, ...} with the text in
+    //!   the region; phys_ingest with "shm_bytes": N reads the document from
+    //!   it. One request at a time may use the region — the client must not
+    //!   opt in while another of its requests is in flight.
+    //!
     //! Actions:
     //!   {"action": "health"}
     //!     → {"status": "ok", "words": N, "labels": N, "chars": N}
     //!
+    //!   {"action": "stats"}
+    //!     → {"status": "ok", "stages": {resolve_total, length_cycle, broadphase,
+    //!        settle, lmdb_feed, warm_batch, envelope_query}} — each stage carries
+    //!        {count, total_ms, avg_us, max_us, hist[16]} (monotonic since start),
+    //!        plus settle_steps {budget, actual} (convergence early exit)
+    //!
     //!   {"action": "ingest", "name": "Doc Name", "century": "AS", "text": "full text..."}
     //!     → {"status": "ok", "doc_id": "...", "tokens": N, "unique": N, "bonds": N}
     //!
@@ -40,12 +82,57 @@ namespace HCPEngine
     //!   {"action": "bonds", "doc_id": "...", "token": "..."}
     //!     → {"status": "ok", "bonds": [{token, surface, count}]}
     //!
+    //!   Inter-site replication (see HCPDocBundle.h for the bundle format):
+    //!   {"action": "export", "doc_id": "...", "path": "..." (optional)}
+    //!     → {"status": "ok", "path": "...", "bytes": N, "bonds": N, "vars": N,
+    //!        "positions": N}
+    //!   {"action": "import", "path": "..."}
+    //!     → {"status": "ok", "doc_id": "...", "doc_pk": N, "doc_name": "...",
+    //!        "bonds": N, "positions": N}
+    //!
+    //!   Streaming ingest (per-connection session; chunks go through the
+    //!   byte-floor as they arrive, so peak memory is a chunk, not a document):
+    //!   {"action": "ingest_begin", "name": "...", "century": "AS", ...}
+    //!     → {"status": "ok"}
+    //!   {"action": "ingest_chunk", "data": "..."}            (repeat)
+    //!     → {"status": "ok", "bytes": N, "runs": N}
+    //!   {"action": "ingest_commit"}
+    //!     → same shape as phys_ingest
+    //!   {"action": "ingest_abort"}
+    //!     → {"status": "ok"}
+    //!
+    //!   Job-based ingest (non-blocking; runs on a dedicated job thread that
+    //!   serializes with the engine lane):
+    //!   {"action": "phys_ingest", "job": true, ... same fields as phys_ingest}
+    //!     → {"status": "ok", "job_id": N}       (returns immediately)
+    //!   {"action": "job_status", "job_id": N}
+    //!     → {"status": "ok", "state": "queued|running|done|failed|cancelled",
+    //!        "stage": "...", "bytes_ingested": N, "runs_total": N,
+    //!        "runs_resolved": N, "bonds_written": N; done jobs additionally
+    //!        carry the full phys_ingest result fields}
+    //!   {"action": "job_cancel", "job_id": N}
+    //!     → {"status": "ok", "state": "..."}    (aborts between phases)
+    //!
     //!   On error: {"status": "error", "message": "description"}
     //!
+    //! Concurrency: the listener hands accepted clients to a small worker
+    //! pool (HCP_SOCKET_WORKERS, default 4). Each worker owns its own
+    //! HCPDbConnection and query kernels, so read-only actions (health,
+    //! retrieve, list, info, bonds) run concurrently. Actions that mutate
+    //! the engine or the store (phys_ingest, run_gutenberg, envelope
+    //! activation, delete_doc, update_meta, import) serialize on one engine lane —
+    //! a long ingest no longer blocks monitoring probes.
+    //!
+    //! Router mode: with HCP_SHARD_BACKENDS="host:port,host:port,..." set, the
+    //! daemon answers the same protocol but runs no engine work of its own —
+    //! every action is partitioned across the listed backend daemons
+    //! (consistent-hash on document name for ingest affinity, scatter-gather
+    //! for list, aggregated health/stats). See HCPShardRouter.h.
     class HCPSocketServer
     {
     public:
         static constexpr int DEFAULT_PORT = 9720;
+        static constexpr int DEFAULT_WORKERS = 4;
 
         HCPSocketServer() = default;
         ~HCPSocketServer();
@@ -65,15 +152,47 @@ namespace HCPEngine
 
     private:
         void ListenerThread(int port);
-        void HandleClient(int clientFd);
-        AZStd::string ProcessRequest(const AZStd::string& json);
+        void WorkerThread();
+        void JobThread();
+        void HandleClient(int clientFd, SocketWorkerContext& ctx);
+        //! Parses `json` IN SITU (rapidjson insitu mode): string values become
+        //! views into the buffer and it is mutated during parsing, so the
+        //! caller must own it and not reuse its contents afterwards.
+        //! An EMPTY return means the handler already streamed its reply to
+        //! clientFd (large retrieves, v2 binary frames) — the caller must not
+        //! write anything.
+        AZStd::string ProcessRequest(AZStd::string& json, SocketWorkerContext& ctx,
+            SocketIngestSession& session, SocketConnState& conn, int clientFd);
 
         HCPEngineSystemComponent* m_engine = nullptr;
+        //! Non-null in router mode (HCP_SHARD_BACKENDS) — ProcessRequest then
+        //! forwards to backend daemons instead of the local engine.
+        std::unique_ptr<HCPShardRouter> m_router;
         std::thread m_thread;
+        std::vector<std::thread> m_workers;
         std::atomic<bool> m_running{false};
         std::atomic<bool> m_stopRequested{false};
         int m_listenFd = -1;
         bool m_listenAll = false;
+
+        //! Accepted client fds awaiting a worker.
+        std::deque<int> m_pendingClients;
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueCv;
+
+        //! Serializes engine-mutating actions (the "ingest lane").
+        std::mutex m_engineMutex;
+
+        //! Background ingest jobs (phys_ingest with "job": true). One job
+        //! thread drains the queue; finished jobs stay in the table for
+        //! job_status polling until pruned (oldest finished first).
+        static constexpr size_t JOB_RETAIN_MAX = 64;
+        std::thread m_jobThread;
+        std::deque<std::shared_ptr<IngestJob>> m_jobQueue;
+        std::unordered_map<uint64_t, std::shared_ptr<IngestJob>> m_jobs;
+        uint64_t m_nextJobId = 1;
+        std::mutex m_jobMutex;
+        std::condition_variable m_jobCv;
     };
 
 } // namespace HCPEngine
@@ -1,11 +1,32 @@
 #include "HCPDatabaseBackend.h"
 
+#include <AzCore/std/containers/unordered_map.h>
+
 #include <sqlite3.h>
 #include <cstdio>
 #include <cstring>
+#include <cstdlib>
 
 namespace HCPEngine
 {
+    // Implicit write batch: without an explicit transaction every statement
+    // commits its own journal frame, and on edge hardware (field-kit laptops,
+    // SD storage) that fsync dominates ingest. Writes outside an explicit
+    // transaction are grouped into an implicit one committed every
+    // BATCH_MAX_WRITES statements, on Disconnect, or when the caller opens
+    // an explicit transaction. HCP_SQLITE_BATCH=0 restores per-statement
+    // commits.
+    static constexpr int BATCH_MAX_WRITES = 512;
+
+    static bool BatchingEnabled()
+    {
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_SQLITE_BATCH");
+            return !(v && v[0] == '0');
+        }();
+        return enabled;
+    }
+
     class SqliteBackend : public IDatabaseBackend
     {
     public:
@@ -39,6 +60,10 @@ namespace HCPEngine
 
             // Enable WAL mode for concurrent reads
             sqlite3_exec(m_db, "PRAGMA journal_mode=WAL", nullptr, nullptr, nullptr);
+            // WAL makes NORMAL safe from corruption — fsync happens at
+            // checkpoint, not per commit. A crash can lose the WAL tail,
+            // the same window the implicit write batch already accepts.
+            sqlite3_exec(m_db, "PRAGMA synchronous=NORMAL", nullptr, nullptr, nullptr);
             // Enable foreign keys
             sqlite3_exec(m_db, "PRAGMA foreign_keys=ON", nullptr, nullptr, nullptr);
             // Reasonable busy timeout for concurrent access
@@ -51,8 +76,16 @@ namespace HCPEngine
         {
             if (m_db)
             {
+                FlushBatch();
+
+                // Cached statements must be finalized before close.
+                for (auto& [sql, stmt] : m_stmtCache)
+                    sqlite3_finalize(stmt);
+                m_stmtCache.clear();
+
                 sqlite3_close(m_db);
                 m_db = nullptr;
+                m_explicitTxn = false;
             }
         }
 
@@ -112,15 +145,10 @@ namespace HCPEngine
             QueryResult qr;
             if (!m_db) return qr;
 
-            sqlite3_stmt* stmt;
-            int rc = sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr);
-            if (rc != SQLITE_OK)
-            {
-                fprintf(stderr, "[SqliteBackend] Prepare error: %s\n",
-                    sqlite3_errmsg(m_db));
-                fflush(stderr);
-                return qr;
-            }
+            // Parameterized statements repeat — bond lookups, position reads —
+            // so they come from the cache and skip re-parsing.
+            sqlite3_stmt* stmt = GetCachedStatement(sql);
+            if (!stmt) return qr;
 
             // Bind parameters — SQLite uses 1-based indexing
             for (size_t i = 0; i < params.size(); ++i)
@@ -133,6 +161,7 @@ namespace HCPEngine
             qr.colCount = sqlite3_column_count(stmt);
             qr.success = true;
 
+            int rc;
             while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
             {
                 AZStd::vector<AZStd::string> row;
@@ -155,7 +184,7 @@ namespace HCPEngine
                 qr.success = false;
             }
 
-            sqlite3_finalize(stmt);
+            sqlite3_reset(stmt);
             return qr;
         }
 
@@ -163,18 +192,10 @@ namespace HCPEngine
         {
             if (!m_db) return false;
 
-            char* errMsg = nullptr;
-            int rc = sqlite3_exec(m_db, sql, nullptr, nullptr, &errMsg);
-            if (rc != SQLITE_OK)
-            {
-                fprintf(stderr, "[SqliteBackend] Execute error: %s\n",
-                    errMsg ? errMsg : "unknown");
-                fflush(stderr);
-                sqlite3_free(errMsg);
-                return false;
-            }
-
-            return true;
+            OpenBatchIfNeeded();
+            bool ok = ExecRaw(sql);
+            if (ok) BatchStatementDone();
+            return ok;
         }
 
         bool ExecuteParams(
@@ -183,15 +204,10 @@ namespace HCPEngine
         {
             if (!m_db) return false;
 
-            sqlite3_stmt* stmt;
-            int rc = sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr);
-            if (rc != SQLITE_OK)
-            {
-                fprintf(stderr, "[SqliteBackend] Prepare error: %s\n",
-                    sqlite3_errmsg(m_db));
-                fflush(stderr);
-                return false;
-            }
+            sqlite3_stmt* stmt = GetCachedStatement(sql);
+            if (!stmt) return false;
+
+            OpenBatchIfNeeded();
 
             for (size_t i = 0; i < params.size(); ++i)
             {
@@ -200,7 +216,7 @@ namespace HCPEngine
                     SQLITE_TRANSIENT);
             }
 
-            rc = sqlite3_step(stmt);
+            int rc = sqlite3_step(stmt);
             bool ok = (rc == SQLITE_DONE || rc == SQLITE_ROW);
             if (!ok)
             {
@@ -209,23 +225,30 @@ namespace HCPEngine
                 fflush(stderr);
             }
 
-            sqlite3_finalize(stmt);
+            sqlite3_reset(stmt);
+            if (ok) BatchStatementDone();
             return ok;
         }
 
         bool BeginTransaction() override
         {
-            return Execute("BEGIN TRANSACTION");
+            // An explicit transaction takes over the write lane from any
+            // open implicit batch.
+            FlushBatch();
+            m_explicitTxn = ExecRaw("BEGIN TRANSACTION");
+            return m_explicitTxn;
         }
 
         bool CommitTransaction() override
         {
-            return Execute("COMMIT");
+            m_explicitTxn = false;
+            return ExecRaw("COMMIT");
         }
 
         bool RollbackTransaction() override
         {
-            return Execute("ROLLBACK");
+            m_explicitTxn = false;
+            return ExecRaw("ROLLBACK");
         }
 
         const char* BackendName() const override { return "sqlite"; }
@@ -353,7 +376,82 @@ namespace HCPEngine
         }
 
     private:
+        //! Run one statement without touching batch state — transaction
+        //! control and batch commits themselves go through here.
+        bool ExecRaw(const char* sql)
+        {
+            char* errMsg = nullptr;
+            int rc = sqlite3_exec(m_db, sql, nullptr, nullptr, &errMsg);
+            if (rc != SQLITE_OK)
+            {
+                fprintf(stderr, "[SqliteBackend] Execute error: %s\n",
+                    errMsg ? errMsg : "unknown");
+                fflush(stderr);
+                sqlite3_free(errMsg);
+                return false;
+            }
+            return true;
+        }
+
+        //! Fetch (or prepare and cache) a statement for the given SQL.
+        //! Returned statement is reset with bindings cleared.
+        sqlite3_stmt* GetCachedStatement(const char* sql)
+        {
+            AZStd::string key(sql);
+            auto it = m_stmtCache.find(key);
+            if (it != m_stmtCache.end())
+            {
+                sqlite3_reset(it->second);
+                sqlite3_clear_bindings(it->second);
+                return it->second;
+            }
+
+            sqlite3_stmt* stmt = nullptr;
+            int rc = sqlite3_prepare_v3(m_db, sql, -1,
+                SQLITE_PREPARE_PERSISTENT, &stmt, nullptr);
+            if (rc != SQLITE_OK)
+            {
+                fprintf(stderr, "[SqliteBackend] Prepare error: %s\n",
+                    sqlite3_errmsg(m_db));
+                fflush(stderr);
+                return nullptr;
+            }
+
+            m_stmtCache.emplace(AZStd::move(key), stmt);
+            return stmt;
+        }
+
+        void OpenBatchIfNeeded()
+        {
+            if (m_explicitTxn || m_batchOpen || !BatchingEnabled()) return;
+            if (ExecRaw("BEGIN TRANSACTION"))
+            {
+                m_batchOpen = true;
+                m_batchCount = 0;
+            }
+        }
+
+        void BatchStatementDone()
+        {
+            if (!m_batchOpen) return;
+            if (++m_batchCount >= BATCH_MAX_WRITES)
+                FlushBatch();
+        }
+
+        //! Commit the implicit batch, if one is open.
+        bool FlushBatch()
+        {
+            if (!m_batchOpen) return true;
+            m_batchOpen = false;
+            m_batchCount = 0;
+            return ExecRaw("COMMIT");
+        }
+
         sqlite3* m_db = nullptr;
+        AZStd::unordered_map<AZStd::string, sqlite3_stmt*> m_stmtCache;
+        bool m_explicitTxn = false;   // caller-managed transaction open
+        bool m_batchOpen   = false;   // implicit write batch open
+        int  m_batchCount  = 0;       // statements in the open batch
     };
 
     // Factory registration
@@ -366,6 +464,9 @@ namespace HCPEngine
 
     // Forward declarations from backend files
     AZStd::unique_ptr<IDatabaseBackend> CreatePostgresBackend();
+    AZStd::unique_ptr<IDatabaseBackend> CreateDualWriteBackend(
+        AZStd::unique_ptr<IDatabaseBackend> primary,
+        AZStd::unique_ptr<IDatabaseBackend> secondary);
 
     AZStd::unique_ptr<IDatabaseBackend> CreateDatabaseBackend(
         const char* backendName,
@@ -377,6 +478,15 @@ namespace HCPEngine
         {
             backend = CreateSqliteBackend();
         }
+        else if (strcmp(backendName, "dual") == 0)
+        {
+            // Field-kit trickle sync: SQLite primary (connectionString is
+            // its path), Postgres secondary fed asynchronously. Secondary
+            // conninfo comes from HCP_DUAL_SECONDARY_CONN (empty → the
+            // Postgres backend's default mothership).
+            backend = CreateDualWriteBackend(
+                CreateSqliteBackend(), CreatePostgresBackend());
+        }
         else
         {
             // Default to postgres
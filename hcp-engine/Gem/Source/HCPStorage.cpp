@@ -1,6 +1,8 @@
 #include "HCPStorage.h"
+#include "HCPDbUtils.h"
 
 #include <AzCore/std/string/conversions.h>
+#include <AzCore/std/containers/unordered_map.h>
 #include <libpq-fe.h>
 #include <cstring>
 
@@ -26,32 +28,23 @@ namespace HCPEngine
             return entities;
         }
 
-        // Build IN-clause token list
-        AZStd::string inClause = "(";
+        // Collect candidate starters, then resolve set-based — one query per
+        // document instead of one per candidate.
+        AZStd::vector<AZStd::string> starterIds;
+        starterIds.reserve(PQntuples(starterRes));
         for (int i = 0; i < PQntuples(starterRes); ++i)
-        {
-            if (i > 0) inClause += ",";
-            inClause += "'";
-            // Escape single quotes in token IDs (shouldn't happen but be safe)
-            const char* tok = PQgetvalue(starterRes, i, 0);
-            for (const char* p = tok; *p; ++p)
-            {
-                if (*p == '\'') inClause += "''";
-                else inClause += *p;
-            }
-            inClause += "'";
-        }
-        inClause += ")";
+            starterIds.push_back(PQgetvalue(starterRes, i, 0));
         PQclear(starterRes);
 
         // Step 2: Cross-reference against entity_names in fiction entities DB
-        AZStd::string query =
+        AZStd::string tokenArr = BuildTextArrayLiteral(starterIds);
+        const char* entParams[] = { tokenArr.c_str() };
+        PGresult* entRes = PQexecParams(ficEntConn,
             "SELECT DISTINCT en.entity_id, t.name, t.category "
             "FROM entity_names en "
             "JOIN tokens t ON t.token_id = en.entity_id "
-            "WHERE en.token_id IN " + inClause;
-
-        PGresult* entRes = PQexec(ficEntConn, query.c_str());
+            "WHERE en.token_id = ANY($1::text[])",
+            1, nullptr, entParams, nullptr, nullptr, 0);
         if (PQresultStatus(entRes) != PGRES_TUPLES_OK)
         {
             fprintf(stderr, "[HCPStorage] Entity cross-ref query failed: %s\n",
@@ -61,7 +54,9 @@ namespace HCPEngine
             return entities;
         }
 
-        // Step 3: For each matched entity, fetch properties
+        AZStd::vector<AZStd::string> entityIds;
+        AZStd::unordered_map<AZStd::string, size_t> entityIndex;  // entity_id → entities[]
+        entityIds.reserve(PQntuples(entRes));
         for (int i = 0; i < PQntuples(entRes); ++i)
         {
             EntityInfo info;
@@ -69,26 +64,39 @@ namespace HCPEngine
             info.name = PQgetvalue(entRes, i, 1);
             info.category = PQgetvalue(entRes, i, 2);
 
-            const char* propParams[] = { info.entityId.c_str() };
-            PGresult* propRes = PQexecParams(ficEntConn,
-                "SELECT key, value FROM entity_properties WHERE entity_id = $1",
-                1, nullptr, propParams, nullptr, nullptr, 0);
-            if (PQresultStatus(propRes) == PGRES_TUPLES_OK)
-            {
-                for (int j = 0; j < PQntuples(propRes); ++j)
-                {
-                    info.properties.push_back({
-                        AZStd::string(PQgetvalue(propRes, j, 0)),
-                        AZStd::string(PQgetvalue(propRes, j, 1))
-                    });
-                }
-            }
-            PQclear(propRes);
-
+            entityIds.push_back(info.entityId);
+            entityIndex[info.entityId] = entities.size();
             entities.push_back(AZStd::move(info));
         }
         PQclear(entRes);
 
+        if (entities.empty())
+            return entities;
+
+        // Step 3: Fetch all matched entities' properties in one set-based query,
+        // then distribute by entity_id. The per-entity round trip here used to
+        // dominate for documents dense with proper nouns.
+        AZStd::string entityArr = BuildTextArrayLiteral(entityIds);
+        const char* propParams[] = { entityArr.c_str() };
+        PGresult* propRes = PQexecParams(ficEntConn,
+            "SELECT entity_id, key, value FROM entity_properties "
+            "WHERE entity_id = ANY($1::text[])",
+            1, nullptr, propParams, nullptr, nullptr, 0);
+        if (PQresultStatus(propRes) == PGRES_TUPLES_OK)
+        {
+            for (int j = 0; j < PQntuples(propRes); ++j)
+            {
+                auto it = entityIndex.find(PQgetvalue(propRes, j, 0));
+                if (it == entityIndex.end())
+                    continue;
+                entities[it->second].properties.push_back({
+                    AZStd::string(PQgetvalue(propRes, j, 1)),
+                    AZStd::string(PQgetvalue(propRes, j, 2))
+                });
+            }
+        }
+        PQclear(propRes);
+
         return entities;
     }
 
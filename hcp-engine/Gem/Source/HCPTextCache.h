@@ -0,0 +1,308 @@
+#pragma once
+
+// ============================================================================
+// HCP text cache — assembled documents as mmap-able side files.
+//
+// `retrieve` used to re-pay the full position load + TokenIdsToText pass on
+// every call, even though Workstation editors re-open the same few documents
+// constantly. The socket server now writes the assembled text to a per-doc
+// cache file on the first retrieval; repeat retrievals mmap it and copy the
+// bytes straight into the reply lane (shm region, binary frame, or streamed
+// JSON) — no DB round trip, no reassembly.
+//
+// The cache is correct, not best-effort stale:
+//
+//   - re-ingest (FillPBMData / UpdatePBMDelta) and delete_doc unlink the
+//     entry before they return, so a hit is always the committed text;
+//   - writes go through a temp file + rename, so a concurrent Open never
+//     sees a half-written entry;
+//   - an open mapping survives the unlink — a worker mid-reply keeps its
+//     (old) bytes while the file is replaced underneath it.
+//
+// Eviction is LRU by mtime: Open bumps the file's timestamp on every hit,
+// and Put trims the directory back under the byte budget, oldest first.
+// The directory layout mirrors HCPPbmSnapshot (one file per doc_id, which
+// is filename-safe: pair codes and dots only).
+//
+// HCP_TEXT_CACHE=0 disables the cache; HCP_TEXT_CACHE_DIR relocates it;
+// HCP_TEXT_CACHE_MAX_MB bounds it (default 256).
+// ============================================================================
+
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/containers/vector.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HCPEngine
+{
+namespace TextCache
+{
+    inline constexpr AZ::u32 MAGIC   = 0x54585448;   // "HTXT" little-endian
+    inline constexpr AZ::u32 VERSION = 1;
+
+    //! Fixed header ahead of the raw UTF-8 text. The token count rides along
+    //! so a cache hit can fill the reply's "tokens" field without touching
+    //! the DB.
+    struct TextHeader
+    {
+        AZ::u32 magic = MAGIC;
+        AZ::u32 version = VERSION;
+        AZ::u64 tokens = 0;
+    };
+
+    static_assert(sizeof(TextHeader) == 16, "text cache header stride");
+
+    //! On by default; HCP_TEXT_CACHE=0 disables both serving and filling.
+    inline bool Enabled()
+    {
+        static const bool enabled = []() {
+            const char* v = std::getenv("HCP_TEXT_CACHE");
+            return !(v && v[0] == '0');
+        }();
+        return enabled;
+    }
+
+    //! Cache directory — HCP_TEXT_CACHE_DIR, or the /tmp default.
+    inline const char* Dir()
+    {
+        static const char* dir = []() {
+            const char* d = std::getenv("HCP_TEXT_CACHE_DIR");
+            return d && d[0] ? d : "/tmp/hcp_text_cache";
+        }();
+        return dir;
+    }
+
+    //! Total on-disk budget in bytes (HCP_TEXT_CACHE_MAX_MB, default 256).
+    inline size_t MaxBytes()
+    {
+        static const size_t maxBytes = []() -> size_t {
+            const char* mb = std::getenv("HCP_TEXT_CACHE_MAX_MB");
+            long v = mb ? atol(mb) : 256;
+            if (v < 1) v = 1;
+            return static_cast<size_t>(v) * 1024 * 1024;
+        }();
+        return maxBytes;
+    }
+
+    inline AZStd::string PathFor(const AZStd::string& docId)
+    {
+        AZStd::string path = Dir();
+        path += '/';
+        path += docId;
+        path += ".txt";
+        return path;
+    }
+
+    //! A mapped cache entry. Valid views keep the mapping alive until they
+    //! go out of scope, even across an invalidating unlink.
+    struct View
+    {
+        const char* text = nullptr;
+        size_t size = 0;
+        AZ::u64 tokens = 0;
+
+        View() = default;
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+        View(View&& other)
+        {
+            *this = AZStd::move(other);
+        }
+        View& operator=(View&& other)
+        {
+            if (this != &other)
+            {
+                Release();
+                text = other.text; size = other.size; tokens = other.tokens;
+                m_map = other.m_map; m_mapBytes = other.m_mapBytes;
+                other.text = nullptr; other.size = 0; other.tokens = 0;
+                other.m_map = nullptr; other.m_mapBytes = 0;
+            }
+            return *this;
+        }
+        ~View() { Release(); }
+
+        explicit operator bool() const { return m_map != nullptr; }
+
+        void Release()
+        {
+            if (m_map)
+            {
+                munmap(m_map, m_mapBytes);
+                m_map = nullptr;
+                text = nullptr;
+                size = 0;
+                tokens = 0;
+            }
+        }
+
+        void* m_map = nullptr;
+        size_t m_mapBytes = 0;
+    };
+
+    //! Map one document's cached text. Returns an invalid View on miss or on
+    //! a header mismatch (stale format). A hit freshens the file's mtime so
+    //! LRU eviction sees it as recently used.
+    inline View Open(const AZStd::string& docId)
+    {
+        View view;
+        int fd = open(PathFor(docId).c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return view;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TextHeader))
+        {
+            close(fd);
+            return view;
+        }
+
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        futimens(fd, nullptr);   // LRU touch
+        close(fd);               // the mapping outlives the descriptor
+        if (map == MAP_FAILED)
+        {
+            return view;
+        }
+
+        const TextHeader* h = static_cast<const TextHeader*>(map);
+        if (h->magic != MAGIC || h->version != VERSION)
+        {
+            munmap(map, st.st_size);
+            return view;
+        }
+
+        view.m_map = map;
+        view.m_mapBytes = st.st_size;
+        view.text = static_cast<const char*>(map) + sizeof(TextHeader);
+        view.size = st.st_size - sizeof(TextHeader);
+        view.tokens = h->tokens;
+        return view;
+    }
+
+    //! Trim the cache directory back under MaxBytes(), oldest mtime first.
+    //! Concurrent trimmers race benignly — a lost unlink is just ENOENT.
+    inline void EvictToBudget()
+    {
+        struct Entry
+        {
+            AZStd::string path;
+            time_t mtime;
+            size_t bytes;
+        };
+
+        AZStd::vector<Entry> entries;
+        size_t total = 0;
+
+        DIR* d = opendir(Dir());
+        if (!d)
+        {
+            return;
+        }
+        while (struct dirent* de = readdir(d))
+        {
+            if (de->d_name[0] == '.')
+            {
+                continue;
+            }
+            AZStd::string path = Dir();
+            path += '/';
+            path += de->d_name;
+            struct stat st;
+            if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+            {
+                entries.push_back({ AZStd::move(path), st.st_mtime,
+                    static_cast<size_t>(st.st_size) });
+                total += static_cast<size_t>(st.st_size);
+            }
+        }
+        closedir(d);
+
+        if (total <= MaxBytes())
+        {
+            return;
+        }
+
+        std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+        for (const Entry& e : entries)
+        {
+            if (total <= MaxBytes())
+            {
+                break;
+            }
+            if (unlink(e.path.c_str()) == 0)
+            {
+                total -= e.bytes;
+            }
+        }
+    }
+
+    //! Store one document's assembled text (temp file + rename, so readers
+    //! never see a partial entry), then trim the cache to budget.
+    inline void Put(const AZStd::string& docId, const char* text, size_t size,
+        AZ::u64 tokens)
+    {
+        mkdir(Dir(), 0755);   // EEXIST is the common case
+
+        // Unique temp name per fill — two workers retrieving the same doc at
+        // once each write their own file; last rename wins with identical bytes.
+        static std::atomic<AZ::u32> s_fillSeq{0};
+        char seq[32];
+        snprintf(seq, sizeof(seq), ".%u.tmp", s_fillSeq.fetch_add(1) + 1);
+        AZStd::string path = PathFor(docId);
+        AZStd::string tmp = path;
+        tmp += seq;
+
+        int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        TextHeader header;
+        header.tokens = tokens;
+        bool ok = write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header));
+        size_t written = 0;
+        while (ok && written < size)
+        {
+            ssize_t n = write(fd, text + written, size - written);
+            if (n <= 0)
+            {
+                ok = false;
+                break;
+            }
+            written += static_cast<size_t>(n);
+        }
+        close(fd);
+
+        if (!ok || rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            unlink(tmp.c_str());
+            return;
+        }
+
+        EvictToBudget();
+    }
+
+    //! Drop one document's entry — called by the re-ingest and delete paths
+    //! before they return. A miss (never cached) is a no-op.
+    inline void Invalidate(const AZStd::string& docId)
+    {
+        unlink(PathFor(docId).c_str());
+    }
+
+} // namespace TextCache
+} // namespace HCPEngine
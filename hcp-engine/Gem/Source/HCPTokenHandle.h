@@ -0,0 +1,208 @@
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/string/string.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/utils.h>
+
+#include "HCPDbUtils.h"
+
+namespace HCPEngine
+{
+    // ---- 64-bit token handles ----
+    //
+    // Canonical token ids are five base-50 pairs ("AA.AE.AF.AA.AB"), each pair
+    // 0..2499 — 12 bits apiece, 60 bits total. A handle packs them arithmetically
+    // into a u64, so on the hot resolve/scan path a token compares and hashes as
+    // one integer instead of a 15-byte heap string. Var tokens (VAR_PREFIX +
+    // surface) have open-ended surfaces and go through an intern table instead;
+    // bit 63 tags which kind a handle is. Strings are materialized only at the
+    // DB / JSON boundaries.
+
+    using TokenHandle = AZ::u64;
+
+    inline constexpr TokenHandle TOKEN_HANDLE_INTERNED = AZ::u64(1) << 63;
+
+    inline bool IsB50Char(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'x');
+    }
+
+    //! True if token is a canonical 5-pair id ("XX.XX.XX.XX.XX").
+    inline bool IsCanonicalTokenId(const AZStd::string& token)
+    {
+        if (token.size() != 14) return false;
+        for (int i = 0; i < 14; ++i)
+        {
+            const bool dot = (i == 2 || i == 5 || i == 8 || i == 11);
+            if (dot ? (token[i] != '.') : !IsB50Char(token[i])) return false;
+        }
+        return true;
+    }
+
+    //! Pack a canonical id into a handle — table lookups, no allocation.
+    //! Caller guarantees IsCanonicalTokenId(token).
+    inline TokenHandle PackTokenId(const AZStd::string& token)
+    {
+        TokenHandle h = 0;
+        for (int p = 0; p < 5; ++p)
+        {
+            h = (h << 12) | AZ::u64(B50_CODEC.DecodePair(token.data() + p * 3));
+        }
+        return h;
+    }
+
+    //! Inverse of PackTokenId.
+    inline AZStd::string UnpackTokenId(TokenHandle h)
+    {
+        char buf[14];
+        for (int p = 4; p >= 0; --p)
+        {
+            // Packed fields are < 2500 by construction; clamp keeps a corrupt
+            // handle inside the table (the old div/mod chain wrapped instead).
+            const int value = int(h & 0xFFF);
+            const char* pair = B50_CODEC.encode[value < 2500 ? value : 2499];
+            h >>= 12;
+            buf[p * 3]     = pair[0];
+            buf[p * 3 + 1] = pair[1];
+            if (p > 0) buf[p * 3 - 1] = '.';
+        }
+        return AZStd::string(buf, 14);
+    }
+
+    //! Intern table for the tokens that do not pack (var tokens, malformed ids).
+    //! Scoped to one scan/write pass — handles from different interners do not mix.
+    class TokenInterner
+    {
+    public:
+        TokenHandle Intern(const AZStd::string& token)
+        {
+            if (IsCanonicalTokenId(token))
+                return PackTokenId(token);
+
+            auto it = m_lookup.find(token);
+            if (it != m_lookup.end()) return it->second;
+
+            const TokenHandle h = TOKEN_HANDLE_INTERNED | AZ::u64(m_surfaces.size());
+            m_surfaces.push_back(token);
+            m_lookup.emplace(token, h);
+            return h;
+        }
+
+        AZStd::string ToString(TokenHandle h) const
+        {
+            if (h & TOKEN_HANDLE_INTERNED)
+                return m_surfaces[size_t(h & ~TOKEN_HANDLE_INTERNED)];
+            return UnpackTokenId(h);
+        }
+
+    private:
+        AZStd::vector<AZStd::string> m_surfaces;
+        AZStd::unordered_map<AZStd::string, TokenHandle> m_lookup;
+    };
+
+    // ---- Batch boundary conversion ----
+    //
+    // The writer/reader bulk paths move whole id columns across the string
+    // boundary at once. Converting the column in one pass keeps the table
+    // lookups hot and reserves the output exactly once, instead of paying
+    // per-call overhead a few million times.
+
+    //! Intern a whole id column. Output is 1:1 with the input.
+    inline void InternTokenIds(const AZStd::vector<AZStd::string>& tokenIds,
+        TokenInterner& interner, AZStd::vector<TokenHandle>& out)
+    {
+        out.clear();
+        out.reserve(tokenIds.size());
+        for (const auto& id : tokenIds)
+            out.push_back(interner.Intern(id));
+    }
+
+    //! Materialize a whole handle column back to id strings. Output is 1:1
+    //! with the input; handles must come from `interner` (or be packed).
+    inline void UnpackTokenIds(const AZStd::vector<TokenHandle>& handles,
+        const TokenInterner& interner, AZStd::vector<AZStd::string>& out)
+    {
+        out.clear();
+        out.reserve(handles.size());
+        for (TokenHandle h : handles)
+            out.push_back(interner.ToString(h));
+    }
+
+    //! Hash for (A, B) bond keys — two handles, one flat integer-keyed map.
+    struct TokenPairHash
+    {
+        size_t operator()(const AZStd::pair<TokenHandle, TokenHandle>& p) const
+        {
+            AZ::u64 h = p.first * 0x9E3779B97F4A7C15ull;
+            h ^= p.second + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            return size_t(h);
+        }
+    };
+
+    //! Bond tally: open-addressing flat hash from (tokenA, tokenB) to count.
+    //! One contiguous slot array, linear probing, counts inline — an increment
+    //! touches one or two cache lines instead of chasing node pointers. count==0
+    //! marks an empty slot (an occupied bond always has count >= 1), so handle 0
+    //! ("AA.AA.AA.AA.AA") stays a valid key.
+    class BondTally
+    {
+    public:
+        BondTally() { m_slots.resize(INITIAL_CAPACITY); }
+
+        void Increment(TokenHandle a, TokenHandle b)
+        {
+            if ((m_size + 1) * 10 >= m_slots.size() * 7) Grow();   // 0.7 load factor
+            Slot& s = FindSlot(m_slots, a, b);
+            if (s.count == 0) { s.a = a; s.b = b; ++m_size; }
+            ++s.count;
+        }
+
+        size_t Size() const { return m_size; }
+
+        //! Visit every (a, b, count) entry, in table order.
+        template<typename Fn>
+        void ForEach(Fn&& fn) const
+        {
+            for (const Slot& s : m_slots)
+                if (s.count != 0) fn(s.a, s.b, s.count);
+        }
+
+    private:
+        static constexpr size_t INITIAL_CAPACITY = 1024;   // power of two
+
+        struct Slot
+        {
+            TokenHandle a = 0;
+            TokenHandle b = 0;
+            int count = 0;
+        };
+
+        static Slot& FindSlot(AZStd::vector<Slot>& slots, TokenHandle a, TokenHandle b)
+        {
+            const size_t mask = slots.size() - 1;
+            size_t i = TokenPairHash{}({a, b}) & mask;
+            while (slots[i].count != 0 && !(slots[i].a == a && slots[i].b == b))
+                i = (i + 1) & mask;
+            return slots[i];
+        }
+
+        void Grow()
+        {
+            AZStd::vector<Slot> next;
+            next.resize(m_slots.size() * 2);
+            for (const Slot& s : m_slots)
+            {
+                if (s.count == 0) continue;
+                Slot& d = FindSlot(next, s.a, s.b);
+                d = s;
+            }
+            m_slots = AZStd::move(next);
+        }
+
+        AZStd::vector<Slot> m_slots;
+        size_t m_size = 0;
+    };
+
+} // namespace HCPEngine
@@ -4,6 +4,7 @@
 #include <AzCore/Console/ILogger.h>
 #include <cctype>
 #include <chrono>
+#include <cstring>
 
 namespace HCPEngine
 {
@@ -401,6 +402,52 @@ namespace HCPEngine
         AZStd::string lower = ToLower(chunk);
         size_t pos = 0;
 
+        // Compiled path: one trie pass per split point yields every candidate
+        // length at once — byte transitions instead of a LookupWord probe per
+        // (position, length) pair, which went quadratic on unspaced OCR text.
+        // Token ids are then fetched only for the candidates actually taken.
+        AZStd::vector<AZ::u32> matchLens;
+        while (pos < lower.size())
+        {
+            matchLens.clear();
+            if (!vocab.MatchWordPrefixes(lower.data() + pos, lower.size() - pos, matchLens))
+                break;   // trie not built — fall through to per-length probing
+
+            bool matched = false;
+            for (size_t mi = matchLens.size(); mi > 0 && !matched; --mi)
+            {
+                const size_t len = matchLens[mi - 1];               // longest first
+                AZStd::string candidate(lower.data() + pos, len);
+                AZStd::string tid = vocab.LookupWord(candidate);
+                if (tid.empty()) continue;                          // index drift — try shorter
+
+                size_t remaining = lower.size() - pos - len;
+                if (remaining == 0)
+                {
+                    outIds.push_back(tid);
+                    pos += len;
+                    matched = true;
+                    break;
+                }
+                AZStd::string remainder(lower.data() + pos + len, remaining);
+                AZStd::string remTid = vocab.LookupWord(remainder);
+                if (!remTid.empty())
+                {
+                    outIds.push_back(tid);
+                    outIds.push_back(remTid);
+                    pos = lower.size();
+                    matched = true;
+                    break;
+                }
+                outIds.push_back(tid);
+                pos += len;
+                matched = true;
+            }
+            if (!matched) return false;
+        }
+        if (pos >= lower.size()) return true;
+
+        // Fallback: trie unavailable — original per-length probing.
         while (pos < lower.size())
         {
             bool matched = false;
@@ -851,19 +898,61 @@ namespace HCPEngine
         const AZStd::vector<AZStd::string>& words,
         const AZStd::vector<AZ::u32>* modifiers)
     {
-        AZStd::string result;
+        // Two-pass reassembly. Pass 1 walks the stream once and resolves each
+        // token's rendered bytes, join decision and capitalization into a flat
+        // plan plus an exact byte count; pass 2 memcpy's everything into a
+        // single preallocated buffer and uppercases in place. A novel-sized
+        // retrieve is hundreds of thousands of tokens — appending token by
+        // token made this allocator-bound instead of bandwidth-bound.
+        struct Piece
+        {
+            const char* src;
+            AZ::u32 len;
+            AZ::u8 space;  // emit ' ' before the token
+            AZ::u8 caps;   // 0 = none, 1 = first char, 2 = all chars
+        };
+        static constexpr char PARA_BREAK[] = "\n\n";
+        static constexpr char EM_DASH[] = "\xe2\x80\x94";  // U+2014 —
+        static constexpr char EN_DASH[] = "\xe2\x80\x93";  // U+2013 –
+
+        AZStd::vector<Piece> plan;
+        plan.reserve(words.size());
+
+        size_t emitted = 0;          // exact output byte count so far
         bool capitalizeNext = true;  // Start of document — capitalize first word
 
+        // Rolling window of the last 3 output bytes, pre-capitalization.
+        // The join rules only test non-alpha bytes, which uppercasing never
+        // produces or destroys, so deferring the toupper to pass 2 is safe.
+        char tail[3] = { 0, 0, 0 };
+        auto pushTail = [&tail](const char* p, size_t n)
+        {
+            if (n >= 3)
+            {
+                tail[0] = p[n-3]; tail[1] = p[n-2]; tail[2] = p[n-1];
+            }
+            else if (n == 2)
+            {
+                tail[0] = tail[2]; tail[1] = p[0]; tail[2] = p[1];
+            }
+            else if (n == 1)
+            {
+                tail[0] = tail[1]; tail[1] = tail[2]; tail[2] = p[0];
+            }
+        };
+
         for (size_t i = 0; i < words.size(); ++i)
         {
-            AZStd::string text = words[i];
-            if (text.empty()) continue;
+            const AZStd::string& word = words[i];
+            if (word.empty()) continue;
 
             const AZ::u32 modifier = (modifiers && i < modifiers->size()) ? (*modifiers)[i] : 0;
 
             // Determine token character class from resolved word content.
             // Single-char strings are punctuation/control; multi-char are words.
-            char c = (text.size() == 1) ? text[0] : '\0';
+            char c = (word.size() == 1) ? word[0] : '\0';
+            const char* src = word.data();
+            size_t len = word.size();
             bool isDash = false;
             bool isControl = false;
 
@@ -873,7 +962,7 @@ namespace HCPEngine
                 // Single \n in source is whitespace (space), not a paragraph break.
                 if (c == '\n')
                 {
-                    text = "\n\n";
+                    src = PARA_BREAK; len = 2;
                     isControl = true;
                 }
                 else
@@ -884,19 +973,19 @@ namespace HCPEngine
             else
             {
                 // Em/en-dash: stored as words, render as Unicode
-                if (text == "emdash")
+                if (word == "emdash")
                 {
-                    text = "\xe2\x80\x94";  // U+2014 —
+                    src = EM_DASH; len = 3;
                     isDash = true;
                 }
-                else if (text == "endash")
+                else if (word == "endash")
                 {
-                    text = "\xe2\x80\x93";  // U+2013 –
+                    src = EN_DASH; len = 3;
                     isDash = true;
                 }
             }
 
-            bool needsSpace = !result.empty();
+            bool needsSpace = emitted != 0;
 
             if (needsSpace && isControl)
                 needsSpace = false;
@@ -916,9 +1005,9 @@ namespace HCPEngine
             }
 
             // Opening punctuation / post-newline: no space before following token
-            if (needsSpace && !result.empty())
+            if (needsSpace)
             {
-                char lastChar = result.back();
+                char lastChar = tail[2];
                 if (lastChar == '(' || lastChar == '[' || lastChar == '{' ||
                     lastChar == '"' || lastChar == '\'' ||
                     lastChar == '\n' || lastChar == '\t' || lastChar == '\f')
@@ -926,32 +1015,29 @@ namespace HCPEngine
                     needsSpace = false;
                 }
                 // After em/en-dash (3-byte UTF-8 sequence)
-                if (result.size() >= 3)
+                if (emitted >= 3)
                 {
-                    auto s = result.size();
-                    unsigned char b0 = result[s-3], b1 = result[s-2], b2 = result[s-1];
+                    unsigned char b0 = tail[0], b1 = tail[1], b2 = tail[2];
                     if (b0 == 0xE2 && b1 == 0x80 && (b2 == 0x94 || b2 == 0x93))
                         needsSpace = false;
                 }
             }
 
-            if (needsSpace) result += ' ';
-
             // Capitalization: word tokens and single-char alphabetic tokens (e.g. "I", "a")
             // Skip punctuation chars (non-alpha single chars).
-            if (!text.empty() && (c == '\0' || isalpha(static_cast<unsigned char>(c))))
+            AZ::u8 caps = 0;
+            if (c == '\0' || isalpha(static_cast<unsigned char>(c)))
             {
                 bool modFirstCap = (modifier & 1) != 0;
                 bool modAllCaps  = (modifier & 2) != 0;
                 if (modAllCaps)
                 {
-                    for (char& ch : text)
-                        ch = static_cast<char>(toupper(static_cast<unsigned char>(ch)));
+                    caps = 2;
                     capitalizeNext = false;
                 }
                 else if (modFirstCap || capitalizeNext)
                 {
-                    text[0] = static_cast<char>(toupper(static_cast<unsigned char>(text[0])));
+                    caps = 1;
                     capitalizeNext = false;
                 }
             }
@@ -960,7 +1046,33 @@ namespace HCPEngine
             if (c == '.' || c == '!' || c == '?' || c == '\n')
                 capitalizeNext = true;
 
-            result += text;
+            if (needsSpace)
+                pushTail(" ", 1);
+            pushTail(src, len);
+
+            emitted += len + (needsSpace ? 1 : 0);
+            plan.push_back({ src, static_cast<AZ::u32>(len),
+                             static_cast<AZ::u8>(needsSpace ? 1 : 0), caps });
+        }
+
+        AZStd::string result;
+        result.resize(emitted);
+        char* out = result.data();
+        for (const Piece& p : plan)
+        {
+            if (p.space)
+                *out++ = ' ';
+            memcpy(out, p.src, p.len);
+            if (p.caps == 1)
+            {
+                out[0] = static_cast<char>(toupper(static_cast<unsigned char>(out[0])));
+            }
+            else if (p.caps == 2)
+            {
+                for (AZ::u32 j = 0; j < p.len; ++j)
+                    out[j] = static_cast<char>(toupper(static_cast<unsigned char>(out[j])));
+            }
+            out += p.len;
         }
         return result;
     }
@@ -1,19 +1,33 @@
 #include "HCPVocabBed.h"
 #include "HCPVocabulary.h"
 #include "HCPEnvelopeManager.h"
+#include "HCPTokenHandle.h"
+#include "HCPResolveStats.h"
+#include "HCPMemoryBudget.h"
+#include "HCPNumaTopology.h"
 
 #include <AzCore/std/sort.h>
 #include <AzCore/std/containers/unordered_set.h>
 #include <lmdb.h>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cctype>
 #include <cmath>
 #include <cstring>
+#include <deque>
+#include <mutex>
 #include <regex>
+#include <thread>
 #include <vector>
 
+#include "Settle/ReplayCapture.h"
 #include "Settle/SettleKernel.h"
+#include "Settle/SettleKernelSimd.h"
+#include "Settle/VkSettleBackend.h"
 
 namespace HCPEngine
 {
@@ -24,13 +38,48 @@ namespace HCPEngine
     // Buffer: [vocab region (static)] [stream region (dynamic)]
     // ========================================================================
 
+    // HCP_VK_SETTLE=0 forces the host SIMD settle even when a Vulkan device and
+    // SPIR-V are available. Default: try the GPU, fall back silently.
+    static bool VkSettleEnabled()
+    {
+        static const bool enabled = []() {
+            const char* env = std::getenv("HCP_VK_SETTLE");
+            return !(env && env[0] == '0');
+        }();
+        return enabled;
+    }
+
+    // SPIR-V path for the settle kernel. HCP_SETTLE_SPV overrides; the default
+    // is settle.spv in the working directory (where build_spirv.sh drops it).
+    static const char* SettleSpvPath()
+    {
+        static const char* path = []() {
+            const char* env = std::getenv("HCP_SETTLE_SPV");
+            return (env && env[0] != '\0') ? env : "settle.spv";
+        }();
+        return path;
+    }
+
+    // HCP_SETTLE_CROSSCHECK=1 re-runs the legacy tierLookup string probe on
+    // every positionally identified settlement and logs any disagreement.
+    // Debug oracle only — default off.
+    static bool SettleCrossCheckEnabled()
+    {
+        static const bool enabled = []() {
+            const char* env = std::getenv("HCP_SETTLE_CROSSCHECK");
+            return env && env[0] == '1';
+        }();
+        return enabled;
+    }
+
     Workspace::~Workspace()
     {
         Shutdown();
     }
 
-    // Host-resident members (vectors + PODs) move cleanly — no GPU resources to
-    // hand off, so the compiler-generated moves are correct and leak-free.
+    // Host-resident members (vectors + PODs) move cleanly, and the Vulkan
+    // backend handle is a unique_ptr that moves with them, so the
+    // compiler-generated moves are correct and leak-free.
     Workspace::Workspace(Workspace&& other) noexcept = default;
     Workspace& Workspace::operator=(Workspace&& other) noexcept = default;
 
@@ -51,17 +100,32 @@ namespace HCPEngine
         for (AZ::u32 t = 0; t < maxTiers; ++t)
             m_tierPhases.push_back(t + 1);
 
-        // Allocate host particle arrays, all parked (off-screen, zero velocity, inert).
-        m_pos.assign(bufferCapacity, hcp::settle::Float4{ 0.0f, -100.0f, 0.0f, 0.0f });
-        m_vel.assign(bufferCapacity, hcp::settle::Float4{ 0.0f, 0.0f, 0.0f, 0.0f });
+        // Allocate host particle planes (SoA), all parked (off-screen, zero velocity, inert).
+        m_posX.assign(bufferCapacity, 0.0f);
+        m_posY.assign(bufferCapacity, -100.0f);
+        m_posZ.assign(bufferCapacity, 0.0f);
+        m_posW.assign(bufferCapacity, 0.0f);
+        m_velX.assign(bufferCapacity, 0.0f);
+        m_velY.assign(bufferCapacity, 0.0f);
+        m_velZ.assign(bufferCapacity, 0.0f);
         m_phase.assign(bufferCapacity, m_inertPhase);
         m_activeParticles = 0;
+        m_dynHighWater = 0;   // every particle above is freshly parked
 
         m_vocabParticleCount = 0;
         m_maxStreamSlots = 0;
         m_currentWordLength = 0;
         m_activeInScene = false;
 
+        // Vulkan settle backend: persistent device buffers at workspace
+        // capacity. TryCreate logs its reason once and returns null when there
+        // is no loader / device / SPIR-V; the host SIMD settle in BeginSimulate
+        // stays the fallback either way.
+        if (VkSettleEnabled() && !m_vkBackend)
+            m_vkBackend = hcp::settle::VkSettleBackend::TryCreate(bufferCapacity, SettleSpvPath());
+        m_vkVocabDirtyFrom = 0;
+        m_vkActiveCount = 0;
+
         return true;
     }
 
@@ -70,12 +134,18 @@ namespace HCPEngine
         fprintf(stderr, "[WS] LoadVocabPack: len=%u vocabParticles=%u bufCap=%u\n",
             wordLength, pack.totalVocabParticles, m_bufferCapacity);
         fflush(stderr);
-        if (m_pos.empty()) return 0;
+        if (m_posX.empty()) return 0;
         if (pack.totalVocabParticles == 0 || pack.totalVocabParticles > m_bufferCapacity) return 0;
 
+        const AZ::u32 oldVocabCount = m_vocabParticleCount;
         m_vocabParticleCount = pack.totalVocabParticles;
         m_currentWordLength = wordLength;
 
+        // Vocab beds carry no rule pack — drop any stale capture stash.
+        m_capPackCellLength = 0;
+        m_capPackPatternCount = 0;
+        m_capPackChars.clear();
+
         // Compute stream capacity from remaining buffer
         AZ::u32 remainingCapacity = m_bufferCapacity - m_vocabParticleCount;
         m_maxStreamSlots = remainingCapacity / wordLength;
@@ -85,15 +155,45 @@ namespace HCPEngine
             m_maxStreamSlots, remainingCapacity);
         fflush(stderr);
 
-        // Write vocab into the host arrays (was a CUDA H->D copy; now a direct write).
-        for (AZ::u32 i = 0; i < m_vocabParticleCount; ++i)
+        // Delta-aware load: frequency-ordered packs for neighbouring phases share
+        // a long common prefix, so diff against the resident vocab region and
+        // rewrite only from the first mismatch on. Equality = position AND phase
+        // tag agree (vocab velocities are always zero, and a particle that was
+        // vocab last pack still has zero velocity — bed chars never move).
+        // Particles past the old vocab count held stream data and always rewrite.
+        AZ::u32 writeFrom = 0;
+        {
+            const AZ::u32 comparable =
+                (oldVocabCount < m_vocabParticleCount) ? oldVocabCount : m_vocabParticleCount;
+            while (writeFrom < comparable)
+            {
+                const AZ::u32 base = writeFrom * 4;
+                const AZ::u32 logicalTier = pack.phases[writeFrom];
+                const AZ::u32 phase = (logicalTier < m_tierPhases.size())
+                    ? m_tierPhases[logicalTier]
+                    : m_inertPhase;
+                if (m_posX[writeFrom] != pack.positions[base + 0] ||
+                    m_posY[writeFrom] != pack.positions[base + 1] ||
+                    m_posZ[writeFrom] != pack.positions[base + 2] ||
+                    m_posW[writeFrom] != pack.positions[base + 3] ||
+                    m_phase[writeFrom] != phase)
+                {
+                    break;
+                }
+                ++writeFrom;
+            }
+        }
+
+        // Write the changed span into the host planes (was a CUDA H->D copy; now
+        // a direct SoA scatter from the pack's flat [x,y,z,w] array).
+        for (AZ::u32 i = writeFrom; i < m_vocabParticleCount; ++i)
         {
             AZ::u32 base = i * 4;
-            m_pos[i] = { pack.positions[base + 0],
-                         pack.positions[base + 1],
-                         pack.positions[base + 2],
-                         pack.positions[base + 3] };
-            m_vel[i] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            m_posX[i] = pack.positions[base + 0];
+            m_posY[i] = pack.positions[base + 1];
+            m_posZ[i] = pack.positions[base + 2];
+            m_posW[i] = pack.positions[base + 3];
+            m_velX[i] = 0.0f; m_velY[i] = 0.0f; m_velZ[i] = 0.0f;
             // Remap logical tier index to phase tag
             AZ::u32 logicalTier = pack.phases[i];
             m_phase[i] = (logicalTier < m_tierPhases.size())
@@ -103,6 +203,17 @@ namespace HCPEngine
 
         // Only vocab active, no stream yet
         m_activeParticles = m_vocabParticleCount;
+        if (m_vocabParticleCount > m_dynHighWater)
+            m_dynHighWater = m_vocabParticleCount;
+        // Device copy is stale from the first rewritten particle on; the GPU
+        // upload in BeginSimulate starts there instead of re-sending the whole
+        // region (min: the previous dirty span may still be un-uploaded).
+        if (writeFrom < m_vkVocabDirtyFrom)
+            m_vkVocabDirtyFrom = writeFrom;
+
+        fprintf(stderr, "[WS] LoadVocabPack: resident prefix=%u/%u reused\n",
+            writeFrom, m_vocabParticleCount);
+        fflush(stderr);
 
         m_streamSlots.clear();
 
@@ -114,12 +225,13 @@ namespace HCPEngine
     AZ::u32 Workspace::LoadStreamRuns(
         const AZStd::vector<CharRun>& runs,
         const AZStd::vector<AZ::u32>& indices,
-        AZ::u32 wordLength)
+        AZ::u32 wordLength,
+        const VocabPack* pack)
     {
         fprintf(stderr, "[WS] LoadStreamRuns: %zu indices, wordLen=%u, vocabCount=%u\n",
             indices.size(), wordLength, m_vocabParticleCount);
         fflush(stderr);
-        if (m_pos.empty() || indices.empty()) return 0;
+        if (m_posX.empty() || indices.empty()) return 0;
 
         m_streamSlots.clear();
         AZ::u32 overflowCount = 0;
@@ -130,14 +242,6 @@ namespace HCPEngine
             maxDynParticles, m_maxStreamSlots, wordLength);
         fflush(stderr);
 
-        // Init dynamic region to parked state (direct host write — was a pinned buffer)
-        for (AZ::u32 i = 0; i < maxDynParticles; ++i)
-        {
-            m_pos[dynBase + i] = { 0.0f, -100.0f, 0.0f, 0.0f };
-            m_vel[dynBase + i] = { 0.0f, 0.0f, 0.0f, 0.0f };
-            m_phase[dynBase + i] = m_inertPhase;
-        }
-
         AZ::u32 slotIdx = 0;
         for (AZ::u32 ri = 0; ri < static_cast<AZ::u32>(indices.size()); ++ri)
         {
@@ -162,14 +266,29 @@ namespace HCPEngine
             ss.firstCap = run.firstCap;
             ss.allCaps = run.allCaps;
 
+            // Bind identity by position NOW, off the settle readback path:
+            // one tier-0 probe per slot at load, so CheckSettlement only
+            // indexes. Slot geometry is deterministic, so the binding holds
+            // for the whole cycle (claim 606/613 — identity rides the slot).
+            if (pack && !pack->tierLookup.empty())
+            {
+                auto found = pack->tierLookup[0].find(run.text);
+                ss.vocabEntry = (found != pack->tierLookup[0].end())
+                    ? found->second
+                    : StreamRunSlot::ENTRY_NONE;
+            }
+
             for (AZ::u32 c = 0; c < charCount; ++c)
             {
                 char ch = (c < run.text.size()) ? run.text[c] : '\0';
                 float z = static_cast<float>(static_cast<unsigned char>(ch)) * RC_Z_SCALE;
 
                 AZ::u32 p = dynBase + dynOffset + c;
-                m_pos[p] = { static_cast<float>(c), RC_Y_OFFSET, z, 1.0f };
-                m_vel[p] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                m_posX[p] = static_cast<float>(c);
+                m_posY[p] = RC_Y_OFFSET;
+                m_posZ[p] = z;
+                m_posW[p] = 1.0f;
+                m_velX[p] = 0.0f; m_velY[p] = 0.0f; m_velZ[p] = 0.0f;
                 m_phase[p] = streamPhase;
             }
 
@@ -184,6 +303,22 @@ namespace HCPEngine
         AZ::u32 actualDynParticles = slotIdx * wordLength;
         m_activeParticles = m_vocabParticleCount + actualDynParticles;
 
+        // Park only the STALE remainder: particles past this load that still
+        // hold live data from an earlier, larger cycle. Everything below was
+        // just overwritten with run data, and everything past the high-water
+        // mark has been parked since Create — so reset cost is proportional to
+        // particles actually used, not to the workspace's stream capacity
+        // (late phases routinely carry <100 runs in a WS_BUFFER_CAPACITY buffer,
+        // and the old full-capacity park was pure overhead for them).
+        const AZ::u32 liveEnd = dynBase + actualDynParticles;
+        for (AZ::u32 p = liveEnd; p < m_dynHighWater; ++p)
+        {
+            m_posX[p] = 0.0f; m_posY[p] = -100.0f; m_posZ[p] = 0.0f; m_posW[p] = 0.0f;
+            m_velX[p] = 0.0f; m_velY[p] = 0.0f;    m_velZ[p] = 0.0f;
+            m_phase[p] = m_inertPhase;
+        }
+        m_dynHighWater = liveEnd;
+
         fprintf(stderr, "[WS] LoadStreamRuns: done, activeParticles=%u (vocab=%u+dyn=%u), overflow=%u\n",
             m_vocabParticleCount + actualDynParticles, m_vocabParticleCount, actualDynParticles, overflowCount);
         fflush(stderr);
@@ -192,54 +327,101 @@ namespace HCPEngine
 
     void Workspace::CheckSettlement(AZ::u32 tierIndex, const VocabPack& pack)
     {
-        if (m_pos.empty() || m_streamSlots.empty()) return;
+        if (m_posX.empty() || m_streamSlots.empty()) return;
 
         // Velocities are host-resident — read directly (was a CUDA D->H readback).
+        // SoA planes: the L1 gate reads all three velocity components, each a
+        // dense sequential scan over its own plane.
         AZ::u32 readbackCount = m_vocabParticleCount +
             static_cast<AZ::u32>(m_streamSlots.size()) * m_currentWordLength;
         if (readbackCount > m_bufferCapacity) readbackCount = m_bufferCapacity;
 
-        const hcp::settle::Float4* hostVel = m_vel.data();
-
         // Get tier lookup (O(1) hash)
         const AZStd::unordered_map<AZStd::string, AZ::u32>* lookup = nullptr;
         if (tierIndex < pack.tierLookup.size())
             lookup = &pack.tierLookup[tierIndex];
 
+        // Length-specialized gate: every stream slot in a phase shares
+        // m_currentWordLength, so the unrolled kernel is dispatched once here
+        // and reused per slot. Slots that clip the readback range (or carry an
+        // off-length charCount) keep the clamped runtime loop below.
+        const hcp::settle::GatePlaneFn gateFn =
+            hcp::settle::GatePlaneKernelForLength(m_currentWordLength);
+
         for (auto& slot : m_streamSlots)
         {
             if (slot.resolved) continue;
 
             AZ::u32 settledCount = 0;
-            for (AZ::u32 c = 0; c < slot.charCount; ++c)
+            if (gateFn && slot.charCount == m_currentWordLength &&
+                slot.bufferStart + slot.charCount <= readbackCount)
+            {
+                settledCount = gateFn(m_velX.data(), m_velY.data(), m_velZ.data(),
+                    slot.bufferStart, WS_VELOCITY_SETTLE_THRESHOLD);
+            }
+            else
             {
-                AZ::u32 idx = slot.bufferStart + c;
-                if (idx >= readbackCount) break;
-                float vMag = fabsf(hostVel[idx].x) + fabsf(hostVel[idx].y) + fabsf(hostVel[idx].z);
-                if (vMag < WS_VELOCITY_SETTLE_THRESHOLD)
-                    ++settledCount;
+                for (AZ::u32 c = 0; c < slot.charCount; ++c)
+                {
+                    AZ::u32 idx = slot.bufferStart + c;
+                    if (idx >= readbackCount) break;
+                    float vMag = fabsf(m_velX[idx]) + fabsf(m_velY[idx]) + fabsf(m_velZ[idx]);
+                    if (vMag < WS_VELOCITY_SETTLE_THRESHOLD)
+                        ++settledCount;
+                }
             }
 
-            if (settledCount == slot.charCount && lookup)
+            if (settledCount != slot.charCount) continue;
+
+            // Positional identification: the entry index was bound to the slot
+            // at LoadStreamRuns, so a settled run is identified by indexing —
+            // no string hashing here. tierLookup is consulted only for slots
+            // loaded without a pack or for non-zero tiers, and as the
+            // HCP_SETTLE_CROSSCHECK debug oracle.
+            AZ::u32 entryIdx = StreamRunSlot::ENTRY_NONE;
+            if (tierIndex == 0 && slot.vocabEntry != StreamRunSlot::ENTRY_UNBOUND)
             {
-                auto it = lookup->find(slot.runText);
-                if (it != lookup->end())
+                entryIdx = slot.vocabEntry;
+                if (SettleCrossCheckEnabled() && lookup)
                 {
-                    AZ::u32 entryIdx = it->second;
-                    slot.resolved = true;
-                    slot.tierResolved = tierIndex;
-                    slot.matchedWord = pack.entries[entryIdx].word;
-                    slot.matchedTokenId = pack.entries[entryIdx].tokenId;
-                    slot.morphBits = pack.entries[entryIdx].morphBits;
+                    auto it = lookup->find(slot.runText);
+                    const AZ::u32 viaLookup = (it != lookup->end())
+                        ? it->second : StreamRunSlot::ENTRY_NONE;
+                    if (viaLookup != entryIdx)
+                    {
+                        fprintf(stderr, "[WS] CheckSettlement crosscheck mismatch: "
+                            "run '%s' positional=%u lookup=%u\n",
+                            slot.runText.c_str(), entryIdx, viaLookup);
+                        fflush(stderr);
+                    }
                 }
             }
+            else if (lookup)
+            {
+                auto it = lookup->find(slot.runText);
+                if (it != lookup->end())
+                    entryIdx = it->second;
+            }
+
+            if (entryIdx < static_cast<AZ::u32>(pack.hot.size()))
+            {
+                const VocabPack::HotEntry& he = pack.hot[entryIdx];
+                slot.resolved = true;
+                slot.tierResolved = tierIndex;
+                // Cold identity is touched only here, on a hit: word chars
+                // come from the blob, token id from the cold array.
+                slot.matchedWord.assign(
+                    pack.charBlob.data() + he.charOffset, he.charCount);
+                slot.matchedTokenId = pack.coldTokenIds[entryIdx];
+                slot.morphBits = he.morphBits;
+            }
         }
     }
 
     // ---- LoadRulePack: load partial-match patterns into vocab region ----
     AZ::u32 Workspace::LoadRulePack(const RulePack& pack)
     {
-        if (m_pos.empty()) return 0;
+        if (m_posX.empty()) return 0;
         if (pack.totalPatternParticles == 0 || pack.totalPatternParticles > m_bufferCapacity) return 0;
 
         m_vocabParticleCount = pack.totalPatternParticles;
@@ -253,14 +435,39 @@ namespace HCPEngine
         for (AZ::u32 i = 0; i < m_vocabParticleCount; ++i)
         {
             AZ::u32 base = i * 4;
-            m_pos[i] = { pack.positions[base], pack.positions[base+1],
-                         pack.positions[base+2], pack.positions[base+3] };
-            m_vel[i] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            m_posX[i] = pack.positions[base + 0];
+            m_posY[i] = pack.positions[base + 1];
+            m_posZ[i] = pack.positions[base + 2];
+            m_posW[i] = pack.positions[base + 3];
+            m_velX[i] = 0.0f; m_velY[i] = 0.0f; m_velZ[i] = 0.0f;
             m_phase[i] = patternPhase;
         }
 
         m_activeParticles = m_vocabParticleCount;
+        if (m_vocabParticleCount > m_dynHighWater)
+            m_dynHighWater = m_vocabParticleCount;
+        m_vkVocabDirtyFrom = 0;  // device copy of the pattern region is fully stale
         m_streamSlots.clear();
+
+        // Stash the pattern bytes for replay capture — rebuilt from the packed
+        // broadphase lanes so the capture matches what the compare actually sees.
+        if (hcp::replay::CaptureEnabled() && pack.laneCount > 0)
+        {
+            m_capPackCellLength = pack.cellLength;
+            m_capPackPatternCount = pack.patternCount;
+            m_capPackChars.assign(
+                static_cast<size_t>(pack.patternCount) * pack.cellLength, '\0');
+            for (AZ::u32 pi = 0; pi < pack.patternCount; ++pi)
+            {
+                for (AZ::u32 c = 0; c < pack.cellLength; ++c)
+                {
+                    AZ::u64 lane = pack.packedChars[pi * pack.laneCount + c / 8];
+                    m_capPackChars[pi * pack.cellLength + c] =
+                        static_cast<char>((lane >> ((c % 8) * 8)) & 0xFF);
+                }
+            }
+        }
+
         return m_maxStreamSlots;
     }
 
@@ -268,46 +475,67 @@ namespace HCPEngine
     void Workspace::CheckPartialSettlement(const RulePack& pack,
         AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>>& matches)
     {
-        if (m_pos.empty() || m_streamSlots.empty()) return;
+        if (m_posX.empty() || m_streamSlots.empty()) return;
 
         AZ::u32 readbackCount = m_vocabParticleCount +
             static_cast<AZ::u32>(m_streamSlots.size()) * m_currentWordLength;
         if (readbackCount > m_bufferCapacity) readbackCount = m_bufferCapacity;
 
-        // Positions + velocities are host-resident — read directly (was a CUDA readback).
-        const hcp::settle::Float4* hostPos = m_pos.data();
-        const hcp::settle::Float4* hostVel = m_vel.data();
+        // Positions + velocities are host-resident — read directly (was a CUDA
+        // readback). Only the Z position plane and velocity planes are touched,
+        // which is exactly what the SoA layout keeps dense.
+        //
+        // Each slot is quantized ONCE — settled-position bitmask plus the
+        // nearest char code per position, packed 8-per-u64 lane — then every
+        // pattern is a handful of masked u64 compares against the masks
+        // BuildRulePack precomputed. This replaces the old scalar walk over
+        // every (pattern, position) pair; byte equality after lroundf is the
+        // same criterion as |streamZ - patZ| < RC_Z_SCALE/2 (the quantization
+        // CheckSettlement already uses).
+
+        AZ::u64 slotChars[8];  // cellLength <= 64 by construction
 
         for (AZ::u32 si = 0; si < static_cast<AZ::u32>(m_streamSlots.size()); ++si)
         {
             auto& slot = m_streamSlots[si];
             if (slot.resolved) continue;
 
-            for (AZ::u32 pi = 0; pi < pack.patternCount; ++pi)
+            AZ::u64 settledMask = 0;
+            memset(slotChars, 0, pack.laneCount * sizeof(AZ::u64));
+
+            for (AZ::u32 c = 0; c < pack.cellLength; ++c)
             {
-                AZ::u32 activeCount = pack.activePositionCount[pi];
-                if (activeCount == 0) continue;
+                AZ::u32 streamIdx = slot.bufferStart + c;
+                if (streamIdx >= readbackCount) break;
 
-                AZ::u32 activeSettled = 0;
-                for (AZ::u32 c = 0; c < pack.cellLength; ++c)
-                {
-                    float patZ = pack.positions[(pi * pack.cellLength + c) * 4 + 2];
-                    if (patZ == 0.0f) continue;  // Inert position
+                float vMag = fabsf(m_velX[streamIdx]) + fabsf(m_velY[streamIdx])
+                           + fabsf(m_velZ[streamIdx]);
+                if (vMag >= WS_VELOCITY_SETTLE_THRESHOLD) continue;
 
-                    AZ::u32 streamIdx = slot.bufferStart + c;
-                    if (streamIdx >= readbackCount) break;
+                settledMask |= AZ::u64(1) << c;
+                AZ::u32 zi = static_cast<AZ::u32>(lroundf(m_posZ[streamIdx] / RC_Z_SCALE));
+                slotChars[c / 8] |= static_cast<AZ::u64>(zi & 0xFF) << ((c % 8) * 8);
+            }
 
-                    float vMag = fabsf(hostVel[streamIdx].x) + fabsf(hostVel[streamIdx].y)
-                               + fabsf(hostVel[streamIdx].z);
-                    if (vMag < WS_VELOCITY_SETTLE_THRESHOLD)
+            for (AZ::u32 pi = 0; pi < pack.patternCount; ++pi)
+            {
+                AZ::u64 active = pack.activeMask[pi];
+                if (active == 0) continue;
+                if ((settledMask & active) != active) continue;
+
+                bool match = true;
+                const AZ::u64* patChars = &pack.packedChars[pi * pack.laneCount];
+                const AZ::u64* patMask = &pack.laneMask[pi * pack.laneCount];
+                for (AZ::u32 lane = 0; lane < pack.laneCount; ++lane)
+                {
+                    if ((slotChars[lane] ^ patChars[lane]) & patMask[lane])
                     {
-                        float streamZ = hostPos[streamIdx].z;
-                        if (fabsf(streamZ - patZ) < RC_Z_SCALE * 0.5f)
-                            ++activeSettled;
+                        match = false;
+                        break;
                     }
                 }
 
-                if (activeSettled == activeCount)
+                if (match)
                 {
                     matches.push_back({si, pi});
                     slot.resolved = true;
@@ -319,7 +547,7 @@ namespace HCPEngine
 
     void Workspace::FlipToTier(AZ::u32 nextTier)
     {
-        if (m_pos.empty()) return;
+        if (m_posX.empty()) return;
         if (nextTier >= m_tierPhases.size()) return;
 
         AZ::u32 newPhase = m_tierPhases[nextTier];
@@ -340,9 +568,9 @@ namespace HCPEngine
                 {
                     AZ::u32 p = slot.bufferStart + c;
                     m_phase[p] = newPhase;
-                    m_pos[p].y = RC_Y_OFFSET;
-                    m_pos[p].w = 1.0f;
-                    m_vel[p] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    m_posY[p] = RC_Y_OFFSET;
+                    m_posW[p] = 1.0f;
+                    m_velX[p] = 0.0f; m_velY[p] = 0.0f; m_velZ[p] = 0.0f;
                 }
             }
         }
@@ -404,7 +632,10 @@ namespace HCPEngine
 
     void Workspace::ResetDynamics()
     {
-        if (m_pos.empty()) return;
+        if (m_posX.empty()) return;
+        // Metadata-only: the stream particles stay dirty and are parked (or
+        // overwritten) by the next LoadStreamRuns' dirty-span fold — nothing
+        // reads the dynamic region while m_streamSlots is empty.
         m_activeParticles = m_vocabParticleCount;
         m_streamSlots.clear();
     }
@@ -424,76 +655,297 @@ namespace HCPEngine
 
     void Workspace::BeginSimulate(int steps, float dt)
     {
-        if (m_pos.empty() || steps <= 0) return;
+        if (m_posX.empty() || steps <= 0) return;
+        ScopedStageTimer stageTimer(ResolveStage::Settle);
         m_simDt = dt;
-        m_pendingSteps = 0;   // AZSL settle runs synchronously here; no async steps pending
+        m_pendingSteps = 0;   // set only when a GPU submit is actually in flight
 
         AZ::u32 count = m_vocabParticleCount +
             static_cast<AZ::u32>(m_streamSlots.size()) * m_currentWordLength;
         if (count > m_bufferCapacity) count = m_bufferCapacity;
         if (count == 0) return;
 
-        // AZSL settle replaces the PhysX-PBD settle. SettleKernel is the validated host
-        // reference of the AZSL compute kernel; per-particle independent (the parallel form
-        // is HCPSettleCompute.azsl). position.w = invMass: >0 movable run, 0 immovable bed.
-        // Particle data is host-resident now — the settle reads/writes m_pos/m_vel directly
-        // (no CUDA round-trip). Verlet history is reconstructed from velocity each call.
-        std::vector<hcp::settle::Float4> cur(m_pos.begin(), m_pos.begin() + count);
-        std::vector<hcp::settle::Float4> prev(count);
-        for (AZ::u32 i = 0; i < count; ++i)
-        {
-            prev[i] = { m_pos[i].x - m_vel[i].x * dt,
-                        m_pos[i].y - m_vel[i].y * dt,
-                        m_pos[i].z - m_vel[i].z * dt, m_pos[i].w };
-        }
         // Differential contact floor (the bed broad-phase): a movable run char rests on
         // the bed surface (Y=0) ONLY if a bed char shares its (X, Z) — same letter at the
         // same position. No match → NO_FLOOR → it falls through and never settles. So a run
         // settles iff every char has bed support, i.e. its spelling is present in the bed.
         // (Was a flat NO_FLOOR for every particle, so nothing ever settled — claim 626.)
+        // Computed as its own plane so both settle paths (GPU upload / host SoA) share it.
         std::vector<float> restY(count, hcp::settle::NO_FLOOR);
         {
-            auto cellKey = [](const hcp::settle::Float4& p) -> uint64_t {
-                uint32_t xi = static_cast<uint32_t>(lroundf(p.x));
-                uint32_t zi = static_cast<uint32_t>(lroundf(p.z / RC_Z_SCALE));
+            auto cellKey = [&](AZ::u32 i) -> uint64_t {
+                uint32_t xi = static_cast<uint32_t>(lroundf(m_posX[i]));
+                uint32_t zi = static_cast<uint32_t>(lroundf(m_posZ[i] / RC_Z_SCALE));
                 return (static_cast<uint64_t>(xi) << 32) | zi;
             };
             AZStd::unordered_set<uint64_t> bedCells;
             AZ::u32 bedCount = (m_vocabParticleCount < count) ? m_vocabParticleCount : count;
             bedCells.reserve(bedCount);
             for (AZ::u32 i = 0; i < bedCount; ++i)
-                bedCells.insert(cellKey(cur[i]));                  // static bed region [0, vocab)
+                bedCells.insert(cellKey(i));                       // static bed region [0, vocab)
             for (AZ::u32 i = m_vocabParticleCount; i < count; ++i) // movable run region [vocab, count)
-                if (bedCells.count(cellKey(cur[i])))
+                if (bedCells.count(cellKey(i)))
                     restY[i] = 0.0f;                               // matching bed char → rest on the bed
         }
-        for (int s = 0; s < steps; ++s)
-            hcp::settle::SettleStepAll(cur, prev, restY);
+
+        m_tierSettledCounts.clear();
+
+        // GPU path: the backend keeps device buffers resident, so only stale
+        // ranges upload — the whole buffer when the pack changed, just the
+        // stream region otherwise (bed particles are immovable; their device
+        // copy stays exact across batches). The full step budget is submitted
+        // asynchronously; IsSimDone polls the fence, FetchSimResults reads back.
+        // Multi-tier packs take the host path: the fused tier re-gate below
+        // works on host planes, and a device-side re-gate needs the AZSL
+        // kernel to carry tier state (not there yet).
+        if (m_vkBackend && m_maxTierCount <= 1)
+        {
+            AZ::u32 first = (m_vkVocabDirtyFrom < m_vocabParticleCount)
+                ? m_vkVocabDirtyFrom
+                : m_vocabParticleCount;
+            if (first > count) first = count;
+            m_vkBackend->UploadRange(
+                m_posX.data(), m_posY.data(), m_posZ.data(), m_posW.data(),
+                m_velX.data(), m_velY.data(), m_velZ.data(),
+                restY.data(), dt, first, count - first);
+            if (m_vkBackend->Begin(count, steps, dt))
+            {
+                m_vkVocabDirtyFrom = m_vocabParticleCount;   // device vocab now current
+                m_vkActiveCount = count;
+                m_pendingSteps = steps;
+                // The async submit runs its full budget (a per-step readback
+                // would serialize it); recorded so the settle_steps ratio in
+                // the stats surface reflects actual work done.
+                ResolveStats::Get().RecordSettleSteps(
+                    static_cast<uint64_t>(steps), static_cast<uint64_t>(steps));
+                return;
+            }
+            // Submit failed — run the host settle for this cycle instead.
+        }
+
+        // Host path. AZSL settle replaces the PhysX-PBD settle. SettleKernel is the
+        // validated host reference of the AZSL compute kernel; per-particle independent
+        // (the parallel form is HCPSettleCompute.azsl). position.w = invMass: >0 movable
+        // run, 0 immovable bed. Particle data is host-resident SoA planes — the batched
+        // SIMD settle (SettleKernelSimd.h) consumes them plane-for-plane, no AoS repack.
+        // Verlet history is reconstructed from velocity each call.
+        hcp::settle::SettleSoA soa;
+        soa.Resize(count);
+        for (AZ::u32 i = 0; i < count; ++i)
+        {
+            soa.curX[i] = m_posX[i]; soa.curY[i] = m_posY[i];
+            soa.curZ[i] = m_posZ[i]; soa.curW[i] = m_posW[i];
+            soa.prevX[i] = m_posX[i] - m_velX[i] * dt;
+            soa.prevY[i] = m_posY[i] - m_velY[i] * dt;
+            soa.prevZ[i] = m_posZ[i] - m_velZ[i] * dt;
+            soa.restY[i] = restY[i];
+        }
+
+        // Replay capture (HCP_REPLAY_DIR): serialize this batch's full settle
+        // input — planes, floors, slots, rule pack, constants — one file per
+        // batch. Settle/replay_settle.cpp re-runs and times it standalone.
+        if (hcp::replay::CaptureEnabled())
+        {
+            hcp::replay::ReplayData cap;
+            cap.header.particleCount = count;
+            cap.header.vocabCount = m_vocabParticleCount;
+            cap.header.slotCount = static_cast<AZ::u32>(m_streamSlots.size());
+            cap.header.packCellLength = m_capPackCellLength;
+            cap.header.packPatternCount = m_capPackPatternCount;
+            cap.header.dt = dt;
+            cap.header.steps = steps;
+            cap.header.velThreshold = WS_VELOCITY_SETTLE_THRESHOLD;
+            cap.header.zScale = RC_Z_SCALE;
+            cap.header.yOffset = RC_Y_OFFSET;
+            cap.curX = soa.curX; cap.curY = soa.curY;
+            cap.curZ = soa.curZ; cap.curW = soa.curW;
+            cap.prevX = soa.prevX; cap.prevY = soa.prevY; cap.prevZ = soa.prevZ;
+            cap.restY = soa.restY;
+            cap.slots.reserve(m_streamSlots.size());
+            for (const auto& slot : m_streamSlots)
+                cap.slots.push_back({ slot.bufferStart, slot.charCount });
+            cap.packChars = m_capPackChars;
+
+            static std::atomic<uint32_t> s_captureSeq{0};
+            char path[512];
+            snprintf(path, sizeof(path), "%s/replay_%05u.hrp",
+                hcp::replay::CaptureDir(), s_captureSeq.fetch_add(1) + 1);
+            if (hcp::replay::Write(path, cap))
+            {
+                fprintf(stderr, "[Workspace] Replay captured: %s (%u particles, "
+                    "%u slots)\n", path, count, cap.header.slotCount);
+                fflush(stderr);
+            }
+        }
+
+        // Convergence-aware budget: `steps` is a cap, not a fixed cost. The
+        // loop stops once every movable particle is below the gate, or once
+        // the unsettled count plateaus after landings begin (the stragglers
+        // are free-fallers whose gate decision more steps cannot change).
+        const int stepsRun = hcp::settle::SettleToConvergence(
+            soa, dt, WS_VELOCITY_SETTLE_THRESHOLD, steps);
+        ResolveStats::Get().RecordSettleSteps(
+            static_cast<uint64_t>(steps), static_cast<uint64_t>(stepsRun));
 
         for (AZ::u32 i = 0; i < count; ++i)
         {
-            m_pos[i] = { cur[i].x, cur[i].y, cur[i].z, m_pos[i].w };
-            m_vel[i] = { (cur[i].x - prev[i].x) / dt,
-                         (cur[i].y - prev[i].y) / dt,
-                         (cur[i].z - prev[i].z) / dt, 0.0f };
+            m_posX[i] = soa.curX[i];
+            m_posY[i] = soa.curY[i];
+            m_posZ[i] = soa.curZ[i];   // m_posW (invMass) is untouched by the settle
+            m_velX[i] = (soa.curX[i] - soa.prevX[i]) / dt;
+            m_velY[i] = (soa.curY[i] - soa.prevY[i]) / dt;
+            m_velZ[i] = (soa.curZ[i] - soa.prevZ[i]) / dt;
         }
+
+        // ---- Fused multi-tier settle ----
+        // Multi-tier packs used to need a host round trip per tier:
+        // CheckSettlement → FlipToTier → another full BeginSimulate budget.
+        // The re-gate now happens here on the planes just written back: slots
+        // that settled are frozen (invMass 0 — later passes must not disturb
+        // the landing), the rest relaunch with the next tier's phase and a
+        // fresh budget, and per-tier counts come out of TierSettledCounts().
+        // The settle itself is phase-blind (the differential floor spans all
+        // tiers); the phase relabel is kept for CheckSettlement's per-tier
+        // lookups.
+        if (m_maxTierCount > 1 && !m_streamSlots.empty())
+        {
+            m_tierSettledCounts.assign(m_maxTierCount, 0);
+            std::vector<bool> settledMark(m_streamSlots.size(), false);
+
+            auto freezeSlot = [&](const StreamRunSlot& slot)
+            {
+                for (AZ::u32 c = 0; c < slot.charCount; ++c)
+                {
+                    AZ::u32 p = slot.bufferStart + c;
+                    if (p >= count) break;
+                    m_posW[p] = 0.0f;
+                }
+            };
+
+            for (AZ::u32 tier = 0; tier + 1 < m_maxTierCount; ++tier)
+            {
+                AZ::u32 nextPhase = (tier + 1 < m_tierPhases.size())
+                    ? m_tierPhases[tier + 1] : m_inertPhase;
+                AZ::u32 regated = 0;
+
+                for (AZ::u32 si = 0; si < static_cast<AZ::u32>(m_streamSlots.size()); ++si)
+                {
+                    auto& slot = m_streamSlots[si];
+                    if (settledMark[si] || slot.resolved) continue;
+
+                    if (SlotSettled(slot, count))
+                    {
+                        settledMark[si] = true;
+                        ++m_tierSettledCounts[tier];
+                        freezeSlot(slot);
+                        continue;
+                    }
+
+                    // Re-gate: relaunch this slot's chars for the next tier.
+                    ++regated;
+                    for (AZ::u32 c = 0; c < slot.charCount; ++c)
+                    {
+                        AZ::u32 p = slot.bufferStart + c;
+                        if (p >= count) break;
+                        m_phase[p] = nextPhase;
+                        m_posY[p] = RC_Y_OFFSET;
+                        m_posW[p] = 1.0f;
+                        m_velX[p] = 0.0f; m_velY[p] = 0.0f; m_velZ[p] = 0.0f;
+                    }
+                }
+
+                if (regated == 0) break;
+
+                // Fresh budget for the re-gated runs — same floor (X/Z and the
+                // bed are untouched by the relaunch, so restY stays valid).
+                for (AZ::u32 i = 0; i < count; ++i)
+                {
+                    soa.curX[i] = m_posX[i]; soa.curY[i] = m_posY[i];
+                    soa.curZ[i] = m_posZ[i]; soa.curW[i] = m_posW[i];
+                    soa.prevX[i] = m_posX[i] - m_velX[i] * dt;
+                    soa.prevY[i] = m_posY[i] - m_velY[i] * dt;
+                    soa.prevZ[i] = m_posZ[i] - m_velZ[i] * dt;
+                }
+                const int tierSteps = hcp::settle::SettleToConvergence(
+                    soa, dt, WS_VELOCITY_SETTLE_THRESHOLD, steps);
+                ResolveStats::Get().RecordSettleSteps(
+                    static_cast<uint64_t>(steps), static_cast<uint64_t>(tierSteps));
+                for (AZ::u32 i = 0; i < count; ++i)
+                {
+                    m_posX[i] = soa.curX[i];
+                    m_posY[i] = soa.curY[i];
+                    m_posZ[i] = soa.curZ[i];
+                    m_velX[i] = (soa.curX[i] - soa.prevX[i]) / dt;
+                    m_velY[i] = (soa.curY[i] - soa.prevY[i]) / dt;
+                    m_velZ[i] = (soa.curZ[i] - soa.prevZ[i]) / dt;
+                }
+            }
+
+            // Whatever settled on the last budget lands in the final tier.
+            for (AZ::u32 si = 0; si < static_cast<AZ::u32>(m_streamSlots.size()); ++si)
+            {
+                if (settledMark[si] || m_streamSlots[si].resolved) continue;
+                if (SlotSettled(m_streamSlots[si], count))
+                    ++m_tierSettledCounts[m_maxTierCount - 1];
+            }
+
+            fprintf(stderr, "[Workspace] Fused tier settle: %u tiers —", m_maxTierCount);
+            for (AZ::u32 t = 0; t < m_maxTierCount; ++t)
+                fprintf(stderr, " t%u=%u", t, m_tierSettledCounts[t]);
+            fprintf(stderr, "\n");
+            fflush(stderr);
+        }
+    }
+
+    bool Workspace::SlotSettled(const StreamRunSlot& slot, AZ::u32 count) const
+    {
+        if (slot.charCount == 0) return false;
+        for (AZ::u32 c = 0; c < slot.charCount; ++c)
+        {
+            AZ::u32 p = slot.bufferStart + c;
+            if (p >= count) return false;
+            float vMag = fabsf(m_velX[p]) + fabsf(m_velY[p]) + fabsf(m_velZ[p]);
+            if (vMag >= WS_VELOCITY_SETTLE_THRESHOLD) return false;
+        }
+        return true;
     }
 
     bool Workspace::IsSimDone() const
     {
-        return true;   // AZSL settle is synchronous (completes in BeginSimulate)
+        if (m_vkBackend && m_pendingSteps > 0)
+            return m_vkBackend->IsDone();   // fence poll, non-blocking
+        return true;   // host settle is synchronous (completes in BeginSimulate)
     }
 
     void Workspace::FetchSimResults()
     {
-        // AZSL settle completes synchronously in BeginSimulate; nothing async to fetch.
+        // Host settle completes synchronously in BeginSimulate; only a GPU
+        // submit leaves work in flight to wait for and read back.
+        if (m_vkBackend && m_pendingSteps > 0)
+        {
+            m_vkBackend->Fetch(
+                m_posX.data(), m_posY.data(), m_posZ.data(),
+                m_velX.data(), m_velY.data(), m_velZ.data(), m_vkActiveCount);
+            m_pendingSteps = 0;
+            m_vkActiveCount = 0;
+        }
     }
 
     void Workspace::Shutdown()
     {
-        // Host-resident arrays — free the system-heap storage (was GPU resource release).
-        m_pos.clear();   m_pos.shrink_to_fit();
-        m_vel.clear();   m_vel.shrink_to_fit();
+        // Backend dtor waits for any in-flight submit before tearing down.
+        m_vkBackend.reset();
+        m_vkVocabDirtyFrom = 0;
+        m_vkActiveCount = 0;
+
+        // Host-resident planes — free the system-heap storage (was GPU resource release).
+        m_posX.clear(); m_posX.shrink_to_fit();
+        m_posY.clear(); m_posY.shrink_to_fit();
+        m_posZ.clear(); m_posZ.shrink_to_fit();
+        m_posW.clear(); m_posW.shrink_to_fit();
+        m_velX.clear(); m_velX.shrink_to_fit();
+        m_velY.clear(); m_velY.shrink_to_fit();
+        m_velZ.clear(); m_velZ.shrink_to_fit();
         m_phase.clear(); m_phase.shrink_to_fit();
         m_activeParticles = 0;
         m_activeInScene = false;
@@ -593,7 +1045,7 @@ namespace HCPEngine
         AZStd::unordered_set<AZStd::string>& seen,
         const HCPVocabulary* vocab,
         const AZStd::vector<InflectionRule>* rules = nullptr,
-        const std::vector<std::regex>* compiled = nullptr)
+        const std::vector<CompiledCondition>* compiled = nullptr)
     {
         const size_t len = word.size();
         if (len < 3) return;
@@ -613,8 +1065,8 @@ namespace HCPEngine
             const std::string wordStd(word.c_str(), word.size());
             for (size_t ri = 0; ri < rules->size(); ++ri)
             {
-                const InflectionRule& r   = (*rules)[ri];
-                const std::regex&    cond = (*compiled)[ri];
+                const InflectionRule&     r    = (*rules)[ri];
+                const CompiledCondition&  cond = (*compiled)[ri];
                 const std::string&   add  = r.addSuffix.c_str();
                 const bool doubling       = (r.stripSuffix == "__DOUBLING__");
 
@@ -640,8 +1092,8 @@ namespace HCPEngine
                     candidate += r.stripSuffix.c_str();
                 }
 
-                // Check condition regex against candidate base
-                if (!std::regex_search(candidate, cond)) continue;
+                // Check condition against candidate base
+                if (!cond.Matches(candidate)) continue;
 
                 appendBase(AZStd::string(candidate.c_str(), candidate.size()), r.morphBit);
             }
@@ -748,7 +1200,7 @@ namespace HCPEngine
         const AZStd::string& word,
         const HCPVocabulary* vocab = nullptr,
         const AZStd::vector<InflectionRule>* rules = nullptr,
-        const std::vector<std::regex>* compiled = nullptr)
+        const std::vector<CompiledCondition>* compiled = nullptr)
     {
         AZStd::vector<InflectionStripResult> results;
         AZStd::unordered_set<AZStd::string> seen;
@@ -870,15 +1322,21 @@ namespace HCPEngine
         // Open w2t sub-db — populated by EnvelopeManager::ActivateEnvelope.
         // MDB_CREATE ensures the handle is valid even if the envelope hasn't fired yet;
         // RebuildVocab() will produce an empty index until it is populated.
+        // Reader daemons (MDB_RDONLY env) attach without MDB_CREATE — the writer
+        // process created the sub-db when it initialized the shared store.
         {
+            unsigned int envFlags = 0;
+            mdb_env_get_flags(lmdbEnv, &envFlags);
+            const bool readOnly = (envFlags & MDB_RDONLY) != 0;
+
             MDB_txn* txn;
-            int rc = mdb_txn_begin(lmdbEnv, nullptr, 0, &txn);
+            int rc = mdb_txn_begin(lmdbEnv, nullptr, readOnly ? MDB_RDONLY : 0, &txn);
             if (rc != 0)
             {
                 fprintf(stderr, "[BedManager] mdb_txn_begin: %s\n", mdb_strerror(rc));
                 return false;
             }
-            rc = mdb_dbi_open(txn, "w2t", MDB_CREATE, &m_vocabDbi);
+            rc = mdb_dbi_open(txn, "w2t", readOnly ? 0 : MDB_CREATE, &m_vocabDbi);
             if (rc == 0)
                 m_vocabDbiOpen = true;
             else
@@ -886,6 +1344,21 @@ namespace HCPEngine
             mdb_txn_commit(txn);
         }
 
+        // Compiled bed file (HCP_BED_FILE, written by Pack/pack_vocab): when it
+        // maps, cold start becomes an mmap + header walk instead of an LMDB
+        // cursor scan, and per-length slice advances read successive windows of
+        // the mapped blob instead of querying Postgres.
+        if (const char* bedPath = std::getenv("HCP_BED_FILE"))
+        {
+            if (m_bedFile.Map(bedPath))
+                fprintf(stderr, "[BedManager] Compiled bed mapped: %s (%u entries, %u lengths)\n",
+                    bedPath, m_bedFile.EntryCount(), m_bedFile.BucketCount());
+            else
+                fprintf(stderr, "[BedManager] HCP_BED_FILE set but %s did not map; using LMDB\n",
+                    bedPath);
+            fflush(stderr);
+        }
+
         // Build in-memory vocab index from whatever is in w2t right now.
         RebuildVocab();
 
@@ -911,11 +1384,74 @@ namespace HCPEngine
                 ++createdCount;
         }
 
+        // Worker-pool mode: HCP_RESOLVE_WORKERS=N resolves independent word
+        // lengths (5+) on N threads, each with its own dedicated workspace.
+        // Default (unset/1) keeps the sequential ascending-length path.
+        m_resolveWorkers = 1;
+        if (const char* wc = std::getenv("HCP_RESOLVE_WORKERS"))
+        {
+            int requested = atoi(wc);
+            AZ::u32 hw = std::thread::hardware_concurrency();
+            if (hw == 0) hw = 1;
+            if (requested > 1)
+                m_resolveWorkers = AZStd::min(
+                    AZStd::min(static_cast<AZ::u32>(requested), WS_RESOLVE_WORKER_MAX), hw);
+        }
+        if (m_resolveWorkers > 1)
+        {
+            m_workerWorkspaces.resize(m_resolveWorkers);
+
+            // NUMA placement: workers round-robin across nodes. Each worker
+            // workspace is created on a thread pinned to its node, so the
+            // particle planes are FIRST-TOUCHED there and the pages stay
+            // local; the resolve fan-out pins worker w to the same node
+            // before it steps them (HCPNumaTopology.h). Creation is
+            // sequential — only the pin, not parallelism, is the point, and
+            // Workspace::Create may probe the Vulkan backend. The shared
+            // primary/extended pools stay first-touch on the calling thread:
+            // they are driven by the sequential path, and pinning the caller
+            // would leak placement policy out of the bed.
+            const AZ::u32 numaNodes = NumaTopology::Get().NodeCount();
+            m_workerNodes.resize(m_resolveWorkers);
+            for (AZ::u32 w = 0; w < m_resolveWorkers; ++w)
+            {
+                m_workerNodes[w] = w % numaNodes;
+                bool ok = false;
+                if (numaNodes > 1)
+                {
+                    std::thread creator([this, w, maxPhaseGroups, &ok] {
+                        NumaTopology::Get().PinThreadToNode(m_workerNodes[w]);
+                        ok = m_workerWorkspaces[w].Create(WS_BUFFER_CAPACITY, maxPhaseGroups);
+                    });
+                    creator.join();
+                }
+                else
+                {
+                    ok = m_workerWorkspaces[w].Create(WS_BUFFER_CAPACITY, maxPhaseGroups);
+                }
+                if (ok)
+                    ++createdCount;
+            }
+            fprintf(stderr, "[BedManager] Worker-pool resolve: %u workers (%u NUMA nodes)\n",
+                m_resolveWorkers, numaNodes);
+            fflush(stderr);
+        }
+
         auto t1 = std::chrono::high_resolution_clock::now();
         float ms = static_cast<float>(std::chrono::duration<double, std::milli>(t1 - t0).count());
 
         m_initialized = true;
 
+        // Memory-budget accounting: the envelope window is pinned (resolve
+        // cannot run without it — the window logic itself moves it), the pack
+        // cache is the cheap eviction target (rebuilds from entries already
+        // resident). Enforcement fires after pack builds, the growth point.
+        MemoryBudget::Get().Register("envelope_window", RebuildCost::Pinned,
+            [this]() { return EnvelopeWindowBytes(); });
+        MemoryBudget::Get().Register("vocab_pack_cache", RebuildCost::Cheap,
+            [this]() { return VocabPackCacheBytes(); },
+            [this]() { ClearVocabPackCache("memory budget"); });
+
         AZ::u32 totalEntries = 0;
         for (auto& [len, entries] : m_vocabByLength)
             totalEntries += static_cast<AZ::u32>(entries.size());
@@ -960,7 +1496,7 @@ namespace HCPEngine
             endIdx = static_cast<AZ::u32>(remaining.size());
 
         AZStd::vector<AZ::u32> wsIndices(remaining.begin() + offset, remaining.begin() + endIdx);
-        AZ::u32 overflowCount = ws->LoadStreamRuns(runs, wsIndices, wordLength);
+        AZ::u32 overflowCount = ws->LoadStreamRuns(runs, wsIndices, wordLength, &phasePack);
 
         offset = endIdx;
 
@@ -979,19 +1515,60 @@ namespace HCPEngine
         return false;
     }
 
+    // ---- Resolve scratch pools (see the block comment in HCPVocabBed.h) ----
+
+    AZStd::vector<AZ::u32> BedManager::AcquireIndexScratch()
+    {
+        std::lock_guard<std::mutex> lock(m_scratchMutex);
+        if (m_indexScratchPool.empty()) return {};
+        AZStd::vector<AZ::u32> v = AZStd::move(m_indexScratchPool.back());
+        m_indexScratchPool.pop_back();
+        v.clear();
+        return v;
+    }
+
+    void BedManager::ReleaseIndexScratch(AZStd::vector<AZ::u32>&& v)
+    {
+        if (v.capacity() == 0) return;  // nothing worth pooling (moved-from shells)
+        std::lock_guard<std::mutex> lock(m_scratchMutex);
+        if (m_indexScratchPool.size() < SCRATCH_POOL_MAX)
+            m_indexScratchPool.push_back(AZStd::move(v));
+    }
+
+    AZStd::vector<ResolutionResult> BedManager::AcquireResultScratch()
+    {
+        std::lock_guard<std::mutex> lock(m_scratchMutex);
+        if (m_resultScratchPool.empty()) return {};
+        AZStd::vector<ResolutionResult> v = AZStd::move(m_resultScratchPool.back());
+        m_resultScratchPool.pop_back();
+        v.clear();
+        return v;
+    }
+
+    void BedManager::ReleaseResultScratch(AZStd::vector<ResolutionResult>&& v)
+    {
+        if (v.capacity() == 0) return;
+        std::lock_guard<std::mutex> lock(m_scratchMutex);
+        if (m_resultScratchPool.size() < SCRATCH_POOL_MAX)
+            m_resultScratchPool.push_back(AZStd::move(v));
+    }
+
     // Helper: finish simulation, check settlement, collect results, reset workspace.
+    // wsResolved/wsUnresolved are caller-owned scratch (recycled across drains).
     static void DrainWorkspace(
         Workspace* ws,
         const VocabPack& phasePack,
         AZ::u32 phaseIndex,
         AZStd::vector<ResolutionResult>& results,
-        AZStd::vector<AZ::u32>& unresolvedIndices)
+        AZStd::vector<AZ::u32>& unresolvedIndices,
+        AZStd::vector<ResolutionResult>& wsResolved,
+        AZStd::vector<AZ::u32>& wsUnresolved)
     {
         ws->FetchSimResults();
         ws->CheckSettlement(0, phasePack);
 
-        AZStd::vector<ResolutionResult> wsResolved;
-        AZStd::vector<AZ::u32> wsUnresolved;
+        wsResolved.clear();
+        wsUnresolved.clear();
         ws->CollectSplit(wsResolved, wsUnresolved);
 
         for (auto& r : wsResolved)
@@ -1020,11 +1597,19 @@ namespace HCPEngine
         AZStd::vector<Workspace*> workspaces = GetWorkspacesForLength(wordLength);
         if (workspaces.empty()) return;
 
-        AZStd::vector<AZ::u32> remaining = runIndices;
+        // Scratch from the shared pools — recycled across the phase loop and
+        // returned below, so steady-state passes don't allocate.
+        AZStd::vector<AZ::u32> remaining = AcquireIndexScratch();
+        remaining.assign(runIndices.begin(), runIndices.end());
+        AZStd::vector<AZ::u32> nextRemaining = AcquireIndexScratch();
+        AZStd::vector<ResolutionResult> wsResolved = AcquireResultScratch();
+        AZStd::vector<AZ::u32> wsUnresolved = AcquireIndexScratch();
+        AZStd::vector<Workspace*> simulating;
 
         while (!remaining.empty())
         {
-            AZStd::vector<AZ::u32> nextRemaining;
+            nextRemaining.clear();
+            simulating.clear();
             AZ::u32 offset = 0;
 
             // Pipeline: load each workspace, kick off simulate, overlap with next load.
@@ -1032,8 +1617,6 @@ namespace HCPEngine
             // and returns immediately, so we can load the next workspace on CPU
             // while the previous one's GPU work is in flight.
 
-            AZStd::vector<Workspace*> simulating;
-
             for (auto* ws : workspaces)
             {
                 if (offset >= static_cast<AZ::u32>(remaining.size())) break;
@@ -1056,10 +1639,16 @@ namespace HCPEngine
             // Drain all simulating workspaces — fetch results as each finishes.
             // With per-workspace scenes, each fetchResults blocks only on its own scene.
             for (auto* ws : simulating)
-                DrainWorkspace(ws, phasePack, phaseIndex, results, unresolvedIndices);
+                DrainWorkspace(ws, phasePack, phaseIndex, results, unresolvedIndices,
+                               wsResolved, wsUnresolved);
 
-            remaining = AZStd::move(nextRemaining);
+            remaining.swap(nextRemaining);
         }
+
+        ReleaseIndexScratch(AZStd::move(remaining));
+        ReleaseIndexScratch(AZStd::move(nextRemaining));
+        ReleaseResultScratch(AZStd::move(wsResolved));
+        ReleaseIndexScratch(AZStd::move(wsUnresolved));
     }
 
     // ---- ResolveLengthCycle: slice through freq-ordered vocab for one word length ----
@@ -1072,6 +1661,7 @@ namespace HCPEngine
     VocabPack BedManager::BuildVocabSliceFromEntries(
         AZ::u32 wordLength,
         const std::vector<VocabPack::Entry>& entries,
+        const std::vector<AZ::u32>& filteredIndices,
         AZ::u32 startEntry,
         AZ::u32 count) const
     {
@@ -1079,11 +1669,11 @@ namespace HCPEngine
         pack.wordLength = wordLength;
         pack.maxTierCount = 1;
 
-        if (startEntry >= static_cast<AZ::u32>(entries.size())) return pack;
+        if (startEntry >= static_cast<AZ::u32>(filteredIndices.size())) return pack;
 
         AZ::u32 endEntry = startEntry + count;
-        if (endEntry > static_cast<AZ::u32>(entries.size()))
-            endEntry = static_cast<AZ::u32>(entries.size());
+        if (endEntry > static_cast<AZ::u32>(filteredIndices.size()))
+            endEntry = static_cast<AZ::u32>(filteredIndices.size());
 
         AZ::u32 sliceCount = endEntry - startEntry;
         pack.vocabEntryCount = sliceCount;
@@ -1091,15 +1681,29 @@ namespace HCPEngine
 
         pack.positions.resize(pack.totalVocabParticles * 4, 0.0f);
         pack.phases.resize(pack.totalVocabParticles, 0);
-        pack.entries.reserve(sliceCount);
+        pack.hot.reserve(sliceCount);
+        pack.coldTokenIds.reserve(sliceCount);
+        pack.charBlob.reserve(static_cast<size_t>(sliceCount) * wordLength);
         pack.tierLookup.resize(1);
 
         AZ::u32 particleIdx = 0;
         for (AZ::u32 i = startEntry; i < endEntry; ++i)
         {
-            const auto& entry = entries[i];
+            // Read the source entry in place via its filtered index — only the
+            // pieces the pack needs are copied, split hot/cold: scalars and
+            // chars into the fixed-stride arrays the settle path scans, the
+            // token id into the cold array read only on hits.
+            const auto& entry = entries[filteredIndices[i]];
             AZ::u32 entryIdx = i - startEntry;
-            pack.entries.push_back(entry);
+
+            VocabPack::HotEntry he;
+            he.charOffset = static_cast<AZ::u32>(pack.charBlob.size());
+            he.charCount = static_cast<AZ::u32>(entry.word.size());
+            he.tierIndex = entry.tierIndex;
+            he.morphBits = entry.morphBits;
+            pack.hot.push_back(he);
+            pack.charBlob.append(entry.word.c_str(), entry.word.size());
+            pack.coldTokenIds.push_back(entry.tokenId);
             pack.tierLookup[0][entry.word] = entryIdx;
 
             for (AZ::u32 c = 0; c < wordLength; ++c)
@@ -1120,6 +1724,130 @@ namespace HCPEngine
         return pack;
     }
 
+    // ---- AcquireVocabPack: persistent cross-document pack cache ----
+    //
+    // Batch ingest runs the same envelope window over hundreds of documents.
+    // ResetWindowToStart clears the vocab map per document, but the buckets
+    // AdvanceEnvelopeLengthBatch reloads are pure functions of (envelope id,
+    // word length, per-length cursor) — and AdvancePhase's contribution is
+    // pinned by the phase cursor — so a pack built for document N is reusable
+    // verbatim for document N+1 whenever the filter also matches. Rebuilding
+    // packs from scratch was the dominant fixed cost per document.
+    //
+    // The key folds in everything that determines pack contents: envelope id,
+    // word length, both cursors, slice offset + size, and the caller-computed
+    // hash of the filtered index list. The cache is cleared whenever the hot
+    // window moves (RebuildVocab) since bucket contents are then no longer a
+    // function of the cursors alone.
+    //
+    // Worker-pool note: cursors are read without m_envelopeMutex — each worker
+    // owns its word length's cursor, and m_phaseCursor only changes on the
+    // sequential path before fan-out.
+    std::shared_ptr<const VocabPack> BedManager::AcquireVocabPack(
+        AZ::u32 wordLength,
+        const std::vector<VocabPack::Entry>& entries,
+        const std::vector<AZ::u32>& filteredIndices,
+        AZ::u64 filterHash,
+        AZ::u32 startEntry,
+        AZ::u32 count)
+    {
+        int lengthCursor = 0;
+        auto cit = m_lengthCursorByLen.find(wordLength);
+        if (cit != m_lengthCursorByLen.end())
+            lengthCursor = cit->second;
+
+        char key[128];
+        snprintf(key, sizeof(key), "%d:%u:%d:%d:%u:%u:%016llx",
+            m_envelopeId, wordLength, lengthCursor, m_phaseCursor,
+            startEntry, count, static_cast<unsigned long long>(filterHash));
+
+        {
+            std::lock_guard<std::mutex> lock(m_packCacheMutex);
+            auto it = m_packCache.find(key);
+            if (it != m_packCache.end())
+            {
+                it->second.lastUse = ++m_packCacheTick;
+                ++m_packCacheHits;
+                return it->second.pack;
+            }
+            ++m_packCacheMisses;
+        }
+
+        // Build outside the lock — concurrent workers build distinct lengths.
+        auto pack = std::make_shared<const VocabPack>(
+            BuildVocabSliceFromEntries(wordLength, entries, filteredIndices,
+                                       startEntry, count));
+
+        {
+            std::lock_guard<std::mutex> lock(m_packCacheMutex);
+            CachedPack& slot = m_packCache[key];
+            slot.pack = pack;
+            slot.lastUse = ++m_packCacheTick;
+
+            // LRU eviction — linear scan is fine at VP_CACHE_MAX_PACKS entries.
+            while (m_packCache.size() > VP_CACHE_MAX_PACKS)
+            {
+                auto oldest = m_packCache.begin();
+                for (auto it = m_packCache.begin(); it != m_packCache.end(); ++it)
+                    if (it->second.lastUse < oldest->second.lastUse)
+                        oldest = it;
+                m_packCache.erase(oldest);  // in-flight users hold their own ref
+            }
+        }
+
+        // Pack builds are the cache's growth point — settle the budget here,
+        // outside the cache lock. The returned ref keeps this pack alive even
+        // if enforcement clears the cache underneath it.
+        MemoryBudget::Get().Enforce("vocab pack build");
+        return pack;
+    }
+
+    void BedManager::ClearVocabPackCache(const char* reason)
+    {
+        std::lock_guard<std::mutex> lock(m_packCacheMutex);
+        if (m_packCache.empty() && m_packCacheHits == 0 && m_packCacheMisses == 0)
+            return;
+
+        fprintf(stderr, "[BedManager] VocabPack cache cleared (%s): %zu packs, %u hits / %u misses\n",
+            reason, m_packCache.size(), m_packCacheHits, m_packCacheMisses);
+        fflush(stderr);
+
+        m_packCache.clear();
+        m_packCacheHits = 0;
+        m_packCacheMisses = 0;
+    }
+
+    size_t BedManager::EnvelopeWindowBytes() const
+    {
+        // Estimate, not a malloc audit: entry struct plus string payloads for
+        // every bucket in the live window and the batch-0 snapshot.
+        auto bucketBytes = [](const std::unordered_map<AZ::u32, std::vector<VocabPack::Entry>>& buckets)
+        {
+            size_t bytes = 0;
+            for (const auto& [len, entries] : buckets)
+            {
+                bytes += entries.capacity() * sizeof(VocabPack::Entry);
+                for (const auto& e : entries)
+                    bytes += e.word.size() + e.tokenId.size();
+            }
+            return bytes;
+        };
+        return bucketBytes(m_vocabByLength) + bucketBytes(m_firstBatchByLength);
+    }
+
+    size_t BedManager::VocabPackCacheBytes()
+    {
+        std::lock_guard<std::mutex> lock(m_packCacheMutex);
+        size_t bytes = 0;
+        for (const auto& [key, cached] : m_packCache)
+        {
+            bytes += key.size() + sizeof(CachedPack);
+            if (cached.pack)
+                bytes += cached.pack->ApproxBytes();
+        }
+        return bytes;
+    }
+
 
     // ---- BuildRulePack: construct partial-match patterns for one cell length ----
     //
@@ -1218,6 +1946,10 @@ namespace HCPEngine
         pack.positions.resize(pack.totalPatternParticles * 4, 0.0f);
         pack.phases.resize(pack.totalPatternParticles, 0);
         pack.activePositionCount.resize(pack.patternCount, 0);
+        pack.laneCount = (cellLength + 7) / 8;
+        pack.activeMask.resize(pack.patternCount, 0);
+        pack.packedChars.resize(pack.patternCount * pack.laneCount, 0);
+        pack.laneMask.resize(pack.patternCount * pack.laneCount, 0);
         pack.rules = AZStd::move(deduped);
 
         // Build particle positions
@@ -1253,7 +1985,16 @@ namespace HCPEngine
                 pack.positions[base + 2] = z;                        // Z = char identity
                 pack.positions[base + 3] = 0.0f;                    // W = 0 (invMass=0, static)
 
-                if (ch != '\0') ++activeCount;
+                if (ch != '\0')
+                {
+                    ++activeCount;
+                    pack.activeMask[pi] |= AZ::u64(1) << c;
+                    AZ::u32 lane = pi * pack.laneCount + c / 8;
+                    AZ::u32 shift = (c % 8) * 8;
+                    pack.packedChars[lane] |=
+                        static_cast<AZ::u64>(static_cast<unsigned char>(ch)) << shift;
+                    pack.laneMask[lane] |= AZ::u64(0xFF) << shift;
+                }
             }
 
             pack.activePositionCount[pi] = activeCount;
@@ -1263,6 +2004,26 @@ namespace HCPEngine
     }
 
 
+    // Broadphase worker count: HCP_BROADPHASE_WORKERS=N (default: one worker
+    // per bed workspace, capped by core count; 1 forces the serial path).
+    // Read once — same caching idiom as the other tuning env vars.
+    static AZ::u32 BroadphaseWorkerCount()
+    {
+        static AZ::u32 count = [] {
+            AZ::u32 hw = std::thread::hardware_concurrency();
+            if (hw == 0) hw = 1;
+            AZ::u32 c = AZStd::min(WS_PRIMARY_COUNT + WS_EXTENDED_COUNT, hw);
+            if (const char* env = std::getenv("HCP_BROADPHASE_WORKERS"))
+            {
+                int requested = atoi(env);
+                if (requested >= 1)
+                    c = AZStd::min(static_cast<AZ::u32>(requested), hw);
+            }
+            return c;
+        }();
+        return count;
+    }
+
     // ---- RunBroadphaseFilter: GPU partial-match broadphase ----
     //
     // Stage 1 of 3: GPU identifies which suffix/prefix patterns match which words.
@@ -1272,10 +2033,11 @@ namespace HCPEngine
 
     AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>> BedManager::RunBroadphaseFilter(
         const AZStd::vector<CharRun>& runs,
-        const AZStd::vector<AZ::u32>& candidateIndices)
+        const ArenaVector<AZ::u32>& candidateIndices)
     {
         AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>> allMatches;
         if (candidateIndices.empty() || !m_initialized) return allMatches;
+        ScopedStageTimer stageTimer(ResolveStage::Broadphase);
 
         // Group candidates by word length
         AZStd::unordered_map<AZ::u32, AZStd::vector<AZ::u32>> byLength;
@@ -1290,28 +2052,56 @@ namespace HCPEngine
             candidateIndices.size(), byLength.size());
         fflush(stderr);
 
-        // Process each word length: GPU partial-match against rule patterns
+        // Build rule packs up front (serial, cheap) and carve the candidate
+        // lists into fixed-size tasks. The match work is independent per
+        // (run, pattern) pair, so a task only needs a workspace of its own.
+        AZStd::unordered_map<AZ::u32, RulePack> packsByLength;
         for (auto& [len, indices] : byLength)
         {
             RulePack rulePack = BuildRulePack(len);
-            if (rulePack.patternCount == 0) continue;
+            if (rulePack.patternCount > 0)
+                packsByLength.emplace(len, AZStd::move(rulePack));
+        }
 
-            auto workspaces = GetWorkspacesForLength(len);
-            if (workspaces.empty()) continue;
-            Workspace* ws = workspaces[0];
+        struct BroadphaseTask
+        {
+            AZ::u32 len;
+            const AZStd::vector<AZ::u32>* indices;   // full candidate list for len
+            AZ::u32 begin;
+            AZ::u32 end;                             // task covers [begin, end)
+            const RulePack* pack;
+        };
+        AZStd::vector<BroadphaseTask> tasks;
+        for (auto& [len, indices] : byLength)
+        {
+            auto packIt = packsByLength.find(len);
+            if (packIt == packsByLength.end()) continue;
+            const AZ::u32 total = static_cast<AZ::u32>(indices.size());
+            for (AZ::u32 b = 0; b < total; b += WS_BROADPHASE_CHUNK)
+            {
+                AZ::u32 e = b + WS_BROADPHASE_CHUNK;
+                if (e > total) e = total;
+                tasks.push_back({len, &indices, b, e, &packIt->second});
+            }
+        }
+        if (tasks.empty()) return allMatches;
 
-            // Process in batches (may overflow workspace capacity)
-            AZ::u32 cursor = 0;
-            while (cursor < static_cast<AZ::u32>(indices.size()))
+        // Run one task to completion on the given workspace. Identical to the
+        // old serial per-length loop, restricted to the task's index range.
+        auto runTask = [&](Workspace* ws, const BroadphaseTask& task,
+            AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>>& out)
+        {
+            AZ::u32 cursor = task.begin;
+            while (cursor < task.end)
             {
-                ws->LoadRulePack(rulePack);
+                ws->LoadRulePack(*task.pack);
 
-                AZ::u32 remaining = static_cast<AZ::u32>(indices.size()) - cursor;
+                AZ::u32 remaining = task.end - cursor;
                 AZStd::vector<AZ::u32> batchIndices(
-                    indices.begin() + cursor,
-                    indices.begin() + cursor + remaining);
+                    task.indices->begin() + cursor,
+                    task.indices->begin() + cursor + remaining);
 
-                AZ::u32 overflow = ws->LoadStreamRuns(runs, batchIndices, len);
+                AZ::u32 overflow = ws->LoadStreamRuns(runs, batchIndices, task.len);
                 AZ::u32 loaded = remaining - overflow;
 
                 // Simulate — fast pass, small pattern set settles quickly
@@ -1321,7 +2111,7 @@ namespace HCPEngine
 
                 // Check partial settlement — only non-\0 positions
                 AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>> matches;
-                ws->CheckPartialSettlement(rulePack, matches);
+                ws->CheckPartialSettlement(*task.pack, matches);
 
                 ws->DeactivateFromScene();
                 ws->ResetDynamics();
@@ -1330,14 +2120,99 @@ namespace HCPEngine
                 for (const auto& [slotIdx, patternIdx] : matches)
                 {
                     AZ::u32 runIdx = batchIndices[slotIdx];
-                    allMatches.push_back({runIdx, patternIdx});
+                    out.push_back({runIdx, patternIdx});
                 }
 
                 cursor += loaded;
                 if (overflow == 0) break;
             }
+        };
+
+        // Worker pool: the broadphase runs on the sequential stage of Resolve,
+        // so every bed workspace is idle — each worker takes exclusive use of
+        // one for the duration of the pass. Worker-pool resolve workspaces
+        // (m_workerWorkspaces) are left alone; they belong to the length pool.
+        AZStd::vector<Workspace*> idleWorkspaces;
+        for (auto& ws : m_primaryWorkspaces) idleWorkspaces.push_back(&ws);
+        for (auto& ws : m_extendedWorkspaces) idleWorkspaces.push_back(&ws);
+
+        AZ::u32 workerCount = BroadphaseWorkerCount();
+        if (workerCount > static_cast<AZ::u32>(idleWorkspaces.size()))
+            workerCount = static_cast<AZ::u32>(idleWorkspaces.size());
+        if (workerCount > static_cast<AZ::u32>(tasks.size()))
+            workerCount = static_cast<AZ::u32>(tasks.size());
+
+        // Per-task result buckets, concatenated in task order afterwards —
+        // output is deterministic no matter how tasks get stolen around.
+        AZStd::vector<AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>>> taskMatches(tasks.size());
+
+        if (workerCount <= 1)
+        {
+            Workspace* ws = idleWorkspaces.empty() ? nullptr : idleWorkspaces[0];
+            if (!ws) return allMatches;
+            for (size_t t = 0; t < tasks.size(); ++t)
+                runTask(ws, tasks[t], taskMatches[t]);
+        }
+        else
+        {
+            // Work-stealing deques: tasks are dealt round-robin, a worker pops
+            // from the front of its own deque and steals from the back of a
+            // neighbour's when it runs dry. Inflection-heavy lengths produce
+            // long chunk sequences; stealing keeps all cores on them.
+            struct WorkerDeque
+            {
+                std::mutex mutex;
+                std::deque<size_t> tasks;
+            };
+            std::vector<WorkerDeque> deques(workerCount);
+            for (size_t t = 0; t < tasks.size(); ++t)
+                deques[t % workerCount].tasks.push_back(t);
+
+            auto workerMain = [&](AZ::u32 self)
+            {
+                Workspace* ws = idleWorkspaces[self];
+                for (;;)
+                {
+                    size_t taskId = SIZE_MAX;
+                    {
+                        std::lock_guard<std::mutex> lock(deques[self].mutex);
+                        if (!deques[self].tasks.empty())
+                        {
+                            taskId = deques[self].tasks.front();
+                            deques[self].tasks.pop_front();
+                        }
+                    }
+                    if (taskId == SIZE_MAX)
+                    {
+                        // Steal from the back of another worker's deque.
+                        for (AZ::u32 v = 1; v < workerCount && taskId == SIZE_MAX; ++v)
+                        {
+                            AZ::u32 victim = (self + v) % workerCount;
+                            std::lock_guard<std::mutex> lock(deques[victim].mutex);
+                            if (!deques[victim].tasks.empty())
+                            {
+                                taskId = deques[victim].tasks.back();
+                                deques[victim].tasks.pop_back();
+                            }
+                        }
+                    }
+                    if (taskId == SIZE_MAX) return;   // everything drained
+                    runTask(ws, tasks[taskId], taskMatches[taskId]);
+                }
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(workerCount);
+            for (AZ::u32 w = 0; w < workerCount; ++w)
+                threads.emplace_back(workerMain, w);
+            for (auto& th : threads)
+                th.join();
         }
 
+        for (auto& bucket : taskMatches)
+            for (auto& m : bucket)
+                allMatches.push_back(m);
+
         fprintf(stderr, "[BedManager] Broadphase filter: %zu pattern matches\n", allMatches.size());
         fflush(stderr);
 
@@ -1445,18 +2320,24 @@ namespace HCPEngine
         };
 
         // Process each GPU match: generate first-level candidate, then recurse.
+        // Expansion is independent per match (the dedup set is per-match), so
+        // the match list splits into contiguous ranges across the broadphase
+        // worker count and merges in range order — same output as a serial walk.
         AZ::u32 level1Count = 0;
         AZ::u32 recursiveCount = 0;
 
-        for (const auto& [runIdx, patternIdx] : gpuMatches)
+        auto expandMatch = [&](const AZStd::pair<AZ::u32, AZ::u32>& match,
+            AZStd::vector<StripCandidate>& out, AZ::u32& l1, AZ::u32& rec)
         {
+            const AZ::u32 runIdx = match.first;
+            const AZ::u32 patternIdx = match.second;
             const AZStd::string& text = runs[runIdx].text;
             AZ::u32 len = static_cast<AZ::u32>(text.size());
 
             auto packIt = rulePacksByLength.find(len);
-            if (packIt == rulePacksByLength.end()) continue;
+            if (packIt == rulePacksByLength.end()) return;
             const RulePack& pack = packIt->second;
-            if (patternIdx >= pack.rules.size()) continue;
+            if (patternIdx >= pack.rules.size()) return;
 
             const RulePackEntry& rule = pack.rules[patternIdx];
 
@@ -1493,9 +2374,9 @@ namespace HCPEngine
                 cand.baseWord = text.substr(rule.patternLen);
             }
 
-            if (cand.baseWord.empty()) continue;
-            candidates.push_back(cand);
-            ++level1Count;
+            if (cand.baseWord.empty()) return;
+            out.push_back(cand);
+            ++l1;
 
             // ---- Recursive expansion: strip the base further ----
             // Feed each new base back through all ~50 patterns.
@@ -1536,13 +2417,56 @@ namespace HCPEngine
                     rc.morpheme = fr.morpheme;  // Deepest morpheme name (for logging)
                     rc.morphBits = stackedBits; // Accumulated through chain
                     rc.isContraction = false;
-                    candidates.push_back(rc);
-                    ++recursiveCount;
+                    out.push_back(rc);
+                    ++rec;
 
                     // Queue for further stripping
                     queue.push_back({deeper, stackedBits});
                 }
             }
+        };
+
+        // ~64 matches per worker before a thread pays for itself — small
+        // match sets stay serial.
+        AZ::u32 workerCount = AZStd::min(BroadphaseWorkerCount(),
+            static_cast<AZ::u32>((gpuMatches.size() + 63) / 64));
+        if (workerCount <= 1)
+        {
+            for (const auto& match : gpuMatches)
+                expandMatch(match, candidates, level1Count, recursiveCount);
+        }
+        else
+        {
+            struct RangeOutput
+            {
+                AZStd::vector<StripCandidate> out;
+                AZ::u32 l1 = 0;
+                AZ::u32 rec = 0;
+            };
+            std::vector<RangeOutput> ranges(workerCount);
+            const size_t perWorker = (gpuMatches.size() + workerCount - 1) / workerCount;
+
+            std::vector<std::thread> threads;
+            threads.reserve(workerCount);
+            for (AZ::u32 w = 0; w < workerCount; ++w)
+            {
+                threads.emplace_back([&, w] {
+                    const size_t begin = w * perWorker;
+                    const size_t end = AZStd::min(begin + perWorker, gpuMatches.size());
+                    for (size_t i = begin; i < end; ++i)
+                        expandMatch(gpuMatches[i], ranges[w].out, ranges[w].l1, ranges[w].rec);
+                });
+            }
+            for (auto& th : threads)
+                th.join();
+
+            for (auto& r : ranges)
+            {
+                for (auto& c : r.out)
+                    candidates.push_back(AZStd::move(c));
+                level1Count += r.l1;
+                recursiveCount += r.rec;
+            }
         }
 
         fprintf(stderr, "[BedManager] GenerateStripCandidates: %u level-1 + %u recursive = %zu total candidates\n",
@@ -1553,6 +2477,168 @@ namespace HCPEngine
     }
 
 
+    // ---- CompiledCondition: compile + match ----
+
+    CompiledCondition CompiledCondition::Compile(const AZStd::string& pattern)
+    {
+        CompiledCondition cond;
+        if (pattern.empty()) return cond;   // Kind::Always
+
+        const size_t len = pattern.size();
+        size_t pos = 0;
+        bool anchoredStart = false;
+        bool anchoredEnd = false;
+
+        if (pattern[0] == '^') { anchoredStart = true; pos = 1; }
+
+        size_t end = len;
+        if (end > pos && pattern[end - 1] == '$') { anchoredEnd = true; --end; }
+
+        // Parse a run of literals and character classes. Anything the fast
+        // path doesn't model drops the whole pattern to the regex fallback.
+        bool simple = true;
+        while (pos < end && simple)
+        {
+            Elem elem;
+            char c = pattern[pos];
+
+            if (c == '[')
+            {
+                ++pos;
+                if (pos < end && pattern[pos] == '^') { elem.negate = true; ++pos; }
+                bool closed = false;
+                while (pos < end)
+                {
+                    char cc = pattern[pos];
+                    if (cc == ']') { closed = true; ++pos; break; }
+                    if (cc == '\\' && pos + 1 < end)
+                    {
+                        char escaped = pattern[pos + 1];
+                        // Escape classes (\d, \w, \s) are regex machinery.
+                        if (isalnum(static_cast<unsigned char>(escaped)))
+                        { simple = false; break; }
+                        elem.chars.set(static_cast<unsigned char>(escaped));
+                        pos += 2;
+                        continue;
+                    }
+                    // Range: a-z (a trailing '-' is a literal)
+                    if (pos + 2 < end && pattern[pos + 1] == '-' && pattern[pos + 2] != ']')
+                    {
+                        unsigned char lo = static_cast<unsigned char>(cc);
+                        unsigned char hi = static_cast<unsigned char>(pattern[pos + 2]);
+                        if (lo > hi) { simple = false; break; }
+                        for (unsigned int b = lo; b <= hi; ++b) elem.chars.set(b);
+                        pos += 3;
+                        continue;
+                    }
+                    elem.chars.set(static_cast<unsigned char>(cc));
+                    ++pos;
+                }
+                if (!closed) simple = false;
+            }
+            else if (c == '.')
+            {
+                elem.chars.set();   // matches any byte
+                ++pos;
+            }
+            else if (c == '\\' && pos + 1 < end)
+            {
+                char escaped = pattern[pos + 1];
+                if (isalnum(static_cast<unsigned char>(escaped)))
+                { simple = false; break; }
+                elem.chars.set(static_cast<unsigned char>(escaped));
+                pos += 2;
+            }
+            else if (c == '*' || c == '+' || c == '?' || c == '(' || c == ')' ||
+                     c == '|' || c == '{' || c == '}' || c == '$' || c == '^')
+            {
+                simple = false;
+            }
+            else
+            {
+                elem.chars.set(static_cast<unsigned char>(c));
+                ++pos;
+            }
+
+            if (simple) cond.elems.push_back(AZStd::move(elem));
+
+            // A quantifier after the element also means regex machinery.
+            if (simple && pos < end &&
+                (pattern[pos] == '*' || pattern[pos] == '+' || pattern[pos] == '?' ||
+                 pattern[pos] == '{'))
+                simple = false;
+        }
+
+        if (!simple)
+        {
+            cond.kind = Kind::Regex;
+            cond.elems.clear();
+            cond.fallback = std::regex(pattern.c_str(),
+                std::regex::ECMAScript | std::regex::optimize);
+            return cond;
+        }
+
+        if (cond.elems.empty())
+            cond.kind = Kind::Always;   // bare anchors match everything
+        else if (anchoredStart && anchoredEnd)
+            cond.kind = Kind::Exact;
+        else if (anchoredEnd)
+            cond.kind = Kind::Suffix;
+        else if (anchoredStart)
+            cond.kind = Kind::Prefix;
+        else
+            cond.kind = Kind::Substring;
+        return cond;
+    }
+
+    bool CompiledCondition::Matches(const std::string& s) const
+    {
+        const size_t n = elems.size();
+        switch (kind)
+        {
+        case Kind::Always:
+            return true;
+
+        case Kind::Exact:
+            if (s.size() != n) return false;
+            for (size_t i = 0; i < n; ++i)
+                if (!elems[i].Hits(s[i])) return false;
+            return true;
+
+        case Kind::Suffix:
+        {
+            if (s.size() < n) return false;
+            const size_t off = s.size() - n;
+            for (size_t i = 0; i < n; ++i)
+                if (!elems[i].Hits(s[off + i])) return false;
+            return true;
+        }
+
+        case Kind::Prefix:
+            if (s.size() < n) return false;
+            for (size_t i = 0; i < n; ++i)
+                if (!elems[i].Hits(s[i])) return false;
+            return true;
+
+        case Kind::Substring:
+        {
+            if (s.size() < n) return false;
+            for (size_t off = 0; off + n <= s.size(); ++off)
+            {
+                bool hit = true;
+                for (size_t i = 0; i < n; ++i)
+                    if (!elems[i].Hits(s[off + i])) { hit = false; break; }
+                if (hit) return true;
+            }
+            return false;
+        }
+
+        case Kind::Regex:
+        default:
+            return std::regex_search(s, fallback);
+        }
+    }
+
     // ---- SetInflectionRules: split by rule_type, compile conditions ----
     void BedManager::SetInflectionRules(AZStd::vector<InflectionRule> rules)
     {
@@ -1560,25 +2646,32 @@ namespace HCPEngine
         m_compiledConditions.clear();
         m_prefixRules.clear();
         m_compiledPrefixConditions.clear();
+        m_stripCache.clear();   // cached bases are stale when the rules change
+        m_stripCacheHits = 0;
+        m_stripCacheMisses = 0;
 
+        size_t regexFallbacks = 0;
         for (auto& r : rules)
         {
+            CompiledCondition cond = CompiledCondition::Compile(r.condition);
+            if (cond.kind == CompiledCondition::Kind::Regex)
+                ++regexFallbacks;
+
             if (r.ruleType == "PREFIX")
             {
-                m_compiledPrefixConditions.emplace_back(r.condition.c_str(),
-                    std::regex::ECMAScript | std::regex::optimize);
+                m_compiledPrefixConditions.push_back(AZStd::move(cond));
                 m_prefixRules.push_back(AZStd::move(r));
             }
             else
             {
-                m_compiledConditions.emplace_back(r.condition.c_str(),
-                    std::regex::ECMAScript | std::regex::optimize);
+                m_compiledConditions.push_back(AZStd::move(cond));
                 m_inflectionRules.push_back(AZStd::move(r));
             }
         }
 
-        fprintf(stderr, "[BedManager] SetInflectionRules: %zu suffix, %zu prefix rules\n",
-            m_inflectionRules.size(), m_prefixRules.size());
+        fprintf(stderr, "[BedManager] SetInflectionRules: %zu suffix, %zu prefix rules "
+            "(%zu regex-fallback conditions)\n",
+            m_inflectionRules.size(), m_prefixRules.size(), regexFallbacks);
         fflush(stderr);
     }
 
@@ -1594,7 +2687,7 @@ namespace HCPEngine
     //
     // Returns empty vector if no prefix matches or no base resolves.
     // Prefix class (PFX_NEG, PFX_ITER, etc.) is stored as morpheme string in
-    // the result — goes into morphemePositions map, not a MorphBit (no bit reserved).
+    // the result — carried as a morpheme string in the result, not a MorphBit (no bit reserved).
     // -----------------------------------------------------------------------
     struct PrefixStripResult
     {
@@ -1610,7 +2703,7 @@ namespace HCPEngine
         const AZStd::string& word,
         const HCPVocabulary* vocab,
         const AZStd::vector<InflectionRule>* rules,
-        const std::vector<std::regex>* compiled)
+        const std::vector<CompiledCondition>* compiled)
     {
         AZStd::vector<PrefixStripResult> results;
         if (!rules || !compiled || rules->empty()) return results;
@@ -1627,8 +2720,8 @@ namespace HCPEngine
 
             std::string base = wordStd.substr(pfx.size());
 
-            // Condition regex applied against the base
-            if (!std::regex_search(base, (*compiled)[ri])) continue;
+            // Condition applied against the base
+            if (!(*compiled)[ri].Matches(base)) continue;
 
             // Base must exist in LMDB — vocab is the filter
             AZStd::string tokenId = vocab->LookupWordLocal(
@@ -1648,9 +2741,20 @@ namespace HCPEngine
 
     void BedManager::InitEnvelopeWindow(int envelopeId, int warmSetSize)
     {
+        // Envelope id is part of the pack cache key, so stale entries can't be
+        // served — but a corpus change means they'll never hit; free the memory.
+        // Slice feedback is per corpus too — a new envelope's match depths tell
+        // us nothing about the old one's.
+        if (envelopeId != m_envelopeId)
+        {
+            ClearVocabPackCache("envelope change");
+            m_entriesPerMatch.clear();
+        }
+
         m_envelopeId  = envelopeId;
         m_sliceCursor = 0;
         m_warmSetSize = warmSetSize;
+        m_advancePrimed = false;   // any lane transition in flight targets the old cursor
         fprintf(stderr, "[BedManager] Envelope window init: id=%d warm=%d slice=%d\n",
             envelopeId, warmSetSize, LMDB_SLICE_SIZE);
         fflush(stderr);
@@ -1663,6 +2767,17 @@ namespace HCPEngine
         // AdvanceEnvelopeLengthBatch) populates vocab on demand during resolution.
         m_lengthCursorByLen.clear();
         m_phaseCursor = 0;
+        m_vocabMirrorsHotWindow = false;   // vocab diverges from the hot window below
+
+        // Batch mode: reinstall the batch-0 bucket snapshot instead of clearing.
+        // The next document restarts from the same highest-priority entries
+        // without re-querying Postgres, and the VocabPack cache keys (cursor 0)
+        // line up so its packs hit immediately.
+        if (m_batchActive && !m_firstBatchByLength.empty())
+        {
+            m_vocabByLength = m_firstBatchByLength;
+            return;
+        }
         m_vocabByLength.clear();
     }
 
@@ -1685,6 +2800,7 @@ namespace HCPEngine
         m_phaseCursor += batchSize;
 
         // Distribute entries into m_vocabByLength by word length (APPEND — accumulates)
+        m_vocabMirrorsHotWindow = false;   // warm-set rows, not hot-window contents
         AZStd::unordered_set<AZ::u32> newLengths;
         for (const auto& e : batch)
         {
@@ -1805,22 +2921,99 @@ namespace HCPEngine
         }
     }
 
+    // ---- Adaptive slice sizing (see the block comment in HCPVocabBed.h) ----
+
+    int BedManager::SliceBudget(AZ::u32 wordLength) const
+    {
+        static const bool adaptive = [] {
+            const char* v = std::getenv("HCP_ADAPTIVE_SLICE");
+            return !(v && v[0] == '0');
+        }();
+        if (!adaptive) return LMDB_SLICE_SIZE;
+
+        auto runIt = m_runCountByLength.find(wordLength);
+        if (runIt == m_runCountByLength.end() || runIt->second == 0)
+            return LMDB_SLICE_SIZE;   // length not in this document's histogram
+
+        // Frequency-ordered vocab: common documents match well inside the
+        // first few dozen entries per run. Refined per envelope as documents
+        // complete (RecordSliceFeedback).
+        float perMatch = 64.0f;
+        auto fbIt = m_entriesPerMatch.find(wordLength);
+        if (fbIt != m_entriesPerMatch.end())
+            perMatch = fbIt->second;
+
+        float budget = static_cast<float>(runIt->second) * perMatch;
+        if (budget < static_cast<float>(MIN_SLICE_SIZE)) return MIN_SLICE_SIZE;
+        if (budget > static_cast<float>(LMDB_SLICE_SIZE)) return LMDB_SLICE_SIZE;
+        return static_cast<int>(budget);
+    }
+
+    void BedManager::RecordSliceFeedback(AZ::u32 wordLength, AZ::u32 matchedRuns)
+    {
+        std::lock_guard<std::mutex> envelopeLock(m_envelopeMutex);
+
+        // Total entries this length consumed: batches already advanced past,
+        // plus the bucket still resident.
+        AZ::u64 loaded = static_cast<AZ::u64>(m_lengthCursorByLen[wordLength]);
+        auto it = m_vocabByLength.find(wordLength);
+        if (it != m_vocabByLength.end())
+            loaded += it->second.size();
+        if (loaded == 0) return;
+
+        // matchedRuns == 0 pushes the estimate up (hard lengths need deeper
+        // scans); the clamp in SliceBudget bounds the drift either way.
+        float perMatch = static_cast<float>(loaded) /
+                         static_cast<float>(matchedRuns > 0 ? matchedRuns : 1);
+        auto fbIt = m_entriesPerMatch.find(wordLength);
+        if (fbIt == m_entriesPerMatch.end())
+            m_entriesPerMatch[wordLength] = perMatch;
+        else
+            fbIt->second = fbIt->second * 0.7f + perMatch * 0.3f;
+    }
+
     bool BedManager::AdvanceEnvelopeLengthBatch(AZ::u32 wordLength)
     {
+        // Compiled-bed path: the mapped bucket IS the frequency-ordered warm
+        // set for this length, so advancing the window is pointer arithmetic
+        // over mapped pages instead of a Postgres round-trip.
+        if (m_bedFile.IsMapped())
+        {
+            std::lock_guard<std::mutex> envelopeLock(m_envelopeMutex);
+            int& cursor = m_lengthCursorByLen[wordLength];
+            if (cursor > 0 || !m_vocabByLength[wordLength].empty())
+                cursor += LMDB_SLICE_SIZE;
+            AZ::u32 loaded = LoadBedFileWindow(wordLength, cursor, LMDB_SLICE_SIZE);
+            if (loaded == 0) return false;   // bucket exhausted for this length
+
+            fprintf(stderr, "[BedManager] Length %u bed-file advance: offset=%d, %u entries mapped\n",
+                wordLength, cursor, loaded);
+            fflush(stderr);
+            return true;
+        }
+
         if (!m_envelopeManager || m_envelopeId == 0) return false;
 
+        // Worker-pool mode: serializes the warm-set query and the write into
+        // m_vocabByLength. Each worker owns a distinct wordLength, but the
+        // Postgres connection and the map buckets are shared.
+        std::lock_guard<std::mutex> envelopeLock(m_envelopeMutex);
+
         int& cursor = m_lengthCursorByLen[wordLength];
         // On first call for this length, cursor is 0 — start from beginning.
         // On subsequent calls, advance past the batch we just processed.
+        // Budgets vary per document, so the advance is the RESIDENT bucket's
+        // size, not a fixed stride — offsets stay continuous either way.
         if (cursor > 0 || !m_vocabByLength[wordLength].empty())
-            cursor += LMDB_SLICE_SIZE;
+            cursor += static_cast<int>(m_vocabByLength[wordLength].size());
 
         auto batch = m_envelopeManager->QueryWarmBatch(
-            m_envelopeId, static_cast<int>(wordLength), cursor, LMDB_SLICE_SIZE);
+            m_envelopeId, static_cast<int>(wordLength), cursor, SliceBudget(wordLength));
 
         if (batch.empty()) return false;  // exhausted for this length
 
         // Replace (not append) the in-memory vocab for this length.
+        m_vocabMirrorsHotWindow = false;   // warm-set batch, not hot-window contents
         auto& vec = m_vocabByLength[wordLength];
         vec.clear();
         vec.reserve(batch.size());
@@ -1852,14 +3045,112 @@ namespace HCPEngine
         int nextFeedStart = m_sliceCursor + LMDB_SLICE_SIZE * 3;
         if (nextFeedStart >= m_warmSetSize) return false;  // window at end of warm set
 
+        // Fast path: the feeder lane already ran this transition — LMDB is
+        // evicted and fed, both row sets are staged — so the index refresh is
+        // an in-memory splice instead of two Postgres round trips plus a full
+        // hot-window rescan.
+        if (m_advancePrimed)
+        {
+            SliceAdvance adv;
+            const bool taken = m_envelopeManager->TakeSliceAdvance(
+                m_envelopeId, m_primedFeedStart, adv);
+            const int primedFeedStart = m_primedFeedStart;
+            m_advancePrimed = false;
+
+            if (taken && primedFeedStart == nextFeedStart)
+            {
+                m_sliceCursor += LMDB_SLICE_SIZE;
+                if (m_vocabMirrorsHotWindow)
+                    SpliceVocabForAdvance(adv);
+                else
+                    RebuildVocab();   // index rebuilt from elsewhere since priming
+                PrimeNextSliceAdvance();
+                return true;
+            }
+            // Stale priming (cursor moved under it): redo synchronously below —
+            // the evict and feed are idempotent against whatever the lane did.
+        }
+
         m_envelopeManager->EvictSlice(m_envelopeId, m_sliceCursor, LMDB_SLICE_SIZE);
         m_envelopeManager->FeedSlice(m_envelopeId, nextFeedStart, LMDB_SLICE_SIZE);
         m_sliceCursor += LMDB_SLICE_SIZE;
 
         RebuildVocab();
+        PrimeNextSliceAdvance();
         return true;
     }
 
+    void BedManager::PrimeNextSliceAdvance()
+    {
+        m_advancePrimed = false;
+        if (!m_envelopeManager || m_envelopeId == 0 || m_warmSetSize == 0) return;
+        if (m_bedFile.IsMapped()) return;   // compiled bed: no LMDB window to feed
+        if (!HCPEnvelopeManager::PrefetchEnabled()) return;
+
+        int feedStart = m_sliceCursor + LMDB_SLICE_SIZE * 3;
+        if (feedStart >= m_warmSetSize) return;
+
+        m_envelopeManager->AdvanceSliceAsync(
+            m_envelopeId, m_sliceCursor, feedStart, LMDB_SLICE_SIZE);
+        m_advancePrimed   = true;
+        m_primedFeedStart = feedStart;
+    }
+
+    void BedManager::SpliceVocabForAdvance(const SliceAdvance& adv)
+    {
+        // The hot window moved — cached packs no longer correspond to the
+        // cursor values in their keys.
+        ClearVocabPackCache("hot window moved");
+
+        // Drop the outgoing slot's words. w2t keys are unique, so one
+        // compaction pass per touched length bucket is exact.
+        AZStd::unordered_map<AZ::u32, AZStd::unordered_set<AZStd::string>> evictedByLen;
+        for (const AZStd::string& word : adv.evictedWords)
+            evictedByLen[static_cast<AZ::u32>(word.size())].insert(word);
+
+        for (const auto& [len, words] : evictedByLen)
+        {
+            auto it = m_vocabByLength.find(len);
+            if (it == m_vocabByLength.end()) continue;
+            auto& vec = it->second;
+            vec.erase(std::remove_if(vec.begin(), vec.end(),
+                [&words](const VocabPack::Entry& e) { return words.count(e.word) != 0; }),
+                vec.end());
+            if (vec.empty())
+                m_vocabByLength.erase(it);
+        }
+
+        // Append the incoming slot's entries — same length gate as the rescan.
+        for (const VocabEntry& src : adv.entries)
+        {
+            AZ::u32 len = static_cast<AZ::u32>(src.word.size());
+            if (len < static_cast<AZ::u32>(VBED_MIN_LEN) ||
+                len > static_cast<AZ::u32>(VBED_MAX_LEN)) continue;
+
+            VocabPack::Entry e;
+            e.word      = src.word;
+            e.tokenId   = src.tokenId;
+            e.tierIndex = 0;
+            e.morphBits = MorphemeNameToBit(src.morpheme.c_str());
+            m_vocabByLength[len].push_back(AZStd::move(e));
+        }
+
+        // Refresh the derived length tables to the shape RebuildVocab leaves.
+        m_activeWordLengths.clear();
+        for (auto& [len, entries] : m_vocabByLength)
+        {
+            m_activeWordLengths.push_back(len);
+            if (!m_labelCountByLength.count(len))
+                m_labelCountByLength[len] = 0;
+        }
+        AZStd::sort(m_activeWordLengths.begin(), m_activeWordLengths.end(),
+            [](AZ::u32 a, AZ::u32 b) { return a < b; });
+
+        fprintf(stderr, "[BedManager] Slice splice: -%zu evicted, +%zu fed, %zu active lengths\n",
+            adv.evictedWords.size(), adv.entries.size(), m_activeWordLengths.size());
+        fflush(stderr);
+    }
+
     // ---- RebuildVocab: scan w2t and build in-memory vocab index ----
     //
     // Reads whatever entries are currently in the LMDB hot window (w2t).
@@ -1867,10 +3158,23 @@ namespace HCPEngine
     // t2w is maintained by EnvelopeManager::FeedSlice — not rebuilt here.
     void BedManager::RebuildVocab()
     {
+        // The hot window moved — cached packs no longer correspond to the
+        // cursor values in their keys.
+        ClearVocabPackCache("hot window moved");
+
+        m_vocabMirrorsHotWindow = false;
         m_vocabByLength.clear();
         m_activeWordLengths.clear();
         m_labelCountByLength.clear();
 
+        // Compiled-bed path: the mapped file is the authoritative bed — rebuild
+        // every bucket from mapped pages, no LMDB traffic at all.
+        if (m_bedFile.IsMapped())
+        {
+            RebuildVocabFromBedFile();
+            return;
+        }
+
         if (!m_vocabDbiOpen || !m_lmdbEnv) return;
 
         MDB_txn* txn = nullptr;
@@ -1938,23 +3242,82 @@ namespace HCPEngine
         AZStd::sort(m_activeWordLengths.begin(), m_activeWordLengths.end(),
             [](AZ::u32 a, AZ::u32 b) { return a < b; });
 
+        // The index now mirrors w2t exactly — feeder-lane splices may track
+        // the window from here until some other writer touches the index.
+        m_vocabMirrorsHotWindow = true;
+
         fprintf(stderr, "[BedManager] RebuildVocab: %u entries across %zu word lengths\n",
             totalEntries, m_activeWordLengths.size());
         fflush(stderr);
     }
 
-    // ---- ReadFilteredVocabSlice: read from in-memory vocab index ----
+    AZ::u32 BedManager::LoadBedFileWindow(AZ::u32 wordLength, int offset, int count)
+    {
+        HCP::Pack::BedFileView::BucketView bv = m_bedFile.BucketForLength(wordLength);
+        if (bv.count == 0 || offset < 0 || static_cast<AZ::u32>(offset) >= bv.count)
+            return 0;
+
+        AZ::u32 end = static_cast<AZ::u32>(offset) + static_cast<AZ::u32>(count);
+        if (end > bv.count) end = bv.count;
+
+        // Fixed-stride reads straight off the mapped pages: slot -> pointer is
+        // one multiply, and there is nothing to parse — morph bits were
+        // compiled to their numeric form by pack_vocab.
+        m_vocabMirrorsHotWindow = false;   // bed-file pages, not hot-window contents
+        auto& vec = m_vocabByLength[wordLength];
+        vec.clear();
+        vec.reserve(end - static_cast<AZ::u32>(offset));
+        for (AZ::u32 s = static_cast<AZ::u32>(offset); s < end; ++s)
+        {
+            VocabPack::Entry e;
+            e.word = AZStd::string(bv.Word(s), wordLength);
+            const char* id = bv.TokenId(s);
+            e.tokenId = AZStd::string(id, strnlen(id, HCP::Pack::BED_TOKEN_ID_WIDTH));
+            e.tierIndex = 0;
+            e.morphBits = bv.Morph(s);
+            vec.push_back(AZStd::move(e));
+        }
+        return end - static_cast<AZ::u32>(offset);
+    }
+
+    void BedManager::RebuildVocabFromBedFile()
+    {
+        AZ::u32 totalEntries = 0;
+        for (AZ::u32 bi = 0; bi < m_bedFile.BucketCount(); ++bi)
+        {
+            HCP::Pack::BedFileView::BucketView bv = m_bedFile.Bucket(bi);
+            if (bv.count == 0) continue;
+
+            // First window per length — same bound the w2t hot window imposes;
+            // AdvanceEnvelopeLengthBatch slides it further along the bucket.
+            totalEntries += LoadBedFileWindow(bv.length, 0, LMDB_SLICE_SIZE);
+            m_activeWordLengths.push_back(bv.length);
+            m_labelCountByLength[bv.length] = bv.labelCount;
+        }
+        AZStd::sort(m_activeWordLengths.begin(), m_activeWordLengths.end(),
+            [](AZ::u32 a, AZ::u32 b) { return a < b; });
+
+        fprintf(stderr, "[BedManager] RebuildVocab (bed file): %u entries across %zu word lengths\n",
+            totalEntries, m_activeWordLengths.size());
+        fflush(stderr);
+    }
+
+    // ---- ReadFilteredVocabIndices: filter the in-memory vocab index in place ----
     //
-    // Returns entries [startEntry, endEntry) for the given word length whose
-    // first char is in neededChars. Reads from m_vocabByLength — no LMDB I/O
-    // at resolve time. The returned vector is on system heap (no AZ pool pressure).
-    std::vector<VocabPack::Entry> BedManager::ReadFilteredVocabSlice(
+    // Returns the indices of entries [startEntry, endEntry) for the given word
+    // length whose first char is in neededChars. Reads from m_vocabByLength — no
+    // LMDB I/O at resolve time, and no Entry copies: the old slice materialized a
+    // filtered std::vector<Entry>, paying two string allocations per surviving
+    // entry (word + tokenId); the pack builder now dereferences these indices
+    // into the source vector instead. The returned vector is on system heap
+    // (no AZ pool pressure).
+    std::vector<AZ::u32> BedManager::ReadFilteredVocabIndices(
         AZ::u32 wordLength,
         const AZStd::unordered_set<char>& neededChars,
         AZ::u32 startEntry,
         AZ::u32 endEntry) const
     {
-        std::vector<VocabPack::Entry> filtered;
+        std::vector<AZ::u32> filtered;
 
         auto it = m_vocabByLength.find(wordLength);
         if (it == m_vocabByLength.end())
@@ -1971,7 +3334,7 @@ namespace HCPEngine
         {
             const auto& e = allEntries[i];
             if (!e.word.empty() && (neededChars.empty() || neededChars.count(e.word[0])))
-                filtered.push_back(e);
+                filtered.push_back(i);
         }
 
         return filtered;
@@ -1998,18 +3361,21 @@ namespace HCPEngine
     //   - Initial item: vocabStart=0, runIndices=all input runs
     //   - On drain: unresolved runs → new item at vocabStart += phaseSize
     //   - On dispatch: leftover (overflow) → re-inserted at queue head (same phase)
-    // VocabPack cache:  built once per vocabStart, never rebuilt.
-    //   Pre-built during dispatch (after BeginSimulate, before FetchSimResults).
+    // VocabPack cache:  acquired once per vocabStart from the persistent
+    //   cross-document cache (AcquireVocabPack), never rebuilt within a cascade.
+    //   Pre-acquired during dispatch (after BeginSimulate, before FetchSimResults).
 
     void BedManager::RunPipelinedCascade(
         AZ::u32 wordLength,
         const AZStd::vector<CharRun>& runs,
-        const std::vector<VocabPack::Entry>& filteredVocab,
+        const std::vector<VocabPack::Entry>& vocabEntries,
+        const std::vector<AZ::u32>& filteredIndices,
         AZStd::vector<AZ::u32>& currentIndices,
         AZStd::vector<ResolutionResult>& results,
-        AZ::u32& phaseIndex)
+        AZ::u32& phaseIndex,
+        const AZStd::vector<Workspace*>* workspaceOverride)
     {
-        AZ::u32 totalFiltered = static_cast<AZ::u32>(filteredVocab.size());
+        AZ::u32 totalFiltered = static_cast<AZ::u32>(filteredIndices.size());
         if (totalFiltered == 0 || currentIndices.empty()) return;
 
         // ---- Dynamic phase sizing ----
@@ -2031,13 +3397,15 @@ namespace HCPEngine
             wordLength, currentIndices.size(), phaseSize, totalFiltered);
         fflush(stderr);
 
-        AZStd::vector<Workspace*> workspaces = GetWorkspacesForLength(wordLength);
+        AZStd::vector<Workspace*> workspaces = workspaceOverride
+            ? *workspaceOverride
+            : GetWorkspacesForLength(wordLength);
         if (workspaces.empty()) return;
 
         // --- Work item: a batch of runs to resolve against a specific vocab slice ---
         struct WorkItem
         {
-            AZ::u32 vocabStart;               // start offset into filteredVocab
+            AZ::u32 vocabStart;               // start offset into filteredIndices
             AZ::u32 absPhaseIdx;              // for ResolutionResult::tierResolved
             AZStd::vector<AZ::u32> runIndices;
         };
@@ -2056,20 +3424,35 @@ namespace HCPEngine
         for (auto* ws : workspaces)
             slots.push_back({ws, false, 0, 0});
 
-        // --- VocabPack cache: built once per vocabStart, reused across workspaces ---
-        // Key: vocabStart (= phase * phaseSize)
-        // Pointers into this map remain stable across emplace (unordered_map guarantee).
-        AZStd::unordered_map<AZ::u32, VocabPack> packCache;
+        // --- Filter identity for the persistent pack cache ---
+        // FNV-1a over the filtered index list (plus bucket size) pins WHICH
+        // entries a pack contains; the cursors inside AcquireVocabPack's key
+        // pin what those indices refer to.
+        AZ::u64 filterHash = 1469598103934665603ull;
+        auto foldHash = [&filterHash](AZ::u64 v)
+        {
+            filterHash = (filterHash ^ v) * 1099511628211ull;
+        };
+        foldHash(vocabEntries.size());
+        for (AZ::u32 fi : filteredIndices)
+            foldHash(fi);
+
+        // --- Per-cascade pack view: one ref per vocabStart ---
+        // Packs come from the persistent cross-document cache (AcquireVocabPack);
+        // holding shared_ptrs here keeps them valid even if another worker's
+        // insert evicts them from the cache mid-cascade.
+        AZStd::unordered_map<AZ::u32, std::shared_ptr<const VocabPack>> packRefs;
         auto getOrBuildPack = [&](AZ::u32 start) -> const VocabPack*
         {
-            auto it = packCache.find(start);
-            if (it == packCache.end())
-            {
-                auto ins = packCache.emplace(start,
-                    BuildVocabSliceFromEntries(wordLength, filteredVocab, start, phaseSize));
-                return &ins.first->second;
-            }
-            return &it->second;
+            auto it = packRefs.find(start);
+            if (it != packRefs.end())
+                return it->second.get();
+
+            auto pack = AcquireVocabPack(wordLength, vocabEntries, filteredIndices,
+                                         filterHash, start, phaseSize);
+            const VocabPack* raw = pack.get();
+            packRefs.emplace(start, AZStd::move(pack));
+            return raw;
         };
 
         // --- Work queue ---
@@ -2095,12 +3478,12 @@ namespace HCPEngine
                 if (!slot.simulating) continue;
                 if (!slot.ws->IsSimDone()) continue;
 
-                const VocabPack& pack = packCache.at(slot.vocabStart);
+                const VocabPack& pack = *packRefs.at(slot.vocabStart);
                 slot.ws->FetchSimResults();
                 slot.ws->CheckSettlement(0, pack);
 
-                AZStd::vector<ResolutionResult> wsResolved;
-                AZStd::vector<AZ::u32> wsUnresolved;
+                AZStd::vector<ResolutionResult> wsResolved = AcquireResultScratch();
+                AZStd::vector<AZ::u32> wsUnresolved = AcquireIndexScratch();
                 slot.ws->CollectSplit(wsResolved, wsUnresolved);
 
                 for (auto& r : wsResolved)
@@ -2108,6 +3491,7 @@ namespace HCPEngine
                     r.tierResolved = slot.absPhaseIdx;
                     results.push_back(AZStd::move(r));
                 }
+                ReleaseResultScratch(AZStd::move(wsResolved));
 
                 if (!wsUnresolved.empty())
                 {
@@ -2116,6 +3500,8 @@ namespace HCPEngine
                     {
                         AZ::u32 nextPhaseIdx = slot.absPhaseIdx + 1;
                         if (nextPhaseIdx > maxAbsPhase) maxAbsPhase = nextPhaseIdx;
+                        // Capacity travels with the item and comes back to the
+                        // pool when the item is consumed below.
                         workQueue.push_back({nextStart, nextPhaseIdx, AZStd::move(wsUnresolved)});
                     }
                     else
@@ -2123,8 +3509,13 @@ namespace HCPEngine
                         // Vocab exhausted — permanently unresolved
                         for (AZ::u32 idx : wsUnresolved)
                             currentIndices.push_back(idx);
+                        ReleaseIndexScratch(AZStd::move(wsUnresolved));
                     }
                 }
+                else
+                {
+                    ReleaseIndexScratch(AZStd::move(wsUnresolved));
+                }
 
                 slot.ws->ResetDynamics();
                 slot.ws->DeactivateFromScene();
@@ -2143,19 +3534,23 @@ namespace HCPEngine
                 const VocabPack* pack = getOrBuildPack(item.vocabStart);
                 if (pack->vocabEntryCount == 0) { ++queueHead; continue; }
 
-                AZStd::vector<AZ::u32> overflow;
+                AZStd::vector<AZ::u32> overflow = AcquireIndexScratch();
                 AZ::u32 offset = 0;
                 bool hasRuns = LoadWorkspaceBatch(slot.ws, wordLength, runs,
                                                   item.runIndices, offset, *pack, overflow);
 
                 // Collect runs this workspace couldn't fit
-                AZStd::vector<AZ::u32> leftover;
+                AZStd::vector<AZ::u32> leftover = AcquireIndexScratch();
                 for (AZ::u32 j = offset; j < static_cast<AZ::u32>(item.runIndices.size()); ++j)
                     leftover.push_back(item.runIndices[j]);
                 leftover.insert(leftover.end(), overflow.begin(), overflow.end());
+                ReleaseIndexScratch(AZStd::move(overflow));
 
                 AZ::u32 savedVocabStart = item.vocabStart;
                 AZ::u32 savedPhaseIdx   = item.absPhaseIdx;
+                // Item fully consumed — recycle its index buffer before the
+                // insert below can invalidate the reference.
+                ReleaseIndexScratch(AZStd::move(item.runIndices));
                 ++queueHead;  // consume this item
 
                 if (!leftover.empty())
@@ -2174,11 +3569,11 @@ namespace HCPEngine
                     slot.absPhaseIdx = savedPhaseIdx;
                     slot.vocabStart  = savedVocabStart;
 
-                    // === KEY OPTIMIZATION: pre-build next phase pack while GPU runs ===
-                    // BuildVocabSliceFromEntries is pure CPU/memory work. By building it
-                    // here — after BeginSimulate, before the next FetchSimResults — the
-                    // build time is hidden behind GPU simulation rather than adding to
-                    // the critical path between phases.
+                    // === KEY OPTIMIZATION: pre-acquire next phase pack while GPU runs ===
+                    // AcquireVocabPack is pure CPU/memory work (a cache probe, or a
+                    // pack build on miss). By doing it here — after BeginSimulate,
+                    // before the next FetchSimResults — the cost is hidden behind
+                    // GPU simulation rather than adding to the path between phases.
                     AZ::u32 nextStart = savedVocabStart + phaseSize;
                     if (nextStart < totalFiltered)
                         getOrBuildPack(nextStart);
@@ -2201,9 +3596,11 @@ namespace HCPEngine
         AZStd::vector<CharRun>& runs,
         const AZStd::vector<AZ::u32>& runIndices,
         AZStd::vector<ResolutionResult>& results,
-        AZStd::vector<AZ::u32>& unresolvedIndices)
+        AZStd::vector<AZ::u32>& unresolvedIndices,
+        const AZStd::vector<Workspace*>* workspaceOverride)
     {
         if (runIndices.empty()) return;
+        ScopedStageTimer stageTimer(ResolveStage::LengthCycle);
 
         // If no vocab loaded for this length, try fetching the first batch from Postgres.
         // This is the normal path when LMDB is not pre-populated — the resolution loop
@@ -2307,6 +3704,8 @@ namespace HCPEngine
         for (AZ::u32 idx : capRuns)   commonRuns.push_back(idx);
         for (AZ::u32 idx : plainRuns) commonRuns.push_back(idx);
 
+        AZ::u32 commonInitial = static_cast<AZ::u32>(commonRuns.size());
+
         while (!commonRuns.empty())
         {
             auto curVocabIt = m_vocabByLength.find(wordLength);
@@ -2320,23 +3719,159 @@ namespace HCPEngine
                     commonChars.insert(runs[idx].text[0]);
 
             // Start from 0 — Labels already handled by direct lookup above,
-            // common vocab pass processes ALL entries including any remaining Labels
-            auto filteredCommon = ReadFilteredVocabSlice(wordLength, commonChars, 0, curTotal);
+            // common vocab pass processes ALL entries including any remaining Labels.
+            // The index list references curVocabIt->second, which is stable until
+            // AdvanceEnvelopeLengthBatch below replaces this length's bucket.
+            auto filteredCommon = ReadFilteredVocabIndices(wordLength, commonChars, 0, curTotal);
             fprintf(stderr, "[BedManager] Length %u common pass (cursor=%d): %zu runs, %u vocab → %zu filtered\n",
                 wordLength, m_sliceCursor, commonRuns.size(), curTotal, filteredCommon.size());
             fflush(stderr);
 
             if (!filteredCommon.empty())
-                RunPipelinedCascade(wordLength, runs, filteredCommon, commonRuns, results, phaseIndex);
+                RunPipelinedCascade(wordLength, runs, curVocabIt->second, filteredCommon,
+                                    commonRuns, results, phaseIndex, workspaceOverride);
 
             if (commonRuns.empty()) break;                              // all runs resolved
             if (!AdvanceEnvelopeLengthBatch(wordLength)) break;        // exhausted for this length
         }
 
+        RecordSliceFeedback(wordLength,
+            commonInitial - static_cast<AZ::u32>(commonRuns.size()));
+
         for (AZ::u32 idx : commonRuns)
             unresolvedIndices.push_back(idx);
     }
 
+    // ---- CollectNeededBuckets: derive (p3, length) needs from run text ----
+    //
+    // p3 first char = letter (A=a..Z=z), second char = 'A'+length. Only pairs
+    // that exist in the text are generated — no cross product. Hyphen runs
+    // contribute the run itself AND derived compound/component buckets so the
+    // hyphen split finds everything pre-loaded (no LMDB writes during the
+    // resolution loop — avoids read/write deadlock). Shared by Resolve's
+    // targeted load and ResolveBatch's union load.
+    void BedManager::CollectNeededBuckets(
+        const AZStd::vector<CharRun>& runs,
+        AZStd::unordered_set<AZStd::string>& p3Seen,
+        AZStd::vector<AZStd::string>& neededP3,
+        AZStd::unordered_set<int>& lengthSet) const
+    {
+        auto addP3 = [&](char firstChar, int wordLen) {
+            char fc = firstChar;
+            if (fc >= 'A' && fc <= 'Z') fc = static_cast<char>(fc + 32);
+            if (fc < 'a' || fc > 'z') return;
+            char p3[3] = { static_cast<char>('A' + (fc - 'a')),
+                           static_cast<char>('A' + wordLen), '\0' };
+            AZStd::string p3Str(p3);
+            if (!p3Seen.count(p3Str)) { p3Seen.insert(p3Str); neededP3.push_back(p3Str); }
+        };
+
+        for (const CharRun& run : runs)
+        {
+            if (run.tag != RunTag::Word || run.text.empty()) continue;
+
+            lengthSet.insert(static_cast<int>(run.text.size()));
+            addP3(run.text[0], static_cast<int>(run.text.size()));
+
+            if (run.text.find('-') == AZStd::string::npos) continue;
+
+            // Split on hyphen → compound and components
+            AZStd::vector<AZStd::string> parts;
+            AZStd::string cur;
+            for (size_t ci = 0; ci < run.text.size(); ++ci)
+            {
+                if (run.text[ci] == '-')
+                { if (!cur.empty()) parts.push_back(cur); cur.clear(); }
+                else cur += run.text[ci];
+            }
+            if (!cur.empty()) parts.push_back(cur);
+            if (parts.size() >= 2)
+            {
+                // Compound form (no hyphens)
+                AZStd::string compound;
+                for (const auto& p : parts) compound += p;
+                if (!compound.empty())
+                    addP3(compound[0], static_cast<int>(compound.size()));
+                // Each component
+                for (const auto& p : parts)
+                    if (!p.empty()) addP3(p[0], static_cast<int>(p.size()));
+            }
+        }
+    }
+
+    // ---- ResolveBatch: back-to-back documents without per-document fixed costs ----
+    //
+    // Nightly corpus runs are thousands of small documents; the per-document
+    // constants — targeted Postgres bucket load, LMDB rebuild, cold VocabPacks —
+    // dominate total time, not resolution itself. Batch mode:
+    //
+    //   1. One union bucket load + RebuildVocab for the whole batch up front.
+    //   2. A snapshot of the resulting batch-0 buckets; ResetWindowToStart
+    //      reinstalls it per document (a memcpy-class copy) instead of clearing
+    //      and re-querying Postgres.
+    //   3. The persistent VocabPack cache then hits across documents, so the
+    //      workspace pipeline goes straight from document N's last phase into
+    //      document N+1's first without draining into DB work.
+    //
+    // Documents see the UNION of the batch's buckets rather than exactly their
+    // own subset — a superset is resolution-equivalent (the first-char filter
+    // trims it per document), it just makes phases marginally fuller.
+    AZStd::vector<ResolutionManifest> BedManager::ResolveBatch(
+        const AZStd::vector<AZStd::vector<CharRun>>& documents)
+    {
+        AZStd::vector<ResolutionManifest> manifests;
+        manifests.reserve(documents.size());
+        if (documents.empty())
+            return manifests;
+
+        if (!m_initialized || !m_envelopeManager)
+        {
+            // Degenerate setups: plain per-document path handles both.
+            for (const auto& doc : documents)
+                manifests.push_back(Resolve(doc));
+            return manifests;
+        }
+
+        auto tb0 = std::chrono::high_resolution_clock::now();
+
+        // ---- Union bucket load: one Postgres→LMDB round for the whole batch ----
+        AZStd::unordered_set<AZStd::string> p3Seen;
+        AZStd::vector<AZStd::string> neededP3;
+        AZStd::unordered_set<int> lengths;
+        for (const auto& doc : documents)
+            CollectNeededBuckets(doc, p3Seen, neededP3, lengths);
+        AZStd::vector<int> neededLengths(lengths.begin(), lengths.end());
+
+        if (!neededP3.empty() && !neededLengths.empty())
+        {
+            m_envelopeManager->LoadBucketsToLmdb(neededP3, neededLengths);
+            RebuildVocab();
+        }
+
+        // Snapshot the batch-0 buckets for per-document reinstall.
+        m_firstBatchByLength = m_vocabByLength;
+        m_batchActive = true;
+
+        fprintf(stderr, "[BedManager] ResolveBatch: %zu documents, %zu p3 buckets, %zu lengths\n",
+            documents.size(), neededP3.size(), neededLengths.size());
+        fflush(stderr);
+
+        for (const auto& doc : documents)
+            manifests.push_back(Resolve(doc));
+
+        m_batchActive = false;
+        m_firstBatchByLength.clear();
+
+        auto tb1 = std::chrono::high_resolution_clock::now();
+        fprintf(stderr, "[BedManager] ResolveBatch done: %zu documents in %lld ms\n",
+            documents.size(),
+            static_cast<long long>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(tb1 - tb0).count()));
+        fflush(stderr);
+
+        return manifests;
+    }
+
     ResolutionManifest BedManager::Resolve(const AZStd::vector<CharRun>& inputRuns)
     {
         ResolutionManifest manifest;
@@ -2348,11 +3883,18 @@ namespace HCPEngine
             return manifest;
         }
 
+        ScopedStageTimer stageTimer(ResolveStage::ResolveTotal);
+
         // Reset the LMDB hot window to offset 0 for each new document.
         // Each document needs the highest-priority vocab entries first.
         // Without this reset, the cursor would remain wherever the last document left it.
         ResetWindowToStart();
 
+        // Reclaim the previous document's scratch in one step. Equivalent to a
+        // reset at the end of the last Resolve, but done here so nothing built
+        // below can dangle past the return.
+        m_resolveArena.Reset();
+
         // Mutable copy — synthetic base runs get appended during interstitial stripping.
         // Original runs at [0..inputRuns.size()), synthetics at [inputRuns.size()..N).
         AZStd::vector<CharRun> runs = inputRuns;
@@ -2363,6 +3905,15 @@ namespace HCPEngine
         // ---- Transform layer: pre-resolve tagged runs ----
         AZ::u32 preResolved = 0;
 
+        // Single-char texts repeat heavily ("a", "I", punctuation), so memoize
+        // the LMDB probes per distinct text — the transform-layer counterpart
+        // of the duplicate stacking the Word path does below. Misses memoize
+        // too (as empty), so a text absent from w2t and c2t pays its three-way
+        // probe once per document, not once per occurrence.
+        AZStd::unordered_map<AZStd::string, AZStd::string> singleCharMemo;
+        AZStd::string newlineTokenId;
+        bool newlineLookedUp = false;
+
         for (AZ::u32 i = 0; i < originalRunCount; ++i)
         {
             const CharRun& run = runs[i];
@@ -2373,28 +3924,37 @@ namespace HCPEngine
                 AZStd::string tokenId = run.preAssignedTokenId;
                 if (tokenId.empty() && m_vocabulary)
                 {
-                    tokenId = m_vocabulary->LookupWordLocal(run.text);
-                    if (tokenId.empty() && !run.text.empty())
+                    auto memoIt = singleCharMemo.find(run.text);
+                    if (memoIt != singleCharMemo.end())
                     {
-                        // "I" is stored uppercase in LMDB — always try capitalised form
-                        // for any single-char that fails the lowercase lookup.
-                        AZStd::string cap = run.text;
-                        cap[0] = static_cast<char>(toupper(static_cast<unsigned char>(cap[0])));
-                        tokenId = m_vocabulary->LookupWordLocal(cap);
+                        tokenId = memoIt->second;
                     }
-                    // Fallback: decode UTF-8 codepoint and query c2t sub-db.
-                    // Punctuation is stored in c2t (char→token), not w2t (word→token).
-                    if (tokenId.empty() && !run.text.empty())
+                    else
                     {
-                        const unsigned char b0 = static_cast<unsigned char>(run.text[0]);
-                        AZ::u32 cp = b0;
-                        if (b0 >= 0xE0 && run.text.size() >= 3)
-                            cp = ((b0 & 0x0F) << 12)
-                               | ((static_cast<unsigned char>(run.text[1]) & 0x3F) << 6)
-                               | (static_cast<unsigned char>(run.text[2]) & 0x3F);
-                        else if (b0 >= 0xC0 && run.text.size() >= 2)
-                            cp = ((b0 & 0x1F) << 6) | (static_cast<unsigned char>(run.text[1]) & 0x3F);
-                        tokenId = m_vocabulary->LookupCodepoint(cp);
+                        tokenId = m_vocabulary->LookupWordLocal(run.text);
+                        if (tokenId.empty() && !run.text.empty())
+                        {
+                            // "I" is stored uppercase in LMDB — always try capitalised form
+                            // for any single-char that fails the lowercase lookup.
+                            AZStd::string cap = run.text;
+                            cap[0] = static_cast<char>(toupper(static_cast<unsigned char>(cap[0])));
+                            tokenId = m_vocabulary->LookupWordLocal(cap);
+                        }
+                        // Fallback: decode UTF-8 codepoint and query c2t sub-db.
+                        // Punctuation is stored in c2t (char→token), not w2t (word→token).
+                        if (tokenId.empty() && !run.text.empty())
+                        {
+                            const unsigned char b0 = static_cast<unsigned char>(run.text[0]);
+                            AZ::u32 cp = b0;
+                            if (b0 >= 0xE0 && run.text.size() >= 3)
+                                cp = ((b0 & 0x0F) << 12)
+                                   | ((static_cast<unsigned char>(run.text[1]) & 0x3F) << 6)
+                                   | (static_cast<unsigned char>(run.text[2]) & 0x3F);
+                            else if (b0 >= 0xC0 && run.text.size() >= 2)
+                                cp = ((b0 & 0x1F) << 6) | (static_cast<unsigned char>(run.text[1]) & 0x3F);
+                            tokenId = m_vocabulary->LookupCodepoint(cp);
+                        }
+                        singleCharMemo.emplace(run.text, tokenId);
                     }
                 }
                 ResolutionResult r;
@@ -2423,8 +3983,14 @@ namespace HCPEngine
             }
             else if (run.tag == RunTag::Newline)
             {
-                // Paragraph break — resolve to newline char token
-                AZStd::string tokenId = m_vocabulary ? m_vocabulary->LookupChar('\n') : "";
+                // Paragraph break — resolve to newline char token (looked up
+                // once; every Newline run maps to the same token).
+                if (!newlineLookedUp)
+                {
+                    newlineTokenId = m_vocabulary ? m_vocabulary->LookupChar('\n') : "";
+                    newlineLookedUp = true;
+                }
+                const AZStd::string& tokenId = newlineTokenId;
                 if (!tokenId.empty())
                 {
                     ResolutionResult r;
@@ -2447,13 +4013,20 @@ namespace HCPEngine
         }
 
         // ---- Classify Word runs + duplicate stacking ----
+        // Each distinct text settles ONCE; later occurrences stack behind the
+        // first and take its result in the fan-out pass at the bottom of this
+        // function. The text key IS the (text, caps-profile) key: CharRun.text
+        // preserves original case, so two runs with equal text carry identical
+        // firstCap/allCaps, and nothing in resolution reads any other cap
+        // state. "the" 4000 times in a novel is one stream particle span, not
+        // 4000.
         AZStd::unordered_map<AZStd::string, AZ::u32> uniqueRunMap;
         AZStd::unordered_map<AZ::u32, AZStd::vector<AZ::u32>> runStacks;
 
         AZStd::unordered_map<AZ::u32, AZStd::vector<AZ::u32>> runsByLength;
-        AZStd::vector<AZ::u32> apostropheRuns;
-        AZStd::vector<AZ::u32> hyphenRuns;
-        AZStd::vector<AZ::u32> noVocabRuns;
+        auto apostropheRuns = m_resolveArena.MakeVector<AZ::u32>();
+        auto hyphenRuns     = m_resolveArena.MakeVector<AZ::u32>();
+        auto noVocabRuns    = m_resolveArena.MakeVector<AZ::u32>();
 
         // Classification is driven by the TEXT, not pre-loaded vocab.
         // All word runs go into runsByLength by their own length.
@@ -2506,119 +4079,50 @@ namespace HCPEngine
             uniqueWordRuns, totalDuplicates);
         fflush(stderr);
 
+        // Record this document's length histogram — SliceBudget scales every
+        // per-length warm batch by it. Strip bases injected mid-resolve land
+        // on lengths that may be absent here; those fall back to full slices.
+        m_runCountByLength.clear();
+        for (const auto& [len, lenRuns] : runsByLength)
+            m_runCountByLength[len] = static_cast<AZ::u32>(lenRuns.size());
+
         // ---- Targeted bucket load: shard → LMDB ----
         // After Phase 1 classification, we know exactly which p3 buckets (first letter
         // × word length) the text needs. Tell the EnvelopeManager to query Postgres
         // for JUST those buckets and write them to LMDB. This replaces the monolithic
         // warm-set assembly — Postgres loads only what the text requires.
-        if (m_envelopeManager)
+        if (m_envelopeManager && !m_batchActive)
         {
-            // Collect needed p3 values (first letter encoding) and lengths from classified runs
-            AZStd::unordered_set<char> firstLetters;
-            AZStd::unordered_set<int> lengths;
-            for (const auto& [len, indices] : runsByLength)
-            {
-                lengths.insert(static_cast<int>(len));
-                for (AZ::u32 idx : indices)
-                {
-                    if (!runs[idx].text.empty())
-                        firstLetters.insert(runs[idx].text[0]);
-                }
-            }
-            // Include apostrophe and hyphen run lengths/letters too
-            for (AZ::u32 idx : apostropheRuns)
-            {
-                if (!runs[idx].text.empty())
-                {
-                    firstLetters.insert(runs[idx].text[0]);
-                    lengths.insert(static_cast<int>(runs[idx].text.size()));
-                }
-            }
-            for (AZ::u32 idx : hyphenRuns)
+            // Kick first-batch warm prefetches for every length the text needs
+            // that has no vocab resident yet. The lane runs the offset-0 warm
+            // query while the foreground does the targeted LMDB load below, so
+            // ResolveLengthCycle's first AdvanceEnvelopeLengthBatch per length
+            // finds its rows staged instead of eating the Postgres round trip
+            // mid-resolve. Later batches are already overlapped: QueryWarmBatch
+            // queues the next one the moment a batch returns.
+            if (m_envelopeId != 0 && !m_bedFile.IsMapped())
             {
-                if (!runs[idx].text.empty())
+                std::lock_guard<std::mutex> envelopeLock(m_envelopeMutex);
+                for (const auto& [len, lenRuns] : runsByLength)
                 {
-                    firstLetters.insert(runs[idx].text[0]);
-                    lengths.insert(static_cast<int>(runs[idx].text.size()));
+                    if (m_lengthCursorByLen[len] > 0) continue;   // past the first batch
+                    auto vocabIt = m_vocabByLength.find(len);
+                    if (vocabIt != m_vocabByLength.end() && !vocabIt->second.empty())
+                        continue;                                  // first batch resident
+                    m_envelopeManager->PrefetchWarmBatchAsync(
+                        m_envelopeId, static_cast<int>(len), 0, SliceBudget(len));
                 }
             }
 
-            // Build exact p3 values from actual (letter, length) pairs in runs.
-            // p3 first char = letter (A=a..Z=z), second char = 'A'+length.
-            // Only generate p3 for pairs that exist in the text — no cross product.
+            // Collect needed p3 values (first letter × length) and lengths from
+            // the run text. CollectNeededBuckets is shared with ResolveBatch's
+            // union load, which hoists this whole stage out of the per-document
+            // path — batch mode skips it here entirely.
+            AZStd::unordered_set<AZStd::string> p3Seen;
             AZStd::vector<AZStd::string> neededP3;
+            AZStd::unordered_set<int> lengths;
+            CollectNeededBuckets(runs, p3Seen, neededP3, lengths);
             AZStd::vector<int> neededLengths(lengths.begin(), lengths.end());
-            AZStd::unordered_set<AZStd::string> p3Seen;
-            for (const auto& [len, indices] : runsByLength)
-            {
-                for (AZ::u32 idx : indices)
-                {
-                    if (runs[idx].text.empty()) continue;
-                    char fc = runs[idx].text[0];
-                    if (fc >= 'A' && fc <= 'Z') fc = static_cast<char>(fc + 32);
-                    if (fc < 'a' || fc > 'z') continue;
-                    char p3[3] = { static_cast<char>('A' + (fc - 'a')),
-                                   static_cast<char>('A' + len), '\0' };
-                    AZStd::string p3Str(p3);
-                    if (!p3Seen.count(p3Str))
-                    {
-                        p3Seen.insert(p3Str);
-                        neededP3.push_back(p3Str);
-                    }
-                }
-            }
-            // Also include apostrophe/hyphen run buckets
-            for (AZ::u32 idx : apostropheRuns)
-            {
-                if (runs[idx].text.empty()) continue;
-                char fc = runs[idx].text[0];
-                if (fc >= 'A' && fc <= 'Z') fc = static_cast<char>(fc + 32);
-                if (fc < 'a' || fc > 'z') continue;
-                char p3[3] = { static_cast<char>('A' + (fc - 'a')),
-                               static_cast<char>('A' + static_cast<int>(runs[idx].text.size())), '\0' };
-                AZStd::string p3Str(p3);
-                if (!p3Seen.count(p3Str)) { p3Seen.insert(p3Str); neededP3.push_back(p3Str); }
-            }
-            // Hyphen runs: include the run itself AND derived compound/component buckets.
-            // This pre-loads everything the hyphen split will need so no LMDB writes
-            // happen during the resolution loop (avoiding read/write deadlock).
-            auto addP3 = [&](char firstChar, int wordLen) {
-                char fc = firstChar;
-                if (fc >= 'A' && fc <= 'Z') fc = static_cast<char>(fc + 32);
-                if (fc < 'a' || fc > 'z') return;
-                char p3[3] = { static_cast<char>('A' + (fc - 'a')),
-                               static_cast<char>('A' + wordLen), '\0' };
-                AZStd::string p3Str(p3);
-                if (!p3Seen.count(p3Str)) { p3Seen.insert(p3Str); neededP3.push_back(p3Str); }
-            };
-            for (AZ::u32 idx : hyphenRuns)
-            {
-                const CharRun& hrun = runs[idx];
-                if (hrun.text.empty()) continue;
-                // The hyphenated form itself
-                addP3(hrun.text[0], static_cast<int>(hrun.text.size()));
-                // Split on hyphen → compound and components
-                AZStd::vector<AZStd::string> parts;
-                AZStd::string cur;
-                for (size_t ci = 0; ci < hrun.text.size(); ++ci)
-                {
-                    if (hrun.text[ci] == '-')
-                    { if (!cur.empty()) parts.push_back(cur); cur.clear(); }
-                    else cur += hrun.text[ci];
-                }
-                if (!cur.empty()) parts.push_back(cur);
-                if (parts.size() >= 2)
-                {
-                    // Compound form (no hyphens)
-                    AZStd::string compound;
-                    for (const auto& p : parts) compound += p;
-                    if (!compound.empty())
-                        addP3(compound[0], static_cast<int>(compound.size()));
-                    // Each component
-                    for (const auto& p : parts)
-                        if (!p.empty()) addP3(p[0], static_cast<int>(p.size()));
-                }
-            }
 
             if (!neededP3.empty() && !neededLengths.empty())
             {
@@ -2637,7 +4141,7 @@ namespace HCPEngine
         // ---- Apostrophe runs: vocabulary LMDB lookup ----
         // Words arrive with original case preserved. Try as-is first.
         // "John's" matches directly. No cap reconstruction needed.
-        AZStd::vector<AZ::u32> unresolvedApostrophe;
+        auto unresolvedApostrophe = m_resolveArena.MakeVector<AZ::u32>();
         for (AZ::u32 idx : apostropheRuns)
         {
             const CharRun& arun = runs[idx];
@@ -2661,7 +4165,7 @@ namespace HCPEngine
         }
 
         // ---- Hyphen runs: vocabulary LMDB lookup ----
-        AZStd::vector<AZ::u32> unresolvedHyphen;
+        auto unresolvedHyphen = m_resolveArena.MakeVector<AZ::u32>();
         for (AZ::u32 idx : hyphenRuns)
         {
             const CharRun& hrun = runs[idx];
@@ -2766,7 +4270,7 @@ namespace HCPEngine
             // before any LMDB reads started.
 
             // Phase 3: Lookups — LMDB now has the needed entries
-            AZStd::vector<AZ::u32> stillUnresolvedHyphen;
+            auto stillUnresolvedHyphen = m_resolveArena.MakeVector<AZ::u32>();
             AZ::u32 hyphenVariants = 0;
             AZ::u32 hyphenDecomposed = 0;
 
@@ -2862,23 +4366,50 @@ namespace HCPEngine
         fflush(stderr);
         if (!m_inflectionRules.empty() || !m_prefixRules.empty())
         {
-            // Collect broadphase candidates: all word runs + unresolved apostrophe runs
-            AZStd::vector<AZ::u32> broadphaseCandidates;
+            // Collect broadphase candidates: all word runs + unresolved apostrophe runs.
+            // Strip-cache partition: a form seen in an earlier document replays
+            // its cached candidates (or its cached "no match") and skips the
+            // GPU pass — only novel forms reach the broadphase. Steady-state
+            // corpus ingest resolves almost entirely from the cache.
+            auto broadphaseCandidates = m_resolveArena.MakeVector<AZ::u32>();
+            AZ::u32 cacheHits = 0;
+
+            auto takeCandidate = [&](AZ::u32 idx)
+            {
+                auto it = m_stripCache.find(runs[idx].text);
+                if (it == m_stripCache.end())
+                {
+                    broadphaseCandidates.push_back(idx);
+                    return;
+                }
+                ++cacheHits;
+                for (const StripCandidate& cached : it->second)
+                {
+                    StripCandidate cand = cached;
+                    cand.sourceRunIndex = idx;
+                    stripCandidates.push_back(AZStd::move(cand));
+                }
+            };
 
             // Plain word runs that could have suffix/prefix morphemes
             for (const auto& [len, indices] : runsByLength)
             {
                 for (AZ::u32 idx : indices)
-                    broadphaseCandidates.push_back(idx);
+                    takeCandidate(idx);
             }
 
             // Unresolved apostrophe runs (contraction candidates)
             for (AZ::u32 idx : unresolvedApostrophe)
-                broadphaseCandidates.push_back(idx);
+                takeCandidate(idx);
 
-            fprintf(stderr, "[BedManager] Broadphase candidates: %zu word + %zu apostrophe = %zu total\n",
-                broadphaseCandidates.size() - unresolvedApostrophe.size(),
-                unresolvedApostrophe.size(), broadphaseCandidates.size());
+            m_stripCacheHits += cacheHits;
+            m_stripCacheMisses += broadphaseCandidates.size();
+
+            fprintf(stderr, "[BedManager] Broadphase candidates: %zu novel, %u strip-cache hits "
+                "(cache: %zu forms, %llu/%llu lifetime hits)\n",
+                broadphaseCandidates.size(), cacheHits, m_stripCache.size(),
+                static_cast<unsigned long long>(m_stripCacheHits),
+                static_cast<unsigned long long>(m_stripCacheHits + m_stripCacheMisses));
             fflush(stderr);
 
             if (!broadphaseCandidates.empty())
@@ -2896,50 +4427,63 @@ namespace HCPEngine
                 }
 
                 // Stage 2: CPU mechanical expansion — generate ALL possible bases
-                stripCandidates = GenerateStripCandidates(runs, gpuMatches, rulePacksByLength);
-
-                // Stage 3 setup: inject ALL base words into runsByLength for ascending PBD
-                for (const auto& cand : stripCandidates)
-                {
-                    if (cand.baseWord.empty()) continue;
-
-                    // Create synthetic CharRun for the base word
-                    CharRun baseCr;
-                    baseCr.text = cand.baseWord;
-                    baseCr.startPos = 0;
-                    baseCr.length = static_cast<AZ::u32>(cand.baseWord.size());
-                    baseCr.tag = RunTag::Word;
-                    AZ::u32 baseIdx = static_cast<AZ::u32>(runs.size());
-                    runs.push_back(baseCr);
+                auto freshCandidates = GenerateStripCandidates(runs, gpuMatches, rulePacksByLength);
 
-                    AZ::u32 baseLen = baseCr.length;
-                    if (activeLenSet.count(baseLen))
-                        runsByLength[baseLen].push_back(baseIdx);
+                // Fill the cache. Every novel form gets an entry — the emplace
+                // pins forms that matched nothing as empty (negative) entries,
+                // and the fresh candidates append onto their forms' vectors.
+                for (AZ::u32 idx : broadphaseCandidates)
+                    m_stripCache.emplace(runs[idx].text, AZStd::vector<StripCandidate>());
+                for (const auto& cand : freshCandidates)
+                    m_stripCache[runs[cand.sourceRunIndex].text].push_back(cand);
 
-                    // For contractions: also inject the second constituent word
-                    if (cand.isContraction && !cand.secondWord.empty())
-                    {
-                        CharRun secondCr;
-                        secondCr.text = cand.secondWord;
-                        secondCr.startPos = 0;
-                        secondCr.length = static_cast<AZ::u32>(cand.secondWord.size());
-                        secondCr.tag = RunTag::Word;
-                        AZ::u32 secondIdx = static_cast<AZ::u32>(runs.size());
-                        runs.push_back(secondCr);
-
-                        AZ::u32 secondLen = secondCr.length;
-                        if (activeLenSet.count(secondLen))
-                            runsByLength[secondLen].push_back(secondIdx);
-                    }
-                }
+                stripCandidates.reserve(stripCandidates.size() + freshCandidates.size());
+                for (auto& cand : freshCandidates)
+                    stripCandidates.push_back(AZStd::move(cand));
+            }
 
-                if (!stripCandidates.empty())
+            // Stage 3 setup: inject ALL base words (cached + fresh) into
+            // runsByLength for ascending PBD
+            for (const auto& cand : stripCandidates)
+            {
+                if (cand.baseWord.empty()) continue;
+
+                // Create synthetic CharRun for the base word
+                CharRun baseCr;
+                baseCr.text = cand.baseWord;
+                baseCr.startPos = 0;
+                baseCr.length = static_cast<AZ::u32>(cand.baseWord.size());
+                baseCr.tag = RunTag::Word;
+                AZ::u32 baseIdx = static_cast<AZ::u32>(runs.size());
+                runs.push_back(baseCr);
+
+                AZ::u32 baseLen = baseCr.length;
+                if (activeLenSet.count(baseLen))
+                    runsByLength[baseLen].push_back(baseIdx);
+
+                // For contractions: also inject the second constituent word
+                if (cand.isContraction && !cand.secondWord.empty())
                 {
-                    fprintf(stderr, "[BedManager] Broadphase injected %zu base words + contractions into resolution queue\n",
-                        stripCandidates.size());
-                    fflush(stderr);
+                    CharRun secondCr;
+                    secondCr.text = cand.secondWord;
+                    secondCr.startPos = 0;
+                    secondCr.length = static_cast<AZ::u32>(cand.secondWord.size());
+                    secondCr.tag = RunTag::Word;
+                    AZ::u32 secondIdx = static_cast<AZ::u32>(runs.size());
+                    runs.push_back(secondCr);
+
+                    AZ::u32 secondLen = secondCr.length;
+                    if (activeLenSet.count(secondLen))
+                        runsByLength[secondLen].push_back(secondIdx);
                 }
             }
+
+            if (!stripCandidates.empty())
+            {
+                fprintf(stderr, "[BedManager] Broadphase injected %zu base words + contractions into resolution queue\n",
+                    stripCandidates.size());
+                fflush(stderr);
+            }
         }
 
         // ---- Ascending length resolve loop with interstitial inflection stripping ----
@@ -2975,7 +4519,7 @@ namespace HCPEngine
             AZStd::vector<InflectionStripResult> candidates;  // priority-ordered
         };
         AZStd::vector<InflectionQueueEntry> inflectionQueue;
-        AZStd::vector<AZ::u32> allUnresolvedOriginal;
+        auto allUnresolvedOriginal = m_resolveArena.MakeVector<AZ::u32>();
         AZ::u32 inflectionCount = 0;
         AZ::u32 syntheticInjections = 0;  // direct LMDB lookups that succeeded
         AZStd::unordered_set<AZStd::string> lookupDone;  // dedup: base words already looked up
@@ -2988,12 +4532,123 @@ namespace HCPEngine
             if (!indices.empty()) runLengths.push_back(len);
         AZStd::sort(runLengths.begin(), runLengths.end());
 
+        // ---- Short-pass tense pre-fetch (fires once, after first length >= 4) ----
+        //
+        // After function-word lengths (2-4) resolve, detect tense/register signals
+        // (past: was/were/had; archaic: hath/thou/etc.) and query the matching Postgres
+        // envelope to inject inflected forms into m_vocabByLength for lengths 5+.
+        // These entries are included by the next ResolveLengthCycle call via
+        // ReadFilteredVocabIndices (which scans up to totalEntries = current vector size).
+        // Extracted into a lambda so the worker-pool path can fire it before fanning
+        // out lengths 5+ even when the text has no length-4 runs.
+        AZStd::string pendingSignalEnvelope;  // queued on the prefetch lane, not yet injected
+
+        // Shared injection: push envelope entries into m_vocabByLength for lengths 5+.
+        auto injectEnvelopeEntries = [&](const AZStd::vector<VocabEntry>& entries,
+                                         const AZStd::string& envelopeName)
+        {
+            AZ::u32 injected = 0;
+            for (const auto& e : entries)
+            {
+                AZ::u32 eLen = static_cast<AZ::u32>(e.word.size());
+                if (eLen < 5 || eLen > 16) continue;  // only unprocessed lengths
+                // FIXED (2026-03-17): AD namespace no longer exists — all tokens
+                // are now AB. Label detection should use PoS/cap metadata, not
+                // namespace prefix. For now, inject everything as tier 1.
+                // TODO: Wire proper Label detection from token_pos PoS data.
+                VocabPack::Entry entry;
+                entry.word      = e.word;
+                entry.tokenId   = e.tokenId;
+                entry.tierIndex = 1u;
+                entry.morphBits = MorphemeNameToBit(e.morpheme.c_str());
+                m_vocabByLength[eLen].push_back(AZStd::move(entry));
+                ++injected;
+            }
+
+            fprintf(stderr, "[BedManager] Pre-fetch injected %u entries from '%s'\n",
+                injected, envelopeName.c_str());
+            fflush(stderr);
+        };
+
+        auto fireShortPassPrefetch = [&]()
+        {
+            if (shortPassSignalFired || !m_envelopeManager) return;
+            shortPassSignalFired = true;
+            ShortPassSignal sig = DetectSignals(manifest);
+
+            // Pick dominant signal — priority: past > progressive > present
+            AZStd::string targetEnvelope;
+            if      (sig.hasPast)        targetEnvelope = "english_past_tense";
+            else if (sig.hasProgressive) targetEnvelope = "english_progressive";
+            else if (sig.hasPresent)     targetEnvelope = "english_plural";
+
+            if (!targetEnvelope.empty())
+            {
+                fprintf(stderr,
+                    "[BedManager] Short-pass signal: past=%d prog=%d pres=%d archaic=%d"
+                    " → pre-fetch '%s'\n",
+                    sig.hasPast, sig.hasProgressive, sig.hasPresent, sig.hasArchaic,
+                    targetEnvelope.c_str());
+                fflush(stderr);
+
+                if (HCPEnvelopeManager::PrefetchEnabled())
+                {
+                    // Queue on the read-ahead lane and keep resolving — the next
+                    // length cycle harvests the entries once they arrive.
+                    m_envelopeManager->PrefetchEnvelopeEntriesAsync(targetEnvelope);
+                    pendingSignalEnvelope = targetEnvelope;
+                }
+                else
+                {
+                    auto entries = m_envelopeManager->QueryEnvelopeEntries(targetEnvelope);
+                    injectEnvelopeEntries(entries, targetEnvelope);
+                }
+            }
+            else if (sig.hasArchaic)
+            {
+                // Archaic envelope not yet defined — log for future wiring
+                fprintf(stderr, "[BedManager] Archaic signal detected"
+                    " — no archaic envelope yet (future Task #16)\n");
+                fflush(stderr);
+            }
+        };
+
+        // Harvest the signal prefetch queued by fireShortPassPrefetch. Waits only
+        // if the lane is still mid-query; falls back to a synchronous fetch if the
+        // lane came up empty, so injection always lands before lengths 5+ read it.
+        auto harvestSignalPrefetch = [&]()
+        {
+            if (pendingSignalEnvelope.empty() || !m_envelopeManager) return;
+            AZStd::vector<VocabEntry> entries;
+            if (!m_envelopeManager->TakeStagedEnvelopeEntries(pendingSignalEnvelope, entries))
+                entries = m_envelopeManager->QueryEnvelopeEntries(pendingSignalEnvelope);
+            injectEnvelopeEntries(entries, pendingSignalEnvelope);
+            pendingSignalEnvelope.clear();
+        };
+
+        // ---- Split sequential vs worker-pool lengths ----
+        // Lengths 2-4 always resolve sequentially (they feed the short-pass
+        // signals). In worker-pool mode, lengths 5+ have no data dependency on
+        // each other and fan out across m_resolveWorkers threads below.
+        AZStd::vector<AZ::u32> sequentialLengths;
+        AZStd::vector<AZ::u32> parallelLengths;
         for (AZ::u32 len : runLengths)
+        {
+            if (m_resolveWorkers > 1 && len >= 5)
+                parallelLengths.push_back(len);
+            else
+                sequentialLengths.push_back(len);
+        }
+
+        for (AZ::u32 len : sequentialLengths)
         {
             // Fetch indices for this length — may include synthetics injected by earlier (longer) cycles
             auto it = runsByLength.find(len);
             if (it == runsByLength.end() || it->second.empty()) continue;
 
+            if (len >= 5)
+                harvestSignalPrefetch();   // inject signal vocab before this cycle reads it
+
             AZStd::vector<AZ::u32> indices = it->second;
 
             AZStd::vector<AZ::u32> unresolvedFromCycle;
@@ -3012,64 +4667,84 @@ namespace HCPEngine
                 len, indices.size(), unresolvedFromCycle.size());
             fflush(stderr);
 
-            // ---- Short-pass tense pre-fetch (fires once, after first length >= 4) ----
-            //
-            // After function-word lengths (2-4) resolve, detect tense/register signals
-            // (past: was/were/had; archaic: hath/thou/etc.) and query the matching Postgres
-            // envelope to inject inflected forms into m_vocabByLength for lengths 5+.
-            // These entries are included by the next ResolveLengthCycle call via
-            // ReadFilteredVocabSlice (which reads up to totalEntries = current vector size).
-            if (!shortPassSignalFired && len >= 4 && m_envelopeManager)
-            {
-                shortPassSignalFired = true;
-                ShortPassSignal sig = DetectSignals(manifest);
-
-                // Pick dominant signal — priority: past > progressive > present
-                AZStd::string targetEnvelope;
-                if      (sig.hasPast)        targetEnvelope = "english_past_tense";
-                else if (sig.hasProgressive) targetEnvelope = "english_progressive";
-                else if (sig.hasPresent)     targetEnvelope = "english_plural";
-
-                if (!targetEnvelope.empty())
-                {
-                    fprintf(stderr,
-                        "[BedManager] Short-pass signal: past=%d prog=%d pres=%d archaic=%d"
-                        " → pre-fetch '%s'\n",
-                        sig.hasPast, sig.hasProgressive, sig.hasPresent, sig.hasArchaic,
-                        targetEnvelope.c_str());
-                    fflush(stderr);
+            if (len >= 4)
+                fireShortPassPrefetch();
+        }
 
-                    auto entries = m_envelopeManager->QueryEnvelopeEntries(targetEnvelope);
-                    AZ::u32 injected = 0;
-                    for (const auto& e : entries)
-                    {
-                        AZ::u32 eLen = static_cast<AZ::u32>(e.word.size());
-                        if (eLen < 5 || eLen > 16) continue;  // only unprocessed lengths
-                        // FIXED (2026-03-17): AD namespace no longer exists — all tokens
-                        // are now AB. Label detection should use PoS/cap metadata, not
-                        // namespace prefix. For now, inject everything as tier 1.
-                        // TODO: Wire proper Label detection from token_pos PoS data.
-                        VocabPack::Entry entry;
-                        entry.word      = e.word;
-                        entry.tokenId   = e.tokenId;
-                        entry.tierIndex = 1u;
-                        entry.morphBits = MorphemeNameToBit(e.morpheme.c_str());
-                        m_vocabByLength[eLen].push_back(AZStd::move(entry));
-                        ++injected;
-                    }
+        // ---- Worker-pool resolve: fan lengths 5+ across dedicated workspaces ----
+        //
+        // Each worker pulls the next unclaimed length off a shared cursor and runs
+        // the normal ResolveLengthCycle against its own workspace, pushing results
+        // onto the bed's lock-free MPSC channels as each length drains — no merge
+        // mutex, so one worker's readback never stalls another's simulate.
+        // Warm-set loading stays correct because AdvanceEnvelopeLengthBatch serializes on
+        // m_envelopeMutex, and per-length vocab buckets are pre-created below so
+        // worker access to m_vocabByLength never rehashes under concurrent readers.
+        if (!parallelLengths.empty())
+        {
+            fireShortPassPrefetch();   // signals must be captured before fan-out
+            harvestSignalPrefetch();   // ...and injected before workers read vocab
 
-                    fprintf(stderr, "[BedManager] Pre-fetch injected %u entries from '%s'\n",
-                        injected, targetEnvelope.c_str());
-                    fflush(stderr);
-                }
-                else if (sig.hasArchaic)
+            for (AZ::u32 len : parallelLengths)
+            {
+                m_vocabByLength[len];      // pre-create bucket (find-only from workers)
+                m_lengthCursorByLen[len];
+            }
+
+            std::atomic<size_t> lengthCursor{0};
+            AZ::u32 workerCount = AZStd::min(m_resolveWorkers,
+                static_cast<AZ::u32>(parallelLengths.size()));
+
+            auto workerBody = [&](AZ::u32 workerIdx)
+            {
+                // Run on the node this worker's workspace planes were
+                // first-touched on (Initialize) — keeps every settle step's
+                // traffic socket-local. Lengths still distribute via the
+                // shared cursor, so a slow length on one socket does not
+                // starve the other.
+                if (workerIdx < m_workerNodes.size())
+                    NumaTopology::Get().PinThreadToNode(m_workerNodes[workerIdx]);
+
+                AZStd::vector<Workspace*> workerWs = { &m_workerWorkspaces[workerIdx] };
+                for (;;)
                 {
-                    // Archaic envelope not yet defined — log for future wiring
-                    fprintf(stderr, "[BedManager] Archaic signal detected"
-                        " — no archaic envelope yet (future Task #16)\n");
+                    size_t li = lengthCursor.fetch_add(1);
+                    if (li >= parallelLengths.size()) break;
+                    AZ::u32 len = parallelLengths[li];
+
+                    auto it = runsByLength.find(len);
+                    if (it == runsByLength.end() || it->second.empty()) continue;
+                    AZStd::vector<AZ::u32> indices = it->second;
+
+                    AZStd::vector<ResolutionResult> localResults;
+                    AZStd::vector<AZ::u32> localUnresolved;
+                    ResolveLengthCycle(len, runs, indices,
+                                       localResults, localUnresolved, &workerWs);
+
+                    // Lock-free push per result — other workers keep simulating.
+                    for (auto& r : localResults)
+                        m_resultQueue.Push(AZStd::move(r));
+                    for (AZ::u32 idx : localUnresolved)
+                        m_unresolvedQueue.Push(idx);
+                    fprintf(stderr, "[BedManager] Length %u (worker %u): %zu runs, %zu unresolved\n",
+                        len, workerIdx, indices.size(), localUnresolved.size());
                     fflush(stderr);
                 }
-            }
+            };
+
+            std::vector<std::thread> workers;
+            for (AZ::u32 w = 0; w < workerCount; ++w)
+                workers.emplace_back(workerBody, w);
+            for (auto& t : workers)
+                t.join();
+
+            // Single consumer: one exchange detaches everything the workers
+            // pushed; results land in push order.
+            m_resultQueue.DrainTo(manifest.results);
+            AZStd::vector<AZ::u32> queuedUnresolved;
+            m_unresolvedQueue.DrainTo(queuedUnresolved);
+            for (AZ::u32 idx : queuedUnresolved)
+                allUnresolvedOriginal.push_back(idx);
         }
 
         // ---- Resolve inflected dependents — priority-ordered candidate matching ----
@@ -3188,7 +4863,7 @@ namespace HCPEngine
             // Remove broadphase-resolved indices from allUnresolvedOriginal
             if (broadphaseResolved > 0)
             {
-                AZStd::vector<AZ::u32> stillUnresolved;
+                auto stillUnresolved = m_resolveArena.MakeVector<AZ::u32>();
                 for (AZ::u32 idx : allUnresolvedOriginal)
                 {
                     if (!resolvedRunIndices.count(idx))
@@ -3814,13 +5489,21 @@ namespace HCPEngine
 
     void BedManager::Shutdown()
     {
+        MemoryBudget::Get().Unregister("envelope_window");
+        MemoryBudget::Get().Unregister("vocab_pack_cache");
         for (auto& ws : m_primaryWorkspaces)
             ws.Shutdown();
         for (auto& ws : m_extendedWorkspaces)
             ws.Shutdown();
+        for (auto& ws : m_workerWorkspaces)
+            ws.Shutdown();
         m_primaryWorkspaces.clear();
         m_extendedWorkspaces.clear();
+        m_workerWorkspaces.clear();
+        ClearVocabPackCache("shutdown");
+        m_resolveArena.Release();
         m_vocabByLength.clear();
+        m_bedFile.Unmap();
         m_vocabDbiOpen = false;
         m_activeWordLengths.clear();
         m_initialized = false;
@@ -3846,29 +5529,35 @@ namespace HCPEngine
         // Var token prefix (unresolved tokens become vars)
         static constexpr const char* SCAN_VAR_PREFIX = "AA.AE.AF.AA.AC";
 
-        // Bond accumulator: "tokenA|tokenB" → count
-        AZStd::unordered_map<AZStd::string, int> bondCounts;
-        AZStd::unordered_set<AZStd::string> uniqueTokenSet;
-
-        AZStd::string prevTokenId;
+        // Tokens are handled as interned u64s here (canonical ids pack to 60 bits,
+        // vars go through the intern table) — one integer hash per occurrence
+        // instead of heap-string keys built and hashed per pair. Bonds tally into
+        // the open-addressing flat table (inline counts, no node allocation).
+        // Strings are materialized once at the ManifestScanResult boundary below,
+        // which feeds the DB writer.
+        TokenInterner interner;
+        BondTally bondCounts;
+        AZStd::unordered_set<TokenHandle> uniqueTokenSet;
+
+        TokenHandle prevToken = 0;
         int position = 0;
 
         for (const auto& r : manifest.results)
         {
             // Determine token ID: resolved tokens use matchedTokenId,
             // unresolved become vars (VAR_PREFIX + surface text)
-            AZStd::string tokenId;
+            TokenHandle token;
             if (r.resolved)
             {
-                tokenId = r.matchedTokenId;
+                token = interner.Intern(r.matchedTokenId);
             }
             else
             {
-                tokenId = AZStd::string(SCAN_VAR_PREFIX) + " " + r.runText;
+                token = interner.Intern(AZStd::string(SCAN_VAR_PREFIX) + " " + r.runText);
             }
 
             // Diagnostic: catch empty tokenIds before they route to '....' row
-            if (tokenId.empty())
+            if (r.resolved && r.matchedTokenId.empty())
             {
                 static int emptyWarnings = 0;
                 if (emptyWarnings < 10)
@@ -3882,55 +5571,53 @@ namespace HCPEngine
                 }
             }
 
-            uniqueTokenSet.insert(tokenId);
+            uniqueTokenSet.insert(token);
 
-            // Record only ALL_CAPS — author override, not derivable. FIRST_CAP is
-            // positional (capitalize-next after . ? ! \n) and Label tokens carry
-            // their intrinsic cap in entries.word, so the reader handles both.
-            // Other morpheme bits (PAST, PROG, etc.) are no longer written —
-            // every form is its own token. Possessives: future work.
-            if (r.allCaps) out.morphemePositions["ALL_CAPS"].push_back(position);
+            // Packed modifier, TokenStream layout. The writer only stores
+            // ALL_CAPS today (author override, not derivable — FIRST_CAP is
+            // positional and Label tokens carry their intrinsic cap in
+            // entries.word), but the full bits ride along for free.
+            out.modifiers.push_back((static_cast<AZ::u32>(r.morphBits) << 2)
+                | (r.firstCap ? 1u : 0u) | (r.allCaps ? 2u : 0u));
 
-            out.tokenIds.push_back(tokenId);
+            out.tokenIds.push_back(interner.ToString(token));
             out.positions.push_back(position);
             out.entityIds.push_back(r.entityId);
             if (!r.entityId.empty()) ++out.entityAnnotations;
 
             // Bond: pair with previous token (scanner tallies as they pass)
-            if (!prevTokenId.empty())
+            if (position > 0)
             {
-                AZStd::string key = prevTokenId + "|" + tokenId;
-                bondCounts[key]++;
+                bondCounts.Increment(prevToken, token);
                 out.totalPairs++;
             }
             else
             {
                 // First token = first FPB A-side
-                out.firstFpbA = tokenId;
+                out.firstFpbA = interner.ToString(token);
             }
 
             // Second token = first FPB B-side
             if (position == 1)
-                out.firstFpbB = tokenId;
+                out.firstFpbB = interner.ToString(token);
 
-            prevTokenId = tokenId;
+            prevToken = token;
             ++position;
         }
 
         out.totalSlots = position;
         out.uniqueTokens = uniqueTokenSet.size();
 
-        // Convert bond map to Bond vector
-        out.bonds.reserve(bondCounts.size());
-        for (auto& [key, count] : bondCounts)
+        // Convert the tally to a Bond vector — the string boundary.
+        out.bonds.reserve(bondCounts.Size());
+        bondCounts.ForEach([&](TokenHandle a, TokenHandle b, int count)
         {
-            size_t sep = key.find('|');
             Bond bond;
-            bond.tokenA = AZStd::string(key.data(), sep);
-            bond.tokenB = AZStd::string(key.data() + sep + 1, key.size() - sep - 1);
+            bond.tokenA = interner.ToString(a);
+            bond.tokenB = interner.ToString(b);
             bond.count = count;
             out.bonds.push_back(AZStd::move(bond));
-        }
+        });
 
         size_t emptyTotal = 0;
         for (const auto& tid : out.tokenIds) if (tid.empty()) ++emptyTotal;
@@ -3941,4 +5628,87 @@ namespace HCPEngine
         return out;
     }
 
+    ManifestScanAggregate ScanManifestToPBMStreaming(const ResolutionManifest& manifest)
+    {
+        ManifestScanAggregate out;
+        if (manifest.results.empty()) return out;
+
+        static constexpr const char* SCAN_VAR_PREFIX = "AA.AE.AF.AA.AC";
+
+        // Same pass as ScanManifestToPBM, but nothing per-slot survives it:
+        // positions append to the per-token grouping as each token passes,
+        // ALL_CAPS slots go straight into their own list, and the bond tally
+        // aggregates as usual. Resident state is the tally + grouping — one
+        // int per slot and one string per unique token, not a heap string per
+        // slot. uniqueTokens falls out of the grouping for free.
+        TokenInterner interner;
+        BondTally bondCounts;
+        AZStd::unordered_map<TokenHandle, AZStd::vector<int>> positionsByToken;
+
+        TokenHandle prevToken = 0;
+        int position = 0;
+
+        for (const auto& r : manifest.results)
+        {
+            TokenHandle token;
+            if (r.resolved)
+            {
+                token = interner.Intern(r.matchedTokenId);
+            }
+            else
+            {
+                token = interner.Intern(AZStd::string(SCAN_VAR_PREFIX) + " " + r.runText);
+            }
+
+            positionsByToken[token].push_back(position);
+            if (r.allCaps) out.allCapsPositions.push_back(position);
+            if (!r.entityId.empty()) ++out.entityAnnotations;
+
+            if (position > 0)
+            {
+                bondCounts.Increment(prevToken, token);
+                out.totalPairs++;
+            }
+            else
+            {
+                out.firstFpbA = interner.ToString(token);
+            }
+
+            if (position == 1)
+                out.firstFpbB = interner.ToString(token);
+
+            prevToken = token;
+            ++position;
+        }
+
+        out.totalSlots = position;
+        out.uniqueTokens = positionsByToken.size();
+
+        out.bonds.reserve(bondCounts.Size());
+        bondCounts.ForEach([&](TokenHandle a, TokenHandle b, int count)
+        {
+            Bond bond;
+            bond.tokenA = interner.ToString(a);
+            bond.tokenB = interner.ToString(b);
+            bond.count = count;
+            out.bonds.push_back(AZStd::move(bond));
+        });
+
+        // String boundary for the grouping: one materialization per unique
+        // token. Lists are ascending by construction (position only grows).
+        out.starterPositions.reserve(positionsByToken.size());
+        for (auto& [handle, posList] : positionsByToken)
+        {
+            out.starterPositions.emplace_back(
+                interner.ToString(handle), AZStd::move(posList));
+        }
+
+        fprintf(stderr, "[ScanManifest] (streaming) %d slots, %zu unique, %zu bond types, "
+            "%zu total pairs\n",
+            out.totalSlots, out.uniqueTokens, out.bonds.size(), out.totalPairs);
+        fflush(stderr);
+
+        return out;
+    }
+
 } // namespace HCPEngine
@@ -5,15 +5,24 @@
 #include <AzCore/std/containers/unordered_map.h>
 #include <AzCore/std/containers/unordered_set.h>
 #include <AzCore/std/string/string.h>
+#include <AzCore/std/utils.h>
 #include <vector>          // std::vector for bulk vocab data (off AZ pool)
 #include <unordered_map>   // std::unordered_map for m_vocabByLength (off AZ pool)
-#include <regex>           // std::regex for compiled rule conditions
+#include <regex>           // std::regex fallback for complex rule conditions
+#include <bitset>          // std::bitset char sets in CompiledCondition
+#include <mutex>           // std::mutex for worker-pool resolve mode
+#include <memory>          // std::shared_ptr for the cross-document VocabPack cache
+#include <string>          // std::string cache keys (off AZ pool)
 #include "HCPResolutionChamber.h"  // ResolutionManifest, ResolutionResult, StreamRunSlot, etc.
 #include "HCPParticlePipeline.h"   // Bond, PBMData
-#include "Settle/SettleKernel.h"   // hcp::settle::Float4 — host-resident particle storage (AZSL swap)
+#include "HCPResolveArena.h"       // ResolveArena, ArenaVector — per-resolve scratch
+#include "HCPMpscQueue.h"          // MpscQueue — lock-free worker result channel
+#include "Pack/BedFile.h"          // BedFileView — mmap'd compiled vocab bed
 
 #include <lmdb.h>   // MDB_env, MDB_dbi (header uses MDB_dbi — not forward-declarable)
 
+namespace hcp::settle { class VkSettleBackend; }  // Source/Settle/VkSettleBackend.h
+
 namespace HCPEngine
 {
     // ---- Constants ----
@@ -32,6 +41,16 @@ namespace HCPEngine
     //! Number of extended workspaces (handle lengths 11-20+, sparse).
     static constexpr AZ::u32 WS_EXTENDED_COUNT = 2;
 
+    //! Cap on concurrent length-resolve workers (worker-pool mode).
+    //! Actual count = min(HCP_RESOLVE_WORKERS, this, hardware_concurrency);
+    //! unset/1 = sequential resolve (the default, identical to the old path).
+    static constexpr AZ::u32 WS_RESOLVE_WORKER_MAX = 8;
+
+    //! Broadphase task granularity: candidate runs per work-stealing task.
+    //! Small enough that a few inflection-heavy lengths still split across
+    //! workers, large enough that per-task rule-pack loads stay in the noise.
+    static constexpr AZ::u32 WS_BROADPHASE_CHUNK = 256;
+
     //! Settlement threshold: particle is settled when velocity magnitude < this.
     static constexpr float WS_VELOCITY_SETTLE_THRESHOLD = 0.5f;
 
@@ -57,6 +76,8 @@ namespace HCPEngine
         std::vector<float> positions;       // Flat: [x,y,z,w] * totalVocabParticles
         std::vector<AZ::u32> phases;        // Logical tier index per particle
 
+        //! Warm-set entry shape (as built by RebuildVocab and friends). Packs
+        //! do NOT store these — see the hot/cold split below.
         struct Entry
         {
             AZStd::string word;
@@ -64,10 +85,48 @@ namespace HCPEngine
             AZ::u32 tierIndex = 0;
             AZ::u16 morphBits = 0;  // Morph bits from warm-set entry (e.g. PAST for "stood")
         };
-        AZStd::vector<Entry> entries;
+
+        // Hot/cold split of per-entry metadata (claim 444 fixed-stride
+        // discipline, same as Pack/PackKernel.h): the settle path touches only
+        // scalar metadata plus offsets into one contiguous char blob, so the
+        // pack's settle-adjacent arrays never drag string headers through
+        // cache. Identity strings are consulted only on CheckSettlement hits.
+
+        //! Hot per-entry settle metadata (16 bytes, trivially copyable).
+        struct HotEntry
+        {
+            AZ::u32 charOffset = 0;  // Byte offset of this word in charBlob
+            AZ::u32 charCount = 0;   // Word byte length (may be < wordLength)
+            AZ::u32 tierIndex = 0;
+            AZ::u16 morphBits = 0;   // Morph bits from warm-set entry
+            AZ::u16 pad = 0;
+        };
+        std::vector<HotEntry> hot;   // system heap, like positions/phases
+        std::string charBlob;        // contiguous word chars; hot[i] addresses
+
+        //! Cold identity, read only when a slot settles: the token id
+        //! reattached to the resolved slot. The matched word itself comes
+        //! from charBlob via the hot entry.
+        AZStd::vector<AZStd::string> coldTokenIds;
 
         // O(1) settlement lookup per tier: tierLookup[tier][word] -> entry index
         AZStd::vector<AZStd::unordered_map<AZStd::string, AZ::u32>> tierLookup;
+
+        //! Resident-byte estimate for the memory-budget accounting — array
+        //! capacities plus string payloads, not a malloc audit.
+        size_t ApproxBytes() const
+        {
+            size_t bytes = sizeof(VocabPack)
+                + positions.capacity() * sizeof(float)
+                + phases.capacity() * sizeof(AZ::u32)
+                + hot.capacity() * sizeof(HotEntry)
+                + charBlob.capacity();
+            for (const auto& id : coldTokenIds)
+                bytes += sizeof(AZStd::string) + id.size();
+            for (const auto& lookup : tierLookup)
+                bytes += lookup.size() * (sizeof(AZStd::string) + sizeof(AZ::u32) + 16);
+            return bytes;
+        }
     };
 
     // ---- RulePack: partial-match patterns for broadphase GPU filtering ----
@@ -105,6 +164,16 @@ namespace HCPEngine
 
         AZStd::vector<RulePackEntry> rules;    // Pattern metadata (parallel to particle layout)
         AZStd::vector<AZ::u32> activePositionCount;  // Non-\0 positions per pattern
+
+        // Broadphase acceleration, filled by BuildRulePack alongside the
+        // particle layout: per pattern, a bitmask of active (non-\0)
+        // positions plus the pattern bytes packed 8-per-u64 lane.
+        // CheckPartialSettlement quantizes each slot once and compares whole
+        // lanes under the mask instead of walking (pattern x position) pairs.
+        AZ::u32 laneCount = 0;                 // u64 lanes per pattern: ceil(cellLength / 8)
+        AZStd::vector<AZ::u64> activeMask;     // Bit c set = pattern has a char at position c
+        AZStd::vector<AZ::u64> packedChars;    // laneCount per pattern; \0 bytes at inert positions
+        AZStd::vector<AZ::u64> laneMask;       // laneCount per pattern; 0xFF bytes at active positions
     };
 
     // ---- Strip candidate: CPU-generated base from a GPU-matched group ----
@@ -154,11 +223,19 @@ namespace HCPEngine
         AZ::u32 LoadVocabPack(const VocabPack& pack, AZ::u32 wordLength);
 
         //! Load stream runs into dynamic region. Returns overflow count.
+        //! When `pack` is given, each slot's vocab entry index is bound here
+        //! (one tier-0 lookup per slot, off the readback path) so settlement
+        //! identification is purely positional. nullptr = rule-pack loads,
+        //! where CheckPartialSettlement does its own pattern mapping.
         AZ::u32 LoadStreamRuns(const AZStd::vector<CharRun>& runs,
                                const AZStd::vector<AZ::u32>& indices,
-                               AZ::u32 wordLength);
+                               AZ::u32 wordLength,
+                               const VocabPack* pack = nullptr);
 
-        //! Check settlement against VocabPack's tier lookup (exact match — all positions).
+        //! Check settlement (exact match — all positions). Settled slots are
+        //! identified by the entry index bound at LoadStreamRuns — no string
+        //! hashing on the readback path; tierLookup remains the fallback for
+        //! unbound slots / non-zero tiers and the HCP_SETTLE_CROSSCHECK oracle.
         void CheckSettlement(AZ::u32 tierIndex, const VocabPack& pack);
 
         //! Load partial-match rule patterns into vocab region (same CUDA workflow as LoadVocabPack).
@@ -172,15 +249,24 @@ namespace HCPEngine
             AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>>& matches);
 
         //! Phase-only flip for unresolved stream particles to next tier.
+        //! Legacy single-step building block: multi-tier packs are now settled
+        //! fused inside BeginSimulate (re-gate without a host round trip);
+        //! kept for callers that drive tiers manually.
         void FlipToTier(AZ::u32 nextTier);
 
+        //! Per-tier settled slot counts from the last BeginSimulate on a
+        //! multi-tier pack (index = tier). Empty for single-tier packs.
+        const AZStd::vector<AZ::u32>& TierSettledCounts() const { return m_tierSettledCounts; }
+
         //! Collect results from stream slots into output vector.
         void CollectResults(AZStd::vector<ResolutionResult>& out);
 
         //! True if any stream slot is unresolved.
         bool HasUnresolved() const;
 
-        //! Clear dynamic region, ready for next cycle.
+        //! Retire the cycle's stream slots, ready for next cycle. Metadata-only:
+        //! particle parking is deferred to the next LoadStreamRuns, which parks
+        //! just the stale span below the high-water mark (see m_dynHighWater).
         void ResetDynamics();
 
         //! Add/remove particle system from own scene.
@@ -211,9 +297,13 @@ namespace HCPEngine
         // Host-resident particle arrays — AZSL swap, replaces PxParticleBuffer/CUDA.
         // Layout: [vocab region (static, w=0)] [stream region (dynamic, w=1)].
         // position.w = invMass (>0 movable run, 0 immovable bed). Sized to m_bufferCapacity.
+        // SoA planes (one vector per component): the settle and the settlement
+        // checks touch one or two components per pass, so separate planes keep
+        // cache lines dense — and it is the layout the SIMD settle
+        // (SettleKernelSimd.h) and a future GPU buffer upload consume directly.
         // std::vector (system heap) keeps bulk particle data off the AZ allocator pool.
-        std::vector<hcp::settle::Float4> m_pos;
-        std::vector<hcp::settle::Float4> m_vel;
+        std::vector<float> m_posX, m_posY, m_posZ, m_posW;
+        std::vector<float> m_velX, m_velY, m_velZ;
         std::vector<AZ::u32>             m_phase;
         AZ::u32 m_activeParticles = 0;      // Replaces PxParticleBuffer::setNbActiveParticles
 
@@ -221,21 +311,50 @@ namespace HCPEngine
         AZ::u32 m_vocabParticleCount = 0;   // Current vocab region size (changes per cycle)
         AZ::u32 m_maxStreamSlots = 0;       // Stream capacity for current cycle
         AZ::u32 m_currentWordLength = 0;    // Word length of current loaded pack
+        AZ::u32 m_dynHighWater = 0;         // One past the furthest particle holding live
+                                            // (non-parked) data since Create. LoadStreamRuns
+                                            // parks only [freshly written end, high water),
+                                            // so reset cost tracks particles actually used
+                                            // in the cycle, not the full stream capacity.
         bool m_activeInScene = false;
 
         int m_pendingSteps = 0;              // Steps remaining in current BeginSimulate
         float m_simDt = 0.0f;               // dt for current simulation
 
+        // Optional Vulkan compute settle (Source/Settle/VkSettleBackend.h).
+        // Null → BeginSimulate runs the host SIMD settle synchronously.
+        std::unique_ptr<hcp::settle::VkSettleBackend> m_vkBackend;
+        AZ::u32 m_vkVocabDirtyFrom = 0;      // Device vocab region stale from this index on
+                                             // (>= m_vocabParticleCount means clean)
+        AZ::u32 m_vkActiveCount = 0;         // Particle count of the in-flight GPU submit
+
         AZStd::vector<StreamRunSlot> m_streamSlots;
 
         // Phase group IDs per tier (persistent across cycles)
         AZStd::vector<AZ::u32> m_tierPhases;
         AZ::u32 m_inertPhase = 0;
         AZ::u32 m_maxTierCount = 0;
+
+        // Per-tier settled counts from the last fused multi-tier settle.
+        AZStd::vector<AZ::u32> m_tierSettledCounts;
+
+        //! Velocity-gate settlement test over one slot's chars (the physical
+        //! criterion; the differential contact floor makes "settled" imply
+        //! "spelling present in the bed"). Shared by the fused tier loop.
+        bool SlotSettled(const StreamRunSlot& slot, AZ::u32 count) const;
+
+        // Replay capture stash (HCP_REPLAY_DIR, see Settle/ReplayCapture.h):
+        // pattern bytes of the loaded rule pack, folded into the capture file
+        // BeginSimulate writes. LoadVocabPack clears it (vocab beds carry no
+        // pack); LoadRulePack rebuilds it from the pack's packed lanes.
+        AZ::u32 m_capPackCellLength = 0;
+        AZ::u32 m_capPackPatternCount = 0;
+        std::vector<char> m_capPackChars;
     };
 
     class HCPVocabulary;      // For punctuation lookups (declared in HCPVocabulary.h)
     class HCPEnvelopeManager; // For mid-resolve pre-fetch (declared in HCPEnvelopeManager.h)
+    struct SliceAdvance;      // Lane-captured slice transition (HCPEnvelopeManager.h)
 
     // ---- Manifest scanner output ----
     //
@@ -257,10 +376,11 @@ namespace HCPEngine
         AZStd::vector<int> positions;            // Position number per slot
         AZStd::vector<AZStd::string> entityIds;  // Entity ID per slot (empty = not part of entity)
 
-        // Sparse cap overlay lists. Only 'FIRST_CAP' and 'ALL_CAPS' are written today
-        // (every form is its own token, so morpheme bits like PAST/PROG/etc. are no longer needed).
-        // Possessive handling is future work. Written to pbm_cap_flags.
-        AZStd::unordered_map<AZStd::string, AZStd::vector<int>> morphemePositions;
+        // Packed per-position modifier column, 1:1 with tokenIds — same layout as
+        // TokenStream::modifiers: (morphBits << 2) | firstCap | (allCaps << 1).
+        // The writer extracts what it stores (today: ALL_CAPS, bit 1) straight
+        // from the bits; no string-keyed morpheme map is rebuilt per document.
+        AZStd::vector<AZ::u32> modifiers;
         int totalSlots = 0;                       // Total position slots in document
         size_t entityAnnotations = 0;             // Count of tokens with entity annotations
     };
@@ -271,6 +391,38 @@ namespace HCPEngine
     //! Unresolved runs become vars (VAR_PREFIX + surface text).
     ManifestScanResult ScanManifestToPBM(const ResolutionManifest& manifest);
 
+    // Streaming scan: for very large documents the per-slot parallel arrays
+    // above are the problem — a heap token-id string per slot roughly doubles
+    // peak memory on top of the manifest. The streaming scan keeps only the
+    // aggregates resident: the bond tally and the per-starter position
+    // grouping (ints per slot, one key string per UNIQUE token). The writer
+    // consumes the grouping directly (StorePositionsGrouped), so the per-slot
+    // arrays are never built at all.
+
+    struct ManifestScanAggregate
+    {
+        AZStd::vector<Bond> bonds;              // Aggregated adjacent-pair bonds
+        AZStd::string firstFpbA;                // First forward pair bond A-side
+        AZStd::string firstFpbB;                // First forward pair bond B-side
+        size_t totalPairs = 0;
+        size_t uniqueTokens = 0;
+
+        // Positions grouped per starter token, ascending — one entry per
+        // unique token, ready for PosPack + the writer's COPY path.
+        AZStd::vector<AZStd::pair<AZStd::string, AZStd::vector<int>>> starterPositions;
+
+        AZStd::vector<int> allCapsPositions;    // Slots carrying the ALL_CAPS override
+        int totalSlots = 0;                       // Total position slots in document
+        size_t entityAnnotations = 0;             // Count of tokens with entity annotations
+    };
+
+    //! Bounded-memory variant of ScanManifestToPBM. Same single pass, same
+    //! bond tally, identical rows once stored — but positions group per
+    //! interned token as they flow past instead of materializing tokenIds/
+    //! positions/modifiers per slot. Pair with
+    //! HCPPbmWriter::StorePositionsGrouped.
+    ManifestScanAggregate ScanManifestToPBMStreaming(const ResolutionManifest& manifest);
+
     // ---- ShortPassSignal: tense/register context from short-word pass ----
     //
     // After resolving lengths 2-4 (function words), scan the manifest for
@@ -291,6 +443,53 @@ namespace HCPEngine
     //! Called after length-4 cycle; result drives pre-fetch envelope selection.
     ShortPassSignal DetectSignals(const ResolutionManifest& manifest);
 
+    // ---- CompiledCondition: regex-free inflection-rule condition matcher ----
+    //
+    // Rule conditions are almost all simple anchored predicates — "e$",
+    // "[^aeiou]y$", "[aeiou]$" — and std::regex_search costs microseconds per
+    // call, which dominates strip-candidate generation on inflection-heavy
+    // documents. Conditions whose pattern is a plain run of literals and
+    // character classes (with optional ^/$ anchors) compile to a byte-wise
+    // matcher; anything with real regex machinery (quantifiers, groups,
+    // alternation, escape classes) keeps the std::regex fallback.
+
+    struct CompiledCondition
+    {
+        //! One pattern position: a 256-bit membership set (a literal sets one
+        //! bit, a class sets its members, '.' sets all). negate inverts [^...].
+        struct Elem
+        {
+            std::bitset<256> chars;
+            bool negate = false;
+
+            bool Hits(char c) const
+            {
+                return chars.test(static_cast<unsigned char>(c)) != negate;
+            }
+        };
+
+        enum class Kind : AZ::u8
+        {
+            Always,     // empty pattern — every base satisfies it
+            Suffix,     // "...$" — elems match the tail of the word
+            Prefix,     // "^..." — elems match the head of the word
+            Exact,      // "^...$" — elems match the whole word
+            Substring,  // unanchored — elems scanned at every offset
+            Regex       // fallback for genuinely complex patterns
+        };
+
+        Kind kind = Kind::Always;
+        std::vector<Elem> elems;
+        std::regex fallback;
+
+        //! Build from a rule condition pattern. Falls back to std::regex
+        //! when the pattern uses machinery the fast path doesn't model.
+        static CompiledCondition Compile(const AZStd::string& pattern);
+
+        //! Equivalent to std::regex_search(s, <original pattern>).
+        bool Matches(const std::string& s) const;
+    };
+
     // ---- BedManager: orchestrates Workspace pool + phased vocab resolution ----
     //
     // Data source: pre-compiled LMDB (data/vocab.lmdb/) with per-length sub-databases.
@@ -317,6 +516,15 @@ namespace HCPEngine
 
         ResolutionManifest Resolve(const AZStd::vector<CharRun>& runs);
 
+        //! Resolve a batch of documents back to back without the per-document
+        //! fixed costs. The targeted Postgres→LMDB bucket load and vocab rebuild
+        //! happen ONCE for the union of all documents' needs, and each document
+        //! restarts from a snapshot of the batch-0 buckets instead of re-querying.
+        //! With the persistent VocabPack cache this keeps the workspace pipeline
+        //! fed across document boundaries. Manifests returned in input order.
+        AZStd::vector<ResolutionManifest> ResolveBatch(
+            const AZStd::vector<AZStd::vector<CharRun>>& documents);
+
         //! Load and compile inflection rules from the DB.
         //! Splits into suffix and prefix rule sets automatically (by rule_type field).
         //! @param rules Loaded rules (from HCPEnvelopeManager::LoadInflectionRules)
@@ -332,29 +540,79 @@ namespace HCPEngine
         void InitEnvelopeWindow(int envelopeId, int warmSetSize);
 
         //! Entries per LMDB hot-cache slot. 3 slots active at any time = 3 × LMDB_SLICE_SIZE.
-        //! Also controls per-length batch size in QueryWarmBatch multi-slice loop.
-        //! Larger value = fewer Postgres round-trips per length, more GPU particles per pass.
+        //! Also the UPPER BOUND on per-length batch size in the QueryWarmBatch
+        //! multi-slice loop — SliceBudget shrinks batches below this for short
+        //! documents (see the adaptive slice sizing block in the private section).
         static constexpr int LMDB_SLICE_SIZE = 20000;
 
+        //! Floor for adaptive per-length batches — below this the Postgres
+        //! round trip dominates and smaller batches stop paying off.
+        static constexpr int MIN_SLICE_SIZE = 2000;
+
         void Shutdown();
 
         bool IsInitialized() const { return m_initialized; }
 
+        //! Resident-byte estimates for the memory-budget accounting
+        //! (HCPMemoryBudget.h; registered by Initialize, dropped by Shutdown).
+        //! The envelope window is the per-length warm entry buckets plus the
+        //! batch-0 snapshot; the pack cache sums its cached packs under its
+        //! own lock.
+        size_t EnvelopeWindowBytes() const;
+        size_t VocabPackCacheBytes();
+
     private:
-        //! Read filtered vocab entries directly from LMDB for one word length.
-        //! Scans entries [startEntry, endEntry) and returns only those whose first char
-        //! is in neededChars. Zero-copy LMDB read; caller owns the returned vector.
-        std::vector<VocabPack::Entry> ReadFilteredVocabSlice(
+        //! Filter vocab entries for one word length by first character.
+        //! Scans entries [startEntry, endEntry) of m_vocabByLength[wordLength] and
+        //! returns the INDICES of those whose first char is in neededChars — no
+        //! Entry copies (the old copying slice paid two string allocations per
+        //! surviving entry; the pack builder now reads entries in place).
+        std::vector<AZ::u32> ReadFilteredVocabIndices(
             AZ::u32 wordLength,
             const AZStd::unordered_set<char>& neededChars,
             AZ::u32 startEntry,
             AZ::u32 endEntry) const;
 
-        //! Build a VocabPack from a pre-filtered entry vector slice.
+        //! Build a VocabPack from filtered indices [startEntry, startEntry+count)
+        //! into `entries` (the full per-length vocab vector, read in place).
         VocabPack BuildVocabSliceFromEntries(AZ::u32 wordLength,
             const std::vector<VocabPack::Entry>& entries,
+            const std::vector<AZ::u32>& filteredIndices,
             AZ::u32 startEntry, AZ::u32 count) const;
 
+        //! Get (or build and cache) the VocabPack for one filtered slice.
+        //! Checks the persistent cross-document cache first — see the comment on
+        //! m_packCache. filterHash identifies the filtered index list (computed
+        //! once per cascade in RunPipelinedCascade).
+        std::shared_ptr<const VocabPack> AcquireVocabPack(
+            AZ::u32 wordLength,
+            const std::vector<VocabPack::Entry>& entries,
+            const std::vector<AZ::u32>& filteredIndices,
+            AZ::u64 filterHash,
+            AZ::u32 startEntry, AZ::u32 count);
+
+        //! Drop all cached VocabPacks and log hit/miss counts. Called when the
+        //! hot window moves (RebuildVocab), on envelope change, and at shutdown.
+        void ClearVocabPackCache(const char* reason);
+
+        //! Replace m_vocabByLength[wordLength] with the mapped bed bucket's
+        //! window [offset, offset+count). Returns entries loaded (0 = past end).
+        AZ::u32 LoadBedFileWindow(AZ::u32 wordLength, int offset, int count);
+
+        //! Rebuild every vocab bucket from the mapped bed file (first window
+        //! per length). The bed-file analogue of the w2t cursor walk.
+        void RebuildVocabFromBedFile();
+
+        //! Collect the p3 bucket codes and word lengths a run list will need
+        //! from Postgres (letter × length, plus hyphen compound/component
+        //! derivations). Shared by Resolve's targeted load and ResolveBatch's
+        //! union load. Appends into the caller's accumulators (p3Seen dedupes).
+        void CollectNeededBuckets(
+            const AZStd::vector<CharRun>& runs,
+            AZStd::unordered_set<AZStd::string>& p3Seen,
+            AZStd::vector<AZStd::string>& neededP3,
+            AZStd::unordered_set<int>& lengthSet) const;
+
         //! Get workspace pool for a given word length (primary or extended).
         AZStd::vector<Workspace*> GetWorkspacesForLength(AZ::u32 wordLength);
 
@@ -369,25 +627,32 @@ namespace HCPEngine
             AZStd::vector<AZ::u32>& unresolvedIndices);
 
         //! Pipelined phase cascade — overlaps GPU simulation of phase N with CPU
-        //! preparation of phase N+1. filteredVocab is a pre-filtered slice from LMDB.
+        //! preparation of phase N+1. vocabEntries is the full per-length vocab
+        //! vector; filteredIndices selects the pre-filtered entries (in order).
         //! Requires WS_PRIMARY_COUNT >= 3 for full triple-pipeline benefit.
+        //! workspaceOverride: non-null = use these workspaces instead of the shared
+        //! pools (worker-pool mode gives each worker its own workspace).
         void RunPipelinedCascade(
             AZ::u32 wordLength,
             const AZStd::vector<CharRun>& runs,
-            const std::vector<VocabPack::Entry>& filteredVocab,
+            const std::vector<VocabPack::Entry>& vocabEntries,
+            const std::vector<AZ::u32>& filteredIndices,
             AZStd::vector<AZ::u32>& currentIndices,
             AZStd::vector<ResolutionResult>& results,
-            AZ::u32& phaseIndex);
+            AZ::u32& phaseIndex,
+            const AZStd::vector<Workspace*>* workspaceOverride = nullptr);
 
         //! Resolve runs of a single word length through Label + common phase cascade.
         //! Labels checked only against capitalized runs (firstCap/allCaps).
         //! Common vocab checked against all remaining unresolved runs.
+        //! workspaceOverride: see RunPipelinedCascade.
         void ResolveLengthCycle(
             AZ::u32 wordLength,
             AZStd::vector<CharRun>& runs,
             const AZStd::vector<AZ::u32>& runIndices,
             AZStd::vector<ResolutionResult>& results,
-            AZStd::vector<AZ::u32>& unresolvedIndices);
+            AZStd::vector<AZ::u32>& unresolvedIndices,
+            const AZStd::vector<Workspace*>* workspaceOverride = nullptr);
 
         //! Build a RulePack for one cell length from loaded inflection/prefix rules.
         //! Suffix patterns right-aligned, prefix patterns left-aligned. ~50 patterns.
@@ -398,7 +663,7 @@ namespace HCPEngine
         //! This is the fast parallel filter — GPU identifies which suffix/prefix matched.
         AZStd::vector<AZStd::pair<AZ::u32, AZ::u32>> RunBroadphaseFilter(
             const AZStd::vector<CharRun>& runs,
-            const AZStd::vector<AZ::u32>& candidateIndices);
+            const ArenaVector<AZ::u32>& candidateIndices);
 
         //! Generate ALL possible strip bases from GPU-matched groups (CPU, no existence check).
         //! Takes GPU filter results + rules, mechanically strips to produce base words.
@@ -416,6 +681,21 @@ namespace HCPEngine
         AZStd::vector<Workspace> m_primaryWorkspaces;    // For lengths 2-10
         AZStd::vector<Workspace> m_extendedWorkspaces;   // For lengths 11-20+
 
+        // Worker-pool mode (HCP_RESOLVE_WORKERS > 1): lengths 5+ resolve
+        // concurrently, one dedicated workspace per worker so the shared pools
+        // are never touched from two threads. 1 = sequential (default).
+        AZ::u32 m_resolveWorkers = 1;
+        AZStd::vector<Workspace> m_workerWorkspaces;     // One per worker
+        AZStd::vector<AZ::u32> m_workerNodes;            // NUMA node per worker (round-robin;
+                                                         // planes first-touched there at Create,
+                                                         // worker thread pinned there at resolve)
+        std::mutex m_envelopeMutex;                      // Serializes warm-set queries + vocab map writes
+
+        // Lock-free readback channels: workers push as their workspaces drain;
+        // the Resolve thread is the single consumer after the pool joins.
+        MpscQueue<ResolutionResult> m_resultQueue;
+        MpscQueue<AZ::u32> m_unresolvedQueue;
+
         // LMDB environment + w2t handle.
         // w2t is populated by EnvelopeManager::ActivateEnvelope before resolve.
         // Call RebuildVocab() after each envelope activation to refresh in-memory index.
@@ -423,12 +703,31 @@ namespace HCPEngine
         MDB_dbi m_vocabDbi = 0;
         bool m_vocabDbiOpen = false;
 
+        // Compiled bed file (HCP_BED_FILE, written by Pack/pack_vocab): mmap'd
+        // per-length fixed-stride char blobs + tier tables + token-id ledger.
+        // When mapped, vocab buckets are built by pointer arithmetic over the
+        // mapped pages — no LMDB cursor walk at cold start and no Postgres
+        // round-trip per slice advance.
+        HCP::Pack::BedFileView m_bedFile;
+
         // Inflection rules loaded from hcp_english.inflection_rules at startup.
         // Set via SetInflectionRules(); compiled conditions parallel the rules vector.
-        AZStd::vector<InflectionRule> m_inflectionRules;   // SUFFIX rules only
-        std::vector<std::regex>       m_compiledConditions;
-        AZStd::vector<InflectionRule> m_prefixRules;       // PREFIX rules only
-        std::vector<std::regex>       m_compiledPrefixConditions;
+        AZStd::vector<InflectionRule>  m_inflectionRules;   // SUFFIX rules only
+        std::vector<CompiledCondition> m_compiledConditions;
+        AZStd::vector<InflectionRule>  m_prefixRules;       // PREFIX rules only
+        std::vector<CompiledCondition> m_compiledPrefixConditions;
+
+        // Cross-document strip-candidate cache, keyed by surface form.
+        // Broadphase matching and base expansion are pure functions of the
+        // text and the rule set, so "running" pays for its -ing walk once per
+        // process, not once per document. An empty vector is a negative entry
+        // (the form matched no pattern) — steady-state ingest mostly hits
+        // those. sourceRunIndex in cached entries is meaningless; it is
+        // patched to the current pass's run index on replay. Cleared by
+        // SetInflectionRules — cached bases are stale when the rules change.
+        AZStd::unordered_map<AZStd::string, AZStd::vector<StripCandidate>> m_stripCache;
+        AZ::u64 m_stripCacheHits = 0;
+        AZ::u64 m_stripCacheMisses = 0;
 
         // In-memory vocab index built from w2t on each RebuildVocab() call.
         // Grouped by word length, in insertion order (frequency-ordered by envelope query).
@@ -437,16 +736,90 @@ namespace HCPEngine
         // Label count per word length — zero until label tier is wired to envelope.
         AZStd::unordered_map<AZ::u32, AZ::u32> m_labelCountByLength;
 
+        //! Max packs retained in the cross-document VocabPack cache. A pack at
+        //! primary lengths can reach ~WS_BUFFER_CAPACITY particles (float4 each)
+        //! plus entry strings, so this bounds the cache to low hundreds of MB.
+        static constexpr AZ::u32 VP_CACHE_MAX_PACKS = 48;
+
+        // Persistent VocabPack cache, surviving across Resolve() calls.
+        // ResetWindowToStart clears m_vocabByLength per document, but consecutive
+        // documents of the same corpus replay identical warm-set batches with
+        // heavily overlapping first-char filters — so packs built for document N
+        // are usually byte-identical for document N+1. Keyed by envelope id +
+        // word length + the cursors that determine the source bucket + slice
+        // offset + a hash of the filtered index list (see AcquireVocabPack).
+        // LRU-evicted at VP_CACHE_MAX_PACKS; cleared whenever the hot window
+        // moves (RebuildVocab). shared_ptr values keep in-flight packs alive if
+        // another worker's insert evicts them mid-cascade. Off AZ pool.
+        struct CachedPack
+        {
+            std::shared_ptr<const VocabPack> pack;
+            AZ::u64 lastUse = 0;
+        };
+        std::unordered_map<std::string, CachedPack> m_packCache;
+        std::mutex m_packCacheMutex;
+        AZ::u64 m_packCacheTick   = 0;
+        AZ::u32 m_packCacheHits   = 0;
+        AZ::u32 m_packCacheMisses = 0;
+
+        // Batch mode (ResolveBatch). While active, Resolve skips the per-document
+        // targeted bucket load, and ResetWindowToStart reinstalls the batch-0
+        // bucket snapshot instead of clearing — every document restarts from the
+        // same highest-priority entries without touching Postgres.
+        bool m_batchActive = false;
+        std::unordered_map<AZ::u32, std::vector<VocabPack::Entry>> m_firstBatchByLength;
+
+        // Bump arena backing the sequential scratch of Resolve() — classification
+        // lists, broadphase candidate sets, dep-resolution leftovers. Reset
+        // wholesale at the top of each Resolve (blocks retained, so steady-state
+        // batch ingest does no scratch mallocs); released at Shutdown. Never
+        // touched from the worker pool. The manifest itself stays on the normal
+        // heap — it outlives the call.
+        ResolveArena m_resolveArena;
+
         // Envelope sliding window state.
         // LMDB hot cache holds [m_sliceCursor, m_sliceCursor + 3*LMDB_SLICE_SIZE) of warm set.
         int m_envelopeId   = 0;
         int m_sliceCursor  = 0;
         int m_warmSetSize  = 0;
 
+        // Feeder-lane slice transitions. m_vocabMirrorsHotWindow is true only
+        // while m_vocabByLength was built from (and incrementally tracks) the
+        // LMDB hot window — the splice fast path is valid exactly then. Every
+        // other writer of m_vocabByLength (warm batches, phases, bed file,
+        // per-document reset) clears it, sending the next advance through the
+        // full RebuildVocab rescan instead.
+        bool m_vocabMirrorsHotWindow = false;
+        bool m_advancePrimed         = false;  // a transition is queued on the lane
+        int  m_primedFeedStart       = 0;      // feed offset it will populate
+
         // Per-length batch cursors for QueryWarmBatch (offset per word length).
         // Reset at the start of each Resolve() call. Updated as multi-slice loop advances.
         std::unordered_map<AZ::u32, int> m_lengthCursorByLen;
 
+        // ---- Adaptive slice sizing ----
+        //
+        // A fixed LMDB_SLICE_SIZE batch loads far more vocab than a short
+        // document can touch (most loaded entries never match). Resolve()
+        // records the document's unique-run histogram per length; SliceBudget
+        // scales each length's warm batch to (runs x entries-per-match),
+        // clamped to [MIN_SLICE_SIZE, LMDB_SLICE_SIZE]. The entries-per-match
+        // factor starts at a frequency-ordered-vocab default and is refined
+        // per envelope from prior documents (EWMA recorded at the end of each
+        // length cycle), so a corpus of dense documents drifts back toward
+        // full slices while light corpora stay small. HCP_ADAPTIVE_SLICE=0
+        // restores fixed LMDB_SLICE_SIZE batches.
+        std::unordered_map<AZ::u32, AZ::u32> m_runCountByLength;  // this document
+        std::unordered_map<AZ::u32, float> m_entriesPerMatch;     // per envelope, EWMA
+
+        //! Warm-batch size for one word length. Call under m_envelopeMutex
+        //! when workers are live (reads the maps above).
+        int SliceBudget(AZ::u32 wordLength) const;
+
+        //! Fold one length cycle's outcome (entries loaded vs runs matched)
+        //! into the per-envelope entries-per-match estimate. Takes the lock.
+        void RecordSliceFeedback(AZ::u32 wordLength, AZ::u32 matchedRuns);
+
         //! Reset per-resolve state: clear phase cursor, per-length cursors, and vocab.
         //! Each new document starts from the highest-priority phase.
         void ResetWindowToStart();
@@ -463,10 +836,26 @@ namespace HCPEngine
         //! Returns true if entries were loaded, false if warm set exhausted.
         bool AdvancePhase();
 
-        //! Evict oldest slot, feed next slot, rebuild in-memory vocab.
+        //! Evict oldest slot, feed next slot, refresh the in-memory vocab.
+        //! When the feeder lane pre-ran the transition (PrimeNextSliceAdvance),
+        //! the refresh is an in-memory splice of the lane-captured rows; only
+        //! the fallback pays the Postgres round trips and hot-window rescan.
         //! (Legacy global cursor — kept for envelope changes. Not used in resolution loop.)
         bool AdvanceEnvelopeSlice();
 
+        //! Queue the next slice transition on the envelope manager's feeder
+        //! lane — Postgres fetches and LMDB writes run off the foreground, so
+        //! the following AdvanceEnvelopeSlice splices instead of stalling.
+        //! Evicting the outgoing slot retires it from w2t one transition early;
+        //! the in-memory index keeps serving it until the advance lands, so
+        //! resolution sees the same availability as the synchronous path.
+        void PrimeNextSliceAdvance();
+
+        //! Apply a lane-completed transition to m_vocabByLength: drop the
+        //! evicted slot's words, append the fed slot's entries. Equivalent to
+        //! the RebuildVocab rescan while the index mirrors the hot window.
+        void SpliceVocabForAdvance(const SliceAdvance& adv);
+
         //! Check possessive forms against current vocab. Integrated into resolution passes.
         //! For runs ending in 's or s': try existing possessive → if miss, strip and
         //! submit base to current pass. Generates MintRecommendations for unminted forms.
@@ -477,6 +866,26 @@ namespace HCPEngine
             AZStd::vector<AZ::u32>& baseSubmissions,
             AZStd::vector<MintRecommendation>& recommendations);
 
+        // ---- Resolve scratch pools ----
+        //
+        // RunPipelinedCascade and ResolvePhase churned fresh index/result
+        // vectors every phase — steady allocator pressure across the hundreds
+        // of phases of a large document. These freelists recycle the vectors
+        // instead (clear-don't-free: capacity survives the round trip), so
+        // steady-state resolve stops allocating once the pools are warm.
+        // Shared across resolve workers — acquire/release is a vector move
+        // under a short lock. Pools are bounded; releases past the cap just
+        // drop the buffer.
+        AZStd::vector<AZ::u32> AcquireIndexScratch();
+        void ReleaseIndexScratch(AZStd::vector<AZ::u32>&& v);
+        AZStd::vector<ResolutionResult> AcquireResultScratch();
+        void ReleaseResultScratch(AZStd::vector<ResolutionResult>&& v);
+
+        static constexpr size_t SCRATCH_POOL_MAX = 64;
+        std::mutex m_scratchMutex;
+        AZStd::vector<AZStd::vector<AZ::u32>> m_indexScratchPool;
+        AZStd::vector<AZStd::vector<ResolutionResult>> m_resultScratchPool;
+
         // Phase cursor for global priority-ordered warm set traversal.
         // Reset at start of each Resolve(). Advances by child-envelope-sized batches.
         int m_phaseCursor = 0;
@@ -4,11 +4,193 @@
 #include <AzCore/Console/ILogger.h>
 #include <AzCore/std/sort.h>
 #include <libpq-fe.h>
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 namespace HCPEngine
 {
+    // ---- W2tIndex: flat open-addressing hash over the w2t sub-db ----
+
+    AZ::u64 W2tIndex::Hash(const char* s, size_t n)
+    {
+        // FNV-1a 64
+        AZ::u64 h = 1469598103934665603ull;
+        for (size_t i = 0; i < n; ++i)
+        {
+            h ^= static_cast<unsigned char>(s[i]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    void W2tIndex::Clear()
+    {
+        m_slots.clear();
+        m_arena.clear();
+        m_size = 0;
+    }
+
+    void W2tIndex::Reserve(size_t entryCount)
+    {
+        size_t capacity = 1024;
+        while (entryCount * 10 >= capacity * 7) capacity <<= 1;
+        m_slots.assign(capacity, Slot());
+    }
+
+    void W2tIndex::Grow()
+    {
+        AZStd::vector<Slot> old;
+        old.swap(m_slots);
+        m_slots.assign(old.size() * 2, Slot());
+
+        const size_t mask = m_slots.size() - 1;
+        for (const Slot& s : old)
+        {
+            if (!s.used) continue;
+            size_t i = Hash(m_arena.data() + s.wordOff, s.wordLen) & mask;
+            while (m_slots[i].used) i = (i + 1) & mask;
+            m_slots[i] = s;
+        }
+    }
+
+    void W2tIndex::Insert(const char* word, size_t wordLen, const char* val, size_t valLen)
+    {
+        if (wordLen == 0 || wordLen > 0xFFFF || valLen > 0xFFFF) return;
+        if (m_slots.empty()) Reserve(0);
+        if ((m_size + 1) * 10 >= m_slots.size() * 7) Grow();
+
+        const size_t mask = m_slots.size() - 1;
+        size_t i = Hash(word, wordLen) & mask;
+        while (m_slots[i].used)
+        {
+            const Slot& s = m_slots[i];
+            if (s.wordLen == wordLen &&
+                memcmp(m_arena.data() + s.wordOff, word, wordLen) == 0)
+            {
+                // Overwrite: append the new value; the old bytes stay as waste.
+                m_slots[i].valOff = static_cast<AZ::u32>(m_arena.size());
+                m_slots[i].valLen = static_cast<AZ::u16>(valLen);
+                m_arena.insert(m_arena.end(), val, val + valLen);
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+
+        Slot s;
+        s.wordOff = static_cast<AZ::u32>(m_arena.size());
+        s.wordLen = static_cast<AZ::u16>(wordLen);
+        m_arena.insert(m_arena.end(), word, word + wordLen);
+        s.valOff = static_cast<AZ::u32>(m_arena.size());
+        s.valLen = static_cast<AZ::u16>(valLen);
+        m_arena.insert(m_arena.end(), val, val + valLen);
+        s.used = true;
+        m_slots[i] = s;
+        ++m_size;
+    }
+
+    bool W2tIndex::Find(const char* word, size_t wordLen, AZStd::string& out) const
+    {
+        if (m_slots.empty() || wordLen == 0 || wordLen > 0xFFFF) return false;
+
+        const size_t mask = m_slots.size() - 1;
+        size_t i = Hash(word, wordLen) & mask;
+        while (m_slots[i].used)
+        {
+            const Slot& s = m_slots[i];
+            if (s.wordLen == wordLen &&
+                memcmp(m_arena.data() + s.wordOff, word, wordLen) == 0)
+            {
+                out.assign(m_arena.data() + s.valOff, s.valLen);
+                return true;
+            }
+            i = (i + 1) & mask;
+        }
+        return false;
+    }
+
+    // ---- WordWalkTrie: compiled matcher for the greedy word walk ----
+
+    void WordWalkTrie::Clear()
+    {
+        m_nodes.clear();
+        m_edgeChars.clear();
+        m_edgeTargets.clear();
+        m_wordCount = 0;
+    }
+
+    void WordWalkTrie::Build(AZStd::vector<AZStd::string>& words)
+    {
+        Clear();
+        if (words.empty()) return;
+
+        AZStd::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        m_wordCount = words.size();
+
+        // Breadth-first over sorted ranges: each queued item is the word range
+        // [lo, hi) sharing a prefix of the given depth, i.e. one trie node.
+        // Children of a popped node group the range by the byte at depth, so
+        // its edges land contiguously — no pointer trie, no second pass.
+        struct Pending
+        {
+            AZ::u32 lo, hi, depth, node;
+        };
+        AZStd::vector<Pending> queue;
+        m_nodes.push_back({});
+        queue.push_back({0, static_cast<AZ::u32>(words.size()), 0, 0});
+
+        for (size_t head = 0; head < queue.size(); ++head)
+        {
+            Pending p = queue[head];
+            AZ::u32 lo = p.lo;
+
+            if (words[lo].size() == p.depth)
+            {
+                m_nodes[p.node].terminal = true;
+                ++lo;                       // de-duped: only words[lo] can end here
+            }
+
+            m_nodes[p.node].firstEdge = static_cast<AZ::u32>(m_edgeChars.size());
+            while (lo < p.hi)
+            {
+                const char c = words[lo][p.depth];
+                AZ::u32 groupEnd = lo + 1;
+                while (groupEnd < p.hi && words[groupEnd][p.depth] == c)
+                    ++groupEnd;
+
+                const AZ::u32 child = static_cast<AZ::u32>(m_nodes.size());
+                m_edgeChars.push_back(c);
+                m_edgeTargets.push_back(child);
+                ++m_nodes[p.node].edgeCount;
+                m_nodes.push_back({});
+                queue.push_back({lo, groupEnd, p.depth + 1, child});
+                lo = groupEnd;
+            }
+        }
+    }
+
+    void WordWalkTrie::MatchPrefixes(const char* s, size_t n,
+                                     AZStd::vector<AZ::u32>& outLens) const
+    {
+        if (m_nodes.empty()) return;
+
+        AZ::u32 node = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Node& cur = m_nodes[node];
+            const char* lo = m_edgeChars.data() + cur.firstEdge;
+            const char* hi = lo + cur.edgeCount;
+            const char* hit = std::lower_bound(lo, hi, s[i]);
+            if (hit == hi || *hit != s[i]) return;
+            node = m_edgeTargets[cur.firstEdge + (hit - lo)];
+            if (m_nodes[node].terminal)
+                outLens.push_back(static_cast<AZ::u32>(i + 1));
+        }
+    }
+
     HCPVocabulary::~HCPVocabulary()
     {
         if (m_env)
@@ -22,6 +204,16 @@ namespace HCPEngine
     {
         int rc;
 
+        // Multi-process reader mode (HCP_LMDB_READONLY=1): open the environment
+        // MDB_RDONLY so N resolver daemons share ONE mmap'd copy of the store —
+        // the writer daemon owns activation and slice feeding. The lock file is
+        // kept (no MDB_NOLOCK): readers register in the reader table so the
+        // writer cannot reclaim pages out from under a live snapshot.
+        {
+            const char* ro = std::getenv("HCP_LMDB_READONLY");
+            m_readOnly = (ro && ro[0] != '\0' && ro[0] != '0');
+        }
+
         rc = mdb_env_create(&m_env);
         if (rc != 0)
         {
@@ -32,7 +224,7 @@ namespace HCPEngine
         mdb_env_set_maxdbs(m_env, 48);  // 6 core + 30 vbed + 1 manifest + 4 entity + headroom
         mdb_env_set_mapsize(m_env, 1ULL * 1024 * 1024 * 1024); // 1 GB virtual
 
-        rc = mdb_env_open(m_env, lmdbPath, 0, 0644);
+        rc = mdb_env_open(m_env, lmdbPath, m_readOnly ? MDB_RDONLY : 0, 0644);
         if (rc != 0)
         {
             fprintf(stderr, "[HCPVocabulary] mdb_env_open(%s): %s\n", lmdbPath, mdb_strerror(rc));
@@ -41,9 +233,11 @@ namespace HCPEngine
             return false;
         }
 
-        // Open named sub-databases — write txn so DBI handles persist
+        // Open named sub-databases — committed txn so DBI handles persist.
+        // Readers must not (and cannot) create sub-dbs: they attach to the
+        // writer-initialized store, so a missing core sub-db is a hard error.
         MDB_txn* txn;
-        rc = mdb_txn_begin(m_env, nullptr, 0, &txn);
+        rc = mdb_txn_begin(m_env, nullptr, m_readOnly ? MDB_RDONLY : 0, &txn);
         if (rc != 0)
         {
             fprintf(stderr, "[HCPVocabulary] mdb_txn_begin: %s\n", mdb_strerror(rc));
@@ -54,7 +248,7 @@ namespace HCPEngine
 
         auto openDb = [&](const char* name, MDB_dbi* dbi) -> bool
         {
-            int r = mdb_dbi_open(txn, name, MDB_CREATE, dbi);
+            int r = mdb_dbi_open(txn, name, m_readOnly ? 0 : MDB_CREATE, dbi);
             if (r != 0)
             {
                 fprintf(stderr, "[HCPVocabulary] mdb_dbi_open(%s): %s\n", name, mdb_strerror(r));
@@ -91,12 +285,214 @@ namespace HCPEngine
 
         m_loaded = true;
 
-        fprintf(stderr, "[HCPVocabulary] LMDB ready — %zu words, %zu labels, %zu chars\n",
+        fprintf(stderr, "[HCPVocabulary] LMDB ready%s — %zu words, %zu labels, %zu chars\n",
+            m_readOnly ? " (reader mode, HCP_LMDB_READONLY)" : "",
             m_wordCount, m_labelCount, m_charCount);
 
+        BuildWordIndex();
+
         return true;
     }
 
+    void HCPVocabulary::BuildWordIndex()
+    {
+        if (!m_loaded) return;
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+
+        MDB_txn* txn;
+        if (mdb_txn_begin(m_env, nullptr, MDB_RDONLY, &txn) != 0) return;
+
+        MDB_stat stat;
+        mdb_stat(txn, m_w2t, &stat);
+
+        MDB_cursor* cursor = nullptr;
+        if (mdb_cursor_open(txn, m_w2t, &cursor) != 0)
+        {
+            mdb_txn_abort(txn);
+            return;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_wordIndexMutex);
+        m_wordIndex.Clear();
+        m_wordIndex.Reserve(stat.ms_entries);
+
+        // Purely alphabetic lowercase words feed the greedy-walk trie — the
+        // only shapes the missing-space split can produce.
+        AZStd::vector<AZStd::string> walkWords;
+        walkWords.reserve(stat.ms_entries);
+
+        MDB_val key, val;
+        while (mdb_cursor_get(cursor, &key, &val, MDB_NEXT) == 0)
+        {
+            m_wordIndex.Insert(
+                static_cast<const char*>(key.mv_data), key.mv_size,
+                static_cast<const char*>(val.mv_data), val.mv_size);
+
+            const char* word = static_cast<const char*>(key.mv_data);
+            bool alpha = key.mv_size > 0;
+            for (size_t i = 0; alpha && i < key.mv_size; ++i)
+                alpha = (word[i] >= 'a' && word[i] <= 'z');
+            if (alpha)
+                walkWords.push_back(AZStd::string(word, key.mv_size));
+        }
+        mdb_cursor_close(cursor);
+        mdb_txn_abort(txn);
+
+        m_walkTrie.Build(walkWords);
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        fprintf(stderr, "[HCPVocabulary] w2t flat index rebuilt: %zu entries in %.1f ms "
+            "(walk trie: %zu words, %zu nodes)\n",
+            m_wordIndex.Size(), ms, m_walkTrie.WordCount(), m_walkTrie.NodeCount());
+        fflush(stderr);
+
+        // w2t contents changed — invalidate both word-cache tiers. The shards
+        // clear themselves lazily (under their own lock) when they first see
+        // the new generation; per-thread tables reset on their next probe.
+        m_wordCacheGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    bool HCPVocabulary::FindIndexed(const char* word, size_t wordLen, AZStd::string& out) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_wordIndexMutex);
+        return m_wordIndex.Ready() && m_wordIndex.Find(word, wordLen, out);
+    }
+
+    bool HCPVocabulary::MatchWordPrefixes(const char* text, size_t len,
+                                          AZStd::vector<AZ::u32>& outLens) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_wordIndexMutex);
+        if (!m_walkTrie.Ready()) return false;
+        m_walkTrie.MatchPrefixes(text, len, outLens);
+        return true;
+    }
+
+    // ---- Two-tier word lookup cache ----
+    //
+    // Natural text is Zipfian: the same few thousand chunks dominate the
+    // tokenize path, so even the flat index's shared-lock probe (and the LMDB
+    // fall-through on misses) repeats the same work millions of times per
+    // corpus. Tier 1 answers those on-thread with no lock at all; tier 2 keeps
+    // the shared working set (hits AND misses) away from LMDB entirely.
+
+    namespace
+    {
+        // FNV-1a 64 (same function W2tIndex uses; that one is private to it).
+        AZ::u64 WordCacheHash(const char* s, size_t n)
+        {
+            AZ::u64 h = 1469598103934665603ull;
+            for (size_t i = 0; i < n; ++i)
+            {
+                h ^= static_cast<unsigned char>(s[i]);
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        // Tier 1: per-thread direct-mapped table. The owner pointer is checked
+        // so a second HCPVocabulary instance can never read another's entries.
+        struct TlsWordSlot
+        {
+            AZStd::string word;
+            AZStd::string tokenId;   // empty = cached miss
+            bool known = false;
+        };
+        struct TlsWordCache
+        {
+            static constexpr size_t SLOT_COUNT = 1024;   // power of two
+            const void* owner = nullptr;
+            AZ::u32 generation = 0;
+            AZStd::vector<TlsWordSlot> slots;
+        };
+        thread_local TlsWordCache t_wordCache;
+    }
+
+    bool HCPVocabulary::CacheProbe(const AZStd::string& word, AZStd::string& out) const
+    {
+        const AZ::u32 generation = m_wordCacheGeneration.load(std::memory_order_acquire);
+        const AZ::u64 hash = WordCacheHash(word.c_str(), word.size());
+
+        // Tier 1 — lock-free on this thread.
+        TlsWordCache& tls = t_wordCache;
+        if (tls.owner != this || tls.generation != generation)
+        {
+            tls.owner = this;
+            tls.generation = generation;
+            tls.slots.clear();
+            tls.slots.resize(TlsWordCache::SLOT_COUNT);
+        }
+        TlsWordSlot& slot = tls.slots[hash & (TlsWordCache::SLOT_COUNT - 1)];
+        if (slot.known && slot.word == word)
+        {
+            out = slot.tokenId;
+            return true;
+        }
+
+        // Tier 2 — sharded LRU shared by all worker threads.
+        WordCacheShard& shard = m_wordCache[hash % WORD_CACHE_SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.generation != generation)
+        {
+            shard.map.clear();
+            shard.generation = generation;
+            return false;
+        }
+        auto it = shard.map.find(word);
+        if (it == shard.map.end())
+            return false;
+        it->second.lastUse = ++shard.tick;
+        out = it->second.tokenId;
+
+        // Promote so the next probe on this thread stays lock-free.
+        slot.word    = word;
+        slot.tokenId = out;
+        slot.known   = true;
+        return true;
+    }
+
+    void HCPVocabulary::CacheWord(const AZStd::string& word, const AZStd::string& tokenId) const
+    {
+        const AZ::u32 generation = m_wordCacheGeneration.load(std::memory_order_acquire);
+        const AZ::u64 hash = WordCacheHash(word.c_str(), word.size());
+
+        TlsWordCache& tls = t_wordCache;
+        if (tls.owner == this && tls.generation == generation && !tls.slots.empty())
+        {
+            TlsWordSlot& slot = tls.slots[hash & (TlsWordCache::SLOT_COUNT - 1)];
+            slot.word    = word;
+            slot.tokenId = tokenId;
+            slot.known   = true;
+        }
+
+        WordCacheShard& shard = m_wordCache[hash % WORD_CACHE_SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.generation != generation)
+        {
+            shard.map.clear();
+            shard.generation = generation;
+        }
+        WordCacheEntry& entry = shard.map[word];
+        entry.tokenId = tokenId;
+        entry.lastUse = ++shard.tick;
+
+        // Capacity eviction: every entry untouched for the shard's last CAP/2
+        // accesses goes, so at most CAP/2 survive. One pass, rare once warm —
+        // only insert-misses grow the map.
+        if (shard.map.size() > WORD_CACHE_SHARD_CAP)
+        {
+            const AZ::u64 cutoff = shard.tick - WORD_CACHE_SHARD_CAP / 2;
+            for (auto evictIt = shard.map.begin(); evictIt != shard.map.end(); )
+            {
+                if (evictIt->second.lastUse < cutoff)
+                    evictIt = shard.map.erase(evictIt);
+                else
+                    ++evictIt;
+            }
+        }
+    }
+
     void HCPVocabulary::SetResolver(CacheMissResolver* resolver)
     {
         m_resolver = resolver;
@@ -190,7 +586,14 @@ namespace HCPEngine
                 lower[i] = static_cast<char>(std::tolower(uc));
         }
 
-        result.tokenId = LmdbGet(m_w2t, lower.c_str(), lower.size());
+        // Cache tiers first (lock-free on a tier-1 hit), then the flat index,
+        // then LMDB. Misses are cached too — see CacheProbe.
+        if (!CacheProbe(lower, result.tokenId))
+        {
+            if (!FindIndexed(lower.c_str(), lower.size(), result.tokenId))
+                result.tokenId = LmdbGet(m_w2t, lower.c_str(), lower.size());
+            CacheWord(lower, result.tokenId);
+        }
 
         // Single character fallback (converts to 4-byte codepoint key)
         if (result.tokenId.empty() && chunk.size() == 1)
@@ -243,26 +646,45 @@ namespace HCPEngine
     AZStd::string HCPVocabulary::LookupWord(const AZStd::string& wordForm) const
     {
         if (!m_loaded) return {};
-        return LmdbGet(m_w2t, wordForm.c_str(), wordForm.size());
+        AZStd::string cached;
+        if (CacheProbe(wordForm, cached))
+            return cached;
+        AZStd::string result;
+        if (!FindIndexed(wordForm.c_str(), wordForm.size(), result))
+            result = LmdbGet(m_w2t, wordForm.c_str(), wordForm.size());
+        // A cached miss also pins the resolver outcome: an unresolvable word
+        // stops re-querying Postgres on every occurrence this generation.
+        CacheWord(wordForm, result);
+        return result;
     }
 
     AZStd::string HCPVocabulary::LookupWordLocal(const AZStd::string& wordForm) const
     {
         if (!m_loaded) return {};
 
-        MDB_txn* txn;
-        int rc = mdb_txn_begin(m_env, nullptr, MDB_RDONLY, &txn);
-        if (rc != 0) return {};
+        AZStd::string cached;
+        if (CacheProbe(wordForm, cached))
+            return cached;
 
-        MDB_val k, v;
-        k.mv_data = const_cast<char*>(wordForm.c_str());
-        k.mv_size = wordForm.size();
-
-        rc = mdb_get(txn, m_w2t, &k, &v);
         AZStd::string result;
-        if (rc == 0)
-            result.assign(static_cast<const char*>(v.mv_data), v.mv_size);
-        mdb_txn_abort(txn);
+        if (!FindIndexed(wordForm.c_str(), wordForm.size(), result))
+        {
+            MDB_txn* txn;
+            int rc = mdb_txn_begin(m_env, nullptr, MDB_RDONLY, &txn);
+            if (rc != 0) return {};
+
+            MDB_val k, v;
+            k.mv_data = const_cast<char*>(wordForm.c_str());
+            k.mv_size = wordForm.size();
+
+            rc = mdb_get(txn, m_w2t, &k, &v);
+            if (rc == 0)
+                result.assign(static_cast<const char*>(v.mv_data), v.mv_size);
+            mdb_txn_abort(txn);
+        }
+        // Affix stem checks miss constantly and repeatedly — caching the
+        // misses is most of the win here.
+        CacheWord(wordForm, result);
         return result;
     }
 
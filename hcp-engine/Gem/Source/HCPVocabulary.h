@@ -6,6 +6,10 @@
 #include <AzCore/std/function/function_template.h>
 #include <lmdb.h>
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
 // Forward declarations
 namespace HCPEngine { class CacheMissResolver; }
 typedef struct pg_conn PGconn;
@@ -52,6 +56,86 @@ namespace HCPEngine
         bool IsComplete() const { return status == Complete; }
     };
 
+    //! Flat open-addressing index over the w2t sub-db — words and token values
+    //! copied into a string arena, slots probed linearly from an FNV-1a hash.
+    //! A hit answers in one probe chain with no LMDB read transaction; a miss
+    //! falls through to LMDB, so entries written after the last rebuild are
+    //! still found. The index is an accelerator, never an authority.
+    class W2tIndex
+    {
+    public:
+        //! Drop all slots and arena contents.
+        void Clear();
+
+        //! Size the table for an expected entry count (0.7 load factor).
+        void Reserve(size_t entryCount);
+
+        //! Insert or overwrite a word → value mapping. Value bytes are stored
+        //! verbatim (including the extended token_id + '\x00' + morpheme form).
+        void Insert(const char* word, size_t wordLen, const char* val, size_t valLen);
+
+        //! Look up a word; on hit, copies the stored value into out.
+        bool Find(const char* word, size_t wordLen, AZStd::string& out) const;
+
+        bool Ready() const { return !m_slots.empty(); }
+        size_t Size() const { return m_size; }
+
+    private:
+        struct Slot
+        {
+            AZ::u32 wordOff = 0;
+            AZ::u32 valOff  = 0;
+            AZ::u16 wordLen = 0;
+            AZ::u16 valLen  = 0;
+            bool    used    = false;
+        };
+
+        static AZ::u64 Hash(const char* s, size_t n);
+        void Grow();
+
+        AZStd::vector<Slot> m_slots;   // Power-of-two capacity
+        AZStd::vector<char> m_arena;   // Word + value bytes, offset-addressed
+        size_t m_size = 0;
+    };
+
+    //! Compiled matcher for the greedy word walk (missing-space splitting):
+    //! a flat byte-wise trie over the purely alphabetic lowercase words of the
+    //! active w2t window. One pass over the text at a split point yields EVERY
+    //! prefix that is a vocabulary word — the walk advances by trie transitions
+    //! instead of probing LookupWord once per candidate length.
+    //! Nodes live in one vector, edges in parallel sorted arrays; a transition
+    //! is a binary search over at most 26 edges.
+    class WordWalkTrie
+    {
+    public:
+        //! Drop all nodes and edges.
+        void Clear();
+
+        //! Build from lowercase [a-z] words. Sorts (and de-dupes) in place.
+        void Build(AZStd::vector<AZStd::string>& words);
+
+        //! Append to outLens every l in [1, n] where s[0..l) is a stored word,
+        //! shortest first. Stops at the first byte with no transition.
+        void MatchPrefixes(const char* s, size_t n, AZStd::vector<AZ::u32>& outLens) const;
+
+        bool Ready() const { return !m_nodes.empty(); }
+        size_t WordCount() const { return m_wordCount; }
+        size_t NodeCount() const { return m_nodes.size(); }
+
+    private:
+        struct Node
+        {
+            AZ::u32 firstEdge = 0;
+            AZ::u16 edgeCount = 0;
+            bool    terminal  = false;
+        };
+
+        AZStd::vector<Node>    m_nodes;
+        AZStd::vector<char>    m_edgeChars;     // parallel to m_edgeTargets,
+        AZStd::vector<AZ::u32> m_edgeTargets;   // sorted per node
+        size_t m_wordCount = 0;
+    };
+
     //! Vocabulary reader — zero-copy LMDB lookups with forward walk.
     //!
     //! LMDB is not pre-populated. It fills from Postgres via the cache miss
@@ -97,6 +181,21 @@ namespace HCPEngine
         //! Used by affix stem checks where misses are expected and frequent.
         AZStd::string LookupWordLocal(const AZStd::string& wordForm) const;
 
+        //! Greedy-walk support: append every l where text[0..l) is an active
+        //! vocabulary word (shortest first) via the compiled trie. Returns
+        //! false when the trie is not built — caller falls back to per-length
+        //! LookupWord probing.
+        bool MatchWordPrefixes(const char* text, size_t len,
+                               AZStd::vector<AZ::u32>& outLens) const;
+
+        //! Monotonic generation of the active word index — bumped by
+        //! BuildWordIndex on envelope activation. Read-path caches key their
+        //! validity to this so an envelope change invalidates them.
+        AZ::u32 WordIndexGeneration() const
+        {
+            return m_wordCacheGeneration.load(std::memory_order_acquire);
+        }
+
         //! Look up a single character → token_id (delegates to LookupCodepoint).
         AZStd::string LookupChar(char c) const;
 
@@ -146,6 +245,11 @@ namespace HCPEngine
 
         size_t AffixCount() const { return m_suffixCount + m_prefixCount; }
 
+        //! Rebuild the flat w2t index from the current LMDB contents.
+        //! Called at the end of Load() and after envelope activation replaces
+        //! the w2t window wholesale. Safe against concurrent lookups.
+        void BuildWordIndex();
+
         bool IsLoaded() const { return m_loaded; }
         size_t WordCount() const { return m_wordCount; }
         size_t CharCount() const { return m_charCount; }
@@ -160,16 +264,25 @@ namespace HCPEngine
         //! Get the LMDB env handle (for resolver setup).
         MDB_env* GetLmdbEnv() const { return m_env; }
 
+        //! True when the environment was opened MDB_RDONLY (HCP_LMDB_READONLY=1):
+        //! this daemon is one of N resolvers sharing the writer's store, and all
+        //! LMDB mutation belongs to the writer process.
+        bool IsReadOnly() const { return m_readOnly; }
+
         //! Get a named DBI handle (for resolver setup).
         MDB_dbi GetDbi(const char* name) const;
 
     private:
         AZStd::string LmdbGet(MDB_dbi dbi, const char* key, size_t keyLen) const;
 
+        //! Consult the flat w2t index under a shared lock. False = fall through to LMDB.
+        bool FindIndexed(const char* word, size_t wordLen, AZStd::string& out) const;
+
         //! Map DBI handle back to sub-db name (for resolver routing).
         const char* SubDbName(MDB_dbi dbi) const;
 
         bool m_loaded = false;
+        bool m_readOnly = false;
         size_t m_wordCount = 0;
         size_t m_charCount = 0;
         size_t m_labelCount = 0;
@@ -184,6 +297,44 @@ namespace HCPEngine
         mutable size_t m_debugCount = 0;
         mutable CacheMissResolver* m_resolver = nullptr;  // Cache fill on miss
 
+        // Flat w2t index — shared lock for lookups, exclusive for rebuilds.
+        // The walk trie is built from the same cursor pass and shares the lock.
+        W2tIndex m_wordIndex;
+        WordWalkTrie m_walkTrie;
+        mutable std::shared_mutex m_wordIndexMutex;
+
+        // ---- Two-tier word lookup cache (tokenize hot path) ----
+        //
+        // Tier 1 is a per-thread direct-mapped table (~1K slots, lock-free);
+        // tier 2 is this process-wide sharded LRU. Both cache MISSES as well
+        // as hits — repeated unknown chunks are as Zipfian as vocabulary —
+        // and invalidate by generation whenever BuildWordIndex runs (envelope
+        // activation / hot-window replacement).
+
+        //! Probe both tiers. True = answer known (out empty = cached miss).
+        bool CacheProbe(const AZStd::string& word, AZStd::string& out) const;
+
+        //! Store a result (empty tokenId = known miss) in both tiers.
+        void CacheWord(const AZStd::string& word, const AZStd::string& tokenId) const;
+
+        static constexpr size_t WORD_CACHE_SHARDS    = 16;
+        static constexpr size_t WORD_CACHE_SHARD_CAP = 2048;
+
+        struct WordCacheEntry
+        {
+            AZStd::string tokenId;   // empty = cached miss
+            AZ::u64 lastUse = 0;
+        };
+        struct WordCacheShard
+        {
+            std::mutex mutex;
+            AZStd::unordered_map<AZStd::string, WordCacheEntry> map;
+            AZ::u64 tick = 0;
+            AZ::u32 generation = 0;   // lazily cleared when behind m_wordCacheGeneration
+        };
+        mutable WordCacheShard m_wordCache[WORD_CACHE_SHARDS];
+        mutable std::atomic<AZ::u32> m_wordCacheGeneration{1};
+
         // Affix index: char → bucket of entries (sorted by length desc within bucket)
         AZStd::unordered_map<char, AZStd::vector<AffixEntry>> m_suffixByLastChar;
         AZStd::unordered_map<char, AZStd::vector<AffixEntry>> m_prefixByFirstChar;
@@ -0,0 +1,260 @@
+#pragma once
+// ============================================================================
+// HCP Pack slice — the compiled bed file (mmap'd vocab, zero parse on load).
+//
+// Packs are immutable between envelope compilations, yet the engine was
+// re-reading them entry by entry at every cold start and re-querying slices
+// per resolve. This file format compiles the bed ONCE into the exact shape
+// PackKernel.h's LengthBucket describes — per-length contiguous fixed-stride
+// char blobs — plus the per-length tier table (VBedMeta's boundaries) and a
+// fixed-stride token-id ledger. The reader mmaps the file; every lookup is
+// pointer arithmetic over mapped pages, so cold start is an mmap + header
+// walk and a per-resolve slice is a pointer offset.
+//
+// Layout (all offsets from file start, little-endian, no padding surprises —
+// every section is 8-byte aligned):
+//
+//   BedFileHeader
+//   BedBucketDesc[bucketCount]          (ascending length, like PackWindow)
+//   per bucket, in desc order:
+//     chars  : count * length bytes     (fixed stride = length, claim 444)
+//     ids    : count * tokenIdWidth     (14-byte token ids, fixed stride)
+//     morphs : count * uint16           (pre-compiled morph bits — the name
+//                                        parsing happens at compile time, once)
+//
+// Doctrine unchanged: the GPU-facing LMDB store still carries chars only.
+// This is the CPU-side compiled artifact the ENGINE maps; identity (token
+// ids) stays host-side, reattached by slot, exactly as before — it just no
+// longer takes a cursor walk to get there.
+// ============================================================================
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HCP {
+namespace Pack {
+
+inline constexpr char     BED_FILE_MAGIC[8] = { 'H','C','P','B','E','D','1','\0' };
+inline constexpr uint32_t BED_FILE_VERSION  = 1;
+inline constexpr uint32_t BED_TOKEN_ID_WIDTH = 14;   // engine token-id width
+
+struct BedFileHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t bucketCount;
+    uint32_t entryCount;     // sum over buckets; derived convenience, verified on map
+    uint32_t tokenIdWidth;   // fixed id stride (BED_TOKEN_ID_WIDTH)
+};
+
+struct BedBucketDesc
+{
+    uint32_t length;         // fixed char stride for this bucket
+    uint32_t count;          // entries in this bucket
+    uint32_t labelCount;     // tier 0 boundary (labels first — VBedMeta order)
+    uint32_t tier1End;       // end of freq-ranked entries (<= count)
+    uint64_t charsOffset;    // -> count * length bytes
+    uint64_t idsOffset;      // -> count * tokenIdWidth bytes
+    uint64_t morphOffset;    // -> count * sizeof(uint16_t)
+};
+
+// In-memory bucket handed to the writer. Entry order within a bucket is the
+// priority order (labels, then freq-ranked, then unranked) — slot IS rank.
+struct BedBucket
+{
+    uint32_t              length = 0;
+    uint32_t              labelCount = 0;
+    uint32_t              tier1End = 0;
+    std::string           chars;    // count * length, fixed stride
+    std::string           ids;      // count * BED_TOKEN_ID_WIDTH, fixed stride
+    std::vector<uint16_t> morphs;   // count entries, pre-compiled morph bits
+};
+
+inline uint64_t BedAlign8(uint64_t v) { return (v + 7u) & ~uint64_t(7); }
+
+// Write the compiled bed. Buckets must be ascending by length (PackWindow
+// order); counts are derived from chars.size()/length, never trusted twice.
+inline bool WriteBedFile(const char* path, const std::vector<BedBucket>& buckets)
+{
+    BedFileHeader hdr{};
+    memcpy(hdr.magic, BED_FILE_MAGIC, sizeof(hdr.magic));
+    hdr.version      = BED_FILE_VERSION;
+    hdr.bucketCount  = static_cast<uint32_t>(buckets.size());
+    hdr.tokenIdWidth = BED_TOKEN_ID_WIDTH;
+
+    std::vector<BedBucketDesc> descs(buckets.size());
+    uint64_t off = BedAlign8(sizeof(BedFileHeader) + buckets.size() * sizeof(BedBucketDesc));
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        const BedBucket& b = buckets[i];
+        if (b.length == 0 || b.chars.size() % b.length != 0) return false;
+        const uint32_t count = static_cast<uint32_t>(b.chars.size() / b.length);
+        if (b.ids.size() != static_cast<size_t>(count) * BED_TOKEN_ID_WIDTH) return false;
+        if (b.morphs.size() != count) return false;
+        if (b.labelCount > count || b.tier1End > count) return false;
+
+        BedBucketDesc& d = descs[i];
+        d.length     = b.length;
+        d.count      = count;
+        d.labelCount = b.labelCount;
+        d.tier1End   = b.tier1End;
+        d.charsOffset = off; off = BedAlign8(off + b.chars.size());
+        d.idsOffset   = off; off = BedAlign8(off + b.ids.size());
+        d.morphOffset = off; off = BedAlign8(off + count * sizeof(uint16_t));
+        hdr.entryCount += count;
+    }
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    if (ok && !descs.empty())
+        ok = fwrite(descs.data(), sizeof(BedBucketDesc), descs.size(), f) == descs.size();
+
+    auto padTo = [&](uint64_t target) {
+        long pos = ftell(f);
+        while (ok && pos >= 0 && static_cast<uint64_t>(pos) < target)
+        { ok = fputc(0, f) != EOF; ++pos; }
+    };
+    for (size_t i = 0; ok && i < buckets.size(); ++i)
+    {
+        const BedBucket& b = buckets[i];
+        const BedBucketDesc& d = descs[i];
+        padTo(d.charsOffset);
+        if (ok && !b.chars.empty()) ok = fwrite(b.chars.data(), 1, b.chars.size(), f) == b.chars.size();
+        padTo(d.idsOffset);
+        if (ok && !b.ids.empty())   ok = fwrite(b.ids.data(), 1, b.ids.size(), f) == b.ids.size();
+        padTo(d.morphOffset);
+        if (ok && d.count)
+            ok = fwrite(b.morphs.data(), sizeof(uint16_t), d.count, f) == d.count;
+    }
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+}
+
+// Read side: mmap the file once, then every access is an offset into the
+// mapping. Read-only, shareable between processes, page cache does the rest.
+class BedFileView
+{
+public:
+    // Zero-copy view of one length bucket. All pointers live inside the
+    // mapping and stay valid until Unmap.
+    struct BucketView
+    {
+        uint32_t        length = 0;
+        uint32_t        count = 0;
+        uint32_t        labelCount = 0;
+        uint32_t        tier1End = 0;
+        const char*     chars = nullptr;    // fixed stride = length
+        const char*     ids = nullptr;      // fixed stride = tokenIdWidth
+        const uint16_t* morphs = nullptr;
+
+        const char* Word(uint32_t slot)    const { return chars + static_cast<size_t>(slot) * length; }
+        const char* TokenId(uint32_t slot) const { return ids + static_cast<size_t>(slot) * BED_TOKEN_ID_WIDTH; }
+        uint16_t    Morph(uint32_t slot)   const { return morphs[slot]; }
+    };
+
+    BedFileView() = default;
+    ~BedFileView() { Unmap(); }
+    BedFileView(const BedFileView&) = delete;
+    BedFileView& operator=(const BedFileView&) = delete;
+
+    // Map and validate. Returns false (and stays unmapped) on any structural
+    // problem — short file, bad magic/version, section out of bounds.
+    bool Map(const char* path)
+    {
+        Unmap();
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(BedFileHeader)))
+        { close(fd); return false; }
+
+        void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);   // the mapping holds its own reference
+        if (base == MAP_FAILED) return false;
+
+        m_base = static_cast<const uint8_t*>(base);
+        m_size = static_cast<size_t>(st.st_size);
+
+        const BedFileHeader* hdr = reinterpret_cast<const BedFileHeader*>(m_base);
+        if (memcmp(hdr->magic, BED_FILE_MAGIC, sizeof(hdr->magic)) != 0 ||
+            hdr->version != BED_FILE_VERSION ||
+            hdr->tokenIdWidth != BED_TOKEN_ID_WIDTH ||
+            sizeof(BedFileHeader) + hdr->bucketCount * sizeof(BedBucketDesc) > m_size)
+        { Unmap(); return false; }
+
+        const BedBucketDesc* descs =
+            reinterpret_cast<const BedBucketDesc*>(m_base + sizeof(BedFileHeader));
+        uint32_t entries = 0;
+        for (uint32_t i = 0; i < hdr->bucketCount; ++i)
+        {
+            const BedBucketDesc& d = descs[i];
+            if (d.length == 0 ||
+                d.labelCount > d.count || d.tier1End > d.count ||
+                d.charsOffset + static_cast<uint64_t>(d.count) * d.length > m_size ||
+                d.idsOffset + static_cast<uint64_t>(d.count) * BED_TOKEN_ID_WIDTH > m_size ||
+                d.morphOffset + static_cast<uint64_t>(d.count) * sizeof(uint16_t) > m_size)
+            { Unmap(); return false; }
+            entries += d.count;
+        }
+        if (entries != hdr->entryCount) { Unmap(); return false; }
+
+        m_header = hdr;
+        m_descs = descs;
+        return true;
+    }
+
+    void Unmap()
+    {
+        if (m_base) munmap(const_cast<uint8_t*>(m_base), m_size);
+        m_base = nullptr; m_size = 0;
+        m_header = nullptr; m_descs = nullptr;
+    }
+
+    bool     IsMapped()    const { return m_header != nullptr; }
+    uint32_t BucketCount() const { return m_header ? m_header->bucketCount : 0; }
+    uint32_t EntryCount()  const { return m_header ? m_header->entryCount : 0; }
+
+    BucketView Bucket(uint32_t index) const
+    {
+        BucketView v;
+        if (!m_header || index >= m_header->bucketCount) return v;
+        const BedBucketDesc& d = m_descs[index];
+        v.length     = d.length;
+        v.count      = d.count;
+        v.labelCount = d.labelCount;
+        v.tier1End   = d.tier1End;
+        v.chars  = reinterpret_cast<const char*>(m_base + d.charsOffset);
+        v.ids    = reinterpret_cast<const char*>(m_base + d.idsOffset);
+        v.morphs = reinterpret_cast<const uint16_t*>(m_base + d.morphOffset);
+        return v;
+    }
+
+    // Bucket for a word length (linear scan — bucket counts are tiny).
+    // Returns a view with count == 0 when the length has no bucket.
+    BucketView BucketForLength(uint32_t length) const
+    {
+        for (uint32_t i = 0; m_header && i < m_header->bucketCount; ++i)
+            if (m_descs[i].length == length)
+                return Bucket(i);
+        return BucketView();
+    }
+
+private:
+    const uint8_t*       m_base = nullptr;
+    size_t               m_size = 0;
+    const BedFileHeader* m_header = nullptr;
+    const BedBucketDesc* m_descs = nullptr;
+};
+
+} // namespace Pack
+} // namespace HCP
@@ -0,0 +1,149 @@
+#pragma once
+// ============================================================================
+// HCP Pack slice — host slot matcher (the GPU matcher's CPU stand-in).
+//
+// The GPU settles a query by comparing its chars against every slot of the
+// query-length bucket in parallel. GPU-less deployment targets run this host
+// kernel instead: wide loads over the fixed-stride blob (claim 444 — the
+// arrayed layout is exactly what makes this possible), emitting the same
+// settled-slot bitmap shape the readback path joins by position (606/613).
+//
+// Two paths, one contract:
+//   * MatchSlotsScalar — byte-loop oracle; keeps the wide path honest.
+//   * MatchSlots       — SSE2 16-byte compares for stride >= 16, 64-bit SWAR
+//                        compares below that; scalar only where a wide load
+//                        would run past the end of the blob.
+//
+// Bitmap convention: slot i settled => bit (i & 63) of out[i >> 6]. Both
+// functions return the settled count and size the bitmap to ceil(count/64).
+// ============================================================================
+#include "PackKernel.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace HCP {
+namespace Pack {
+
+// Byte-loop reference. Query length must equal the bucket stride — a pack
+// bucket only ever holds words of its own length, so a length mismatch is a
+// caller error and settles nothing.
+inline uint32_t MatchSlotsScalar(const LengthBucket& b,
+                                 const char* query, size_t queryLen,
+                                 std::vector<uint64_t>& outBitmap)
+{
+    outBitmap.assign((b.count + 63) / 64, 0);
+    if (b.length == 0 || queryLen != b.length) return 0;
+
+    uint32_t settled = 0;
+    for (uint32_t slot = 0; slot < b.count; ++slot)
+    {
+        const char* s = b.blob.data() + static_cast<size_t>(slot) * b.length;
+        if (std::memcmp(s, query, b.length) == 0)
+        {
+            outBitmap[slot >> 6] |= 1ULL << (slot & 63);
+            ++settled;
+        }
+    }
+    return settled;
+}
+
+namespace Detail {
+
+inline uint64_t Load64(const char* p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+// Wide equality for a stride of 8 or more: 8-byte chunks, then one final
+// 8-byte window at [len-8, len) — the overlap re-checks a few bytes instead
+// of falling back to a scalar tail, and never reads outside the slot.
+inline bool EqWide8(const char* s, const char* q, uint32_t len)
+{
+    uint32_t k = 0;
+    for (; k + 8 <= len; k += 8)
+        if (Load64(s + k) != Load64(q + k)) return false;
+    if (k < len)
+        if (Load64(s + len - 8) != Load64(q + len - 8)) return false;
+    return true;
+}
+
+#if defined(__SSE2__)
+// Same shape with 16-byte compares; requires len >= 16.
+inline bool EqWide16(const char* s, const char* q, uint32_t len)
+{
+    uint32_t k = 0;
+    for (; k + 16 <= len; k += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + k));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + k));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF) return false;
+    }
+    if (k < len)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + len - 16));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + len - 16));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF) return false;
+    }
+    return true;
+}
+#endif
+
+} // namespace Detail
+
+// Wide-load slot matcher. Semantically identical to MatchSlotsScalar.
+inline uint32_t MatchSlots(const LengthBucket& b,
+                           const char* query, size_t queryLen,
+                           std::vector<uint64_t>& outBitmap)
+{
+    outBitmap.assign((b.count + 63) / 64, 0);
+    if (b.length == 0 || queryLen != b.length) return 0;
+
+    const char*    blob = b.blob.data();
+    const uint32_t len  = b.length;
+    uint32_t settled = 0;
+    auto settle = [&](uint32_t slot) { outBitmap[slot >> 6] |= 1ULL << (slot & 63); ++settled; };
+
+    if (len >= 8)
+    {
+        // Stride covers a full wide load — every compare stays inside its slot.
+        for (uint32_t slot = 0; slot < b.count; ++slot)
+        {
+            const char* s = blob + static_cast<size_t>(slot) * len;
+#if defined(__SSE2__)
+            const bool eq = (len >= 16) ? Detail::EqWide16(s, query, len)
+                                        : Detail::EqWide8(s, query, len);
+#else
+            const bool eq = Detail::EqWide8(s, query, len);
+#endif
+            if (eq) settle(slot);
+        }
+        return settled;
+    }
+
+    // Short strides (1..7): one masked 8-byte compare per slot. The load reads
+    // past the slot into its neighbour — harmless inside the blob — so the
+    // last few slots, where 8 bytes would overrun the blob itself, go scalar.
+    const uint64_t mask = (1ULL << (8 * len)) - 1;
+    uint64_t q64 = 0;
+    std::memcpy(&q64, query, len);
+
+    uint32_t slot = 0;
+    const size_t blobSize = b.blob.size();
+    for (; slot < b.count && static_cast<size_t>(slot) * len + 8 <= blobSize; ++slot)
+        if (((Detail::Load64(blob + static_cast<size_t>(slot) * len) ^ q64) & mask) == 0)
+            settle(slot);
+    for (; slot < b.count; ++slot)
+        if (std::memcmp(blob + static_cast<size_t>(slot) * len, query, len) == 0)
+            settle(slot);
+    return settled;
+}
+
+} // namespace Pack
+} // namespace HCP
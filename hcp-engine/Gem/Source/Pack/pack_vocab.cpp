@@ -10,9 +10,13 @@
 // Usage: pack_vocab [slice_size|all] [out_path]
 //   slice_size default 20000 (LMDB_SLICE_SIZE, claim 628 bounded window)
 //   out_path   default ./vocab.lmdb.new
+//
+// Also writes <out_path>.bed — the engine's mmap'd compiled bed (BedFile.h):
+// the same buckets in flat-file form, for BedManager's HCP_BED_FILE path.
 // ============================================================================
 #include "PackKernel.h"
 #include "PackStore.h"
+#include "BedFile.h"
 
 #include <libpq-fe.h>
 #include <sys/stat.h>
@@ -103,6 +107,56 @@ int main(int argc, char** argv)
         std::printf("  %u -> \"%s\" : %s\n", cid, CharsForCompactId(rb, cid).c_str(),
                     tokenIds[packed.ledger[cid]].c_str());
 
+    // ---- compiled bed file: the engine-side mmap artifact ----
+    // Same buckets, flat-file form (<out>.bed). BedManager maps this instead of
+    // re-reading entries at cold start / re-querying slices per resolve. Token
+    // ids ride along here (CPU-side artifact — the LMDB store stays chars-only).
+    std::string bedPath = std::string(outPath) + ".bed";
+    {
+        std::vector<BedBucket> beds;
+        for (const auto& b : packed.buckets)
+        {
+            BedBucket bed;
+            bed.length     = b.length;
+            bed.chars      = b.blob;
+            bed.labelCount = 0;          // warm set carries no label tier yet
+            bed.tier1End   = b.count;    // everything is freq-ranked
+            for (uint32_t s = 0; s < b.count; ++s)
+            {
+                const std::string& tid = tokenIds[packed.ledger[b.baseCompactId + s]];
+                char fixed[BED_TOKEN_ID_WIDTH] = {};
+                std::memcpy(fixed, tid.data(),
+                    tid.size() < sizeof(fixed) ? tid.size() : sizeof(fixed));
+                bed.ids.append(fixed, sizeof(fixed));
+                bed.morphs.push_back(0); // morphology lives in the definition (claim 56)
+            }
+            beds.push_back(std::move(bed));
+        }
+
+        std::remove(bedPath.c_str());
+        if (!WriteBedFile(bedPath.c_str(), beds)) { std::printf("FAIL: WriteBedFile\n"); ++fail; }
+
+        BedFileView view;
+        if (!view.Map(bedPath.c_str())) { std::printf("FAIL: bed file does not map back\n"); ++fail; }
+        else
+        {
+            bool bedOk = (view.EntryCount() == packed.count);
+            for (uint32_t cid = 0; bedOk && cid < packed.count; ++cid)
+            {
+                std::string chars = CharsForCompactId(packed, cid);
+                BedFileView::BucketView bv =
+                    view.BucketForLength(static_cast<uint32_t>(chars.size()));
+                bool found = false;
+                for (uint32_t s = 0; s < bv.count && !found; ++s)
+                    if (std::string(bv.Word(s), bv.length) == chars) found = true;
+                if (!found) bedOk = false;
+            }
+            if (!bedOk) { std::printf("FAIL: bed file readback mismatch\n"); ++fail; }
+            else std::printf("bed file:           %u entries mapped OK  ->  %s\n",
+                             view.EntryCount(), bedPath.c_str());
+        }
+    }
+
     std::printf("\n%s (%d failures)  ->  %s\n", fail == 0 ? "OK" : "FAILED", fail, outPath);
     return fail == 0 ? 0 : 1;
 }
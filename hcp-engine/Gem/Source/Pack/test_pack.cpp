@@ -7,9 +7,13 @@
 // ============================================================================
 #include "PackKernel.h"
 #include "PackStore.h"
+#include "PackMatch.h"
+#include "BedFile.h"
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <random>
 #include <string>
 #include <vector>
 #include <set>
@@ -108,6 +112,133 @@ int main()
     std::remove(path.c_str());
     std::remove((path + "-lock").c_str());
 
+    // ---- compiled bed file (BedFile.h): mmap round-trip -------------------
+    // Same buckets, flat-file form: the engine maps this and reads entries by
+    // pointer arithmetic instead of cursor walks.
+    {
+        std::vector<BedBucket> beds;
+        for (const auto& b : packed.buckets)
+        {
+            BedBucket bed;
+            bed.length = b.length;
+            bed.chars  = b.blob;
+            bed.labelCount = 0;
+            bed.tier1End   = b.count;
+            for (uint32_t s = 0; s < b.count; ++s)
+            {
+                // Synthesize fixed-width token ids from the canonical ledger —
+                // same 14-byte stride the engine uses.
+                char id[BED_TOKEN_ID_WIDTH + 1];
+                std::snprintf(id, sizeof(id), "T%013llu",
+                    static_cast<unsigned long long>(packed.ledger[b.baseCompactId + s]));
+                bed.ids.append(id, BED_TOKEN_ID_WIDTH);
+                bed.morphs.push_back(static_cast<uint16_t>(s * 3));
+            }
+            beds.push_back(std::move(bed));
+        }
+
+        std::string bedPath = std::string(std::getenv("TMPDIR") ? std::getenv("TMPDIR") : "/tmp")
+                            + "/hcp_pack_test.bed";
+        std::remove(bedPath.c_str());
+        check(WriteBedFile(bedPath.c_str(), beds), "wrote compiled bed file");
+
+        BedFileView view;
+        check(view.Map(bedPath.c_str()), "mapped compiled bed file");
+        check(view.BucketCount() == beds.size(), "mapped bucket count matches");
+        check(view.EntryCount() == packed.count, "mapped entry count matches window");
+
+        // 10. every slot reads back by pointer arithmetic: chars, id, morph
+        bool bedOk = true;
+        for (size_t bi = 0; bi < beds.size(); ++bi)
+        {
+            BedFileView::BucketView bv = view.BucketForLength(beds[bi].length);
+            if (bv.count * bv.length != beds[bi].chars.size()) { bedOk = false; continue; }
+            for (uint32_t s = 0; s < bv.count; ++s)
+            {
+                if (std::string(bv.Word(s), bv.length)
+                        != beds[bi].chars.substr(static_cast<size_t>(s) * bv.length, bv.length)) bedOk = false;
+                if (std::string(bv.TokenId(s), BED_TOKEN_ID_WIDTH)
+                        != beds[bi].ids.substr(static_cast<size_t>(s) * BED_TOKEN_ID_WIDTH,
+                                               BED_TOKEN_ID_WIDTH)) bedOk = false;
+                if (bv.Morph(s) != beds[bi].morphs[s]) bedOk = false;
+            }
+        }
+        check(bedOk, "mapped slots match written chars/ids/morphs (pointer arithmetic)");
+
+        // 11. tier table survives, absent lengths return an empty view
+        check(view.BucketForLength(beds[0].length).tier1End == beds[0].tier1End,
+              "tier table round-trips");
+        check(view.BucketForLength(99).count == 0, "absent length -> empty bucket view");
+
+        // 12. structural validation: a truncated file refuses to map
+        {
+            FILE* f = fopen(bedPath.c_str(), "rb");
+            std::string bytes;
+            int c;
+            while (f && (c = fgetc(f)) != EOF) bytes.push_back(static_cast<char>(c));
+            if (f) fclose(f);
+            std::string halfPath = bedPath + ".trunc";
+            FILE* h = fopen(halfPath.c_str(), "wb");
+            if (h) { fwrite(bytes.data(), 1, bytes.size() / 2, h); fclose(h); }
+            BedFileView bad;
+            check(!bad.Map(halfPath.c_str()), "truncated bed file refuses to map");
+            std::remove(halfPath.c_str());
+        }
+
+        view.Unmap();
+        std::remove(bedPath.c_str());
+    }
+
+    // ---- host slot matcher (PackMatch.h) ----------------------------------
+    // The GPU stand-in: wide compares over the fixed-stride blob, settled-slot
+    // bitmap joined by position. The scalar loop is the oracle for the wide path.
+    {
+        // 13. each window word settles exactly its own slot in its bucket
+        bool selfOk = true;
+        for (const auto& e : win)
+        {
+            for (const auto& b : packed.buckets)
+            {
+                if (b.length != e.chars.size()) continue;
+                std::vector<uint64_t> bm;
+                uint32_t n = MatchSlots(b, e.chars.data(), e.chars.size(), bm);
+                if (n != 1) { selfOk = false; continue; }
+                uint32_t slot = 0;
+                while (!(bm[slot >> 6] >> (slot & 63) & 1)) ++slot;
+                if (packed.ledger[b.baseCompactId + slot] != e.canonicalId) selfOk = false;
+            }
+        }
+        check(selfOk, "each window word settles exactly its own slot (identity by position)");
+
+        // 14. wide path agrees with the scalar oracle on randomized buckets
+        //     (all stride regimes: SWAR-masked < 8, SWAR 8..15, 16-wide >= 16)
+        std::mt19937 rng(606);
+        bool oracleOk = true;
+        for (int trial = 0; trial < 500 && oracleOk; ++trial)
+        {
+            LengthBucket b;
+            b.length = 1 + rng() % 40;
+            b.count  = rng() % 150;
+            b.blob.resize(static_cast<size_t>(b.length) * b.count);
+            for (auto& c : b.blob) c = static_cast<char>('a' + rng() % 4);
+            std::string q(b.length, 'a');
+            for (auto& c : q) c = static_cast<char>('a' + rng() % 4);
+            if (b.count && (rng() & 1))
+                std::memcpy(&b.blob[static_cast<size_t>(rng() % b.count) * b.length],
+                            q.data(), b.length);
+            std::vector<uint64_t> bmWide, bmRef;
+            uint32_t nWide = MatchSlots(b, q.data(), q.size(), bmWide);
+            uint32_t nRef  = MatchSlotsScalar(b, q.data(), q.size(), bmRef);
+            if (nWide != nRef || bmWide != bmRef) oracleOk = false;
+        }
+        check(oracleOk, "wide matcher agrees with scalar oracle (500 randomized buckets)");
+
+        // 15. a query of the wrong length settles nothing (caller error, not a scan)
+        std::vector<uint64_t> bm;
+        check(MatchSlots(packed.buckets[0], "mismatch", 8, bm) == 0,
+              "wrong-length query settles no slots");
+    }
+
     std::printf("\n%s (%d failures)\n", g_fail == 0 ? "PASS" : "FAILED", g_fail);
     return g_fail == 0 ? 0 : 1;
 }
@@ -0,0 +1,153 @@
+#pragma once
+
+// ============================================================================
+// ReplayCapture.h — serialized settle input state for deterministic replay.
+//
+// Diagnosing a settle regression in production needs the EXACT inputs:
+// particle planes, contact floors, stream slots, the loaded rule pack and
+// every constant feeding the budget. With HCP_REPLAY_DIR set, the engine
+// (Workspace::BeginSimulate, HCPVocabBed.cpp) writes one capture file per
+// simulate batch; replay_settle.cpp re-runs the same batch against the CPU
+// reference kernel and times every phase. A performance bug report is the
+// replay file, not a prose description of the document that triggered it.
+//
+// Like the rest of this directory the format is dependency-free (std only)
+// so the replayer builds standalone — see test_settle.cpp / CMakeLists.txt.
+//
+// Layout (native-endian, sections back to back):
+//
+//   [ReplayHeader]
+//   [float × particleCount]  curX, curY, curZ, curW   (4 planes)
+//   [float × particleCount]  prevX, prevY, prevZ      (3 planes)
+//   [float × particleCount]  restY                    (contact floors)
+//   [ReplaySlot × slotCount]                          (stream runs)
+//   [char × packPatternCount × packCellLength]        (rule-pack bytes,
+//                                                      absent when counts = 0)
+// ============================================================================
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace hcp
+{
+namespace replay
+{
+    constexpr uint32_t MAGIC   = 0x4C505248u;   // "HRPL" little-endian
+    constexpr uint32_t VERSION = 1;
+
+    struct ReplayHeader
+    {
+        uint32_t magic = MAGIC;
+        uint32_t version = VERSION;
+        uint32_t particleCount = 0;
+        uint32_t vocabCount = 0;        // [0, vocabCount) = immovable bed
+        uint32_t slotCount = 0;
+        uint32_t packCellLength = 0;    // 0 = no rule-pack section
+        uint32_t packPatternCount = 0;
+        float    dt = 0.0f;
+        int32_t  steps = 0;             // step budget (cap, not fixed cost)
+        float    velThreshold = 0.0f;   // L1 velocity settle gate
+        float    zScale = 0.0f;         // char lattice Z quantum (RC_Z_SCALE)
+        float    yOffset = 0.0f;        // run drop height (RC_Y_OFFSET)
+    };
+
+    //! One stream run's span in the particle buffer.
+    struct ReplaySlot
+    {
+        uint32_t bufferStart = 0;
+        uint32_t charCount = 0;
+    };
+
+    static_assert(sizeof(ReplayHeader) == 48, "replay header stride");
+    static_assert(sizeof(ReplaySlot) == 8, "replay slot stride");
+
+    //! Whole capture in memory — what Write serializes and Read rebuilds.
+    struct ReplayData
+    {
+        ReplayHeader header;
+        std::vector<float> curX, curY, curZ, curW;
+        std::vector<float> prevX, prevY, prevZ;
+        std::vector<float> restY;
+        std::vector<ReplaySlot> slots;
+        std::vector<char> packChars;    // patternCount × cellLength, \0 = inert
+    };
+
+    //! Capture directory — HCP_REPLAY_DIR; unset (the default) disables capture.
+    inline const char* CaptureDir()
+    {
+        static const char* dir = []() -> const char* {
+            const char* d = std::getenv("HCP_REPLAY_DIR");
+            return (d && d[0]) ? d : nullptr;
+        }();
+        return dir;
+    }
+
+    inline bool CaptureEnabled() { return CaptureDir() != nullptr; }
+
+    inline bool Write(const char* path, const ReplayData& d)
+    {
+        FILE* f = std::fopen(path, "wb");
+        if (!f) return false;
+
+        bool ok = std::fwrite(&d.header, sizeof(d.header), 1, f) == 1;
+        auto plane = [&](const std::vector<float>& v) {
+            if (ok && !v.empty())
+                ok = std::fwrite(v.data(), sizeof(float), v.size(), f) == v.size();
+        };
+        plane(d.curX); plane(d.curY); plane(d.curZ); plane(d.curW);
+        plane(d.prevX); plane(d.prevY); plane(d.prevZ);
+        plane(d.restY);
+        if (ok && !d.slots.empty())
+            ok = std::fwrite(d.slots.data(), sizeof(ReplaySlot), d.slots.size(), f)
+                == d.slots.size();
+        if (ok && !d.packChars.empty())
+            ok = std::fwrite(d.packChars.data(), 1, d.packChars.size(), f)
+                == d.packChars.size();
+
+        std::fclose(f);
+        return ok;
+    }
+
+    inline bool Read(const char* path, ReplayData& d)
+    {
+        FILE* f = std::fopen(path, "rb");
+        if (!f) return false;
+
+        bool ok = std::fread(&d.header, sizeof(d.header), 1, f) == 1
+            && d.header.magic == MAGIC
+            && d.header.version == VERSION;
+
+        const size_t n = d.header.particleCount;
+        auto plane = [&](std::vector<float>& v) {
+            if (!ok) return;
+            v.resize(n);
+            if (n) ok = std::fread(v.data(), sizeof(float), n, f) == n;
+        };
+        plane(d.curX); plane(d.curY); plane(d.curZ); plane(d.curW);
+        plane(d.prevX); plane(d.prevY); plane(d.prevZ);
+        plane(d.restY);
+
+        if (ok)
+        {
+            d.slots.resize(d.header.slotCount);
+            if (d.header.slotCount)
+                ok = std::fread(d.slots.data(), sizeof(ReplaySlot),
+                    d.slots.size(), f) == d.slots.size();
+        }
+        if (ok)
+        {
+            const size_t packBytes =
+                static_cast<size_t>(d.header.packPatternCount) * d.header.packCellLength;
+            d.packChars.resize(packBytes);
+            if (packBytes)
+                ok = std::fread(d.packChars.data(), 1, packBytes, f) == packBytes;
+        }
+
+        std::fclose(f);
+        return ok;
+    }
+
+} // namespace replay
+} // namespace hcp
@@ -39,6 +39,16 @@ namespace hcp::settle
     constexpr float VEL_SETTLE_THRESHOLD   = 0.5f;    // L1 velocity (units/sec)
     constexpr int   SETTLE_STEPS           = 60;      // per-cycle step budget
 
+    // Convergence-aware budget (SettleToConvergence, SettleKernelSimd.h): the
+    // step budget is a CAP, not a fixed cost. MIN_STEPS is the warm-up before
+    // checks run — every particle launches at zero velocity, so an earlier
+    // scan would read a spuriously "converged" scene (free fall needs ~4
+    // steps of gravity to cross the gate). STALL_STEPS is how long the
+    // unsettled count may plateau, once it has decreased at least once,
+    // before the stragglers are declared free-fallers and the phase stops.
+    constexpr int   SETTLE_MIN_STEPS       = 8;
+    constexpr int   SETTLE_STALL_STEPS     = 6;
+
     struct Float4 { float x, y, z, w; };
 
     // A particle's contact floor for slice 1. Broad-phase (which bed particle a
@@ -160,4 +170,125 @@ namespace hcp::settle
             SettleStepOne(cur[i], prev[i], i < restY.size() ? restY[i] : NO_FLOOR);
     }
 
+    // ---- Length-specialized gate kernels -----------------------------------
+    //
+    // charCount is a runtime value in the engine but only spans 2..20 (primary
+    // workspaces cover lengths 2..10, extended 11..20). Templating the per-run
+    // gate on the length makes the per-character trip count a compile-time
+    // constant: the loop unrolls fully and the partial count stays in a
+    // register. Dispatch happens once per phase; lengths outside the table and
+    // runs that clip the buffer end fall back to the runtime-length loops.
+
+    constexpr uint32_t GATE_MIN_WORDLEN = 2;
+    constexpr uint32_t GATE_MAX_WORDLEN = 20;
+
+    template <int WordLen>
+    inline uint32_t CountSettledFixed(const std::vector<Float4>& cur,
+                                      const std::vector<Float4>& prev,
+                                      uint32_t bufferStart)
+    {
+        uint32_t settled = 0;
+        for (int c = 0; c < WordLen; ++c)
+        {
+            const uint32_t idx = bufferStart + static_cast<uint32_t>(c);
+            if (L1Velocity(cur[idx], prev[idx]) < VEL_SETTLE_THRESHOLD)
+                ++settled;
+        }
+        return settled;
+    }
+
+    //! CountSettled with the per-run loop selected by length at the call site.
+    //! Identical result to CountSettled for every run.
+    inline uint32_t CountSettledDispatch(const std::vector<Float4>& cur,
+                                         const std::vector<Float4>& prev,
+                                         const Run& run)
+    {
+        // Clipped runs keep the bounds-checked loop.
+        if (run.bufferStart + run.charCount > cur.size())
+            return CountSettled(cur, prev, run);
+
+        switch (run.charCount)
+        {
+        case 2:  return CountSettledFixed<2>(cur, prev, run.bufferStart);
+        case 3:  return CountSettledFixed<3>(cur, prev, run.bufferStart);
+        case 4:  return CountSettledFixed<4>(cur, prev, run.bufferStart);
+        case 5:  return CountSettledFixed<5>(cur, prev, run.bufferStart);
+        case 6:  return CountSettledFixed<6>(cur, prev, run.bufferStart);
+        case 7:  return CountSettledFixed<7>(cur, prev, run.bufferStart);
+        case 8:  return CountSettledFixed<8>(cur, prev, run.bufferStart);
+        case 9:  return CountSettledFixed<9>(cur, prev, run.bufferStart);
+        case 10: return CountSettledFixed<10>(cur, prev, run.bufferStart);
+        case 11: return CountSettledFixed<11>(cur, prev, run.bufferStart);
+        case 12: return CountSettledFixed<12>(cur, prev, run.bufferStart);
+        case 13: return CountSettledFixed<13>(cur, prev, run.bufferStart);
+        case 14: return CountSettledFixed<14>(cur, prev, run.bufferStart);
+        case 15: return CountSettledFixed<15>(cur, prev, run.bufferStart);
+        case 16: return CountSettledFixed<16>(cur, prev, run.bufferStart);
+        case 17: return CountSettledFixed<17>(cur, prev, run.bufferStart);
+        case 18: return CountSettledFixed<18>(cur, prev, run.bufferStart);
+        case 19: return CountSettledFixed<19>(cur, prev, run.bufferStart);
+        case 20: return CountSettledFixed<20>(cur, prev, run.bufferStart);
+        default: return CountSettled(cur, prev, run);
+        }
+    }
+
+    inline bool RunGateDispatch(const std::vector<Float4>& cur,
+                                const std::vector<Float4>& prev,
+                                const Run& run)
+    {
+        return CountSettledDispatch(cur, prev, run) == run.charCount;
+    }
+
+    // SoA-plane form for hosts that keep velocities as separate X/Y/Z planes
+    // (the engine workspace). Caller guarantees [bufferStart, bufferStart+WordLen)
+    // is in bounds; the dispatcher returns null outside 2..20 so the caller can
+    // keep its clamped runtime loop.
+    template <int WordLen>
+    inline uint32_t CountSettledPlanesFixed(const float* velX, const float* velY,
+                                            const float* velZ, uint32_t bufferStart,
+                                            float threshold)
+    {
+        uint32_t settled = 0;
+        for (int c = 0; c < WordLen; ++c)
+        {
+            const uint32_t i = bufferStart + static_cast<uint32_t>(c);
+            const float vMag = std::fabs(velX[i]) + std::fabs(velY[i]) + std::fabs(velZ[i]);
+            if (vMag < threshold)
+                ++settled;
+        }
+        return settled;
+    }
+
+    using GatePlaneFn = uint32_t (*)(const float*, const float*, const float*,
+                                     uint32_t, float);
+
+    //! Resolve the unrolled plane-gate kernel for a word length, once per
+    //! phase. nullptr outside [GATE_MIN_WORDLEN, GATE_MAX_WORDLEN].
+    inline GatePlaneFn GatePlaneKernelForLength(uint32_t charCount)
+    {
+        switch (charCount)
+        {
+        case 2:  return &CountSettledPlanesFixed<2>;
+        case 3:  return &CountSettledPlanesFixed<3>;
+        case 4:  return &CountSettledPlanesFixed<4>;
+        case 5:  return &CountSettledPlanesFixed<5>;
+        case 6:  return &CountSettledPlanesFixed<6>;
+        case 7:  return &CountSettledPlanesFixed<7>;
+        case 8:  return &CountSettledPlanesFixed<8>;
+        case 9:  return &CountSettledPlanesFixed<9>;
+        case 10: return &CountSettledPlanesFixed<10>;
+        case 11: return &CountSettledPlanesFixed<11>;
+        case 12: return &CountSettledPlanesFixed<12>;
+        case 13: return &CountSettledPlanesFixed<13>;
+        case 14: return &CountSettledPlanesFixed<14>;
+        case 15: return &CountSettledPlanesFixed<15>;
+        case 16: return &CountSettledPlanesFixed<16>;
+        case 17: return &CountSettledPlanesFixed<17>;
+        case 18: return &CountSettledPlanesFixed<18>;
+        case 19: return &CountSettledPlanesFixed<19>;
+        case 20: return &CountSettledPlanesFixed<20>;
+        default: return nullptr;
+        }
+    }
+
 } // namespace hcp::settle
@@ -0,0 +1,554 @@
+// VkSettleBackend.cpp — persistent Vulkan settle backend.
+//
+// Same plumbing as vk_settle_harness.cpp (GLAD multi-context with alias
+// macros, azslc/dxc SPIR-V, binding layout from HCPSettleSrg.azsli), but
+// resources live for the workspace lifetime and are destroyed on teardown:
+// the harness sets up and leaks per run; a backend cannot.
+//
+// Each backend owns its own VkInstance/VkDevice/VkQueue. Workspaces simulate
+// concurrently under the broadphase and worker pools, and vkQueueSubmit
+// requires external synchronization per queue — separate devices sidestep
+// that without a cross-workspace submit lock.
+
+#define GLAD_VULKAN_IMPLEMENTATION
+#include <glad/vulkan.h>
+
+#include "VkSettleBackend.h"
+#include "SettleKernel.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace hcp::settle
+{
+
+// GLAD multi-context mode: function pointers live per context struct. One
+// context per backend (loaded against that backend's instance/device); alias
+// macros keep call sites idiomatic. Member name = vk name minus "vk".
+#define vkCreateInstance                       impl.vk.CreateInstance
+#define vkDestroyInstance                      impl.vk.DestroyInstance
+#define vkEnumeratePhysicalDevices             impl.vk.EnumeratePhysicalDevices
+#define vkGetPhysicalDeviceProperties          impl.vk.GetPhysicalDeviceProperties
+#define vkGetPhysicalDeviceMemoryProperties    impl.vk.GetPhysicalDeviceMemoryProperties
+#define vkGetPhysicalDeviceQueueFamilyProperties impl.vk.GetPhysicalDeviceQueueFamilyProperties
+#define vkCreateDevice                         impl.vk.CreateDevice
+#define vkDestroyDevice                        impl.vk.DestroyDevice
+#define vkDeviceWaitIdle                       impl.vk.DeviceWaitIdle
+#define vkGetDeviceQueue                       impl.vk.GetDeviceQueue
+#define vkCreateBuffer                         impl.vk.CreateBuffer
+#define vkDestroyBuffer                        impl.vk.DestroyBuffer
+#define vkGetBufferMemoryRequirements          impl.vk.GetBufferMemoryRequirements
+#define vkAllocateMemory                       impl.vk.AllocateMemory
+#define vkFreeMemory                           impl.vk.FreeMemory
+#define vkBindBufferMemory                     impl.vk.BindBufferMemory
+#define vkMapMemory                            impl.vk.MapMemory
+#define vkUnmapMemory                          impl.vk.UnmapMemory
+#define vkCreateDescriptorSetLayout            impl.vk.CreateDescriptorSetLayout
+#define vkDestroyDescriptorSetLayout           impl.vk.DestroyDescriptorSetLayout
+#define vkCreatePipelineLayout                 impl.vk.CreatePipelineLayout
+#define vkDestroyPipelineLayout                impl.vk.DestroyPipelineLayout
+#define vkCreateShaderModule                   impl.vk.CreateShaderModule
+#define vkDestroyShaderModule                  impl.vk.DestroyShaderModule
+#define vkCreateComputePipelines               impl.vk.CreateComputePipelines
+#define vkDestroyPipeline                      impl.vk.DestroyPipeline
+#define vkCreateDescriptorPool                 impl.vk.CreateDescriptorPool
+#define vkDestroyDescriptorPool                impl.vk.DestroyDescriptorPool
+#define vkAllocateDescriptorSets               impl.vk.AllocateDescriptorSets
+#define vkUpdateDescriptorSets                 impl.vk.UpdateDescriptorSets
+#define vkCreateCommandPool                    impl.vk.CreateCommandPool
+#define vkDestroyCommandPool                   impl.vk.DestroyCommandPool
+#define vkAllocateCommandBuffers               impl.vk.AllocateCommandBuffers
+#define vkResetCommandBuffer                   impl.vk.ResetCommandBuffer
+#define vkBeginCommandBuffer                   impl.vk.BeginCommandBuffer
+#define vkEndCommandBuffer                     impl.vk.EndCommandBuffer
+#define vkCmdBindPipeline                      impl.vk.CmdBindPipeline
+#define vkCmdBindDescriptorSets                impl.vk.CmdBindDescriptorSets
+#define vkCmdDispatch                          impl.vk.CmdDispatch
+#define vkCmdPipelineBarrier                   impl.vk.CmdPipelineBarrier
+#define vkQueueSubmit                          impl.vk.QueueSubmit
+#define vkCreateFence                          impl.vk.CreateFence
+#define vkDestroyFence                         impl.vk.DestroyFence
+#define vkResetFences                          impl.vk.ResetFences
+#define vkGetFenceStatus                       impl.vk.GetFenceStatus
+#define vkWaitForFences                        impl.vk.WaitForFences
+
+// Matches the cbuffer (b4) member order in HCPSettleSrg.azsli (std140 scalars).
+struct VkParams
+{
+    uint32_t particleCount;
+    float    dt, gravity, damping, friction, velSettleThreshold, noFloor;
+};
+
+struct VkFloat4 { float x, y, z, w; };
+
+struct VkSettleBackend::Impl
+{
+    GladVulkanContext vk{};
+
+    VkInstance       instance = VK_NULL_HANDLE;
+    VkPhysicalDevice phys     = VK_NULL_HANDLE;
+    VkDevice         device   = VK_NULL_HANDLE;
+    VkQueue          queue    = VK_NULL_HANDLE;
+    uint32_t         queueFamily = 0;
+    VkPhysicalDeviceMemoryProperties memProps{};
+    char             deviceName[256] = {};
+
+    VkDescriptorSetLayout dsl    = VK_NULL_HANDLE;
+    VkPipelineLayout      layout = VK_NULL_HANDLE;
+    VkShaderModule        module = VK_NULL_HANDLE;
+    VkPipeline            pipe   = VK_NULL_HANDLE;
+    VkDescriptorPool      dpool  = VK_NULL_HANDLE;
+    VkDescriptorSet       set    = VK_NULL_HANDLE;
+    VkCommandPool         cmdPool = VK_NULL_HANDLE;
+    VkCommandBuffer       cmd    = VK_NULL_HANDLE;
+    VkFence               fence  = VK_NULL_HANDLE;
+
+    struct Buf
+    {
+        VkBuffer       buf = VK_NULL_HANDLE;
+        VkDeviceMemory mem = VK_NULL_HANDLE;
+        void*          mapped = nullptr;
+        VkDeviceSize   size = 0;
+    };
+    Buf posB, prevB, restB, setB, parB;
+
+    bool  inFlight = false;
+    float submittedDt = 1.0f / 60.0f;
+
+    bool FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags want, uint32_t& out) const;
+    bool CreateMappedBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Buf& b);
+    void DestroyBuf(Buf& b);
+};
+
+namespace
+{
+    // One-time failure log: five workspaces probing an idle dev box without a
+    // GPU should say "no device" once, not five times.
+    void LogOnce(const char* reason)
+    {
+        static bool logged = false;
+        if (logged) return;
+        logged = true;
+        std::fprintf(stderr, "[VkSettleBackend] unavailable: %s (host settle path stays)\n", reason);
+        std::fflush(stderr);
+    }
+
+    std::vector<uint32_t> LoadSpirv(const char* path)
+    {
+        std::ifstream f(path, std::ios::binary | std::ios::ate);
+        if (!f) return {};
+        size_t bytes = static_cast<size_t>(f.tellg());
+        f.seekg(0);
+        std::vector<uint32_t> code(bytes / 4);
+        f.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(bytes));
+        return code;
+    }
+}
+
+VkSettleBackend::VkSettleBackend() = default;
+
+bool VkSettleBackend::Impl::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags want,
+                                           uint32_t& out) const
+{
+    for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i)
+        if ((typeBits & (1u << i)) &&
+            (memProps.memoryTypes[i].propertyFlags & want) == want)
+        {
+            out = i;
+            return true;
+        }
+    return false;
+}
+
+bool VkSettleBackend::Impl::CreateMappedBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
+                                               Buf& b)
+{
+    Impl& impl = *this;
+    b.size = size;
+    VkBufferCreateInfo bi{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bi.size = size;
+    bi.usage = usage;
+    bi.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(impl.device, &bi, nullptr, &b.buf) != VK_SUCCESS) return false;
+
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(impl.device, b.buf, &req);
+    uint32_t typeIndex = 0;
+    if (!FindMemoryType(req.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            typeIndex))
+        return false;
+
+    VkMemoryAllocateInfo ai{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    ai.allocationSize = req.size;
+    ai.memoryTypeIndex = typeIndex;
+    if (vkAllocateMemory(impl.device, &ai, nullptr, &b.mem) != VK_SUCCESS) return false;
+    if (vkBindBufferMemory(impl.device, b.buf, b.mem, 0) != VK_SUCCESS) return false;
+    // Persistent mapping: uploads/readbacks become plain memcpys.
+    return vkMapMemory(impl.device, b.mem, 0, VK_WHOLE_SIZE, 0, &b.mapped) == VK_SUCCESS;
+}
+
+void VkSettleBackend::Impl::DestroyBuf(Buf& b)
+{
+    Impl& impl = *this;
+    if (b.mapped) { vkUnmapMemory(impl.device, b.mem); b.mapped = nullptr; }
+    if (b.buf)    { vkDestroyBuffer(impl.device, b.buf, nullptr); b.buf = VK_NULL_HANDLE; }
+    if (b.mem)    { vkFreeMemory(impl.device, b.mem, nullptr); b.mem = VK_NULL_HANDLE; }
+}
+
+std::unique_ptr<VkSettleBackend> VkSettleBackend::TryCreate(uint32_t capacity,
+                                                            const char* spirvPath)
+{
+    if (capacity == 0 || !spirvPath) return nullptr;
+
+    std::vector<uint32_t> code = LoadSpirv(spirvPath);
+    if (code.empty())
+    {
+        LogOnce("SPIR-V not found (build_spirv.sh / HCP_SETTLE_SPV)");
+        return nullptr;
+    }
+
+    std::unique_ptr<VkSettleBackend> backend(new VkSettleBackend());
+    backend->m_impl.reset(new Impl());
+    backend->m_capacity = capacity;
+    Impl& impl = *backend->m_impl;
+
+    if (!gladLoaderLoadVulkanContext(&impl.vk, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE))
+    {
+        LogOnce("no Vulkan loader (libvulkan.so.1)");
+        return nullptr;
+    }
+
+    VkApplicationInfo app{VK_STRUCTURE_TYPE_APPLICATION_INFO};
+    app.pApplicationName = "hcp_settle_backend";
+    app.apiVersion = VK_API_VERSION_1_1;
+    VkInstanceCreateInfo ii{VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
+    ii.pApplicationInfo = &app;
+    if (vkCreateInstance(&ii, nullptr, &impl.instance) != VK_SUCCESS)
+    {
+        LogOnce("vkCreateInstance failed");
+        return nullptr;
+    }
+    gladLoaderLoadVulkanContext(&impl.vk, impl.instance, VK_NULL_HANDLE, VK_NULL_HANDLE);
+
+    uint32_t n = 0;
+    vkEnumeratePhysicalDevices(impl.instance, &n, nullptr);
+    if (n == 0)
+    {
+        LogOnce("no Vulkan physical devices");
+        return nullptr;
+    }
+    std::vector<VkPhysicalDevice> devs(n);
+    vkEnumeratePhysicalDevices(impl.instance, &n, devs.data());
+
+    // Prefer a discrete GPU; never pick a CPU (llvmpipe) if a GPU exists.
+    VkPhysicalDevice chosen = VK_NULL_HANDLE;
+    int chosenRank = -1;
+    for (VkPhysicalDevice d : devs)
+    {
+        VkPhysicalDeviceProperties p;
+        vkGetPhysicalDeviceProperties(d, &p);
+        int rank = (p.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)   ? 3 :
+                   (p.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) ? 2 :
+                   (p.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU)            ? 0 : 1;
+        if (rank > chosenRank) { chosenRank = rank; chosen = d; }
+    }
+    // HCP_VK_DEVICE=<name substring> pins a specific GPU (same knob as the harness).
+    if (const char* want = std::getenv("HCP_VK_DEVICE"))
+    {
+        for (VkPhysicalDevice d : devs)
+        {
+            VkPhysicalDeviceProperties p;
+            vkGetPhysicalDeviceProperties(d, &p);
+            if (std::strstr(p.deviceName, want)) { chosen = d; break; }
+        }
+    }
+    if (chosenRank == 0)
+    {
+        LogOnce("only a CPU (llvmpipe) device present");
+        return nullptr;
+    }
+    impl.phys = chosen;
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(impl.phys, &props);
+    std::snprintf(impl.deviceName, sizeof(impl.deviceName), "%s", props.deviceName);
+    vkGetPhysicalDeviceMemoryProperties(impl.phys, &impl.memProps);
+
+    uint32_t qn = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(impl.phys, &qn, nullptr);
+    std::vector<VkQueueFamilyProperties> qf(qn);
+    vkGetPhysicalDeviceQueueFamilyProperties(impl.phys, &qn, qf.data());
+    bool found = false;
+    for (uint32_t i = 0; i < qn; ++i)
+        if (qf[i].queueFlags & VK_QUEUE_COMPUTE_BIT) { impl.queueFamily = i; found = true; break; }
+    if (!found)
+    {
+        LogOnce("no compute queue family");
+        return nullptr;
+    }
+
+    float prio = 1.0f;
+    VkDeviceQueueCreateInfo qi{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+    qi.queueFamilyIndex = impl.queueFamily;
+    qi.queueCount = 1;
+    qi.pQueuePriorities = &prio;
+    VkDeviceCreateInfo di{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+    di.queueCreateInfoCount = 1;
+    di.pQueueCreateInfos = &qi;
+    if (vkCreateDevice(impl.phys, &di, nullptr, &impl.device) != VK_SUCCESS)
+    {
+        LogOnce("vkCreateDevice failed");
+        return nullptr;
+    }
+    gladLoaderLoadVulkanContext(&impl.vk, impl.instance, impl.phys, impl.device);
+    vkGetDeviceQueue(impl.device, impl.queueFamily, 0, &impl.queue);
+
+    // ---- pipeline + descriptor plumbing (bindings per HCPSettleSrg.azsli) ----
+    VkDescriptorSetLayoutBinding binds[5]{};
+    for (int i = 0; i < 5; ++i)
+    {
+        binds[i].binding = static_cast<uint32_t>(i);
+        binds[i].descriptorCount = 1;
+        binds[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        binds[i].descriptorType = (i == 4) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+                                           : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    }
+    VkDescriptorSetLayoutCreateInfo dli{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    dli.bindingCount = 5;
+    dli.pBindings = binds;
+    if (vkCreateDescriptorSetLayout(impl.device, &dli, nullptr, &impl.dsl) != VK_SUCCESS)
+        return nullptr;
+
+    VkPipelineLayoutCreateInfo pli{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    pli.setLayoutCount = 1;
+    pli.pSetLayouts = &impl.dsl;
+    if (vkCreatePipelineLayout(impl.device, &pli, nullptr, &impl.layout) != VK_SUCCESS)
+        return nullptr;
+
+    VkShaderModuleCreateInfo smi{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+    smi.codeSize = code.size() * 4;
+    smi.pCode = code.data();
+    if (vkCreateShaderModule(impl.device, &smi, nullptr, &impl.module) != VK_SUCCESS)
+        return nullptr;
+
+    VkComputePipelineCreateInfo cpi{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+    cpi.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    cpi.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    cpi.stage.module = impl.module;
+    cpi.stage.pName = "SettleStep";
+    cpi.layout = impl.layout;
+    if (vkCreateComputePipelines(impl.device, VK_NULL_HANDLE, 1, &cpi, nullptr,
+            &impl.pipe) != VK_SUCCESS)
+    {
+        LogOnce("compute pipeline creation failed");
+        return nullptr;
+    }
+
+    // ---- persistent device buffers at workspace capacity ----
+    if (!impl.CreateMappedBuffer(VkDeviceSize(capacity) * sizeof(VkFloat4),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, impl.posB) ||
+        !impl.CreateMappedBuffer(VkDeviceSize(capacity) * sizeof(VkFloat4),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, impl.prevB) ||
+        !impl.CreateMappedBuffer(VkDeviceSize(capacity) * sizeof(float),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, impl.restB) ||
+        !impl.CreateMappedBuffer(VkDeviceSize(capacity) * sizeof(uint32_t),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, impl.setB) ||
+        !impl.CreateMappedBuffer(sizeof(VkParams),
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, impl.parB))
+    {
+        LogOnce("buffer allocation failed (host-visible memory)");
+        return nullptr;
+    }
+
+    VkDescriptorPoolSize sizes[2] = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4}, {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1}};
+    VkDescriptorPoolCreateInfo dpi{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    dpi.maxSets = 1;
+    dpi.poolSizeCount = 2;
+    dpi.pPoolSizes = sizes;
+    if (vkCreateDescriptorPool(impl.device, &dpi, nullptr, &impl.dpool) != VK_SUCCESS)
+        return nullptr;
+    VkDescriptorSetAllocateInfo dsa{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    dsa.descriptorPool = impl.dpool;
+    dsa.descriptorSetCount = 1;
+    dsa.pSetLayouts = &impl.dsl;
+    if (vkAllocateDescriptorSets(impl.device, &dsa, &impl.set) != VK_SUCCESS)
+        return nullptr;
+
+    auto writeDesc = [&impl](uint32_t binding, const Impl::Buf& b, VkDescriptorType t)
+    {
+        VkDescriptorBufferInfo info{b.buf, 0, VK_WHOLE_SIZE};
+        VkWriteDescriptorSet w{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+        w.dstSet = impl.set;
+        w.dstBinding = binding;
+        w.descriptorCount = 1;
+        w.descriptorType = t;
+        w.pBufferInfo = &info;
+        vkUpdateDescriptorSets(impl.device, 1, &w, 0, nullptr);
+    };
+    writeDesc(0, impl.posB,  VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    writeDesc(1, impl.prevB, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    writeDesc(2, impl.restB, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    writeDesc(3, impl.setB,  VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    writeDesc(4, impl.parB,  VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+
+    // ---- reusable command buffer + fence ----
+    VkCommandPoolCreateInfo pci{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    pci.queueFamilyIndex = impl.queueFamily;
+    pci.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    if (vkCreateCommandPool(impl.device, &pci, nullptr, &impl.cmdPool) != VK_SUCCESS)
+        return nullptr;
+    VkCommandBufferAllocateInfo cbi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    cbi.commandPool = impl.cmdPool;
+    cbi.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cbi.commandBufferCount = 1;
+    if (vkAllocateCommandBuffers(impl.device, &cbi, &impl.cmd) != VK_SUCCESS)
+        return nullptr;
+    VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    if (vkCreateFence(impl.device, &fci, nullptr, &impl.fence) != VK_SUCCESS)
+        return nullptr;
+
+    std::fprintf(stderr, "[VkSettleBackend] ready: %s, %u-particle buffers resident\n",
+        impl.deviceName, capacity);
+    std::fflush(stderr);
+    return backend;
+}
+
+VkSettleBackend::~VkSettleBackend()
+{
+    if (!m_impl) return;
+    Impl& impl = *m_impl;
+    if (impl.device)
+    {
+        vkDeviceWaitIdle(impl.device);
+        if (impl.fence)   vkDestroyFence(impl.device, impl.fence, nullptr);
+        if (impl.cmdPool) vkDestroyCommandPool(impl.device, impl.cmdPool, nullptr);
+        impl.DestroyBuf(impl.posB);
+        impl.DestroyBuf(impl.prevB);
+        impl.DestroyBuf(impl.restB);
+        impl.DestroyBuf(impl.setB);
+        impl.DestroyBuf(impl.parB);
+        if (impl.dpool)  vkDestroyDescriptorPool(impl.device, impl.dpool, nullptr);
+        if (impl.pipe)   vkDestroyPipeline(impl.device, impl.pipe, nullptr);
+        if (impl.module) vkDestroyShaderModule(impl.device, impl.module, nullptr);
+        if (impl.layout) vkDestroyPipelineLayout(impl.device, impl.layout, nullptr);
+        if (impl.dsl)    vkDestroyDescriptorSetLayout(impl.device, impl.dsl, nullptr);
+        vkDestroyDevice(impl.device, nullptr);
+    }
+    if (impl.instance)
+        vkDestroyInstance(impl.instance, nullptr);
+}
+
+const char* VkSettleBackend::DeviceName() const
+{
+    return m_impl ? m_impl->deviceName : "";
+}
+
+void VkSettleBackend::UploadRange(const float* posX, const float* posY, const float* posZ,
+                                  const float* posW,
+                                  const float* velX, const float* velY, const float* velZ,
+                                  const float* restY, float dt,
+                                  uint32_t first, uint32_t count)
+{
+    Impl& impl = *m_impl;
+    if (first >= m_capacity) return;
+    if (first + count > m_capacity) count = m_capacity - first;
+
+    VkFloat4* cur  = static_cast<VkFloat4*>(impl.posB.mapped);
+    VkFloat4* prev = static_cast<VkFloat4*>(impl.prevB.mapped);
+    float*    rest = static_cast<float*>(impl.restB.mapped);
+    for (uint32_t i = first; i < first + count; ++i)
+    {
+        cur[i]  = { posX[i], posY[i], posZ[i], posW[i] };
+        prev[i] = { posX[i] - velX[i] * dt,
+                    posY[i] - velY[i] * dt,
+                    posZ[i] - velZ[i] * dt,
+                    posW[i] };
+        rest[i] = restY[i];
+    }
+}
+
+bool VkSettleBackend::Begin(uint32_t particleCount, int steps, float dt)
+{
+    Impl& impl = *m_impl;
+    if (impl.inFlight || particleCount == 0 || steps <= 0) return false;
+    if (particleCount > m_capacity) particleCount = m_capacity;
+
+    VkParams params;
+    params.particleCount = particleCount;
+    params.dt = dt;
+    params.gravity = GRAVITY;
+    params.damping = DAMPING;
+    params.friction = FRICTION;
+    params.velSettleThreshold = VEL_SETTLE_THRESHOLD;
+    params.noFloor = NO_FLOOR;
+    std::memcpy(impl.parB.mapped, &params, sizeof(params));
+
+    vkResetCommandBuffer(impl.cmd, 0);
+    VkCommandBufferBeginInfo bi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(impl.cmd, &bi) != VK_SUCCESS) return false;
+
+    vkCmdBindPipeline(impl.cmd, VK_PIPELINE_BIND_POINT_COMPUTE, impl.pipe);
+    vkCmdBindDescriptorSets(impl.cmd, VK_PIPELINE_BIND_POINT_COMPUTE, impl.layout,
+        0, 1, &impl.set, 0, nullptr);
+    const uint32_t groups = (particleCount + 63) / 64;
+    VkMemoryBarrier mb{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+    mb.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    mb.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    for (int s = 0; s < steps; ++s)
+    {
+        vkCmdDispatch(impl.cmd, groups, 1, 1);
+        if (s + 1 < steps)
+            vkCmdPipelineBarrier(impl.cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &mb, 0, nullptr, 0, nullptr);
+    }
+    if (vkEndCommandBuffer(impl.cmd) != VK_SUCCESS) return false;
+
+    vkResetFences(impl.device, 1, &impl.fence);
+    VkSubmitInfo si{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    si.commandBufferCount = 1;
+    si.pCommandBuffers = &impl.cmd;
+    if (vkQueueSubmit(impl.queue, 1, &si, impl.fence) != VK_SUCCESS) return false;
+
+    impl.inFlight = true;
+    impl.submittedDt = dt;
+    return true;
+}
+
+bool VkSettleBackend::IsDone() const
+{
+    Impl& impl = *m_impl;
+    if (!impl.inFlight) return true;
+    return vkGetFenceStatus(impl.device, impl.fence) == VK_SUCCESS;
+}
+
+bool VkSettleBackend::Fetch(float* posX, float* posY, float* posZ,
+                            float* velX, float* velY, float* velZ, uint32_t count)
+{
+    Impl& impl = *m_impl;
+    if (!impl.inFlight) return false;
+    if (vkWaitForFences(impl.device, 1, &impl.fence, VK_TRUE, UINT64_MAX) != VK_SUCCESS)
+        return false;
+    impl.inFlight = false;
+
+    if (count > m_capacity) count = m_capacity;
+    const VkFloat4* cur  = static_cast<const VkFloat4*>(impl.posB.mapped);
+    const VkFloat4* prev = static_cast<const VkFloat4*>(impl.prevB.mapped);
+    const float invDt = 1.0f / impl.submittedDt;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        posX[i] = cur[i].x;
+        posY[i] = cur[i].y;
+        posZ[i] = cur[i].z;
+        velX[i] = (cur[i].x - prev[i].x) * invDt;
+        velY[i] = (cur[i].y - prev[i].y) * invDt;
+        velZ[i] = (cur[i].z - prev[i].z) * invDt;
+    }
+    return true;
+}
+
+} // namespace hcp::settle
@@ -0,0 +1,75 @@
+#pragma once
+
+// VkSettleBackend — persistent Vulkan compute backend for the settle step.
+//
+// vk_settle_harness.cpp proved HCPSettleCompute.azsl's SPIR-V reproduces the
+// CPU reference on hardware; this class productionizes that rig for the engine
+// workspace. Differences from the harness:
+//   - device buffers are created once at workspace capacity and stay host-
+//     mapped, so a phase uploads only the ranges that changed (the vocab
+//     region survives across phases of the same pack; stream slots re-upload
+//     per batch);
+//   - submission is asynchronous behind a fence: Begin() records and submits
+//     the full step budget and returns, IsDone() polls the fence, Fetch()
+//     waits and reads the planes back.
+//
+// The API speaks the workspace's SoA planes directly (positions, velocities,
+// per-particle rest floors); packing to the kernel's Float4 layout happens
+// straight into the persistently mapped staging memory. No AZ / O3DE
+// dependencies — the class builds standalone like the rest of Settle/ (GLAD
+// single-header Vulkan with its internal dlopen loader), so the smoke test
+// runs without the engine.
+//
+// TryCreate returns null when there is no loader, no compute-capable device,
+// or no SPIR-V at the given path; callers keep the host SIMD path then.
+
+#include <cstdint>
+#include <memory>
+
+namespace hcp::settle
+{
+    class VkSettleBackend
+    {
+    public:
+        //! Null on any failure (no loader / device / compute queue / SPIR-V).
+        //! The first failure per process logs its reason to stderr.
+        static std::unique_ptr<VkSettleBackend> TryCreate(uint32_t capacity,
+                                                          const char* spirvPath);
+        ~VkSettleBackend();
+
+        VkSettleBackend(const VkSettleBackend&) = delete;
+        VkSettleBackend& operator=(const VkSettleBackend&) = delete;
+
+        //! Pack and copy particles [first, first+count) into the mapped device
+        //! staging. prev is derived from velocity (prev = cur - vel*dt), the
+        //! same Verlet-history reconstruction the host path performs.
+        void UploadRange(const float* posX, const float* posY, const float* posZ,
+                         const float* posW,
+                         const float* velX, const float* velY, const float* velZ,
+                         const float* restY, float dt,
+                         uint32_t first, uint32_t count);
+
+        //! Record and submit `steps` settle dispatches over `particleCount`
+        //! particles. Returns immediately; false = submit failed and nothing
+        //! is in flight (caller falls back to the host path).
+        bool Begin(uint32_t particleCount, int steps, float dt);
+
+        //! True once the submitted step budget has signalled its fence
+        //! (also true when nothing is in flight).
+        bool IsDone() const;
+
+        //! Block until the budget completes, then read positions back into the
+        //! planes and rebuild velocities ((cur - prev) / dt of the submit).
+        bool Fetch(float* posX, float* posY, float* posZ,
+                   float* velX, float* velY, float* velZ, uint32_t count);
+
+        uint32_t Capacity() const { return m_capacity; }
+        const char* DeviceName() const;
+
+    private:
+        VkSettleBackend();
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+        uint32_t m_capacity = 0;
+    };
+}
@@ -0,0 +1,200 @@
+// bench_settle.cpp — settle-step throughput benchmarks with regression gating.
+//
+// test_settle.cpp pins correctness; this target measures throughput so kernel
+// changes that slow production resolve show up before they ship. Standalone
+// like the tests: no google-benchmark dependency, but the same shape — each
+// benchmark auto-scales its iteration count until it runs long enough to
+// time stably, then reports particles/sec and ns/particle.
+//
+// Workload mirrors the live engine where the standalone tree can: the particle
+// population is WS_BUFFER_CAPACITY (131072, HCPVocabBed.h:26) with the test
+// suite's bed/run/floor mix. CheckSettlement and RunPipelinedCascade live in
+// the Gem and need O3DE; their kernel-level analogues here are the run-gate
+// scan (bench: gate) and the full step-budget + gate + freeze cycle over
+// synthetic runs (bench: cascade).
+//
+// Gating: by default this only reports. Set HCP_BENCH_MIN_<NAME> (NAME in
+// STEP_SCALAR, STEP_SOA, GATE, CASCADE) to a minimum particles/sec figure and
+// the process exits non-zero if that benchmark lands below it — point the
+// thresholds at ~90% of a known-good machine's numbers to gate regressions.
+
+#include "SettleKernel.h"
+#include "SettleKernelSimd.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace hcp::settle;
+
+// Matches the live workspace size (HCPVocabBed.h WS_BUFFER_CAPACITY).
+constexpr size_t kParticles = 131072;
+constexpr uint32_t kRunLength = 8;       // synthetic runs: 8 chars each
+
+static int g_gateFailures = 0;
+
+// Deterministic LCG, same recurrence as test_settle.cpp.
+static uint32_t g_seed = 0x48435021u;
+static float NextRand()
+{
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return static_cast<float>(g_seed >> 8) / static_cast<float>(1u << 24);
+}
+
+// The test suite's mixed scene at workspace size: 1/3 bed anchors, movable
+// particles released above floors, ~1 in 4 movable with no floor (free-fall).
+struct Scene
+{
+    std::vector<Float4> cur, prev;
+    std::vector<float>  restY;
+    std::vector<Run>    runs;
+};
+
+static Scene BuildScene()
+{
+    Scene s;
+    g_seed = 0x48435021u;
+    s.cur.reserve(kParticles);
+    s.restY.reserve(kParticles);
+    for (size_t i = 0; i < kParticles; ++i)
+    {
+        const bool bed = (i % 3 == 0);
+        const float w = bed ? 0.0f : 1.0f;
+        s.cur.push_back({ NextRand() * 10.0f, bed ? 0.0f : 0.25f + NextRand() * 4.0f,
+                          NextRand() * 5.0f, w });
+        s.restY.push_back((!bed && NextRand() < 0.75f) ? 0.0f : NO_FLOOR);
+    }
+    s.prev = s.cur;
+    for (uint32_t start = 0; start + kRunLength <= kParticles; start += kRunLength)
+        s.runs.push_back(Run{start, kRunLength});
+    return s;
+}
+
+// Auto-scaling timer: doubles the iteration count until a timed pass exceeds
+// the budget, then reports from that pass. itemsPerIter = particles touched
+// per body() call, so the figure is directly comparable across benchmarks.
+template <typename Fn>
+static double RunBench(const char* name, size_t itemsPerIter, Fn&& body)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr double kMinSeconds = 0.3;
+
+    body();   // warm-up (page in, branch-train)
+
+    size_t iters = 1;
+    double elapsed = 0.0;
+    for (;;)
+    {
+        const auto t0 = Clock::now();
+        for (size_t i = 0; i < iters; ++i) body();
+        elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (elapsed >= kMinSeconds || iters >= (size_t(1) << 30)) break;
+        iters *= 2;
+    }
+
+    const double pps = static_cast<double>(itemsPerIter) * iters / elapsed;
+    std::printf("%-14s %10zu iters  %12.3g particles/sec  %8.2f ns/particle\n",
+                name, iters, pps, 1e9 / pps);
+
+    // Optional regression gate: HCP_BENCH_MIN_<NAME> = minimum particles/sec.
+    char envName[64];
+    std::snprintf(envName, sizeof(envName), "HCP_BENCH_MIN_%s", name);
+    for (char* c = envName; *c; ++c)
+        if (*c >= 'a' && *c <= 'z') *c = static_cast<char>(*c - 'a' + 'A');
+    if (const char* minStr = std::getenv(envName))
+    {
+        const double minPps = std::atof(minStr);
+        if (minPps > 0.0 && pps < minPps)
+        {
+            std::printf("  GATE FAIL: %s below %s=%.3g\n", name, envName, minPps);
+            ++g_gateFailures;
+        }
+    }
+    return pps;
+}
+
+// Fold a value into a sink the optimizer cannot discard.
+static float g_sink = 0.0f;
+
+int main()
+{
+    std::printf("=== HCP settle benchmarks (%zu particles, %zu runs of %u) ===\n",
+                kParticles, BuildScene().runs.size(), kRunLength);
+#if defined(__AVX2__)
+    std::printf("ISA: AVX2 8-wide\n");
+#elif defined(__ARM_NEON)
+    std::printf("ISA: NEON 4-wide\n");
+#else
+    std::printf("ISA: scalar fallback\n");
+#endif
+
+    Scene base = BuildScene();
+
+    // ---- 1. Scalar AoS settle step (the oracle path) ----
+    {
+        Scene s = base;
+        RunBench("step_scalar", kParticles, [&] {
+            SettleStepAll(s.cur, s.prev, s.restY);
+        });
+        g_sink += s.cur[0].y;
+    }
+
+    // ---- 2. Batched SoA/SIMD settle step (the production host path) ----
+    {
+        SettleSoA soa;
+        soa.FromAoS(base.cur, base.prev, base.restY);
+        RunBench("step_soa", kParticles, [&] {
+            SettleStepAllSoA(soa);
+        });
+        g_sink += soa.curY[0];
+    }
+
+    // ---- 3. Run-gate scan (kernel analogue of CheckSettlement's tier pass) ----
+    {
+        Scene s = base;
+        // A few steps first so the gate sees realistic mixed velocities.
+        for (int i = 0; i < 8; ++i) SettleStepAll(s.cur, s.prev, s.restY);
+        RunBench("gate", kParticles, [&] {
+            uint32_t settled = 0;
+            for (const Run& run : s.runs)
+                settled += CountSettled(s.cur, s.prev, run);
+            g_sink += static_cast<float>(settled);
+        });
+    }
+
+    // ---- 4. Full settle cycle (analogue of one RunPipelinedCascade phase):
+    //         reload state, run the 60-step budget, gate every run, freeze the
+    //         settled ones. Items = particle-steps so the figure lines up with
+    //         the step benchmarks. ----
+    {
+        SettleSoA fresh;
+        fresh.FromAoS(base.cur, base.prev, base.restY);
+        SettleSoA soa;
+        std::vector<Float4> cur, prev;
+        RunBench("cascade", kParticles * SETTLE_STEPS, [&] {
+            soa = fresh;                            // pack reload, part of the cycle
+            for (int step = 0; step < SETTLE_STEPS; ++step)
+                SettleStepAllSoA(soa);
+            soa.ToAoS(cur, prev);
+            uint32_t gated = 0;
+            for (const Run& run : base.runs)
+            {
+                if (RunGate(cur, prev, run))
+                {
+                    FreezeRun(cur, run);
+                    ++gated;
+                }
+            }
+            g_sink += static_cast<float>(gated);
+        });
+    }
+
+    std::printf("(sink %.3g)\n", g_sink);
+    if (g_gateFailures)
+        std::printf("=== %d benchmark(s) below gate threshold ===\n", g_gateFailures);
+    else
+        std::printf("=== all benchmarks reported (no gate thresholds exceeded) ===\n");
+    return g_gateFailures;
+}
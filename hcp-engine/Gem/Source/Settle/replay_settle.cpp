@@ -0,0 +1,168 @@
+// replay_settle.cpp — standalone replayer for captured Resolve() settle batches.
+//
+// Usage: replay_settle <capture.hrp> [more.hrp ...]
+//
+// The engine writes captures when HCP_REPLAY_DIR is set (one file per
+// simulate batch, see ReplayCapture.h). This re-runs each batch against the
+// CPU reference kernel with the captured constants and times every phase:
+// the settle itself, the per-run velocity gate, and (when a rule pack rode
+// along) the partial-match broadphase. The gate and broadphase mirror
+// HCPVocabBed.cpp semantics byte-for-byte — same doctrine as test_settle.cpp's
+// RunGate mirror — so a capture that regresses here regresses in the engine.
+//
+// Prints a position checksum per replay: two runs of the same capture must
+// match bit-for-bit (the settle is deterministic), so checksum drift across
+// machines or revisions is itself a finding worth filing.
+//
+// With no arguments the binary self-skips (exit 0) — keeps the ctest entry
+// green on build hosts that have no captures to hand.
+
+#include "ReplayCapture.h"
+#include "SettleKernel.h"
+#include "SettleKernelSimd.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace hcp;
+
+static double MsSince(std::chrono::high_resolution_clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+// FNV-1a over the raw bits of the position planes — determinism fingerprint.
+static uint64_t PositionChecksum(const settle::SettleSoA& soa)
+{
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](const std::vector<float>& plane) {
+        for (float v : plane)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            for (int b = 0; b < 4; ++b)
+            {
+                h ^= (bits >> (b * 8)) & 0xFF;
+                h *= 1099511628211ull;
+            }
+        }
+    };
+    mix(soa.curX); mix(soa.curY); mix(soa.curZ);
+    return h;
+}
+
+static int ReplayOne(const char* path)
+{
+    replay::ReplayData cap;
+    if (!replay::Read(path, cap))
+    {
+        std::printf("[FAIL] %s: unreadable or bad header\n", path);
+        return 1;
+    }
+
+    const replay::ReplayHeader& h = cap.header;
+    std::printf("%s: %u particles (%u bed), %u slots, dt=%g steps<=%d "
+        "thresh=%g pack=%ux%u\n",
+        path, h.particleCount, h.vocabCount, h.slotCount, h.dt, h.steps,
+        h.velThreshold, h.packPatternCount, h.packCellLength);
+
+    settle::SettleSoA soa;
+    soa.curX = cap.curX;   soa.curY = cap.curY;
+    soa.curZ = cap.curZ;   soa.curW = cap.curW;
+    soa.prevX = cap.prevX; soa.prevY = cap.prevY; soa.prevZ = cap.prevZ;
+    soa.restY = cap.restY;
+
+    // ---- Phase 1: settle to convergence ----
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const int stepsRun = settle::SettleToConvergence(
+        soa, h.dt, h.velThreshold, h.steps);
+    const double settleMs = MsSince(t0);
+
+    // ---- Phase 2: per-run velocity gate (mirrors Workspace::SlotSettled) ----
+    t0 = std::chrono::high_resolution_clock::now();
+    uint32_t settledRuns = 0;
+    std::vector<bool> slotSettled(cap.slots.size(), false);
+    for (size_t si = 0; si < cap.slots.size(); ++si)
+    {
+        const replay::ReplaySlot& slot = cap.slots[si];
+        if (slot.charCount == 0) continue;
+        bool ok = true;
+        for (uint32_t c = 0; c < slot.charCount && ok; ++c)
+        {
+            uint32_t p = slot.bufferStart + c;
+            if (p >= h.particleCount) { ok = false; break; }
+            float vMag = std::fabs(soa.curX[p] - soa.prevX[p])
+                       + std::fabs(soa.curY[p] - soa.prevY[p])
+                       + std::fabs(soa.curZ[p] - soa.prevZ[p]);
+            if (vMag / h.dt >= h.velThreshold) ok = false;
+        }
+        slotSettled[si] = ok;
+        if (ok) ++settledRuns;
+    }
+    const double gateMs = MsSince(t0);
+
+    // ---- Phase 3: partial-match broadphase, when a pack rode along ----
+    // Mirrors CheckPartialSettlement's criterion (active pattern positions
+    // settled and byte-equal after Z quantization); the engine's SWAR form
+    // is the optimization of exactly this loop.
+    uint32_t broadphaseMatches = 0;
+    double broadMs = 0.0;
+    if (h.packPatternCount > 0 && h.packCellLength > 0)
+    {
+        t0 = std::chrono::high_resolution_clock::now();
+        for (size_t si = 0; si < cap.slots.size(); ++si)
+        {
+            const replay::ReplaySlot& slot = cap.slots[si];
+            if (slot.charCount == 0 || slot.bufferStart + slot.charCount > h.particleCount)
+                continue;
+
+            for (uint32_t pi = 0; pi < h.packPatternCount; ++pi)
+            {
+                const char* pat = cap.packChars.data()
+                    + static_cast<size_t>(pi) * h.packCellLength;
+                bool match = true;
+                for (uint32_t c = 0; c < h.packCellLength && match; ++c)
+                {
+                    if (pat[c] == '\0') continue;   // inert position
+                    if (c >= slot.charCount) { match = false; break; }
+                    uint32_t p = slot.bufferStart + c;
+                    float vMag = std::fabs(soa.curX[p] - soa.prevX[p])
+                               + std::fabs(soa.curY[p] - soa.prevY[p])
+                               + std::fabs(soa.curZ[p] - soa.prevZ[p]);
+                    if (vMag / h.dt >= h.velThreshold) { match = false; break; }
+                    char ch = static_cast<char>(
+                        static_cast<uint32_t>(lroundf(soa.curZ[p] / h.zScale)) & 0xFF);
+                    if (ch != pat[c]) match = false;
+                }
+                if (match) { ++broadphaseMatches; break; }
+            }
+        }
+        broadMs = MsSince(t0);
+    }
+
+    std::printf("  settle: %d/%d steps, %.2f ms  |  gate: %u/%u runs settled, "
+        "%.3f ms", stepsRun, h.steps, settleMs, settledRuns, h.slotCount, gateMs);
+    if (h.packPatternCount > 0)
+        std::printf("  |  broadphase: %u matched, %.3f ms", broadphaseMatches, broadMs);
+    std::printf("\n  checksum: %016llx\n",
+        static_cast<unsigned long long>(PositionChecksum(soa)));
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("[SKIP] replay_settle: no capture files given "
+            "(capture with HCP_REPLAY_DIR=<dir>)\n");
+        return 0;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; ++i)
+        failures += ReplayOne(argv[i]);
+    return failures;
+}
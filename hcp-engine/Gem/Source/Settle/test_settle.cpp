@@ -9,8 +9,11 @@
 //   3. The settle is deterministic (bit-identical across repeated runs).
 //   4. The run GATE mirrors HCPVocabBed.cpp: resolves iff ALL chars settled.
 //   5. Freeze is idempotent and a frozen run thereafter behaves as bed.
+//   6. The batched SoA/SIMD path (SettleKernelSimd.h) is resolution-equivalent
+//      to the scalar reference: identical gate decisions over the step budget.
 
 #include "SettleKernel.h"
+#include "SettleKernelSimd.h"
 
 #include <cstdio>
 #include <cstring>
@@ -151,6 +154,236 @@ static void TestFreezeIdempotent()
     Check("freeze is idempotent", BitEqual(cur[0], a0) && BitEqual(cur[1], a1));
 }
 
+// ---- 6. Batched SoA/SIMD path vs scalar reference -------------------------
+// The oracle is resolution-equivalence (see SettleKernel.h header note): after
+// the full step budget, every run's gate decision must match the scalar path.
+// Positions are also compared with a tight tolerance — the lanes run the same
+// op sequence, so drift here means a genuine divergence, not float noise.
+static void TestSimdMatchesScalar()
+{
+    // Deterministic LCG — mixed bed/run scene with varied floors and heights,
+    // sized to exercise full SIMD lanes plus a scalar tail.
+    uint32_t seed = 0x48435021u;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+
+    constexpr size_t kCount = 259;   // not a multiple of 8: forces a tail
+    std::vector<Float4> cur, prev;
+    std::vector<float>  restY;
+    std::vector<Run>    runs;
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        const bool bed = (i % 3 == 0);
+        const float w = bed ? 0.0f : 1.0f;
+        cur.push_back({ next() * 10.0f, bed ? 0.0f : 0.25f + next() * 4.0f,
+                        next() * 5.0f, w });
+        // ~1 in 4 movable particles gets no floor (falls forever, never gates)
+        restY.push_back((!bed && next() < 0.75f) ? 0.0f : NO_FLOOR);
+    }
+    prev = cur;
+    for (uint32_t start = 0; start + 4 <= kCount; start += 4)
+        runs.push_back(Run{start, 4});
+
+    // Scalar reference
+    std::vector<Float4> curS = cur, prevS = prev;
+    Advance(curS, prevS, restY, SETTLE_STEPS);
+
+    // Batched SoA path
+    SettleSoA soa;
+    soa.FromAoS(cur, prev, restY);
+    for (int s = 0; s < SETTLE_STEPS; ++s)
+        SettleStepAllSoA(soa);
+    std::vector<Float4> curV, prevV;
+    soa.ToAoS(curV, prevV);
+
+    bool gatesMatch = true;
+    uint32_t gated = 0;
+    for (const Run& run : runs)
+    {
+        const bool gs = RunGate(curS, prevS, run);
+        const bool gv = RunGate(curV, prevV, run);
+        if (gs != gv) gatesMatch = false;
+        if (gs) ++gated;
+    }
+    Check("SoA/SIMD gate decisions match scalar reference for every run", gatesMatch);
+    std::printf("       (%u of %zu runs gated, ISA: %s)\n", gated, runs.size(),
+#if defined(__AVX2__)
+                "AVX2 8-wide"
+#elif defined(__ARM_NEON)
+                "NEON 4-wide"
+#else
+                "scalar fallback"
+#endif
+    );
+
+    float maxErr = 0.0f;
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        maxErr = std::fmax(maxErr, std::fabs(curS[i].x - curV[i].x));
+        maxErr = std::fmax(maxErr, std::fabs(curS[i].y - curV[i].y));
+        maxErr = std::fmax(maxErr, std::fabs(curS[i].z - curV[i].z));
+    }
+    Check("SoA/SIMD positions track scalar reference (err < 1e-4)", maxErr < 1e-4f);
+    std::printf("       (max position error %.3g)\n", maxErr);
+
+    // Round-trip sanity: FromAoS/ToAoS with zero steps is the identity.
+    SettleSoA rt;
+    rt.FromAoS(cur, prev, restY);
+    std::vector<Float4> curR, prevR;
+    rt.ToAoS(curR, prevR);
+    bool identity = true;
+    for (size_t i = 0; identity && i < kCount; ++i)
+        identity = BitEqual(cur[i], curR[i]);
+    Check("SoA round-trip (FromAoS -> ToAoS) is the identity", identity);
+}
+
+// ---- 7. Length-specialized gate dispatch matches the runtime loop ---------
+static void TestGateDispatchMatchesRuntime()
+{
+    // Mixed scene covering every dispatchable length 2..20, plus one run past
+    // the table (25) and one clipping the buffer end — both must fall back.
+    uint32_t seed = 0x48435021u;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+
+    std::vector<Float4> cur, prev;
+    std::vector<float>  restY;
+    std::vector<Run>    runs;
+    uint32_t start = 0;
+    for (uint32_t len = GATE_MIN_WORDLEN; len <= GATE_MAX_WORDLEN + 5; ++len)
+    {
+        runs.push_back(Run{start, len});
+        start += len;
+    }
+    for (uint32_t i = 0; i < start; ++i)
+    {
+        cur.push_back({ next() * 10.0f, 0.25f + next() * 4.0f, next() * 5.0f, 1.0f });
+        restY.push_back(next() < 0.75f ? 0.0f : NO_FLOOR);
+    }
+    prev = cur;
+    Advance(cur, prev, restY, SETTLE_STEPS / 2);   // mixed settled/unsettled state
+
+    bool countsMatch = true, gatesMatch = true;
+    for (const Run& run : runs)
+    {
+        if (CountSettledDispatch(cur, prev, run) != CountSettled(cur, prev, run))
+            countsMatch = false;
+        if (RunGateDispatch(cur, prev, run) != RunGate(cur, prev, run))
+            gatesMatch = false;
+    }
+    Check("dispatched CountSettled matches runtime loop for lengths 2..25", countsMatch);
+    Check("dispatched RunGate matches runtime loop for lengths 2..25", gatesMatch);
+
+    // Clipped run: extends past the particle array; dispatch must take the
+    // bounds-checked fallback and agree with it.
+    Run clipped{start - 3, 8};
+    Check("dispatched gate agrees on a run clipping the buffer end",
+        CountSettledDispatch(cur, prev, clipped) == CountSettled(cur, prev, clipped));
+
+    // Plane-form kernel against the AoS L1 gate on derived velocity planes.
+    std::vector<float> velX(start), velY(start), velZ(start);
+    for (uint32_t i = 0; i < start; ++i)
+    {
+        velX[i] = cur[i].x - prev[i].x;
+        velY[i] = cur[i].y - prev[i].y;
+        velZ[i] = cur[i].z - prev[i].z;
+    }
+    bool planesMatch = true;
+    for (const Run& run : runs)
+    {
+        GatePlaneFn fn = GatePlaneKernelForLength(run.charCount);
+        if (run.charCount > GATE_MAX_WORDLEN)
+        {
+            if (fn != nullptr) planesMatch = false;
+            continue;
+        }
+        if (!fn) { planesMatch = false; continue; }
+        uint32_t expected = 0;
+        for (uint32_t c = 0; c < run.charCount; ++c)
+        {
+            const uint32_t i = run.bufferStart + c;
+            if (std::fabs(velX[i]) + std::fabs(velY[i]) + std::fabs(velZ[i])
+                < VEL_SETTLE_THRESHOLD)
+                ++expected;
+        }
+        if (fn(velX.data(), velY.data(), velZ.data(), run.bufferStart,
+               VEL_SETTLE_THRESHOLD) != expected)
+            planesMatch = false;
+    }
+    Check("plane-form kernels match the scalar plane gate, null past length 20",
+        planesMatch);
+}
+
+// ---- 8. Convergence early exit is resolution-equivalent -------------------
+static void TestConvergenceEarlyExit()
+{
+    uint32_t seed = 0x48435021u;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+
+    // Engine-shaped scene: every movable run launches from the same height
+    // (the RC_Y_OFFSET drop), ~3 in 4 supported by a floor at 0, the rest
+    // free-fallers that never gate.
+    constexpr size_t kCount = 240;
+    std::vector<Float4> cur;
+    std::vector<float>  restY;
+    std::vector<Run>    runs;
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        const bool bed = (i % 5 == 0);
+        cur.push_back({ next() * 10.0f, bed ? 0.0f : 1.5f, next() * 5.0f,
+                        bed ? 0.0f : 1.0f });
+        restY.push_back((!bed && next() < 0.75f) ? 0.0f : NO_FLOOR);
+    }
+    std::vector<Float4> prev = cur;
+    for (uint32_t start = 0; start + 4 <= kCount; start += 4)
+        runs.push_back(Run{start, 4});
+
+    // Full-budget scalar reference: the gate decisions to preserve.
+    std::vector<Float4> curS = cur, prevS = prev;
+    Advance(curS, prevS, restY, SETTLE_STEPS);
+
+    // Convergence path over the same scene.
+    SettleSoA soa;
+    soa.FromAoS(cur, prev, restY);
+    const int stepsRun = SettleToConvergence(soa, DT, VEL_SETTLE_THRESHOLD, SETTLE_STEPS);
+    std::vector<Float4> curC, prevC;
+    soa.ToAoS(curC, prevC);
+
+    bool gatesMatch = true;
+    for (const Run& run : runs)
+        if (RunGate(curS, prevS, run) != RunGate(curC, prevC, run))
+            gatesMatch = false;
+    Check("early exit fires inside the step budget", stepsRun < SETTLE_STEPS);
+    Check("early-exit gate decisions match the full-budget reference", gatesMatch);
+    std::printf("       (%d of %d budgeted steps run)\n", stepsRun, SETTLE_STEPS);
+
+    // All-supported scene: converges to zero unsettled, not just a stall.
+    SettleSoA all;
+    all.FromAoS(cur, prev, restY);
+    for (size_t i = 0; i < kCount; ++i)
+        all.restY[i] = 0.0f;
+    const int allSteps = SettleToConvergence(all, DT, VEL_SETTLE_THRESHOLD, SETTLE_STEPS);
+    Check("fully supported scene converges to zero unsettled inside budget",
+        allSteps < SETTLE_STEPS && CountUnsettledSoA(all, DT, VEL_SETTLE_THRESHOLD) == 0);
+
+    // Only free-fallers: the count never decreases, so the stall exit must
+    // stay unarmed and the full budget runs (the fixed-cost worst case).
+    SettleSoA fall;
+    fall.FromAoS(cur, prev, restY);
+    for (size_t i = 0; i < kCount; ++i)
+        fall.restY[i] = NO_FLOOR;
+    const int fallSteps = SettleToConvergence(fall, DT, VEL_SETTLE_THRESHOLD, SETTLE_STEPS);
+    Check("free-faller-only scene runs the full budget (stall exit unarmed)",
+        fallSteps == SETTLE_STEPS);
+}
+
 int main()
 {
     std::printf("=== HCP settle reference tests ===\n");
@@ -159,6 +392,9 @@ int main()
     TestDeterminism();
     TestRunGateAllOrNothing();
     TestFreezeIdempotent();
+    TestSimdMatchesScalar();
+    TestGateDispatchMatchesRuntime();
+    TestConvergenceEarlyExit();
     std::printf("=== %d passed, %d failed ===\n", g_pass, g_fail);
     return g_fail;
 }
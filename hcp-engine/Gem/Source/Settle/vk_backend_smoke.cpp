@@ -0,0 +1,191 @@
+// vk_backend_smoke.cpp — VkSettleBackend vs CPU reference.
+//
+// vk_settle_harness.cpp proves the raw SPIR-V matches the CPU kernel; this
+// smoke test proves the production wrapper around it: persistent buffers,
+// plane-based upload/readback with Verlet history reconstruction, the async
+// Begin/IsDone/Fetch contract, and delta uploads (re-uploading only a
+// subrange leaves the rest of the resident state valid).
+//
+// Self-skips (exit 0) when TryCreate returns null — no loader, no device, or
+// no settle.spv. Otherwise exit code == number of failed checks.
+
+#include "SettleKernel.h"
+#include "VkSettleBackend.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace sk = hcp::settle;
+
+static int g_pass = 0, g_fail = 0;
+static void Check(const char* label, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", label);
+    if (ok) ++g_pass; else ++g_fail;
+}
+
+// Plane-form scene mirroring a workspace: [0, bedCount) immovable bed (w=0),
+// [bedCount, n) movable run chars (w=1) dropped above a floor.
+struct Planes {
+    std::vector<float> px, py, pz, pw, vx, vy, vz, restY;
+    void Resize(uint32_t n) {
+        px.assign(n, 0); py.assign(n, 0); pz.assign(n, 0); pw.assign(n, 0);
+        vx.assign(n, 0); vy.assign(n, 0); vz.assign(n, 0);
+        restY.assign(n, sk::NO_FLOOR);
+    }
+};
+
+static void BuildScene(Planes& p, uint32_t n, uint32_t bedCount, uint32_t seed) {
+    p.Resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        p.px[i] = (float)(i % 257);
+        p.pz[i] = (float)(i % 13);
+        if (i < bedCount) {
+            p.py[i] = 0.0f;                     // bed: pinned, no floor needed
+        } else {
+            p.py[i] = 1.0f + (float)(seed % 400) / 100.0f;
+            p.pw[i] = 1.0f;
+            p.vx[i] = ((float)(seed % 100) - 50.0f) / 200.0f;
+            p.restY[i] = (i % 4 == 0) ? sk::NO_FLOOR : 0.0f;
+        }
+    }
+}
+
+// CPU oracle in the same plane form: pack to Float4, reconstruct prev from
+// velocity, run the reference kernel, unpack with vel = (cur - prev) / dt.
+static void CpuSettle(Planes& p, uint32_t n, int steps) {
+    std::vector<sk::Float4> cur(n), prev(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        cur[i] = { p.px[i], p.py[i], p.pz[i], p.pw[i] };
+        prev[i] = { p.px[i] - p.vx[i] * sk::DT,
+                    p.py[i] - p.vy[i] * sk::DT,
+                    p.pz[i] - p.vz[i] * sk::DT, p.pw[i] };
+    }
+    for (int s = 0; s < steps; ++s) sk::SettleStepAll(cur, prev, p.restY);
+    for (uint32_t i = 0; i < n; ++i) {
+        p.px[i] = cur[i].x; p.py[i] = cur[i].y; p.pz[i] = cur[i].z;
+        p.vx[i] = (cur[i].x - prev[i].x) / sk::DT;
+        p.vy[i] = (cur[i].y - prev[i].y) / sk::DT;
+        p.vz[i] = (cur[i].z - prev[i].z) / sk::DT;
+    }
+}
+
+static float MaxAbsDiff(const std::vector<float>& a, const std::vector<float>& b, uint32_t n) {
+    float m = 0;
+    for (uint32_t i = 0; i < n; ++i) m = std::fmax(m, std::fabs(a[i] - b[i]));
+    return m;
+}
+
+int main(int argc, char** argv)
+{
+    const char* spvPath = argc > 1 ? argv[1] : "settle.spv";
+    std::printf("=== VkSettleBackend smoke (backend == CPU reference) ===\n");
+
+    const uint32_t CAP = 4096;
+    auto backend = sk::VkSettleBackend::TryCreate(CAP, spvPath);
+    if (!backend) {
+        std::fprintf(stderr, "SKIP: VkSettleBackend unavailable here\n");
+        return 0;
+    }
+    std::printf("device: %s\n", backend->DeviceName());
+
+    // ---- Test 1: async full run — Begin returns, IsDone flips, Fetch matches CPU ----
+    {
+        const uint32_t N = 1024, BED = 256;
+        Planes gpu, cpu;
+        BuildScene(gpu, N, BED, 0x48435021u);
+        cpu = gpu;
+
+        backend->UploadRange(gpu.px.data(), gpu.py.data(), gpu.pz.data(), gpu.pw.data(),
+                             gpu.vx.data(), gpu.vy.data(), gpu.vz.data(),
+                             gpu.restY.data(), sk::DT, 0, N);
+        Check("Begin submits the step budget", backend->Begin(N, sk::SETTLE_STEPS, sk::DT));
+        // Not asserting IsDone() == false here: a fast device may finish before
+        // we look. Poll until it reports done, then fetch.
+        while (!backend->IsDone()) {}
+        Check("IsDone reports completion", backend->IsDone());
+        Check("Fetch succeeds after completion",
+              backend->Fetch(gpu.px.data(), gpu.py.data(), gpu.pz.data(),
+                             gpu.vx.data(), gpu.vy.data(), gpu.vz.data(), N));
+        Check("second Fetch without a Begin is rejected",
+              !backend->Fetch(gpu.px.data(), gpu.py.data(), gpu.pz.data(),
+                              gpu.vx.data(), gpu.vy.data(), gpu.vz.data(), N));
+
+        CpuSettle(cpu, N, sk::SETTLE_STEPS);
+        float posErr = std::fmax(MaxAbsDiff(gpu.py, cpu.py, N),
+                       std::fmax(MaxAbsDiff(gpu.px, cpu.px, N), MaxAbsDiff(gpu.pz, cpu.pz, N)));
+        float velErr = std::fmax(MaxAbsDiff(gpu.vy, cpu.vy, N),
+                       std::fmax(MaxAbsDiff(gpu.vx, cpu.vx, N), MaxAbsDiff(gpu.vz, cpu.vz, N)));
+        Check("60 steps: positions match CPU within 1e-2", posErr < 1e-2f);
+        Check("60 steps: rebuilt velocities match CPU within 1e-1", velErr < 1e-1f);
+        std::printf("       (max pos err = %.3e, max vel err = %.3e)\n", posErr, velErr);
+
+        bool bedPinned = true;
+        for (uint32_t i = 0; i < BED; ++i)
+            bedPinned = bedPinned && gpu.py[i] == 0.0f && gpu.vy[i] == 0.0f;
+        Check("bed region (w=0) untouched by the backend", bedPinned);
+    }
+
+    // ---- Test 2: delta upload — refresh only the stream range, bed stays resident ----
+    {
+        const uint32_t N = 2048, BED = 512;
+        Planes base;
+        BuildScene(base, N, BED, 0x48435021u);
+
+        // Phase 1: full upload + run (leaves bed/vocab region resident on device).
+        Planes gpu = base;
+        backend->UploadRange(gpu.px.data(), gpu.py.data(), gpu.pz.data(), gpu.pw.data(),
+                             gpu.vx.data(), gpu.vy.data(), gpu.vz.data(),
+                             gpu.restY.data(), sk::DT, 0, N);
+        backend->Begin(N, 10, sk::DT);
+        backend->Fetch(gpu.px.data(), gpu.py.data(), gpu.pz.data(),
+                       gpu.vx.data(), gpu.vy.data(), gpu.vz.data(), N);
+
+        // Phase 2: new stream batch in [BED, N); re-upload only that range.
+        Planes next = base;
+        BuildScene(next, N, BED, 0x1234567u);
+        for (uint32_t i = 0; i < BED; ++i) {   // bed identical to phase 1
+            next.px[i] = base.px[i]; next.py[i] = base.py[i]; next.pz[i] = base.pz[i];
+            next.pw[i] = base.pw[i]; next.restY[i] = base.restY[i];
+            next.vx[i] = next.vy[i] = next.vz[i] = 0.0f;
+        }
+        Planes cpu = next;
+        backend->UploadRange(next.px.data(), next.py.data(), next.pz.data(), next.pw.data(),
+                             next.vx.data(), next.vy.data(), next.vz.data(),
+                             next.restY.data(), sk::DT, BED, N - BED);
+        backend->Begin(N, sk::SETTLE_STEPS, sk::DT);
+        Check("delta phase: Fetch succeeds",
+              backend->Fetch(next.px.data(), next.py.data(), next.pz.data(),
+                             next.vx.data(), next.vy.data(), next.vz.data(), N));
+
+        CpuSettle(cpu, N, sk::SETTLE_STEPS);
+        float posErr = std::fmax(MaxAbsDiff(next.py, cpu.py, N),
+                       std::fmax(MaxAbsDiff(next.px, cpu.px, N), MaxAbsDiff(next.pz, cpu.pz, N)));
+        Check("delta upload: subrange refresh matches full CPU recompute", posErr < 1e-2f);
+        std::printf("       (max pos err = %.3e)\n", posErr);
+    }
+
+    // ---- Test 3: contract guards ----
+    {
+        Check("Capacity reports construction size", backend->Capacity() == CAP);
+        Check("Begin with zero particles is rejected", !backend->Begin(0, 10, sk::DT));
+        Check("Begin with zero steps is rejected", !backend->Begin(64, 0, sk::DT));
+        Check("double Begin while in flight is rejected",
+              [&] {
+                  Planes p; BuildScene(p, 64, 16, 1u);
+                  backend->UploadRange(p.px.data(), p.py.data(), p.pz.data(), p.pw.data(),
+                                       p.vx.data(), p.vy.data(), p.vz.data(),
+                                       p.restY.data(), sk::DT, 0, 64);
+                  if (!backend->Begin(64, sk::SETTLE_STEPS, sk::DT)) return false;
+                  bool second = backend->Begin(64, 1, sk::DT);
+                  backend->Fetch(p.px.data(), p.py.data(), p.pz.data(),
+                                 p.vx.data(), p.vy.data(), p.vz.data(), 64);
+                  return !second;
+              }());
+    }
+
+    std::printf("=== %d passed, %d failed ===\n", g_pass, g_fail);
+    return g_fail;
+}
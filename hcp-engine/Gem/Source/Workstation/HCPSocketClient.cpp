@@ -5,6 +5,11 @@
 #include <QtEndian>
 
 #include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace HCPEngine
 {
@@ -35,6 +40,7 @@ namespace HCPEngine
         m_reconnectTimer->stop();
         if (m_socket->state() != QAbstractSocket::UnconnectedState)
             m_socket->abort();
+        CloseSharedMemory();
     }
 
     void HCPSocketClient::ConnectToEngine()
@@ -64,6 +70,7 @@ namespace HCPEngine
         fprintf(stderr, "[HCP Client] Connected to %s:%d\n",
             m_host.toUtf8().constData(), m_port);
         fflush(stderr);
+        NegotiateSharedMemory();   // first request on the wire; FIFO keeps ordering
         emit connected();
     }
 
@@ -86,6 +93,7 @@ namespace HCPEngine
             }
         }
         m_recvBuffer.clear();
+        CloseSharedMemory();   // the server unlinks its region on teardown
 
         emit disconnected();
 
@@ -123,6 +131,53 @@ namespace HCPEngine
         m_socket->connectToHost(m_host, m_port);
     }
 
+    // ---- Same-host shared-memory lane ----
+
+    void HCPSocketClient::NegotiateSharedMemory()
+    {
+        // Only a local daemon can share a region with us; remote hosts stay
+        // on plain JSON.
+        if (m_host != "127.0.0.1" && m_host != "localhost" && m_host != "::1")
+            return;
+
+        QJsonObject req;
+        req["action"] = "protocol";
+        req["shm_bytes"] = static_cast<qint64>(DefaultShmBytes);
+        SendRequest(req, [this](const QJsonObject& resp)
+        {
+            if (resp["status"].toString() != "ok" || !resp.contains("shm_name"))
+                return;   // daemon predates the lane, or refused — JSON works fine
+
+            const QByteArray name = resp["shm_name"].toString().toUtf8();
+            const size_t bytes = static_cast<size_t>(resp["shm_bytes"].toDouble());
+            int fd = ::shm_open(name.constData(), O_RDWR, 0600);
+            if (fd < 0)
+                return;
+            void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);   // the mapping keeps the region alive
+            if (map == MAP_FAILED)
+                return;
+
+            m_shmName = name;
+            m_shmPtr = static_cast<uchar*>(map);
+            m_shmSize = bytes;
+            fprintf(stderr, "[HCP Client] Shared-memory lane up: %s (%zu bytes)\n",
+                name.constData(), bytes);
+            fflush(stderr);
+        });
+    }
+
+    void HCPSocketClient::CloseSharedMemory()
+    {
+        if (m_shmPtr)
+        {
+            ::munmap(m_shmPtr, m_shmSize);
+            m_shmPtr = nullptr;
+        }
+        m_shmSize = 0;
+        m_shmName.clear();
+    }
+
     // ---- Protocol: length-prefixed JSON ----
 
     void HCPSocketClient::SendRequest(const QJsonObject& request, ResponseCallback cb)
@@ -203,6 +258,16 @@ namespace HCPEngine
                 response["message"] = QString("JSON parse error: %1").arg(parseErr.errorString());
             }
 
+            // Shared-memory reply: the bulk payload is in the mapped region,
+            // not the JSON — materialize it so callers see a normal reply.
+            if (m_shmPtr && response["shm"].toBool())
+            {
+                const size_t n = static_cast<size_t>(response["text_bytes"].toDouble());
+                if (n <= m_shmSize)
+                    response["text"] = QString::fromUtf8(
+                        reinterpret_cast<const char*>(m_shmPtr), static_cast<int>(n));
+            }
+
             // Dispatch to first pending callback
             if (!m_pendingCallbacks.empty())
             {
@@ -259,6 +324,8 @@ namespace HCPEngine
         QJsonObject req;
         req["action"] = "retrieve";
         req["doc_id"] = docId;
+        if (m_shmPtr && m_pendingCallbacks.empty())
+            req["shm"] = true;   // reply text lands in the mapped region
         SendRequest(req, std::move(cb));
     }
 
@@ -285,10 +352,23 @@ namespace HCPEngine
     {
         QJsonObject req;
         req["action"] = "phys_ingest";
-        req["text"] = text;
         req["name"] = name;
         if (!metadata.isEmpty())
             req["metadata"] = metadata;
+
+        // Large documents go through the shared-memory lane when it is free:
+        // no JSON escape, no copy through the socket buffers.
+        const QByteArray utf8 = text.toUtf8();
+        if (m_shmPtr && m_pendingCallbacks.empty()
+            && static_cast<size_t>(utf8.size()) <= m_shmSize)
+        {
+            memcpy(m_shmPtr, utf8.constData(), static_cast<size_t>(utf8.size()));
+            req["shm_bytes"] = static_cast<qint64>(utf8.size());
+        }
+        else
+        {
+            req["text"] = text;
+        }
         SendRequest(req, std::move(cb));
     }
 
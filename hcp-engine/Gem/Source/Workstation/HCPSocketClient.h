@@ -15,6 +15,13 @@ namespace HCPEngine
     /// Async socket client for the HCP engine daemon.
     /// Length-prefixed JSON protocol: 4-byte big-endian length + UTF-8 JSON payload.
     /// All responses arrive on the Qt event loop (UI thread) — callbacks are UI-safe.
+    ///
+    /// When the daemon is local (loopback host), the client negotiates a
+    /// shared-memory bulk lane on connect: document text for retrieve and
+    /// phys_ingest crosses through a mapped POSIX shm region instead of the
+    /// kernel socket buffers, and the socket carries only control JSON. The
+    /// lane is transparent to callers — replies are materialized back into
+    /// the usual QJsonObject shape before callbacks fire.
     class HCPSocketClient : public QObject
     {
         Q_OBJECT
@@ -61,6 +68,8 @@ namespace HCPEngine
     private:
         void SendRequest(const QJsonObject& request, ResponseCallback cb);
         void ProcessRecvBuffer();
+        void NegotiateSharedMemory();
+        void CloseSharedMemory();
 
         QTcpSocket* m_socket = nullptr;
         QString m_host;
@@ -72,6 +81,15 @@ namespace HCPEngine
         // FIFO callback queue — server processes one request at a time
         std::deque<ResponseCallback> m_pendingCallbacks;
 
+        // Same-host shared-memory bulk lane (server-owned region, mapped by
+        // name). Only one request at a time may use it, so requests opt in
+        // only when no other request is in flight — otherwise they fall back
+        // to inline JSON, which is always correct.
+        static constexpr size_t DefaultShmBytes = 16 * 1024 * 1024;
+        QByteArray m_shmName;
+        uchar* m_shmPtr = nullptr;
+        size_t m_shmSize = 0;
+
         // Auto-reconnect
         QTimer* m_reconnectTimer = nullptr;
         int m_reconnectAttempts = 0;
@@ -1,6 +1,7 @@
 /// HCP Workstation Engine — lightweight kernel host implementation.
 
 #include "HCPWorkstationEngine.h"
+#include "../HCPTokenizer.h"
 
 #include <libpq-fe.h>
 #include <cstdio>
@@ -32,7 +33,8 @@ namespace HCPEngine
         const char* nfEntConnInfo)
     {
         // 1. Primary DB connection (required)
-        bool dbOk = m_dbConn.Connect(pbmConnInfo ? pbmConnInfo : DEFAULT_PBM_CONNINFO);
+        m_pbmConnInfo = pbmConnInfo ? pbmConnInfo : DEFAULT_PBM_CONNINFO;
+        bool dbOk = m_dbConn.Connect(m_pbmConnInfo.c_str());
         if (!dbOk)
         {
             fprintf(stderr, "[WorkstationEngine] WARNING: Primary DB connection failed. "
@@ -81,6 +83,10 @@ namespace HCPEngine
 
     void HCPWorkstationEngine::Shutdown()
     {
+        if (m_prefetchThread.joinable())
+            m_prefetchThread.join();
+        m_prefetchConn.Disconnect();
+
         if (m_ficEntConn)
         {
             PQfinish(m_ficEntConn);
@@ -94,6 +100,78 @@ namespace HCPEngine
         m_dbConn.Disconnect();
     }
 
+    bool HCPWorkstationEngine::FetchTextWindow(
+        const AZStd::string& docId, int fromSlot, int count, TextWindow& out)
+    {
+        if (count <= 0 || !IsReady())
+            return false;
+
+        // Serve from the read-ahead slot when it matches the request.
+        bool hit = false;
+        {
+            std::lock_guard<std::mutex> lock(m_prefetchMutex);
+            if (m_prefetchedValid && m_prefetchedDocId == docId
+                && m_prefetched.fromSlot == fromSlot && m_prefetched.count == count)
+            {
+                out = AZStd::move(m_prefetched);
+                m_prefetchedValid = false;
+                hit = true;
+            }
+        }
+
+        if (!hit)
+        {
+            AZStd::vector<AZStd::string> words;
+            AZStd::vector<AZ::u32> modifiers;
+            int totalSlots = 0;
+            if (!m_pbmReader.LoadPositionsRange(docId, m_vocabulary,
+                    fromSlot, count, words, modifiers, totalSlots))
+                return false;
+
+            out.text = TokenIdsToText(words, &modifiers);
+            out.fromSlot = fromSlot;
+            out.count = count;
+            out.totalSlots = totalSlots;
+        }
+
+        if (fromSlot + count < out.totalSlots)
+            PrefetchNextWindow(docId, fromSlot + count, count);
+
+        return true;
+    }
+
+    void HCPWorkstationEngine::PrefetchNextWindow(
+        const AZStd::string& docId, int fromSlot, int count)
+    {
+        if (m_prefetchThread.joinable())
+            m_prefetchThread.join();
+
+        m_prefetchThread = std::thread([this, docId, fromSlot, count]
+        {
+            if (!m_prefetchConn.IsConnected()
+                && !m_prefetchConn.Connect(m_pbmConnInfo.c_str()))
+                return;
+
+            AZStd::vector<AZStd::string> words;
+            AZStd::vector<AZ::u32> modifiers;
+            int totalSlots = 0;
+            if (!m_prefetchReader.LoadPositionsRange(docId, m_vocabulary,
+                    fromSlot, count, words, modifiers, totalSlots))
+                return;
+
+            TextWindow window;
+            window.text = TokenIdsToText(words, &modifiers);
+            window.fromSlot = fromSlot;
+            window.count = count;
+            window.totalSlots = totalSlots;
+
+            std::lock_guard<std::mutex> lock(m_prefetchMutex);
+            m_prefetched = AZStd::move(window);
+            m_prefetchedDocId = docId;
+            m_prefetchedValid = true;
+        });
+    }
+
     AZStd::vector<EntityInfo> HCPWorkstationEngine::GetFictionEntities(int docPk)
     {
         if (!m_ficEntConn || !m_dbConn.IsConnected())
@@ -25,6 +25,9 @@
 
 #include <AzCore/std/string/string.h>
 
+#include <mutex>
+#include <thread>
+
 struct pg_conn;
 typedef pg_conn PGconn;
 
@@ -81,7 +84,31 @@ namespace HCPEngine
 
         bool HasEntityConnections() const { return m_ficEntConn != nullptr || m_nfEntConn != nullptr; }
 
+        // ---- Windowed document retrieval ----
+
+        /// One viewport-sized slice of a document's reconstructed text.
+        struct TextWindow
+        {
+            AZStd::string text;
+            int fromSlot = 0;
+            int count = 0;        // window size in slots (as requested)
+            int totalSlots = 0;   // document length, for paging
+        };
+
+        /// Fetch a slot window of a document's text. Serves from the
+        /// read-ahead slot when the prefetcher already holds it (sequential
+        /// paging hits this almost every time), otherwise loads synchronously;
+        /// either way the NEXT window is then prefetched in the background.
+        /// The prefetcher runs on its own DB connection and reader — PGconn is
+        /// not thread-safe, so it never touches the UI thread's kernels.
+        bool FetchTextWindow(const AZStd::string& docId, int fromSlot, int count,
+            TextWindow& out);
+
     private:
+        /// Kick the read-ahead thread for [fromSlot, fromSlot + count). Joins
+        /// any previous prefetch first — call WITHOUT m_prefetchMutex held.
+        void PrefetchNextWindow(const AZStd::string& docId, int fromSlot, int count);
+
         // Primary data connection (hcp_fic_pbm)
         HCPDbConnection m_dbConn;
 
@@ -98,6 +125,18 @@ namespace HCPEngine
         // Entity cross-ref connections (optional, separate DBs)
         PGconn* m_ficEntConn = nullptr;   // hcp_fic_entities
         PGconn* m_nfEntConn = nullptr;    // hcp_nf_entities
+
+        // Read-ahead lane for FetchTextWindow — own connection (lazily
+        // connected with the same conninfo as m_dbConn) and own reader, so
+        // the background load never shares a PGconn with the UI thread.
+        HCPDbConnection m_prefetchConn;
+        HCPPbmReader m_prefetchReader{m_prefetchConn};
+        std::thread m_prefetchThread;
+        std::mutex m_prefetchMutex;
+        TextWindow m_prefetched;
+        AZStd::string m_prefetchedDocId;
+        bool m_prefetchedValid = false;
+        AZStd::string m_pbmConnInfo;      // resolved at Initialize
     };
 
 } // namespace HCPEngine
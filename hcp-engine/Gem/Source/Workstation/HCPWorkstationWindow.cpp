@@ -43,6 +43,8 @@
 #include <QJsonArray>
 #include <QFile>
 #include <QMessageBox>
+#include <QTimer>
+#include <QTextCursor>
 
 #include <AzCore/std/containers/unordered_map.h>
 
@@ -885,28 +887,39 @@ namespace HCPEngine
 
     void HCPWorkstationWindow::ShowText(const QString& docId)
     {
+        // New load generation: any append chain still queued from a previous
+        // ShowText — including one for this same document — is now stale.
+        const int loadGen = ++m_textLoadGen;
+
         m_textView->setPlainText("Loading...");
 
         AZStd::string azDocId(docId.toUtf8().constData(), docId.toUtf8().size());
 
-        // Direct DB + vocab path — reconstruct text from positional tokens
+        // Direct DB + vocab path — windowed reconstruction. The first window
+        // renders immediately (a novel no longer freezes the UI on open); the
+        // rest streams in window-sized appends through the engine's
+        // read-ahead, one queued event per window so input stays responsive.
         if (m_engine && m_engine->IsDbConnected() && m_engine->IsVocabLoaded())
         {
-            AZStd::vector<AZStd::string> words;
-            AZStd::vector<AZ::u32> modifiers;
-            if (!m_engine->GetPbmReader().LoadPositionsWithModifiers(azDocId, m_engine->GetVocabulary(), words, modifiers)
-                || words.empty())
+            HCPWorkstationEngine::TextWindow window;
+            if (!m_engine->FetchTextWindow(azDocId, 0, TEXT_WINDOW_SLOTS, window)
+                || window.text.empty())
             {
                 m_textView->setPlainText("(no text stored)");
                 return;
             }
 
-            AZStd::string text = TokenIdsToText(words, &modifiers);
-            if (text.empty())
-                m_textView->setPlainText("(reconstruction failed)");
-            else
-                m_textView->setPlainText(
-                    QString::fromUtf8(text.c_str(), static_cast<int>(text.size())));
+            m_textView->setPlainText(
+                QString::fromUtf8(window.text.c_str(), static_cast<int>(window.text.size())));
+            m_textLoadDocId = docId;
+
+            if (window.fromSlot + window.count < window.totalSlots)
+            {
+                const int next = window.fromSlot + window.count;
+                QTimer::singleShot(0, this, [this, docId, next, loadGen] {
+                    AppendTextWindow(docId, next, loadGen);
+                });
+            }
             return;
         }
 
@@ -930,6 +943,36 @@ namespace HCPEngine
         }
     }
 
+    void HCPWorkstationWindow::AppendTextWindow(const QString& docId, int fromSlot, int loadGen)
+    {
+        // Stale chain — the user moved to another document, or ShowText ran
+        // again (possibly for this same document); that call owns the view now.
+        if (loadGen != m_textLoadGen || m_textLoadDocId != docId || m_selectedDocId != docId)
+            return;
+        if (!m_engine || !m_engine->IsDbConnected() || !m_engine->IsVocabLoaded())
+            return;
+
+        AZStd::string azDocId(docId.toUtf8().constData(), docId.toUtf8().size());
+
+        HCPWorkstationEngine::TextWindow window;
+        if (!m_engine->FetchTextWindow(azDocId, fromSlot, TEXT_WINDOW_SLOTS, window))
+            return;
+
+        // Append without disturbing the user's scroll position or selection.
+        QTextCursor cursor(m_textView->document());
+        cursor.movePosition(QTextCursor::End);
+        cursor.insertText(
+            QString::fromUtf8(window.text.c_str(), static_cast<int>(window.text.size())));
+
+        if (window.fromSlot + window.count < window.totalSlots)
+        {
+            const int next = window.fromSlot + window.count;
+            QTimer::singleShot(0, this, [this, docId, next, loadGen] {
+                AppendTextWindow(docId, next, loadGen);
+            });
+        }
+    }
+
     // ---- Slot handlers ----
 
     void HCPWorkstationWindow::OnBondTokenClicked(QTreeWidgetItem* item, [[maybe_unused]] int column)
@@ -84,6 +84,7 @@ namespace HCPEngine
         void ShowEntities(const QString& docId, const QString& filterEntityId = {});
         void ShowVars(const QString& docId, const QString& filterEntityId = {});
         void ShowText(const QString& docId);
+        void AppendTextWindow(const QString& docId, int fromSlot, int loadGen);
         void UpdateBreadcrumb(const QString& segment);
 
         void IngestFile(const QString& filePath);
@@ -159,6 +160,20 @@ namespace HCPEngine
         QString m_selectedDocId;
         QString m_activeFilter;
 
+        /// Document whose text is currently streaming into the view; guards
+        /// queued AppendTextWindow chains against document switches.
+        QString m_textLoadDocId;
+
+        /// Bumped on every ShowText call. The doc-id guard alone can't tell
+        /// two loads of the SAME document apart (Retrieve Text clicked twice),
+        /// so each queued append chain carries the generation it was started
+        /// under and stops once a newer load has taken the view.
+        int m_textLoadGen = 0;
+
+        /// Retrieval window size in slots — roughly a few screens of prose,
+        /// small enough that the first window renders in milliseconds.
+        static constexpr int TEXT_WINDOW_SLOTS = 4000;
+
         // Tab indices
         int m_tabEntities = 2;
         int m_tabVars = 3;
@@ -9,11 +9,16 @@ set(FILES
     Source/HCPTokenizer.cpp
     Source/HCPTokenizer.h
     Source/HCPParticlePipeline.h
+    Source/HCPPrimeGrid.h
+    Source/HCPEulerReassembly.cpp
+    Source/HCPEulerReassembly.h
     Source/HCPCharRun.h
     Source/HCPStorage.cpp
     Source/HCPStorage.h
     Source/HCPSocketServer.cpp
     Source/HCPSocketServer.h
+    Source/HCPShardRouter.cpp
+    Source/HCPShardRouter.h
     Source/HCPBondCompiler.cpp
     Source/HCPBondCompiler.h
     Source/HCPCacheMissResolver.cpp
@@ -21,8 +26,12 @@ set(FILES
     Source/HCPResolutionChamber.h
     Source/HCPVocabBed.cpp
     Source/HCPVocabBed.h
+    Source/Settle/VkSettleBackend.cpp
+    Source/Settle/VkSettleBackend.h
+    Source/Settle/ReplayCapture.h
     Source/HCPByteIngest.cpp
     Source/HCPByteIngest.h
+    Source/HCPCharClass.h
     ../../tools/byte-floor/bytefloor.cpp
     ../../tools/byte-floor/bytefloor.h
     Source/HCPEnvelopeManager.cpp
@@ -32,16 +41,24 @@ set(FILES
     Source/HCPDbConnection.cpp
     Source/HCPDbConnection.h
     Source/HCPDbUtils.h
+    Source/HCPPosPack.h
     Source/HCPPbmWriter.cpp
     Source/HCPPbmWriter.h
     Source/HCPPbmReader.cpp
     Source/HCPPbmReader.h
+    Source/HCPDocBundle.cpp
+    Source/HCPDocBundle.h
     Source/HCPPhysIngest.cpp
     Source/HCPPhysIngest.h
     Source/HCPGutenbergRunner.cpp
     Source/HCPGutenbergRunner.h
+    Source/HCPIngestBench.cpp
+    Source/HCPIngestBench.h
     Source/HCPDocumentQuery.cpp
     Source/HCPDocumentQuery.h
+    Source/HCPQueryCache.h
+    Source/HCPTextCache.h
+    Source/HCPMemoryBudget.h
     Source/HCPDocVarQuery.cpp
     Source/HCPDocVarQuery.h
     Source/HCPBondQuery.cpp
@@ -49,4 +66,5 @@ set(FILES
     Source/HCPDatabaseBackend.h
     Source/HCPPostgresBackend.cpp
     Source/HCPSqliteBackend.cpp
+    Source/HCPDualWriteBackend.cpp
 )
@@ -1,13 +1,40 @@
 #include "GlossKernel.h"
+#include "hash128.h"
 #include "md5.h"
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <regex>
+#include <thread>
 
 namespace hcp {
 
+// Shard [0, n) into contiguous ranges and run fn(lo, hi, shard) on a worker per
+// range. Contiguous shards keep each worker walking its own stretch of m_parsed.
+// Small corpora stay serial — thread startup would cost more than it saves.
+template <class Fn>
+static void runShards(size_t n, int width, const Fn& fn)
+{
+    if (width <= 1 || n < 4096) { fn(0, n, 0); return; }
+    std::vector<std::thread> pool;
+    size_t chunk = (n + width - 1) / width;
+    for (int t = 0; t < width; ++t) {
+        size_t lo = (size_t)t * chunk, hi = std::min(n, lo + chunk);
+        if (lo >= hi) break;
+        pool.emplace_back([&fn, lo, hi, t] { fn(lo, hi, t); });
+    }
+    for (auto& th : pool) th.join();
+}
+
 GlossKernel::~GlossKernel() { if (m_conn) PQfinish(m_conn); }
 
+int GlossKernel::Workers() const
+{
+    int w = m_cfg.threads;
+    if (w <= 0) w = (int)std::thread::hardware_concurrency();
+    return w < 1 ? 1 : w;
+}
+
 int GlossKernel::Intern(const std::string& s)
 {
     auto it = m_internIdx.find(s);
@@ -264,60 +291,114 @@ bool GlossKernel::LoadSenses()
 
 void GlossKernel::ParseAll()
 {
-    // structure string + key + residue cache (units already classified during load)
-    for (auto& p : m_parsed) {
-        if (p.status == 2) continue;
-        std::string s;
-        for (size_t si = 0; si < p.sections.size(); ++si) {
-            if (si) s += ';';
-            for (size_t ui = 0; ui < p.sections[si].size(); ++ui) {
-                if (ui) s += ',';
-                const Unit& u = p.sections[si][ui];
-                if (u.cls == 2)       s += m_markers[-1 - u.lemma];
-                else if (u.cls == 0)  s += m_coreMap[u.lemma];
-                else                  s += Lemma(u.lemma);
-                if (u.cls == 1) p.residueWords.push_back(u.lemma);
+    // structure string + key + residue cache (units already classified during load).
+    // Senses are independent here — each worker writes only its own Parsed records;
+    // the intern pool and map tables are read-only after load (find, not operator[]).
+    // Residue lemmas land in per-shard arenas (offsets recorded shard-relative),
+    // stitched into the flat run-wide arena the fixpoint scans every pass.
+    const size_t n = m_parsed.size();
+    const int width = (n < 4096) ? 1 : Workers();    // mirror runShards' serial cutoff
+    const size_t chunk = n ? (n + (size_t)width - 1) / (size_t)width : 0;
+    std::vector<std::vector<int>> shardResidue((size_t)width);
+    runShards(n, width, [&](size_t lo, size_t hi, int shard) {
+        auto& arena = shardResidue[(size_t)shard];
+        // Fold each fragment into the hasher as it is appended — the structure
+        // string survives only because kx_concept stores it; the hash never
+        // re-reads it. Generic over the hasher so md5 (compatibility default,
+        // byte-identical to Postgres md5()) and the fast 128-bit lane share
+        // one walk.
+        auto foldSense = [&](Parsed& p, auto&& h) {
+            std::string s;
+            p.residueBegin = (uint32_t)arena.size();
+            auto emit = [&](const char* d, size_t len) { s.append(d, len); h.update(d, len); };
+            for (size_t si = 0; si < p.sections.size(); ++si) {
+                if (si) emit(";", 1);
+                for (size_t ui = 0; ui < p.sections[si].size(); ++ui) {
+                    if (ui) emit(",", 1);
+                    const Unit& u = p.sections[si][ui];
+                    if (u.cls == 2)       { const auto& f = m_markers[-1 - u.lemma]; emit(f.data(), f.size()); }
+                    else if (u.cls == 0)  { const auto& f = m_coreMap.find(u.lemma)->second; emit(f.data(), f.size()); }
+                    else                  { const auto& f = Lemma(u.lemma); emit(f.data(), f.size()); }
+                    if (u.cls == 1) arena.push_back(u.lemma);
+                }
             }
+            p.residueCount = (uint32_t)arena.size() - p.residueBegin;
+            p.structure = std::move(s);
+            p.ckey = h.hex();
+            std::vector<std::vector<Unit>>().swap(p.sections);  // ladder never reads units
+        };
+        for (size_t i = lo; i < hi; ++i) {
+            Parsed& p = m_parsed[i];
+            if (p.status == 2) continue;
+            if (m_cfg.fastHash) foldSense(p, hash128::Stream{});
+            else                foldSense(p, md5::Stream{});
         }
-        p.structure = std::move(s);
-        p.ckey = md5::hex(p.structure);
-    }
+    });
+
+    // Stitch: concatenate shard arenas, rebase each sense's offset by its shard's base.
+    std::vector<size_t> base((size_t)width, 0);
+    size_t total = 0;
+    for (int t = 0; t < width; ++t) { base[(size_t)t] = total; total += shardResidue[(size_t)t].size(); }
+    m_residueArena.clear();
+    m_residueArena.reserve(total);
+    for (auto& a : shardResidue)
+        m_residueArena.insert(m_residueArena.end(), a.begin(), a.end());
+    for (size_t i = 0; i < n; ++i)
+        m_parsed[i].residueBegin += (uint32_t)base[std::min((size_t)(width - 1), chunk ? i / chunk : 0)];
 }
 
 void GlossKernel::Fixpoint()
 {
     // skins: words that name at least one concept. Seed = core exponents.
-    std::unordered_set<int> skins;
-    for (auto& kv : m_coreMap) skins.insert(kv.first);
+    // Flat bitmap over intern ids — the pool is fixed after load, and the
+    // per-pass residue scan is the hot loop; no hashing on it.
+    std::vector<char> skins(m_lemmas.size(), 0);
+    for (auto& kv : m_coreMap) skins[(size_t)kv.first] = 1;
 
+    // Within a pass every sense evaluation is independent (skins is read-only
+    // until the boundary), so workers scan contiguous shards and record mint
+    // candidates locally; the merge — status flip + skin growth — is serial at
+    // the pass boundary, which preserves the serial ladder's semantics exactly:
+    // a word minted in pass N only unlocks other senses from pass N+1 on.
+    const int width = Workers();
+    std::fprintf(stderr, "fixpoint: %d workers\n", width);
     std::vector<char> done(m_parsed.size(), 0);
+    std::vector<std::vector<size_t>> mintedByShard((size_t)width);
     for (int pass = 1; pass <= m_cfg.maxPasses; ++pass) {
-        std::vector<int> newWords;
+        for (auto& shard : mintedByShard) shard.clear();
+        runShards(m_parsed.size(), width, [&](size_t lo, size_t hi, int shard) {
+            auto& local = mintedByShard[(size_t)shard];
+            for (size_t i = lo; i < hi; ++i) {
+                if (done[i]) continue;
+                Parsed& p = m_parsed[i];
+                if (p.status == 2) { done[i] = 1; continue; }
+                int residue = 0;
+                const int* rw = m_residueArena.data() + p.residueBegin;
+                for (uint32_t k = 0; k < p.residueCount; ++k)
+                    if (!skins[(size_t)rw[k]]) ++residue;
+                if (residue <= m_cfg.maxResidue) local.push_back(i);
+            }
+        });
         long minted = 0;
-        for (size_t i = 0; i < m_parsed.size(); ++i) {
-            if (done[i]) continue;
-            Parsed& p = m_parsed[i];
-            if (p.status == 2) { done[i] = 1; continue; }
-            int residue = 0;
-            for (int w : p.residueWords)
-                if (!skins.count(w)) ++residue;
-            if (residue <= m_cfg.maxResidue) {
+        for (auto& shard : mintedByShard) {
+            for (size_t i : shard) {
+                Parsed& p = m_parsed[i];
                 p.status = 1; p.mintedPass = pass;
                 done[i] = 1; ++minted;
-                newWords.push_back(p.word);
+                skins[(size_t)p.word] = 1;
             }
         }
         std::fprintf(stderr, "pass %d: minted %ld senses\n", pass, minted);
         m_stats.passes = pass;
         if (minted == 0) break;
-        for (int w : newWords) skins.insert(w);
     }
     for (auto& p : m_parsed) {
         if (p.status == 1) ++m_stats.complete;
         else if (p.status == 0) {
             ++m_stats.incomplete;
-            for (int w : p.residueWords)
-                if (!skins.count(w)) ++p.residueFinal;
+            const int* rw = m_residueArena.data() + p.residueBegin;
+            for (uint32_t k = 0; k < p.residueCount; ++k)
+                if (!skins[(size_t)rw[k]]) ++p.residueFinal;
         }
     }
 }
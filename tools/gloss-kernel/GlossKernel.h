@@ -28,6 +28,8 @@ struct KernelConfig
     int  maxPasses    = 50;      // fixpoint safety bound
     long limitSenses  = 0;       // 0 = all (smoke-test knob)
     int  maxResidue   = 0;       // mint threshold: 0 = complete explications only
+    int  threads      = 0;       // pass-executor width; 0 = hardware concurrency
+    bool fastHash     = false;   // 128-bit non-crypto collapse keys (NOT md5()-comparable)
 
     // --- language parameter set (claim 553: language = data, engine = invariant) ---
     // Per-language seed tables: coremap (primes+molecules tagged in this language),
@@ -76,6 +78,7 @@ private:
     bool WriteResults();                 // TRUNCATE + COPY kx_* tables
 
     int Intern(const std::string& s);
+    int Workers() const;                 // resolved pass-executor width (>= 1)
     const std::string& Lemma(int id) const { return m_lemmas[id]; }
 
     struct Unit { int lemma; uint8_t cls; };          // cls: 0 core, 1 content, 2 marker
@@ -83,8 +86,8 @@ private:
     {
         long sense_id = 0;
         int  word = -1;                               // owning word (lemma id)
-        std::vector<std::vector<Unit>> sections;      // ordered
-        std::vector<int> residueWords;                // content lemmas, unresolved cache
+        std::vector<std::vector<Unit>> sections;      // ordered; freed after ParseAll
+        uint32_t residueBegin = 0, residueCount = 0;  // content lemmas in m_residueArena
         std::string structure, ckey;
         int  status = 0;                              // 0 pending, 1 complete(minted), 2 empty
         int  mintedPass = 0;
@@ -102,6 +105,7 @@ private:
     std::unordered_set<int>              m_scaffold;      // lemma ids to drop
     std::unordered_map<int,int>          m_lemmaFix;      // bad lemma id -> good lemma id
     std::vector<Parsed>                  m_parsed;
+    std::vector<int>                     m_residueArena;  // all residue lemmas, flat (fixpoint-hot)
 
     // pattern trie over lemma ids (greedy longest match), folded to marker names
     struct PatNode { std::unordered_map<int,int> next; int marker = -1; };
@@ -0,0 +1,49 @@
+// Fast 128-bit collapse-key hash — two avalanched FNV-1a lanes.
+// Non-cryptographic by design: a collapse key only needs collision resistance
+// within a shard's sense space, and md5 stays the compatibility default (kernel
+// keys must match Postgres md5() for SQL-pilot comparison — see the README).
+// Streaming shape mirrors md5::Stream so ParseAll can fold fragments directly.
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace hcp::hash128 {
+
+// murmur3 finalizer — full avalanche over one 64-bit lane
+inline uint64_t fmix64(uint64_t k)
+{
+    k ^= k >> 33; k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33; return k;
+}
+
+struct Stream
+{
+    uint64_t h1    = 1469598103934665603ULL;   // FNV-1a offset basis
+    uint64_t h2    = 0x9ae16a3b2f90404fULL;    // independent basis, lane 2
+    uint64_t total = 0;
+
+    void update(const void* data, size_t n)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < n; ++i) {
+            h1 = (h1 ^ p[i]) * 1099511628211ULL;
+            h2 = (h2 ^ (p[i] + 0x5c)) * 1099511628211ULL;   // lane 2 sees shifted bytes
+        }
+        total += n;
+    }
+
+    std::string hex()
+    {
+        uint64_t a = fmix64(h1 ^ total);
+        uint64_t b = fmix64(h2 + (a >> 32));               // cross-couple the lanes
+        uint8_t out[16];
+        for (int k = 0; k < 8; ++k) { out[k] = (uint8_t)(a >> (8 * k)); out[8 + k] = (uint8_t)(b >> (8 * k)); }
+        static const char* h = "0123456789abcdef";
+        std::string s(32, '0');
+        for (int k = 0; k < 16; ++k) { s[2*k] = h[out[k] >> 4]; s[2*k+1] = h[out[k] & 15]; }
+        return s;
+    }
+};
+
+} // namespace hcp::hash128
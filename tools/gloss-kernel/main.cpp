@@ -20,6 +20,8 @@ int main(int argc, char** argv)
         else if (!std::strcmp(argv[i], "--limit") && i + 1 < argc) cfg.limitSenses = std::atol(argv[++i]);
         else if (!std::strcmp(argv[i], "--max-residue") && i + 1 < argc) cfg.maxResidue = std::atoi(argv[++i]);
         else if (!std::strcmp(argv[i], "--max-passes") && i + 1 < argc) cfg.maxPasses = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) cfg.threads = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--fast-hash")) cfg.fastHash = true;
         else if (!std::strcmp(argv[i], "--dbname") && i + 1 < argc) dbname = argv[++i];
         else if (!std::strcmp(argv[i], "--suffix") && i + 1 < argc) cfg.tableSuffix = argv[++i];
         else if (!std::strcmp(argv[i], "--word-regex") && i + 1 < argc) cfg.wordRegex = argv[++i];
@@ -27,6 +29,7 @@ int main(int argc, char** argv)
             std::fprintf(stderr,
                 "usage: gloss-kernel [--dbname DB] [--suffix _lang] [--word-regex RE] [--keep-case]\n"
                 "                    [--limit N] [--max-residue K] [--max-passes N] [--include-dated]\n"
+                "                    [--threads N] [--fast-hash]\n"
                 "language = data: same engine, different {coremap,scaffold,lemma_fix,patterns}<suffix>\n");
             return 2;
         }
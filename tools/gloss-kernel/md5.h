@@ -43,28 +43,54 @@ inline void processBlock(Ctx& ctx, const uint8_t* p)
     ctx.a0 += A; ctx.b0 += B; ctx.c0 += C; ctx.d0 += D;
 }
 
+// Streaming interface: fold fragments as they are produced instead of
+// materializing the whole message first. hex(msg) below is the one-shot form.
+struct Stream
+{
+    Ctx      ctx;
+    uint8_t  buf[64];
+    size_t   fill  = 0;
+    uint64_t total = 0;
+
+    void update(const void* data, size_t n)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        total += n;
+        if (fill) {
+            size_t take = (n < 64 - fill) ? n : 64 - fill;
+            std::memcpy(buf + fill, p, take);
+            fill += take; p += take; n -= take;
+            if (fill == 64) { processBlock(ctx, buf); fill = 0; }
+        }
+        for (; n >= 64; p += 64, n -= 64) processBlock(ctx, p);
+        if (n) { std::memcpy(buf, p, n); fill = n; }
+    }
+
+    std::string hex()
+    {
+        uint8_t tail[128] = {0};
+        std::memcpy(tail, buf, fill);
+        tail[fill] = 0x80;
+        size_t tlen = (fill < 56) ? 64 : 128;
+        uint64_t bits = total * 8;
+        std::memcpy(tail + tlen - 8, &bits, 8);
+        processBlock(ctx, tail);
+        if (tlen == 128) processBlock(ctx, tail + 64);
+        uint8_t out[16];
+        std::memcpy(out + 0,  &ctx.a0, 4); std::memcpy(out + 4,  &ctx.b0, 4);
+        std::memcpy(out + 8,  &ctx.c0, 4); std::memcpy(out + 12, &ctx.d0, 4);
+        static const char* h = "0123456789abcdef";
+        std::string s(32, '0');
+        for (int k = 0; k < 16; ++k) { s[2*k] = h[out[k] >> 4]; s[2*k+1] = h[out[k] & 15]; }
+        return s;
+    }
+};
+
 inline std::string hex(const std::string& msg)
 {
-    Ctx ctx;
-    size_t n = msg.size();
-    size_t i = 0;
-    for (; i + 64 <= n; i += 64) processBlock(ctx, reinterpret_cast<const uint8_t*>(msg.data()) + i);
-    uint8_t tail[128] = {0};
-    size_t rem = n - i;
-    std::memcpy(tail, msg.data() + i, rem);
-    tail[rem] = 0x80;
-    size_t tlen = (rem < 56) ? 64 : 128;
-    uint64_t bits = static_cast<uint64_t>(n) * 8;
-    std::memcpy(tail + tlen - 8, &bits, 8);
-    processBlock(ctx, tail);
-    if (tlen == 128) processBlock(ctx, tail + 64);
-    uint8_t out[16];
-    std::memcpy(out + 0,  &ctx.a0, 4); std::memcpy(out + 4,  &ctx.b0, 4);
-    std::memcpy(out + 8,  &ctx.c0, 4); std::memcpy(out + 12, &ctx.d0, 4);
-    static const char* h = "0123456789abcdef";
-    std::string s(32, '0');
-    for (int k = 0; k < 16; ++k) { s[2*k] = h[out[k] >> 4]; s[2*k+1] = h[out[k] & 15]; }
-    return s;
+    Stream s;
+    s.update(msg.data(), msg.size());
+    return s.hex();
 }
 
 } // namespace hcp::md5